@@ -0,0 +1,45 @@
+# Open3D: www.open3d.org
+# The MIT License (MIT)
+# See license file or visit www.open3d.org for details
+
+# examples/Python/Benchmark/benchmark_ascii_io.py
+
+# Measures the throughput of reading ascii point cloud files in the XYZ, XYZN,
+# XYZRGB, PTS and PCD formats for point clouds of increasing size. Throughput
+# is given in megabytes of file per second. Every file is read once before
+# the measurement so that it is in the page cache.
+
+import os
+import time
+import numpy as np
+import open3d as o3d
+
+number_of_points = [10**5, 10**6, 10**7]
+formats = ["xyz", "xyzn", "xyzrgb", "pts", "pcd"]
+repeat = 3
+
+
+def measure(pcd, extension):
+    file_path = "benchmark_ascii_io." + extension
+    o3d.io.write_point_cloud(file_path, pcd, write_ascii=True)
+    o3d.io.read_point_cloud(file_path)
+    read_time = float("inf")
+    for _ in range(repeat):
+        start = time.time()
+        o3d.io.read_point_cloud(file_path)
+        read_time = min(read_time, time.time() - start)
+    megabytes = os.path.getsize(file_path) / 1e6
+    os.remove(file_path)
+    return megabytes / read_time
+
+
+if __name__ == "__main__":
+    print("%12s" % "points" +
+          "".join(["%14s" % (extension + " [MB/s]") for extension in formats]))
+    for n in number_of_points:
+        pcd = o3d.geometry.PointCloud()
+        pcd.points = o3d.utility.Vector3dVector(np.random.uniform(size=(n, 3)))
+        pcd.estimate_normals(o3d.geometry.KDTreeSearchParamKNN(knn=10))
+        pcd.colors = o3d.utility.Vector3dVector(np.random.uniform(size=(n, 3)))
+        print("%12d" % n + "".join(
+            ["%14.1f" % measure(pcd, extension) for extension in formats]))
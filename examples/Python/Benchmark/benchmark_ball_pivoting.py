@@ -0,0 +1,59 @@
+# Open3D: www.open3d.org
+# The MIT License (MIT)
+# See license file or visit www.open3d.org for details
+
+# examples/Python/Benchmark/benchmark_ball_pivoting.py
+
+# Compares serial and parallel Ball Pivoting on a densely subdivided knot for
+# increasing numbers of OpenMP threads. Every thread count runs in its own
+# process because OMP_NUM_THREADS is only read when the OpenMP runtime starts.
+
+import multiprocessing
+import os
+import subprocess
+import sys
+import time
+
+mesh_path = "../../TestData/knot.ply"
+number_of_subdivisions = 3
+radii = [1.5, 3.0]
+
+
+def run():
+    import open3d as o3d
+    mesh = o3d.io.read_triangle_mesh(mesh_path)
+    mesh = mesh.subdivide_loop(number_of_iterations=number_of_subdivisions)
+    mesh.compute_vertex_normals()
+    pcd = o3d.geometry.PointCloud()
+    pcd.points = mesh.vertices
+    pcd.normals = mesh.vertex_normals
+    start = time.time()
+    serial = o3d.geometry.TriangleMesh.create_from_point_cloud_ball_pivoting(
+        pcd, o3d.utility.DoubleVector(radii))
+    serial_time = time.time() - start
+    start = time.time()
+    parallel = o3d.geometry.TriangleMesh.\
+        create_from_point_cloud_ball_pivoting_parallel(
+            pcd, o3d.utility.DoubleVector(radii))
+    parallel_time = time.time() - start
+    print("%f %f %d %d %d" %
+          (serial_time, parallel_time, len(serial.triangles),
+           len(parallel.triangles), parallel.is_edge_manifold()))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) > 1 and sys.argv[1] == "run":
+        run()
+        sys.exit(0)
+    print("%10s %12s %14s %12s %14s %10s" %
+          ("threads", "serial [s]", "parallel [s]", "serial tri",
+           "parallel tri", "manifold"))
+    num_threads = 1
+    while num_threads <= multiprocessing.cpu_count():
+        env = dict(os.environ, OMP_NUM_THREADS=str(num_threads))
+        output = subprocess.check_output([sys.executable, __file__, "run"],
+                                         env=env).decode().split()
+        print("%10d %12.2f %14.2f %12s %14s %10s" %
+              (num_threads, float(output[0]), float(output[1]), output[2],
+               output[3], bool(int(output[4]))))
+        num_threads *= 2
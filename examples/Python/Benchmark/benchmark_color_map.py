@@ -0,0 +1,88 @@
+# Open3D: www.open3d.org
+# The MIT License (MIT)
+# See license file or visit www.open3d.org for details
+
+# examples/Python/Benchmark/benchmark_color_map.py
+
+# Compares time and peak memory of color map optimization when all keyframes
+# are held in memory and when they are streamed from files, for increasing
+# sequence lengths. Longer sequences are made by repeating the keyframes of the
+# fountain dataset.
+
+import multiprocessing
+import os
+import resource
+import sys
+import time
+sys.path.append("../Utility")
+import open3d as o3d
+from file import *
+
+path = "[path_to_fountain_dataset]"
+sequence_lengths = [8, 16, 32, 64, 128]
+maximum_iteration = 10
+
+
+def make_sequence(n_keyframes):
+    depth_files = get_file_list(os.path.join(path, "depth/"), extension=".png")
+    color_files = get_file_list(os.path.join(path, "image/"), extension=".jpg")
+    assert (len(depth_files) == len(color_files))
+    camera = o3d.io.read_pinhole_camera_trajectory(
+        os.path.join(path, "scene/key.log"))
+    parameters = [
+        camera.parameters[i % len(camera.parameters)]
+        for i in range(n_keyframes)
+    ]
+    camera.parameters = parameters
+    color_files = [color_files[i % len(color_files)] for i in range(n_keyframes)]
+    depth_files = [depth_files[i % len(depth_files)] for i in range(n_keyframes)]
+    return color_files, depth_files, camera
+
+
+def run(n_keyframes, streaming, queue):
+    color_files, depth_files, camera = make_sequence(n_keyframes)
+    mesh = o3d.io.read_triangle_mesh(
+        os.path.join(path, "scene", "integrated.ply"))
+    option = o3d.color_map.ColorMapOptimizationOption()
+    option.maximum_iteration = maximum_iteration
+    start = time.time()
+    if streaming:
+        o3d.color_map.color_map_optimization(mesh, color_files, depth_files,
+                                             camera, option)
+    else:
+        rgbd_images = []
+        for color_file, depth_file in zip(color_files, depth_files):
+            rgbd_images.append(
+                o3d.geometry.RGBDImage.create_from_color_and_depth(
+                    o3d.io.read_image(color_file),
+                    o3d.io.read_image(depth_file),
+                    convert_rgb_to_intensity=False))
+        o3d.color_map.color_map_optimization(mesh, rgbd_images, camera,
+                                             option)
+    elapsed = time.time() - start
+    # ru_maxrss is reported in kilobytes on Linux
+    peak_mb = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss / 1024.0
+    queue.put((elapsed, peak_mb))
+
+
+def measure(n_keyframes, streaming):
+    # Each run gets its own process so that the peak memory is not shared.
+    queue = multiprocessing.Queue()
+    process = multiprocessing.Process(target=run,
+                                      args=(n_keyframes, streaming, queue))
+    process.start()
+    result = queue.get()
+    process.join()
+    return result
+
+
+if __name__ == "__main__":
+    print("%10s %14s %14s %14s %14s" %
+          ("keyframes", "memory [s]", "memory [MB]", "streaming [s]",
+           "streaming [MB]"))
+    for n_keyframes in sequence_lengths:
+        time_in_memory, peak_in_memory = measure(n_keyframes, False)
+        time_streaming, peak_streaming = measure(n_keyframes, True)
+        print("%10d %14.2f %14.1f %14.2f %14.1f" %
+              (n_keyframes, time_in_memory, peak_in_memory, time_streaming,
+               peak_streaming))
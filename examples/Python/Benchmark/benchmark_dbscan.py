@@ -0,0 +1,67 @@
+# Open3D: www.open3d.org
+# The MIT License (MIT)
+# See license file or visit www.open3d.org for details
+
+# examples/Python/Benchmark/benchmark_dbscan.py
+
+# Measures the run time of PointCloud.cluster_dbscan for increasing cloud sizes
+# and thread counts. Each measurement runs in its own process so that
+# OMP_NUM_THREADS takes effect.
+
+import os
+import subprocess
+import sys
+import time
+import numpy as np
+import open3d as o3d
+
+point_counts = [100000, 1000000, 10000000]
+thread_counts = [1, 2, 4, 8]
+eps = 0.02
+min_points = 10
+
+
+def make_cloud(n_points):
+    # noisy spheres sampled with about 30 points per eps-disc of the surface
+    rng = np.random.RandomState(0)
+    n_spheres = 16
+    centers = rng.uniform(0, 4, size=(n_spheres, 3))
+    labels = rng.randint(0, n_spheres, size=n_points)
+    directions = rng.normal(size=(n_points, 3))
+    directions /= np.linalg.norm(directions, axis=1)[:, None]
+    radius = eps * np.sqrt(n_points / n_spheres / 120.0)
+    points = centers[labels] + directions * radius
+    points += rng.normal(scale=eps * 0.1, size=points.shape)
+    pcd = o3d.geometry.PointCloud()
+    pcd.points = o3d.utility.Vector3dVector(points)
+    return pcd
+
+
+def run(n_points):
+    pcd = make_cloud(n_points)
+    start = time.time()
+    labels = np.array(pcd.cluster_dbscan(eps, min_points))
+    elapsed = time.time() - start
+    print("%f %d" % (elapsed, labels.max() + 1))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) == 2:
+        run(int(sys.argv[1]))
+        sys.exit(0)
+
+    print("%12s %8s %10s %10s %9s" %
+          ("points", "threads", "time [s]", "speedup", "clusters"))
+    for n_points in point_counts:
+        base_time = None
+        for n_threads in thread_counts:
+            env = dict(os.environ, OMP_NUM_THREADS=str(n_threads))
+            output = subprocess.check_output(
+                [sys.executable, __file__, str(n_points)], env=env)
+            elapsed, n_clusters = output.decode().split()[-2:]
+            elapsed = float(elapsed)
+            if base_time is None:
+                base_time = elapsed
+            print("%12d %8d %10.3f %10.2f %9s" %
+                  (n_points, n_threads, elapsed, base_time / elapsed,
+                   n_clusters))
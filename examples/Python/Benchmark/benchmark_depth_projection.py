@@ -0,0 +1,64 @@
+# Open3D: www.open3d.org
+# The MIT License (MIT)
+# See license file or visit www.open3d.org for details
+
+# examples/Python/Benchmark/benchmark_depth_projection.py
+
+# Reports the per-frame latency of back-projecting the TestData RGB-D frames,
+# once with the PointCloud factory functions that allocate a new point cloud
+# per frame and once with a DepthBackProjector that reuses its ray tables and
+# output buffer.
+
+import os
+import time
+import open3d as o3d
+
+data_path = "../../TestData/RGBD/"
+repeat = 50
+
+
+def read_frames():
+    depth_files = sorted(os.listdir(os.path.join(data_path, "depth")))
+    color_files = sorted(os.listdir(os.path.join(data_path, "color")))
+    depths = []
+    rgbds = []
+    for depth_file, color_file in zip(depth_files, color_files):
+        depth = o3d.io.read_image(os.path.join(data_path, "depth", depth_file))
+        color = o3d.io.read_image(os.path.join(data_path, "color", color_file))
+        depths.append(depth)
+        rgbds.append(
+            o3d.geometry.RGBDImage.create_from_color_and_depth(
+                color, depth, convert_rgb_to_intensity=False))
+    return depths, rgbds
+
+
+def measure(function, frames):
+    start = time.time()
+    for i in range(repeat):
+        for frame in frames:
+            function(frame)
+    return (time.time() - start) / (repeat * len(frames)) * 1000.0
+
+
+if __name__ == "__main__":
+    intrinsic = o3d.camera.PinholeCameraIntrinsic(
+        o3d.camera.PinholeCameraIntrinsicParameters.PrimeSenseDefault)
+    depths, rgbds = read_frames()
+    projector = o3d.geometry.DepthBackProjector()
+    output = o3d.geometry.PointCloud()
+
+    print("%12s %14s %14s" % ("input", "factory [ms]", "projector [ms]"))
+    factory = measure(
+        lambda depth: o3d.geometry.PointCloud.create_from_depth_image(
+            depth, intrinsic), depths)
+    reused = measure(
+        lambda depth: projector.create_from_depth_image(
+            depth, intrinsic, output), depths)
+    print("%12s %14.3f %14.3f" % ("depth", factory, reused))
+    factory = measure(
+        lambda rgbd: o3d.geometry.PointCloud.create_from_rgbd_image(
+            rgbd, intrinsic), rgbds)
+    reused = measure(
+        lambda rgbd: projector.create_from_rgbd_image(rgbd, intrinsic, output),
+        rgbds)
+    print("%12s %14.3f %14.3f" % ("rgbd", factory, reused))
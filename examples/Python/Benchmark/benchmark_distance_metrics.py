@@ -0,0 +1,68 @@
+# Open3D: www.open3d.org
+# The MIT License (MIT)
+# See license file or visit www.open3d.org for details
+
+# examples/Python/Benchmark/benchmark_distance_metrics.py
+
+# Compares the time to evaluate Chamfer distance, Hausdorff distance and
+# F-score of many scans against one reference, computed from two calls of
+# compute_point_cloud_distance per scan and with a DistanceMetrics object whose
+# reference is indexed once. The scans are noisy samples of the knot mesh.
+
+import time
+import numpy as np
+import open3d as o3d
+
+number_of_scans = 20
+number_of_points = 100000
+thresholds = [0.5, 1.0, 2.0]
+
+
+def make_scans(mesh):
+    scans = []
+    for i in range(number_of_scans):
+        scan = mesh.sample_points_uniformly(number_of_points)
+        points = np.asarray(scan.points)
+        points += np.random.normal(scale=0.2, size=points.shape)
+        scans.append(scan)
+    return scans
+
+
+def metrics_from_distances(scan, reference):
+    forward = np.asarray(scan.compute_point_cloud_distance(reference))
+    backward = np.asarray(reference.compute_point_cloud_distance(scan))
+    precision = [np.mean(forward < t) for t in thresholds]
+    recall = [np.mean(backward < t) for t in thresholds]
+    chamfer = forward.mean() + backward.mean()
+    hausdorff = max(forward.max(), backward.max())
+    return chamfer, hausdorff, precision, recall
+
+
+if __name__ == "__main__":
+    mesh = o3d.io.read_triangle_mesh("../../TestData/knot.ply")
+    reference = mesh.sample_points_uniformly(number_of_points)
+    scans = make_scans(mesh)
+
+    start = time.time()
+    for scan in scans:
+        metrics_from_distances(scan, reference)
+    time_distances = time.time() - start
+
+    metrics = o3d.geometry.DistanceMetrics()
+    start = time.time()
+    metrics.set_reference(reference)
+    for scan in scans:
+        metrics.compute(scan, thresholds)
+    time_cloud = time.time() - start
+
+    start = time.time()
+    metrics.set_reference(mesh, number_of_points)
+    for scan in scans:
+        metrics.compute(scan, thresholds)
+    time_mesh = time.time() - start
+
+    print("%d scans of %d points" % (number_of_scans, number_of_points))
+    print("%40s %10.3f s" %
+          ("compute_point_cloud_distance x 2", time_distances))
+    print("%40s %10.3f s" % ("DistanceMetrics, point cloud", time_cloud))
+    print("%40s %10.3f s" % ("DistanceMetrics, triangle mesh", time_mesh))
@@ -0,0 +1,54 @@
+# Open3D: www.open3d.org
+# The MIT License (MIT)
+# See license file or visit www.open3d.org for details
+
+# examples/Python/Benchmark/benchmark_fgr_throughput.py
+
+# Measures how many fragment pairs per second FastGlobalRegistration aligns on
+# the TestData/Feature pair for increasing numbers of OpenMP threads. Every
+# thread count runs in its own process because OMP_NUM_THREADS is only read
+# when the OpenMP runtime starts.
+
+import multiprocessing
+import os
+import subprocess
+import sys
+import time
+
+data_path = "../../TestData/Feature/"
+number_of_pairs = 20
+seed = 0
+
+
+def run():
+    import numpy as np
+    import open3d as o3d
+    source = o3d.io.read_point_cloud(os.path.join(data_path, "cloud_bin_0.pcd"))
+    target = o3d.io.read_point_cloud(os.path.join(data_path, "cloud_bin_1.pcd"))
+    source_fpfh = o3d.io.read_feature(
+        os.path.join(data_path, "cloud_bin_0.fpfh.bin"))
+    target_fpfh = o3d.io.read_feature(
+        os.path.join(data_path, "cloud_bin_1.fpfh.bin"))
+    option = o3d.registration.FastGlobalRegistrationOption(seed=seed)
+    start = time.time()
+    for i in range(number_of_pairs):
+        result = o3d.registration.registration_fast_based_on_feature_matching(
+            source, target, source_fpfh, target_fpfh, option)
+    elapsed = time.time() - start
+    # The checksum shows that the result does not depend on the thread count.
+    print("%f %.12f" % (number_of_pairs / elapsed,
+                        np.abs(result.transformation).sum()))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) > 1 and sys.argv[1] == "run":
+        run()
+        sys.exit(0)
+    print("%10s %14s %20s" % ("threads", "pairs / s", "checksum"))
+    num_threads = 1
+    while num_threads <= multiprocessing.cpu_count():
+        env = dict(os.environ, OMP_NUM_THREADS=str(num_threads))
+        output = subprocess.check_output([sys.executable, __file__, "run"],
+                                         env=env).decode().split()
+        print("%10d %14.2f %20s" % (num_threads, float(output[0]), output[1]))
+        num_threads *= 2
@@ -0,0 +1,45 @@
+# Open3D: www.open3d.org
+# The MIT License (MIT)
+# See license file or visit www.open3d.org for details
+
+# examples/Python/Benchmark/benchmark_jtj_reduction.py
+
+# Reports how many Jacobian rows per second the JTJ and JTr reduction of
+# point-to-plane ICP processes. The correspondences are given, so the time is
+# spent in the residual functor and the reduction only, without any nearest
+# neighbor search.
+
+import time
+import numpy as np
+import open3d as o3d
+
+row_counts = [10**4, 10**5, 10**6, 10**7]
+repeat = 5
+
+
+def make_problem(n_rows):
+    rng = np.random.RandomState(0)
+    source = o3d.geometry.PointCloud()
+    source.points = o3d.utility.Vector3dVector(rng.uniform(size=(n_rows, 3)))
+    target = o3d.geometry.PointCloud()
+    target.points = o3d.utility.Vector3dVector(
+        np.asarray(source.points) + rng.normal(scale=1e-2, size=(n_rows, 3)))
+    normals = rng.normal(size=(n_rows, 3))
+    normals /= np.linalg.norm(normals, axis=1)[:, None]
+    target.normals = o3d.utility.Vector3dVector(normals)
+    indices = np.arange(n_rows, dtype=np.int32)
+    corres = o3d.utility.Vector2iVector(np.stack([indices, indices], axis=1))
+    return source, target, corres
+
+
+if __name__ == "__main__":
+    estimation = o3d.registration.TransformationEstimationPointToPlane()
+    print("%12s %16s" % ("rows", "rows/s"))
+    for n_rows in row_counts:
+        source, target, corres = make_problem(n_rows)
+        best = float("inf")
+        for _ in range(repeat):
+            start = time.time()
+            estimation.compute_transformation(source, target, corres)
+            best = min(best, time.time() - start)
+        print("%12d %16.0f" % (n_rows, n_rows / best))
@@ -0,0 +1,71 @@
+# Open3D: www.open3d.org
+# The MIT License (MIT)
+# See license file or visit www.open3d.org for details
+
+# examples/Python/Benchmark/benchmark_mesh_cleanup.py
+
+# Times the mesh cleanup steps and vertex clustering on a triangle soup, the
+# kind of mesh that marching cubes produces before its vertices are welded,
+# for increasing numbers of OpenMP threads. Every thread count runs in its own
+# process because OMP_NUM_THREADS is only read when the OpenMP runtime starts.
+
+import multiprocessing
+import os
+import subprocess
+import sys
+import time
+
+mesh_path = "../../TestData/knot.ply"
+number_of_subdivisions = 5
+voxel_size = 1.0
+
+
+def make_triangle_soup(mesh):
+    import numpy as np
+    import open3d as o3d
+    vertices = np.asarray(mesh.vertices)
+    triangles = np.asarray(mesh.triangles)
+    soup = o3d.geometry.TriangleMesh()
+    soup.vertices = o3d.utility.Vector3dVector(vertices[triangles.ravel()])
+    soup.triangles = o3d.utility.Vector3iVector(
+        np.arange(3 * len(triangles), dtype=np.int32).reshape(-1, 3))
+    return soup
+
+
+def run():
+    import open3d as o3d
+    mesh = o3d.io.read_triangle_mesh(mesh_path)
+    mesh = mesh.subdivide_loop(number_of_iterations=number_of_subdivisions)
+    mesh = make_triangle_soup(mesh)
+    output = []
+    start = time.time()
+    mesh.remove_duplicated_vertices()
+    output.append(time.time() - start)
+    start = time.time()
+    mesh.remove_duplicated_triangles()
+    output.append(time.time() - start)
+    start = time.time()
+    mesh.remove_unreferenced_vertices()
+    output.append(time.time() - start)
+    start = time.time()
+    mesh.simplify_vertex_clustering(voxel_size)
+    output.append(time.time() - start)
+    print(" ".join(["%f" % value for value in output]))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) > 1 and sys.argv[1] == "run":
+        run()
+        sys.exit(0)
+    print("%10s %16s %16s %16s %16s" %
+          ("threads", "vertices [s]", "triangles [s]", "unreferenced [s]",
+           "clustering [s]"))
+    num_threads = 1
+    while num_threads <= multiprocessing.cpu_count():
+        env = dict(os.environ, OMP_NUM_THREADS=str(num_threads))
+        output = subprocess.check_output([sys.executable, __file__, "run"],
+                                         env=env).decode().split()
+        print("%10d %16.3f %16.3f %16.3f %16.3f" %
+              (num_threads, float(output[0]), float(output[1]),
+               float(output[2]), float(output[3])))
+        num_threads *= 2
@@ -0,0 +1,66 @@
+# Open3D: www.open3d.org
+# The MIT License (MIT)
+# See license file or visit www.open3d.org for details
+
+# examples/Python/Benchmark/benchmark_normals.py
+
+# Reports the throughput of normal estimation in points per second, and the
+# time of normal plus FPFH estimation with and without shared neighborhoods.
+
+import time
+import numpy as np
+import open3d as o3d
+
+point_counts = [100000, 1000000, 5000000]
+repeat = 3
+
+
+def make_cloud(n_points):
+    # noisy unit sphere
+    rng = np.random.RandomState(0)
+    points = rng.normal(size=(n_points, 3))
+    points /= np.linalg.norm(points, axis=1)[:, None]
+    points += rng.normal(scale=1e-3, size=points.shape)
+    pcd = o3d.geometry.PointCloud()
+    pcd.points = o3d.utility.Vector3dVector(points)
+    return pcd
+
+
+def best_time(func):
+    times = []
+    for _ in range(repeat):
+        start = time.time()
+        func()
+        times.append(time.time() - start)
+    return min(times)
+
+
+def estimate_normals(pcd, param):
+    pcd.normals = o3d.utility.Vector3dVector()
+    pcd.estimate_normals(param)
+
+
+def normals_and_fpfh(pcd, param):
+    pcd.normals = o3d.utility.Vector3dVector()
+    pcd.estimate_normals(param)
+    o3d.registration.compute_fpfh_feature(pcd, param)
+
+
+def normals_and_fpfh_shared(pcd, param):
+    pcd.normals = o3d.utility.Vector3dVector()
+    neighborhoods = o3d.geometry.PointCloudNeighborhoods(pcd, param)
+    pcd.estimate_normals(neighborhoods)
+    o3d.registration.compute_fpfh_feature(pcd, neighborhoods)
+
+
+if __name__ == "__main__":
+    param = o3d.geometry.KDTreeSearchParamKNN(30)
+    print("%10s %16s %16s %16s" %
+          ("points", "normals [pt/s]", "+fpfh [s]", "+fpfh shared [s]"))
+    for n_points in point_counts:
+        pcd = make_cloud(n_points)
+        t_normals = best_time(lambda: estimate_normals(pcd, param))
+        t_fpfh = best_time(lambda: normals_and_fpfh(pcd, param))
+        t_shared = best_time(lambda: normals_and_fpfh_shared(pcd, param))
+        print("%10d %16.0f %16.3f %16.3f" %
+              (n_points, n_points / t_normals, t_fpfh, t_shared))
@@ -0,0 +1,48 @@
+# Open3D: www.open3d.org
+# The MIT License (MIT)
+# See license file or visit www.open3d.org for details
+
+# examples/Python/Benchmark/benchmark_pcd_io.py
+
+# Measures the throughput of reading and writing PCD files with binary and
+# binary_compressed data for point clouds of increasing size. Throughput is
+# given in bytes of point data per second, independent of the compression.
+
+import os
+import time
+import numpy as np
+import open3d as o3d
+
+file_path = "benchmark_pcd_io.pcd"
+number_of_points = [10**5, 10**6, 10**7]
+repeat = 3
+
+
+def measure(pcd, compressed):
+    write_time = float("inf")
+    read_time = float("inf")
+    for _ in range(repeat):
+        start = time.time()
+        o3d.io.write_point_cloud(file_path, pcd, compressed=compressed)
+        write_time = min(write_time, time.time() - start)
+        start = time.time()
+        o3d.io.read_point_cloud(file_path)
+        read_time = min(read_time, time.time() - start)
+    os.remove(file_path)
+    # Points, normals and colors are stored as 7 floats per point.
+    megabytes = len(pcd.points) * 7 * 4 / 1e6
+    return megabytes / write_time, megabytes / read_time
+
+
+if __name__ == "__main__":
+    print("%12s %12s %14s %14s" %
+          ("points", "compressed", "write [MB/s]", "read [MB/s]"))
+    for n in number_of_points:
+        pcd = o3d.geometry.PointCloud()
+        pcd.points = o3d.utility.Vector3dVector(np.random.uniform(size=(n, 3)))
+        pcd.estimate_normals(o3d.geometry.KDTreeSearchParamKNN(knn=10))
+        pcd.colors = o3d.utility.Vector3dVector(np.random.uniform(size=(n, 3)))
+        for compressed in [False, True]:
+            write_speed, read_speed = measure(pcd, compressed)
+            print("%12d %12s %14.1f %14.1f" %
+                  (n, compressed, write_speed, read_speed))
@@ -0,0 +1,63 @@
+# Open3D: www.open3d.org
+# The MIT License (MIT)
+# See license file or visit www.open3d.org for details
+
+# examples/Python/Benchmark/benchmark_ply_io.py
+
+# Measures the throughput of reading and writing binary PLY files for point
+# clouds and meshes of increasing size. Binary files are decoded from a memory
+# mapping, ASCII files go through rply and are listed for comparison.
+
+import os
+import time
+import numpy as np
+import open3d as o3d
+
+mesh_path = "../../TestData/knot.ply"
+file_path = "benchmark_ply_io.ply"
+number_of_subdivisions = [3, 4, 5, 6]
+repeat = 3
+
+
+def measure(write, read):
+    write_time = float("inf")
+    read_time = float("inf")
+    for _ in range(repeat):
+        start = time.time()
+        write()
+        write_time = min(write_time, time.time() - start)
+        start = time.time()
+        read()
+        read_time = min(read_time, time.time() - start)
+    gigabytes = os.path.getsize(file_path) / 1e9
+    os.remove(file_path)
+    return gigabytes, gigabytes / write_time, gigabytes / read_time
+
+
+if __name__ == "__main__":
+    print("%10s %10s %10s %10s %14s %14s" %
+          ("geometry", "ascii", "vertices", "size [GB]", "write [GB/s]",
+           "read [GB/s]"))
+    for n in number_of_subdivisions:
+        mesh = o3d.io.read_triangle_mesh(mesh_path)
+        mesh = mesh.subdivide_loop(number_of_iterations=n)
+        mesh.compute_vertex_normals()
+        mesh.vertex_colors = o3d.utility.Vector3dVector(
+            np.random.uniform(size=(len(mesh.vertices), 3)))
+        pcd = o3d.geometry.PointCloud()
+        pcd.points = mesh.vertices
+        pcd.normals = mesh.vertex_normals
+        pcd.colors = mesh.vertex_colors
+        for write_ascii in [False, True]:
+            result = measure(
+                lambda: o3d.io.write_point_cloud(
+                    file_path, pcd, write_ascii=write_ascii),
+                lambda: o3d.io.read_point_cloud(file_path))
+            print("%10s %10s %10d %10.3f %14.3f %14.3f" %
+                  (("pointcloud", write_ascii, len(pcd.points)) + result))
+            result = measure(
+                lambda: o3d.io.write_triangle_mesh(
+                    file_path, mesh, write_ascii=write_ascii),
+                lambda: o3d.io.read_triangle_mesh(file_path))
+            print("%10s %10s %10d %10.3f %14.3f %14.3f" %
+                  (("mesh", write_ascii, len(mesh.vertices)) + result))
@@ -0,0 +1,59 @@
+# Open3D: www.open3d.org
+# The MIT License (MIT)
+# See license file or visit www.open3d.org for details
+
+# examples/Python/Benchmark/benchmark_quadric_decimation.py
+
+# Measures how many input triangles per second quadric decimation processes,
+# serially and with the partitioned parallel rounds, for increasing numbers of
+# OpenMP threads. The mean distance of the simplified vertices to the input
+# mesh shows that both variants give a comparable quality. Every thread count
+# runs in its own process because OMP_NUM_THREADS is only read when the OpenMP
+# runtime starts.
+
+import multiprocessing
+import os
+import subprocess
+import sys
+import time
+
+mesh_path = "../../TestData/knot.ply"
+number_of_subdivisions = 5
+target_ratio = 0.05
+
+
+def run():
+    import numpy as np
+    import open3d as o3d
+    mesh = o3d.io.read_triangle_mesh(mesh_path)
+    mesh = mesh.subdivide_loop(number_of_iterations=number_of_subdivisions)
+    n_triangles = len(mesh.triangles)
+    target = int(target_ratio * n_triangles)
+    metrics = o3d.geometry.DistanceMetrics()
+    metrics.set_reference(mesh, 100000)
+    output = []
+    for parallel in [False, True]:
+        start = time.time()
+        simplified = mesh.simplify_quadric_decimation(target, parallel)
+        elapsed = time.time() - start
+        distance = np.mean(metrics.compute_distance(simplified.vertices))
+        output += [n_triangles / elapsed, distance]
+    print(" ".join(["%f" % value for value in output]))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) > 1 and sys.argv[1] == "run":
+        run()
+        sys.exit(0)
+    print("%10s %16s %16s %16s %16s" %
+          ("threads", "serial [tri/s]", "serial [dist]", "parallel [tri/s]",
+           "parallel [dist]"))
+    num_threads = 1
+    while num_threads <= multiprocessing.cpu_count():
+        env = dict(os.environ, OMP_NUM_THREADS=str(num_threads))
+        output = subprocess.check_output([sys.executable, __file__, "run"],
+                                         env=env).decode().split()
+        print("%10d %16.0f %16.6f %16.0f %16.6f" %
+              (num_threads, float(output[0]), float(output[1]),
+               float(output[2]), float(output[3])))
+        num_threads *= 2
@@ -0,0 +1,131 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "BenchmarkUtility/BenchmarkUtility.h"
+
+#include <Eigen/Dense>
+#include <cstdio>
+#include <random>
+#include <string>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "Open3D/IO/ClassIO/ImageIO.h"
+
+namespace benchmark_utility {
+
+ScopedNumThreads::ScopedNumThreads(int num_threads) {
+#ifdef _OPENMP
+    previous_num_threads_ = omp_get_max_threads();
+    omp_set_num_threads(num_threads);
+#else
+    previous_num_threads_ = 1;
+#endif
+}
+
+ScopedNumThreads::~ScopedNumThreads() {
+#ifdef _OPENMP
+    omp_set_num_threads(previous_num_threads_);
+#endif
+}
+
+std::vector<int64_t> GetNumThreads() {
+#ifdef _OPENMP
+    const int64_t max_num_threads = omp_get_max_threads();
+#else
+    const int64_t max_num_threads = 1;
+#endif
+    std::vector<int64_t> num_threads;
+    for (int64_t n = 1; n < max_num_threads; n *= 2) {
+        num_threads.push_back(n);
+    }
+    num_threads.push_back(max_num_threads);
+    return num_threads;
+}
+
+void SizesAndThreads(benchmark::internal::Benchmark *benchmark,
+                     const std::vector<int64_t> &sizes) {
+    benchmark->ArgNames({"size", "threads"});
+    benchmark->ArgsProduct({sizes, GetNumThreads()});
+    benchmark->Unit(benchmark::kMillisecond);
+    benchmark->UseRealTime();
+}
+
+void Threads(benchmark::internal::Benchmark *benchmark) {
+    benchmark->ArgName("threads");
+    for (int64_t num_threads : GetNumThreads()) {
+        benchmark->Arg(num_threads);
+    }
+    benchmark->Unit(benchmark::kMillisecond);
+    benchmark->UseRealTime();
+}
+
+std::shared_ptr<open3d::geometry::PointCloud> CreateSphere(int num_points,
+                                                           bool with_normals,
+                                                           bool with_colors) {
+    auto pointcloud = std::make_shared<open3d::geometry::PointCloud>();
+    std::mt19937 engine(0);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    pointcloud->points_.resize(num_points);
+    if (with_normals) {
+        pointcloud->normals_.resize(num_points);
+    }
+    if (with_colors) {
+        pointcloud->colors_.resize(num_points);
+    }
+    for (int i = 0; i < num_points; i++) {
+        Eigen::Vector3d direction(normal(engine), normal(engine),
+                                  normal(engine));
+        direction.normalize();
+        pointcloud->points_[i] = direction * (1.0 + 1e-3 * normal(engine));
+        if (with_normals) {
+            pointcloud->normals_[i] = direction;
+        }
+        if (with_colors) {
+            pointcloud->colors_[i] = Eigen::Vector3d(
+                    uniform(engine), uniform(engine), uniform(engine));
+        }
+    }
+    return pointcloud;
+}
+
+std::shared_ptr<open3d::geometry::RGBDImage> ReadRGBDFrame(
+        int index, bool convert_rgb_to_intensity) {
+    char name[16];
+    snprintf(name, sizeof(name), "%05d", index);
+    const std::string rgbd_dir = std::string(BENCHMARK_DATA_DIR) + "/RGBD/";
+    open3d::geometry::Image color;
+    open3d::geometry::Image depth;
+    open3d::io::ReadImage(rgbd_dir + "color/" + name + ".jpg", color);
+    open3d::io::ReadImage(rgbd_dir + "depth/" + name + ".png", depth);
+    return open3d::geometry::RGBDImage::CreateFromColorAndDepth(
+            color, depth, 1000.0, 3.0, convert_rgb_to_intensity);
+}
+
+}  // namespace benchmark_utility
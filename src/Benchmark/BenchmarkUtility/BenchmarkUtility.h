@@ -0,0 +1,80 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+// BENCHMARK_DATA_DIR defined in CMakeLists.txt
+// Put it here to avoid editor warnings
+#ifndef BENCHMARK_DATA_DIR
+#define BENCHMARK_DATA_DIR
+#endif
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/RGBDImage.h"
+
+namespace benchmark_utility {
+
+/// Sets the number of OpenMP threads for the lifetime of the object and
+/// restores the previous number afterwards. Does nothing without OpenMP.
+class ScopedNumThreads {
+public:
+    explicit ScopedNumThreads(int num_threads);
+    ~ScopedNumThreads();
+
+private:
+    int previous_num_threads_;
+};
+
+/// The numbers of threads every benchmark is run with: powers of two up to
+/// the number of processors, plus the number of processors itself.
+std::vector<int64_t> GetNumThreads();
+
+/// Registers one run per combination of \p sizes and GetNumThreads(). The
+/// size is state.range(0) and the number of threads state.range(1).
+void SizesAndThreads(benchmark::internal::Benchmark *benchmark,
+                     const std::vector<int64_t> &sizes);
+
+/// Registers one run per number of threads in GetNumThreads(), which is
+/// state.range(0), for benchmarks with inputs of a fixed size.
+void Threads(benchmark::internal::Benchmark *benchmark);
+
+/// A point cloud of \p num_points points sampled from a noisy unit sphere.
+/// Points are sampled with a fixed seed, so every run gets the same cloud.
+std::shared_ptr<open3d::geometry::PointCloud> CreateSphere(int num_points,
+                                                           bool with_normals,
+                                                           bool with_colors);
+
+/// The RGBD frame \p index of examples/TestData/RGBD, with a primesense
+/// camera and depth in meters.
+std::shared_ptr<open3d::geometry::RGBDImage> ReadRGBDFrame(
+        int index, bool convert_rgb_to_intensity);
+
+}  // namespace benchmark_utility
@@ -0,0 +1,57 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Geometry/DepthPreprocessor.h"
+#include "Open3D/Geometry/Image.h"
+#include "BenchmarkUtility/BenchmarkUtility.h"
+
+using namespace open3d;
+using namespace benchmark_utility;
+
+static void DepthPreprocessorProcess(benchmark::State &state) {
+    auto rgbd = ReadRGBDFrame(0, false);
+    const geometry::DepthPreprocessor preprocessor;
+    ScopedNumThreads num_threads(int(state.range(0)));
+    for (auto _ : state) {
+        auto depth = preprocessor.Process(rgbd->depth_);
+        benchmark::DoNotOptimize(depth);
+    }
+    state.SetItemsProcessed(state.iterations() * rgbd->depth_.width_ *
+                            rgbd->depth_.height_);
+}
+BENCHMARK(DepthPreprocessorProcess)->Apply(Threads);
+
+static void ImageFilterBilateral(benchmark::State &state) {
+    auto rgbd = ReadRGBDFrame(0, false);
+    ScopedNumThreads num_threads(int(state.range(0)));
+    for (auto _ : state) {
+        auto depth = rgbd->depth_.FilterBilateral();
+        benchmark::DoNotOptimize(depth);
+    }
+    state.SetItemsProcessed(state.iterations() * rgbd->depth_.width_ *
+                            rgbd->depth_.height_);
+}
+BENCHMARK(ImageFilterBilateral)->Apply(Threads);
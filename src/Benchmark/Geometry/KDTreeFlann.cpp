@@ -0,0 +1,106 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <cmath>
+#include <vector>
+
+#include "Open3D/Geometry/KDTreeFlann.h"
+#include "BenchmarkUtility/BenchmarkUtility.h"
+
+using namespace open3d;
+using namespace benchmark_utility;
+
+static void KDTreeFlannBuild(benchmark::State &state) {
+    auto pointcloud = CreateSphere(int(state.range(0)), false, false);
+    ScopedNumThreads num_threads(int(state.range(1)));
+    for (auto _ : state) {
+        geometry::KDTreeFlann kdtree(*pointcloud);
+        benchmark::DoNotOptimize(kdtree);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(KDTreeFlannBuild)->Apply([](benchmark::internal::Benchmark *b) {
+    SizesAndThreads(b, {100000, 1000000});
+});
+
+/// Searches the 30 nearest neighbors of every point, in parallel over the
+/// points as normal and feature estimation do.
+static void KDTreeFlannSearchKNN(benchmark::State &state) {
+    auto pointcloud = CreateSphere(int(state.range(0)), false, false);
+    geometry::KDTreeFlann kdtree(*pointcloud);
+    ScopedNumThreads num_threads(int(state.range(1)));
+    const int num_points = int(pointcloud->points_.size());
+    for (auto _ : state) {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            std::vector<int> indices;
+            std::vector<double> distance2;
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+            for (int i = 0; i < num_points; i++) {
+                kdtree.SearchKNN(pointcloud->points_[i], 30, indices,
+                                 distance2);
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(KDTreeFlannSearchKNN)->Apply([](benchmark::internal::Benchmark *b) {
+    SizesAndThreads(b, {100000, 1000000});
+});
+
+/// Searches at most 30 neighbors within a radius of about 5 point spacings.
+static void KDTreeFlannSearchHybrid(benchmark::State &state) {
+    auto pointcloud = CreateSphere(int(state.range(0)), false, false);
+    geometry::KDTreeFlann kdtree(*pointcloud);
+    ScopedNumThreads num_threads(int(state.range(1)));
+    const int num_points = int(pointcloud->points_.size());
+    const double radius = 5.0 * std::sqrt(4.0 * M_PI / num_points);
+    for (auto _ : state) {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            std::vector<int> indices;
+            std::vector<double> distance2;
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+            for (int i = 0; i < num_points; i++) {
+                kdtree.SearchHybrid(pointcloud->points_[i], radius, 30,
+                                    indices, distance2);
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(KDTreeFlannSearchHybrid)
+        ->Apply([](benchmark::internal::Benchmark *b) {
+            SizesAndThreads(b, {100000, 1000000});
+        });
@@ -0,0 +1,62 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Geometry/KDTreeSearchParam.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "BenchmarkUtility/BenchmarkUtility.h"
+
+using namespace open3d;
+using namespace benchmark_utility;
+
+static void PointCloudVoxelDownSample(benchmark::State &state) {
+    auto pointcloud = CreateSphere(int(state.range(0)), true, true);
+    ScopedNumThreads num_threads(int(state.range(1)));
+    for (auto _ : state) {
+        auto downsampled = pointcloud->VoxelDownSample(0.01);
+        benchmark::DoNotOptimize(downsampled);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(PointCloudVoxelDownSample)
+        ->Apply([](benchmark::internal::Benchmark *b) {
+            SizesAndThreads(b, {100000, 1000000, 10000000});
+        });
+
+static void PointCloudEstimateNormals(benchmark::State &state) {
+    auto pointcloud = CreateSphere(int(state.range(0)), false, false);
+    ScopedNumThreads num_threads(int(state.range(1)));
+    for (auto _ : state) {
+        state.PauseTiming();
+        pointcloud->normals_.clear();
+        state.ResumeTiming();
+        pointcloud->EstimateNormals(geometry::KDTreeSearchParamKNN(30));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(PointCloudEstimateNormals)
+        ->Apply([](benchmark::internal::Benchmark *b) {
+            SizesAndThreads(b, {100000, 1000000});
+        });
@@ -0,0 +1,92 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <cstdio>
+#include <string>
+
+#include "Open3D/IO/ClassIO/PointCloudIO.h"
+#include "BenchmarkUtility/BenchmarkUtility.h"
+
+using namespace open3d;
+using namespace benchmark_utility;
+
+namespace {
+
+/// Bytes of point data of a point cloud with points, normals and colors.
+int64_t GetPointBytes(int64_t num_points) { return num_points * 9 * 8; }
+
+void WritePointCloud(benchmark::State &state, const std::string &filename) {
+    auto pointcloud = CreateSphere(int(state.range(0)), true, true);
+    ScopedNumThreads num_threads(int(state.range(1)));
+    for (auto _ : state) {
+        io::WritePointCloud(filename, *pointcloud, false, false, false);
+    }
+    std::remove(filename.c_str());
+    state.SetBytesProcessed(state.iterations() * GetPointBytes(state.range(0)));
+}
+
+void ReadPointCloud(benchmark::State &state, const std::string &filename) {
+    auto pointcloud = CreateSphere(int(state.range(0)), true, true);
+    io::WritePointCloud(filename, *pointcloud, false, false, false);
+    ScopedNumThreads num_threads(int(state.range(1)));
+    for (auto _ : state) {
+        geometry::PointCloud read;
+        io::ReadPointCloud(filename, read, "auto", false, false);
+        benchmark::DoNotOptimize(read);
+    }
+    std::remove(filename.c_str());
+    state.SetBytesProcessed(state.iterations() * GetPointBytes(state.range(0)));
+}
+
+}  // unnamed namespace
+
+static void WritePointCloudToPLY(benchmark::State &state) {
+    WritePointCloud(state, "benchmark_tmp.ply");
+}
+BENCHMARK(WritePointCloudToPLY)->Apply([](benchmark::internal::Benchmark *b) {
+    SizesAndThreads(b, {100000, 1000000});
+});
+
+static void ReadPointCloudFromPLY(benchmark::State &state) {
+    ReadPointCloud(state, "benchmark_tmp.ply");
+}
+BENCHMARK(ReadPointCloudFromPLY)->Apply([](benchmark::internal::Benchmark *b) {
+    SizesAndThreads(b, {100000, 1000000});
+});
+
+static void WritePointCloudToPCD(benchmark::State &state) {
+    WritePointCloud(state, "benchmark_tmp.pcd");
+}
+BENCHMARK(WritePointCloudToPCD)->Apply([](benchmark::internal::Benchmark *b) {
+    SizesAndThreads(b, {100000, 1000000});
+});
+
+static void ReadPointCloudFromPCD(benchmark::State &state) {
+    ReadPointCloud(state, "benchmark_tmp.pcd");
+}
+BENCHMARK(ReadPointCloudFromPCD)->Apply([](benchmark::internal::Benchmark *b) {
+    SizesAndThreads(b, {100000, 1000000});
+});
@@ -0,0 +1,122 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <cstdio>
+#include <string>
+
+#include "Open3D/Camera/PinholeCameraIntrinsic.h"
+#include "Open3D/IO/ClassIO/TSDFVolumeIO.h"
+#include "Open3D/Utility/FileSystem.h"
+#include "BenchmarkUtility/BenchmarkUtility.h"
+
+using namespace open3d;
+using namespace benchmark_utility;
+
+namespace {
+
+const int kNumFrames = 4;
+
+/// The volume of the ScalableTSDFVolumeIntegrate benchmark, whose time is what
+/// reading a saved volume avoids. The size argument is the voxel length in
+/// millimeters.
+integration::ScalableTSDFVolume CreateIntegratedVolume(
+        int64_t voxel_length_mm) {
+    const double voxel_length = voxel_length_mm / 1000.0;
+    integration::ScalableTSDFVolume volume(
+            voxel_length, 5.0 * voxel_length,
+            integration::TSDFVolumeColorType::RGB8);
+    const camera::PinholeCameraIntrinsic intrinsic(
+            camera::PinholeCameraIntrinsicParameters::PrimeSenseDefault);
+    for (int i = 0; i < kNumFrames; i++) {
+        auto rgbd = ReadRGBDFrame(i, false);
+        Eigen::Matrix4d extrinsic = Eigen::Matrix4d::Identity();
+        extrinsic(0, 3) = 0.01 * i;
+        volume.Integrate(*rgbd, intrinsic, extrinsic);
+    }
+    return volume;
+}
+
+void WriteTSDFVolume(benchmark::State &state, bool compressed) {
+    auto volume = CreateIntegratedVolume(state.range(0));
+    const std::string filename = "benchmark_tmp.tsdf";
+    ScopedNumThreads num_threads(int(state.range(1)));
+    for (auto _ : state) {
+        io::WriteTSDFVolume(filename, volume, compressed);
+    }
+    utility::filesystem::MappedFile file;
+    if (file.Open(filename)) {
+        state.counters["file_bytes"] = double(file.GetSize());
+    }
+    file.Close();
+    std::remove(filename.c_str());
+}
+
+void ReadTSDFVolume(benchmark::State &state, bool compressed) {
+    const std::string filename = "benchmark_tmp.tsdf";
+    io::WriteTSDFVolume(filename, CreateIntegratedVolume(state.range(0)),
+                        compressed);
+    ScopedNumThreads num_threads(int(state.range(1)));
+    for (auto _ : state) {
+        integration::ScalableTSDFVolume volume(
+                0.01, 0.05, integration::TSDFVolumeColorType::None);
+        io::ReadTSDFVolume(filename, volume);
+        benchmark::DoNotOptimize(volume);
+    }
+    std::remove(filename.c_str());
+}
+
+}  // unnamed namespace
+
+static void WriteTSDFVolumeToTSDF(benchmark::State &state) {
+    WriteTSDFVolume(state, false);
+}
+BENCHMARK(WriteTSDFVolumeToTSDF)->Apply([](benchmark::internal::Benchmark *b) {
+    SizesAndThreads(b, {8, 4});
+});
+
+static void WriteTSDFVolumeToTSDFCompressed(benchmark::State &state) {
+    WriteTSDFVolume(state, true);
+}
+BENCHMARK(WriteTSDFVolumeToTSDFCompressed)
+        ->Apply([](benchmark::internal::Benchmark *b) {
+            SizesAndThreads(b, {8, 4});
+        });
+
+static void ReadTSDFVolumeFromTSDF(benchmark::State &state) {
+    ReadTSDFVolume(state, false);
+}
+BENCHMARK(ReadTSDFVolumeFromTSDF)
+        ->Apply([](benchmark::internal::Benchmark *b) {
+            SizesAndThreads(b, {8, 4});
+        });
+
+static void ReadTSDFVolumeFromTSDFCompressed(benchmark::State &state) {
+    ReadTSDFVolume(state, true);
+}
+BENCHMARK(ReadTSDFVolumeFromTSDFCompressed)
+        ->Apply([](benchmark::internal::Benchmark *b) {
+            SizesAndThreads(b, {8, 4});
+        });
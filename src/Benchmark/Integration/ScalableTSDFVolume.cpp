@@ -0,0 +1,197 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <memory>
+#include <vector>
+
+#include "Open3D/Camera/PinholeCameraIntrinsic.h"
+#include "Open3D/Geometry/DepthPreprocessor.h"
+#include "Open3D/Integration/ScalableTSDFVolume.h"
+#include "BenchmarkUtility/BenchmarkUtility.h"
+
+using namespace open3d;
+using namespace benchmark_utility;
+
+namespace {
+
+const int kNumFrames = 4;
+
+/// The size argument is the voxel length in millimeters.
+std::shared_ptr<integration::ScalableTSDFVolume> CreateVolume(
+        int64_t voxel_length_mm) {
+    const double voxel_length = voxel_length_mm / 1000.0;
+    return std::make_shared<integration::ScalableTSDFVolume>(
+            voxel_length, 5.0 * voxel_length,
+            integration::TSDFVolumeColorType::RGB8);
+}
+
+/// Integrates the first frames of examples/TestData/RGBD with a camera that
+/// moves a little between them.
+void IntegrateFrames(integration::ScalableTSDFVolume &volume) {
+    const camera::PinholeCameraIntrinsic intrinsic(
+            camera::PinholeCameraIntrinsicParameters::PrimeSenseDefault);
+    for (int i = 0; i < kNumFrames; i++) {
+        auto rgbd = ReadRGBDFrame(i, false);
+        Eigen::Matrix4d extrinsic = Eigen::Matrix4d::Identity();
+        extrinsic(0, 3) = 0.01 * i;
+        volume.Integrate(*rgbd, intrinsic, extrinsic);
+    }
+}
+
+}  // unnamed namespace
+
+static void ScalableTSDFVolumeIntegrate(benchmark::State &state) {
+    const camera::PinholeCameraIntrinsic intrinsic(
+            camera::PinholeCameraIntrinsicParameters::PrimeSenseDefault);
+    std::vector<std::shared_ptr<geometry::RGBDImage>> frames;
+    for (int i = 0; i < kNumFrames; i++) {
+        frames.push_back(ReadRGBDFrame(i, false));
+    }
+    ScopedNumThreads num_threads(int(state.range(1)));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto volume = CreateVolume(state.range(0));
+        state.ResumeTiming();
+        for (int i = 0; i < kNumFrames; i++) {
+            Eigen::Matrix4d extrinsic = Eigen::Matrix4d::Identity();
+            extrinsic(0, 3) = 0.01 * i;
+            volume->Integrate(*frames[i], intrinsic, extrinsic);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kNumFrames);
+}
+BENCHMARK(ScalableTSDFVolumeIntegrate)
+        ->Apply([](benchmark::internal::Benchmark *b) {
+            SizesAndThreads(b, {8, 4});
+        });
+
+/// Integrates preprocessed frames into 8 mm voxels. The size argument is the
+/// depth sampling stride that selects the volume units.
+static void ScalableTSDFVolumeIntegratePreprocessed(benchmark::State &state) {
+    const camera::PinholeCameraIntrinsic intrinsic(
+            camera::PinholeCameraIntrinsicParameters::PrimeSenseDefault);
+    const geometry::DepthPreprocessor preprocessor;
+    std::vector<std::shared_ptr<geometry::RGBDImage>> frames;
+    for (int i = 0; i < kNumFrames; i++) {
+        frames.push_back(preprocessor.Process(*ReadRGBDFrame(i, false)));
+    }
+    ScopedNumThreads num_threads(int(state.range(1)));
+    for (auto _ : state) {
+        state.PauseTiming();
+        integration::ScalableTSDFVolume volume(
+                0.008, 0.04, integration::TSDFVolumeColorType::RGB8, 16,
+                int(state.range(0)));
+        state.ResumeTiming();
+        for (int i = 0; i < kNumFrames; i++) {
+            Eigen::Matrix4d extrinsic = Eigen::Matrix4d::Identity();
+            extrinsic(0, 3) = 0.01 * i;
+            volume.Integrate(*frames[i], intrinsic, extrinsic);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kNumFrames);
+}
+BENCHMARK(ScalableTSDFVolumeIntegratePreprocessed)
+        ->Apply([](benchmark::internal::Benchmark *b) {
+            SizesAndThreads(b, {1, 4, 16});
+        });
+
+/// Integrates with paging and a budget below the number of units that every
+/// frame touches, so that each frame reads and writes units to the disk.
+static void ScalableTSDFVolumeIntegratePaged(benchmark::State &state) {
+    const camera::PinholeCameraIntrinsic intrinsic(
+            camera::PinholeCameraIntrinsicParameters::PrimeSenseDefault);
+    std::vector<std::shared_ptr<geometry::RGBDImage>> frames;
+    for (int i = 0; i < kNumFrames; i++) {
+        frames.push_back(ReadRGBDFrame(i, false));
+    }
+    ScopedNumThreads num_threads(int(state.range(1)));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto volume = CreateVolume(state.range(0));
+        volume->EnablePaging("benchmark_volume_units.bin", 256);
+        state.ResumeTiming();
+        for (int i = 0; i < kNumFrames; i++) {
+            Eigen::Matrix4d extrinsic = Eigen::Matrix4d::Identity();
+            extrinsic(0, 3) = 0.01 * i;
+            volume->Integrate(*frames[i], intrinsic, extrinsic);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kNumFrames);
+}
+BENCHMARK(ScalableTSDFVolumeIntegratePaged)
+        ->Apply([](benchmark::internal::Benchmark *b) {
+            SizesAndThreads(b, {8, 4});
+        });
+
+static void ScalableTSDFVolumeExtractTriangleMesh(benchmark::State &state) {
+    auto volume = CreateVolume(state.range(0));
+    IntegrateFrames(*volume);
+    ScopedNumThreads num_threads(int(state.range(1)));
+    for (auto _ : state) {
+        auto mesh = volume->ExtractTriangleMesh();
+        benchmark::DoNotOptimize(mesh);
+    }
+}
+BENCHMARK(ScalableTSDFVolumeExtractTriangleMesh)
+        ->Apply([](benchmark::internal::Benchmark *b) {
+            SizesAndThreads(b, {8, 4});
+        });
+
+static void ScalableTSDFVolumeExtractPointCloud(benchmark::State &state) {
+    auto volume = CreateVolume(state.range(0));
+    IntegrateFrames(*volume);
+    ScopedNumThreads num_threads(int(state.range(1)));
+    for (auto _ : state) {
+        auto pointcloud = volume->ExtractPointCloud();
+        benchmark::DoNotOptimize(pointcloud);
+    }
+}
+BENCHMARK(ScalableTSDFVolumeExtractPointCloud)
+        ->Apply([](benchmark::internal::Benchmark *b) {
+            SizesAndThreads(b, {8, 4});
+        });
+
+/// Renders VGA depth, normal and color images from the pose of the last
+/// integrated frame.
+static void ScalableTSDFVolumeRaycast(benchmark::State &state) {
+    const camera::PinholeCameraIntrinsic intrinsic(
+            camera::PinholeCameraIntrinsicParameters::PrimeSenseDefault);
+    auto volume = CreateVolume(state.range(0));
+    IntegrateFrames(*volume);
+    Eigen::Matrix4d extrinsic = Eigen::Matrix4d::Identity();
+    extrinsic(0, 3) = 0.01 * (kNumFrames - 1);
+    geometry::Image depth, normal, color;
+    ScopedNumThreads num_threads(int(state.range(1)));
+    for (auto _ : state) {
+        volume->Raycast(intrinsic, extrinsic, depth, normal, color);
+    }
+    state.SetItemsProcessed(state.iterations() * intrinsic.width_ *
+                            intrinsic.height_);
+}
+BENCHMARK(ScalableTSDFVolumeRaycast)
+        ->Apply([](benchmark::internal::Benchmark *b) {
+            SizesAndThreads(b, {8, 4});
+        });
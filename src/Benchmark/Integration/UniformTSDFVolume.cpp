@@ -0,0 +1,146 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <memory>
+#include <new>
+
+#include "Open3D/Camera/PinholeCameraIntrinsic.h"
+#include "Open3D/Integration/UniformTSDFVolume.h"
+#include "BenchmarkUtility/BenchmarkUtility.h"
+
+using namespace open3d;
+using namespace benchmark_utility;
+
+namespace {
+
+/// A 4 m cube around the camera of examples/TestData/RGBD, of which the camera
+/// sees a small part. A voxel takes 48 bytes, so resolution 512 needs 6.4 GB
+/// and 1024 needs 52 GB of memory. Returns nullptr and skips the benchmark if
+/// the volume cannot be allocated.
+std::unique_ptr<integration::UniformTSDFVolume> CreateVolume(
+        benchmark::State &state, int resolution) {
+    std::unique_ptr<integration::UniformTSDFVolume> volume;
+    try {
+        volume.reset(new integration::UniformTSDFVolume(
+                4.0, resolution, 4.0 / resolution * 5.0,
+                integration::TSDFVolumeColorType::RGB8,
+                Eigen::Vector3d(-2.0, -2.0, -0.5)));
+    } catch (const std::bad_alloc &) {
+        state.SkipWithError("Not enough memory for the volume.");
+    }
+    return volume;
+}
+
+/// CreateVolume with the first frames of examples/TestData/RGBD integrated.
+std::unique_ptr<integration::UniformTSDFVolume> CreateIntegratedVolume(
+        benchmark::State &state, int resolution) {
+    auto volume = CreateVolume(state, resolution);
+    if (volume) {
+        const camera::PinholeCameraIntrinsic intrinsic(
+                camera::PinholeCameraIntrinsicParameters::PrimeSenseDefault);
+        for (int i = 0; i < 4; i++) {
+            Eigen::Matrix4d extrinsic = Eigen::Matrix4d::Identity();
+            extrinsic(0, 3) = 0.01 * i;
+            volume->Integrate(*ReadRGBDFrame(i, false), intrinsic, extrinsic);
+        }
+    }
+    return volume;
+}
+
+}  // unnamed namespace
+
+/// Integrates a frame into CreateVolume. The size argument is the resolution.
+/// Items per second are frames per second.
+static void UniformTSDFVolumeIntegrate(benchmark::State &state) {
+    const camera::PinholeCameraIntrinsic intrinsic(
+            camera::PinholeCameraIntrinsicParameters::PrimeSenseDefault);
+    auto rgbd = ReadRGBDFrame(0, false);
+    auto volume = CreateVolume(state, int(state.range(0)));
+    if (!volume) {
+        return;
+    }
+    ScopedNumThreads num_threads(int(state.range(1)));
+    for (auto _ : state) {
+        volume->Integrate(*rgbd, intrinsic, Eigen::Matrix4d::Identity());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(UniformTSDFVolumeIntegrate)
+        ->Apply([](benchmark::internal::Benchmark *b) {
+            SizesAndThreads(b, {256, 512, 1024});
+        });
+
+/// Extraction visits all voxels, so items per second are voxels per second.
+static void UniformTSDFVolumeExtractTriangleMesh(benchmark::State &state) {
+    auto volume = CreateIntegratedVolume(state, int(state.range(0)));
+    if (!volume) {
+        return;
+    }
+    ScopedNumThreads num_threads(int(state.range(1)));
+    for (auto _ : state) {
+        auto mesh = volume->ExtractTriangleMesh();
+        benchmark::DoNotOptimize(mesh);
+    }
+    state.SetItemsProcessed(state.iterations() * volume->voxel_num_);
+}
+BENCHMARK(UniformTSDFVolumeExtractTriangleMesh)
+        ->Apply([](benchmark::internal::Benchmark *b) {
+            SizesAndThreads(b, {128, 256, 512});
+        });
+
+static void UniformTSDFVolumeExtractPointCloud(benchmark::State &state) {
+    auto volume = CreateIntegratedVolume(state, int(state.range(0)));
+    if (!volume) {
+        return;
+    }
+    ScopedNumThreads num_threads(int(state.range(1)));
+    for (auto _ : state) {
+        auto pointcloud = volume->ExtractPointCloud();
+        benchmark::DoNotOptimize(pointcloud);
+    }
+    state.SetItemsProcessed(state.iterations() * volume->voxel_num_);
+}
+BENCHMARK(UniformTSDFVolumeExtractPointCloud)
+        ->Apply([](benchmark::internal::Benchmark *b) {
+            SizesAndThreads(b, {128, 256, 512});
+        });
+
+static void UniformTSDFVolumeExtractVoxelGrid(benchmark::State &state) {
+    auto volume = CreateIntegratedVolume(state, int(state.range(0)));
+    if (!volume) {
+        return;
+    }
+    ScopedNumThreads num_threads(int(state.range(1)));
+    for (auto _ : state) {
+        auto voxel_grid = volume->ExtractVoxelGrid();
+        benchmark::DoNotOptimize(voxel_grid);
+    }
+    state.SetItemsProcessed(state.iterations() * volume->voxel_num_);
+}
+BENCHMARK(UniformTSDFVolumeExtractVoxelGrid)
+        ->Apply([](benchmark::internal::Benchmark *b) {
+            SizesAndThreads(b, {128, 256, 512});
+        });
@@ -0,0 +1,84 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <Eigen/Geometry>
+
+#include "Open3D/Registration/Registration.h"
+#include "Open3D/Registration/TransformationEstimation.h"
+#include "BenchmarkUtility/BenchmarkUtility.h"
+
+using namespace open3d;
+using namespace benchmark_utility;
+
+namespace {
+
+/// A small rigid motion of the source onto the target.
+Eigen::Matrix4d GetPerturbation() {
+    Eigen::Matrix4d transformation = Eigen::Matrix4d::Identity();
+    transformation.block<3, 3>(0, 0) =
+            Eigen::AngleAxisd(0.05, Eigen::Vector3d(1, 2, 3).normalized())
+                    .toRotationMatrix();
+    transformation.block<3, 1>(0, 3) = Eigen::Vector3d(0.01, -0.02, 0.01);
+    return transformation;
+}
+
+/// Runs 30 iterations of ICP of a sphere onto a perturbed copy of itself.
+void RegistrationICP(benchmark::State &state,
+                     const registration::TransformationEstimation &estimation) {
+    auto target = CreateSphere(int(state.range(0)), true, false);
+    geometry::PointCloud source = *target;
+    source.Transform(GetPerturbation());
+    const registration::ICPConvergenceCriteria criteria(0.0, 0.0, 30);
+    ScopedNumThreads num_threads(int(state.range(1)));
+    for (auto _ : state) {
+        auto result = registration::RegistrationICP(
+                source, *target, 0.1, Eigen::Matrix4d::Identity(), estimation,
+                criteria);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) *
+                            criteria.max_iteration_);
+}
+
+}  // unnamed namespace
+
+static void RegistrationICPPointToPoint(benchmark::State &state) {
+    RegistrationICP(state,
+                    registration::TransformationEstimationPointToPoint());
+}
+BENCHMARK(RegistrationICPPointToPoint)
+        ->Apply([](benchmark::internal::Benchmark *b) {
+            SizesAndThreads(b, {10000, 100000});
+        });
+
+static void RegistrationICPPointToPlane(benchmark::State &state) {
+    RegistrationICP(state,
+                    registration::TransformationEstimationPointToPlane());
+}
+BENCHMARK(RegistrationICPPointToPlane)
+        ->Apply([](benchmark::internal::Benchmark *b) {
+            SizesAndThreads(b, {10000, 100000});
+        });
@@ -0,0 +1,51 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+
+#include "Open3D/Utility/Profiler.h"
+#include "BenchmarkUtility/BenchmarkUtility.h"
+
+using namespace open3d;
+using namespace benchmark_utility;
+
+/// Cost of opening and closing one zone while the profiler is disabled
+/// (range 0) and enabled (range 1). Recorded zones are cleared after every
+/// batch to keep the memory bounded.
+static void ProfileZone(benchmark::State &state) {
+    const int batch_size = 1024;
+    utility::Profiler &profiler = utility::Profiler::i();
+    profiler.Clear();
+    profiler.SetEnabled(state.range(0) != 0);
+    for (auto _ : state) {
+        for (int i = 0; i < batch_size; i++) {
+            utility::ProfileZone zone("Benchmark");
+        }
+        profiler.Clear();
+    }
+    profiler.SetEnabled(false);
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+BENCHMARK(ProfileZone)->ArgName("enabled")->Arg(0)->Arg(1);
@@ -26,6 +26,9 @@
 
 #include "Open3D/ColorMap/ColorMapOptimization.h"
 
+#include <list>
+#include <unordered_map>
+
 #include "Open3D/Camera/PinholeCameraTrajectory.h"
 #include "Open3D/ColorMap/ColorMapOptimizationJacobian.h"
 #include "Open3D/ColorMap/ImageWarpingField.h"
@@ -34,6 +37,7 @@
 #include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Geometry/RGBDImage.h"
 #include "Open3D/Geometry/TriangleMesh.h"
+#include "Open3D/IO/ClassIO/ImageIO.h"
 #include "Open3D/IO/ClassIO/ImageWarpingFieldIO.h"
 #include "Open3D/IO/ClassIO/PinholeCameraTrajectoryIO.h"
 #include "Open3D/Utility/Console.h"
@@ -214,6 +218,20 @@ void OptimizeImageCoorRigid(
     }
 }
 
+std::tuple<std::shared_ptr<geometry::Image>,
+           std::shared_ptr<geometry::Image>,
+           std::shared_ptr<geometry::Image>>
+CreateGradientImages(const geometry::RGBDImage& image_rgbd) {
+    auto gray_image = image_rgbd.color_.CreateFloatImage();
+    auto gray_image_filtered =
+            gray_image->Filter(geometry::Image::FilterType::Gaussian3);
+    return std::make_tuple(gray_image_filtered,
+                           gray_image_filtered->Filter(
+                                   geometry::Image::FilterType::Sobel3Dx),
+                           gray_image_filtered->Filter(
+                                   geometry::Image::FilterType::Sobel3Dy));
+}
+
 std::tuple<std::vector<std::shared_ptr<geometry::Image>>,
            std::vector<std::shared_ptr<geometry::Image>>,
            std::vector<std::shared_ptr<geometry::Image>>,
@@ -227,14 +245,11 @@ CreateGradientImages(
     std::vector<std::shared_ptr<geometry::Image>> images_color;
     std::vector<std::shared_ptr<geometry::Image>> images_depth;
     for (size_t i = 0; i < images_rgbd.size(); i++) {
-        auto gray_image = images_rgbd[i]->color_.CreateFloatImage();
-        auto gray_image_filtered =
-                gray_image->Filter(geometry::Image::FilterType::Gaussian3);
-        images_gray.push_back(gray_image_filtered);
-        images_dx.push_back(gray_image_filtered->Filter(
-                geometry::Image::FilterType::Sobel3Dx));
-        images_dy.push_back(gray_image_filtered->Filter(
-                geometry::Image::FilterType::Sobel3Dy));
+        std::shared_ptr<geometry::Image> gray, dx, dy;
+        std::tie(gray, dx, dy) = CreateGradientImages(*images_rgbd[i]);
+        images_gray.push_back(gray);
+        images_dx.push_back(dx);
+        images_dy.push_back(dy);
         auto color = std::make_shared<geometry::Image>(images_rgbd[i]->color_);
         auto depth = std::make_shared<geometry::Image>(images_rgbd[i]->depth_);
         images_color.push_back(color);
@@ -272,6 +287,268 @@ std::vector<ImageWarpingField> CreateWarpingFields(
     return fields;
 }
 
+std::shared_ptr<geometry::RGBDImage> LoadKeyframe(
+        const RGBDImageProvider& image_provider, int index) {
+    auto image_rgbd = image_provider(index);
+    if (image_rgbd == nullptr || image_rgbd->IsEmpty()) {
+        utility::LogWarning(
+                "[ColorMapOptimization] Unable to load keyframe {:d}.\n",
+                index);
+        return nullptr;
+    }
+    return image_rgbd;
+}
+
+/// Bounded LRU cache of the gray, dx and dy images of keyframes loaded
+/// through an RGBDImageProvider. Not thread safe, the streaming optimization
+/// visits the keyframes one at a time and parallelizes within a keyframe.
+class GradientImageCache {
+public:
+    struct Entry {
+        std::shared_ptr<geometry::Image> gray_;
+        std::shared_ptr<geometry::Image> dx_;
+        std::shared_ptr<geometry::Image> dy_;
+    };
+
+public:
+    GradientImageCache(const RGBDImageProvider& image_provider,
+                       size_t capacity)
+        : image_provider_(image_provider),
+          capacity_(std::max(capacity, size_t(1))) {}
+
+    /// Returns the gradient images of keyframe \p index, or an entry of null
+    /// images if the keyframe cannot be loaded.
+    Entry Get(int index) {
+        auto found = entries_.find(index);
+        if (found != entries_.end()) {
+            lru_.splice(lru_.begin(), lru_, found->second.second);
+            return found->second.first;
+        }
+        Entry entry;
+        auto image_rgbd = LoadKeyframe(image_provider_, index);
+        if (image_rgbd == nullptr) {
+            return entry;
+        }
+        if (entries_.size() >= capacity_) {
+            entries_.erase(lru_.back());
+            lru_.pop_back();
+        }
+        std::tie(entry.gray_, entry.dx_, entry.dy_) =
+                CreateGradientImages(*image_rgbd);
+        lru_.push_front(index);
+        entries_.emplace(index, std::make_pair(entry, lru_.begin()));
+        return entry;
+    }
+
+private:
+    const RGBDImageProvider& image_provider_;
+    size_t capacity_;
+    std::list<int> lru_;
+    std::unordered_map<int, std::pair<Entry, std::list<int>::iterator>>
+            entries_;
+};
+
+/// Order in which the keyframes are visited in iteration \p itr. Going back
+/// and forth lets every iteration start with the keyframes that the previous
+/// one left in the cache, a cyclic order would evict each of them right
+/// before it is needed again.
+std::vector<int> StreamingKeyframeOrder(int n_camera, int itr) {
+    std::vector<int> order(n_camera);
+    for (int c = 0; c < n_camera; c++) {
+        order[c] = itr % 2 == 0 ? c : n_camera - 1 - c;
+    }
+    return order;
+}
+
+void SetProxyIntensityFromAccumulation(
+        const std::vector<double>& proxy_intensity_sum,
+        const std::vector<double>& proxy_intensity_count,
+        std::vector<double>& proxy_intensity) {
+    proxy_intensity.resize(proxy_intensity_sum.size());
+    for (size_t i = 0; i < proxy_intensity_sum.size(); i++) {
+        proxy_intensity[i] =
+                proxy_intensity_count[i] > 0
+                        ? proxy_intensity_sum[i] / proxy_intensity_count[i]
+                        : 0.0;
+    }
+}
+
+void OptimizeImageCoorRigidStreaming(
+        const geometry::TriangleMesh& mesh,
+        GradientImageCache& cache,
+        camera::PinholeCameraTrajectory& camera,
+        const std::vector<std::vector<int>>& visiblity_image_to_vertex,
+        std::vector<double>& proxy_intensity,
+        const ColorMapOptimizationOption& option) {
+    auto n_vertex = mesh.vertices_.size();
+    int n_camera = int(camera.parameters_.size());
+    std::vector<double> proxy_sum(n_vertex, 0.0), proxy_count(n_vertex, 0.0);
+    for (int c : StreamingKeyframeOrder(n_camera, 1)) {
+        if (visiblity_image_to_vertex[c].empty()) continue;
+        auto entry = cache.Get(c);
+        if (entry.gray_ == nullptr) continue;
+        AccumulateProxyIntensityForImage(
+                mesh, *entry.gray_, camera, c,
+                visiblity_image_to_vertex[c], proxy_sum, proxy_count,
+                option.image_boundary_margin_);
+    }
+    SetProxyIntensityFromAccumulation(proxy_sum, proxy_count, proxy_intensity);
+    for (int itr = 0; itr < option.maximum_iteration_; itr++) {
+        utility::LogDebug("[Iteration {:04d}] ", itr + 1);
+        double residual = 0.0;
+        int total_num_ = 0;
+        std::fill(proxy_sum.begin(), proxy_sum.end(), 0.0);
+        std::fill(proxy_count.begin(), proxy_count.end(), 0.0);
+        // Every camera is updated against the proxy intensity of the previous
+        // iteration, so the proxy of the next iteration can be accumulated
+        // right after each update while the keyframe is still in the cache.
+        for (int c : StreamingKeyframeOrder(n_camera, itr)) {
+            // A keyframe without visible vertices has an empty system and
+            // keeps its pose, so it does not need to be loaded.
+            if (visiblity_image_to_vertex[c].empty()) continue;
+            auto entry = cache.Get(c);
+            if (entry.gray_ == nullptr) continue;
+            auto intrinsic = camera.parameters_[c].intrinsic_.intrinsic_matrix_;
+            auto extrinsic = camera.parameters_[c].extrinsic_;
+            ColorMapOptimizationJacobian jac;
+            Eigen::Matrix4d intr = Eigen::Matrix4d::Zero();
+            intr.block<3, 3>(0, 0) = intrinsic;
+            intr(3, 3) = 1.0;
+
+            auto f_lambda = [&](int i, Eigen::Vector6d& J_r, double& r) {
+                jac.ComputeJacobianAndResidualRigid(
+                        i, J_r, r, mesh, proxy_intensity, entry.gray_,
+                        entry.dx_, entry.dy_, intr, extrinsic,
+                        visiblity_image_to_vertex[c],
+                        option.image_boundary_margin_);
+            };
+            Eigen::Matrix6d JTJ;
+            Eigen::Vector6d JTr;
+            double r2;
+            std::tie(JTJ, JTr, r2) =
+                    utility::ComputeJTJandJTr<Eigen::Matrix6d, Eigen::Vector6d>(
+                            f_lambda, int(visiblity_image_to_vertex[c].size()),
+                            false);
+
+            bool is_success;
+            Eigen::Matrix4d delta;
+            std::tie(is_success, delta) =
+                    utility::SolveJacobianSystemAndObtainExtrinsicMatrix(JTJ,
+                                                                         JTr);
+            camera.parameters_[c].extrinsic_ = delta * extrinsic;
+            residual += r2;
+            total_num_ += int(visiblity_image_to_vertex[c].size());
+
+            AccumulateProxyIntensityForImage(
+                    mesh, *entry.gray_, camera, c,
+                    visiblity_image_to_vertex[c], proxy_sum, proxy_count,
+                    option.image_boundary_margin_);
+        }
+        utility::LogDebug("Residual error : {:.6f} (avg : {:.6f})\n", residual,
+                          residual / total_num_);
+        SetProxyIntensityFromAccumulation(proxy_sum, proxy_count,
+                                          proxy_intensity);
+    }
+}
+
+void OptimizeImageCoorNonrigidStreaming(
+        const geometry::TriangleMesh& mesh,
+        GradientImageCache& cache,
+        std::vector<ImageWarpingField>& warping_fields,
+        const std::vector<ImageWarpingField>& warping_fields_init,
+        camera::PinholeCameraTrajectory& camera,
+        const std::vector<std::vector<int>>& visiblity_image_to_vertex,
+        std::vector<double>& proxy_intensity,
+        const ColorMapOptimizationOption& option) {
+    auto n_vertex = mesh.vertices_.size();
+    int n_camera = int(camera.parameters_.size());
+    std::vector<double> proxy_sum(n_vertex, 0.0), proxy_count(n_vertex, 0.0);
+    for (int c : StreamingKeyframeOrder(n_camera, 1)) {
+        if (visiblity_image_to_vertex[c].empty()) continue;
+        auto entry = cache.Get(c);
+        if (entry.gray_ == nullptr) continue;
+        AccumulateProxyIntensityForImage(
+                mesh, *entry.gray_, warping_fields[c], camera, c,
+                visiblity_image_to_vertex[c], proxy_sum, proxy_count,
+                option.image_boundary_margin_);
+    }
+    SetProxyIntensityFromAccumulation(proxy_sum, proxy_count, proxy_intensity);
+    for (int itr = 0; itr < option.maximum_iteration_; itr++) {
+        utility::LogDebug("[Iteration {:04d}] ", itr + 1);
+        double residual = 0.0;
+        double residual_reg = 0.0;
+        std::fill(proxy_sum.begin(), proxy_sum.end(), 0.0);
+        std::fill(proxy_count.begin(), proxy_count.end(), 0.0);
+        for (int c : StreamingKeyframeOrder(n_camera, itr)) {
+            // A keyframe without visible vertices has an empty system and
+            // keeps its pose, so it does not need to be loaded.
+            if (visiblity_image_to_vertex[c].empty()) continue;
+            auto entry = cache.Get(c);
+            if (entry.gray_ == nullptr) continue;
+            int nonrigidval = warping_fields[c].anchor_w_ *
+                              warping_fields[c].anchor_h_ * 2;
+            auto intrinsic = camera.parameters_[c].intrinsic_.intrinsic_matrix_;
+            auto extrinsic = camera.parameters_[c].extrinsic_;
+            ColorMapOptimizationJacobian jac;
+            Eigen::Matrix4d intr = Eigen::Matrix4d::Zero();
+            intr.block<3, 3>(0, 0) = intrinsic;
+            intr(3, 3) = 1.0;
+
+            auto f_lambda = [&](int i, Eigen::Vector14d& J_r, double& r,
+                                Eigen::Vector14i& pattern) {
+                jac.ComputeJacobianAndResidualNonRigid(
+                        i, J_r, r, pattern, mesh, proxy_intensity, entry.gray_,
+                        entry.dx_, entry.dy_, warping_fields[c],
+                        warping_fields_init[c], intr, extrinsic,
+                        visiblity_image_to_vertex[c],
+                        option.image_boundary_margin_);
+            };
+            Eigen::MatrixXd JTJ;
+            Eigen::VectorXd JTr;
+            double r2;
+            std::tie(JTJ, JTr, r2) =
+                    ComputeJTJandJTrNonRigid<Eigen::Vector14d, Eigen::Vector14i,
+                                             Eigen::MatrixXd, Eigen::VectorXd>(
+                            f_lambda, int(visiblity_image_to_vertex[c].size()),
+                            nonrigidval, false);
+
+            double weight = option.non_rigid_anchor_point_weight_ *
+                            visiblity_image_to_vertex[c].size() / n_vertex;
+            for (int j = 0; j < nonrigidval; j++) {
+                double r = weight * (warping_fields[c].flow_(j) -
+                                     warping_fields_init[c].flow_(j));
+                JTJ(6 + j, 6 + j) += weight * weight;
+                JTr(6 + j) += weight * r;
+                residual_reg += r * r;
+            }
+
+            bool success;
+            Eigen::VectorXd result;
+            std::tie(success, result) = utility::SolveLinearSystemPSD(
+                    JTJ, -JTr, /*prefer_sparse=*/false,
+                    /*check_symmetric=*/false,
+                    /*check_det=*/false, /*check_psd=*/false);
+            Eigen::Vector6d result_pose;
+            result_pose << result.block(0, 0, 6, 1);
+            auto delta = utility::TransformVector6dToMatrix4d(result_pose);
+            camera.parameters_[c].extrinsic_ = delta * extrinsic;
+            for (int j = 0; j < nonrigidval; j++) {
+                warping_fields[c].flow_(j) += result(6 + j);
+            }
+            residual += r2;
+
+            AccumulateProxyIntensityForImage(
+                    mesh, *entry.gray_, warping_fields[c], camera, c,
+                    visiblity_image_to_vertex[c], proxy_sum, proxy_count,
+                    option.image_boundary_margin_);
+        }
+        utility::LogDebug("Residual error : {:.6f}, reg : {:.6f}\n", residual,
+                          residual_reg);
+        SetProxyIntensityFromAccumulation(proxy_sum, proxy_count,
+                                          proxy_intensity);
+    }
+}
+
 }  // unnamed namespace
 
 namespace color_map {
@@ -324,5 +601,107 @@ void ColorMapOptimization(
                                 option.invisible_vertex_color_knn_);
     }
 }
+void ColorMapOptimization(geometry::TriangleMesh& mesh,
+                          const RGBDImageProvider& image_provider,
+                          camera::PinholeCameraTrajectory& camera,
+                          const ColorMapOptimizationOption& option
+                          /* = ColorMapOptimizationOption()*/) {
+    utility::LogDebug("[ColorMapOptimization] :: Streaming\n");
+    auto n_vertex = mesh.vertices_.size();
+    int n_camera = int(camera.parameters_.size());
+
+    // The depth images and the boundary masks are only needed for the
+    // visibility check, they are created for one keyframe at a time.
+    utility::LogDebug("[ColorMapOptimization] :: VisibilityCheck\n");
+    std::vector<std::vector<int>> visiblity_image_to_vertex(n_camera);
+    std::vector<std::pair<int, int>> image_sizes(n_camera);
+    for (int c = 0; c < n_camera; c++) {
+        auto image_rgbd = LoadKeyframe(image_provider, c);
+        if (image_rgbd == nullptr) return;
+        auto mask = image_rgbd->depth_.CreateDepthBoundaryMask(
+                option.depth_threshold_for_discontinuity_check_,
+                option.half_dilation_kernel_size_for_discontinuity_map_);
+        visiblity_image_to_vertex[c] = CreateImageToVertexVisibility(
+                mesh, image_rgbd->depth_, *mask, camera, c,
+                option.maximum_allowable_depth_,
+                option.depth_threshold_for_visiblity_check_);
+        image_sizes[c] = std::make_pair(image_rgbd->color_.width_,
+                                        image_rgbd->color_.height_);
+    }
+
+    GradientImageCache cache(image_provider,
+                             size_t(std::max(option.maximum_cached_keyframes_,
+                                             1)));
+    std::vector<double> proxy_intensity;
+    std::vector<Eigen::Vector3d> color_sum(n_vertex, Eigen::Vector3d::Zero());
+    std::vector<double> color_count(n_vertex, 0.0);
+    if (option.non_rigid_camera_coordinate_) {
+        utility::LogDebug("[ColorMapOptimization] :: Non-Rigid Optimization\n");
+        std::vector<ImageWarpingField> warping_uv_, warping_uv_init_;
+        for (int c = 0; c < n_camera; c++) {
+            warping_uv_.push_back(ImageWarpingField(
+                    image_sizes[c].first, image_sizes[c].second,
+                    option.number_of_vertical_anchors_));
+        }
+        warping_uv_init_ = warping_uv_;
+        OptimizeImageCoorNonrigidStreaming(
+                mesh, cache, warping_uv_, warping_uv_init_, camera,
+                visiblity_image_to_vertex, proxy_intensity, option);
+        for (int c = 0; c < n_camera; c++) {
+            if (visiblity_image_to_vertex[c].empty()) continue;
+            auto image_rgbd = LoadKeyframe(image_provider, c);
+            if (image_rgbd == nullptr) continue;
+            AccumulateGeometryColorForImage(
+                    mesh, image_rgbd->color_, warping_uv_[c], camera, c,
+                    visiblity_image_to_vertex[c], color_sum, color_count,
+                    option.image_boundary_margin_);
+        }
+    } else {
+        utility::LogDebug("[ColorMapOptimization] :: Rigid Optimization\n");
+        OptimizeImageCoorRigidStreaming(mesh, cache, camera,
+                                        visiblity_image_to_vertex,
+                                        proxy_intensity, option);
+        for (int c = 0; c < n_camera; c++) {
+            if (visiblity_image_to_vertex[c].empty()) continue;
+            auto image_rgbd = LoadKeyframe(image_provider, c);
+            if (image_rgbd == nullptr) continue;
+            AccumulateGeometryColorForImage(
+                    mesh, image_rgbd->color_, camera, c,
+                    visiblity_image_to_vertex[c], color_sum, color_count,
+                    option.image_boundary_margin_);
+        }
+    }
+    SetGeometryColorFromAccumulation(mesh, color_sum, color_count,
+                                     option.invisible_vertex_color_knn_);
+}
+
+void ColorMapOptimization(geometry::TriangleMesh& mesh,
+                          const std::vector<std::string>& color_filenames,
+                          const std::vector<std::string>& depth_filenames,
+                          camera::PinholeCameraTrajectory& camera,
+                          const ColorMapOptimizationOption& option
+                          /* = ColorMapOptimizationOption()*/,
+                          double depth_scale /* = 1000.0*/,
+                          double depth_trunc /* = 3.0*/) {
+    if (color_filenames.size() != camera.parameters_.size() ||
+        depth_filenames.size() != camera.parameters_.size()) {
+        utility::LogError(
+                "[ColorMapOptimization] Expected {:d} color and depth images, "
+                "got {:d} and {:d}.\n",
+                camera.parameters_.size(), color_filenames.size(),
+                depth_filenames.size());
+        return;
+    }
+    RGBDImageProvider image_provider =
+            [&](int index) -> std::shared_ptr<geometry::RGBDImage> {
+        utility::LogDebug("reading {}...\n", color_filenames[index]);
+        auto color = io::CreateImageFromFile(color_filenames[index]);
+        utility::LogDebug("reading {}...\n", depth_filenames[index]);
+        auto depth = io::CreateImageFromFile(depth_filenames[index]);
+        return geometry::RGBDImage::CreateFromColorAndDepth(
+                *color, *depth, depth_scale, depth_trunc, false);
+    };
+    ColorMapOptimization(mesh, image_provider, camera, option);
+}
 }  // namespace color_map
 }  // namespace open3d
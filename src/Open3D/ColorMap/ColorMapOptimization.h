@@ -26,7 +26,9 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace open3d {
@@ -60,7 +62,8 @@ public:
             double depth_threshold_for_discontinuity_check = 0.1,
             int half_dilation_kernel_size_for_discontinuity_map = 3,
             int image_boundary_margin = 10,
-            int invisible_vertex_color_knn = 3)
+            int invisible_vertex_color_knn = 3,
+            int maximum_cached_keyframes = 32)
         : non_rigid_camera_coordinate_(non_rigid_camera_coordinate),
           number_of_vertical_anchors_(number_of_vertical_anchors),
           non_rigid_anchor_point_weight_(non_rigid_anchor_point_weight),
@@ -73,7 +76,8 @@ public:
           half_dilation_kernel_size_for_discontinuity_map_(
                   half_dilation_kernel_size_for_discontinuity_map),
           image_boundary_margin_(image_boundary_margin),
-          invisible_vertex_color_knn_(invisible_vertex_color_knn) {}
+          invisible_vertex_color_knn_(invisible_vertex_color_knn),
+          maximum_cached_keyframes_(maximum_cached_keyframes) {}
     ~ColorMapOptimizationOption() {}
 
 public:
@@ -87,8 +91,17 @@ public:
     int half_dilation_kernel_size_for_discontinuity_map_;
     int image_boundary_margin_;
     int invisible_vertex_color_knn_;
+    /// Number of keyframes whose gradient images are kept in memory by the
+    /// streaming variant of ColorMapOptimization.
+    int maximum_cached_keyframes_;
 };
 
+/// Function that loads the RGBD keyframe of the given camera index. The
+/// returned image must have the same layout as the ones passed to the
+/// in-memory ColorMapOptimization (8-bit color, float depth in meters).
+typedef std::function<std::shared_ptr<geometry::RGBDImage>(int)>
+        RGBDImageProvider;
+
 /// This is implementation of following paper
 /// Q.-Y. Zhou and V. Koltun,
 /// Color Map Optimization for 3D Reconstruction with Consumer Depth Cameras,
@@ -99,5 +112,32 @@ void ColorMapOptimization(
         camera::PinholeCameraTrajectory& camera,
         const ColorMapOptimizationOption& option =
                 ColorMapOptimizationOption());
+
+/// Streaming variant of ColorMapOptimization. Keyframes are requested from
+/// \p image_provider when they are needed and only the gradient images of
+/// the last \p option.maximum_cached_keyframes_ keyframes are kept in memory,
+/// so the peak memory no longer grows with the length of the sequence.
+/// The keyframe of camera i is image_provider(i), for every camera in
+/// \p camera.
+void ColorMapOptimization(
+        geometry::TriangleMesh& mesh,
+        const RGBDImageProvider& image_provider,
+        camera::PinholeCameraTrajectory& camera,
+        const ColorMapOptimizationOption& option =
+                ColorMapOptimizationOption());
+
+/// Streaming variant of ColorMapOptimization that reads the keyframes from
+/// color and depth image files. The depth images are converted with
+/// \p depth_scale and \p depth_trunc as in
+/// RGBDImage::CreateFromColorAndDepth.
+void ColorMapOptimization(
+        geometry::TriangleMesh& mesh,
+        const std::vector<std::string>& color_filenames,
+        const std::vector<std::string>& depth_filenames,
+        camera::PinholeCameraTrajectory& camera,
+        const ColorMapOptimizationOption& option =
+                ColorMapOptimizationOption(),
+        double depth_scale = 1000.0,
+        double depth_trunc = 3.0);
 }  // namespace color_map
 }  // namespace open3d
@@ -27,9 +27,16 @@
 #pragma once
 
 #include <Eigen/Core>
+#include <algorithm>
 #include <tuple>
 #include <vector>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "Open3D/Utility/Console.h"
+
 namespace Eigen {
 
 typedef Eigen::Matrix<double, 14, 14> Matrix14d;
@@ -42,20 +49,92 @@ namespace open3d {
 namespace color_map {
 
 /// Function to compute JTJ and Jtr
-/// Input: function pointer f and total number of rows of Jacobian matrix
+/// Input: functor f and total number of rows of Jacobian matrix
 /// Output: JTJ, JTr, sum of r^2
 /// Note: this function is almost identical to the functions in
-/// Utility/Eigen.h/cpp, but this function takes additional multiplication
+/// Utility/Eigen.h, but this function takes additional multiplication
 /// pattern that can produce JTJ having hundreds of rows and columns.
+/// f(int i, VecInTypeDouble &J_r, double &r, VecInTypeInt &pattern) outputs
+/// the nonzero entries J_r of row i and their columns pattern.
 template <typename VecInTypeDouble,
           typename VecInTypeInt,
           typename MatOutType,
-          typename VecOutType>
+          typename VecOutType,
+          typename FuncType>
 std::tuple<MatOutType, VecOutType, double> ComputeJTJandJTrNonRigid(
-        std::function<void(int, VecInTypeDouble &, double &, VecInTypeInt &)> f,
-        int iteration_num,
-        int nonrigidval,
-        bool verbose = true);
+        FuncType f, int iteration_num, int nonrigidval, bool verbose = true) {
+    const int size = 6 + nonrigidval;
+#ifdef _OPENMP
+    const int num_threads = omp_get_max_threads();
+#else
+    const int num_threads = 1;
+#endif
+    // Every slot is zeroed up front, because the region may run on fewer
+    // threads than omp_get_max_threads(), e.g. when nested in another one.
+    std::vector<MatOutType> JTJ_partials(num_threads,
+                                         MatOutType::Zero(size, size));
+    std::vector<VecOutType> JTr_partials(num_threads, VecOutType::Zero(size));
+    std::vector<double> r2_sum_partials(num_threads, 0.0);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+#ifdef _OPENMP
+        const int thread_num = omp_get_thread_num();
+#else
+        const int thread_num = 0;
+#endif
+        MatOutType &JTJ_private = JTJ_partials[thread_num];
+        VecOutType &JTr_private = JTr_partials[thread_num];
+        double r2_sum_private = 0.0;
+        VecInTypeDouble J_r;
+        VecInTypeInt pattern;
+        double r;
+#ifdef _OPENMP
+#pragma omp for nowait
+#endif
+        for (int i = 0; i < iteration_num; i++) {
+            f(i, J_r, r, pattern);
+            // Only the upper triangle of JTJ is accumulated.
+            for (int x = 0; x < J_r.size(); x++) {
+                const int col_x = pattern(x);
+                JTJ_private(col_x, col_x) += J_r(x) * J_r(x);
+                for (int y = x + 1; y < J_r.size(); y++) {
+                    const int col_y = pattern(y);
+                    if (col_x == col_y) {
+                        JTJ_private(col_x, col_x) += 2.0 * J_r(x) * J_r(y);
+                    } else {
+                        JTJ_private(std::min(col_x, col_y),
+                                    std::max(col_x, col_y)) += J_r(x) * J_r(y);
+                    }
+                }
+                JTr_private(col_x) += r * J_r(x);
+            }
+            r2_sum_private += r * r;
+        }
+        r2_sum_partials[thread_num] = r2_sum_private;
+    }
+    // Tree reduction of the partial sums, each level in parallel.
+    for (int stride = 1; stride < num_threads; stride *= 2) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int i = 0; i < num_threads - stride; i += 2 * stride) {
+            JTJ_partials[i] += JTJ_partials[i + stride];
+            JTr_partials[i] += JTr_partials[i + stride];
+            r2_sum_partials[i] += r2_sum_partials[i + stride];
+        }
+    }
+    MatOutType &JTJ = JTJ_partials[0];
+    JTJ.template triangularView<Eigen::StrictlyLower>() = JTJ.transpose();
+    const double r2_sum = r2_sum_partials[0];
+    if (verbose) {
+        utility::LogDebug("Residual : {:.2e} (# of elements : {:d})\n",
+                          r2_sum / (double)iteration_num, iteration_num);
+    }
+    return std::make_tuple(std::move(JTJ), std::move(JTr_partials[0]),
+                           r2_sum);
+}
 
 }  // namespace color_map
 }  // namespace open3d
@@ -51,6 +51,44 @@ inline std::tuple<float, float, float> Project3DPointAndGetUVDepth(
     return std::make_tuple(u, v, z);
 }
 
+std::vector<int> CreateImageToVertexVisibility(
+        const geometry::TriangleMesh& mesh,
+        const geometry::Image& image_depth,
+        const geometry::Image& image_mask,
+        const camera::PinholeCameraTrajectory& camera,
+        int camid,
+        double maximum_allowable_depth,
+        double depth_threshold_for_visiblity_check) {
+    int n_vertex = int(mesh.vertices_.size());
+    std::vector<char> is_visible(n_vertex, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int vertex_id = 0; vertex_id < n_vertex; vertex_id++) {
+        Eigen::Vector3d X = mesh.vertices_[vertex_id];
+        float u, v, d;
+        std::tie(u, v, d) = Project3DPointAndGetUVDepth(X, camera, camid);
+        int u_d = int(round(u)), v_d = int(round(v));
+        if (d < 0.0 || !image_depth.TestImageBoundary(u_d, v_d)) continue;
+        float d_sensor = *image_depth.PointerAt<float>(u_d, v_d);
+        if (d_sensor > maximum_allowable_depth) continue;
+        if (*image_mask.PointerAt<unsigned char>(u_d, v_d) == 255) continue;
+        if (std::fabs(d - d_sensor) < depth_threshold_for_visiblity_check) {
+            is_visible[vertex_id] = 1;
+        }
+    }
+    std::vector<int> visiblity_image_to_vertex;
+    for (int vertex_id = 0; vertex_id < n_vertex; vertex_id++) {
+        if (is_visible[vertex_id]) {
+            visiblity_image_to_vertex.push_back(vertex_id);
+        }
+    }
+    utility::LogDebug("[cam {:d}] {:.5f} percents are visible\n", camid,
+                      double(visiblity_image_to_vertex.size()) / n_vertex *
+                              100);
+    return visiblity_image_to_vertex;
+}
+
 std::tuple<std::vector<std::vector<int>>, std::vector<std::vector<int>>>
 CreateVertexAndImageVisibility(
         const geometry::TriangleMesh& mesh,
@@ -69,32 +107,14 @@ CreateVertexAndImageVisibility(
 #pragma omp parallel for schedule(static)
 #endif
     for (int c = 0; c < int(n_camera); c++) {
-        int viscnt = 0;
-        for (size_t vertex_id = 0; vertex_id < n_vertex; vertex_id++) {
-            Eigen::Vector3d X = mesh.vertices_[vertex_id];
-            float u, v, d;
-            std::tie(u, v, d) = Project3DPointAndGetUVDepth(X, camera, c);
-            int u_d = int(round(u)), v_d = int(round(v));
-            if (d < 0.0 || !images_depth[c]->TestImageBoundary(u_d, v_d))
-                continue;
-            float d_sensor = *images_depth[c]->PointerAt<float>(u_d, v_d);
-            if (d_sensor > maximum_allowable_depth) continue;
-            if (*images_mask[c]->PointerAt<unsigned char>(u_d, v_d) == 255)
-                continue;
-            if (std::fabs(d - d_sensor) < depth_threshold_for_visiblity_check) {
-#ifdef _OPENMP
-#pragma omp critical
-#endif
-                {
-                    visiblity_vertex_to_image[vertex_id].push_back(c);
-                    visiblity_image_to_vertex[c].push_back(int(vertex_id));
-                    viscnt++;
-                }
-            }
+        visiblity_image_to_vertex[c] = CreateImageToVertexVisibility(
+                mesh, *images_depth[c], *images_mask[c], camera, c,
+                maximum_allowable_depth, depth_threshold_for_visiblity_check);
+    }
+    for (int c = 0; c < int(n_camera); c++) {
+        for (int vertex_id : visiblity_image_to_vertex[c]) {
+            visiblity_vertex_to_image[vertex_id].push_back(c);
         }
-        utility::LogDebug("[cam {:d}] {:.5f} percents are visible\n", c,
-                          double(viscnt) / n_vertex * 100);
-        fflush(stdout);
     }
     return std::make_tuple(visiblity_vertex_to_image,
                            visiblity_image_to_vertex);
@@ -224,6 +244,39 @@ void SetProxyIntensityForVertex(
     }
 }
 
+namespace {
+
+/// Assigns the averaged color of the k nearest visible vertices to every
+/// vertex that is not seen by any image.
+void FillInvisibleVertexColors(geometry::TriangleMesh& mesh,
+                               const std::vector<size_t>& valid_vertices,
+                               const std::vector<size_t>& invalid_vertices,
+                               int invisible_vertex_color_knn) {
+    std::shared_ptr<geometry::TriangleMesh> valid_mesh =
+            mesh.SelectDownSample(valid_vertices);
+    geometry::KDTreeFlann kd_tree(*valid_mesh);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < (int)invalid_vertices.size(); ++i) {
+        size_t invalid_vertex = invalid_vertices[i];
+        std::vector<int> indices;  // indices to valid_mesh
+        std::vector<double> dists;
+        kd_tree.SearchKNN(mesh.vertices_[invalid_vertex],
+                          invisible_vertex_color_knn, indices, dists);
+        Eigen::Vector3d new_color(0, 0, 0);
+        for (const int& index : indices) {
+            new_color += valid_mesh->vertex_colors_[index];
+        }
+        if (indices.size() > 0) {
+            new_color /= indices.size();
+        }
+        mesh.vertex_colors_[invalid_vertex] = new_color;
+    }
+}
+
+}  // unnamed namespace
+
 void SetGeometryColorAverage(
         geometry::TriangleMesh& mesh,
         const std::vector<std::shared_ptr<geometry::Image>>& images_color,
@@ -277,27 +330,8 @@ void SetGeometryColorAverage(
         }
     }
     if (invisible_vertex_color_knn > 0) {
-        std::shared_ptr<geometry::TriangleMesh> valid_mesh =
-                mesh.SelectDownSample(valid_vertices);
-        geometry::KDTreeFlann kd_tree(*valid_mesh);
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-        for (int i = 0; i < (int)invalid_vertices.size(); ++i) {
-            size_t invalid_vertex = invalid_vertices[i];
-            std::vector<int> indices;  // indices to valid_mesh
-            std::vector<double> dists;
-            kd_tree.SearchKNN(mesh.vertices_[invalid_vertex],
-                              invisible_vertex_color_knn, indices, dists);
-            Eigen::Vector3d new_color(0, 0, 0);
-            for (const int& index : indices) {
-                new_color += valid_mesh->vertex_colors_[index];
-            }
-            if (indices.size() > 0) {
-                new_color /= indices.size();
-            }
-            mesh.vertex_colors_[invalid_vertex] = new_color;
-        }
+        FillInvisibleVertexColors(mesh, valid_vertices, invalid_vertices,
+                                  invisible_vertex_color_knn);
     }
 }
 
@@ -355,28 +389,158 @@ void SetGeometryColorAverage(
         }
     }
     if (invisible_vertex_color_knn > 0) {
-        std::shared_ptr<geometry::TriangleMesh> valid_mesh =
-                mesh.SelectDownSample(valid_vertices);
-        geometry::KDTreeFlann kd_tree(*valid_mesh);
+        FillInvisibleVertexColors(mesh, valid_vertices, invalid_vertices,
+                                  invisible_vertex_color_knn);
+    }
+}
+
+void AccumulateProxyIntensityForImage(
+        const geometry::TriangleMesh& mesh,
+        const geometry::Image& image_gray,
+        const camera::PinholeCameraTrajectory& camera,
+        int camid,
+        const std::vector<int>& visiblity_image_to_vertex,
+        std::vector<double>& proxy_intensity_sum,
+        std::vector<double>& proxy_intensity_count,
+        int image_boundary_margin) {
+    // Vertex indices are unique within one image, so the rows can be
+    // accumulated in parallel without synchronization.
 #ifdef _OPENMP
 #pragma omp parallel for schedule(static)
 #endif
-        for (int i = 0; i < (int)invalid_vertices.size(); ++i) {
-            size_t invalid_vertex = invalid_vertices[i];
-            std::vector<int> indices;  // indices to valid_mesh
-            std::vector<double> dists;
-            kd_tree.SearchKNN(mesh.vertices_[invalid_vertex],
-                              invisible_vertex_color_knn, indices, dists);
-            Eigen::Vector3d new_color(0, 0, 0);
-            for (const int& index : indices) {
-                new_color += valid_mesh->vertex_colors_[index];
-            }
-            if (indices.size() > 0) {
-                new_color /= indices.size();
-            }
-            mesh.vertex_colors_[invalid_vertex] = new_color;
+    for (int k = 0; k < int(visiblity_image_to_vertex.size()); k++) {
+        int i = visiblity_image_to_vertex[k];
+        float gray;
+        bool valid = false;
+        std::tie(valid, gray) = QueryImageIntensity<float>(
+                image_gray, mesh.vertices_[i], camera, camid, -1,
+                image_boundary_margin);
+        if (valid) {
+            proxy_intensity_sum[i] += gray;
+            proxy_intensity_count[i] += 1.0;
+        }
+    }
+}
+
+void AccumulateProxyIntensityForImage(
+        const geometry::TriangleMesh& mesh,
+        const geometry::Image& image_gray,
+        const ImageWarpingField& warping_field,
+        const camera::PinholeCameraTrajectory& camera,
+        int camid,
+        const std::vector<int>& visiblity_image_to_vertex,
+        std::vector<double>& proxy_intensity_sum,
+        std::vector<double>& proxy_intensity_count,
+        int image_boundary_margin) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int k = 0; k < int(visiblity_image_to_vertex.size()); k++) {
+        int i = visiblity_image_to_vertex[k];
+        float gray;
+        bool valid = false;
+        std::tie(valid, gray) = QueryImageIntensity<float>(
+                image_gray, warping_field, mesh.vertices_[i], camera, camid,
+                -1, image_boundary_margin);
+        if (valid) {
+            proxy_intensity_sum[i] += gray;
+            proxy_intensity_count[i] += 1.0;
+        }
+    }
+}
+
+void AccumulateGeometryColorForImage(
+        const geometry::TriangleMesh& mesh,
+        const geometry::Image& image_color,
+        const camera::PinholeCameraTrajectory& camera,
+        int camid,
+        const std::vector<int>& visiblity_image_to_vertex,
+        std::vector<Eigen::Vector3d>& color_sum,
+        std::vector<double>& color_count,
+        int image_boundary_margin /*= 10*/) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int k = 0; k < int(visiblity_image_to_vertex.size()); k++) {
+        int i = visiblity_image_to_vertex[k];
+        unsigned char r_temp, g_temp, b_temp;
+        bool valid = false;
+        std::tie(valid, r_temp) = QueryImageIntensity<unsigned char>(
+                image_color, mesh.vertices_[i], camera, camid, 0,
+                image_boundary_margin);
+        std::tie(valid, g_temp) = QueryImageIntensity<unsigned char>(
+                image_color, mesh.vertices_[i], camera, camid, 1,
+                image_boundary_margin);
+        std::tie(valid, b_temp) = QueryImageIntensity<unsigned char>(
+                image_color, mesh.vertices_[i], camera, camid, 2,
+                image_boundary_margin);
+        if (valid) {
+            color_sum[i] += Eigen::Vector3d((float)r_temp / 255.0f,
+                                            (float)g_temp / 255.0f,
+                                            (float)b_temp / 255.0f);
+            color_count[i] += 1.0;
+        }
+    }
+}
+
+void AccumulateGeometryColorForImage(
+        const geometry::TriangleMesh& mesh,
+        const geometry::Image& image_color,
+        const ImageWarpingField& warping_field,
+        const camera::PinholeCameraTrajectory& camera,
+        int camid,
+        const std::vector<int>& visiblity_image_to_vertex,
+        std::vector<Eigen::Vector3d>& color_sum,
+        std::vector<double>& color_count,
+        int image_boundary_margin /*= 10*/) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int k = 0; k < int(visiblity_image_to_vertex.size()); k++) {
+        int i = visiblity_image_to_vertex[k];
+        unsigned char r_temp, g_temp, b_temp;
+        bool valid = false;
+        std::tie(valid, r_temp) = QueryImageIntensity<unsigned char>(
+                image_color, warping_field, mesh.vertices_[i], camera, camid,
+                0, image_boundary_margin);
+        std::tie(valid, g_temp) = QueryImageIntensity<unsigned char>(
+                image_color, warping_field, mesh.vertices_[i], camera, camid,
+                1, image_boundary_margin);
+        std::tie(valid, b_temp) = QueryImageIntensity<unsigned char>(
+                image_color, warping_field, mesh.vertices_[i], camera, camid,
+                2, image_boundary_margin);
+        if (valid) {
+            color_sum[i] += Eigen::Vector3d((float)r_temp / 255.0f,
+                                            (float)g_temp / 255.0f,
+                                            (float)b_temp / 255.0f);
+            color_count[i] += 1.0;
         }
     }
 }
+
+void SetGeometryColorFromAccumulation(
+        geometry::TriangleMesh& mesh,
+        const std::vector<Eigen::Vector3d>& color_sum,
+        const std::vector<double>& color_count,
+        int invisible_vertex_color_knn /*= 3*/) {
+    size_t n_vertex = mesh.vertices_.size();
+    mesh.vertex_colors_.clear();
+    mesh.vertex_colors_.resize(n_vertex);
+    std::vector<size_t> valid_vertices;
+    std::vector<size_t> invalid_vertices;
+    for (size_t i = 0; i < n_vertex; i++) {
+        if (color_count[i] > 0.0) {
+            mesh.vertex_colors_[i] = color_sum[i] / color_count[i];
+            valid_vertices.push_back(i);
+        } else {
+            mesh.vertex_colors_[i] = Eigen::Vector3d::Zero();
+            invalid_vertices.push_back(i);
+        }
+    }
+    if (invisible_vertex_color_knn > 0) {
+        FillInvisibleVertexColors(mesh, valid_vertices, invalid_vertices,
+                                  invisible_vertex_color_knn);
+    }
+}
 }  // namespace color_map
 }  // namespace open3d
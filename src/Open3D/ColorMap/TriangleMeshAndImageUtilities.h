@@ -56,6 +56,17 @@ inline std::tuple<float, float, float> Project3DPointAndGetUVDepth(
         const camera::PinholeCameraTrajectory& camera,
         int camid);
 
+/// Returns the indices of the mesh vertices that are visible from camera
+/// \p camid, in increasing order.
+std::vector<int> CreateImageToVertexVisibility(
+        const geometry::TriangleMesh& mesh,
+        const geometry::Image& image_depth,
+        const geometry::Image& image_mask,
+        const camera::PinholeCameraTrajectory& camera,
+        int camid,
+        double maximum_allowable_depth,
+        double depth_threshold_for_visiblity_check);
+
 std::tuple<std::vector<std::vector<int>>, std::vector<std::vector<int>>>
 CreateVertexAndImageVisibility(
         const geometry::TriangleMesh& mesh,
@@ -117,5 +128,59 @@ void SetGeometryColorAverage(
         const std::vector<std::vector<int>>& visiblity_vertex_to_image,
         int image_boundary_margin = 10,
         int invisible_vertex_color_knn = 3);
+
+/// Adds the intensity that image \p camid observes at each of its visible
+/// vertices to \p proxy_intensity_sum and increments the matching entry of
+/// \p proxy_intensity_count. Used to build the proxy intensity one image at a
+/// time when the images are not all kept in memory.
+void AccumulateProxyIntensityForImage(
+        const geometry::TriangleMesh& mesh,
+        const geometry::Image& image_gray,
+        const camera::PinholeCameraTrajectory& camera,
+        int camid,
+        const std::vector<int>& visiblity_image_to_vertex,
+        std::vector<double>& proxy_intensity_sum,
+        std::vector<double>& proxy_intensity_count,
+        int image_boundary_margin);
+
+void AccumulateProxyIntensityForImage(
+        const geometry::TriangleMesh& mesh,
+        const geometry::Image& image_gray,
+        const ImageWarpingField& warping_field,
+        const camera::PinholeCameraTrajectory& camera,
+        int camid,
+        const std::vector<int>& visiblity_image_to_vertex,
+        std::vector<double>& proxy_intensity_sum,
+        std::vector<double>& proxy_intensity_count,
+        int image_boundary_margin);
+
+/// Per-image counterpart of SetGeometryColorAverage. The averaged colors are
+/// written to the mesh by SetGeometryColorFromAccumulation.
+void AccumulateGeometryColorForImage(
+        const geometry::TriangleMesh& mesh,
+        const geometry::Image& image_color,
+        const camera::PinholeCameraTrajectory& camera,
+        int camid,
+        const std::vector<int>& visiblity_image_to_vertex,
+        std::vector<Eigen::Vector3d>& color_sum,
+        std::vector<double>& color_count,
+        int image_boundary_margin = 10);
+
+void AccumulateGeometryColorForImage(
+        const geometry::TriangleMesh& mesh,
+        const geometry::Image& image_color,
+        const ImageWarpingField& warping_field,
+        const camera::PinholeCameraTrajectory& camera,
+        int camid,
+        const std::vector<int>& visiblity_image_to_vertex,
+        std::vector<Eigen::Vector3d>& color_sum,
+        std::vector<double>& color_count,
+        int image_boundary_margin = 10);
+
+void SetGeometryColorFromAccumulation(
+        geometry::TriangleMesh& mesh,
+        const std::vector<Eigen::Vector3d>& color_sum,
+        const std::vector<double>& color_count,
+        int invisible_vertex_color_knn = 3);
 }  // namespace color_map
 }  // namespace open3d
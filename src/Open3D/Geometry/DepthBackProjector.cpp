@@ -0,0 +1,234 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include "Open3D/Geometry/DepthBackProjector.h"
+
+#include <Eigen/Dense>
+
+#include "Open3D/Camera/PinholeCameraIntrinsic.h"
+#include "Open3D/Geometry/Image.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/RGBDImage.h"
+#include "Open3D/Utility/Console.h"
+
+namespace open3d {
+
+namespace {
+using namespace geometry;
+
+template <typename T>
+const T *RowPointer(const Image &image, int v) {
+    return (const T *)(image.data_.data() + v * image.BytesPerLine());
+}
+
+/// Counts the valid pixels of every sampled row of \p depth and turns the
+/// counts into output offsets. Returns the total number of valid pixels.
+template <typename TD, typename DepthFunc>
+int ComputeRowOffsets(const Image &depth,
+                      int stride,
+                      const DepthFunc &to_depth,
+                      std::vector<int> &row_offsets) {
+    int num_rows = (depth.height_ + stride - 1) / stride;
+    row_offsets.assign(num_rows + 1, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int r = 0; r < num_rows; r++) {
+        const TD *p = RowPointer<TD>(depth, r * stride);
+        int count = 0;
+        for (int u = 0; u < depth.width_; u += stride) {
+            if (to_depth(p[u]) > 0) count++;
+        }
+        row_offsets[r + 1] = count;
+    }
+    for (int r = 0; r < num_rows; r++) {
+        row_offsets[r + 1] += row_offsets[r];
+    }
+    return row_offsets[num_rows];
+}
+
+/// Writes the valid pixels of every sampled row starting at its offset. A
+/// pixel (u, v) with depth z becomes camera_pose * (z * ray_x[u],
+/// z * ray_y[v], z), which is evaluated as z * (ray_x[u] * R.col(0) +
+/// ray_y[v] * R.col(1) + R.col(2)) + t. \p func(k, u, v) is called for every
+/// output point k.
+template <typename TD, typename DepthFunc, typename PixelFunc>
+void BackProjectRows(const Image &depth,
+                     int stride,
+                     const DepthFunc &to_depth,
+                     const std::vector<double> &ray_x,
+                     const std::vector<double> &ray_y,
+                     const Eigen::Matrix4d &camera_pose,
+                     const std::vector<int> &row_offsets,
+                     std::vector<Eigen::Vector3d> &points,
+                     const PixelFunc &func) {
+    const Eigen::Vector3d c0 = camera_pose.block<3, 1>(0, 0);
+    const Eigen::Vector3d c1 = camera_pose.block<3, 1>(0, 1);
+    const Eigen::Vector3d c2 = camera_pose.block<3, 1>(0, 2);
+    const Eigen::Vector3d t = camera_pose.block<3, 1>(0, 3);
+    int num_rows = int(row_offsets.size()) - 1;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int r = 0; r < num_rows; r++) {
+        int v = r * stride;
+        const TD *p = RowPointer<TD>(depth, v);
+        const Eigen::Vector3d row_ray = ray_y[v] * c1 + c2;
+        int k = row_offsets[r];
+        for (int u = 0; u < depth.width_; u += stride) {
+            float z = to_depth(p[u]);
+            if (z > 0) {
+                points[k] = (double)z * (ray_x[u] * c0 + row_ray) + t;
+                func(k, u, v);
+                k++;
+            }
+        }
+    }
+}
+
+template <typename TC, int NC>
+void BackProjectRGBD(const RGBDImage &image,
+                     const std::vector<double> &ray_x,
+                     const std::vector<double> &ray_y,
+                     const Eigen::Matrix4d &camera_pose,
+                     std::vector<int> &row_offsets,
+                     PointCloud &output) {
+    auto to_depth = [](float d) { return d; };
+    int num_valid_pixels =
+            ComputeRowOffsets<float>(image.depth_, 1, to_depth, row_offsets);
+    output.points_.resize(num_valid_pixels);
+    output.colors_.resize(num_valid_pixels);
+    double scale = (sizeof(TC) == 1) ? 255.0 : 1.0;
+    auto &colors = output.colors_;
+    BackProjectRows<float>(
+            image.depth_, 1, to_depth, ray_x, ray_y, camera_pose, row_offsets,
+            output.points_, [&](int k, int u, int v) {
+                const TC *pc = RowPointer<TC>(image.color_, v) + u * NC;
+                colors[k] = Eigen::Vector3d(pc[0], pc[(NC - 1) / 2],
+                                            pc[NC - 1]) /
+                            scale;
+            });
+}
+
+}  // unnamed namespace
+
+namespace geometry {
+
+void DepthBackProjector::PrepareRays(
+        const camera::PinholeCameraIntrinsic &intrinsic,
+        int width,
+        int height) {
+    if (intrinsic_matrix_ == intrinsic.intrinsic_matrix_ &&
+        int(ray_x_.size()) == width && int(ray_y_.size()) == height) {
+        return;
+    }
+    intrinsic_matrix_ = intrinsic.intrinsic_matrix_;
+    auto focal_length = intrinsic.GetFocalLength();
+    auto principal_point = intrinsic.GetPrincipalPoint();
+    ray_x_.resize(width);
+    ray_y_.resize(height);
+    for (int u = 0; u < width; u++) {
+        ray_x_[u] = (u - principal_point.first) / focal_length.first;
+    }
+    for (int v = 0; v < height; v++) {
+        ray_y_[v] = (v - principal_point.second) / focal_length.second;
+    }
+}
+
+bool DepthBackProjector::CreateFromDepthImage(
+        const Image &depth,
+        const camera::PinholeCameraIntrinsic &intrinsic,
+        const Eigen::Matrix4d &extrinsic,
+        double depth_scale,
+        double depth_trunc,
+        int stride,
+        PointCloud &output) {
+    output.Clear();
+    if (depth.num_of_channels_ != 1 ||
+        (depth.bytes_per_channel_ != 2 && depth.bytes_per_channel_ != 4)) {
+        utility::LogWarning(
+                "[CreatePointCloudFromDepthImage] Unsupported image format.\n");
+        return false;
+    }
+    if (stride < 1) {
+        utility::LogWarning(
+                "[CreatePointCloudFromDepthImage] Invalid stride.\n");
+        return false;
+    }
+    PrepareRays(intrinsic, depth.width_, depth.height_);
+    Eigen::Matrix4d camera_pose = extrinsic.inverse();
+    auto no_color = [](int, int, int) {};
+    if (depth.bytes_per_channel_ == 2) {
+        // Same conversion as Image::ConvertDepthToFloatImage.
+        float scale = (float)depth_scale;
+        auto to_depth = [scale, depth_trunc](uint16_t d) {
+            float z = (float)d / scale;
+            return z >= depth_trunc ? 0.0f : z;
+        };
+        output.points_.resize(ComputeRowOffsets<uint16_t>(
+                depth, stride, to_depth, row_offsets_));
+        BackProjectRows<uint16_t>(depth, stride, to_depth, ray_x_, ray_y_,
+                                  camera_pose, row_offsets_, output.points_,
+                                  no_color);
+    } else {
+        auto to_depth = [](float d) { return d; };
+        output.points_.resize(ComputeRowOffsets<float>(depth, stride, to_depth,
+                                                       row_offsets_));
+        BackProjectRows<float>(depth, stride, to_depth, ray_x_, ray_y_,
+                               camera_pose, row_offsets_, output.points_,
+                               no_color);
+    }
+    return true;
+}
+
+bool DepthBackProjector::CreateFromRGBDImage(
+        const RGBDImage &image,
+        const camera::PinholeCameraIntrinsic &intrinsic,
+        const Eigen::Matrix4d &extrinsic,
+        PointCloud &output) {
+    output.Clear();
+    if (image.depth_.num_of_channels_ == 1 &&
+        image.depth_.bytes_per_channel_ == 4) {
+        PrepareRays(intrinsic, image.depth_.width_, image.depth_.height_);
+        Eigen::Matrix4d camera_pose = extrinsic.inverse();
+        if (image.color_.bytes_per_channel_ == 1 &&
+            image.color_.num_of_channels_ == 3) {
+            BackProjectRGBD<uint8_t, 3>(image, ray_x_, ray_y_, camera_pose,
+                                        row_offsets_, output);
+            return true;
+        } else if (image.color_.bytes_per_channel_ == 4 &&
+                   image.color_.num_of_channels_ == 1) {
+            BackProjectRGBD<float, 1>(image, ray_x_, ray_y_, camera_pose,
+                                      row_offsets_, output);
+            return true;
+        }
+    }
+    utility::LogWarning(
+            "[CreatePointCloudFromRGBDImage] Unsupported image format.\n");
+    return false;
+}
+
+}  // namespace geometry
+}  // namespace open3d
@@ -0,0 +1,98 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <vector>
+
+namespace open3d {
+
+namespace camera {
+class PinholeCameraIntrinsic;
+}
+
+namespace geometry {
+
+class Image;
+class PointCloud;
+class RGBDImage;
+
+/// \class DepthBackProjector
+///
+/// Back-projects depth images of one camera into point clouds. The rays with
+/// unit depth through every pixel column and row are cached for the last
+/// intrinsic and image size, so consecutive frames only pay for the
+/// projection itself. Rows are processed in parallel and the valid pixels are
+/// compacted with a prefix sum over the rows, so the output has the same
+/// order as PointCloud::CreateFromDepthImage.
+///
+/// The output point cloud is passed in by the caller, and its storage is
+/// reused across frames.
+class DepthBackProjector {
+public:
+    DepthBackProjector() {}
+    ~DepthBackProjector() {}
+
+public:
+    /// Same as PointCloud::CreateFromDepthImage, but writes into \p output.
+    /// Returns false and clears \p output if the image format is not
+    /// supported.
+    bool CreateFromDepthImage(const Image &depth,
+                              const camera::PinholeCameraIntrinsic &intrinsic,
+                              const Eigen::Matrix4d &extrinsic,
+                              double depth_scale,
+                              double depth_trunc,
+                              int stride,
+                              PointCloud &output);
+
+    /// Same as PointCloud::CreateFromRGBDImage, but writes into \p output.
+    /// Returns false and clears \p output if the image format is not
+    /// supported.
+    bool CreateFromRGBDImage(const RGBDImage &image,
+                             const camera::PinholeCameraIntrinsic &intrinsic,
+                             const Eigen::Matrix4d &extrinsic,
+                             PointCloud &output);
+
+protected:
+    /// Recomputes the ray tables unless they were computed for the same
+    /// intrinsic matrix and image size.
+    void PrepareRays(const camera::PinholeCameraIntrinsic &intrinsic,
+                     int width,
+                     int height);
+
+protected:
+    Eigen::Matrix3d intrinsic_matrix_ = Eigen::Matrix3d::Zero();
+    /// x / z of the ray through each pixel column.
+    std::vector<double> ray_x_;
+    /// y / z of the ray through each pixel row.
+    std::vector<double> ray_y_;
+    /// Output offset of every sampled row.
+    std::vector<int> row_offsets_;
+};
+
+}  // namespace geometry
+}  // namespace open3d
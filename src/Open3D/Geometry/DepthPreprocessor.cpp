@@ -0,0 +1,139 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Geometry/DepthPreprocessor.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Open3D/Geometry/Image.h"
+#include "Open3D/Geometry/RGBDImage.h"
+#include "Open3D/Utility/Console.h"
+
+namespace open3d {
+namespace geometry {
+
+std::shared_ptr<Image> DepthPreprocessor::CreateValidMask(
+        const Image &depth) const {
+    auto mask = std::make_shared<Image>();
+    if (depth.num_of_channels_ != 1 || depth.bytes_per_channel_ != 4) {
+        utility::LogWarning("[DepthPreprocessor] Unsupported image format.\n");
+        return mask;
+    }
+    const int width = depth.width_;
+    const int height = depth.height_;
+    const float depth_min = float(depth_min_);
+    const float depth_max = float(depth_max_);
+    const float threshold = float(discontinuity_threshold_);
+    auto in_range = [depth_min, depth_max](float d) {
+        return d > 0.0f && d >= depth_min && d <= depth_max;
+    };
+    // 255 at discontinuities first, then at valid pixels.
+    auto discontinuities = std::make_shared<Image>();
+    discontinuities->Prepare(width, height, 1, 1);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int v = 0; v < height; v++) {
+        const float *p = depth.PointerAt<float>(0, v);
+        const float *p_up = depth.PointerAt<float>(0, std::max(v - 1, 0));
+        const float *p_down =
+                depth.PointerAt<float>(0, std::min(v + 1, height - 1));
+        uint8_t *m = discontinuities->PointerAt<uint8_t>(0, v);
+        for (int u = 0; u < width; u++) {
+            const float d = p[u];
+            if (!in_range(d)) {
+                m[u] = 0;
+                continue;
+            }
+            const float max_diff = threshold * d;
+            const float neighbours[4] = {p[std::max(u - 1, 0)],
+                                         p[std::min(u + 1, width - 1)],
+                                         p_up[u], p_down[u]};
+            bool is_discontinuity = false;
+            for (int i = 0; i < 4; i++) {
+                if (in_range(neighbours[i]) &&
+                    std::abs(neighbours[i] - d) > max_diff) {
+                    is_discontinuity = true;
+                }
+            }
+            m[u] = is_discontinuity ? 255 : 0;
+        }
+    }
+    if (discontinuity_dilation_ >= 1) {
+        discontinuities = discontinuities->Dilate(discontinuity_dilation_);
+    }
+    mask->Prepare(width, height, 1, 1);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int v = 0; v < height; v++) {
+        const float *p = depth.PointerAt<float>(0, v);
+        const uint8_t *pd = discontinuities->PointerAt<uint8_t>(0, v);
+        uint8_t *m = mask->PointerAt<uint8_t>(0, v);
+        for (int u = 0; u < width; u++) {
+            m[u] = (in_range(p[u]) && pd[u] == 0) ? 255 : 0;
+        }
+    }
+    return mask;
+}
+
+std::shared_ptr<Image> DepthPreprocessor::Process(const Image &depth) const {
+    auto mask = CreateValidMask(depth);
+    if (mask->IsEmpty()) {
+        return std::make_shared<Image>();
+    }
+    auto masked = std::make_shared<Image>();
+    masked->Prepare(depth.width_, depth.height_, 1, 4);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int v = 0; v < depth.height_; v++) {
+        const float *p = depth.PointerAt<float>(0, v);
+        const uint8_t *m = mask->PointerAt<uint8_t>(0, v);
+        float *po = masked->PointerAt<float>(0, v);
+        for (int u = 0; u < depth.width_; u++) {
+            po[u] = m[u] != 0 ? p[u] : 0.0f;
+        }
+    }
+    if (bilateral_half_kernel_size_ <= 0) {
+        return masked;
+    }
+    return masked->FilterBilateral(bilateral_half_kernel_size_,
+                                   bilateral_sigma_space_,
+                                   bilateral_sigma_depth_);
+}
+
+std::shared_ptr<RGBDImage> DepthPreprocessor::Process(
+        const RGBDImage &image) const {
+    auto output = std::make_shared<RGBDImage>();
+    output->color_ = image.color_;
+    output->depth_ = *Process(image.depth_);
+    return output;
+}
+
+}  // namespace geometry
+}  // namespace open3d
@@ -0,0 +1,102 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <memory>
+
+namespace open3d {
+namespace geometry {
+
+class Image;
+class RGBDImage;
+
+/// \class DepthPreprocessor
+///
+/// Cleans up float depth images in meters once per frame, so that
+/// integration, odometry and back-projection can share the result instead of
+/// each handling raw depth on its own. Depth outside of
+/// [depth_min_, depth_max_] and depth next to discontinuities is removed, and
+/// the remaining depth is smoothed with an edge preserving bilateral filter.
+///
+/// Removed pixels are 0 in the output, which every consumer of depth images
+/// already treats as missing depth: pass the output to
+/// ScalableTSDFVolume::Integrate or DepthBackProjector directly, and set
+/// OdometryOption::depth_preprocessed_ for ComputeRGBDOdometry.
+class DepthPreprocessor {
+public:
+    DepthPreprocessor(double depth_min = 0.0,
+                      double depth_max = 4.0,
+                      double discontinuity_threshold = 0.05,
+                      int discontinuity_dilation = 1,
+                      int bilateral_half_kernel_size = 2,
+                      double bilateral_sigma_space = 1.5,
+                      double bilateral_sigma_depth = 0.03)
+        : depth_min_(depth_min),
+          depth_max_(depth_max),
+          discontinuity_threshold_(discontinuity_threshold),
+          discontinuity_dilation_(discontinuity_dilation),
+          bilateral_half_kernel_size_(bilateral_half_kernel_size),
+          bilateral_sigma_space_(bilateral_sigma_space),
+          bilateral_sigma_depth_(bilateral_sigma_depth) {}
+    ~DepthPreprocessor() {}
+
+public:
+    /// Returns an 8 bit image that is 255 where \p depth is valid: in range
+    /// and at least discontinuity_dilation_ pixels away from a
+    /// discontinuity. Returns an empty image if \p depth is not a float image.
+    std::shared_ptr<Image> CreateValidMask(const Image &depth) const;
+
+    /// Returns the float depth that is filtered where CreateValidMask is 255
+    /// and 0 elsewhere. Returns an empty image if \p depth is not a float
+    /// image.
+    std::shared_ptr<Image> Process(const Image &depth) const;
+
+    /// Returns an RGBD image with the color of \p image and its processed
+    /// depth.
+    std::shared_ptr<RGBDImage> Process(const RGBDImage &image) const;
+
+public:
+    /// Valid range of the depth in meters.
+    double depth_min_;
+    double depth_max_;
+    /// A pixel is at a discontinuity if one of its four neighbours differs by
+    /// more than this fraction of its depth.
+    double discontinuity_threshold_;
+    /// Radius in pixels of the region removed around discontinuities, 0 only
+    /// removes the pixels at the discontinuities.
+    int discontinuity_dilation_;
+    /// Radius in pixels of the bilateral filter, 0 disables the filter.
+    int bilateral_half_kernel_size_;
+    /// Standard deviation of the filter weights over the pixel distance.
+    double bilateral_sigma_space_;
+    /// Standard deviation of the filter weights over the depth difference in
+    /// meters.
+    double bilateral_sigma_depth_;
+};
+
+}  // namespace geometry
+}  // namespace open3d
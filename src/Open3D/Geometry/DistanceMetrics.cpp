@@ -0,0 +1,337 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include "Open3D/Geometry/DistanceMetrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Open3D/Geometry/IntersectionTest.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/TriangleMesh.h"
+#include "Open3D/Utility/Console.h"
+
+namespace open3d {
+
+namespace {
+
+/// Number of triangles below which a BVH node becomes a leaf.
+constexpr int kBVHLeafSize = 4;
+
+/// Squared distance from \p point to an axis-aligned box.
+double SquaredDistanceToBox(const Eigen::Vector3d &point,
+                            const Eigen::Vector3d &min_bound,
+                            const Eigen::Vector3d &max_bound) {
+    Eigen::Vector3d d = (min_bound - point)
+                                .cwiseMax(point - max_bound)
+                                .cwiseMax(Eigen::Vector3d::Zero());
+    return d.squaredNorm();
+}
+
+/// Statistics of the distances of one direction of a comparison.
+class DistanceStatistics {
+public:
+    double sum_ = 0.0;
+    double max_ = 0.0;
+    /// Number of distances below each threshold.
+    std::vector<size_t> counts_;
+};
+
+/// Evaluates \p distance(i, indices, dists) for i in [0, n) in parallel and
+/// accumulates the sum, the maximum and the number of distances below each
+/// threshold in one pass. indices and dists are search buffers owned by the
+/// calling thread.
+template <typename DistanceFunc>
+DistanceStatistics AccumulateDistances(int n,
+                                       const std::vector<double> &thresholds,
+                                       const DistanceFunc &distance) {
+    DistanceStatistics statistics;
+    statistics.counts_.resize(thresholds.size(), 0);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        DistanceStatistics local;
+        local.counts_.resize(thresholds.size(), 0);
+        std::vector<int> indices(1);
+        std::vector<double> dists(1);
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (int i = 0; i < n; i++) {
+            double d = distance(i, indices, dists);
+            local.sum_ += d;
+            local.max_ = std::max(local.max_, d);
+            for (size_t t = 0; t < thresholds.size(); t++) {
+                if (d < thresholds[t]) local.counts_[t]++;
+            }
+        }
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        {
+            statistics.sum_ += local.sum_;
+            statistics.max_ = std::max(statistics.max_, local.max_);
+            for (size_t t = 0; t < thresholds.size(); t++) {
+                statistics.counts_[t] += local.counts_[t];
+            }
+        }
+    }
+    return statistics;
+}
+
+}  // unnamed namespace
+
+namespace geometry {
+
+bool DistanceMetrics::SetReference(const PointCloud &reference) {
+    is_mesh_ = false;
+    vertices_.clear();
+    triangles_.clear();
+    bvh_nodes_.clear();
+    bvh_triangles_.clear();
+    reference_points_ = reference.points_;
+    if (reference_points_.empty()) {
+        utility::LogWarning("[DistanceMetrics] Reference has no points.\n");
+        return false;
+    }
+    return kdtree_.SetGeometry(reference);
+}
+
+bool DistanceMetrics::SetReference(const TriangleMesh &reference,
+                                   size_t number_of_points) {
+    is_mesh_ = true;
+    reference_points_.clear();
+    vertices_ = reference.vertices_;
+    triangles_ = reference.triangles_;
+    bvh_nodes_.clear();
+    bvh_triangles_.clear();
+    if (triangles_.empty() || number_of_points == 0) {
+        utility::LogWarning(
+                "[DistanceMetrics] Reference needs triangles and sample "
+                "points.\n");
+        return false;
+    }
+
+    std::vector<Eigen::Vector3d> centers(triangles_.size());
+    for (size_t t = 0; t < triangles_.size(); t++) {
+        const Eigen::Vector3i &triangle = triangles_[t];
+        centers[t] = (vertices_[triangle(0)] + vertices_[triangle(1)] +
+                      vertices_[triangle(2)]) /
+                     3.0;
+    }
+    bvh_triangles_.resize(triangles_.size());
+    for (size_t t = 0; t < triangles_.size(); t++) {
+        bvh_triangles_[t] = int(t);
+    }
+    bvh_nodes_.reserve(2 * triangles_.size() / kBVHLeafSize + 1);
+    BuildBVH(0, int(triangles_.size()), centers);
+
+    reference_points_ =
+            reference.SamplePointsUniformly(number_of_points)->points_;
+    return true;
+}
+
+int DistanceMetrics::BuildBVH(int begin,
+                              int end,
+                              const std::vector<Eigen::Vector3d> &centers) {
+    int index = int(bvh_nodes_.size());
+    bvh_nodes_.push_back(BVHNode());
+    Eigen::Vector3d min_bound = Eigen::Vector3d::Constant(
+            std::numeric_limits<double>::infinity());
+    Eigen::Vector3d max_bound = -min_bound;
+    Eigen::Vector3d min_center = min_bound;
+    Eigen::Vector3d max_center = max_bound;
+    for (int k = begin; k < end; k++) {
+        const Eigen::Vector3i &triangle = triangles_[bvh_triangles_[k]];
+        for (int v = 0; v < 3; v++) {
+            min_bound = min_bound.cwiseMin(vertices_[triangle(v)]);
+            max_bound = max_bound.cwiseMax(vertices_[triangle(v)]);
+        }
+        min_center = min_center.cwiseMin(centers[bvh_triangles_[k]]);
+        max_center = max_center.cwiseMax(centers[bvh_triangles_[k]]);
+    }
+    bvh_nodes_[index].min_bound_ = min_bound;
+    bvh_nodes_[index].max_bound_ = max_bound;
+    bvh_nodes_[index].begin_ = begin;
+    bvh_nodes_[index].end_ = end;
+    if (end - begin <= kBVHLeafSize) {
+        return index;
+    }
+
+    // Split at the median of the triangle centers along the longest axis.
+    int axis;
+    (max_center - min_center).maxCoeff(&axis);
+    int middle = begin + (end - begin) / 2;
+    std::nth_element(bvh_triangles_.begin() + begin,
+                     bvh_triangles_.begin() + middle,
+                     bvh_triangles_.begin() + end, [&](int a, int b) {
+                         return centers[a](axis) < centers[b](axis);
+                     });
+    int left = BuildBVH(begin, middle, centers);
+    int right = BuildBVH(middle, end, centers);
+    bvh_nodes_[index].left_ = left;
+    bvh_nodes_[index].right_ = right;
+    return index;
+}
+
+double DistanceMetrics::SquaredDistanceToMesh(
+        const Eigen::Vector3d &point) const {
+    double best = std::numeric_limits<double>::infinity();
+    // The median split keeps the depth of the hierarchy logarithmic, so a
+    // small fixed stack suffices.
+    int stack[128];
+    int stack_size = 0;
+    stack[stack_size++] = 0;
+    while (stack_size > 0) {
+        const BVHNode &node = bvh_nodes_[stack[--stack_size]];
+        if (SquaredDistanceToBox(point, node.min_bound_, node.max_bound_) >=
+            best) {
+            continue;
+        }
+        if (node.left_ < 0) {
+            for (int k = node.begin_; k < node.end_; k++) {
+                const Eigen::Vector3i &triangle = triangles_[bvh_triangles_[k]];
+                Eigen::Vector3d closest =
+                        IntersectionTest::PointTriangleClosestPoint(
+                                point, vertices_[triangle(0)],
+                                vertices_[triangle(1)], vertices_[triangle(2)]);
+                best = std::min(best, (point - closest).squaredNorm());
+            }
+            continue;
+        }
+        // Visit the closer child first.
+        const BVHNode &left = bvh_nodes_[node.left_];
+        const BVHNode &right = bvh_nodes_[node.right_];
+        double left_distance =
+                SquaredDistanceToBox(point, left.min_bound_, left.max_bound_);
+        double right_distance =
+                SquaredDistanceToBox(point, right.min_bound_, right.max_bound_);
+        if (left_distance < right_distance) {
+            stack[stack_size++] = node.right_;
+            stack[stack_size++] = node.left_;
+        } else {
+            stack[stack_size++] = node.left_;
+            stack[stack_size++] = node.right_;
+        }
+    }
+    return best;
+}
+
+std::vector<double> DistanceMetrics::ComputeDistance(
+        const std::vector<Eigen::Vector3d> &points) const {
+    std::vector<double> distances(points.size(), 0.0);
+    if (is_mesh_ ? bvh_nodes_.empty() : reference_points_.empty()) {
+        utility::LogWarning("[DistanceMetrics] Reference is not set.\n");
+        return distances;
+    }
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        std::vector<int> indices(1);
+        std::vector<double> dists(1);
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (int i = 0; i < (int)points.size(); i++) {
+            if (is_mesh_) {
+                distances[i] = std::sqrt(SquaredDistanceToMesh(points[i]));
+            } else if (kdtree_.SearchKNN(points[i], 1, indices, dists) > 0) {
+                distances[i] = std::sqrt(dists[0]);
+            }
+        }
+    }
+    return distances;
+}
+
+DistanceMetricsResult DistanceMetrics::Compute(
+        const PointCloud &query, const std::vector<double> &thresholds) const {
+    DistanceMetricsResult result;
+    result.thresholds_ = thresholds;
+    if (is_mesh_ ? bvh_nodes_.empty() : reference_points_.empty()) {
+        utility::LogWarning("[DistanceMetrics] Reference is not set.\n");
+        return result;
+    }
+    if (!query.HasPoints()) {
+        utility::LogWarning("[DistanceMetrics] Query has no points.\n");
+        return result;
+    }
+
+    // query -> reference
+    const auto &query_points = query.points_;
+    DistanceStatistics forward;
+    if (is_mesh_) {
+        forward = AccumulateDistances(
+                int(query_points.size()), thresholds,
+                [&](int i, std::vector<int> &, std::vector<double> &) {
+                    return std::sqrt(SquaredDistanceToMesh(query_points[i]));
+                });
+    } else {
+        forward = AccumulateDistances(
+                int(query_points.size()), thresholds,
+                [&](int i, std::vector<int> &indices,
+                    std::vector<double> &dists) {
+                    // Like ComputeDistance, a point without a neighbor,
+                    // e.g. a NaN point, is at distance 0.
+                    if (kdtree_.SearchKNN(query_points[i], 1, indices,
+                                          dists) > 0) {
+                        return std::sqrt(dists[0]);
+                    }
+                    return 0.0;
+                });
+    }
+
+    // reference -> query
+    KDTreeFlann query_kdtree(query);
+    DistanceStatistics backward = AccumulateDistances(
+            int(reference_points_.size()), thresholds,
+            [&](int i, std::vector<int> &indices, std::vector<double> &dists) {
+                if (query_kdtree.SearchKNN(reference_points_[i], 1, indices,
+                                           dists) > 0) {
+                    return std::sqrt(dists[0]);
+                }
+                return 0.0;
+            });
+
+    result.chamfer_distance_ = forward.sum_ / query_points.size() +
+                               backward.sum_ / reference_points_.size();
+    result.hausdorff_distance_ = std::max(forward.max_, backward.max_);
+    for (size_t t = 0; t < thresholds.size(); t++) {
+        double precision = double(forward.counts_[t]) / query_points.size();
+        double recall = double(backward.counts_[t]) / reference_points_.size();
+        result.precision_.push_back(precision);
+        result.recall_.push_back(recall);
+        result.fscore_.push_back(precision + recall > 0
+                                         ? 2.0 * precision * recall /
+                                                   (precision + recall)
+                                         : 0.0);
+    }
+    return result;
+}
+
+}  // namespace geometry
+}  // namespace open3d
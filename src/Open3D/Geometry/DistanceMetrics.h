@@ -0,0 +1,129 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#pragma once
+
+#include <Eigen/Core>
+#include <vector>
+
+#include "Open3D/Geometry/KDTreeFlann.h"
+
+namespace open3d {
+namespace geometry {
+
+class PointCloud;
+class TriangleMesh;
+
+/// \class DistanceMetricsResult
+///
+/// Symmetric distances between a point cloud and a reference geometry.
+class DistanceMetricsResult {
+public:
+    DistanceMetricsResult() {}
+    ~DistanceMetricsResult() {}
+
+public:
+    /// Mean distance from the query to the reference plus mean distance from
+    /// the reference to the query.
+    double chamfer_distance_ = 0.0;
+    /// Largest distance in either direction.
+    double hausdorff_distance_ = 0.0;
+    /// Distance thresholds of precision_, recall_ and fscore_.
+    std::vector<double> thresholds_;
+    /// Fraction of query points closer to the reference than each threshold.
+    std::vector<double> precision_;
+    /// Fraction of reference points closer to the query than each threshold.
+    std::vector<double> recall_;
+    /// Harmonic mean of precision_ and recall_.
+    std::vector<double> fscore_;
+};
+
+/// \class DistanceMetrics
+///
+/// Compares point clouds with a fixed reference, either a point cloud or a
+/// triangle mesh. The search structure of the reference is built once in
+/// SetReference and reused by every comparison, and both directions of a
+/// comparison are computed in parallel.
+///
+/// Distances to a mesh are exact point-to-triangle distances found with a
+/// bounding volume hierarchy over the triangles. Distances from a mesh are
+/// measured from points sampled uniformly on its surface.
+class DistanceMetrics {
+public:
+    DistanceMetrics() {}
+    ~DistanceMetrics() {}
+    DistanceMetrics(const DistanceMetrics &) = delete;
+    DistanceMetrics &operator=(const DistanceMetrics &) = delete;
+
+public:
+    /// Sets a point cloud as reference.
+    bool SetReference(const PointCloud &reference);
+    /// Sets a triangle mesh as reference. \p number_of_points points are
+    /// sampled uniformly on the mesh to measure the distances from it.
+    bool SetReference(const TriangleMesh &reference, size_t number_of_points);
+
+    /// Distance from each of \p points to the reference.
+    std::vector<double> ComputeDistance(
+            const std::vector<Eigen::Vector3d> &points) const;
+
+    /// Compares \p query with the reference in both directions. Precision,
+    /// recall and F-score are computed for every distance threshold in the
+    /// same pass as the distances.
+    DistanceMetricsResult Compute(const PointCloud &query,
+                                  const std::vector<double> &thresholds) const;
+
+protected:
+    /// Node of the bounding volume hierarchy over the mesh triangles. Leaves
+    /// hold bvh_triangles_[begin_:end_], inner nodes have two children.
+    class BVHNode {
+    public:
+        Eigen::Vector3d min_bound_ = Eigen::Vector3d::Zero();
+        Eigen::Vector3d max_bound_ = Eigen::Vector3d::Zero();
+        int left_ = -1;
+        int right_ = -1;
+        int begin_ = 0;
+        int end_ = 0;
+    };
+
+    int BuildBVH(int begin,
+                 int end,
+                 const std::vector<Eigen::Vector3d> &centers);
+    double SquaredDistanceToMesh(const Eigen::Vector3d &point) const;
+
+protected:
+    bool is_mesh_ = false;
+    /// Points of the reference cloud, or points sampled on the reference
+    /// mesh.
+    std::vector<Eigen::Vector3d> reference_points_;
+    /// KDTree of the reference cloud.
+    KDTreeFlann kdtree_;
+    std::vector<Eigen::Vector3d> vertices_;
+    std::vector<Eigen::Vector3i> triangles_;
+    std::vector<BVHNode> bvh_nodes_;
+    std::vector<int> bvh_triangles_;
+};
+
+}  // namespace geometry
+}  // namespace open3d
@@ -27,12 +27,17 @@
 #include <numeric>
 #include <unordered_map>
 
+#include "Open3D/Geometry/FixedRadiusGrid.h"
 #include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Geometry/TriangleMesh.h"
 #include "Open3D/Utility/Console.h"
 #include "Open3D/Utility/Helper.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace open3d {
 
 namespace {
@@ -138,31 +143,218 @@ private:
     std::unordered_map<int, int> classes;
 };
 
+/// Returns the indices of the non-zero entries of \p mask in increasing
+/// order. The mask is split into one block per thread: every block counts its
+/// entries, the counts give the offset of each block in the output, and every
+/// block then writes its indices from its offset.
+std::vector<size_t> MaskToIndices(const std::vector<char> &mask) {
+#ifdef _OPENMP
+    int num_blocks = omp_get_max_threads();
+#else
+    int num_blocks = 1;
+#endif
+    int64_t n = int64_t(mask.size());
+    std::vector<size_t> offsets(num_blocks + 1, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, 1)
+#endif
+    for (int b = 0; b < num_blocks; b++) {
+        size_t count = 0;
+        for (int64_t i = n * b / num_blocks; i < n * (b + 1) / num_blocks;
+             i++) {
+            count += mask[i] != 0;
+        }
+        offsets[b + 1] = count;
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<size_t> indices(offsets[num_blocks]);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, 1)
+#endif
+    for (int b = 0; b < num_blocks; b++) {
+        size_t k = offsets[b];
+        for (int64_t i = n * b / num_blocks; i < n * (b + 1) / num_blocks;
+             i++) {
+            if (mask[i] != 0) {
+                indices[k++] = size_t(i);
+            }
+        }
+    }
+    return indices;
+}
+
+/// Copies the points, normals and colors at \p indices into a new point
+/// cloud.
+std::shared_ptr<PointCloud> SelectPoints(const PointCloud &input,
+                                         const std::vector<size_t> &indices) {
+    auto output = std::make_shared<PointCloud>();
+    bool has_normals = input.HasNormals();
+    bool has_colors = input.HasColors();
+    output->points_.resize(indices.size());
+    if (has_normals) output->normals_.resize(indices.size());
+    if (has_colors) output->colors_.resize(indices.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int k = 0; k < int(indices.size()); k++) {
+        size_t i = indices[k];
+        output->points_[k] = input.points_[i];
+        if (has_normals) output->normals_[k] = input.normals_[i];
+        if (has_colors) output->colors_[k] = input.colors_[i];
+    }
+    utility::LogDebug(
+            "Pointcloud down sampled from {:d} points to {:d} points.\n",
+            (int)input.points_.size(), (int)output->points_.size());
+    return output;
+}
+
+/// Sets mask[i] for the points that have more than \p nb_points neighbors
+/// within \p search_radius, the point itself included.
+bool ComputeRadiusInliers(const PointCloud &input,
+                          size_t nb_points,
+                          double search_radius,
+                          std::vector<char> &mask) {
+    if (nb_points < 1 || search_radius <= 0) {
+        utility::LogWarning(
+                "[RemoveRadiusOutliers] Illegal input parameters,"
+                "number of points and radius must be positive\n");
+        return false;
+    }
+    int n = int(input.points_.size());
+    mask.assign(n, 0);
+    FixedRadiusGrid grid;
+    if (grid.SetPoints(input.points_, search_radius)) {
+        std::vector<size_t> num_neighbors(n, 0);
+        grid.ForEachNeighbor([](int) { return true; },
+                             [&](int i, int, double) { num_neighbors[i]++; });
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int i = 0; i < n; i++) {
+            mask[i] = num_neighbors[i] > nb_points;
+        }
+        return true;
+    }
+
+    // The radius is too small for a grid over the extent of the points.
+    KDTreeFlann kdtree;
+    kdtree.SetGeometry(input);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        std::vector<int> tmp_indices;
+        std::vector<double> dist;
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (int i = 0; i < n; i++) {
+            size_t nb_neighbors = kdtree.SearchRadius(
+                    input.points_[i], search_radius, tmp_indices, dist);
+            mask[i] = nb_neighbors > nb_points;
+        }
+    }
+    return true;
+}
+
+/// Sets mask[i] for the points whose average distance to their
+/// \p nb_neighbors nearest neighbors is below the mean of all average
+/// distances plus \p std_ratio times their standard deviation.
+bool ComputeStatisticalInliers(const PointCloud &input,
+                               size_t nb_neighbors,
+                               double std_ratio,
+                               std::vector<char> &mask) {
+    if (nb_neighbors < 1 || std_ratio <= 0) {
+        utility::LogWarning(
+                "[RemoveStatisticalOutliers] Illegal input parameters, number "
+                "of neighbors"
+                "and standard deviation ratio must be positive\n");
+        return false;
+    }
+    int n = int(input.points_.size());
+    mask.assign(n, 0);
+    if (n == 0) {
+        return true;
+    }
+    KDTreeFlann kdtree;
+    kdtree.SetGeometry(input);
+    std::vector<double> avg_distances = std::vector<double>(n);
+    size_t valid_distances = 0;
+#ifdef _OPENMP
+#pragma omp parallel reduction(+ : valid_distances)
+#endif
+    {
+        std::vector<int> tmp_indices;
+        std::vector<double> dist;
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (int i = 0; i < n; i++) {
+            kdtree.SearchKNN(input.points_[i], int(nb_neighbors), tmp_indices,
+                             dist);
+            double mean = -1.0;
+            if (dist.size() > 0u) {
+                valid_distances++;
+                double sum = 0.0;
+                for (double d : dist) {
+                    sum += std::sqrt(d);
+                }
+                mean = sum / dist.size();
+            }
+            avg_distances[i] = mean;
+        }
+    }
+    if (valid_distances == 0) {
+        return true;
+    }
+    double cloud_mean = std::accumulate(
+            avg_distances.begin(), avg_distances.end(), 0.0,
+            [](double const &x, double const &y) { return y > 0 ? x + y : x; });
+    cloud_mean /= valid_distances;
+    double sq_sum = std::inner_product(
+            avg_distances.begin(), avg_distances.end(), avg_distances.begin(),
+            0.0, [](double const &x, double const &y) { return x + y; },
+            [cloud_mean](double const &x, double const &y) {
+                return x > 0 ? (x - cloud_mean) * (y - cloud_mean) : 0;
+            });
+    // Bessel's correction
+    double std_dev = std::sqrt(sq_sum / (valid_distances - 1));
+    double distance_threshold = cloud_mean + std_ratio * std_dev;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < n; i++) {
+        mask[i] = avg_distances[i] > 0 && avg_distances[i] < distance_threshold;
+    }
+    return true;
+}
+
 }  // unnamed namespace
 
 namespace geometry {
 std::shared_ptr<PointCloud> PointCloud::SelectDownSample(
         const std::vector<size_t> &indices, bool invert /* = false */) const {
-    auto output = std::make_shared<PointCloud>();
-    bool has_normals = HasNormals();
-    bool has_colors = HasColors();
-
-    std::vector<bool> mask = std::vector<bool>(points_.size(), invert);
+    std::vector<char> mask(points_.size(), invert);
     for (size_t i : indices) {
         mask[i] = !invert;
     }
+    return SelectPoints(*this, MaskToIndices(mask));
+}
 
-    for (size_t i = 0; i < points_.size(); i++) {
-        if (mask[i]) {
-            output->points_.push_back(points_[i]);
-            if (has_normals) output->normals_.push_back(normals_[i]);
-            if (has_colors) output->colors_.push_back(colors_[i]);
-        }
+std::shared_ptr<PointCloud> PointCloud::SelectDownSampleByMask(
+        const std::vector<bool> &mask, bool invert /* = false */) const {
+    if (mask.size() != points_.size()) {
+        utility::LogWarning(
+                "[SelectDownSampleByMask] Size of mask ({:d}) does not match "
+                "the number of points ({:d}).\n",
+                mask.size(), points_.size());
+        return std::make_shared<PointCloud>();
     }
-    utility::LogDebug(
-            "Pointcloud down sampled from {:d} points to {:d} points.\n",
-            (int)points_.size(), (int)output->points_.size());
-    return output;
+    std::vector<char> select(mask.size());
+    for (size_t i = 0; i < mask.size(); i++) {
+        select[i] = mask[i] != invert;
+    }
+    return SelectPoints(*this, MaskToIndices(select));
 }
 
 std::shared_ptr<TriangleMesh> TriangleMesh::SelectDownSample(
@@ -394,96 +586,45 @@ std::shared_ptr<PointCloud> PointCloud::Crop(
     return SelectDownSample(indices);
 }
 
+std::vector<bool> PointCloud::ComputeRadiusInlierMask(
+        size_t nb_points, double search_radius) const {
+    std::vector<char> mask;
+    if (!ComputeRadiusInliers(*this, nb_points, search_radius, mask)) {
+        return std::vector<bool>();
+    }
+    return std::vector<bool>(mask.begin(), mask.end());
+}
+
+std::vector<bool> PointCloud::ComputeStatisticalInlierMask(
+        size_t nb_neighbors, double std_ratio) const {
+    std::vector<char> mask;
+    if (!ComputeStatisticalInliers(*this, nb_neighbors, std_ratio, mask)) {
+        return std::vector<bool>();
+    }
+    return std::vector<bool>(mask.begin(), mask.end());
+}
+
 std::tuple<std::shared_ptr<PointCloud>, std::vector<size_t>>
 PointCloud::RemoveRadiusOutliers(size_t nb_points, double search_radius) const {
-    if (nb_points < 1 || search_radius <= 0) {
-        utility::LogWarning(
-                "[RemoveRadiusOutliers] Illegal input parameters,"
-                "number of points and radius must be positive\n");
+    std::vector<char> mask;
+    if (!ComputeRadiusInliers(*this, nb_points, search_radius, mask)) {
         return std::make_tuple(std::make_shared<PointCloud>(),
                                std::vector<size_t>());
     }
-    KDTreeFlann kdtree;
-    kdtree.SetGeometry(*this);
-    std::vector<bool> mask = std::vector<bool>(points_.size());
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int i = 0; i < int(points_.size()); i++) {
-        std::vector<int> tmp_indices;
-        std::vector<double> dist;
-        size_t nb_neighbors = kdtree.SearchRadius(points_[i], search_radius,
-                                                  tmp_indices, dist);
-        mask[i] = (nb_neighbors > nb_points);
-    }
-    std::vector<size_t> indices;
-    for (size_t i = 0; i < mask.size(); i++) {
-        if (mask[i]) {
-            indices.push_back(i);
-        }
-    }
-    return std::make_tuple(SelectDownSample(indices), indices);
+    std::vector<size_t> indices = MaskToIndices(mask);
+    return std::make_tuple(SelectPoints(*this, indices), indices);
 }
 
 std::tuple<std::shared_ptr<PointCloud>, std::vector<size_t>>
 PointCloud::RemoveStatisticalOutliers(size_t nb_neighbors,
                                       double std_ratio) const {
-    if (nb_neighbors < 1 || std_ratio <= 0) {
-        utility::LogWarning(
-                "[RemoveStatisticalOutliers] Illegal input parameters, number "
-                "of neighbors"
-                "and standard deviation ratio must be positive\n");
-        return std::make_tuple(std::make_shared<PointCloud>(),
-                               std::vector<size_t>());
-    }
-    if (points_.size() == 0) {
-        return std::make_tuple(std::make_shared<PointCloud>(),
-                               std::vector<size_t>());
-    }
-    KDTreeFlann kdtree;
-    kdtree.SetGeometry(*this);
-    std::vector<double> avg_distances = std::vector<double>(points_.size());
-    std::vector<size_t> indices;
-    size_t valid_distances = 0;
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int i = 0; i < int(points_.size()); i++) {
-        std::vector<int> tmp_indices;
-        std::vector<double> dist;
-        kdtree.SearchKNN(points_[i], int(nb_neighbors), tmp_indices, dist);
-        double mean = -1.0;
-        if (dist.size() > 0u) {
-            valid_distances++;
-            std::for_each(dist.begin(), dist.end(),
-                          [](double &d) { d = std::sqrt(d); });
-            mean = std::accumulate(dist.begin(), dist.end(), 0.0) / dist.size();
-        }
-        avg_distances[i] = mean;
-    }
-    if (valid_distances == 0) {
+    std::vector<char> mask;
+    if (!ComputeStatisticalInliers(*this, nb_neighbors, std_ratio, mask)) {
         return std::make_tuple(std::make_shared<PointCloud>(),
                                std::vector<size_t>());
     }
-    double cloud_mean = std::accumulate(
-            avg_distances.begin(), avg_distances.end(), 0.0,
-            [](double const &x, double const &y) { return y > 0 ? x + y : x; });
-    cloud_mean /= valid_distances;
-    double sq_sum = std::inner_product(
-            avg_distances.begin(), avg_distances.end(), avg_distances.begin(),
-            0.0, [](double const &x, double const &y) { return x + y; },
-            [cloud_mean](double const &x, double const &y) {
-                return x > 0 ? (x - cloud_mean) * (y - cloud_mean) : 0;
-            });
-    // Bessel's correction
-    double std_dev = std::sqrt(sq_sum / (valid_distances - 1));
-    double distance_threshold = cloud_mean + std_ratio * std_dev;
-    for (size_t i = 0; i < avg_distances.size(); i++) {
-        if (avg_distances[i] > 0 && avg_distances[i] < distance_threshold) {
-            indices.push_back(i);
-        }
-    }
-    return std::make_tuple(SelectDownSample(indices), indices);
+    std::vector<size_t> indices = MaskToIndices(mask);
+    return std::make_tuple(SelectPoints(*this, indices), indices);
 }
 
 std::shared_ptr<TriangleMesh> TriangleMesh::Crop(
@@ -25,9 +25,18 @@
 // ----------------------------------------------------------------------------
 
 #include <Eigen/Eigenvalues>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <queue>
 
 #include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/PointCloudNeighborhoods.h"
 #include "Open3D/Utility/Console.h"
 
 namespace open3d {
@@ -217,16 +226,13 @@ Eigen::Vector3d FastEigen3x3(Eigen::Matrix3d &A) {
     }
 }
 
-Eigen::Vector3d ComputeNormal(const PointCloud &cloud,
-                              const std::vector<int> &indices,
-                              bool fast_normal_computation) {
-    if (indices.size() == 0) {
-        return Eigen::Vector3d::Zero();
-    }
+Eigen::Matrix3d ComputeCovariance(const PointCloud &cloud,
+                                  const int *indices,
+                                  int count) {
     Eigen::Matrix3d covariance;
     Eigen::Matrix<double, 9, 1> cumulants;
     cumulants.setZero();
-    for (size_t i = 0; i < indices.size(); i++) {
+    for (int i = 0; i < count; i++) {
         const Eigen::Vector3d &point = cloud.points_[indices[i]];
         cumulants(0) += point(0);
         cumulants(1) += point(1);
@@ -238,7 +244,7 @@ Eigen::Vector3d ComputeNormal(const PointCloud &cloud,
         cumulants(7) += point(1) * point(2);
         cumulants(8) += point(2) * point(2);
     }
-    cumulants /= (double)indices.size();
+    cumulants /= (double)count;
     covariance(0, 0) = cumulants(3) - cumulants(0) * cumulants(0);
     covariance(1, 1) = cumulants(6) - cumulants(1) * cumulants(1);
     covariance(2, 2) = cumulants(8) - cumulants(2) * cumulants(2);
@@ -248,9 +254,14 @@ Eigen::Vector3d ComputeNormal(const PointCloud &cloud,
     covariance(2, 0) = covariance(0, 2);
     covariance(1, 2) = cumulants(7) - cumulants(1) * cumulants(2);
     covariance(2, 1) = covariance(1, 2);
+    return covariance;
+}
 
+Eigen::Vector3d ComputeNormal(const Eigen::Matrix3d &covariance,
+                              bool fast_normal_computation) {
     if (fast_normal_computation) {
-        return FastEigen3x3(covariance);
+        Eigen::Matrix3d A = covariance;
+        return FastEigen3x3(A);
     } else {
         Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver;
         solver.compute(covariance, Eigen::ComputeEigenvectors);
@@ -258,6 +269,145 @@ Eigen::Vector3d ComputeNormal(const PointCloud &cloud,
     }
 }
 
+/// Computes normals_[i] from the \p count neighbors at \p indices and
+/// returns the surface variation lambda_0 / (lambda_0 + lambda_1 + lambda_2)
+/// of the neighborhood, where lambda_0 is the smallest eigenvalue of its
+/// covariance. If the cloud had normals before (\p has_normal), the new
+/// normal is oriented like the previous one.
+double EstimateNormal(PointCloud &cloud,
+                      int i,
+                      const int *indices,
+                      int count,
+                      bool has_normal,
+                      bool fast_normal_computation) {
+    if (count < 3) {
+        cloud.normals_[i] = Eigen::Vector3d(0.0, 0.0, 1.0);
+        return 0.0;
+    }
+    Eigen::Matrix3d covariance = ComputeCovariance(cloud, indices, count);
+    Eigen::Vector3d normal = ComputeNormal(covariance, fast_normal_computation);
+    double curvature = 0.0;
+    if (normal.norm() == 0.0) {
+        if (has_normal) {
+            normal = cloud.normals_[i];
+        } else {
+            normal = Eigen::Vector3d(0.0, 0.0, 1.0);
+        }
+    } else {
+        // The normal is the eigenvector of the smallest eigenvalue, which is
+        // therefore its Rayleigh quotient.
+        double trace = covariance.trace();
+        if (trace > 0.0) {
+            curvature = normal.dot(covariance * normal) / trace;
+        }
+    }
+    if (has_normal && normal.dot(cloud.normals_[i]) < 0.0) {
+        normal *= -1.0;
+    }
+    cloud.normals_[i] = normal;
+    return curvature;
+}
+
+/// Computes a minimum spanning forest of the graph on \p num_vertices
+/// vertices with the given \p edges and non-negative \p weights, using
+/// Boruvka's algorithm. In every round each component finds its lightest
+/// outgoing edge in a parallel pass over the edges, and the components are
+/// joined along these edges. Ties are broken by edge index, which makes the
+/// forest unique. Writes the indices of the forest edges to \p forest.
+/// Returns false if there are too many edges for the 32 bit edge indices of
+/// the sort keys.
+bool ComputeMinimumSpanningForest(int num_vertices,
+                                  const std::vector<Eigen::Vector2i> &edges,
+                                  const std::vector<float> &weights,
+                                  std::vector<size_t> &forest) {
+    forest.clear();
+    if (edges.size() > size_t(std::numeric_limits<uint32_t>::max())) {
+        utility::LogWarning(
+                "[ComputeMinimumSpanningForest] Too many edges: {:d}.\n",
+                edges.size());
+        return false;
+    }
+    const uint64_t no_edge = std::numeric_limits<uint64_t>::max();
+    std::vector<int> parent(num_vertices);
+    std::vector<int> size(num_vertices, 1);
+    std::vector<int> component(num_vertices);
+    std::iota(parent.begin(), parent.end(), 0);
+    std::iota(component.begin(), component.end(), 0);
+    std::vector<std::atomic<uint64_t>> lightest(num_vertices);
+    // Union by size keeps the trees shallow, so roots are found without
+    // path compression and can be looked up concurrently.
+    auto find_root = [&](int x) {
+        while (parent[x] != x) {
+            x = parent[x];
+        }
+        return x;
+    };
+    auto update_lightest = [&](int c, uint64_t key) {
+        uint64_t current = lightest[c].load();
+        while (key < current &&
+               !lightest[c].compare_exchange_weak(current, key)) {
+        }
+    };
+
+    int64_t num_edges = int64_t(edges.size());
+    while (true) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int i = 0; i < num_vertices; i++) {
+            lightest[i].store(no_edge);
+        }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int64_t e = 0; e < num_edges; e++) {
+            int cu = component[edges[e](0)];
+            int cv = component[edges[e](1)];
+            if (cu == cv) {
+                continue;
+            }
+            // The bits of a non-negative float sort like its value.
+            uint32_t weight_bits;
+            std::memcpy(&weight_bits, &weights[e], sizeof(float));
+            uint64_t key = (uint64_t(weight_bits) << 32) | uint64_t(e);
+            update_lightest(cu, key);
+            update_lightest(cv, key);
+        }
+
+        bool merged = false;
+        for (int c = 0; c < num_vertices; c++) {
+            uint64_t key = lightest[c].load();
+            if (component[c] != c || key == no_edge) {
+                continue;
+            }
+            size_t e = size_t(key & 0xffffffff);
+            int ru = find_root(edges[e](0));
+            int rv = find_root(edges[e](1));
+            if (ru == rv) {
+                // both components picked the same edge
+                continue;
+            }
+            if (size[ru] < size[rv]) {
+                std::swap(ru, rv);
+            }
+            parent[rv] = ru;
+            size[ru] += size[rv];
+            forest.push_back(e);
+            merged = true;
+        }
+        if (!merged) {
+            break;
+        }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int i = 0; i < num_vertices; i++) {
+            component[i] = find_root(i);
+        }
+    }
+    return true;
+}
+
 }  // unnamed namespace
 
 namespace geometry {
@@ -271,31 +421,60 @@ bool PointCloud::EstimateNormals(
     }
     KDTreeFlann kdtree;
     kdtree.SetGeometry(*this);
+    // Each thread processes a contiguous range of the Morton order, so its
+    // queries stay in a small part of the KDTree.
+    std::vector<int> order = ComputeMortonOrder(points_);
 #ifdef _OPENMP
-#pragma omp parallel for schedule(static)
+#pragma omp parallel
 #endif
-    for (int i = 0; i < (int)points_.size(); i++) {
+    {
         std::vector<int> indices;
         std::vector<double> distance2;
-        Eigen::Vector3d normal;
-        if (kdtree.Search(points_[i], search_param, indices, distance2) >= 3) {
-            normal = ComputeNormal(*this, indices, fast_normal_computation);
-            if (normal.norm() == 0.0) {
-                if (has_normal) {
-                    normal = normals_[i];
-                } else {
-                    normal = Eigen::Vector3d(0.0, 0.0, 1.0);
-                }
-            }
-            if (has_normal && normal.dot(normals_[i]) < 0.0) {
-                normal *= -1.0;
-            }
-            normals_[i] = normal;
-        } else {
-            normals_[i] = Eigen::Vector3d(0.0, 0.0, 1.0);
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (int k = 0; k < (int)order.size(); k++) {
+            int i = order[k];
+            int count = kdtree.Search(points_[i], search_param, indices,
+                                      distance2);
+            EstimateNormal(*this, i, indices.data(), count, has_normal,
+                           fast_normal_computation);
         }
     }
+    return true;
+}
 
+bool PointCloud::EstimateNormals(
+        const PointCloudNeighborhoods &neighborhoods,
+        bool fast_normal_computation /* = true */) {
+    std::vector<double> curvatures;
+    return EstimateNormals(neighborhoods, curvatures, fast_normal_computation);
+}
+
+bool PointCloud::EstimateNormals(
+        const PointCloudNeighborhoods &neighborhoods,
+        std::vector<double> &curvatures,
+        bool fast_normal_computation /* = true */) {
+    if (neighborhoods.Size() != points_.size()) {
+        utility::LogWarning(
+                "[EstimateNormals] Neighborhoods were computed for {:d} "
+                "points, but the PointCloud has {:d} points.\n",
+                neighborhoods.Size(), points_.size());
+        return false;
+    }
+    bool has_normal = HasNormals();
+    if (HasNormals() == false) {
+        normals_.resize(points_.size());
+    }
+    curvatures.resize(points_.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < (int)points_.size(); i++) {
+        curvatures[i] = EstimateNormal(*this, i, neighborhoods.Indices(i),
+                                       neighborhoods.NumNeighbors(i),
+                                       has_normal, fast_normal_computation);
+    }
     return true;
 }
 
@@ -347,5 +526,117 @@ bool PointCloud::OrientNormalsTowardsCameraLocation(
     }
     return true;
 }
+
+bool PointCloud::OrientNormalsConsistentTangentPlane(size_t k) {
+    if (HasNormals() == false) {
+        utility::LogWarning(
+                "[OrientNormalsConsistentTangentPlane] No normals in the "
+                "PointCloud. Call EstimateNormals() first.\n");
+        return false;
+    }
+    int n = int(points_.size());
+    // Every point has k + 1 neighbors, itself included, and one edge to
+    // each of them.
+    if (k == 0 ||
+        size_t(n) * (k + 1) > size_t(std::numeric_limits<uint32_t>::max())) {
+        utility::LogWarning(
+                "[OrientNormalsConsistentTangentPlane] Illegal number of "
+                "neighbors {:d} for {:d} points.\n",
+                k, n);
+        return false;
+    }
+
+    // Riemannian graph: every point is joined to its k nearest neighbors,
+    // with a small weight if their tangent planes are nearly parallel. An
+    // edge found from both of its ends is kept twice, which does not change
+    // the spanning forest.
+    std::vector<Eigen::Vector2i> edges;
+    std::vector<float> weights;
+    {
+        PointCloudNeighborhoods neighborhoods(
+                *this, KDTreeSearchParamKNN(int(k) + 1));
+        edges.resize(neighborhoods.indices_.size());
+        weights.resize(neighborhoods.indices_.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int i = 0; i < n; i++) {
+            for (size_t e = neighborhoods.offsets_[i];
+                 e < neighborhoods.offsets_[i + 1]; e++) {
+                int j = neighborhoods.indices_[e];
+                edges[e] = Eigen::Vector2i(i, j);
+                float weight =
+                        float(1.0 - std::abs(normals_[i].dot(normals_[j])));
+                weights[e] =
+                        std::isnan(weight) ? 1.0f : std::max(weight, 0.0f);
+            }
+        }
+    }
+    std::vector<size_t> forest;
+    if (!ComputeMinimumSpanningForest(n, edges, weights, forest)) {
+        return false;
+    }
+    std::vector<float>().swap(weights);
+
+    // adjacency of the spanning forest
+    std::vector<size_t> offsets(n + 1, 0);
+    for (size_t e : forest) {
+        offsets[edges[e](0) + 1]++;
+        offsets[edges[e](1) + 1]++;
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<int> adjacency(offsets[n]);
+    {
+        std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t e : forest) {
+            adjacency[fill[edges[e](0)]++] = edges[e](1);
+            adjacency[fill[edges[e](1)]++] = edges[e](0);
+        }
+    }
+    std::vector<Eigen::Vector2i>().swap(edges);
+
+    // Every tree is traversed from its highest point, whose normal is made to
+    // point upwards, and each normal is flipped to agree with its parent.
+    std::vector<int> tree(n, -1);
+    std::vector<int> roots;
+    std::queue<int> queue;
+    auto traverse = [&](int root, int label, bool orient) {
+        tree[root] = label;
+        queue.push(root);
+        while (!queue.empty()) {
+            int i = queue.front();
+            queue.pop();
+            for (size_t e = offsets[i]; e < offsets[i + 1]; e++) {
+                int j = adjacency[e];
+                if (tree[j] == label) {
+                    continue;
+                }
+                if (orient && normals_[i].dot(normals_[j]) < 0.0) {
+                    normals_[j] *= -1.0;
+                }
+                tree[j] = label;
+                queue.push(j);
+                if (!orient && points_[j](2) > points_[roots[label]](2)) {
+                    roots[label] = j;
+                }
+            }
+        }
+    };
+    for (int i = 0; i < n; i++) {
+        if (tree[i] == -1) {
+            roots.push_back(i);
+            traverse(i, int(roots.size()) - 1, false);
+        }
+    }
+    for (size_t t = 0; t < roots.size(); t++) {
+        int root = roots[t];
+        if (normals_[root](2) < 0.0) {
+            normals_[root] *= -1.0;
+        }
+        // labels of the second pass are shifted to tell them apart
+        traverse(root, int(roots.size() + t), true);
+    }
+    return true;
+}
 }  // namespace geometry
 }  // namespace open3d
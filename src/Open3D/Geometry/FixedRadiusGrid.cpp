@@ -0,0 +1,145 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Geometry/FixedRadiusGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Open3D/Utility/Console.h"
+
+namespace open3d {
+namespace geometry {
+
+FixedRadiusGrid::FixedRadiusGrid(const std::vector<Eigen::Vector3d> &points,
+                                 double radius) {
+    SetPoints(points, radius);
+}
+
+bool FixedRadiusGrid::SetPoints(const std::vector<Eigen::Vector3d> &points,
+                                double radius) {
+    cell_keys_.clear();
+    cell_begin_.assign(1, 0);
+    sorted_points_.clear();
+    indices_.clear();
+    radius2_ = 0.0;
+    if (radius <= 0.0) {
+        utility::LogWarning(
+                "[FixedRadiusGrid::SetPoints] radius must be positive.\n");
+        return false;
+    }
+    if (points.empty()) {
+        return true;
+    }
+
+    min_bound_ = points[0];
+    Eigen::Vector3d max_bound = points[0];
+    for (const auto &point : points) {
+        min_bound_ = min_bound_.array().min(point.array()).matrix();
+        max_bound = max_bound.array().max(point.array()).matrix();
+    }
+    cell_size_ = radius;
+    double num_cells = 1.0;
+    for (int d = 0; d < 3; d++) {
+        resolution_(d) = int64_t(
+                std::floor((max_bound(d) - min_bound_(d)) / cell_size_)) + 1;
+        num_cells *= double(resolution_(d));
+    }
+    if (num_cells >= double(std::numeric_limits<int64_t>::max() / 2)) {
+        utility::LogWarning(
+                "[FixedRadiusGrid::SetPoints] radius {:f} is too small for "
+                "the extent of the points.\n",
+                radius);
+        return false;
+    }
+
+    int n = int(points.size());
+    std::vector<std::pair<int64_t, int>> keys(n);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < n; i++) {
+        int64_t key = 0;
+        for (int d = 0; d < 3; d++) {
+            int64_t c = int64_t(
+                    std::floor((points[i](d) - min_bound_(d)) / cell_size_));
+            c = std::min(std::max(c, int64_t(0)), resolution_(d) - 1);
+            key = key * resolution_(d) + c;
+        }
+        keys[i] = std::make_pair(key, i);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    sorted_points_.resize(n);
+    indices_.resize(n);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int s = 0; s < n; s++) {
+        indices_[s] = keys[s].second;
+        sorted_points_[s] = points[keys[s].second];
+    }
+    cell_begin_.clear();
+    for (int s = 0; s < n; s++) {
+        if (s == 0 || keys[s].first != keys[s - 1].first) {
+            cell_keys_.push_back(keys[s].first);
+            cell_begin_.push_back(s);
+        }
+    }
+    cell_begin_.push_back(n);
+    // Same threshold as the float radius passed to flann by KDTreeFlann.
+    radius2_ = double(float(radius * radius));
+    return true;
+}
+
+int FixedRadiusGrid::GetNeighborRanges(int cell, int64_t ranges[9][2]) const {
+    int64_t key = cell_keys_[cell];
+    int64_t z = key % resolution_(2);
+    int64_t y = (key / resolution_(2)) % resolution_(1);
+    int64_t x = key / (resolution_(2) * resolution_(1));
+    int64_t z0 = std::max(z - 1, int64_t(0));
+    int64_t z1 = std::min(z + 1, resolution_(2) - 1);
+    int n_ranges = 0;
+    for (int64_t nx = x - 1; nx <= x + 1; nx++) {
+        if (nx < 0 || nx >= resolution_(0)) continue;
+        for (int64_t ny = y - 1; ny <= y + 1; ny++) {
+            if (ny < 0 || ny >= resolution_(1)) continue;
+            int64_t column = (nx * resolution_(1) + ny) * resolution_(2);
+            auto begin = std::lower_bound(cell_keys_.begin(),
+                                          cell_keys_.end(), column + z0);
+            auto end = std::upper_bound(begin, cell_keys_.end(), column + z1);
+            if (begin == end) continue;
+            ranges[n_ranges][0] = cell_begin_[begin - cell_keys_.begin()];
+            ranges[n_ranges][1] = cell_begin_[end - cell_keys_.begin()];
+            n_ranges++;
+        }
+    }
+    return n_ranges;
+}
+
+}  // namespace geometry
+}  // namespace open3d
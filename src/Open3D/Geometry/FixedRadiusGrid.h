@@ -0,0 +1,126 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace open3d {
+namespace geometry {
+
+/// \class FixedRadiusGrid
+///
+/// Uniform grid whose cell size equals a fixed search radius. Points are
+/// sorted by cell and stored contiguously, so that all neighbours of a point
+/// within the radius are found by scanning the 3x3x3 block of cells around
+/// it. Meant for algorithms that query every point of a cloud with the same
+/// radius, where it avoids the per-query allocations of
+/// KDTreeFlann::SearchRadius and never stores the neighbourhoods.
+///
+/// A pair of points is reported when its squared distance is smaller than
+/// float(radius * radius), the same criterion as KDTreeFlann::SearchRadius.
+class FixedRadiusGrid {
+public:
+    FixedRadiusGrid() {}
+    FixedRadiusGrid(const std::vector<Eigen::Vector3d> &points, double radius);
+    ~FixedRadiusGrid() {}
+    FixedRadiusGrid(const FixedRadiusGrid &) = delete;
+    FixedRadiusGrid &operator=(const FixedRadiusGrid &) = delete;
+
+public:
+    /// Builds the grid. Returns false, and leaves an index that reports no
+    /// neighbours, if the radius is not positive or the points span too many
+    /// cells.
+    bool SetPoints(const std::vector<Eigen::Vector3d> &points, double radius);
+
+    int NumCells() const { return int(cell_keys_.size()); }
+
+    /// Calls func(i, j, distance2) for every point i of \p cell with
+    /// is_query(i) and every point j within the radius of i, i included.
+    template <typename Pred, typename Func>
+    void ForEachNeighborInCell(int cell,
+                               const Pred &is_query,
+                               const Func &func) const {
+        int64_t ranges[9][2];
+        int n_ranges = GetNeighborRanges(cell, ranges);
+        for (int64_t s = cell_begin_[cell]; s < cell_begin_[cell + 1]; s++) {
+            int i = indices_[s];
+            if (!is_query(i)) continue;
+            const Eigen::Vector3d &p = sorted_points_[s];
+            for (int r = 0; r < n_ranges; r++) {
+                for (int64_t t = ranges[r][0]; t < ranges[r][1]; t++) {
+                    const Eigen::Vector3d &q = sorted_points_[t];
+                    double dx = p(0) - q(0);
+                    double dy = p(1) - q(1);
+                    double dz = p(2) - q(2);
+                    double distance2 = dx * dx + dy * dy + dz * dz;
+                    if (distance2 < radius2_) {
+                        func(i, indices_[t], distance2);
+                    }
+                }
+            }
+        }
+    }
+
+    /// Parallel loop of ForEachNeighborInCell over all cells. All calls for
+    /// a given point i are made by the same thread.
+    template <typename Pred, typename Func>
+    void ForEachNeighbor(const Pred &is_query, const Func &func) const {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+        for (int cell = 0; cell < NumCells(); cell++) {
+            ForEachNeighborInCell(cell, is_query, func);
+        }
+    }
+
+private:
+    /// Writes the ranges of sorted_points_ covered by the 3x3x3 block of
+    /// cells around \p cell and returns their number. Cells are sorted by
+    /// (x, y, z), so the three cells along z of every (x, y) column are
+    /// contiguous.
+    int GetNeighborRanges(int cell, int64_t ranges[9][2]) const;
+
+protected:
+    double radius2_ = 0.0;
+    Eigen::Vector3d min_bound_ = Eigen::Vector3d::Zero();
+    double cell_size_ = 0.0;
+    Eigen::Matrix<int64_t, 3, 1> resolution_ =
+            Eigen::Matrix<int64_t, 3, 1>::Zero();
+    /// Linear cell keys in increasing order, one per non-empty cell.
+    std::vector<int64_t> cell_keys_;
+    /// Points of cell c are sorted_points_[cell_begin_[c]:cell_begin_[c+1]].
+    std::vector<int64_t> cell_begin_;
+    std::vector<Eigen::Vector3d> sorted_points_;
+    /// Index in the input points of each entry of sorted_points_.
+    std::vector<int> indices_;
+};
+
+}  // namespace geometry
+}  // namespace open3d
@@ -26,6 +26,9 @@
 
 #include "Open3D/Geometry/Image.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace {
 /// Isotropic 2D kernels are separable:
 /// two 1D kernels are applied in x and y direction.
@@ -261,6 +264,82 @@ std::shared_ptr<Image> Image::Filter(const std::vector<double> &dx,
     return temp4;
 }
 
+std::shared_ptr<Image> Image::FilterBilateral(
+        int half_kernel_size /* = 2 */,
+        double sigma_space /* = 1.5 */,
+        double sigma_value /* = 0.03 */) const {
+    auto output = std::make_shared<Image>();
+    if (num_of_channels_ != 1 || bytes_per_channel_ != 4) {
+        utility::LogWarning("[FilterBilateral] Unsupported image format.\n");
+        return output;
+    }
+    if (half_kernel_size < 0 || !(sigma_space > 0.0) ||
+        !(sigma_value > 0.0)) {
+        utility::LogWarning("[FilterBilateral] Invalid parameters.\n");
+        return output;
+    }
+    output->Prepare(width_, height_, 1, 4);
+
+    const int kernel_size = 2 * half_kernel_size + 1;
+    std::vector<float> space_weights(kernel_size * kernel_size);
+    for (int yy = -half_kernel_size; yy <= half_kernel_size; yy++) {
+        for (int xx = -half_kernel_size; xx <= half_kernel_size; xx++) {
+            space_weights[(yy + half_kernel_size) * kernel_size + xx +
+                          half_kernel_size] =
+                    float(std::exp(-(xx * xx + yy * yy) /
+                                   (2.0 * sigma_space * sigma_space)));
+        }
+    }
+    // The value weights are tabulated up to three standard deviations.
+    const int num_bins = 256;
+    const float bins_per_value = float(num_bins / (3.0 * sigma_value));
+    std::vector<float> value_weights(num_bins);
+    for (int i = 0; i < num_bins; i++) {
+        double r = (i + 0.5) / bins_per_value;
+        value_weights[i] =
+                float(std::exp(-r * r / (2.0 * sigma_value * sigma_value)));
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int y = 0; y < height_; y++) {
+        const float *pi = PointerAt<float>(0, y);
+        float *po = output->PointerAt<float>(0, y);
+        const int y0 = std::max(y - half_kernel_size, 0);
+        const int y1 = std::min(y + half_kernel_size, height_ - 1);
+        for (int x = 0; x < width_; x++) {
+            const float center = pi[x];
+            if (!(center > 0.0f)) {
+                po[x] = 0.0f;
+                continue;
+            }
+            const int x0 = std::max(x - half_kernel_size, 0);
+            const int x1 = std::min(x + half_kernel_size, width_ - 1);
+            float sum = 0.0f;
+            float sum_weights = 0.0f;
+            for (int yy = y0; yy <= y1; yy++) {
+                const float *pn = PointerAt<float>(0, yy);
+                const float *ws =
+                        space_weights.data() +
+                        (yy - y + half_kernel_size) * kernel_size -
+                        (x - half_kernel_size);
+                for (int xx = x0; xx <= x1; xx++) {
+                    const float value = pn[xx];
+                    const float bin = std::abs(value - center) * bins_per_value;
+                    if (value > 0.0f && bin < float(num_bins)) {
+                        const float w = ws[xx] * value_weights[int(bin)];
+                        sum += w * value;
+                        sum_weights += w;
+                    }
+                }
+            }
+            po[x] = sum / sum_weights;
+        }
+    }
+    return output;
+}
+
 std::shared_ptr<Image> Image::Flip() const {
     auto output = std::make_shared<Image>();
     if (num_of_channels_ != 1 || bytes_per_channel_ != 4) {
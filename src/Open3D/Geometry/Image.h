@@ -140,6 +140,16 @@ public:
     std::shared_ptr<Image> FilterHorizontal(
             const std::vector<double> &kernel) const;
 
+    /// Function to filter a float image with an edge preserving bilateral
+    /// filter. The weight of a neighbour falls off with its distance in
+    /// pixels (\p sigma_space) and with its difference to the center value
+    /// (\p sigma_value), and neighbours that differ by more than three
+    /// \p sigma_value are ignored. Values that are not positive, e.g. missing
+    /// depth, are neither used nor filtered.
+    std::shared_ptr<Image> FilterBilateral(int half_kernel_size = 2,
+                                           double sigma_space = 1.5,
+                                           double sigma_value = 0.03) const;
+
     /// Function to 2x image downsample using simple 2x2 averaging
     std::shared_ptr<Image> Downsample() const;
 
@@ -205,5 +205,73 @@ double IntersectionTest::LineSegmentsMinimumDistance(
     return dist;
 }
 
+Eigen::Vector3d IntersectionTest::PointTriangleClosestPoint(
+        const Eigen::Vector3d& q,
+        const Eigen::Vector3d& p0,
+        const Eigen::Vector3d& p1,
+        const Eigen::Vector3d& p2) {
+    const Eigen::Vector3d p10 = p1 - p0;
+    const Eigen::Vector3d p20 = p2 - p0;
+
+    // q in vertex region outside p0
+    const Eigen::Vector3d q0 = q - p0;
+    double d1 = p10.dot(q0);
+    double d2 = p20.dot(q0);
+    if (d1 <= 0 && d2 <= 0) {
+        return p0;
+    }
+
+    // q in vertex region outside p1
+    const Eigen::Vector3d q1 = q - p1;
+    double d3 = p10.dot(q1);
+    double d4 = p20.dot(q1);
+    if (d3 >= 0 && d4 <= d3) {
+        return p1;
+    }
+
+    // q in edge region of p0 p1
+    double vc = d1 * d4 - d3 * d2;
+    if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+        double v = d1 / (d1 - d3);
+        return p0 + v * p10;
+    }
+
+    // q in vertex region outside p2
+    const Eigen::Vector3d q2 = q - p2;
+    double d5 = p10.dot(q2);
+    double d6 = p20.dot(q2);
+    if (d6 >= 0 && d5 <= d6) {
+        return p2;
+    }
+
+    // q in edge region of p0 p2
+    double vb = d5 * d2 - d1 * d6;
+    if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+        double w = d2 / (d2 - d6);
+        return p0 + w * p20;
+    }
+
+    // q in edge region of p1 p2
+    double va = d3 * d6 - d5 * d4;
+    if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0) {
+        double w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+        return p1 + w * (p2 - p1);
+    }
+
+    // q inside face region
+    double denom = 1.0 / (va + vb + vc);
+    double v = vb * denom;
+    double w = vc * denom;
+    return p0 + v * p10 + w * p20;
+}
+
+double IntersectionTest::PointTriangleMinimumDistance(
+        const Eigen::Vector3d& q,
+        const Eigen::Vector3d& p0,
+        const Eigen::Vector3d& p1,
+        const Eigen::Vector3d& p2) {
+    return (q - PointTriangleClosestPoint(q, p0, p1, p2)).norm();
+}
+
 }  // namespace geometry
 }  // namespace open3d
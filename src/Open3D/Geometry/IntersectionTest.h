@@ -77,6 +77,22 @@ public:
                                               const Eigen::Vector3d& p1,
                                               const Eigen::Vector3d& q0,
                                               const Eigen::Vector3d& q1);
+
+    /// Computes the point of the triangle \param p0, \param p1, \param p2
+    /// that is closest to the 3D point \param q. This implementation is based
+    /// on the description of Christer Ericson, "Real-Time Collision
+    /// Detection", Section 5.1.5.
+    static Eigen::Vector3d PointTriangleClosestPoint(const Eigen::Vector3d& q,
+                                                     const Eigen::Vector3d& p0,
+                                                     const Eigen::Vector3d& p1,
+                                                     const Eigen::Vector3d& p2);
+
+    /// Computes the minimum distance between the 3D point \param q and the
+    /// triangle \param p0, \param p1, \param p2.
+    static double PointTriangleMinimumDistance(const Eigen::Vector3d& q,
+                                               const Eigen::Vector3d& p0,
+                                               const Eigen::Vector3d& p1,
+                                               const Eigen::Vector3d& p2);
 };
 
 }  // namespace geometry
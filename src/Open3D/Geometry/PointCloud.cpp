@@ -126,18 +126,23 @@ std::vector<double> PointCloud::ComputePointCloudDistance(
     KDTreeFlann kdtree;
     kdtree.SetGeometry(target);
 #ifdef _OPENMP
-#pragma omp parallel for schedule(static)
+#pragma omp parallel
 #endif
-    for (int i = 0; i < (int)points_.size(); i++) {
+    {
         std::vector<int> indices(1);
         std::vector<double> dists(1);
-        if (kdtree.SearchKNN(points_[i], 1, indices, dists) == 0) {
-            utility::LogDebug(
-                    "[ComputePointCloudToPointCloudDistance] Found a point "
-                    "without neighbors.\n");
-            distances[i] = 0.0;
-        } else {
-            distances[i] = std::sqrt(dists[0]);
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (int i = 0; i < (int)points_.size(); i++) {
+            if (kdtree.SearchKNN(points_[i], 1, indices, dists) == 0) {
+                utility::LogDebug(
+                        "[ComputePointCloudToPointCloudDistance] Found a point "
+                        "without neighbors.\n");
+                distances[i] = 0.0;
+            } else {
+                distances[i] = std::sqrt(dists[0]);
+            }
         }
     }
     return distances;
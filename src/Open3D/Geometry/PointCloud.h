@@ -43,6 +43,7 @@ class PinholeCameraIntrinsic;
 namespace geometry {
 
 class Image;
+class PointCloudNeighborhoods;
 class RGBDImage;
 class TriangleMesh;
 class VoxelGrid;
@@ -106,6 +107,14 @@ public:
     std::shared_ptr<PointCloud> SelectDownSample(
             const std::vector<size_t> &indices, bool invert = false) const;
 
+    /// Function to select points from \param input pointcloud into
+    /// \return output pointcloud
+    /// Points with a true entry in \param mask are selected, or those with a
+    /// false entry if \param invert is true. The size of the mask must match
+    /// the number of points.
+    std::shared_ptr<PointCloud> SelectDownSampleByMask(
+            const std::vector<bool> &mask, bool invert = false) const;
+
     /// Function to downsample \param input pointcloud into output pointcloud
     /// with a voxel \param voxel_size defines the resolution of the voxel grid,
     /// smaller value leads to denser output point cloud. Normals and colors are
@@ -140,6 +149,19 @@ public:
     std::tuple<std::shared_ptr<PointCloud>, std::vector<size_t>>
     RemoveStatisticalOutliers(size_t nb_neighbors, double std_ratio) const;
 
+    /// Function to compute the inliers of RemoveRadiusOutliers. Returns a
+    /// mask that is true for the points with more than \param nb_points
+    /// points in a sphere of radius \param search_radius, or an empty mask
+    /// for illegal parameters.
+    std::vector<bool> ComputeRadiusInlierMask(size_t nb_points,
+                                              double search_radius) const;
+
+    /// Function to compute the inliers of RemoveStatisticalOutliers. Returns
+    /// a mask that is true for the points that are kept, or an empty mask for
+    /// illegal parameters.
+    std::vector<bool> ComputeStatisticalInlierMask(size_t nb_neighbors,
+                                                   double std_ratio) const;
+
     /// Function to compute the normals of a point cloud
     /// \param cloud is the input point cloud. It also stores the output
     /// normals. Normals are oriented with respect to the input point cloud if
@@ -149,6 +171,20 @@ public:
             const KDTreeSearchParam &search_param = KDTreeSearchParamKNN(),
             bool fast_normal_computation = true);
 
+    /// Function to compute the normals of a point cloud from the precomputed
+    /// \param neighborhoods of its points, see EstimateNormals above.
+    bool EstimateNormals(const PointCloudNeighborhoods &neighborhoods,
+                         bool fast_normal_computation = true);
+
+    /// Function to compute the normals of a point cloud from the precomputed
+    /// \param neighborhoods of its points. \param curvatures receives the
+    /// surface variation lambda_0 / (lambda_0 + lambda_1 + lambda_2) of the
+    /// covariance of each neighborhood, 0 for points with less than 3
+    /// neighbors.
+    bool EstimateNormals(const PointCloudNeighborhoods &neighborhoods,
+                         std::vector<double> &curvatures,
+                         bool fast_normal_computation = true);
+
     /// Function to orient the normals of a point cloud
     /// \param cloud is the input point cloud. It must have normals.
     /// Normals are oriented with respect to \param orientation_reference
@@ -162,11 +198,21 @@ public:
     bool OrientNormalsTowardsCameraLocation(
             const Eigen::Vector3d &camera_location = Eigen::Vector3d::Zero());
 
+    /// Function to consistently orient the normals of a point cloud based on
+    /// tangent plane propagation, as in Hoppe et al., "Surface Reconstruction
+    /// from Unorganized Points", 1992. Every point is connected to its
+    /// \param k nearest neighbors, with weight 1 - |n_i . n_j|. Orientation
+    /// is propagated along the minimum spanning tree of this graph, starting
+    /// at the highest point of every connected part, whose normal is made to
+    /// point upwards. The point cloud must have normals.
+    bool OrientNormalsConsistentTangentPlane(size_t k);
+
     /// Function to compute the point to point distances between point clouds
     /// \param source is the first point cloud.
     /// \param target is the second point cloud.
     /// \return the output distance. It has the same size as the number
-    /// of points in \param source
+    /// of points in \param source. See DistanceMetrics for symmetric metrics
+    /// against a reusable reference.
     std::vector<double> ComputePointCloudDistance(const PointCloud &target);
 
     /// Function to compute the mean and covariance matrix
@@ -201,7 +247,8 @@ public:
     /// In the latter case, the depth is scaled by 1 / depth_scale, and
     /// truncated at depth_trunc distance. The depth image is also sampled with
     /// stride, in order to support (fast) coarse point cloud extraction. Return
-    /// an empty pointcloud if the conversion fails.
+    /// an empty pointcloud if the conversion fails. Use DepthBackProjector to
+    /// reuse the output storage across frames.
     static std::shared_ptr<PointCloud> CreateFromDepthImage(
             const Image &depth,
             const camera::PinholeCameraIntrinsic &intrinsic,
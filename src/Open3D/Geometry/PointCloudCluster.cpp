@@ -26,95 +26,248 @@
 
 #include "Open3D/Geometry/PointCloud.h"
 
-#include <Eigen/Dense>
-#include <unordered_set>
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
 
+#include "Open3D/Geometry/FixedRadiusGrid.h"
 #include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Utility/Console.h"
 
+namespace open3d {
+
+namespace {
+
+/// Lock-free union-find. Roots are always linked below the smaller index, so
+/// the root of a set is its smallest element and parent_[x] <= x holds at any
+/// time, which keeps the concurrent path halving in Find() safe.
+class ConcurrentUnionFind {
+public:
+    ConcurrentUnionFind(int size) : parent_(size) {
 #ifdef _OPENMP
-#include <omp.h>
+#pragma omp parallel for schedule(static)
 #endif
+        for (int i = 0; i < size; i++) {
+            parent_[i].store(i);
+        }
+    }
 
-namespace open3d {
-namespace geometry {
+    int Find(int x) {
+        while (true) {
+            int p = parent_[x].load();
+            if (p == x) return x;
+            int gp = parent_[p].load();
+            if (gp != p) {
+                parent_[x].compare_exchange_weak(p, gp);
+            }
+            x = gp;
+        }
+    }
 
-std::vector<int> PointCloud::ClusterDBSCAN(double eps,
-                                           size_t min_points,
-                                           bool print_progress) const {
-    KDTreeFlann kdtree(*this);
+    void Union(int a, int b) {
+        while (true) {
+            a = Find(a);
+            b = Find(b);
+            if (a == b) return;
+            if (a < b) std::swap(a, b);
+            int expected = a;
+            if (parent_[a].compare_exchange_strong(expected, b)) return;
+        }
+    }
 
-    // precompute all neighbours
-    utility::LogDebug("Precompute Neighbours\n");
-    utility::ConsoleProgressBar progress_bar(
-            points_.size(), "Precompute Neighbours", print_progress);
-    std::vector<std::vector<int>> nbs(points_.size());
+private:
+    std::vector<std::atomic<int>> parent_;
+};
+
+/// Neighbour search over the cells of a geometry::FixedRadiusGrid, one task
+/// per cell.
+class GridNeighbors {
+public:
+    explicit GridNeighbors(const geometry::FixedRadiusGrid &grid)
+        : grid_(grid) {}
+
+    int NumTasks() const { return grid_.NumCells(); }
+
+    template <typename Pred, typename Func>
+    void ForEachNeighborInTask(int task,
+                               const Pred &is_query,
+                               const Func &func) const {
+        grid_.ForEachNeighborInCell(task, is_query, func);
+    }
+
+private:
+    const geometry::FixedRadiusGrid &grid_;
+};
+
+/// Neighbourhoods precomputed with a KDTreeFlann, for radii that are too
+/// small for a grid over the extent of the points. One task per block of
+/// points.
+class KDTreeNeighbors {
+public:
+    KDTreeNeighbors(const geometry::PointCloud &pointcloud, double radius)
+        : indices_(pointcloud.points_.size()),
+          distances2_(pointcloud.points_.size()) {
+        geometry::KDTreeFlann kdtree(pointcloud);
+        int n = int(pointcloud.points_.size());
 #ifdef _OPENMP
 #pragma omp parallel for schedule(static)
 #endif
-    for (int idx = 0; idx < int(points_.size()); ++idx) {
-        std::vector<double> dists2;
-        kdtree.SearchRadius(points_[idx], eps, nbs[idx], dists2);
+        for (int i = 0; i < n; i++) {
+            kdtree.SearchRadius(pointcloud.points_[i], radius, indices_[i],
+                                distances2_[i]);
+        }
+    }
+
+    int NumTasks() const {
+        return int((indices_.size() + kBlockSize - 1) / kBlockSize);
+    }
 
+    template <typename Pred, typename Func>
+    void ForEachNeighborInTask(int task,
+                               const Pred &is_query,
+                               const Func &func) const {
+        int end = std::min(int(indices_.size()), (task + 1) * kBlockSize);
+        for (int i = task * kBlockSize; i < end; i++) {
+            if (!is_query(i)) continue;
+            for (size_t k = 0; k < indices_[i].size(); k++) {
+                func(i, indices_[i][k], distances2_[i][k]);
+            }
+        }
+    }
+
+private:
+    static const int kBlockSize = 256;
+    std::vector<std::vector<int>> indices_;
+    std::vector<std::vector<double>> distances2_;
+};
+
+/// Labels the points with the neighbours of \p neighbors, see
+/// PointCloud::ClusterDBSCAN.
+template <typename Neighbors>
+std::vector<int> ComputeDBSCANLabels(int n,
+                                     const Neighbors &neighbors,
+                                     size_t min_points,
+                                     bool print_progress) {
+    // Neighbourhoods are never stored: the tasks are scanned once to find
+    // the core points, once to join neighbouring core points and once to
+    // attach border points. Each scan is parallel over tasks.
+    int num_tasks = neighbors.NumTasks();
+    utility::ConsoleProgressBar progress_bar(size_t(num_tasks) * 3,
+                                             "Clustering", print_progress);
+
+    // count neighbours and mark core points
+    utility::LogDebug("Precompute Neighbours\n");
+    std::vector<int> num_neighbors(n, 0);
+    auto all_points = [](int) { return true; };
+    auto count_neighbor = [&](int i, int, double) { num_neighbors[i]++; };
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+    for (int task = 0; task < num_tasks; task++) {
+        neighbors.ForEachNeighborInTask(task, all_points, count_neighbor);
+        if (print_progress) {
 #ifdef _OPENMP
 #pragma omp critical
 #endif
-        { ++progress_bar; }
+            { ++progress_bar; }
+        }
+    }
+    std::vector<char> is_core(n);
+    for (int i = 0; i < n; i++) {
+        is_core[i] = size_t(num_neighbors[i]) >= min_points;
     }
     utility::LogDebug("Done Precompute Neighbours\n");
 
-    // set all labels to undefined (-2)
+    // connect core points within eps of each other
     utility::LogDebug("Compute Clusters\n");
-    progress_bar.reset(points_.size(), "Clustering", print_progress);
-    std::vector<int> labels(points_.size(), -2);
-    int cluster_label = 0;
-    for (size_t idx = 0; idx < points_.size(); ++idx) {
-        if (labels[idx] != -2) {  // label is not undefined
-            continue;
+    ConcurrentUnionFind components(n);
+    auto core_points = [&](int i) { return is_core[i] != 0; };
+    auto join_core = [&](int i, int j, double) {
+        if (j < i && is_core[j]) {
+            components.Union(i, j);
         }
-
-        // check density
-        if (nbs[idx].size() < min_points) {
-            labels[idx] = -1;
-            continue;
+    };
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+    for (int task = 0; task < num_tasks; task++) {
+        neighbors.ForEachNeighborInTask(task, core_points, join_core);
+        if (print_progress) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            { ++progress_bar; }
         }
+    }
 
-        std::unordered_set<int> nbs_next(nbs[idx].begin(), nbs[idx].end());
-        std::unordered_set<int> nbs_visited;
-        nbs_visited.insert(int(idx));
-
-        labels[idx] = cluster_label;
-        ++progress_bar;
-        while (!nbs_next.empty()) {
-            int nb = *nbs_next.begin();
-            nbs_next.erase(nbs_next.begin());
-            nbs_visited.insert(nb);
-
-            if (labels[nb] == -1) {  // noise label
-                labels[nb] = cluster_label;
-                ++progress_bar;
-            }
-            if (labels[nb] != -2) {  // not undefined label
-                continue;
-            }
-            labels[nb] = cluster_label;
-            ++progress_bar;
-
-            if (nbs[nb].size() >= min_points) {
-                for (int qnb : nbs[nb]) {
-                    if (nbs_visited.count(qnb) == 0) {
-                        nbs_next.insert(qnb);
-                    }
-                }
-            }
+    // Number the clusters by their smallest core point, which is the order
+    // in which the sequential algorithm discovers them.
+    std::vector<int> labels(n, -1);
+    int cluster_label = 0;
+    for (int i = 0; i < n; i++) {
+        if (is_core[i] && components.Find(i) == i) {
+            labels[i] = cluster_label++;
+        }
+    }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < n; i++) {
+        int root = is_core[i] ? components.Find(i) : i;
+        if (root != i) {
+            labels[i] = labels[root];
         }
+    }
 
-        cluster_label++;
+    // A border point joins the first cluster that reaches it, the one with
+    // the smallest label among its core neighbours. Other points are noise.
+    auto border_points = [&](int i) { return is_core[i] == 0; };
+    auto attach_border = [&](int i, int j, double) {
+        if (is_core[j] && (labels[i] == -1 || labels[j] < labels[i])) {
+            labels[i] = labels[j];
+        }
+    };
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+    for (int task = 0; task < num_tasks; task++) {
+        neighbors.ForEachNeighborInTask(task, border_points, attach_border);
+        if (print_progress) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            { ++progress_bar; }
+        }
     }
 
     utility::LogDebug("Done Compute Clusters: {:d}\n", cluster_label);
     return labels;
 }
 
+}  // unnamed namespace
+
+namespace geometry {
+
+std::vector<int> PointCloud::ClusterDBSCAN(double eps,
+                                           size_t min_points,
+                                           bool print_progress) const {
+    int n = int(points_.size());
+    if (eps <= 0.0) {
+        utility::LogWarning(
+                "[ClusterDBSCAN] eps must be positive, all points are "
+                "noise.\n");
+        return std::vector<int>(n, -1);
+    }
+    FixedRadiusGrid grid;
+    if (grid.SetPoints(points_, eps)) {
+        return ComputeDBSCANLabels(n, GridNeighbors(grid), min_points,
+                                   print_progress);
+    }
+    // eps is too small for a grid over the extent of the points.
+    return ComputeDBSCANLabels(n, KDTreeNeighbors(*this, eps), min_points,
+                               print_progress);
+}
+
 }  // namespace geometry
 }  // namespace open3d
@@ -27,6 +27,7 @@
 #include <Eigen/Dense>
 
 #include "Open3D/Camera/PinholeCameraIntrinsic.h"
+#include "Open3D/Geometry/DepthBackProjector.h"
 #include "Open3D/Geometry/Image.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Geometry/RGBDImage.h"
@@ -35,88 +36,6 @@
 
 namespace open3d {
 
-namespace {
-using namespace geometry;
-
-int CountValidDepthPixels(const Image &depth, int stride) {
-    int num_valid_pixels = 0;
-    for (int i = 0; i < depth.height_; i += stride) {
-        for (int j = 0; j < depth.width_; j += stride) {
-            const float *p = depth.PointerAt<float>(j, i);
-            if (*p > 0) num_valid_pixels += 1;
-        }
-    }
-    return num_valid_pixels;
-}
-
-std::shared_ptr<PointCloud> CreatePointCloudFromFloatDepthImage(
-        const Image &depth,
-        const camera::PinholeCameraIntrinsic &intrinsic,
-        const Eigen::Matrix4d &extrinsic,
-        int stride) {
-    auto pointcloud = std::make_shared<PointCloud>();
-    Eigen::Matrix4d camera_pose = extrinsic.inverse();
-    auto focal_length = intrinsic.GetFocalLength();
-    auto principal_point = intrinsic.GetPrincipalPoint();
-    int num_valid_pixels = CountValidDepthPixels(depth, stride);
-    pointcloud->points_.resize(num_valid_pixels);
-    int cnt = 0;
-    for (int i = 0; i < depth.height_; i += stride) {
-        for (int j = 0; j < depth.width_; j += stride) {
-            const float *p = depth.PointerAt<float>(j, i);
-            if (*p > 0) {
-                double z = (double)(*p);
-                double x = (j - principal_point.first) * z / focal_length.first;
-                double y =
-                        (i - principal_point.second) * z / focal_length.second;
-                Eigen::Vector4d point =
-                        camera_pose * Eigen::Vector4d(x, y, z, 1.0);
-                pointcloud->points_[cnt++] = point.block<3, 1>(0, 0);
-            }
-        }
-    }
-    return pointcloud;
-}
-
-template <typename TC, int NC>
-std::shared_ptr<PointCloud> CreatePointCloudFromRGBDImageT(
-        const RGBDImage &image,
-        const camera::PinholeCameraIntrinsic &intrinsic,
-        const Eigen::Matrix4d &extrinsic) {
-    auto pointcloud = std::make_shared<PointCloud>();
-    Eigen::Matrix4d camera_pose = extrinsic.inverse();
-    auto focal_length = intrinsic.GetFocalLength();
-    auto principal_point = intrinsic.GetPrincipalPoint();
-    double scale = (sizeof(TC) == 1) ? 255.0 : 1.0;
-    int num_valid_pixels = CountValidDepthPixels(image.depth_, 1);
-    pointcloud->points_.resize(num_valid_pixels);
-    pointcloud->colors_.resize(num_valid_pixels);
-    int cnt = 0;
-    for (int i = 0; i < image.depth_.height_; i++) {
-        float *p = (float *)(image.depth_.data_.data() +
-                             i * image.depth_.BytesPerLine());
-        TC *pc = (TC *)(image.color_.data_.data() +
-                        i * image.color_.BytesPerLine());
-        for (int j = 0; j < image.depth_.width_; j++, p++, pc += NC) {
-            if (*p > 0) {
-                double z = (double)(*p);
-                double x = (j - principal_point.first) * z / focal_length.first;
-                double y =
-                        (i - principal_point.second) * z / focal_length.second;
-                Eigen::Vector4d point =
-                        camera_pose * Eigen::Vector4d(x, y, z, 1.0);
-                pointcloud->points_[cnt] = point.block<3, 1>(0, 0);
-                pointcloud->colors_[cnt++] =
-                        Eigen::Vector3d(pc[0], pc[(NC - 1) / 2], pc[NC - 1]) /
-                        scale;
-            }
-        }
-    }
-    return pointcloud;
-}
-
-}  // unnamed namespace
-
 namespace geometry {
 std::shared_ptr<PointCloud> PointCloud::CreateFromDepthImage(
         const Image &depth,
@@ -125,41 +44,21 @@ std::shared_ptr<PointCloud> PointCloud::CreateFromDepthImage(
         double depth_scale /* = 1000.0*/,
         double depth_trunc /* = 1000.0*/,
         int stride /* = 1*/) {
-    if (depth.num_of_channels_ == 1) {
-        if (depth.bytes_per_channel_ == 2) {
-            auto float_depth =
-                    depth.ConvertDepthToFloatImage(depth_scale, depth_trunc);
-            return CreatePointCloudFromFloatDepthImage(*float_depth, intrinsic,
-                                                       extrinsic, stride);
-        } else if (depth.bytes_per_channel_ == 4) {
-            return CreatePointCloudFromFloatDepthImage(depth, intrinsic,
-                                                       extrinsic, stride);
-        }
-    }
-    utility::LogWarning(
-            "[CreatePointCloudFromDepthImage] Unsupported image format.\n");
-    return std::make_shared<PointCloud>();
+    auto pointcloud = std::make_shared<PointCloud>();
+    DepthBackProjector().CreateFromDepthImage(depth, intrinsic, extrinsic,
+                                              depth_scale, depth_trunc, stride,
+                                              *pointcloud);
+    return pointcloud;
 }
 
 std::shared_ptr<PointCloud> PointCloud::CreateFromRGBDImage(
         const RGBDImage &image,
         const camera::PinholeCameraIntrinsic &intrinsic,
         const Eigen::Matrix4d &extrinsic /* = Eigen::Matrix4d::Identity()*/) {
-    if (image.depth_.num_of_channels_ == 1 &&
-        image.depth_.bytes_per_channel_ == 4) {
-        if (image.color_.bytes_per_channel_ == 1 &&
-            image.color_.num_of_channels_ == 3) {
-            return CreatePointCloudFromRGBDImageT<uint8_t, 3>(image, intrinsic,
-                                                              extrinsic);
-        } else if (image.color_.bytes_per_channel_ == 4 &&
-                   image.color_.num_of_channels_ == 1) {
-            return CreatePointCloudFromRGBDImageT<float, 1>(image, intrinsic,
-                                                            extrinsic);
-        }
-    }
-    utility::LogWarning(
-            "[CreatePointCloudFromRGBDImage] Unsupported image format.\n");
-    return std::make_shared<PointCloud>();
+    auto pointcloud = std::make_shared<PointCloud>();
+    DepthBackProjector().CreateFromRGBDImage(image, intrinsic, extrinsic,
+                                             *pointcloud);
+    return pointcloud;
 }
 
 std::shared_ptr<PointCloud> PointCloud::CreateFromVoxelGrid(
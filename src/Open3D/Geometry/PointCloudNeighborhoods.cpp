@@ -0,0 +1,175 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include "Open3D/Geometry/PointCloudNeighborhoods.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+
+#include "Open3D/Geometry/KDTreeFlann.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Utility/Console.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace open3d {
+
+namespace {
+
+/// Spreads the lower 21 bits of \p x so that there are two zero bits between
+/// consecutive bits.
+uint64_t SpreadBits(uint64_t x) {
+    x &= 0x1fffff;
+    x = (x | (x << 32)) & 0x1f00000000ffff;
+    x = (x | (x << 16)) & 0x1f0000ff0000ff;
+    x = (x | (x << 8)) & 0x100f00f00f00f00f;
+    x = (x | (x << 4)) & 0x10c30c30c30c30c3;
+    x = (x | (x << 2)) & 0x1249249249249249;
+    return x;
+}
+
+}  // unnamed namespace
+
+namespace geometry {
+
+std::vector<int> ComputeMortonOrder(
+        const std::vector<Eigen::Vector3d> &points) {
+    int n = int(points.size());
+    std::vector<int> order(n);
+    if (n == 0) {
+        return order;
+    }
+    Eigen::Vector3d min_bound = points[0];
+    Eigen::Vector3d max_bound = points[0];
+    for (const auto &point : points) {
+        min_bound = min_bound.array().min(point.array()).matrix();
+        max_bound = max_bound.array().max(point.array()).matrix();
+    }
+    double extent = (max_bound - min_bound).maxCoeff();
+    double scale = extent > 0.0 ? double((1 << 21) - 1) / extent : 0.0;
+
+    std::vector<std::pair<uint64_t, int>> codes(n);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < n; i++) {
+        Eigen::Vector3d p = (points[i] - min_bound) * scale;
+        // Also maps NaN coordinates to 0.
+        uint64_t x = p(0) > 0.0 ? uint64_t(p(0)) : 0;
+        uint64_t y = p(1) > 0.0 ? uint64_t(p(1)) : 0;
+        uint64_t z = p(2) > 0.0 ? uint64_t(p(2)) : 0;
+        codes[i] = std::make_pair(
+                SpreadBits(x) | (SpreadBits(y) << 1) | (SpreadBits(z) << 2), i);
+    }
+    std::sort(codes.begin(), codes.end());
+    for (int k = 0; k < n; k++) {
+        order[k] = codes[k].second;
+    }
+    return order;
+}
+
+PointCloudNeighborhoods::PointCloudNeighborhoods(
+        const PointCloud &cloud, const KDTreeSearchParam &param) {
+    Compute(cloud, param);
+}
+
+bool PointCloudNeighborhoods::Compute(const PointCloud &cloud,
+                                      const KDTreeSearchParam &param) {
+    int n = int(cloud.points_.size());
+    offsets_.assign(n + 1, 0);
+    indices_.clear();
+    distance2_.clear();
+    if (n == 0) {
+        return true;
+    }
+    KDTreeFlann kdtree;
+    if (!kdtree.SetGeometry(cloud)) {
+        return false;
+    }
+    std::vector<int> order = ComputeMortonOrder(cloud.points_);
+
+    // Every block of the Morton order collects the neighborhoods of its
+    // points in its own buffers, which are then copied to their final
+    // position once all sizes are known.
+#ifdef _OPENMP
+    int num_blocks = omp_get_max_threads() * 4;
+#else
+    int num_blocks = 1;
+#endif
+    std::vector<int> counts(n);
+    std::vector<std::vector<int>> block_indices(num_blocks);
+    std::vector<std::vector<double>> block_distance2(num_blocks);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (int b = 0; b < num_blocks; b++) {
+        std::vector<int> indices;
+        std::vector<double> distance2;
+        for (int64_t k = int64_t(n) * b / num_blocks;
+             k < int64_t(n) * (b + 1) / num_blocks; k++) {
+            int i = order[k];
+            int count = kdtree.Search(cloud.points_[i], param, indices,
+                                      distance2);
+            counts[i] = std::max(count, 0);
+            block_indices[b].insert(block_indices[b].end(), indices.begin(),
+                                    indices.begin() + counts[i]);
+            block_distance2[b].insert(block_distance2[b].end(),
+                                      distance2.begin(),
+                                      distance2.begin() + counts[i]);
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        offsets_[i + 1] = offsets_[i] + size_t(counts[i]);
+    }
+    indices_.resize(offsets_[n]);
+    distance2_.resize(offsets_[n]);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (int b = 0; b < num_blocks; b++) {
+        size_t pos = 0;
+        for (int64_t k = int64_t(n) * b / num_blocks;
+             k < int64_t(n) * (b + 1) / num_blocks; k++) {
+            int i = order[k];
+            std::copy(block_indices[b].begin() + pos,
+                      block_indices[b].begin() + pos + counts[i],
+                      indices_.begin() + offsets_[i]);
+            std::copy(block_distance2[b].begin() + pos,
+                      block_distance2[b].begin() + pos + counts[i],
+                      distance2_.begin() + offsets_[i]);
+            pos += counts[i];
+        }
+        std::vector<int>().swap(block_indices[b]);
+        std::vector<double>().swap(block_distance2[b]);
+    }
+    return true;
+}
+
+}  // namespace geometry
+}  // namespace open3d
@@ -0,0 +1,85 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#pragma once
+
+#include <Eigen/Core>
+#include <cstddef>
+#include <vector>
+
+#include "Open3D/Geometry/KDTreeSearchParam.h"
+
+namespace open3d {
+namespace geometry {
+
+class PointCloud;
+
+/// Returns the indices of \p points sorted along a Morton (Z-order) curve
+/// over their bounding box. Points that are close in this order are close in
+/// space, so a thread that processes a contiguous range of it touches a small
+/// part of the point cloud and of its KDTree.
+std::vector<int> ComputeMortonOrder(const std::vector<Eigen::Vector3d> &points);
+
+/// \class PointCloudNeighborhoods
+///
+/// Neighbors of all points of a point cloud, found with one KDTree search
+/// parameter and stored in flat arrays. The neighbors of point i are
+/// indices_[offsets_[i]:offsets_[i + 1]], sorted by increasing distance as
+/// returned by KDTreeFlann::Search, with squared distances in distance2_.
+///
+/// Computing them once allows functions like PointCloud::EstimateNormals and
+/// registration::ComputeFPFHFeature to run on the same neighborhoods without
+/// searching the KDTree again.
+class PointCloudNeighborhoods {
+public:
+    PointCloudNeighborhoods() {}
+    PointCloudNeighborhoods(const PointCloud &cloud,
+                            const KDTreeSearchParam &param);
+    ~PointCloudNeighborhoods() {}
+
+public:
+    /// Searches the neighbors of every point of \p cloud with \p param.
+    /// Queries are processed in parallel in Morton order.
+    bool Compute(const PointCloud &cloud, const KDTreeSearchParam &param);
+
+    /// Number of points the neighborhoods were computed for.
+    size_t Size() const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+
+    int NumNeighbors(size_t i) const {
+        return int(offsets_[i + 1] - offsets_[i]);
+    }
+    const int *Indices(size_t i) const { return indices_.data() + offsets_[i]; }
+    const double *Distance2(size_t i) const {
+        return distance2_.data() + offsets_[i];
+    }
+
+public:
+    std::vector<size_t> offsets_;
+    std::vector<int> indices_;
+    std::vector<double> distance2_;
+};
+
+}  // namespace geometry
+}  // namespace open3d
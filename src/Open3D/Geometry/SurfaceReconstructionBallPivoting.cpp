@@ -29,39 +29,30 @@
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Geometry/TriangleMesh.h"
 #include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Helper.h"
 
 #include <Eigen/Dense>
 
-#include <iostream>
+#include <algorithm>
+#include <deque>
 #include <list>
+#include <tuple>
+#include <unordered_map>
 
 namespace open3d {
 namespace geometry {
 
-class BallPivotingVertex;
-class BallPivotingEdge;
-class BallPivotingTriangle;
-
-typedef std::shared_ptr<BallPivotingVertex> BallPivotingVertexPtr;
-typedef std::shared_ptr<BallPivotingEdge> BallPivotingEdgePtr;
-typedef std::shared_ptr<BallPivotingTriangle> BallPivotingTrianglePtr;
-
+/// Vertices, edges, and triangles of the front are stored in pools that are
+/// owned by BallPivoting and refer to each other by their pool index, -1
+/// denotes a missing element.
 class BallPivotingVertex {
 public:
     enum Type { Orphan = 0, Front = 1, Inner = 2 };
 
-    BallPivotingVertex(int idx,
-                       const Eigen::Vector3d& point,
-                       const Eigen::Vector3d& normal)
-        : idx_(idx), point_(point), normal_(normal), type_(Orphan) {}
-
-    void UpdateType();
+    BallPivotingVertex() : type_(Orphan) {}
 
 public:
-    int idx_;
-    const Eigen::Vector3d& point_;
-    const Eigen::Vector3d& normal_;
-    std::unordered_set<BallPivotingEdgePtr> edges_;
+    std::vector<int> edges_;
     Type type_;
 };
 
@@ -69,105 +60,112 @@ class BallPivotingEdge {
 public:
     enum Type { Border = 0, Front = 1, Inner = 2 };
 
-    BallPivotingEdge(BallPivotingVertexPtr source, BallPivotingVertexPtr target)
-        : source_(source), target_(target), type_(Type::Front) {}
-
-    void AddAdjacentTriangle(BallPivotingTrianglePtr triangle);
-    BallPivotingVertexPtr GetOppositeVertex();
+    BallPivotingEdge(int source, int target)
+        : source_(source),
+          target_(target),
+          triangle0_(-1),
+          triangle1_(-1),
+          type_(Type::Front) {}
 
 public:
-    BallPivotingVertexPtr source_;
-    BallPivotingVertexPtr target_;
-    BallPivotingTrianglePtr triangle0_;
-    BallPivotingTrianglePtr triangle1_;
+    int source_;
+    int target_;
+    int triangle0_;
+    int triangle1_;
     Type type_;
 };
 
 class BallPivotingTriangle {
 public:
-    BallPivotingTriangle(BallPivotingVertexPtr vert0,
-                         BallPivotingVertexPtr vert1,
-                         BallPivotingVertexPtr vert2,
-                         Eigen::Vector3d ball_center)
+    BallPivotingTriangle(int vert0,
+                         int vert1,
+                         int vert2,
+                         const Eigen::Vector3d& ball_center)
         : vert0_(vert0),
           vert1_(vert1),
           vert2_(vert2),
           ball_center_(ball_center) {}
 
 public:
-    BallPivotingVertexPtr vert0_;
-    BallPivotingVertexPtr vert1_;
-    BallPivotingVertexPtr vert2_;
+    int vert0_;
+    int vert1_;
+    int vert2_;
     Eigen::Vector3d ball_center_;
 };
 
-void BallPivotingVertex::UpdateType() {
-    if (edges_.empty()) {
-        type_ = Type::Orphan;
-    } else {
-        for (const BallPivotingEdgePtr& edge : edges_) {
-            if (edge->type_ != BallPivotingEdge::Type::Inner) {
-                type_ = Type::Front;
-                return;
+class BallPivoting {
+public:
+    BallPivoting(const std::vector<Eigen::Vector3d>& points,
+                 const std::vector<Eigen::Vector3d>& normals)
+        : points_(points), normals_(normals), vertices_(points.size()) {
+        kdtree_.SetMatrixData(Eigen::Map<const Eigen::MatrixXd>(
+                (const double*)points.data(), 3, points.size()));
+    }
+
+    void UpdateVertexType(int vidx) {
+        BallPivotingVertex& vertex = vertices_[vidx];
+        if (vertex.edges_.empty()) {
+            vertex.type_ = BallPivotingVertex::Type::Orphan;
+        } else {
+            for (int eidx : vertex.edges_) {
+                if (edges_[eidx].type_ != BallPivotingEdge::Type::Inner) {
+                    vertex.type_ = BallPivotingVertex::Type::Front;
+                    return;
+                }
             }
+            vertex.type_ = BallPivotingVertex::Type::Inner;
         }
-        type_ = Type::Inner;
     }
-}
 
-void BallPivotingEdge::AddAdjacentTriangle(BallPivotingTrianglePtr triangle) {
-    if (triangle != triangle0_ && triangle != triangle1_) {
-        if (triangle0_ == nullptr) {
-            triangle0_ = triangle;
-            type_ = Type::Front;
-            // update orientation
-            BallPivotingVertexPtr opp = GetOppositeVertex();
-            Eigen::Vector3d tr_norm =
-                    (target_->point_ - source_->point_)
-                            .cross(opp->point_ - source_->point_);
-            tr_norm /= tr_norm.norm();
-            Eigen::Vector3d pt_norm =
-                    source_->normal_ + target_->normal_ + opp->normal_;
-            pt_norm /= pt_norm.norm();
-            if (pt_norm.dot(tr_norm) < 0) {
-                std::swap(target_, source_);
-            }
-        } else if (triangle1_ == nullptr) {
-            triangle1_ = triangle;
-            type_ = Type::Inner;
-        } else {
-            utility::LogDebug("!!! This case should not happen\n");
+    void AddVertexEdge(int vidx, int eidx) {
+        std::vector<int>& edges = vertices_[vidx].edges_;
+        if (std::find(edges.begin(), edges.end(), eidx) == edges.end()) {
+            edges.push_back(eidx);
         }
     }
-}
 
-BallPivotingVertexPtr BallPivotingEdge::GetOppositeVertex() {
-    if (triangle0_ != nullptr) {
-        if (triangle0_->vert0_->idx_ != source_->idx_ &&
-            triangle0_->vert0_->idx_ != target_->idx_) {
-            return triangle0_->vert0_;
-        } else if (triangle0_->vert1_->idx_ != source_->idx_ &&
-                   triangle0_->vert1_->idx_ != target_->idx_) {
-            return triangle0_->vert1_;
+    int GetOppositeVertex(int eidx) {
+        const BallPivotingEdge& edge = edges_[eidx];
+        if (edge.triangle0_ < 0) {
+            return -1;
+        }
+        const BallPivotingTriangle& triangle = triangles_[edge.triangle0_];
+        if (triangle.vert0_ != edge.source_ &&
+            triangle.vert0_ != edge.target_) {
+            return triangle.vert0_;
+        } else if (triangle.vert1_ != edge.source_ &&
+                   triangle.vert1_ != edge.target_) {
+            return triangle.vert1_;
         } else {
-            return triangle0_->vert2_;
+            return triangle.vert2_;
         }
-    } else {
-        return nullptr;
     }
-}
 
-class BallPivoting {
-public:
-    BallPivoting(const PointCloud& pcd)
-        : has_normals_(pcd.HasNormals()), kdtree_(pcd) {
-        mesh_ = std::make_shared<TriangleMesh>();
-        mesh_->vertices_ = pcd.points_;
-        mesh_->vertex_normals_ = pcd.normals_;
-        mesh_->vertex_colors_ = pcd.colors_;
-        for (size_t vidx = 0; vidx < pcd.points_.size(); ++vidx) {
-            vertices.emplace_back(std::make_shared<BallPivotingVertex>(
-                    vidx, pcd.points_[vidx], pcd.normals_[vidx]));
+    void AddAdjacentTriangle(int eidx, int tidx) {
+        BallPivotingEdge& edge = edges_[eidx];
+        if (tidx != edge.triangle0_ && tidx != edge.triangle1_) {
+            if (edge.triangle0_ < 0) {
+                edge.triangle0_ = tidx;
+                edge.type_ = BallPivotingEdge::Type::Front;
+                // update orientation
+                int opp = GetOppositeVertex(eidx);
+                Eigen::Vector3d tr_norm =
+                        (points_[edge.target_] - points_[edge.source_])
+                                .cross(points_[opp] - points_[edge.source_]);
+                tr_norm /= tr_norm.norm();
+                Eigen::Vector3d pt_norm = normals_[edge.source_] +
+                                          normals_[edge.target_] +
+                                          normals_[opp];
+                pt_norm /= pt_norm.norm();
+                if (pt_norm.dot(tr_norm) < 0) {
+                    std::swap(edge.target_, edge.source_);
+                }
+            } else if (edge.triangle1_ < 0) {
+                edge.triangle1_ = tidx;
+                edge.type_ = BallPivotingEdge::Type::Inner;
+            } else {
+                utility::LogDebug("!!! This case should not happen\n");
+            }
         }
     }
 
@@ -176,9 +174,9 @@ public:
                            int vidx3,
                            double radius,
                            Eigen::Vector3d& center) {
-        const Eigen::Vector3d& v1 = vertices[vidx1]->point_;
-        const Eigen::Vector3d& v2 = vertices[vidx2]->point_;
-        const Eigen::Vector3d& v3 = vertices[vidx3]->point_;
+        const Eigen::Vector3d& v1 = points_[vidx1];
+        const Eigen::Vector3d& v2 = points_[vidx2];
+        const Eigen::Vector3d& v3 = points_[vidx3];
         double c = (v2 - v1).squaredNorm();
         double b = (v1 - v3).squaredNorm();
         double a = (v3 - v2).squaredNorm();
@@ -209,9 +207,8 @@ public:
         if (height >= 0.0) {
             Eigen::Vector3d tr_norm = (v2 - v1).cross(v3 - v1);
             tr_norm /= tr_norm.norm();
-            Eigen::Vector3d pt_norm = vertices[vidx1]->normal_ +
-                                      vertices[vidx2]->normal_ +
-                                      vertices[vidx3]->normal_;
+            Eigen::Vector3d pt_norm =
+                    normals_[vidx1] + normals_[vidx2] + normals_[vidx3];
             pt_norm /= pt_norm.norm();
             if (tr_norm.dot(pt_norm) < 0) {
                 tr_norm *= -1;
@@ -224,67 +221,60 @@ public:
         return false;
     }
 
-    BallPivotingEdgePtr GetLinkingEdge(const BallPivotingVertexPtr& v0,
-                                       const BallPivotingVertexPtr& v1) {
-        for (BallPivotingEdgePtr edge0 : v0->edges_) {
-            for (BallPivotingEdgePtr edge1 : v1->edges_) {
-                if (edge0->source_->idx_ == edge1->source_->idx_ &&
-                    edge0->target_->idx_ == edge1->target_->idx_) {
-                    return edge0;
-                }
+    int GetLinkingEdge(int v0, int v1) {
+        for (int eidx : vertices_[v0].edges_) {
+            const BallPivotingEdge& edge = edges_[eidx];
+            if ((edge.source_ == v0 && edge.target_ == v1) ||
+                (edge.source_ == v1 && edge.target_ == v0)) {
+                return eidx;
             }
         }
-        return nullptr;
+        return -1;
     }
 
-    void CreateTriangle(const BallPivotingVertexPtr& v0,
-                        const BallPivotingVertexPtr& v1,
-                        const BallPivotingVertexPtr& v2,
-                        const Eigen::Vector3d& center) {
-        utility::LogDebug(
-                "[CreateTriangle] with v0.idx={}, v1.idx={}, v2.idx={}\n",
-                v0->idx_, v1->idx_, v2->idx_);
-        BallPivotingTrianglePtr triangle =
-                std::make_shared<BallPivotingTriangle>(v0, v1, v2, center);
-
-        BallPivotingEdgePtr e0 = GetLinkingEdge(v0, v1);
-        if (e0 == nullptr) {
-            e0 = std::make_shared<BallPivotingEdge>(v0, v1);
-        }
-        e0->AddAdjacentTriangle(triangle);
-        v0->edges_.insert(e0);
-        v1->edges_.insert(e0);
-
-        BallPivotingEdgePtr e1 = GetLinkingEdge(v1, v2);
-        if (e1 == nullptr) {
-            e1 = std::make_shared<BallPivotingEdge>(v1, v2);
-        }
-        e1->AddAdjacentTriangle(triangle);
-        v1->edges_.insert(e1);
-        v2->edges_.insert(e1);
-
-        BallPivotingEdgePtr e2 = GetLinkingEdge(v2, v0);
-        if (e2 == nullptr) {
-            e2 = std::make_shared<BallPivotingEdge>(v2, v0);
+    int GetOrCreateLinkingEdge(int v0, int v1) {
+        int eidx = GetLinkingEdge(v0, v1);
+        if (eidx < 0) {
+            eidx = int(edges_.size());
+            edges_.emplace_back(v0, v1);
         }
-        e2->AddAdjacentTriangle(triangle);
-        v2->edges_.insert(e2);
-        v0->edges_.insert(e2);
+        return eidx;
+    }
 
-        v0->UpdateType();
-        v1->UpdateType();
-        v2->UpdateType();
+    void CreateTriangle(int v0, int v1, int v2, const Eigen::Vector3d& center) {
+        utility::LogDebug(
+                "[CreateTriangle] with v0.idx={}, v1.idx={}, v2.idx={}\n", v0,
+                v1, v2);
+        int tidx = int(triangles_.size());
+        triangles_.emplace_back(v0, v1, v2, center);
+
+        int e0 = GetOrCreateLinkingEdge(v0, v1);
+        AddAdjacentTriangle(e0, tidx);
+        AddVertexEdge(v0, e0);
+        AddVertexEdge(v1, e0);
+
+        int e1 = GetOrCreateLinkingEdge(v1, v2);
+        AddAdjacentTriangle(e1, tidx);
+        AddVertexEdge(v1, e1);
+        AddVertexEdge(v2, e1);
+
+        int e2 = GetOrCreateLinkingEdge(v2, v0);
+        AddAdjacentTriangle(e2, tidx);
+        AddVertexEdge(v2, e2);
+        AddVertexEdge(v0, e2);
+
+        UpdateVertexType(v0);
+        UpdateVertexType(v1);
+        UpdateVertexType(v2);
 
         Eigen::Vector3d face_normal =
-                ComputeFaceNormal(v0->point_, v1->point_, v2->point_);
-        if (face_normal.dot(v0->normal_) > -1e-16) {
-            mesh_->triangles_.emplace_back(
-                    Eigen::Vector3i(v0->idx_, v1->idx_, v2->idx_));
+                ComputeFaceNormal(points_[v0], points_[v1], points_[v2]);
+        if (face_normal.dot(normals_[v0]) > -1e-16) {
+            mesh_triangles_.emplace_back(Eigen::Vector3i(v0, v1, v2));
         } else {
-            mesh_->triangles_.emplace_back(
-                    Eigen::Vector3i(v0->idx_, v2->idx_, v1->idx_));
+            mesh_triangles_.emplace_back(Eigen::Vector3i(v0, v2, v1));
         }
-        mesh_->triangle_normals_.push_back(face_normal);
+        mesh_triangle_normals_.push_back(face_normal);
     }
 
     Eigen::Vector3d ComputeFaceNormal(const Eigen::Vector3d& v0,
@@ -298,54 +288,50 @@ public:
         return normal;
     }
 
-    bool IsCompatible(const BallPivotingVertexPtr& v0,
-                      const BallPivotingVertexPtr& v1,
-                      const BallPivotingVertexPtr& v2) {
+    bool IsCompatible(int v0, int v1, int v2) {
         utility::LogDebug("[IsCompatible] v0.idx={}, v1.idx={}, v2.idx={}\n",
-                          v0->idx_, v1->idx_, v2->idx_);
+                          v0, v1, v2);
         Eigen::Vector3d normal =
-                ComputeFaceNormal(v0->point_, v1->point_, v2->point_);
-        if (normal.dot(v0->normal_) < -1e-16) {
+                ComputeFaceNormal(points_[v0], points_[v1], points_[v2]);
+        if (normal.dot(normals_[v0]) < -1e-16) {
             normal *= -1;
         }
-        bool ret = normal.dot(v0->normal_) > -1e-16 &&
-                   normal.dot(v1->normal_) > -1e-16 &&
-                   normal.dot(v2->normal_) > -1e-16;
+        bool ret = normal.dot(normals_[v0]) > -1e-16 &&
+                   normal.dot(normals_[v1]) > -1e-16 &&
+                   normal.dot(normals_[v2]) > -1e-16;
         utility::LogDebug("[IsCompatible] retuns = {}\n", ret);
         return ret;
     }
 
-    BallPivotingVertexPtr FindCandidateVertex(
-            const BallPivotingEdgePtr& edge,
-            double radius,
-            Eigen::Vector3d& candidate_center) {
+    int FindCandidateVertex(int eidx,
+                            double radius,
+                            Eigen::Vector3d& candidate_center) {
+        const BallPivotingEdge& edge = edges_[eidx];
+        int src = edge.source_;
+        int tgt = edge.target_;
         utility::LogDebug("[FindCandidateVertex] edge=({}, {}), radius={}\n",
-                          edge->source_->idx_, edge->target_->idx_, radius);
-        BallPivotingVertexPtr src = edge->source_;
-        BallPivotingVertexPtr tgt = edge->target_;
-
-        const BallPivotingVertexPtr opp = edge->GetOppositeVertex();
-        utility::LogDebug("[FindCandidateVertex] edge=({}, {}), opp={}\n",
-                          src->idx_, tgt->idx_, opp->idx_);
-        utility::LogDebug("[FindCandidateVertex] src={} => {}\n", src->idx_,
-                          src->point_.transpose());
-        utility::LogDebug("[FindCandidateVertex] tgt={} => {}\n", tgt->idx_,
-                          tgt->point_.transpose());
-        utility::LogDebug("[FindCandidateVertex] src={} => {}\n", opp->idx_,
-                          opp->point_.transpose());
-
-        Eigen::Vector3d mp = 0.5 * (src->point_ + tgt->point_);
-        utility::LogDebug("[FindCandidateVertex] edge=({}, {}), mp={}\n",
-                          edge->source_->idx_, edge->target_->idx_,
-                          mp.transpose());
-
-        BallPivotingTrianglePtr triangle = edge->triangle0_;
-        const Eigen::Vector3d& center = triangle->ball_center_;
+                          src, tgt, radius);
+
+        int opp = GetOppositeVertex(eidx);
+        utility::LogDebug("[FindCandidateVertex] edge=({}, {}), opp={}\n", src,
+                          tgt, opp);
+        utility::LogDebug("[FindCandidateVertex] src={} => {}\n", src,
+                          points_[src].transpose());
+        utility::LogDebug("[FindCandidateVertex] tgt={} => {}\n", tgt,
+                          points_[tgt].transpose());
+        utility::LogDebug("[FindCandidateVertex] src={} => {}\n", opp,
+                          points_[opp].transpose());
+
+        Eigen::Vector3d mp = 0.5 * (points_[src] + points_[tgt]);
+        utility::LogDebug("[FindCandidateVertex] edge=({}, {}), mp={}\n", src,
+                          tgt, mp.transpose());
+
+        const Eigen::Vector3d& center =
+                triangles_[edge.triangle0_].ball_center_;
         utility::LogDebug("[FindCandidateVertex] edge=({}, {}), center={}\n",
-                          edge->source_->idx_, edge->target_->idx_,
-                          center.transpose());
+                          src, tgt, center.transpose());
 
-        Eigen::Vector3d v = tgt->point_ - src->point_;
+        Eigen::Vector3d v = points_[tgt] - points_[src];
         v /= v.norm();
 
         Eigen::Vector3d a = center - mp;
@@ -358,63 +344,60 @@ public:
                 "[FindCandidateVertex] found {} potential candidates\n",
                 indices.size());
 
-        BallPivotingVertexPtr min_candidate = nullptr;
+        int min_candidate = -1;
         double min_angle = 2 * M_PI;
-        for (auto nbidx : indices) {
-            utility::LogDebug("[FindCandidateVertex] nbidx {:d}\n", nbidx);
-            const BallPivotingVertexPtr& candidate = vertices[nbidx];
-            if (candidate->idx_ == src->idx_ || candidate->idx_ == tgt->idx_ ||
-                candidate->idx_ == opp->idx_) {
+        for (auto candidate : indices) {
+            utility::LogDebug("[FindCandidateVertex] nbidx {:d}\n", candidate);
+            if (candidate == src || candidate == tgt || candidate == opp) {
                 utility::LogDebug(
                         "[FindCandidateVertex] candidate {:d} is a triangle "
                         "vertex of the edge\n",
-                        candidate->idx_);
+                        candidate);
                 continue;
             }
             utility::LogDebug("[FindCandidateVertex] candidate={:d} => {}\n",
-                              candidate->idx_, candidate->point_.transpose());
+                              candidate, points_[candidate].transpose());
 
             bool coplanar = IntersectionTest::PointsCoplanar(
-                    src->point_, tgt->point_, opp->point_, candidate->point_);
+                    points_[src], points_[tgt], points_[opp],
+                    points_[candidate]);
             if (coplanar && (IntersectionTest::LineSegmentsMinimumDistance(
-                                     mp, candidate->point_, src->point_,
-                                     opp->point_) < 1e-12 ||
+                                     mp, points_[candidate], points_[src],
+                                     points_[opp]) < 1e-12 ||
                              IntersectionTest::LineSegmentsMinimumDistance(
-                                     mp, candidate->point_, tgt->point_,
-                                     opp->point_) < 1e-12)) {
+                                     mp, points_[candidate], points_[tgt],
+                                     points_[opp]) < 1e-12)) {
                 utility::LogDebug(
                         "[FindCandidateVertex] candidate {:d} is interesecting "
                         "the existing triangle\n",
-                        candidate->idx_);
+                        candidate);
                 continue;
             }
 
             Eigen::Vector3d new_center;
-            if (!ComputeBallCenter(src->idx_, tgt->idx_, candidate->idx_,
-                                   radius, new_center)) {
+            if (!ComputeBallCenter(src, tgt, candidate, radius, new_center)) {
                 utility::LogDebug(
                         "[FindCandidateVertex] candidate {:d} can not compute "
                         "ball\n",
-                        candidate->idx_);
+                        candidate);
                 continue;
             }
             utility::LogDebug(
                     "[FindCandidateVertex] candidate {:d} center={}\n",
-                    candidate->idx_, new_center.transpose());
+                    candidate, new_center.transpose());
 
             Eigen::Vector3d b = new_center - mp;
             b /= b.norm();
             utility::LogDebug(
                     "[FindCandidateVertex] candidate {:d} v={}, a={}, b={}\n",
-                    candidate->idx_, v.transpose(), a.transpose(),
-                    b.transpose());
+                    candidate, v.transpose(), a.transpose(), b.transpose());
 
             double cosinus = a.dot(b);
             cosinus = std::min(cosinus, 1.0);
             cosinus = std::max(cosinus, -1.0);
             utility::LogDebug(
                     "[FindCandidateVertex] candidate {:d} cosinus={:f}\n",
-                    candidate->idx_, cosinus);
+                    candidate, cosinus);
 
             double angle = std::acos(cosinus);
 
@@ -427,22 +410,20 @@ public:
                 utility::LogDebug(
                         "[FindCandidateVertex] candidate {:d} angle {:f} > "
                         "min_angle {:f}\n",
-                        candidate->idx_, angle, min_angle);
+                        candidate, angle, min_angle);
                 continue;
             }
 
             bool empty_ball = true;
-            for (auto nbidx2 : indices) {
-                const BallPivotingVertexPtr& nb = vertices[nbidx2];
-                if (nb->idx_ == src->idx_ || nb->idx_ == tgt->idx_ ||
-                    nb->idx_ == candidate->idx_) {
+            for (auto nb : indices) {
+                if (nb == src || nb == tgt || nb == candidate) {
                     continue;
                 }
-                if ((new_center - nb->point_).norm() < radius - 1e-16) {
+                if ((new_center - points_[nb]).norm() < radius - 1e-16) {
                     utility::LogDebug(
                             "[FindCandidateVertex] candidate {:d} not an empty "
                             "ball\n",
-                            candidate->idx_);
+                            candidate);
                     empty_ball = false;
                     break;
                 }
@@ -451,95 +432,95 @@ public:
             if (empty_ball) {
                 utility::LogDebug(
                         "[FindCandidateVertex] candidate {:d} works\n",
-                        candidate->idx_);
+                        candidate);
                 min_angle = angle;
-                min_candidate = vertices[nbidx];
+                min_candidate = candidate;
                 candidate_center = new_center;
             }
         }
 
-        if (min_candidate == nullptr) {
-            utility::LogDebug("[FindCandidateVertex] returns nullptr\n");
-        } else {
-            utility::LogDebug("[FindCandidateVertex] returns {:d}\n",
-                              min_candidate->idx_);
-        }
+        utility::LogDebug("[FindCandidateVertex] returns {:d}\n",
+                          min_candidate);
         return min_candidate;
     }
 
     void ExpandTriangulation(double radius) {
         utility::LogDebug("[ExpandTriangulation] radius={}\n", radius);
         while (!edge_front_.empty()) {
-            BallPivotingEdgePtr edge = edge_front_.front();
+            int eidx = edge_front_.front();
             edge_front_.pop_front();
-            if (edge->type_ != BallPivotingEdge::Front) {
+            if (edges_[eidx].type_ != BallPivotingEdge::Front) {
                 continue;
             }
 
             Eigen::Vector3d center;
-            BallPivotingVertexPtr candidate =
-                    FindCandidateVertex(edge, radius, center);
-            if (candidate == nullptr ||
-                candidate->type_ == BallPivotingVertex::Type::Inner ||
-                !IsCompatible(candidate, edge->source_, edge->target_)) {
-                edge->type_ = BallPivotingEdge::Type::Border;
-                border_edges_.push_back(edge);
+            int candidate = FindCandidateVertex(eidx, radius, center);
+            int src = edges_[eidx].source_;
+            int tgt = edges_[eidx].target_;
+            if (candidate < 0 ||
+                vertices_[candidate].type_ ==
+                        BallPivotingVertex::Type::Inner ||
+                !IsCompatible(candidate, src, tgt)) {
+                edges_[eidx].type_ = BallPivotingEdge::Type::Border;
+                border_edges_.push_back(eidx);
                 continue;
             }
 
-            BallPivotingEdgePtr e0 = GetLinkingEdge(candidate, edge->source_);
-            BallPivotingEdgePtr e1 = GetLinkingEdge(candidate, edge->target_);
-            if ((e0 != nullptr && e0->type_ != BallPivotingEdge::Type::Front) ||
-                (e1 != nullptr && e1->type_ != BallPivotingEdge::Type::Front)) {
-                edge->type_ = BallPivotingEdge::Type::Border;
-                border_edges_.push_back(edge);
+            int e0 = GetLinkingEdge(candidate, src);
+            int e1 = GetLinkingEdge(candidate, tgt);
+            if ((e0 >= 0 &&
+                 edges_[e0].type_ != BallPivotingEdge::Type::Front) ||
+                (e1 >= 0 &&
+                 edges_[e1].type_ != BallPivotingEdge::Type::Front)) {
+                edges_[eidx].type_ = BallPivotingEdge::Type::Border;
+                border_edges_.push_back(eidx);
                 continue;
             }
 
-            CreateTriangle(edge->source_, edge->target_, candidate, center);
+            CreateTriangle(src, tgt, candidate, center);
 
-            e0 = GetLinkingEdge(candidate, edge->source_);
-            e1 = GetLinkingEdge(candidate, edge->target_);
-            if (e0->type_ == BallPivotingEdge::Type::Front) {
+            e0 = GetLinkingEdge(candidate, src);
+            e1 = GetLinkingEdge(candidate, tgt);
+            if (edges_[e0].type_ == BallPivotingEdge::Type::Front) {
                 edge_front_.push_front(e0);
             }
-            if (e1->type_ == BallPivotingEdge::Type::Front) {
+            if (edges_[e1].type_ == BallPivotingEdge::Type::Front) {
                 edge_front_.push_front(e1);
             }
         }
     }
 
-    bool TryTriangleSeed(const BallPivotingVertexPtr& v0,
-                         const BallPivotingVertexPtr& v1,
-                         const BallPivotingVertexPtr& v2,
+    bool TryTriangleSeed(int v0,
+                         int v1,
+                         int v2,
                          const std::vector<int>& nb_indices,
                          double radius,
                          Eigen::Vector3d& center) {
         utility::LogDebug(
                 "[TryTriangleSeed] v0.idx={}, v1.idx={}, v2.idx={}, "
                 "radius={}\n",
-                v0->idx_, v1->idx_, v2->idx_, radius);
+                v0, v1, v2, radius);
 
         if (!IsCompatible(v0, v1, v2)) {
             return false;
         }
 
-        BallPivotingEdgePtr e0 = GetLinkingEdge(v0, v2);
-        BallPivotingEdgePtr e1 = GetLinkingEdge(v1, v2);
-        if (e0 != nullptr && e0->type_ == BallPivotingEdge::Type::Inner) {
+        int e0 = GetLinkingEdge(v0, v2);
+        int e1 = GetLinkingEdge(v1, v2);
+        if (e0 >= 0 && edges_[e0].type_ == BallPivotingEdge::Type::Inner) {
             utility::LogDebug(
                     "[TryTriangleSeed] returns {} because e0 is inner edge\n",
                     false);
             return false;
         }
-        if (e1 != nullptr && e1->type_ == BallPivotingEdge::Type::Inner) {
+        if (e1 >= 0 && edges_[e1].type_ == BallPivotingEdge::Type::Inner) {
             utility::LogDebug(
                     "[TryTriangleSeed] returns {} because e1 is inner edge\n",
                     false);
             return false;
         }
 
-        if (!ComputeBallCenter(v0->idx_, v1->idx_, v2->idx_, radius, center)) {
+        if (!ComputeBallCenter(v0, v1, v2, radius, center)) {
             utility::LogDebug(
                     "[TryTriangleSeed] returns {} could not compute ball "
                     "center\n",
@@ -549,12 +530,10 @@ public:
 
         // test if no other point is within the ball
         for (const auto& nbidx : nb_indices) {
-            const BallPivotingVertexPtr& v = vertices[nbidx];
-            if (v->idx_ == v0->idx_ || v->idx_ == v1->idx_ ||
-                v->idx_ == v2->idx_) {
+            if (nbidx == v0 || nbidx == v1 || nbidx == v2) {
                 continue;
             }
-            if ((center - v->point_).norm() < radius - 1e-16) {
+            if ((center - points_[nbidx]).norm() < radius - 1e-16) {
                 utility::LogDebug(
                         "[TryTriangleSeed] returns {} computed ball is not "
                         "empty\n",
@@ -567,58 +546,57 @@ public:
         return true;
     }
 
-    bool TrySeed(BallPivotingVertexPtr& v, double radius) {
-        utility::LogDebug("[TrySeed] with v.idx={}, radius={}\n", v->idx_,
-                          radius);
+    bool TrySeed(int v, double radius) {
+        utility::LogDebug("[TrySeed] with v.idx={}, radius={}\n", v, radius);
         std::vector<int> indices;
         std::vector<double> dists2;
-        kdtree_.SearchRadius(v->point_, 2 * radius, indices, dists2);
+        kdtree_.SearchRadius(points_[v], 2 * radius, indices, dists2);
         if (indices.size() < 3u) {
             return false;
         }
 
         for (size_t nbidx0 = 0; nbidx0 < indices.size(); ++nbidx0) {
-            const BallPivotingVertexPtr& nb0 = vertices[indices[nbidx0]];
-            if (nb0->type_ != BallPivotingVertex::Type::Orphan) {
+            int nb0 = indices[nbidx0];
+            if (vertices_[nb0].type_ != BallPivotingVertex::Type::Orphan) {
                 continue;
             }
-            if (nb0->idx_ == v->idx_) {
+            if (nb0 == v) {
                 continue;
             }
 
-            int candidate_vidx2 = -1;
+            int nb1 = -1;
             Eigen::Vector3d center;
             for (size_t nbidx1 = nbidx0 + 1; nbidx1 < indices.size();
                  ++nbidx1) {
-                const BallPivotingVertexPtr& nb1 = vertices[indices[nbidx1]];
-                if (nb1->type_ != BallPivotingVertex::Type::Orphan) {
+                int candidate = indices[nbidx1];
+                if (vertices_[candidate].type_ !=
+                    BallPivotingVertex::Type::Orphan) {
                     continue;
                 }
-                if (nb1->idx_ == v->idx_) {
+                if (candidate == v) {
                     continue;
                 }
-                if (TryTriangleSeed(v, nb0, nb1, indices, radius, center)) {
-                    candidate_vidx2 = nb1->idx_;
+                if (TryTriangleSeed(v, nb0, candidate, indices, radius,
+                                    center)) {
+                    nb1 = candidate;
                     break;
                 }
             }
 
-            if (candidate_vidx2 >= 0) {
-                const BallPivotingVertexPtr& nb1 = vertices[candidate_vidx2];
-
-                BallPivotingEdgePtr e0 = GetLinkingEdge(v, nb1);
-                if (e0 != nullptr &&
-                    e0->type_ != BallPivotingEdge::Type::Front) {
+            if (nb1 >= 0) {
+                int e0 = GetLinkingEdge(v, nb1);
+                if (e0 >= 0 &&
+                    edges_[e0].type_ != BallPivotingEdge::Type::Front) {
                     continue;
                 }
-                BallPivotingEdgePtr e1 = GetLinkingEdge(nb0, nb1);
-                if (e1 != nullptr &&
-                    e1->type_ != BallPivotingEdge::Type::Front) {
+                int e1 = GetLinkingEdge(nb0, nb1);
+                if (e1 >= 0 &&
+                    edges_[e1].type_ != BallPivotingEdge::Type::Front) {
                     continue;
                 }
-                BallPivotingEdgePtr e2 = GetLinkingEdge(v, nb0);
-                if (e2 != nullptr &&
-                    e2->type_ != BallPivotingEdge::Type::Front) {
+                int e2 = GetLinkingEdge(v, nb0);
+                if (e2 >= 0 &&
+                    edges_[e2].type_ != BallPivotingEdge::Type::Front) {
                     continue;
                 }
 
@@ -627,13 +605,13 @@ public:
                 e0 = GetLinkingEdge(v, nb1);
                 e1 = GetLinkingEdge(nb0, nb1);
                 e2 = GetLinkingEdge(v, nb0);
-                if (e0->type_ == BallPivotingEdge::Type::Front) {
+                if (edges_[e0].type_ == BallPivotingEdge::Type::Front) {
                     edge_front_.push_front(e0);
                 }
-                if (e1->type_ == BallPivotingEdge::Type::Front) {
+                if (edges_[e1].type_ == BallPivotingEdge::Type::Front) {
                     edge_front_.push_front(e1);
                 }
-                if (e2->type_ == BallPivotingEdge::Type::Front) {
+                if (edges_[e2].type_ == BallPivotingEdge::Type::Front) {
                     edge_front_.push_front(e2);
                 }
 
@@ -651,76 +629,73 @@ public:
     }
 
     void FindSeedTriangle(double radius) {
-        for (size_t vidx = 0; vidx < vertices.size(); ++vidx) {
+        for (size_t vidx = 0; vidx < vertices_.size(); ++vidx) {
             utility::LogDebug("[FindSeedTriangle] with radius={}, vidx={}\n",
                               radius, vidx);
-            if (vertices[vidx]->type_ == BallPivotingVertex::Type::Orphan) {
-                if (TrySeed(vertices[vidx], radius)) {
+            if (vertices_[vidx].type_ == BallPivotingVertex::Type::Orphan) {
+                if (TrySeed(int(vidx), radius)) {
                     ExpandTriangulation(radius);
                 }
             }
         }
     }
 
-    std::shared_ptr<TriangleMesh> Run(const std::vector<double>& radii) {
-        if (!has_normals_) {
-            utility::LogWarning("ReconstructBallPivoting requires normals\n");
-            return mesh_;
-        }
+    /// Moves the border edges whose triangle admits an empty ball of the new
+    /// \param radius back to the front.
+    void UpdateBorderEdges(double radius) {
+        for (auto it = border_edges_.begin(); it != border_edges_.end();) {
+            int eidx = *it;
+            const BallPivotingTriangle& triangle =
+                    triangles_[edges_[eidx].triangle0_];
+            utility::LogDebug(
+                    "[Run] try edge {:d}-{:d} of triangle {:d}-{:d}-{:d}\n",
+                    edges_[eidx].source_, edges_[eidx].target_,
+                    triangle.vert0_, triangle.vert1_, triangle.vert2_);
 
-        mesh_->triangles_.clear();
+            Eigen::Vector3d center;
+            if (ComputeBallCenter(triangle.vert0_, triangle.vert1_,
+                                  triangle.vert2_, radius, center)) {
+                utility::LogDebug("[Run]   yes, we can work on this\n");
+                std::vector<int> indices;
+                std::vector<double> dists2;
+                kdtree_.SearchRadius(center, radius, indices, dists2);
+                bool empty_ball = true;
+                for (auto idx : indices) {
+                    if (idx != triangle.vert0_ && idx != triangle.vert1_ &&
+                        idx != triangle.vert2_) {
+                        utility::LogDebug(
+                                "[Run]   but no, the ball is not empty\n");
+                        empty_ball = false;
+                        break;
+                    }
+                }
 
+                if (empty_ball) {
+                    utility::LogDebug(
+                            "[Run]   yeah, add edge to edge_front_: {:d}\n",
+                            edge_front_.size());
+                    edges_[eidx].type_ = BallPivotingEdge::Type::Front;
+                    edge_front_.push_back(eidx);
+                    it = border_edges_.erase(it);
+                    continue;
+                }
+            }
+            ++it;
+        }
+    }
+
+    bool Run(const std::vector<double>& radii) {
         for (double radius : radii) {
             utility::LogDebug("[Run] ################################\n");
             utility::LogDebug("[Run] change to radius {:.4f}\n", radius);
             if (radius <= 0) {
                 utility::LogWarning(
                         "got an invalid, negative radius as parameter\n");
-                return mesh_;
+                return false;
             }
 
             // update radius => update border edges
-            for (auto it = border_edges_.begin(); it != border_edges_.end();) {
-                BallPivotingEdgePtr edge = *it;
-                BallPivotingTrianglePtr triangle = edge->triangle0_;
-                utility::LogDebug(
-                        "[Run] try edge {:d}-{:d} of triangle {:d}-{:d}-{:d}\n",
-                        edge->source_->idx_, edge->target_->idx_,
-                        triangle->vert0_->idx_, triangle->vert1_->idx_,
-                        triangle->vert2_->idx_);
-
-                Eigen::Vector3d center;
-                if (ComputeBallCenter(triangle->vert0_->idx_,
-                                      triangle->vert1_->idx_,
-                                      triangle->vert2_->idx_, radius, center)) {
-                    utility::LogDebug("[Run]   yes, we can work on this\n");
-                    std::vector<int> indices;
-                    std::vector<double> dists2;
-                    kdtree_.SearchRadius(center, radius, indices, dists2);
-                    bool empty_ball = true;
-                    for (auto idx : indices) {
-                        if (idx != triangle->vert0_->idx_ &&
-                            idx != triangle->vert1_->idx_ &&
-                            idx != triangle->vert2_->idx_) {
-                            utility::LogDebug(
-                                    "[Run]   but no, the ball is not empty\n");
-                            empty_ball = false;
-                            break;
-                        }
-                    }
-
-                    if (empty_ball) {
-                        utility::LogDebug(
-                                "[Run]   yeah, add edge to edge_front_: {:d}\n",
-                                edge_front_.size());
-                        edge->type_ = BallPivotingEdge::Type::Front;
-                        edge_front_.push_back(edge);
-                        it = border_edges_.erase(it);
-                        continue;
-                    }
-                }
-                ++it;
-            }
+            UpdateBorderEdges(radius);
 
             // do the reconstruction
             if (edge_front_.empty()) {
@@ -730,25 +705,208 @@ public:
             }
 
             utility::LogDebug("[Run] mesh_ has {:d} triangles\n",
-                              mesh_->triangles_.size());
+                              mesh_triangles_.size());
             utility::LogDebug("[Run] ################################\n");
         }
-        return mesh_;
+        return true;
+    }
+
+    /// Adds a triangle that was found by pivoting another part of the point
+    /// cloud. The triangle is rejected if one of its edges is already shared
+    /// by two triangles.
+    bool AddTriangle(int v0, int v1, int v2, const Eigen::Vector3d& center) {
+        int e0 = GetLinkingEdge(v0, v1);
+        int e1 = GetLinkingEdge(v1, v2);
+        int e2 = GetLinkingEdge(v2, v0);
+        if ((e0 >= 0 && edges_[e0].type_ == BallPivotingEdge::Type::Inner) ||
+            (e1 >= 0 && edges_[e1].type_ == BallPivotingEdge::Type::Inner) ||
+            (e2 >= 0 && edges_[e2].type_ == BallPivotingEdge::Type::Inner)) {
+            return false;
+        }
+        CreateTriangle(v0, v1, v2, center);
+        return true;
+    }
+
+    /// Pivots the ball over all open edges of the added triangles. In contrast
+    /// to Run no new seed triangles are searched.
+    void Stitch(const std::vector<double>& radii) {
+        for (size_t eidx = 0; eidx < edges_.size(); ++eidx) {
+            if (edges_[eidx].type_ == BallPivotingEdge::Type::Front) {
+                edge_front_.push_back(int(eidx));
+            }
+        }
+        for (double radius : radii) {
+            UpdateBorderEdges(radius);
+            ExpandTriangulation(radius);
+        }
     }
 
-private:
-    bool has_normals_;
+public:
+    const std::vector<Eigen::Vector3d>& points_;
+    const std::vector<Eigen::Vector3d>& normals_;
     KDTreeFlann kdtree_;
-    std::list<BallPivotingEdgePtr> edge_front_;
-    std::list<BallPivotingEdgePtr> border_edges_;
-    std::vector<BallPivotingVertexPtr> vertices;
-    std::shared_ptr<TriangleMesh> mesh_;
+    std::vector<BallPivotingVertex> vertices_;
+    std::vector<BallPivotingEdge> edges_;
+    std::vector<BallPivotingTriangle> triangles_;
+    std::deque<int> edge_front_;
+    std::list<int> border_edges_;
+    std::vector<Eigen::Vector3i> mesh_triangles_;
+    std::vector<Eigen::Vector3d> mesh_triangle_normals_;
 };
 
+namespace {
+
+std::shared_ptr<TriangleMesh> CreateBallPivotingMesh(const PointCloud& pcd) {
+    auto mesh = std::make_shared<TriangleMesh>();
+    mesh->vertices_ = pcd.points_;
+    mesh->vertex_normals_ = pcd.normals_;
+    mesh->vertex_colors_ = pcd.colors_;
+    return mesh;
+}
+
+}  // unnamed namespace
+
 std::shared_ptr<TriangleMesh> TriangleMesh::CreateFromPointCloudBallPivoting(
         const PointCloud& pcd, const std::vector<double>& radii) {
-    BallPivoting bp(pcd);
-    return bp.Run(radii);
+    auto mesh = CreateBallPivotingMesh(pcd);
+    if (!pcd.HasNormals()) {
+        utility::LogWarning("ReconstructBallPivoting requires normals\n");
+        return mesh;
+    }
+    BallPivoting bp(pcd.points_, pcd.normals_);
+    bp.Run(radii);
+    mesh->triangles_ = std::move(bp.mesh_triangles_);
+    mesh->triangle_normals_ = std::move(bp.mesh_triangle_normals_);
+    return mesh;
+}
+
+std::shared_ptr<TriangleMesh>
+TriangleMesh::CreateFromPointCloudBallPivotingParallel(
+        const PointCloud& pcd,
+        const std::vector<double>& radii,
+        double cell_size /* = 0.0 */) {
+    auto mesh = CreateBallPivotingMesh(pcd);
+    if (!pcd.HasNormals()) {
+        utility::LogWarning("ReconstructBallPivoting requires normals\n");
+        return mesh;
+    }
+    if (radii.empty() || !pcd.HasPoints()) {
+        return mesh;
+    }
+    double max_radius = 0.0;
+    for (double radius : radii) {
+        if (radius <= 0) {
+            utility::LogWarning(
+                    "got an invalid, negative radius as parameter\n");
+            return mesh;
+        }
+        max_radius = std::max(max_radius, radius);
+    }
+
+    // Every triangle is owned by the cell that contains its centroid. Its
+    // vertices lie within 2 / sqrt(3) * max_radius of the centroid and all
+    // points that can stop the ball while pivoting around its edges lie
+    // within 2 * max_radius of a vertex.
+    const double margin = (2.0 + 2.0 / std::sqrt(3.0)) * max_radius;
+    const Eigen::Vector3d min_bound = pcd.GetMinBound();
+    const Eigen::Vector3d extent = pcd.GetMaxBound() - min_bound;
+    if (cell_size <= 0.0) {
+        // A surface sample populates about k^2 cells of a k^3 grid.
+        int cells_per_axis = std::max(
+                1, int(std::ceil(std::sqrt(pcd.points_.size() / 50000.0))));
+        cell_size = extent.maxCoeff() / cells_per_axis;
+    }
+    // The cell coordinates have to fit into an int.
+    const int max_cells_per_axis = 1 << 20;
+    cell_size = std::max(std::max(cell_size, margin),
+                         extent.maxCoeff() / max_cells_per_axis);
+    Eigen::Vector3i resolution;
+    for (int axis = 0; axis < 3; ++axis) {
+        resolution(axis) = int(std::floor(extent(axis) / cell_size)) + 1;
+    }
+    auto CellCoordinate = [&](double value, int axis) {
+        double coordinate = std::floor((value - min_bound(axis)) / cell_size);
+        return int(std::min(std::max(coordinate, 0.0),
+                            double(resolution(axis) - 1)));
+    };
+    auto CellOf = [&](const Eigen::Vector3d& p) {
+        return Eigen::Vector3i(CellCoordinate(p(0), 0), CellCoordinate(p(1), 1),
+                               CellCoordinate(p(2), 2));
+    };
+
+    // Each point goes to every cell whose extended box contains it. Only the
+    // occupied cells are stored, the grid itself can be far larger.
+    std::unordered_map<Eigen::Vector3i, std::vector<int>,
+                       utility::hash_eigen::hash<Eigen::Vector3i>>
+            cell_points;
+    std::vector<Eigen::Vector3i> cells;
+    for (size_t pidx = 0; pidx < pcd.points_.size(); ++pidx) {
+        const Eigen::Vector3d& p = pcd.points_[pidx];
+        Eigen::Vector3i lo, hi;
+        for (int axis = 0; axis < 3; ++axis) {
+            lo(axis) = CellCoordinate(p(axis) - margin, axis);
+            hi(axis) = CellCoordinate(p(axis) + margin, axis);
+        }
+        for (int z = lo(2); z <= hi(2); ++z) {
+            for (int y = lo(1); y <= hi(1); ++y) {
+                for (int x = lo(0); x <= hi(0); ++x) {
+                    cell_points[Eigen::Vector3i(x, y, z)].push_back(int(pidx));
+                }
+            }
+        }
+        cells.push_back(CellOf(p));
+    }
+    // The cells that contain a point, in z, y, x order so that the result
+    // does not depend on the hash map.
+    std::sort(cells.begin(), cells.end(),
+              [](const Eigen::Vector3i& a, const Eigen::Vector3i& b) {
+                  return std::make_tuple(a(2), a(1), a(0)) <
+                         std::make_tuple(b(2), b(1), b(0));
+              });
+    cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+
+    // Pivot every cell independently and keep the triangles it owns.
+    std::vector<std::vector<BallPivotingTriangle>> cell_triangles(
+            cells.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int i = 0; i < int(cells.size()); ++i) {
+        const std::vector<int>& indices = cell_points.at(cells[i]);
+        std::vector<Eigen::Vector3d> points(indices.size());
+        std::vector<Eigen::Vector3d> normals(indices.size());
+        for (size_t k = 0; k < indices.size(); ++k) {
+            points[k] = pcd.points_[indices[k]];
+            normals[k] = pcd.normals_[indices[k]];
+        }
+        BallPivoting bp(points, normals);
+        bp.Run(radii);
+        for (const BallPivotingTriangle& triangle : bp.triangles_) {
+            Eigen::Vector3d centroid =
+                    (points[triangle.vert0_] + points[triangle.vert1_] +
+                     points[triangle.vert2_]) /
+                    3.0;
+            if (CellOf(centroid) == cells[i]) {
+                cell_triangles[i].emplace_back(indices[triangle.vert0_],
+                                               indices[triangle.vert1_],
+                                               indices[triangle.vert2_],
+                                               triangle.ball_center_);
+            }
+        }
+    }
+
+    // Merge the cells and close the seams between them.
+    BallPivoting bp(pcd.points_, pcd.normals_);
+    for (const auto& triangles : cell_triangles) {
+        for (const BallPivotingTriangle& triangle : triangles) {
+            bp.AddTriangle(triangle.vert0_, triangle.vert1_, triangle.vert2_,
+                           triangle.ball_center_);
+        }
+    }
+    bp.Stitch(radii);
+    mesh->triangles_ = std::move(bp.mesh_triangles_);
+    mesh->triangle_normals_ = std::move(bp.mesh_triangle_normals_);
+    return mesh;
 }
 
 }  // namespace geometry
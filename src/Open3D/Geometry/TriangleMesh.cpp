@@ -38,6 +38,7 @@
 #include <tuple>
 
 #include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Helper.h"
 
 namespace open3d {
 namespace geometry {
@@ -697,39 +698,75 @@ std::shared_ptr<PointCloud> TriangleMesh::SamplePointsPoissonDisk(
     return pcl;
 }
 
+namespace {
+
+/// Keeps the elements of \param values at \param indices, in that order.
+template <typename T>
+void SelectElements(std::vector<T> &values, const std::vector<int> &indices) {
+    std::vector<T> selected(indices.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < int(indices.size()); ++i) {
+        selected[i] = values[indices[i]];
+    }
+    values.swap(selected);
+}
+
+void RemapTriangles(std::vector<Eigen::Vector3i> &triangles,
+                    const std::vector<int> &index_old_to_new) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < int(triangles.size()); ++i) {
+        Eigen::Vector3i &triangle = triangles[i];
+        triangle(0) = index_old_to_new[triangle(0)];
+        triangle(1) = index_old_to_new[triangle(1)];
+        triangle(2) = index_old_to_new[triangle(2)];
+    }
+}
+
+}  // unnamed namespace
+
 TriangleMesh &TriangleMesh::RemoveDuplicatedVertices() {
-    typedef std::tuple<double, double, double> Coordinate3;
-    std::unordered_map<Coordinate3, size_t,
-                       utility::hash_tuple::hash<Coordinate3>>
-            point_to_old_index;
-    std::vector<int> index_old_to_new(vertices_.size());
-    bool has_vert_normal = HasVertexNormals();
-    bool has_vert_color = HasVertexColors();
-    size_t old_vertex_num = vertices_.size();
-    size_t k = 0;                                  // new index
-    for (size_t i = 0; i < old_vertex_num; i++) {  // old index
-        Coordinate3 coord = std::make_tuple(vertices_[i](0), vertices_[i](1),
-                                            vertices_[i](2));
-        if (point_to_old_index.find(coord) == point_to_old_index.end()) {
-            point_to_old_index[coord] = i;
-            vertices_[k] = vertices_[i];
-            if (has_vert_normal) vertex_normals_[k] = vertex_normals_[i];
-            if (has_vert_color) vertex_colors_[k] = vertex_colors_[i];
-            index_old_to_new[i] = (int)k;
-            k++;
+    // The last element separates vertices with NaN coordinates, which are
+    // never equal to another vertex.
+    typedef std::tuple<double, double, double, int> Coordinate3;
+    int old_vertex_num = int(vertices_.size());
+    std::vector<Coordinate3> coords(old_vertex_num);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < old_vertex_num; i++) {
+        const Eigen::Vector3d &vertex = vertices_[i];
+        if (vertex.hasNaN()) {
+            coords[i] = std::make_tuple(0.0, 0.0, 0.0, i + 1);
         } else {
-            index_old_to_new[i] = index_old_to_new[point_to_old_index[coord]];
+            coords[i] = std::make_tuple(vertex(0), vertex(1), vertex(2), 0);
         }
     }
-    vertices_.resize(k);
-    if (has_vert_normal) vertex_normals_.resize(k);
-    if (has_vert_color) vertex_colors_.resize(k);
-    if (k < old_vertex_num) {
-        for (auto &triangle : triangles_) {
-            triangle(0) = index_old_to_new[triangle(0)];
-            triangle(1) = index_old_to_new[triangle(1)];
-            triangle(2) = index_old_to_new[triangle(2)];
+    std::vector<int> first = utility::FindFirstOccurrences(coords);
+
+    // Duplicates are mapped to the first vertex with the same coordinates,
+    // the remaining vertices keep their order.
+    std::vector<int> index_old_to_new(old_vertex_num);
+    std::vector<int> kept;
+    for (int i = 0; i < old_vertex_num; i++) {
+        if (first[i] == i) {
+            index_old_to_new[i] = int(kept.size());
+            kept.push_back(i);
+        } else {
+            index_old_to_new[i] = index_old_to_new[first[i]];
         }
+    }
+    int k = int(kept.size());
+    if (k < old_vertex_num) {
+        bool has_vert_normal = HasVertexNormals();
+        bool has_vert_color = HasVertexColors();
+        SelectElements(vertices_, kept);
+        if (has_vert_normal) SelectElements(vertex_normals_, kept);
+        if (has_vert_color) SelectElements(vertex_colors_, kept);
+        RemapTriangles(triangles_, index_old_to_new);
         if (HasAdjacencyList()) {
             ComputeAdjacencyList();
         }
@@ -743,12 +780,12 @@ TriangleMesh &TriangleMesh::RemoveDuplicatedVertices() {
 
 TriangleMesh &TriangleMesh::RemoveDuplicatedTriangles() {
     typedef std::tuple<int, int, int> Index3;
-    std::unordered_map<Index3, size_t, utility::hash_tuple::hash<Index3>>
-            triangle_to_old_index;
-    bool has_tri_normal = HasTriangleNormals();
-    size_t old_triangle_num = triangles_.size();
-    size_t k = 0;
-    for (size_t i = 0; i < old_triangle_num; i++) {
+    int old_triangle_num = int(triangles_.size());
+    std::vector<Index3> indices(old_triangle_num);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < old_triangle_num; i++) {
         Index3 index;
         // We first need to find the minimum index. Because triangle (0-1-2)
         // and triangle (2-0-1) are the same.
@@ -769,17 +806,24 @@ TriangleMesh &TriangleMesh::RemoveDuplicatedTriangles() {
                                         triangles_[i](1));
             }
         }
-        if (triangle_to_old_index.find(index) == triangle_to_old_index.end()) {
-            triangle_to_old_index[index] = i;
-            triangles_[k] = triangles_[i];
-            if (has_tri_normal) triangle_normals_[k] = triangle_normals_[i];
-            k++;
+        indices[i] = index;
+    }
+    std::vector<int> first = utility::FindFirstOccurrences(indices);
+
+    std::vector<int> kept;
+    for (int i = 0; i < old_triangle_num; i++) {
+        if (first[i] == i) {
+            kept.push_back(i);
         }
     }
-    triangles_.resize(k);
-    if (has_tri_normal) triangle_normals_.resize(k);
-    if (k < old_triangle_num && HasAdjacencyList()) {
-        ComputeAdjacencyList();
+    int k = int(kept.size());
+    if (k < old_triangle_num) {
+        bool has_tri_normal = HasTriangleNormals();
+        SelectElements(triangles_, kept);
+        if (has_tri_normal) SelectElements(triangle_normals_, kept);
+        if (HasAdjacencyList()) {
+            ComputeAdjacencyList();
+        }
     }
     utility::LogDebug(
             "[RemoveDuplicatedTriangles] {:d} triangles have been removed.\n",
@@ -795,31 +839,25 @@ TriangleMesh &TriangleMesh::RemoveUnreferencedVertices() {
         vertex_has_reference[triangle(1)] = true;
         vertex_has_reference[triangle(2)] = true;
     }
-    std::vector<int> index_old_to_new(vertices_.size());
-    bool has_vert_normal = HasVertexNormals();
-    bool has_vert_color = HasVertexColors();
-    size_t old_vertex_num = vertices_.size();
-    size_t k = 0;                                  // new index
-    for (size_t i = 0; i < old_vertex_num; i++) {  // old index
+    int old_vertex_num = int(vertices_.size());
+    std::vector<int> index_old_to_new(old_vertex_num);
+    std::vector<int> kept;
+    for (int i = 0; i < old_vertex_num; i++) {
         if (vertex_has_reference[i]) {
-            vertices_[k] = vertices_[i];
-            if (has_vert_normal) vertex_normals_[k] = vertex_normals_[i];
-            if (has_vert_color) vertex_colors_[k] = vertex_colors_[i];
-            index_old_to_new[i] = (int)k;
-            k++;
+            index_old_to_new[i] = int(kept.size());
+            kept.push_back(i);
         } else {
             index_old_to_new[i] = -1;
         }
     }
-    vertices_.resize(k);
-    if (has_vert_normal) vertex_normals_.resize(k);
-    if (has_vert_color) vertex_colors_.resize(k);
+    int k = int(kept.size());
     if (k < old_vertex_num) {
-        for (auto &triangle : triangles_) {
-            triangle(0) = index_old_to_new[triangle(0)];
-            triangle(1) = index_old_to_new[triangle(1)];
-            triangle(2) = index_old_to_new[triangle(2)];
-        }
+        bool has_vert_normal = HasVertexNormals();
+        bool has_vert_color = HasVertexColors();
+        SelectElements(vertices_, kept);
+        if (has_vert_normal) SelectElements(vertex_normals_, kept);
+        if (has_vert_color) SelectElements(vertex_colors_, kept);
+        RemapTriangles(triangles_, index_old_to_new);
         if (HasAdjacencyList()) {
             ComputeAdjacencyList();
         }
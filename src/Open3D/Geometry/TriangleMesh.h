@@ -352,9 +352,13 @@ public:
                     TriangleMesh::SimplificationContraction::Average) const;
 
     /// Function to simplify mesh using Quadric Error Metric Decimation by
-    /// Garland and Heckbert.
+    /// Garland and Heckbert. If \param parallel is true, the mesh is first
+    /// decimated in spatial cells in parallel, keeping the vertices on the
+    /// cell boundaries fixed, and only the rest of the triangles are
+    /// decimated in a serial pass. The result does not depend on the number
+    /// of threads.
     std::shared_ptr<TriangleMesh> SimplifyQuadricDecimation(
-            int target_number_of_triangles) const;
+            int target_number_of_triangles, bool parallel = false) const;
 
     /// Function to select points from \param input TriangleMesh into
     /// \return output TriangleMesh
@@ -380,6 +384,19 @@ public:
     static std::shared_ptr<TriangleMesh> CreateFromPointCloudBallPivoting(
             const PointCloud &pcd, const std::vector<double> &radii);
 
+    /// Parallel variant of CreateFromPointCloudBallPivoting. Space is divided
+    /// into cubic cells of edge length \param cell_size that are pivoted
+    /// independently, each together with the points within about three times
+    /// the largest radius of it. A cell keeps the triangles whose centroid it
+    /// contains and the seams between the cells are closed by pivoting the
+    /// ball over the remaining open edges. If \param cell_size is not
+    /// positive, it is chosen from the number of points. The result does not
+    /// depend on the number of threads.
+    static std::shared_ptr<TriangleMesh>
+    CreateFromPointCloudBallPivotingParallel(const PointCloud &pcd,
+                                             const std::vector<double> &radii,
+                                             double cell_size = 0.0);
+
     /// Factory function to create a tetrahedron mesh (trianglemeshfactory.cpp).
     /// the mesh centroid will be at (0,0,0) and \param radius defines the
     /// distance from the center to the mesh vertices.
@@ -27,10 +27,12 @@
 #include "Open3D/Geometry/TriangleMesh.h"
 
 #include <Eigen/Dense>
-#include <queue>
+#include <algorithm>
+#include <memory>
 #include <tuple>
 
 #include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Helper.h"
 
 namespace open3d {
 namespace geometry {
@@ -110,93 +112,108 @@ std::shared_ptr<TriangleMesh> TriangleMesh::SimplifyVertexClustering(
         return mesh;
     }
 
-    auto GetVoxelIdx = [&](const Eigen::Vector3d& vert) {
-        Eigen::Vector3d ref_coord = (vert - voxel_min_bound) / voxel_size;
-        Eigen::Vector3i idx(int(floor(ref_coord(0))), int(floor(ref_coord(1))),
-                            int(floor(ref_coord(2))));
-        return idx;
-    };
-
-    std::unordered_map<Eigen::Vector3i, std::unordered_set<int>,
-                       utility::hash_eigen::hash<Eigen::Vector3i>>
-            voxel_vertices;
-    std::unordered_map<Eigen::Vector3i, int,
-                       utility::hash_eigen::hash<Eigen::Vector3i>>
-            voxel_vert_ind;
-    int new_vidx = 0;
-    for (size_t vidx = 0; vidx < vertices_.size(); ++vidx) {
-        const Eigen::Vector3i vox_idx = GetVoxelIdx(vertices_[vidx]);
-        voxel_vertices[vox_idx].insert(int(vidx));
+    // Group the vertices by voxel. Voxels are numbered in the order of
+    // their first vertex.
+    typedef std::tuple<int, int, int> Index3;
+    const int n_vertices = int(vertices_.size());
+    std::vector<Index3> voxel_indices(n_vertices);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int vidx = 0; vidx < n_vertices; ++vidx) {
+        Eigen::Vector3d ref_coord =
+                (vertices_[vidx] - voxel_min_bound) / voxel_size;
+        voxel_indices[vidx] = std::make_tuple(int(floor(ref_coord(0))),
+                                              int(floor(ref_coord(1))),
+                                              int(floor(ref_coord(2))));
+    }
+    std::vector<int> first = utility::FindFirstOccurrences(voxel_indices);
+    std::vector<int> voxel_vert_ind(n_vertices);
+    std::vector<int> voxel_counts;
+    for (int vidx = 0; vidx < n_vertices; ++vidx) {
+        if (first[vidx] == vidx) {
+            voxel_vert_ind[vidx] = int(voxel_counts.size());
+            voxel_counts.push_back(0);
+        } else {
+            voxel_vert_ind[vidx] = voxel_vert_ind[first[vidx]];
+        }
+        voxel_counts[voxel_vert_ind[vidx]]++;
+    }
+    const int n_voxels = int(voxel_counts.size());
 
-        if (voxel_vert_ind.count(vox_idx) == 0) {
-            voxel_vert_ind[vox_idx] = new_vidx;
-            new_vidx++;
+    // List the vertices of every voxel in a single array
+    std::vector<int> voxel_begin(n_voxels + 1, 0);
+    for (int vox_vidx = 0; vox_vidx < n_voxels; ++vox_vidx) {
+        voxel_begin[vox_vidx + 1] =
+                voxel_begin[vox_vidx] + voxel_counts[vox_vidx];
+    }
+    std::vector<int> voxel_vertices(n_vertices);
+    {
+        std::vector<int> next(voxel_begin.begin(), voxel_begin.end() - 1);
+        for (int vidx = 0; vidx < n_vertices; ++vidx) {
+            voxel_vertices[next[voxel_vert_ind[vidx]]++] = vidx;
         }
     }
 
     // aggregate vertex info
     bool has_vert_normal = HasVertexNormals();
     bool has_vert_color = HasVertexColors();
-    mesh->vertices_.resize(voxel_vertices.size());
+    mesh->vertices_.resize(n_voxels);
     if (has_vert_normal) {
-        mesh->vertex_normals_.resize(voxel_vertices.size());
+        mesh->vertex_normals_.resize(n_voxels);
     }
     if (has_vert_color) {
-        mesh->vertex_colors_.resize(voxel_vertices.size());
+        mesh->vertex_colors_.resize(n_voxels);
     }
 
-    auto AvgVertex = [&](const std::unordered_set<int> ind) {
+    auto Avg = [&](const std::vector<Eigen::Vector3d>& values, int vox_vidx) {
         Eigen::Vector3d aggr(0, 0, 0);
-        for (int vidx : ind) {
-            aggr += vertices_[vidx];
+        for (int k = voxel_begin[vox_vidx]; k < voxel_begin[vox_vidx + 1];
+             ++k) {
+            aggr += values[voxel_vertices[k]];
         }
-        aggr /= double(ind.size());
-        return aggr;
-    };
-    auto AvgNormal = [&](const std::unordered_set<int> ind) {
-        Eigen::Vector3d aggr(0, 0, 0);
-        for (int vidx : ind) {
-            aggr += vertex_normals_[vidx];
-        }
-        aggr /= double(ind.size());
-        return aggr;
-    };
-    auto AvgColor = [&](const std::unordered_set<int> ind) {
-        Eigen::Vector3d aggr(0, 0, 0);
-        for (int vidx : ind) {
-            aggr += vertex_colors_[vidx];
-        }
-        aggr /= double(ind.size());
+        aggr /= double(voxel_begin[vox_vidx + 1] - voxel_begin[vox_vidx]);
         return aggr;
     };
 
-    if (contraction == TriangleMesh::SimplificationContraction::Average) {
-        for (const auto& voxel : voxel_vertices) {
-            int vox_vidx = voxel_vert_ind[voxel.first];
-            mesh->vertices_[vox_vidx] = AvgVertex(voxel.second);
-            if (has_vert_normal) {
-                mesh->vertex_normals_[vox_vidx] = AvgNormal(voxel.second);
-            }
-            if (has_vert_color) {
-                mesh->vertex_colors_[vox_vidx] = AvgColor(voxel.second);
-            }
+    // Map vertices to triangles
+    std::vector<int> vert_to_triangles_begin;
+    std::vector<int> vert_to_triangles;
+    if (contraction == TriangleMesh::SimplificationContraction::Quadric) {
+        vert_to_triangles_begin.assign(n_vertices + 1, 0);
+        for (const auto& triangle : triangles_) {
+            vert_to_triangles_begin[triangle(0) + 1]++;
+            vert_to_triangles_begin[triangle(1) + 1]++;
+            vert_to_triangles_begin[triangle(2) + 1]++;
         }
-    } else if (contraction ==
-               TriangleMesh::SimplificationContraction::Quadric) {
-        // Map triangles
-        std::unordered_map<int, std::unordered_set<int>> vert_to_triangles;
+        for (int vidx = 0; vidx < n_vertices; ++vidx) {
+            vert_to_triangles_begin[vidx + 1] += vert_to_triangles_begin[vidx];
+        }
+        vert_to_triangles.resize(3 * triangles_.size());
+        std::vector<int> next(vert_to_triangles_begin.begin(),
+                              vert_to_triangles_begin.end() - 1);
         for (size_t tidx = 0; tidx < triangles_.size(); ++tidx) {
-            vert_to_triangles[triangles_[tidx](0)].emplace(int(tidx));
-            vert_to_triangles[triangles_[tidx](1)].emplace(int(tidx));
-            vert_to_triangles[triangles_[tidx](2)].emplace(int(tidx));
+            vert_to_triangles[next[triangles_[tidx](0)]++] = int(tidx);
+            vert_to_triangles[next[triangles_[tidx](1)]++] = int(tidx);
+            vert_to_triangles[next[triangles_[tidx](2)]++] = int(tidx);
         }
+    }
 
-        for (const auto& voxel : voxel_vertices) {
-            int vox_vidx = voxel_vert_ind[voxel.first];
-
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int vox_vidx = 0; vox_vidx < n_voxels; ++vox_vidx) {
+        if (contraction == TriangleMesh::SimplificationContraction::Average) {
+            mesh->vertices_[vox_vidx] = Avg(vertices_, vox_vidx);
+        } else if (contraction ==
+                   TriangleMesh::SimplificationContraction::Quadric) {
             Quadric q;
-            for (int vidx : voxel.second) {
-                for (int tidx : vert_to_triangles[vidx]) {
+            for (int k = voxel_begin[vox_vidx]; k < voxel_begin[vox_vidx + 1];
+                 ++k) {
+                int vidx = voxel_vertices[k];
+                for (int i = vert_to_triangles_begin[vidx];
+                     i < vert_to_triangles_begin[vidx + 1]; ++i) {
+                    int tidx = vert_to_triangles[i];
                     Eigen::Vector4d p = GetTrianglePlane(tidx);
                     double area = GetTriangleArea(tidx);
                     q += Quadric(p, area);
@@ -206,29 +223,33 @@ std::shared_ptr<TriangleMesh> TriangleMesh::SimplifyVertexClustering(
                 Eigen::Vector3d v = q.Minimum();
                 mesh->vertices_[vox_vidx] = v;
             } else {
-                mesh->vertices_[vox_vidx] = AvgVertex(voxel.second);
+                mesh->vertices_[vox_vidx] = Avg(vertices_, vox_vidx);
             }
+        }
 
-            if (has_vert_normal) {
-                mesh->vertex_normals_[vox_vidx] = AvgNormal(voxel.second);
-            }
-            if (has_vert_color) {
-                mesh->vertex_colors_[vox_vidx] = AvgColor(voxel.second);
-            }
+        if (has_vert_normal) {
+            mesh->vertex_normals_[vox_vidx] = Avg(vertex_normals_, vox_vidx);
+        }
+        if (has_vert_color) {
+            mesh->vertex_colors_[vox_vidx] = Avg(vertex_colors_, vox_vidx);
         }
     }
 
     //  connect vertices
-    std::unordered_set<Eigen::Vector3i,
-                       utility::hash_eigen::hash<Eigen::Vector3i>>
-            triangles;
-    for (const auto& triangle : triangles_) {
-        int vidx0 = voxel_vert_ind[GetVoxelIdx(vertices_[triangle(0)])];
-        int vidx1 = voxel_vert_ind[GetVoxelIdx(vertices_[triangle(1)])];
-        int vidx2 = voxel_vert_ind[GetVoxelIdx(vertices_[triangle(2)])];
+    const int n_triangles = int(triangles_.size());
+    std::vector<Index3> triangles(n_triangles);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int tidx = 0; tidx < n_triangles; ++tidx) {
+        const Eigen::Vector3i& triangle = triangles_[tidx];
+        int vidx0 = voxel_vert_ind[triangle(0)];
+        int vidx1 = voxel_vert_ind[triangle(1)];
+        int vidx2 = voxel_vert_ind[triangle(2)];
 
         // only connect if in different voxels
         if (vidx0 == vidx1 || vidx0 == vidx2 || vidx1 == vidx2) {
+            triangles[tidx] = std::make_tuple(-1, -1, -1);
             continue;
         }
 
@@ -246,14 +267,17 @@ std::shared_ptr<TriangleMesh> TriangleMesh::SimplifyVertexClustering(
             vidx2 = tmp;
         }
 
-        triangles.emplace(Eigen::Vector3i(vidx0, vidx1, vidx2));
+        triangles[tidx] = std::make_tuple(vidx0, vidx1, vidx2);
     }
 
-    mesh->triangles_.resize(triangles.size());
-    int tidx = 0;
-    for (const Eigen::Vector3i& triangle : triangles) {
-        mesh->triangles_[tidx] = triangle;
-        tidx++;
+    // Keep the first of equal triangles
+    first = utility::FindFirstOccurrences(triangles);
+    for (int tidx = 0; tidx < n_triangles; ++tidx) {
+        if (first[tidx] == tidx && std::get<0>(triangles[tidx]) >= 0) {
+            mesh->triangles_.emplace_back(std::get<0>(triangles[tidx]),
+                                          std::get<1>(triangles[tidx]),
+                                          std::get<2>(triangles[tidx]));
+        }
     }
 
     if (HasTriangleNormals()) {
@@ -263,248 +287,682 @@ std::shared_ptr<TriangleMesh> TriangleMesh::SimplifyVertexClustering(
     return mesh;
 }
 
-std::shared_ptr<TriangleMesh> TriangleMesh::SimplifyQuadricDecimation(
-        int target_number_of_triangles) const {
-    typedef std::tuple<double, int, int> CostEdge;
+/// Binary min-heap of edge indices that supports updating and removing
+/// entries in place, so that no stale entries are kept.
+class EdgeHeap {
+public:
+    explicit EdgeHeap(size_t number_of_edges)
+        : costs_(number_of_edges), positions_(number_of_edges, -1) {}
 
-    auto mesh = std::make_shared<TriangleMesh>();
-    mesh->vertices_ = vertices_;
-    mesh->vertex_normals_ = vertex_normals_;
-    mesh->vertex_colors_ = vertex_colors_;
-    mesh->triangles_ = triangles_;
+    bool Empty() const { return heap_.empty(); }
 
-    std::vector<bool> vertices_deleted(vertices_.size(), false);
-    std::vector<bool> triangles_deleted(triangles_.size(), false);
+    bool Contains(int edge) const { return positions_[edge] >= 0; }
 
-    // Map vertices to triangles and compute triangle planes and areas
-    std::vector<std::unordered_set<int>> vert_to_triangles(vertices_.size());
-    std::vector<Eigen::Vector4d> triangle_planes(triangles_.size());
-    std::vector<double> triangle_areas(triangles_.size());
-    for (size_t tidx = 0; tidx < triangles_.size(); ++tidx) {
-        vert_to_triangles[triangles_[tidx](0)].emplace(tidx);
-        vert_to_triangles[triangles_[tidx](1)].emplace(tidx);
-        vert_to_triangles[triangles_[tidx](2)].emplace(tidx);
+    /// Inserts \param edge or changes its cost if it is already contained.
+    void Update(int edge, double cost) {
+        costs_[edge] = cost;
+        if (!Contains(edge)) {
+            positions_[edge] = int(heap_.size());
+            heap_.push_back(edge);
+        }
+        SiftDown(SiftUp(positions_[edge]));
+    }
 
-        triangle_planes[tidx] = GetTrianglePlane(tidx);
-        triangle_areas[tidx] = GetTriangleArea(tidx);
+    void Remove(int edge) {
+        int pos = positions_[edge];
+        if (pos < 0) {
+            return;
+        }
+        Swap(pos, int(heap_.size()) - 1);
+        heap_.pop_back();
+        positions_[edge] = -1;
+        if (pos < int(heap_.size())) {
+            SiftDown(SiftUp(pos));
+        }
     }
 
-    // Compute the error metric per vertex
-    std::vector<Quadric> Qs(vertices_.size());
-    for (size_t vidx = 0; vidx < vertices_.size(); ++vidx) {
-        for (int tidx : vert_to_triangles[vidx]) {
-            Qs[vidx] += Quadric(triangle_planes[tidx], triangle_areas[tidx]);
+    int Pop() {
+        int edge = heap_[0];
+        Remove(edge);
+        return edge;
+    }
+
+protected:
+    bool Less(int pos0, int pos1) const {
+        int edge0 = heap_[pos0];
+        int edge1 = heap_[pos1];
+        return costs_[edge0] < costs_[edge1] ||
+               (costs_[edge0] == costs_[edge1] && edge0 < edge1);
+    }
+
+    void Swap(int pos0, int pos1) {
+        std::swap(heap_[pos0], heap_[pos1]);
+        positions_[heap_[pos0]] = pos0;
+        positions_[heap_[pos1]] = pos1;
+    }
+
+    int SiftUp(int pos) {
+        while (pos > 0 && Less(pos, (pos - 1) / 2)) {
+            Swap(pos, (pos - 1) / 2);
+            pos = (pos - 1) / 2;
         }
+        return pos;
     }
 
-    // For boundary edges add perpendicular plane quadric
-    auto edge_triangle_count = GetEdgeToTrianglesMap();
-    auto AddPerpPlaneQuadric = [&](int vidx0, int vidx1, int vidx2,
-                                   double area) {
-        int min = std::min(vidx0, vidx1);
-        int max = std::max(vidx0, vidx1);
-        Eigen::Vector2i edge(min, max);
-        if (edge_triangle_count[edge].size() != 1) {
-            return;
+    void SiftDown(int pos) {
+        int size = int(heap_.size());
+        while (true) {
+            int min = pos;
+            int left = 2 * pos + 1;
+            int right = left + 1;
+            if (left < size && Less(left, min)) {
+                min = left;
+            }
+            if (right < size && Less(right, min)) {
+                min = right;
+            }
+            if (min == pos) {
+                return;
+            }
+            Swap(pos, min);
+            pos = min;
         }
-        const auto& vert0 = mesh->vertices_[vidx0];
-        const auto& vert1 = mesh->vertices_[vidx1];
-        const auto& vert2 = mesh->vertices_[vidx2];
-        Eigen::Vector3d vert2p = (vert2 - vert0).cross(vert2 - vert1);
-        Eigen::Vector4d plane = ComputeTrianglePlane(vert0, vert1, vert2p);
-        Quadric quad(plane, area);
-        Qs[vidx0] += quad;
-        Qs[vidx1] += quad;
-    };
-    for (size_t tidx = 0; tidx < triangles_.size(); ++tidx) {
-        const auto& tria = triangles_[tidx];
-        double area = triangle_areas[tidx];
-        AddPerpPlaneQuadric(tria(0), tria(1), tria(2), area);
-        AddPerpPlaneQuadric(tria(1), tria(2), tria(0), area);
-        AddPerpPlaneQuadric(tria(2), tria(0), tria(1), area);
     }
 
-    // Get valid edges and compute cost
-    // Note: We could also select all vertex pairs as edges with dist < eps
-    std::unordered_map<Eigen::Vector2i, Eigen::Vector3d,
-                       utility::hash_eigen::hash<Eigen::Vector2i>>
-            vbars;
-    std::unordered_map<Eigen::Vector2i, double,
-                       utility::hash_eigen::hash<Eigen::Vector2i>>
-            costs;
-    auto CostEdgeComp = [](const CostEdge& a, const CostEdge& b) {
-        return std::get<0>(a) > std::get<0>(b);
-    };
-    std::priority_queue<CostEdge, std::vector<CostEdge>, decltype(CostEdgeComp)>
-            queue(CostEdgeComp);
-
-    auto AddEdge = [&](int vidx0, int vidx1, bool update) {
-        int min = std::min(vidx0, vidx1);
-        int max = std::max(vidx0, vidx1);
-        Eigen::Vector2i edge(min, max);
-        if (update || vbars.count(edge) == 0) {
-            const Quadric& Q0 = Qs[min];
-            const Quadric& Q1 = Qs[max];
-            Quadric Qbar = Q0 + Q1;
-            double cost;
-            Eigen::Vector3d vbar;
-            if (Qbar.IsInvertible()) {
-                vbar = Qbar.Minimum();
-                cost = Qbar.Eval(vbar);
-            } else {
-                const Eigen::Vector3d& v0 = mesh->vertices_[vidx0];
-                const Eigen::Vector3d& v1 = mesh->vertices_[vidx0];
-                Eigen::Vector3d vmid = (v0 + v1) / 2;
-                double cost0 = Qbar.Eval(v0);
-                double cost1 = Qbar.Eval(v1);
-                double costmid = Qbar.Eval(vbar);
-                cost = std::min(cost0, std::min(cost1, costmid));
-                if (cost == costmid) {
-                    vbar = vmid;
-                } else if (cost == cost0) {
-                    vbar = v0;
-                } else {
-                    vbar = v1;
-                }
+protected:
+    std::vector<double> costs_;
+    std::vector<int> heap_;
+    std::vector<int> positions_;
+};
+
+/// Lists of indices per element stored in a single array. A list that grows
+/// is moved to the end of the array, which is compacted once more than half
+/// of it is unused.
+class FlatAdjacency {
+public:
+    /// Builds the lists from (element, index) pairs.
+    void Build(int number_of_elements,
+               const std::vector<std::pair<int, int>>& pairs) {
+        begin_.assign(number_of_elements + 1, 0);
+        for (const auto& pair : pairs) {
+            begin_[pair.first + 1]++;
+        }
+        for (int element = 0; element < number_of_elements; ++element) {
+            begin_[element + 1] += begin_[element];
+        }
+        size_.resize(number_of_elements);
+        for (int element = 0; element < number_of_elements; ++element) {
+            size_[element] = begin_[element + 1] - begin_[element];
+        }
+        indices_.resize(pairs.size());
+        std::vector<int> next(begin_.begin(), begin_.end() - 1);
+        for (const auto& pair : pairs) {
+            indices_[next[pair.first]++] = pair.second;
+        }
+        begin_.pop_back();
+        used_ = indices_.size();
+    }
+
+    const int* begin(int element) const {
+        return indices_.data() + begin_[element];
+    }
+    const int* end(int element) const {
+        return indices_.data() + begin_[element] + size_[element];
+    }
+
+    /// Replaces the list of \param element.
+    void Set(int element, const std::vector<int>& list) {
+        used_ += list.size();
+        used_ -= size_[element];
+        if (int(list.size()) <= size_[element]) {
+            std::copy(list.begin(), list.end(),
+                      indices_.begin() + begin_[element]);
+        } else {
+            if (indices_.size() + list.size() > 2 * used_) {
+                Compact();
             }
-            vbars[edge] = vbar;
-            costs[edge] = cost;
-            queue.push(CostEdge(cost, min, max));
+            begin_[element] = int(indices_.size());
+            indices_.insert(indices_.end(), list.begin(), list.end());
+        }
+        size_[element] = int(list.size());
+    }
+
+protected:
+    void Compact() {
+        std::vector<int> indices;
+        indices.reserve(2 * used_);
+        for (size_t element = 0; element < begin_.size(); ++element) {
+            int begin = int(indices.size());
+            indices.insert(indices.end(), indices_.begin() + begin_[element],
+                           indices_.begin() + begin_[element] + size_[element]);
+            begin_[element] = begin;
         }
+        indices_.swap(indices);
+    }
+
+protected:
+    std::vector<int> begin_;
+    std::vector<int> size_;
+    std::vector<int> indices_;
+    size_t used_ = 0;
+};
+
+/// Greedy edge collapse of a part of a triangle mesh. The vertices, vertex
+/// attributes, triangles and quadrics are shared with other parts that are
+/// decimated concurrently; a part only modifies the elements of its own
+/// triangles.
+class QuadricDecimation {
+public:
+    QuadricDecimation(TriangleMesh& mesh,
+                      std::vector<Quadric>& Qs,
+                      std::vector<char>& vertices_deleted,
+                      std::vector<char>& triangles_deleted,
+                      std::vector<int>& local_vertex,
+                      const std::vector<char>& vertices_locked)
+        : mesh_(mesh),
+          Qs_(Qs),
+          vertices_deleted_(vertices_deleted),
+          triangles_deleted_(triangles_deleted),
+          local_vertex_(local_vertex),
+          vertices_locked_(vertices_locked) {}
+
+    /// Collapses edges of \param triangles until at most \param
+    /// target_number_of_triangles of them are left. Edges with a locked
+    /// vertex are not collapsed. Returns the number of removed triangles.
+    int Run(const std::vector<int>& triangles, int target_number_of_triangles);
+
+protected:
+    class Edge {
+    public:
+        int vidx0_;
+        int vidx1_;
+        Eigen::Vector3d vbar_;
     };
 
-    // add all edges to priority queue
-    for (const auto& triangle : triangles_) {
-        AddEdge(triangle(0), triangle(1), false);
-        AddEdge(triangle(1), triangle(2), false);
-        AddEdge(triangle(2), triangle(0), false);
+    double ComputeCost(Edge& edge) const;
+    bool IsFlipped(int vidx0, int vidx1, const Eigen::Vector3d& vbar) const;
+    bool IsNonManifoldCollapse(int vidx0, int vidx1);
+    int Collapse(int eidx);
+
+    static bool HasVertex(const Eigen::Vector3i& tria, int vidx) {
+        return vidx == tria(0) || vidx == tria(1) || vidx == tria(2);
     }
 
-    // perform incremental edge collapse
-    bool has_vert_normal = HasVertexNormals();
-    bool has_vert_color = HasVertexColors();
-    int n_triangles = int(triangles_.size());
-    while (n_triangles > target_number_of_triangles && !queue.empty()) {
-        // retrieve edge from queue
-        double cost;
-        int vidx0, vidx1;
-        std::tie(cost, vidx0, vidx1) = queue.top();
-        queue.pop();
-
-        // test if the edge has been updated (reinserted into queue)
-        Eigen::Vector2i edge(vidx0, vidx1);
-        bool valid = !vertices_deleted[vidx0] && !vertices_deleted[vidx1] &&
-                     cost == costs[edge];
-        if (!valid) {
+protected:
+    TriangleMesh& mesh_;
+    std::vector<Quadric>& Qs_;
+    std::vector<char>& vertices_deleted_;
+    std::vector<char>& triangles_deleted_;
+    /// Index of a vertex in vertices_, -1 for vertices of other parts.
+    std::vector<int>& local_vertex_;
+    const std::vector<char>& vertices_locked_;
+
+    std::vector<int> vertices_;
+    std::vector<Edge> edges_;
+    std::vector<char> edges_deleted_;
+    FlatAdjacency vert_to_triangles_;
+    FlatAdjacency vert_to_edges_;
+    std::unique_ptr<EdgeHeap> heap_;
+    std::vector<int> list_;
+};
+
+double QuadricDecimation::ComputeCost(Edge& edge) const {
+    Quadric Qbar = Qs_[edge.vidx0_] + Qs_[edge.vidx1_];
+    if (Qbar.IsInvertible()) {
+        edge.vbar_ = Qbar.Minimum();
+        return Qbar.Eval(edge.vbar_);
+    }
+    const Eigen::Vector3d& v0 = mesh_.vertices_[edge.vidx0_];
+    const Eigen::Vector3d& v1 = mesh_.vertices_[edge.vidx1_];
+    Eigen::Vector3d vmid = (v0 + v1) / 2;
+    double cost0 = Qbar.Eval(v0);
+    double cost1 = Qbar.Eval(v1);
+    double costmid = Qbar.Eval(vmid);
+    double cost = std::min(cost0, std::min(cost1, costmid));
+    if (cost == costmid) {
+        edge.vbar_ = vmid;
+    } else if (cost == cost0) {
+        edge.vbar_ = v0;
+    } else {
+        edge.vbar_ = v1;
+    }
+    return cost;
+}
+
+bool QuadricDecimation::IsFlipped(int vidx0,
+                                  int vidx1,
+                                  const Eigen::Vector3d& vbar) const {
+    int lidx1 = local_vertex_[vidx1];
+    for (const int* tidx = vert_to_triangles_.begin(lidx1);
+         tidx != vert_to_triangles_.end(lidx1); ++tidx) {
+        if (triangles_deleted_[*tidx]) {
+            continue;
+        }
+        const Eigen::Vector3i& tria = mesh_.triangles_[*tidx];
+        if (HasVertex(tria, vidx0)) {
             continue;
         }
 
-        // avoid flip of triangle normal
-        bool flipped = false;
-        for (int tidx : vert_to_triangles[vidx1]) {
-            if (triangles_deleted[tidx]) {
-                continue;
-            }
+        Eigen::Vector3d vert0 = mesh_.vertices_[tria(0)];
+        Eigen::Vector3d vert1 = mesh_.vertices_[tria(1)];
+        Eigen::Vector3d vert2 = mesh_.vertices_[tria(2)];
+        Eigen::Vector3d norm_before = (vert1 - vert0).cross(vert2 - vert0);
+        norm_before /= norm_before.norm();
+
+        if (vidx1 == tria(0)) {
+            vert0 = vbar;
+        } else if (vidx1 == tria(1)) {
+            vert1 = vbar;
+        } else if (vidx1 == tria(2)) {
+            vert2 = vbar;
+        }
 
-            const Eigen::Vector3i& tria = mesh->triangles_[tidx];
-            bool has_vidx0 =
-                    vidx0 == tria(0) || vidx0 == tria(1) || vidx0 == tria(2);
-            bool has_vidx1 =
-                    vidx1 == tria(0) || vidx1 == tria(1) || vidx1 == tria(2);
-            if (has_vidx0 && has_vidx1) {
-                continue;
-            }
+        Eigen::Vector3d norm_after = (vert1 - vert0).cross(vert2 - vert0);
+        norm_after /= norm_after.norm();
+        if (norm_before.dot(norm_after) < 0) {
+            return true;
+        }
+    }
+    return false;
+}
 
-            Eigen::Vector3d vert0 = mesh->vertices_[tria(0)];
-            Eigen::Vector3d vert1 = mesh->vertices_[tria(1)];
-            Eigen::Vector3d vert2 = mesh->vertices_[tria(2)];
-            Eigen::Vector3d norm_before = (vert1 - vert0).cross(vert2 - vert0);
-            norm_before /= norm_before.norm();
-
-            if (vidx1 == tria(0)) {
-                vert0 = vbars[edge];
-            } else if (vidx1 == tria(1)) {
-                vert1 = vbars[edge];
-            } else if (vidx1 == tria(2)) {
-                vert2 = vbars[edge];
+bool QuadricDecimation::IsNonManifoldCollapse(int vidx0, int vidx1) {
+    // The vertices of the edge may only share the neighbours that are
+    // opposite to the edge, otherwise the collapse creates an edge with more
+    // than two triangles.
+    int lidx0 = local_vertex_[vidx0];
+    int lidx1 = local_vertex_[vidx1];
+    list_.clear();
+    int n_opposite = 0;
+    for (const int* tidx = vert_to_triangles_.begin(lidx0);
+         tidx != vert_to_triangles_.end(lidx0); ++tidx) {
+        if (triangles_deleted_[*tidx]) {
+            continue;
+        }
+        const Eigen::Vector3i& tria = mesh_.triangles_[*tidx];
+        if (HasVertex(tria, vidx1)) {
+            n_opposite++;
+        }
+        for (int k = 0; k < 3; ++k) {
+            if (tria(k) != vidx0 && tria(k) != vidx1) {
+                list_.push_back(tria(k));
             }
+        }
+    }
+    std::sort(list_.begin(), list_.end());
+    list_.erase(std::unique(list_.begin(), list_.end()), list_.end());
+    size_t n_neighbors0 = list_.size();
+    for (const int* tidx = vert_to_triangles_.begin(lidx1);
+         tidx != vert_to_triangles_.end(lidx1); ++tidx) {
+        if (triangles_deleted_[*tidx]) {
+            continue;
+        }
+        const Eigen::Vector3i& tria = mesh_.triangles_[*tidx];
+        for (int k = 0; k < 3; ++k) {
+            if (tria(k) != vidx0 && tria(k) != vidx1 &&
+                std::binary_search(list_.begin(),
+                                   list_.begin() + n_neighbors0, tria(k))) {
+                list_.push_back(tria(k));
+            }
+        }
+    }
+    std::sort(list_.begin() + n_neighbors0, list_.end());
+    int n_common = int(std::unique(list_.begin() + n_neighbors0, list_.end()) -
+                       (list_.begin() + n_neighbors0));
+    return n_common > n_opposite;
+}
 
-            Eigen::Vector3d norm_after = (vert1 - vert0).cross(vert2 - vert0);
-            norm_after /= norm_after.norm();
-            if (norm_before.dot(norm_after) < 0) {
-                flipped = true;
+int QuadricDecimation::Collapse(int eidx) {
+    // vidx1 is merged into vidx0
+    const int vidx0 = edges_[eidx].vidx0_;
+    const int vidx1 = edges_[eidx].vidx1_;
+    const int lidx0 = local_vertex_[vidx0];
+    const int lidx1 = local_vertex_[vidx1];
+
+    // Connect triangles from vidx1 to vidx0, or mark deleted
+    int n_deleted = 0;
+    list_.clear();
+    for (const int* tidx = vert_to_triangles_.begin(lidx0);
+         tidx != vert_to_triangles_.end(lidx0); ++tidx) {
+        if (!triangles_deleted_[*tidx] &&
+            !HasVertex(mesh_.triangles_[*tidx], vidx1)) {
+            list_.push_back(*tidx);
+        }
+    }
+    for (const int* tidx = vert_to_triangles_.begin(lidx1);
+         tidx != vert_to_triangles_.end(lidx1); ++tidx) {
+        if (triangles_deleted_[*tidx]) {
+            continue;
+        }
+        Eigen::Vector3i& tria = mesh_.triangles_[*tidx];
+        if (HasVertex(tria, vidx0)) {
+            triangles_deleted_[*tidx] = true;
+            n_deleted++;
+            continue;
+        }
+        if (vidx1 == tria(0)) {
+            tria(0) = vidx0;
+        } else if (vidx1 == tria(1)) {
+            tria(1) = vidx0;
+        } else if (vidx1 == tria(2)) {
+            tria(2) = vidx0;
+        }
+        list_.push_back(*tidx);
+    }
+    vert_to_triangles_.Set(lidx0, list_);
+
+    // update vertex vidx0 to vbar
+    mesh_.vertices_[vidx0] = edges_[eidx].vbar_;
+    Qs_[vidx0] += Qs_[vidx1];
+    if (mesh_.HasVertexNormals()) {
+        mesh_.vertex_normals_[vidx0] = 0.5 * (mesh_.vertex_normals_[vidx0] +
+                                              mesh_.vertex_normals_[vidx1]);
+    }
+    if (mesh_.HasVertexColors()) {
+        mesh_.vertex_colors_[vidx0] = 0.5 * (mesh_.vertex_colors_[vidx0] +
+                                             mesh_.vertex_colors_[vidx1]);
+    }
+    vertices_deleted_[vidx1] = true;
+
+    // Move the edges of vidx1 to vidx0, dropping the ones vidx0 already has
+    edges_deleted_[eidx] = true;
+    list_.clear();
+    for (const int* e = vert_to_edges_.begin(lidx0);
+         e != vert_to_edges_.end(lidx0); ++e) {
+        if (!edges_deleted_[*e]) {
+            list_.push_back(*e);
+        }
+    }
+    size_t n_edges0 = list_.size();
+    for (const int* e = vert_to_edges_.begin(lidx1);
+         e != vert_to_edges_.end(lidx1); ++e) {
+        if (edges_deleted_[*e]) {
+            continue;
+        }
+        Edge& edge = edges_[*e];
+        int other = edge.vidx0_ == vidx1 ? edge.vidx1_ : edge.vidx0_;
+        bool duplicate = false;
+        for (size_t k = 0; k < n_edges0; ++k) {
+            const Edge& edge0 = edges_[list_[k]];
+            if (edge0.vidx0_ == other || edge0.vidx1_ == other) {
+                duplicate = true;
                 break;
             }
         }
-        if (flipped) {
+        if (duplicate) {
+            edges_deleted_[*e] = true;
+            heap_->Remove(*e);
             continue;
         }
+        edge.vidx0_ = std::min(vidx0, other);
+        edge.vidx1_ = std::max(vidx0, other);
+        list_.push_back(*e);
+    }
+    vert_to_edges_.Set(lidx0, list_);
 
-        // Connect triangles from vidx1 to vidx0, or mark deleted
-        for (int tidx : vert_to_triangles[vidx1]) {
-            if (triangles_deleted[tidx]) {
-                continue;
-            }
-
-            Eigen::Vector3i& tria = mesh->triangles_[tidx];
-            bool has_vidx0 =
-                    vidx0 == tria(0) || vidx0 == tria(1) || vidx0 == tria(2);
-            bool has_vidx1 =
-                    vidx1 == tria(0) || vidx1 == tria(1) || vidx1 == tria(2);
+    // Update edge costs for all edges connecting to vidx0
+    for (int e : list_) {
+        heap_->Update(e, ComputeCost(edges_[e]));
+    }
+    return n_deleted;
+}
 
-            if (has_vidx0 && has_vidx1) {
-                triangles_deleted[tidx] = true;
-                n_triangles--;
-                continue;
+int QuadricDecimation::Run(const std::vector<int>& triangles,
+                           int target_number_of_triangles) {
+    // Number the vertices of the part and link them to their triangles
+    std::vector<std::pair<int, int>> pairs;
+    pairs.reserve(3 * triangles.size());
+    for (int tidx : triangles) {
+        const Eigen::Vector3i& tria = mesh_.triangles_[tidx];
+        for (int k = 0; k < 3; ++k) {
+            if (local_vertex_[tria(k)] < 0) {
+                local_vertex_[tria(k)] = int(vertices_.size());
+                vertices_.push_back(tria(k));
             }
+            pairs.emplace_back(local_vertex_[tria(k)], tidx);
+        }
+    }
+    vert_to_triangles_.Build(int(vertices_.size()), pairs);
 
-            if (vidx1 == tria(0)) {
-                tria(0) = vidx0;
-            } else if (vidx1 == tria(1)) {
-                tria(1) = vidx0;
-            } else if (vidx1 == tria(2)) {
-                tria(2) = vidx0;
+    // Get unique edges between unlocked vertices
+    // Note: We could also select all vertex pairs as edges with dist < eps
+    std::vector<std::pair<int, int>> edges;
+    edges.reserve(3 * triangles.size());
+    for (int tidx : triangles) {
+        const Eigen::Vector3i& tria = mesh_.triangles_[tidx];
+        for (int k = 0; k < 3; ++k) {
+            int vidx0 = tria(k);
+            int vidx1 = tria((k + 1) % 3);
+            if (!vertices_locked_[vidx0] && !vertices_locked_[vidx1]) {
+                edges.emplace_back(std::min(vidx0, vidx1),
+                                   std::max(vidx0, vidx1));
             }
-            vert_to_triangles[vidx0].insert(tidx);
         }
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    edges_.resize(edges.size());
+    edges_deleted_.assign(edges.size(), false);
+    heap_.reset(new EdgeHeap(edges.size()));
+    pairs.clear();
+    for (size_t eidx = 0; eidx < edges.size(); ++eidx) {
+        edges_[eidx].vidx0_ = edges[eidx].first;
+        edges_[eidx].vidx1_ = edges[eidx].second;
+        heap_->Update(int(eidx), ComputeCost(edges_[eidx]));
+        pairs.emplace_back(local_vertex_[edges[eidx].first], int(eidx));
+        pairs.emplace_back(local_vertex_[edges[eidx].second], int(eidx));
+    }
+    vert_to_edges_.Build(int(vertices_.size()), pairs);
 
-        // update vertex vidx0 to vbar
-        mesh->vertices_[vidx0] = vbars[edge];
-        Qs[vidx0] += Qs[vidx1];
-        if (has_vert_normal) {
-            mesh->vertex_normals_[vidx0] = 0.5 * (mesh->vertex_normals_[vidx0] +
-                                                  mesh->vertex_normals_[vidx1]);
+    // perform incremental edge collapse
+    int n_triangles = int(triangles.size());
+    while (n_triangles > target_number_of_triangles && !heap_->Empty()) {
+        int eidx = heap_->Pop();
+        // avoid flip of triangle normal and non-manifold edges, the edge is
+        // reconsidered once its cost changes
+        if (IsFlipped(edges_[eidx].vidx0_, edges_[eidx].vidx1_,
+                      edges_[eidx].vbar_) ||
+            IsNonManifoldCollapse(edges_[eidx].vidx0_, edges_[eidx].vidx1_)) {
+            continue;
         }
-        if (has_vert_color) {
-            mesh->vertex_colors_[vidx0] = 0.5 * (mesh->vertex_colors_[vidx0] +
-                                                 mesh->vertex_colors_[vidx1]);
+        n_triangles -= Collapse(eidx);
+    }
+
+    for (int vidx : vertices_) {
+        local_vertex_[vidx] = -1;
+    }
+    return int(triangles.size()) - n_triangles;
+}
+
+std::shared_ptr<TriangleMesh> TriangleMesh::SimplifyQuadricDecimation(
+        int target_number_of_triangles, bool parallel /* = false */) const {
+    auto mesh = std::make_shared<TriangleMesh>();
+    mesh->vertices_ = vertices_;
+    mesh->vertex_normals_ = vertex_normals_;
+    mesh->vertex_colors_ = vertex_colors_;
+    mesh->triangles_ = triangles_;
+
+    const int n_vertices = int(vertices_.size());
+    const int n_triangles = int(triangles_.size());
+    std::vector<char> vertices_deleted(n_vertices, false);
+    std::vector<char> triangles_deleted(n_triangles, false);
+
+    // Map vertices to triangles and compute triangle planes and areas
+    std::vector<std::pair<int, int>> pairs(3 * triangles_.size());
+    std::vector<Eigen::Vector4d> triangle_planes(triangles_.size());
+    std::vector<double> triangle_areas(triangles_.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int tidx = 0; tidx < n_triangles; ++tidx) {
+        for (int k = 0; k < 3; ++k) {
+            pairs[3 * tidx + k] = std::make_pair(triangles_[tidx](k), tidx);
         }
-        vertices_deleted[vidx1] = true;
+        triangle_planes[tidx] = GetTrianglePlane(tidx);
+        triangle_areas[tidx] = GetTriangleArea(tidx);
+    }
+    FlatAdjacency vert_to_triangles;
+    vert_to_triangles.Build(n_vertices, pairs);
+    pairs = std::vector<std::pair<int, int>>();
+
+    // Compute the error metric per vertex. For boundary edges add a
+    // perpendicular plane quadric.
+    std::vector<Quadric> Qs(vertices_.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int vidx = 0; vidx < n_vertices; ++vidx) {
+        auto IsBoundaryEdge = [&](int vidx0, int vidx1) {
+            int count = 0;
+            for (const int* tidx = vert_to_triangles.begin(vidx0);
+                 tidx != vert_to_triangles.end(vidx0); ++tidx) {
+                const Eigen::Vector3i& tria = triangles_[*tidx];
+                if (vidx1 == tria(0) || vidx1 == tria(1) || vidx1 == tria(2)) {
+                    count++;
+                }
+            }
+            return count == 1;
+        };
+        for (const int* tidx = vert_to_triangles.begin(vidx);
+             tidx != vert_to_triangles.end(vidx); ++tidx) {
+            Qs[vidx] += Quadric(triangle_planes[*tidx], triangle_areas[*tidx]);
+        }
+        for (const int* tidx = vert_to_triangles.begin(vidx);
+             tidx != vert_to_triangles.end(vidx); ++tidx) {
+            const Eigen::Vector3i& tria = triangles_[*tidx];
+            for (int k = 0; k < 3; ++k) {
+                int vidx0 = tria(k);
+                int vidx1 = tria((k + 1) % 3);
+                if ((vidx0 != vidx && vidx1 != vidx) ||
+                    !IsBoundaryEdge(vidx0, vidx1)) {
+                    continue;
+                }
+                const auto& vert0 = vertices_[vidx0];
+                const auto& vert1 = vertices_[vidx1];
+                const auto& vert2 = vertices_[tria((k + 2) % 3)];
+                Eigen::Vector3d vert2p = (vert2 - vert0).cross(vert2 - vert1);
+                Eigen::Vector4d plane =
+                        ComputeTrianglePlane(vert0, vert1, vert2p);
+                Qs[vidx] += Quadric(plane, triangle_areas[*tidx]);
+            }
+        }
+    }
 
-        // Update edge costs for all triangles connecting to vidx0
-        for (const auto& tidx : vert_to_triangles[vidx0]) {
-            if (triangles_deleted[tidx]) {
-                continue;
+    std::vector<int> local_vertex(n_vertices, -1);
+    std::vector<char> vertices_locked(n_vertices, false);
+    int n_remaining = n_triangles;
+
+    if (parallel && n_triangles > target_number_of_triangles) {
+        // Decimate the triangles of every grid cell independently while the
+        // vertices of triangles that cross cells are locked. The second
+        // round uses a grid shifted by half a cell, so that most of the
+        // locked regions of the first round are decimated in parallel, too.
+        const int cells_per_axis = std::max(
+                1, int(std::ceil(std::sqrt(n_triangles / 200000.0))));
+        const Eigen::Vector3d min_bound = GetMinBound();
+        const double cell_size =
+                std::max((GetMaxBound() - min_bound).maxCoeff(), 1e-12) /
+                cells_per_axis;
+        const int resolution = cells_per_axis + 1;
+        std::vector<int> vertex_cells(n_vertices);
+        for (int round = 0; round < 2; ++round) {
+            const double offset = round * 0.5 * cell_size;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+            for (int vidx = 0; vidx < n_vertices; ++vidx) {
+                Eigen::Vector3i cell =
+                        ((mesh->vertices_[vidx] - min_bound).array() +
+                         offset)
+                                .cwiseQuotient(Eigen::Array3d::Constant(
+                                        cell_size))
+                                .floor()
+                                .cast<int>()
+                                .cwiseMax(0)
+                                .cwiseMin(resolution - 1);
+                vertex_cells[vidx] =
+                        cell(0) + resolution * (cell(1) + resolution * cell(2));
+                vertices_locked[vidx] = false;
             }
-            const Eigen::Vector3i& tria = mesh->triangles_[tidx];
-            if (tria(0) == vidx0 || tria(1) == vidx0) {
-                AddEdge(tria(0), tria(1), true);
+
+            std::vector<std::pair<int, int>> cell_triangles;
+            for (int tidx = 0; tidx < n_triangles; ++tidx) {
+                if (triangles_deleted[tidx]) {
+                    continue;
+                }
+                const Eigen::Vector3i& tria = mesh->triangles_[tidx];
+                int cell = vertex_cells[tria(0)];
+                if (vertex_cells[tria(1)] == cell &&
+                    vertex_cells[tria(2)] == cell) {
+                    cell_triangles.emplace_back(cell, tidx);
+                } else {
+                    vertices_locked[tria(0)] = true;
+                    vertices_locked[tria(1)] = true;
+                    vertices_locked[tria(2)] = true;
+                }
             }
-            if (tria(1) == vidx0 || tria(2) == vidx0) {
-                AddEdge(tria(1), tria(2), true);
+            FlatAdjacency cell_to_triangles;
+            cell_to_triangles.Build(resolution * resolution * resolution,
+                                    cell_triangles);
+
+            // Every cell is reduced by the ratio that is still required
+            const double ratio =
+                    double(target_number_of_triangles) / n_remaining;
+            int n_removed = 0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) reduction(+ : n_removed)
+#endif
+            for (int cell = 0; cell < resolution * resolution * resolution;
+                 ++cell) {
+                std::vector<int> triangles(cell_to_triangles.begin(cell),
+                                           cell_to_triangles.end(cell));
+                if (triangles.empty()) {
+                    continue;
+                }
+                // Triangles at the locked boundary can not be removed
+                int n_locked = 0;
+                for (int tidx : triangles) {
+                    const Eigen::Vector3i& tria = mesh->triangles_[tidx];
+                    if (vertices_locked[tria(0)] || vertices_locked[tria(1)] ||
+                        vertices_locked[tria(2)]) {
+                        n_locked++;
+                    }
+                }
+                QuadricDecimation decimation(*mesh, Qs, vertices_deleted,
+                                             triangles_deleted, local_vertex,
+                                             vertices_locked);
+                n_removed += decimation.Run(
+                        triangles,
+                        int(std::ceil(ratio * triangles.size())) + n_locked);
             }
-            if (tria(2) == vidx0 || tria(0) == vidx0) {
-                AddEdge(tria(2), tria(0), true);
+            n_remaining -= n_removed;
+        }
+        std::fill(vertices_locked.begin(), vertices_locked.end(), false);
+    }
+
+    // Decimate the remaining triangles at once
+    if (n_remaining > target_number_of_triangles) {
+        std::vector<int> triangles;
+        triangles.reserve(n_remaining);
+        for (int tidx = 0; tidx < n_triangles; ++tidx) {
+            if (!triangles_deleted[tidx]) {
+                triangles.push_back(tidx);
             }
         }
+        QuadricDecimation decimation(*mesh, Qs, vertices_deleted,
+                                     triangles_deleted, local_vertex,
+                                     vertices_locked);
+        decimation.Run(triangles, target_number_of_triangles);
     }
 
     // Apply changes to the triangle mesh
+    bool has_vert_normal = HasVertexNormals();
+    bool has_vert_color = HasVertexColors();
     int next_free = 0;
-    std::unordered_map<int, int> vert_remapping;
+    std::vector<int> vert_remapping(n_vertices, -1);
     for (size_t idx = 0; idx < mesh->vertices_.size(); ++idx) {
         if (!vertices_deleted[idx]) {
-            vert_remapping[int(idx)] = next_free;
+            vert_remapping[idx] = next_free;
             mesh->vertices_[next_free] = mesh->vertices_[idx];
             if (has_vert_normal) {
                 mesh->vertex_normals_[next_free] = mesh->vertex_normals_[idx];
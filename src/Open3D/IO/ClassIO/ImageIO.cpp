@@ -30,6 +30,7 @@
 
 #include "Open3D/Utility/Console.h"
 #include "Open3D/Utility/FileSystem.h"
+#include "Open3D/Utility/Profiler.h"
 
 namespace open3d {
 
@@ -66,6 +67,7 @@ std::shared_ptr<geometry::Image> CreateImageFromFile(
 }
 
 bool ReadImage(const std::string &filename, geometry::Image &image) {
+    OPEN3D_PROFILE_ZONE("ReadImage");
     std::string filename_ext =
             utility::filesystem::GetFileExtensionInLowerCase(filename);
     if (filename_ext.empty()) {
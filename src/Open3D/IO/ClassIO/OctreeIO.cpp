@@ -31,6 +31,7 @@
 #include "Open3D/IO/ClassIO/IJsonConvertibleIO.h"
 #include "Open3D/Utility/Console.h"
 #include "Open3D/Utility/FileSystem.h"
+#include "Open3D/Utility/Profiler.h"
 
 namespace open3d {
 namespace io {
@@ -59,6 +60,7 @@ std::shared_ptr<geometry::Octree> CreateOctreeFromFile(
 bool ReadOctree(const std::string &filename,
                 geometry::Octree &octree,
                 const std::string &format) {
+    OPEN3D_PROFILE_ZONE("ReadOctree");
     std::string filename_ext;
     if (format == "auto") {
         filename_ext =
@@ -31,6 +31,7 @@
 #include "Open3D/IO/ClassIO/IJsonConvertibleIO.h"
 #include "Open3D/Utility/Console.h"
 #include "Open3D/Utility/FileSystem.h"
+#include "Open3D/Utility/Profiler.h"
 
 namespace open3d {
 
@@ -82,6 +83,7 @@ CreatePinholeCameraTrajectoryFromFile(const std::string &filename) {
 
 bool ReadPinholeCameraTrajectory(const std::string &filename,
                                  camera::PinholeCameraTrajectory &trajectory) {
+    OPEN3D_PROFILE_ZONE("ReadPinholeCameraTrajectory");
     std::string filename_ext =
             utility::filesystem::GetFileExtensionInLowerCase(filename);
     if (filename_ext.empty()) {
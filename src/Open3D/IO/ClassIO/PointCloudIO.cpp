@@ -30,6 +30,7 @@
 
 #include "Open3D/Utility/Console.h"
 #include "Open3D/Utility/FileSystem.h"
+#include "Open3D/Utility/Profiler.h"
 
 namespace open3d {
 
@@ -81,6 +82,7 @@ bool ReadPointCloud(const std::string &filename,
                     bool remove_nan_points,
                     bool remove_infinite_points,
                     bool print_progress) {
+    OPEN3D_PROFILE_ZONE("ReadPointCloud");
     std::string filename_ext;
     if (format == "auto") {
         filename_ext =
@@ -31,6 +31,7 @@
 #include "Open3D/IO/ClassIO/IJsonConvertibleIO.h"
 #include "Open3D/Utility/Console.h"
 #include "Open3D/Utility/FileSystem.h"
+#include "Open3D/Utility/Profiler.h"
 
 namespace open3d {
 
@@ -74,6 +75,7 @@ std::shared_ptr<registration::PoseGraph> CreatePoseGraphFromFile(
 
 bool ReadPoseGraph(const std::string &filename,
                    registration::PoseGraph &pose_graph) {
+    OPEN3D_PROFILE_ZONE("ReadPoseGraph");
     std::string filename_ext =
             utility::filesystem::GetFileExtensionInLowerCase(filename);
     if (filename_ext.empty()) {
@@ -0,0 +1,148 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/IO/ClassIO/TSDFVolumeIO.h"
+
+#include <unordered_map>
+
+#include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/FileSystem.h"
+#include "Open3D/Utility/Profiler.h"
+
+namespace open3d {
+
+namespace {
+using namespace io;
+
+// The readers and writers are overloaded on the volume type, so the maps hold
+// plain function pointers, which pick the matching overload.
+static const std::unordered_map<
+        std::string,
+        bool (*)(const std::string &, integration::UniformTSDFVolume &)>
+        file_extension_to_uniform_tsdf_volume_read_function{
+                {"tsdf", ReadTSDFVolumeFromTSDF},
+        };
+
+static const std::unordered_map<
+        std::string,
+        bool (*)(const std::string &, integration::ScalableTSDFVolume &)>
+        file_extension_to_scalable_tsdf_volume_read_function{
+                {"tsdf", ReadTSDFVolumeFromTSDF},
+        };
+
+static const std::unordered_map<std::string,
+                                bool (*)(const std::string &,
+                                         const integration::UniformTSDFVolume &,
+                                         bool)>
+        file_extension_to_uniform_tsdf_volume_write_function{
+                {"tsdf", WriteTSDFVolumeToTSDF},
+        };
+
+static const std::unordered_map<
+        std::string,
+        bool (*)(const std::string &,
+                 const integration::ScalableTSDFVolume &,
+                 bool)>
+        file_extension_to_scalable_tsdf_volume_write_function{
+                {"tsdf", WriteTSDFVolumeToTSDF},
+        };
+
+template <typename FunctionMap>
+typename FunctionMap::mapped_type FindTSDFVolumeFunction(
+        const FunctionMap &function_map, const std::string &filename) {
+    std::string filename_ext =
+            utility::filesystem::GetFileExtensionInLowerCase(filename);
+    if (filename_ext.empty()) {
+        return nullptr;
+    }
+    auto map_itr = function_map.find(filename_ext);
+    if (map_itr == function_map.end()) {
+        return nullptr;
+    }
+    return map_itr->second;
+}
+}  // unnamed namespace
+
+namespace io {
+
+bool ReadTSDFVolume(const std::string &filename,
+                    integration::UniformTSDFVolume &volume) {
+    OPEN3D_PROFILE_ZONE("ReadTSDFVolume");
+    auto read_function = FindTSDFVolumeFunction(
+            file_extension_to_uniform_tsdf_volume_read_function, filename);
+    if (read_function == nullptr) {
+        utility::LogWarning(
+                "Read integration::UniformTSDFVolume failed: unknown file "
+                "extension.\n");
+        return false;
+    }
+    return read_function(filename, volume);
+}
+
+bool ReadTSDFVolume(const std::string &filename,
+                    integration::ScalableTSDFVolume &volume) {
+    OPEN3D_PROFILE_ZONE("ReadTSDFVolume");
+    auto read_function = FindTSDFVolumeFunction(
+            file_extension_to_scalable_tsdf_volume_read_function, filename);
+    if (read_function == nullptr) {
+        utility::LogWarning(
+                "Read integration::ScalableTSDFVolume failed: unknown file "
+                "extension.\n");
+        return false;
+    }
+    return read_function(filename, volume);
+}
+
+bool WriteTSDFVolume(const std::string &filename,
+                     const integration::UniformTSDFVolume &volume,
+                     bool compressed /* = true*/) {
+    auto write_function = FindTSDFVolumeFunction(
+            file_extension_to_uniform_tsdf_volume_write_function, filename);
+    if (write_function == nullptr) {
+        utility::LogWarning(
+                "Write integration::UniformTSDFVolume failed: unknown file "
+                "extension.\n");
+        return false;
+    }
+    return write_function(filename, volume, compressed);
+}
+
+bool WriteTSDFVolume(const std::string &filename,
+                     const integration::ScalableTSDFVolume &volume,
+                     bool compressed /* = true*/) {
+    auto write_function = FindTSDFVolumeFunction(
+            file_extension_to_scalable_tsdf_volume_write_function, filename);
+    if (write_function == nullptr) {
+        utility::LogWarning(
+                "Write integration::ScalableTSDFVolume failed: unknown file "
+                "extension.\n");
+        return false;
+    }
+    return write_function(filename, volume, compressed);
+}
+
+}  // namespace io
+}  // namespace open3d
@@ -0,0 +1,86 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <string>
+
+#include "Open3D/Integration/ScalableTSDFVolume.h"
+#include "Open3D/Integration/UniformTSDFVolume.h"
+
+namespace open3d {
+namespace io {
+
+/// The general entrance for reading a UniformTSDFVolume from a file. The
+/// parameters of \p volume are replaced by the ones in the file.
+/// \return If the read function is successful.
+bool ReadTSDFVolume(const std::string &filename,
+                    integration::UniformTSDFVolume &volume);
+
+/// The general entrance for reading a ScalableTSDFVolume from a file. The
+/// parameters of \p volume are replaced by the ones in the file, and all read
+/// volume units are in memory and dirty.
+/// \return If the read function is successful.
+bool ReadTSDFVolume(const std::string &filename,
+                    integration::ScalableTSDFVolume &volume);
+
+/// The general entrance for writing a UniformTSDFVolume to a file
+/// \param compressed Compress the voxel blocks with LZF.
+/// \return If the write function is successful.
+bool WriteTSDFVolume(const std::string &filename,
+                     const integration::UniformTSDFVolume &volume,
+                     bool compressed = true);
+
+/// The general entrance for writing a ScalableTSDFVolume, including paged
+/// volume units, to a file
+/// \param compressed Compress the voxel blocks with LZF.
+/// \return If the write function is successful.
+bool WriteTSDFVolume(const std::string &filename,
+                     const integration::ScalableTSDFVolume &volume,
+                     bool compressed = true);
+
+/// The TSDF file format stores a header with the volume parameters, an index
+/// of voxel blocks and the blocks. A block holds the observed voxels of an x
+/// slice of a UniformTSDFVolume or of a volume unit of a ScalableTSDFVolume;
+/// blocks without observed voxels are not stored. Blocks are encoded and
+/// compressed in parallel, and decoded in parallel from a memory mapping of
+/// the file.
+bool ReadTSDFVolumeFromTSDF(const std::string &filename,
+                            integration::UniformTSDFVolume &volume);
+
+bool ReadTSDFVolumeFromTSDF(const std::string &filename,
+                            integration::ScalableTSDFVolume &volume);
+
+bool WriteTSDFVolumeToTSDF(const std::string &filename,
+                           const integration::UniformTSDFVolume &volume,
+                           bool compressed = true);
+
+bool WriteTSDFVolumeToTSDF(const std::string &filename,
+                           const integration::ScalableTSDFVolume &volume,
+                           bool compressed = true);
+
+}  // namespace io
+}  // namespace open3d
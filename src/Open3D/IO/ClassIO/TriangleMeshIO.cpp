@@ -30,6 +30,7 @@
 
 #include "Open3D/Utility/Console.h"
 #include "Open3D/Utility/FileSystem.h"
+#include "Open3D/Utility/Profiler.h"
 
 namespace open3d {
 
@@ -81,6 +82,7 @@ std::shared_ptr<geometry::TriangleMesh> CreateMeshFromFile(
 bool ReadTriangleMesh(const std::string &filename,
                       geometry::TriangleMesh &mesh,
                       bool print_progress) {
+    OPEN3D_PROFILE_ZONE("ReadTriangleMesh");
     std::string filename_ext =
             utility::filesystem::GetFileExtensionInLowerCase(filename);
     if (filename_ext.empty()) {
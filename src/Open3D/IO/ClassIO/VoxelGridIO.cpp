@@ -30,6 +30,7 @@
 
 #include "Open3D/Utility/Console.h"
 #include "Open3D/Utility/FileSystem.h"
+#include "Open3D/Utility/Profiler.h"
 
 namespace open3d {
 
@@ -69,6 +70,7 @@ bool ReadVoxelGrid(const std::string &filename,
                    geometry::VoxelGrid &voxelgrid,
                    const std::string &format,
                    bool print_progress) {
+    OPEN3D_PROFILE_ZONE("ReadVoxelGrid");
     std::string filename_ext;
     if (format == "auto") {
         filename_ext =
@@ -25,13 +25,17 @@
 // ----------------------------------------------------------------------------
 
 #include <liblzf/lzf.h>
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <sstream>
 
 #include "Open3D/IO/ClassIO/PointCloudIO.h"
 #include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/FileSystem.h"
 #include "Open3D/Utility/Helper.h"
+#include "Open3D/Utility/TextParser.h"
 
 // References for PCD file IO
 // http://pointclouds.org/documentation/tutorials/pcd_file_format.php
@@ -233,53 +237,6 @@ bool ReadPCDHeader(FILE *file, PCDHeader &header) {
     return true;
 }
 
-double UnpackBinaryPCDElement(const char *data_ptr,
-                              const char type,
-                              const int size) {
-    if (type == 'I') {
-        if (size == 1) {
-            std::int8_t data;
-            memcpy(&data, data_ptr, sizeof(data));
-            return (double)data;
-        } else if (size == 2) {
-            std::int16_t data;
-            memcpy(&data, data_ptr, sizeof(data));
-            return (double)data;
-        } else if (size == 4) {
-            std::int32_t data;
-            memcpy(&data, data_ptr, sizeof(data));
-            return (double)data;
-        } else {
-            return 0.0;
-        }
-    } else if (type == 'U') {
-        if (size == 1) {
-            std::uint8_t data;
-            memcpy(&data, data_ptr, sizeof(data));
-            return (double)data;
-        } else if (size == 2) {
-            std::uint16_t data;
-            memcpy(&data, data_ptr, sizeof(data));
-            return (double)data;
-        } else if (size == 4) {
-            std::uint32_t data;
-            memcpy(&data, data_ptr, sizeof(data));
-            return (double)data;
-        } else {
-            return 0.0;
-        }
-    } else if (type == 'F') {
-        if (size == 4) {
-            std::float_t data;
-            memcpy(&data, data_ptr, sizeof(data));
-            return (double)data;
-        } else {
-            return 0.0;
-        }
-    }
-    return 0.0;
-}
-
 Eigen::Vector3d UnpackBinaryPCDColor(const char *data_ptr,
                                      const char type,
                                      const int size) {
@@ -294,34 +251,80 @@ Eigen::Vector3d UnpackBinaryPCDColor(const char *data_ptr,
     }
 }
 
-double UnpackASCIIPCDElement(const char *data_ptr,
+/// Parses a plain decimal integer as strtol and strtoul with base 0 would.
+/// Returns false for anything else, e.g. octal and hexadecimal numbers.
+bool ParseASCIIPCDDecimal(const char *begin, const char *end, long &value) {
+    bool negative = false;
+    if (begin < end && *begin == '-') {
+        negative = true;
+        begin++;
+    }
+    if (begin == end || end - begin > 9 || (*begin == '0' && end - begin > 1)) {
+        return false;
+    }
+    value = 0;
+    for (const char *ptr = begin; ptr < end; ptr++) {
+        if (*ptr < '0' || *ptr > '9') {
+            return false;
+        }
+        value = value * 10 + (*ptr - '0');
+    }
+    if (negative) {
+        value = -value;
+    }
+    return true;
+}
+
+long ParseASCIIPCDSigned(const char *begin, const char *end) {
+    long value;
+    if (ParseASCIIPCDDecimal(begin, end, value)) {
+        return value;
+    }
+    char *str_end;
+    return std::strtol(std::string(begin, end).c_str(), &str_end, 0);
+}
+
+unsigned long ParseASCIIPCDUnsigned(const char *begin, const char *end) {
+    long value;
+    if (ParseASCIIPCDDecimal(begin, end, value) && value >= 0) {
+        return (unsigned long)value;
+    }
+    char *str_end;
+    return std::strtoul(std::string(begin, end).c_str(), &str_end, 0);
+}
+
+double UnpackASCIIPCDElement(const char *begin,
+                             const char *end,
                              const char type,
                              const int size) {
-    char *end;
     if (type == 'I') {
-        return (double)std::strtol(data_ptr, &end, 0);
+        return (double)ParseASCIIPCDSigned(begin, end);
     } else if (type == 'U') {
-        return (double)std::strtoul(data_ptr, &end, 0);
+        return (double)ParseASCIIPCDUnsigned(begin, end);
     } else if (type == 'F') {
-        return std::strtod(data_ptr, &end);
+        double value;
+        return utility::ParseNumber(begin, end, value) ? value : 0.0;
     }
     return 0.0;
 }
 
-Eigen::Vector3d UnpackASCIIPCDColor(const char *data_ptr,
+Eigen::Vector3d UnpackASCIIPCDColor(const char *begin,
+                                    const char *end,
                                     const char type,
                                     const int size) {
     if (size == 4) {
         std::uint8_t data[4] = {0, 0, 0, 0};
-        char *end;
         if (type == 'I') {
-            std::int32_t value = std::strtol(data_ptr, &end, 0);
+            std::int32_t value = ParseASCIIPCDSigned(begin, end);
             memcpy(data, &value, 4);
         } else if (type == 'U') {
-            std::uint32_t value = std::strtoul(data_ptr, &end, 0);
+            std::uint32_t value = ParseASCIIPCDUnsigned(begin, end);
             memcpy(data, &value, 4);
         } else if (type == 'F') {
-            std::float_t value = std::strtof(data_ptr, &end);
+            std::float_t value;
+            if (!utility::ParseNumber(begin, end, value)) {
+                value = 0.0f;
+            }
             memcpy(data, &value, 4);
         }
         return Eigen::Vector3d((double)data[2] / 255.0, (double)data[1] / 255.0,
@@ -331,7 +334,252 @@ Eigen::Vector3d UnpackASCIIPCDColor(const char *data_ptr,
     }
 }
 
+/// The fields Open3D reads from one line of ascii data.
+struct PCDASCIIPoint {
+    Eigen::Vector3d point;
+    Eigen::Vector3d normal;
+    Eigen::Vector3d color;
+};
+
+/// Where a token of a line of ascii data is stored.
+enum class PCDASCIITarget {
+    Ignored,
+    PointX,
+    PointY,
+    PointZ,
+    NormalX,
+    NormalY,
+    NormalZ,
+    Color,
+};
+
+struct PCDASCIIToken {
+    PCDASCIITarget target;
+    char type;
+    int size;
+};
+
+/// Returns the target of every token of a line of ascii data.
+std::vector<PCDASCIIToken> GetPCDASCIITokens(const PCDHeader &header) {
+    std::vector<PCDASCIIToken> tokens(header.elementnum,
+                                      {PCDASCIITarget::Ignored, 0, 0});
+    for (const auto &field : header.fields) {
+        if (field.count_offset >= header.elementnum) {
+            continue;
+        }
+        PCDASCIIToken &token = tokens[field.count_offset];
+        token.type = field.type;
+        token.size = field.size;
+        if (field.name == "x") {
+            token.target = PCDASCIITarget::PointX;
+        } else if (field.name == "y") {
+            token.target = PCDASCIITarget::PointY;
+        } else if (field.name == "z") {
+            token.target = PCDASCIITarget::PointZ;
+        } else if (field.name == "normal_x") {
+            token.target = PCDASCIITarget::NormalX;
+        } else if (field.name == "normal_y") {
+            token.target = PCDASCIITarget::NormalY;
+        } else if (field.name == "normal_z") {
+            token.target = PCDASCIITarget::NormalZ;
+        } else if (field.name == "rgb" || field.name == "rgba") {
+            token.target = PCDASCIITarget::Color;
+        }
+    }
+    return tokens;
+}
+
+inline bool IsPCDDelimiter(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+/// Parses a line of ascii data. Returns false for lines with less than
+/// tokens.size() tokens.
+bool ParseASCIIPCDLine(const std::vector<PCDASCIIToken> &tokens,
+                       const char *ptr,
+                       const char *line_end,
+                       PCDASCIIPoint &record) {
+    record.point.setZero();
+    record.normal.setZero();
+    record.color.setZero();
+    for (const auto &token : tokens) {
+        while (ptr < line_end && IsPCDDelimiter(*ptr)) {
+            ptr++;
+        }
+        if (ptr == line_end) {
+            return false;
+        }
+        const char *begin = ptr;
+        while (ptr < line_end && !IsPCDDelimiter(*ptr)) {
+            ptr++;
+        }
+        switch (token.target) {
+            case PCDASCIITarget::Ignored:
+                break;
+            case PCDASCIITarget::PointX:
+            case PCDASCIITarget::PointY:
+            case PCDASCIITarget::PointZ:
+                record.point(int(token.target) - int(PCDASCIITarget::PointX)) =
+                        UnpackASCIIPCDElement(begin, ptr, token.type,
+                                              token.size);
+                break;
+            case PCDASCIITarget::NormalX:
+            case PCDASCIITarget::NormalY:
+            case PCDASCIITarget::NormalZ:
+                record.normal(int(token.target) -
+                              int(PCDASCIITarget::NormalX)) =
+                        UnpackASCIIPCDElement(begin, ptr, token.type,
+                                              token.size);
+                break;
+            case PCDASCIITarget::Color:
+                record.color = UnpackASCIIPCDColor(begin, ptr, token.type,
+                                                   token.size);
+                break;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+void DecodePCDField(const char *base,
+                    size_t stride,
+                    int num_points,
+                    int component,
+                    std::vector<Eigen::Vector3d> &values) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < num_points; i++) {
+        T value;
+        memcpy(&value, base + size_t(i) * stride, sizeof(T));
+        values[i](component) = (double)value;
+    }
+}
+
+/// Decodes \p field of \p num_points points into the component
+/// \p component of \p values. The values of consecutive points are
+/// \p stride bytes apart, which covers both the interleaved layout of binary
+/// data and the columnar layout of compressed data.
+void DecodePCDField(const PCLPointField &field,
+                    const char *base,
+                    size_t stride,
+                    int num_points,
+                    int component,
+                    std::vector<Eigen::Vector3d> &values) {
+    if (field.type == 'I' && field.size == 1) {
+        DecodePCDField<std::int8_t>(base, stride, num_points, component,
+                                    values);
+    } else if (field.type == 'I' && field.size == 2) {
+        DecodePCDField<std::int16_t>(base, stride, num_points, component,
+                                     values);
+    } else if (field.type == 'I' && field.size == 4) {
+        DecodePCDField<std::int32_t>(base, stride, num_points, component,
+                                     values);
+    } else if (field.type == 'U' && field.size == 1) {
+        DecodePCDField<std::uint8_t>(base, stride, num_points, component,
+                                     values);
+    } else if (field.type == 'U' && field.size == 2) {
+        DecodePCDField<std::uint16_t>(base, stride, num_points, component,
+                                      values);
+    } else if (field.type == 'U' && field.size == 4) {
+        DecodePCDField<std::uint32_t>(base, stride, num_points, component,
+                                      values);
+    } else if (field.type == 'F' && field.size == 4) {
+        DecodePCDField<float>(base, stride, num_points, component, values);
+    } else if (field.type == 'F' && field.size == 8) {
+        DecodePCDField<double>(base, stride, num_points, component, values);
+    } else {
+        for (int i = 0; i < num_points; i++) {
+            values[i](component) = 0.0;
+        }
+    }
+}
+
+void DecodePCDColorField(const PCLPointField &field,
+                         const char *base,
+                         size_t stride,
+                         int num_points,
+                         std::vector<Eigen::Vector3d> &colors) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < num_points; i++) {
+        colors[i] = UnpackBinaryPCDColor(base + size_t(i) * stride, field.type,
+                                         field.size);
+    }
+}
+
+/// Decodes the fields Open3D uses from a block of binary data. Points are
+/// interleaved in binary data, compressed data stores every field as a
+/// contiguous column.
+void DecodePCDFields(const PCDHeader &header,
+                     const char *data,
+                     bool columnar,
+                     geometry::PointCloud &pointcloud) {
+    for (const auto &field : header.fields) {
+        const char *base;
+        size_t stride;
+        if (columnar) {
+            base = data + size_t(field.offset) * size_t(header.points);
+            stride = size_t(field.size * field.count);
+        } else {
+            base = data + field.offset;
+            stride = size_t(header.pointsize);
+        }
+        if (field.name == "x") {
+            DecodePCDField(field, base, stride, header.points, 0,
+                           pointcloud.points_);
+        } else if (field.name == "y") {
+            DecodePCDField(field, base, stride, header.points, 1,
+                           pointcloud.points_);
+        } else if (field.name == "z") {
+            DecodePCDField(field, base, stride, header.points, 2,
+                           pointcloud.points_);
+        } else if (field.name == "normal_x") {
+            DecodePCDField(field, base, stride, header.points, 0,
+                           pointcloud.normals_);
+        } else if (field.name == "normal_y") {
+            DecodePCDField(field, base, stride, header.points, 1,
+                           pointcloud.normals_);
+        } else if (field.name == "normal_z") {
+            DecodePCDField(field, base, stride, header.points, 2,
+                           pointcloud.normals_);
+        } else if (field.name == "rgb" || field.name == "rgba") {
+            DecodePCDColorField(field, base, stride, header.points,
+                                pointcloud.colors_);
+        }
+    }
+}
+
+/// Returns \p size bytes of \p filename starting at the current position of
+/// \p file. The bytes come from \p mapped_file if the file can be mapped and
+/// are read into \p buffer with a single call otherwise. Returns nullptr if
+/// the file is too short.
+const char *ReadPCDBlock(FILE *file,
+                         const std::string &filename,
+                         size_t size,
+                         utility::filesystem::MappedFile &mapped_file,
+                         std::vector<char> &buffer) {
+    long position = ftell(file);
+    if (position < 0) {
+        return nullptr;
+    }
+    if (mapped_file.IsOpen() || mapped_file.Open(filename)) {
+        if (size_t(position) + size > mapped_file.GetSize()) {
+            return nullptr;
+        }
+        fseek(file, long(size_t(position) + size), SEEK_SET);
+        return mapped_file.GetData() + position;
+    }
+    buffer.resize(size);
+    if (fread(buffer.data(), 1, size, file) != size) {
+        return nullptr;
+    }
+    return buffer.data();
+}
+
 bool ReadPCDData(FILE *file,
+                 const std::string &filename,
                  const PCDHeader &header,
                  geometry::PointCloud &pointcloud) {
     // The header should have been checked
@@ -349,91 +597,51 @@ bool ReadPCDData(FILE *file,
         pointcloud.colors_.resize(header.points);
     }
     if (header.datatype == PCD_DATA_ASCII) {
-        char line_buffer[DEFAULT_IO_BUFFER_SIZE];
-        int idx = 0;
-        while (fgets(line_buffer, DEFAULT_IO_BUFFER_SIZE, file) &&
-               idx < header.points) {
-            std::string line(line_buffer);
-            std::vector<std::string> strs;
-            utility::SplitString(strs, line, "\t\r\n ");
-            if ((int)strs.size() < header.elementnum) {
-                continue;
+        utility::filesystem::MappedFile mapped_file;
+        std::string buffer;
+        const char *begin, *end;
+        long position = ftell(file);
+        if (position < 0 ||
+            !utility::ReadTextFile(filename, mapped_file, buffer, begin,
+                                   end) ||
+            position > end - begin) {
+            utility::LogWarning("[ReadPCDData] Failed to read data record.\n");
+            pointcloud.Clear();
+            return false;
+        }
+        const std::vector<PCDASCIIToken> tokens = GetPCDASCIITokens(header);
+        std::vector<PCDASCIIPoint> records =
+                utility::ParseLines<PCDASCIIPoint>(
+                        begin + position, end,
+                        [&](const char *ptr, const char *line_end,
+                            PCDASCIIPoint &record) {
+                            return ParseASCIIPCDLine(tokens, ptr, line_end,
+                                                     record);
+                        });
+        const size_t num_records =
+                std::min(records.size(), size_t(header.points));
+        for (size_t idx = 0; idx < num_records; idx++) {
+            pointcloud.points_[idx] = records[idx].point;
+            if (header.has_normals) {
+                pointcloud.normals_[idx] = records[idx].normal;
             }
-            for (size_t i = 0; i < header.fields.size(); i++) {
-                const auto &field = header.fields[i];
-                if (field.name == "x") {
-                    pointcloud.points_[idx](0) = UnpackASCIIPCDElement(
-                            strs[field.count_offset].c_str(), field.type,
-                            field.size);
-                } else if (field.name == "y") {
-                    pointcloud.points_[idx](1) = UnpackASCIIPCDElement(
-                            strs[field.count_offset].c_str(), field.type,
-                            field.size);
-                } else if (field.name == "z") {
-                    pointcloud.points_[idx](2) = UnpackASCIIPCDElement(
-                            strs[field.count_offset].c_str(), field.type,
-                            field.size);
-                } else if (field.name == "normal_x") {
-                    pointcloud.normals_[idx](0) = UnpackASCIIPCDElement(
-                            strs[field.count_offset].c_str(), field.type,
-                            field.size);
-                } else if (field.name == "normal_y") {
-                    pointcloud.normals_[idx](1) = UnpackASCIIPCDElement(
-                            strs[field.count_offset].c_str(), field.type,
-                            field.size);
-                } else if (field.name == "normal_z") {
-                    pointcloud.normals_[idx](2) = UnpackASCIIPCDElement(
-                            strs[field.count_offset].c_str(), field.type,
-                            field.size);
-                } else if (field.name == "rgb" || field.name == "rgba") {
-                    pointcloud.colors_[idx] = UnpackASCIIPCDColor(
-                            strs[field.count_offset].c_str(), field.type,
-                            field.size);
-                }
+            if (header.has_colors) {
+                pointcloud.colors_[idx] = records[idx].color;
             }
-            idx++;
         }
     } else if (header.datatype == PCD_DATA_BINARY) {
-        std::unique_ptr<char[]> buffer(new char[header.pointsize]);
-        for (int i = 0; i < header.points; i++) {
-            if (fread(buffer.get(), header.pointsize, 1, file) != 1) {
-                utility::LogWarning(
-                        "[ReadPCDData] Failed to read data record.\n");
-                pointcloud.Clear();
-                return false;
-            }
-            for (const auto &field : header.fields) {
-                if (field.name == "x") {
-                    pointcloud.points_[i](0) =
-                            UnpackBinaryPCDElement(buffer.get() + field.offset,
-                                                   field.type, field.size);
-                } else if (field.name == "y") {
-                    pointcloud.points_[i](1) =
-                            UnpackBinaryPCDElement(buffer.get() + field.offset,
-                                                   field.type, field.size);
-                } else if (field.name == "z") {
-                    pointcloud.points_[i](2) =
-                            UnpackBinaryPCDElement(buffer.get() + field.offset,
-                                                   field.type, field.size);
-                } else if (field.name == "normal_x") {
-                    pointcloud.normals_[i](0) =
-                            UnpackBinaryPCDElement(buffer.get() + field.offset,
-                                                   field.type, field.size);
-                } else if (field.name == "normal_y") {
-                    pointcloud.normals_[i](1) =
-                            UnpackBinaryPCDElement(buffer.get() + field.offset,
-                                                   field.type, field.size);
-                } else if (field.name == "normal_z") {
-                    pointcloud.normals_[i](2) =
-                            UnpackBinaryPCDElement(buffer.get() + field.offset,
-                                                   field.type, field.size);
-                } else if (field.name == "rgb" || field.name == "rgba") {
-                    pointcloud.colors_[i] =
-                            UnpackBinaryPCDColor(buffer.get() + field.offset,
-                                                 field.type, field.size);
-                }
-            }
+        utility::filesystem::MappedFile mapped_file;
+        std::vector<char> buffer;
+        const char *data = ReadPCDBlock(
+                file, filename,
+                size_t(header.points) * size_t(header.pointsize),
+                mapped_file, buffer);
+        if (data == nullptr) {
+            utility::LogWarning("[ReadPCDData] Failed to read data record.\n");
+            pointcloud.Clear();
+            return false;
         }
+        DecodePCDFields(header, data, false, pointcloud);
     } else if (header.datatype == PCD_DATA_BINARY_COMPRESSED) {
         std::uint32_t compressed_size;
         std::uint32_t uncompressed_size;
@@ -448,72 +656,35 @@ bool ReadPCDData(FILE *file,
             pointcloud.Clear();
             return false;
         }
-        utility::LogWarning(
+        utility::LogDebug(
                 "PCD data with {:d} compressed size, and {:d} uncompressed "
                 "size.\n",
                 compressed_size, uncompressed_size);
-        std::unique_ptr<char[]> buffer_compressed(new char[compressed_size]);
-        if (fread(buffer_compressed.get(), 1, compressed_size, file) !=
-            compressed_size) {
+        if (size_t(uncompressed_size) <
+            size_t(header.points) * size_t(header.pointsize)) {
+            utility::LogWarning("[ReadPCDData] Failed to read data record.\n");
+            pointcloud.Clear();
+            return false;
+        }
+        utility::filesystem::MappedFile mapped_file;
+        std::vector<char> buffer_compressed;
+        const char *data_compressed = ReadPCDBlock(
+                file, filename, compressed_size, mapped_file,
+                buffer_compressed);
+        if (data_compressed == nullptr) {
             utility::LogWarning("[ReadPCDData] Failed to read data record.\n");
             pointcloud.Clear();
             return false;
         }
         std::unique_ptr<char[]> buffer(new char[uncompressed_size]);
-        if (lzf_decompress(buffer_compressed.get(),
-                           (unsigned int)compressed_size, buffer.get(),
-                           (unsigned int)uncompressed_size) !=
+        if (lzf_decompress(data_compressed, (unsigned int)compressed_size,
+                           buffer.get(), (unsigned int)uncompressed_size) !=
             uncompressed_size) {
             utility::LogWarning("[ReadPCDData] Uncompression failed.\n");
             pointcloud.Clear();
             return false;
         }
-        for (const auto &field : header.fields) {
-            const char *base_ptr = buffer.get() + field.offset * header.points;
-            if (field.name == "x") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.points_[i](0) = UnpackBinaryPCDElement(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            } else if (field.name == "y") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.points_[i](1) = UnpackBinaryPCDElement(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            } else if (field.name == "z") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.points_[i](2) = UnpackBinaryPCDElement(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            } else if (field.name == "normal_x") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.normals_[i](0) = UnpackBinaryPCDElement(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            } else if (field.name == "normal_y") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.normals_[i](1) = UnpackBinaryPCDElement(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            } else if (field.name == "normal_z") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.normals_[i](2) = UnpackBinaryPCDElement(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            } else if (field.name == "rgb" || field.name == "rgba") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.colors_[i] = UnpackBinaryPCDColor(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            }
-        }
+        DecodePCDFields(header, buffer.get(), true, pointcloud);
     }
     return true;
 }
@@ -534,30 +705,21 @@ bool GenerateHeader(const geometry::PointCloud &pointcloud,
     field.type = 'F';
     field.size = 4;
     field.count = 1;
-    field.name = "x";
-    header.fields.push_back(field);
-    field.name = "y";
-    header.fields.push_back(field);
-    field.name = "z";
-    header.fields.push_back(field);
-    header.elementnum = 3;
-    header.pointsize = 12;
+    std::vector<std::string> names = {"x", "y", "z"};
     if (pointcloud.HasNormals()) {
-        field.name = "normal_x";
-        header.fields.push_back(field);
-        field.name = "normal_y";
-        header.fields.push_back(field);
-        field.name = "normal_z";
-        header.fields.push_back(field);
-        header.elementnum += 3;
-        header.pointsize += 12;
+        names.insert(names.end(), {"normal_x", "normal_y", "normal_z"});
     }
     if (pointcloud.HasColors()) {
-        field.name = "rgb";
+        names.push_back("rgb");
+    }
+    for (const auto &name : names) {
+        field.name = name;
+        field.count_offset = int(header.fields.size());
+        field.offset = field.count_offset * field.size;
         header.fields.push_back(field);
-        header.elementnum++;
-        header.pointsize += 4;
     }
+    header.elementnum = int(header.fields.size());
+    header.pointsize = header.elementnum * field.size;
     if (write_ascii) {
         header.datatype = PCD_DATA_ASCII;
     } else {
@@ -624,6 +786,47 @@ float ConvertRGBToFloat(const Eigen::Vector3d &color) {
     return value;
 }
 
+/// Encodes the points [\p begin, \p end) into \p data, either interleaved
+/// or, for compressed data, with every field stored as a contiguous column.
+/// All fields are 4 byte floats as set up by GenerateHeader.
+void EncodePCDFields(const PCDHeader &header,
+                     const geometry::PointCloud &pointcloud,
+                     int begin,
+                     int end,
+                     bool columnar,
+                     char *data) {
+    for (const auto &field : header.fields) {
+        char *base;
+        size_t stride;
+        if (columnar) {
+            base = data + size_t(field.offset) * size_t(end - begin);
+            stride = sizeof(float);
+        } else {
+            base = data + field.offset;
+            stride = size_t(header.pointsize);
+        }
+        const std::vector<Eigen::Vector3d> *values = nullptr;
+        int component = 0;
+        if (field.name == "x" || field.name == "y" || field.name == "z") {
+            values = &pointcloud.points_;
+            component = field.name[0] - 'x';
+        } else if (field.name == "normal_x" || field.name == "normal_y" ||
+                   field.name == "normal_z") {
+            values = &pointcloud.normals_;
+            component = field.name[7] - 'x';
+        }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int i = begin; i < end; i++) {
+            float value = values != nullptr
+                                  ? (float)(*values)[i](component)
+                                  : ConvertRGBToFloat(pointcloud.colors_[i]);
+            memcpy(base + size_t(i - begin) * stride, &value, sizeof(float));
+        }
+    }
+}
+
 bool WritePCDData(FILE *file,
                   const PCDHeader &header,
                   const geometry::PointCloud &pointcloud) {
@@ -645,50 +848,26 @@ bool WritePCDData(FILE *file,
             fprintf(file, "\n");
         }
     } else if (header.datatype == PCD_DATA_BINARY) {
-        std::unique_ptr<float[]> data(new float[header.elementnum]);
-        for (size_t i = 0; i < pointcloud.points_.size(); i++) {
-            const auto &point = pointcloud.points_[i];
-            data[0] = (float)point(0);
-            data[1] = (float)point(1);
-            data[2] = (float)point(2);
-            int idx = 3;
-            if (has_normal) {
-                const auto &normal = pointcloud.normals_[i];
-                data[idx + 0] = (float)normal(0);
-                data[idx + 1] = (float)normal(1);
-                data[idx + 2] = (float)normal(2);
-                idx += 3;
-            }
-            if (has_color) {
-                const auto &color = pointcloud.colors_[i];
-                data[idx] = ConvertRGBToFloat(color);
+        // Blocks of points are encoded in parallel and written in one call.
+        const int block_size = 1 << 20;
+        std::vector<char> buffer;
+        for (int begin = 0; begin < header.points; begin += block_size) {
+            int end = std::min(begin + block_size, header.points);
+            buffer.resize(size_t(end - begin) * size_t(header.pointsize));
+            EncodePCDFields(header, pointcloud, begin, end, false,
+                            buffer.data());
+            if (fwrite(buffer.data(), 1, buffer.size(), file) !=
+                buffer.size()) {
+                return false;
             }
-            fwrite(data.get(), sizeof(float), header.elementnum, file);
         }
     } else if (header.datatype == PCD_DATA_BINARY_COMPRESSED) {
-        int strip_size = header.points;
         std::uint32_t buffer_size =
                 (std::uint32_t)(header.elementnum * header.points);
         std::unique_ptr<float[]> buffer(new float[buffer_size]);
         std::unique_ptr<float[]> buffer_compressed(new float[buffer_size * 2]);
-        for (size_t i = 0; i < pointcloud.points_.size(); i++) {
-            const auto &point = pointcloud.points_[i];
-            buffer[0 * strip_size + i] = (float)point(0);
-            buffer[1 * strip_size + i] = (float)point(1);
-            buffer[2 * strip_size + i] = (float)point(2);
-            int idx = 3;
-            if (has_normal) {
-                const auto &normal = pointcloud.normals_[i];
-                buffer[(idx + 0) * strip_size + i] = (float)normal(0);
-                buffer[(idx + 1) * strip_size + i] = (float)normal(1);
-                buffer[(idx + 2) * strip_size + i] = (float)normal(2);
-                idx += 3;
-            }
-            if (has_color) {
-                const auto &color = pointcloud.colors_[i];
-                buffer[idx * strip_size + i] = ConvertRGBToFloat(color);
-            }
-        }
+        EncodePCDFields(header, pointcloud, 0, header.points, true,
+                        reinterpret_cast<char *>(buffer.get()));
         std::uint32_t buffer_size_in_bytes = buffer_size * sizeof(float);
         std::uint32_t size_compressed =
                 lzf_compress(buffer.get(), buffer_size_in_bytes,
@@ -739,7 +918,7 @@ bool ReadPointCloudFromPCD(const std::string &filename,
                       header.has_points ? "yes" : "no",
                       header.has_normals ? "yes" : "no",
                       header.has_colors ? "yes" : "no");
-    if (ReadPCDData(file, header, pointcloud) == false) {
+    if (ReadPCDData(file, filename, header, pointcloud) == false) {
         utility::LogWarning("Read PCD failed: unable to read data.\n");
         fclose(file);
         return false;
@@ -25,12 +25,20 @@
 // ----------------------------------------------------------------------------
 
 #include <rply/rply.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <unordered_map>
 
 #include "Open3D/IO/ClassIO/LineSetIO.h"
 #include "Open3D/IO/ClassIO/PointCloudIO.h"
 #include "Open3D/IO/ClassIO/TriangleMeshIO.h"
 #include "Open3D/IO/ClassIO/VoxelGridIO.h"
 #include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/FileSystem.h"
 
 namespace open3d {
 
@@ -349,6 +357,601 @@ int ReadColorCallback(p_ply_argument argument) {
 
 }  // namespace ply_voxelgrid_reader
 
+namespace ply_binary {
+
+// Binary PLY files are memory mapped and the properties Open3D uses are
+// decoded with typed strided copies, in parallel over the rows of a block.
+// Files this path does not handle, such as ASCII files or faces that are not
+// triangles, are read with rply instead.
+
+const int kBlockRows = 1 << 20;
+
+enum class ScalarType {
+    Int8,
+    UInt8,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Float32,
+    Float64
+};
+
+bool ParseScalarType(const std::string &name, ScalarType &type) {
+    static const std::unordered_map<std::string, ScalarType> types = {
+            {"int8", ScalarType::Int8},       {"char", ScalarType::Int8},
+            {"uint8", ScalarType::UInt8},     {"uchar", ScalarType::UInt8},
+            {"int16", ScalarType::Int16},     {"short", ScalarType::Int16},
+            {"uint16", ScalarType::UInt16},   {"ushort", ScalarType::UInt16},
+            {"int32", ScalarType::Int32},     {"int", ScalarType::Int32},
+            {"uint32", ScalarType::UInt32},   {"uint", ScalarType::UInt32},
+            {"float32", ScalarType::Float32}, {"float", ScalarType::Float32},
+            {"float64", ScalarType::Float64}, {"double", ScalarType::Float64}};
+    auto it = types.find(name);
+    if (it == types.end()) {
+        return false;
+    }
+    type = it->second;
+    return true;
+}
+
+size_t ScalarSize(ScalarType type) {
+    switch (type) {
+        case ScalarType::Int8:
+        case ScalarType::UInt8:
+            return 1;
+        case ScalarType::Int16:
+        case ScalarType::UInt16:
+            return 2;
+        case ScalarType::Int32:
+        case ScalarType::UInt32:
+        case ScalarType::Float32:
+            return 4;
+        default:
+            return 8;
+    }
+}
+
+struct PLYProperty {
+    std::string name;
+    ScalarType type;
+    bool is_list = false;
+    ScalarType length_type;
+    /// Byte offset inside a row.
+    size_t offset = 0;
+};
+
+struct PLYElement {
+    std::string name;
+    size_t count = 0;
+    std::vector<PLYProperty> properties;
+    /// Byte size of a row. Elements with list properties have no fixed row
+    /// size, except faces with a single index list, whose rows are assumed to
+    /// hold triangles. The assumption is checked while decoding.
+    size_t stride = 0;
+    /// Byte offset of the first row in the file, 0 if it is not known
+    /// because a preceding element has no fixed row size or a list whose size
+    /// is only assumed.
+    size_t data_offset = 0;
+
+    const PLYProperty *FindProperty(const std::string &property_name) const {
+        for (const auto &property : properties) {
+            if (property.name == property_name) {
+                return &property;
+            }
+        }
+        return nullptr;
+    }
+};
+
+struct PLYHeader {
+    /// True if the byte order of the file differs from the host.
+    bool swap_bytes = false;
+    std::vector<PLYElement> elements;
+
+    const PLYElement *FindElement(const std::string &element_name) const {
+        for (const auto &element : elements) {
+            if (element.name == element_name) {
+                return &element;
+            }
+        }
+        return nullptr;
+    }
+};
+
+bool IsLittleEndianHost() {
+    const uint16_t one = 1;
+    unsigned char first_byte;
+    std::memcpy(&first_byte, &one, 1);
+    return first_byte == 1;
+}
+
+/// Computes the row layout of \p element. Returns false and sets the stride
+/// to 0 if the rows have no fixed size.
+bool ComputeRowLayout(PLYElement &element) {
+    size_t offset = 0;
+    int num_lists = 0;
+    for (auto &property : element.properties) {
+        property.offset = offset;
+        if (property.is_list) {
+            if (property.name != "vertex_indices" &&
+                property.name != "vertex_index") {
+                return false;
+            }
+            offset += ScalarSize(property.length_type) +
+                      3 * ScalarSize(property.type);
+            num_lists++;
+        } else {
+            offset += ScalarSize(property.type);
+        }
+    }
+    if (num_lists == 0 || (num_lists == 1 && element.name == "face")) {
+        element.stride = offset;
+        return true;
+    }
+    element.stride = 0;
+    return false;
+}
+
+/// Parses the header of a binary PLY file. Returns false if the file is not
+/// a binary PLY file or the header is malformed.
+bool ParseHeader(const char *data, size_t size, PLYHeader &header) {
+    if (size < 4 || std::strncmp(data, "ply", 3) != 0 ||
+        (data[3] != '\n' && data[3] != '\r')) {
+        return false;
+    }
+    bool has_format = false;
+    size_t pos = 0;
+    while (pos < size) {
+        const char *line_end = static_cast<const char *>(
+                std::memchr(data + pos, '\n', size - pos));
+        if (line_end == nullptr) {
+            return false;
+        }
+        std::istringstream line(std::string(data + pos, line_end));
+        pos = size_t(line_end - data) + 1;
+        std::string keyword;
+        line >> keyword;
+        if (keyword == "ply" || keyword == "comment" ||
+            keyword == "obj_info" || keyword.empty()) {
+            continue;
+        } else if (keyword == "format") {
+            std::string format;
+            line >> format;
+            if (format == "binary_little_endian") {
+                header.swap_bytes = !IsLittleEndianHost();
+            } else if (format == "binary_big_endian") {
+                header.swap_bytes = IsLittleEndianHost();
+            } else {
+                return false;
+            }
+            has_format = true;
+        } else if (keyword == "element") {
+            PLYElement element;
+            long long count = -1;
+            line >> element.name >> count;
+            if (line.fail() || count < 0) {
+                return false;
+            }
+            element.count = size_t(count);
+            header.elements.push_back(element);
+        } else if (keyword == "property") {
+            if (header.elements.empty()) {
+                return false;
+            }
+            PLYProperty property;
+            std::string type;
+            line >> type;
+            if (type == "list") {
+                std::string length_type;
+                line >> length_type >> type;
+                property.is_list = true;
+                if (!ParseScalarType(length_type, property.length_type)) {
+                    return false;
+                }
+            }
+            line >> property.name;
+            if (line.fail() || !ParseScalarType(type, property.type)) {
+                return false;
+            }
+            header.elements.back().properties.push_back(property);
+        } else if (keyword == "end_header") {
+            size_t offset = pos;
+            for (auto &element : header.elements) {
+                element.data_offset = offset;
+                if (!ComputeRowLayout(element)) {
+                    break;
+                }
+                // The triangle rows of a face are only checked when the face
+                // is decoded, so the elements after it are not located with
+                // the assumed size.
+                bool has_list = false;
+                for (const auto &property : element.properties) {
+                    has_list = has_list || property.is_list;
+                }
+                if (has_list) {
+                    break;
+                }
+                offset += element.count * element.stride;
+            }
+            return has_format;
+        } else {
+            return false;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+inline T LoadScalar(const char *ptr, bool swap_bytes) {
+    T value;
+    if (swap_bytes) {
+        char bytes[sizeof(T)];
+        std::reverse_copy(ptr, ptr + sizeof(T), bytes);
+        std::memcpy(&value, bytes, sizeof(T));
+    } else {
+        std::memcpy(&value, ptr, sizeof(T));
+    }
+    return value;
+}
+
+template <typename T>
+inline void StoreScalar(char *ptr, T value, bool swap_bytes) {
+    std::memcpy(ptr, &value, sizeof(T));
+    if (swap_bytes) {
+        std::reverse(ptr, ptr + sizeof(T));
+    }
+}
+
+double LoadAsDouble(ScalarType type, const char *ptr, bool swap_bytes) {
+    switch (type) {
+        case ScalarType::Int8:
+            return double(LoadScalar<int8_t>(ptr, swap_bytes));
+        case ScalarType::UInt8:
+            return double(LoadScalar<uint8_t>(ptr, swap_bytes));
+        case ScalarType::Int16:
+            return double(LoadScalar<int16_t>(ptr, swap_bytes));
+        case ScalarType::UInt16:
+            return double(LoadScalar<uint16_t>(ptr, swap_bytes));
+        case ScalarType::Int32:
+            return double(LoadScalar<int32_t>(ptr, swap_bytes));
+        case ScalarType::UInt32:
+            return double(LoadScalar<uint32_t>(ptr, swap_bytes));
+        case ScalarType::Float32:
+            return double(LoadScalar<float>(ptr, swap_bytes));
+        default:
+            return LoadScalar<double>(ptr, swap_bytes);
+    }
+}
+
+template <typename T>
+void DecodeVector3As(const char *rows,
+                     size_t stride,
+                     const PLYProperty *const properties[3],
+                     bool swap_bytes,
+                     double divisor,
+                     int begin,
+                     int end,
+                     std::vector<Eigen::Vector3d> &values) {
+    const size_t offset0 = properties[0]->offset;
+    const size_t offset1 = properties[1]->offset;
+    const size_t offset2 = properties[2]->offset;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = begin; i < end; i++) {
+        const char *row = rows + size_t(i) * stride;
+        values[i](0) = double(LoadScalar<T>(row + offset0, swap_bytes)) /
+                       divisor;
+        values[i](1) = double(LoadScalar<T>(row + offset1, swap_bytes)) /
+                       divisor;
+        values[i](2) = double(LoadScalar<T>(row + offset2, swap_bytes)) /
+                       divisor;
+    }
+}
+
+/// Decodes three scalar properties of the rows [\p begin, \p end) into
+/// \p values, divided by \p divisor.
+void DecodeVector3(const char *rows,
+                   size_t stride,
+                   const PLYProperty *const properties[3],
+                   bool swap_bytes,
+                   double divisor,
+                   int begin,
+                   int end,
+                   std::vector<Eigen::Vector3d> &values) {
+    const ScalarType type = properties[0]->type;
+    if (properties[1]->type == type && properties[2]->type == type) {
+        switch (type) {
+            case ScalarType::UInt8:
+                DecodeVector3As<uint8_t>(rows, stride, properties, swap_bytes,
+                                         divisor, begin, end, values);
+                return;
+            case ScalarType::Float32:
+                DecodeVector3As<float>(rows, stride, properties, swap_bytes,
+                                       divisor, begin, end, values);
+                return;
+            case ScalarType::Float64:
+                DecodeVector3As<double>(rows, stride, properties, swap_bytes,
+                                        divisor, begin, end, values);
+                return;
+            default:
+                break;
+        }
+    }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = begin; i < end; i++) {
+        const char *row = rows + size_t(i) * stride;
+        for (int c = 0; c < 3; c++) {
+            values[i](c) = LoadAsDouble(properties[c]->type,
+                                        row + properties[c]->offset,
+                                        swap_bytes) /
+                           divisor;
+        }
+    }
+}
+
+/// Decodes the index lists of the rows [\p begin, \p end) into
+/// \p triangles. Returns false if a list does not hold three indices.
+bool DecodeTriangles(const char *rows,
+                     size_t stride,
+                     const PLYProperty &property,
+                     bool swap_bytes,
+                     int begin,
+                     int end,
+                     std::vector<Eigen::Vector3i> &triangles) {
+    const size_t length_size = ScalarSize(property.length_type);
+    const size_t index_size = ScalarSize(property.type);
+    int num_invalid = 0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(+ : num_invalid)
+#endif
+    for (int i = begin; i < end; i++) {
+        const char *list = rows + size_t(i) * stride + property.offset;
+        if (LoadAsDouble(property.length_type, list, swap_bytes) != 3.0) {
+            num_invalid++;
+            continue;
+        }
+        const char *indices = list + length_size;
+        for (int c = 0; c < 3; c++) {
+            triangles[i](c) = int(LoadAsDouble(
+                    property.type, indices + c * index_size, swap_bytes));
+        }
+    }
+    return num_invalid == 0;
+}
+
+/// Finds the three properties \p names of \p element. Returns false if only
+/// some of them exist, which rply reads as partially filled attributes.
+bool FindVector3(const PLYElement &element,
+                 const char *const names[3],
+                 const PLYProperty *properties[3]) {
+    int num_found = 0;
+    for (int c = 0; c < 3; c++) {
+        properties[c] = element.FindProperty(names[c]);
+        if (properties[c] != nullptr) {
+            num_found++;
+            if (properties[c]->is_list) {
+                return false;
+            }
+        }
+    }
+    return num_found == 0 || num_found == 3;
+}
+
+/// Reads the vertices of a binary PLY file and, if \p triangles is given,
+/// its triangles. Returns false if the file has to be read with rply.
+bool ReadBinaryPLY(const std::string &filename,
+                   std::vector<Eigen::Vector3d> &points,
+                   std::vector<Eigen::Vector3d> &normals,
+                   std::vector<Eigen::Vector3d> &colors,
+                   std::vector<Eigen::Vector3i> *triangles,
+                   bool print_progress) {
+    utility::filesystem::MappedFile file;
+    if (!file.Open(filename)) {
+        return false;
+    }
+    PLYHeader header;
+    if (!ParseHeader(file.GetData(), file.GetSize(), header)) {
+        return false;
+    }
+
+    const PLYElement *vertex = header.FindElement("vertex");
+    if (vertex == nullptr || vertex->count == 0 || vertex->stride == 0 ||
+        vertex->data_offset == 0 ||
+        vertex->data_offset + vertex->count * vertex->stride >
+                file.GetSize()) {
+        return false;
+    }
+    static const char *const point_names[3] = {"x", "y", "z"};
+    static const char *const normal_names[3] = {"nx", "ny", "nz"};
+    static const char *const color_names[3] = {"red", "green", "blue"};
+    const PLYProperty *point_properties[3];
+    const PLYProperty *normal_properties[3];
+    const PLYProperty *color_properties[3];
+    if (!FindVector3(*vertex, point_names, point_properties) ||
+        point_properties[0] == nullptr ||
+        !FindVector3(*vertex, normal_names, normal_properties) ||
+        !FindVector3(*vertex, color_names, color_properties)) {
+        return false;
+    }
+    const PLYElement *face = nullptr;
+    const PLYProperty *face_property = nullptr;
+    if (triangles != nullptr) {
+        face = header.FindElement("face");
+        if (face != nullptr) {
+            face_property = face->FindProperty("vertex_indices");
+            if (face_property == nullptr) {
+                face_property = face->FindProperty("vertex_index");
+            }
+            if (face_property == nullptr || !face_property->is_list ||
+                face->stride == 0 || face->data_offset == 0 ||
+                face->data_offset + face->count * face->stride >
+                        file.GetSize()) {
+                return false;
+            }
+        }
+    }
+    if (vertex->count > size_t(std::numeric_limits<int>::max()) ||
+        (face != nullptr &&
+         face->count > size_t(std::numeric_limits<int>::max()))) {
+        return false;
+    }
+
+    const int num_vertices = int(vertex->count);
+    const int num_faces = face != nullptr ? int(face->count) : 0;
+    points.resize(num_vertices);
+    normals.resize(normal_properties[0] != nullptr ? num_vertices : 0);
+    colors.resize(color_properties[0] != nullptr ? num_vertices : 0);
+    if (triangles != nullptr) {
+        triangles->resize(num_faces);
+    }
+
+    utility::ConsoleProgressBar progress_bar(
+            size_t((num_vertices + kBlockRows - 1) / kBlockRows +
+                   (num_faces + kBlockRows - 1) / kBlockRows),
+            "Reading PLY: ", print_progress);
+    const char *vertex_rows = file.GetData() + vertex->data_offset;
+    for (int begin = 0; begin < num_vertices; begin += kBlockRows) {
+        int end = std::min(begin + kBlockRows, num_vertices);
+        DecodeVector3(vertex_rows, vertex->stride, point_properties,
+                      header.swap_bytes, 1.0, begin, end, points);
+        if (!normals.empty()) {
+            DecodeVector3(vertex_rows, vertex->stride, normal_properties,
+                          header.swap_bytes, 1.0, begin, end, normals);
+        }
+        if (!colors.empty()) {
+            DecodeVector3(vertex_rows, vertex->stride, color_properties,
+                          header.swap_bytes, 255.0, begin, end, colors);
+        }
+        ++progress_bar;
+    }
+    if (face != nullptr) {
+        const char *face_rows = file.GetData() + face->data_offset;
+        for (int begin = 0; begin < num_faces; begin += kBlockRows) {
+            int end = std::min(begin + kBlockRows, num_faces);
+            if (!DecodeTriangles(face_rows, face->stride, *face_property,
+                                 header.swap_bytes, begin, end,
+                                 *triangles)) {
+                return false;
+            }
+            ++progress_bar;
+        }
+    }
+    return true;
+}
+
+/// Writes a binary little endian PLY file with the layout of the rply
+/// writer. Blocks of rows are encoded in parallel and written in one call.
+bool WriteBinaryPLY(const std::string &filename,
+                    const std::vector<Eigen::Vector3d> &points,
+                    const std::vector<Eigen::Vector3d> *normals,
+                    const std::vector<Eigen::Vector3d> *colors,
+                    const std::vector<Eigen::Vector3i> *triangles,
+                    bool print_progress) {
+    FILE *file = fopen(filename.c_str(), "wb");
+    if (file == NULL) {
+        utility::LogWarning("Write PLY failed: unable to open file: {}\n",
+                            filename);
+        return false;
+    }
+
+    std::ostringstream header;
+    header << "ply\nformat binary_little_endian 1.0\n"
+           << "comment Created by Open3D\n"
+           << "element vertex " << points.size() << "\n"
+           << "property double x\nproperty double y\nproperty double z\n";
+    if (normals != nullptr) {
+        header << "property double nx\nproperty double ny\n"
+               << "property double nz\n";
+    }
+    if (colors != nullptr) {
+        header << "property uchar red\nproperty uchar green\n"
+               << "property uchar blue\n";
+    }
+    if (triangles != nullptr) {
+        header << "element face " << triangles->size() << "\n"
+               << "property list uchar uint vertex_indices\n";
+    }
+    header << "end_header\n";
+    const std::string header_str = header.str();
+    bool success =
+            fwrite(header_str.data(), 1, header_str.size(), file) ==
+            header_str.size();
+
+    const bool swap_bytes = !IsLittleEndianHost();
+    const int num_vertices = int(points.size());
+    const int num_triangles =
+            triangles != nullptr ? int(triangles->size()) : 0;
+    const size_t vertex_stride = 3 * sizeof(double) +
+                                 (normals != nullptr ? 3 * sizeof(double) : 0) +
+                                 (colors != nullptr ? 3 : 0);
+    const size_t triangle_stride = 1 + 3 * sizeof(uint32_t);
+    std::vector<char> buffer;
+    utility::ConsoleProgressBar progress_bar(
+            size_t((num_vertices + kBlockRows - 1) / kBlockRows +
+                   (num_triangles + kBlockRows - 1) / kBlockRows),
+            "Writing PLY: ", print_progress);
+    for (int begin = 0; success && begin < num_vertices; begin += kBlockRows) {
+        int end = std::min(begin + kBlockRows, num_vertices);
+        buffer.resize(size_t(end - begin) * vertex_stride);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int i = begin; i < end; i++) {
+            char *row = buffer.data() + size_t(i - begin) * vertex_stride;
+            for (int c = 0; c < 3; c++, row += sizeof(double)) {
+                StoreScalar(row, points[i](c), swap_bytes);
+            }
+            if (normals != nullptr) {
+                for (int c = 0; c < 3; c++, row += sizeof(double)) {
+                    StoreScalar(row, (*normals)[i](c), swap_bytes);
+                }
+            }
+            if (colors != nullptr) {
+                for (int c = 0; c < 3; c++, row++) {
+                    *row = char(uint8_t(std::min(
+                            255.0, std::max(0.0, (*colors)[i](c) * 255.0))));
+                }
+            }
+        }
+        success = fwrite(buffer.data(), 1, buffer.size(), file) ==
+                  buffer.size();
+        ++progress_bar;
+    }
+    for (int begin = 0; success && begin < num_triangles;
+         begin += kBlockRows) {
+        int end = std::min(begin + kBlockRows, num_triangles);
+        buffer.resize(size_t(end - begin) * triangle_stride);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int i = begin; i < end; i++) {
+            char *row = buffer.data() + size_t(i - begin) * triangle_stride;
+            row[0] = 3;
+            for (int c = 0; c < 3; c++) {
+                StoreScalar(row + 1 + c * sizeof(uint32_t),
+                            uint32_t((*triangles)[i](c)), swap_bytes);
+            }
+        }
+        success = fwrite(buffer.data(), 1, buffer.size(), file) ==
+                  buffer.size();
+        ++progress_bar;
+    }
+    if (fclose(file) != 0) {
+        success = false;
+    }
+    if (!success) {
+        utility::LogWarning("Write PLY failed: unable to write file: {}\n",
+                            filename);
+    }
+    return success;
+}
+
+}  // namespace ply_binary
+
 }  // unnamed namespace
 
 namespace io {
@@ -358,6 +961,13 @@ bool ReadPointCloudFromPLY(const std::string &filename,
                            bool print_progress) {
     using namespace ply_pointcloud_reader;
 
+    pointcloud.Clear();
+    if (ply_binary::ReadBinaryPLY(filename, pointcloud.points_,
+                                  pointcloud.normals_, pointcloud.colors_,
+                                  nullptr, print_progress)) {
+        return true;
+    }
+
     p_ply ply_file = ply_open(filename.c_str(), NULL, 0, NULL);
     if (!ply_file) {
         utility::LogWarning("Read PLY failed: unable to open file: %s\n",
@@ -427,10 +1037,15 @@ bool WritePointCloudToPLY(const std::string &filename,
         utility::LogWarning("Write PLY failed: point cloud has 0 points.\n");
         return false;
     }
+    if (!write_ascii) {
+        return ply_binary::WriteBinaryPLY(
+                filename, pointcloud.points_,
+                pointcloud.HasNormals() ? &pointcloud.normals_ : nullptr,
+                pointcloud.HasColors() ? &pointcloud.colors_ : nullptr,
+                nullptr, print_progress);
+    }
 
-    p_ply ply_file = ply_create(filename.c_str(),
-                                write_ascii ? PLY_ASCII : PLY_LITTLE_ENDIAN,
-                                NULL, 0, NULL);
+    p_ply ply_file = ply_create(filename.c_str(), PLY_ASCII, NULL, 0, NULL);
     if (!ply_file) {
         utility::LogWarning("Write PLY failed: unable to open file: {}\n",
                             filename);
@@ -494,6 +1109,13 @@ bool ReadTriangleMeshFromPLY(const std::string &filename,
                              bool print_progress) {
     using namespace ply_trianglemesh_reader;
 
+    mesh.Clear();
+    if (ply_binary::ReadBinaryPLY(filename, mesh.vertices_,
+                                  mesh.vertex_normals_, mesh.vertex_colors_,
+                                  &mesh.triangles_, print_progress)) {
+        return true;
+    }
+
     p_ply ply_file = ply_open(filename.c_str(), NULL, 0, NULL);
     if (!ply_file) {
         utility::LogWarning("Read PLY failed: unable to open file: {}\n",
@@ -573,18 +1195,23 @@ bool WriteTriangleMeshToPLY(const std::string &filename,
         return false;
     }
 
-    p_ply ply_file = ply_create(filename.c_str(),
-                                write_ascii ? PLY_ASCII : PLY_LITTLE_ENDIAN,
-                                NULL, 0, NULL);
+    write_vertex_normals = write_vertex_normals && mesh.HasVertexNormals();
+    write_vertex_colors = write_vertex_colors && mesh.HasVertexColors();
+    if (!write_ascii) {
+        return ply_binary::WriteBinaryPLY(
+                filename, mesh.vertices_,
+                write_vertex_normals ? &mesh.vertex_normals_ : nullptr,
+                write_vertex_colors ? &mesh.vertex_colors_ : nullptr,
+                &mesh.triangles_, print_progress);
+    }
+
+    p_ply ply_file = ply_create(filename.c_str(), PLY_ASCII, NULL, 0, NULL);
     if (!ply_file) {
         utility::LogWarning("Write PLY failed: unable to open file: {}\n",
                             filename);
         return false;
     }
 
-    write_vertex_normals = write_vertex_normals && mesh.HasVertexNormals();
-    write_vertex_colors = write_vertex_colors && mesh.HasVertexColors();
-
     ply_add_comment(ply_file, "Created by Open3D");
     ply_add_element(ply_file, "vertex",
                     static_cast<long>(mesh.vertices_.size()));
@@ -24,11 +24,13 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <algorithm>
 #include <cstdio>
 
 #include "Open3D/IO/ClassIO/PointCloudIO.h"
 #include "Open3D/Utility/Console.h"
 #include "Open3D/Utility/Helper.h"
+#include "Open3D/Utility/TextParser.h"
 
 namespace open3d {
 namespace io {
@@ -36,59 +38,77 @@ namespace io {
 bool ReadPointCloudFromPTS(const std::string &filename,
                            geometry::PointCloud &pointcloud,
                            bool print_progress) {
-    FILE *file = fopen(filename.c_str(), "r");
-    if (file == NULL) {
+    utility::filesystem::MappedFile mapped_file;
+    std::string buffer;
+    const char *begin, *end;
+    if (!utility::ReadTextFile(filename, mapped_file, buffer, begin, end)) {
         utility::LogWarning("Read PTS failed: unable to open file.\n");
         return false;
     }
-    char line_buffer[DEFAULT_IO_BUFFER_SIZE];
-    int num_of_pts = 0, num_of_fields = 0;
-    if (fgets(line_buffer, DEFAULT_IO_BUFFER_SIZE, file)) {
-        sscanf(line_buffer, "%d", &num_of_pts);
-    }
+    const char *header_end = std::find(begin, end, '\n');
+    int num_of_pts = 0;
+    const char *ptr = begin;
+    utility::ParseNumber(ptr, header_end, num_of_pts);
     if (num_of_pts <= 0) {
         utility::LogWarning("Read PTS failed: unable to read header.\n");
-        fclose(file);
         return false;
     }
-    utility::ConsoleProgressBar progress_bar(num_of_pts,
-                                             "Reading PTS: ", print_progress);
-    int idx = 0;
-    while (idx < num_of_pts &&
-           fgets(line_buffer, DEFAULT_IO_BUFFER_SIZE, file)) {
-        if (num_of_fields == 0) {
-            std::vector<std::string> st;
-            utility::SplitString(st, line_buffer, " ");
-            num_of_fields = (int)st.size();
-            if (num_of_fields < 3) {
-                utility::LogWarning(
-                        "Read PTS failed: insufficient data fields.\n");
-                fclose(file);
-                return false;
-            }
-            pointcloud.points_.resize(num_of_pts);
+    if (header_end == end || header_end + 1 == end) {
+        return true;
+    }
+    const char *data_begin = header_end + 1;
+    const char *first_line_end = std::find(data_begin, end, '\n');
+    if (first_line_end != end) {
+        first_line_end++;
+    }
+    std::vector<std::string> st;
+    utility::SplitString(st, std::string(data_begin, first_line_end), " ");
+    const int num_of_fields = (int)st.size();
+    if (num_of_fields < 3) {
+        utility::LogWarning("Read PTS failed: insufficient data fields.\n");
+        return false;
+    }
+
+    // Every line counts as a point, a line that cannot be parsed leaves its
+    // point unchanged.
+    struct Record {
+        bool valid;
+        Eigen::Vector3d point;
+        Eigen::Vector3d color;
+    };
+    std::vector<Record> records = utility::ParseLines<Record>(
+            data_begin, end,
+            [num_of_fields](const char *ptr, const char *line_end,
+                            Record &record) {
+                record.valid =
+                        utility::ParseNumber(ptr, line_end, record.point(0)) &&
+                        utility::ParseNumber(ptr, line_end, record.point(1)) &&
+                        utility::ParseNumber(ptr, line_end, record.point(2));
+                if (record.valid && num_of_fields >= 7) {
+                    // X Y Z I R G B
+                    int i, r, g, b;
+                    record.valid = utility::ParseNumber(ptr, line_end, i) &&
+                                   utility::ParseNumber(ptr, line_end, r) &&
+                                   utility::ParseNumber(ptr, line_end, g) &&
+                                   utility::ParseNumber(ptr, line_end, b);
+                    record.color = Eigen::Vector3d(r, g, b) / 255.0;
+                }
+                return true;
+            },
+            "Reading PTS: ", print_progress);
+    pointcloud.points_.resize(num_of_pts);
+    if (num_of_fields >= 7) {
+        pointcloud.colors_.resize(num_of_pts);
+    }
+    const size_t num_records = std::min(records.size(), size_t(num_of_pts));
+    for (size_t idx = 0; idx < num_records; idx++) {
+        if (records[idx].valid) {
+            pointcloud.points_[idx] = records[idx].point;
             if (num_of_fields >= 7) {
-                // X Y Z I R G B
-                pointcloud.colors_.resize(num_of_pts);
+                pointcloud.colors_[idx] = records[idx].color;
             }
         }
-        double x, y, z;
-        int i, r, g, b;
-        if (num_of_fields < 7) {
-            if (sscanf(line_buffer, "%lf %lf %lf", &x, &y, &z) == 3) {
-                pointcloud.points_[idx] = Eigen::Vector3d(x, y, z);
-            }
-        } else {
-            if (sscanf(line_buffer, "%lf %lf %lf %d %d %d %d", &x, &y, &z, &i,
-                       &r, &g, &b) == 7) {
-                pointcloud.points_[idx] = Eigen::Vector3d(x, y, z);
-                pointcloud.colors_[idx] = Eigen::Vector3d(r, g, b) / 255.0;
-            }
-        }
-        idx++;
-        ++progress_bar;
     }
-    fclose(file);
     return true;
 }
 
@@ -0,0 +1,535 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <liblzf/lzf.h>
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+
+#include "Open3D/IO/ClassIO/TSDFVolumeIO.h"
+#include "Open3D/Integration/VolumeUnitStore.h"
+#include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/FileSystem.h"
+
+// A TSDF file holds, in native byte order:
+//   the header: magic "O3DTSDF\0", uint32 version, volume type and color
+//   type, double voxel length, length, SDF truncation and origin[3], int32
+//   resolution and depth sampling stride, uint64 number of blocks and offset
+//   of the block index;
+//   the blocks: VolumeUnitStore::EncodeVoxels of an x slice of a uniform
+//   volume or of a volume unit of a scalable volume, LZF compressed if that
+//   is smaller;
+//   the block index: per block int32 index[3], uint64 offset, size and
+//   uncompressed size. A block is compressed if its size is smaller than its
+//   uncompressed size.
+
+namespace open3d {
+
+namespace {
+using namespace io;
+
+const char TSDF_MAGIC[8] = "O3DTSDF";
+const uint32_t TSDF_VERSION = 1;
+const uint32_t TSDF_UNIFORM_VOLUME = 0;
+const uint32_t TSDF_SCALABLE_VOLUME = 1;
+const size_t TSDF_HEADER_SIZE = 92;
+const size_t TSDF_BLOCK_ENTRY_SIZE = 36;
+/// Number of blocks that are encoded in parallel before they are written.
+const size_t TSDF_BLOCKS_PER_CHUNK = 64;
+
+struct TSDFHeader {
+    uint32_t volume_type_ = TSDF_UNIFORM_VOLUME;
+    uint32_t color_type_ = 0;
+    double voxel_length_ = 0.0;
+    double length_ = 0.0;
+    double sdf_trunc_ = 0.0;
+    Eigen::Vector3d origin_ = Eigen::Vector3d::Zero();
+    int32_t resolution_ = 0;
+    int32_t depth_sampling_stride_ = 0;
+    uint64_t num_blocks_ = 0;
+    uint64_t index_offset_ = 0;
+};
+
+struct TSDFBlockEntry {
+    Eigen::Vector3i index_;
+    uint64_t offset_;
+    uint64_t size_;
+    uint64_t raw_size_;
+};
+
+template <typename T>
+void AppendValue(std::vector<uint8_t> &buffer, const T &value) {
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+const char *ExtractValue(const char *data, T &value) {
+    std::memcpy(&value, data, sizeof(T));
+    return data + sizeof(T);
+}
+
+std::vector<uint8_t> EncodeTSDFHeader(const TSDFHeader &header) {
+    std::vector<uint8_t> buffer(TSDF_MAGIC, TSDF_MAGIC + sizeof(TSDF_MAGIC));
+    AppendValue(buffer, TSDF_VERSION);
+    AppendValue(buffer, header.volume_type_);
+    AppendValue(buffer, header.color_type_);
+    AppendValue(buffer, header.voxel_length_);
+    AppendValue(buffer, header.length_);
+    AppendValue(buffer, header.sdf_trunc_);
+    for (int i = 0; i < 3; i++) {
+        AppendValue(buffer, header.origin_(i));
+    }
+    AppendValue(buffer, header.resolution_);
+    AppendValue(buffer, header.depth_sampling_stride_);
+    AppendValue(buffer, header.num_blocks_);
+    AppendValue(buffer, header.index_offset_);
+    return buffer;
+}
+
+bool DecodeTSDFHeader(const char *data, size_t size, TSDFHeader &header) {
+    if (size < TSDF_HEADER_SIZE ||
+        std::memcmp(data, TSDF_MAGIC, sizeof(TSDF_MAGIC)) != 0) {
+        utility::LogWarning("Read TSDF failed: not a TSDF file.\n");
+        return false;
+    }
+    uint32_t version;
+    data = ExtractValue(data + sizeof(TSDF_MAGIC), version);
+    if (version != TSDF_VERSION) {
+        utility::LogWarning("Read TSDF failed: unsupported version {:d}.\n",
+                            version);
+        return false;
+    }
+    data = ExtractValue(data, header.volume_type_);
+    data = ExtractValue(data, header.color_type_);
+    data = ExtractValue(data, header.voxel_length_);
+    data = ExtractValue(data, header.length_);
+    data = ExtractValue(data, header.sdf_trunc_);
+    for (int i = 0; i < 3; i++) {
+        data = ExtractValue(data, header.origin_(i));
+    }
+    data = ExtractValue(data, header.resolution_);
+    data = ExtractValue(data, header.depth_sampling_stride_);
+    data = ExtractValue(data, header.num_blocks_);
+    data = ExtractValue(data, header.index_offset_);
+    const uint32_t max_color_type =
+            (uint32_t)integration::TSDFVolumeColorType::Gray32;
+    if (header.color_type_ > max_color_type ||
+        !(header.voxel_length_ > 0.0) || header.resolution_ <= 0 ||
+        (int64_t)header.resolution_ * header.resolution_ *
+                        header.resolution_ >
+                INT_MAX) {
+        utility::LogWarning("Read TSDF failed: invalid volume parameters.\n");
+        return false;
+    }
+    if (header.index_offset_ < TSDF_HEADER_SIZE ||
+        header.index_offset_ > size ||
+        header.num_blocks_ >
+                (size - header.index_offset_) / TSDF_BLOCK_ENTRY_SIZE) {
+        utility::LogWarning("Read TSDF failed: file is truncated.\n");
+        return false;
+    }
+    return true;
+}
+
+/// Maps \p filename and reads its header and block index.
+bool ReadTSDFFile(const std::string &filename,
+                  uint32_t volume_type,
+                  utility::filesystem::MappedFile &mapped_file,
+                  TSDFHeader &header,
+                  std::vector<TSDFBlockEntry> &entries) {
+    if (!mapped_file.Open(filename)) {
+        utility::LogWarning("Read TSDF failed: unable to open file: {}\n",
+                            filename);
+        return false;
+    }
+    const char *data = mapped_file.GetData();
+    const size_t size = mapped_file.GetSize();
+    if (!DecodeTSDFHeader(data, size, header)) {
+        return false;
+    }
+    if (header.volume_type_ != volume_type) {
+        utility::LogWarning(
+                "Read TSDF failed: file holds a {} volume.\n",
+                header.volume_type_ == TSDF_SCALABLE_VOLUME ? "scalable"
+                                                            : "uniform");
+        return false;
+    }
+    entries.resize(header.num_blocks_);
+    const char *entry_data = data + header.index_offset_;
+    for (auto &entry : entries) {
+        for (int i = 0; i < 3; i++) {
+            entry_data = ExtractValue(entry_data, entry.index_(i));
+        }
+        entry_data = ExtractValue(entry_data, entry.offset_);
+        entry_data = ExtractValue(entry_data, entry.size_);
+        entry_data = ExtractValue(entry_data, entry.raw_size_);
+        if (entry.offset_ > header.index_offset_ ||
+            entry.size_ > header.index_offset_ - entry.offset_ ||
+            entry.size_ > entry.raw_size_ || entry.raw_size_ > UINT_MAX) {
+            utility::LogWarning("Read TSDF failed: invalid block index.\n");
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Decodes the blocks \p entries of \p mapped_file in parallel.
+/// \p decode_block is called with the block number and the uncompressed
+/// block.
+bool DecodeTSDFBlocks(
+        const utility::filesystem::MappedFile &mapped_file,
+        const std::vector<TSDFBlockEntry> &entries,
+        const std::function<bool(size_t, const uint8_t *, size_t)>
+                &decode_block) {
+    const uint8_t *data =
+            reinterpret_cast<const uint8_t *>(mapped_file.GetData());
+    int num_failed = 0;
+#ifdef _OPENMP
+#pragma omp parallel reduction(+ : num_failed)
+#endif
+    {
+        std::vector<uint8_t> buffer;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+        for (int i = 0; i < (int)entries.size(); i++) {
+            const auto &entry = entries[i];
+            const uint8_t *block = data + entry.offset_;
+            if (entry.size_ < entry.raw_size_) {
+                buffer.resize(entry.raw_size_);
+                if (lzf_decompress(block, (unsigned int)entry.size_,
+                                   buffer.data(),
+                                   (unsigned int)entry.raw_size_) !=
+                    entry.raw_size_) {
+                    num_failed++;
+                    continue;
+                }
+                block = buffer.data();
+            }
+            if (!decode_block(i, block, entry.raw_size_)) {
+                num_failed++;
+            }
+        }
+    }
+    if (num_failed > 0) {
+        utility::LogWarning("Read TSDF failed: {:d} corrupted blocks.\n",
+                            num_failed);
+        return false;
+    }
+    return true;
+}
+
+/// Writes a TSDF file with a block for each of \p indices that has observed
+/// voxels. The blocks are processed in chunks: \p load_chunk is called with
+/// the first and one past the last block number of a chunk, then
+/// \p encode_block encodes the blocks of the chunk in parallel, and the chunk
+/// is written.
+bool WriteTSDFFile(
+        const std::string &filename,
+        TSDFHeader header,
+        const std::vector<Eigen::Vector3i> &indices,
+        bool compressed,
+        const std::function<bool(size_t, size_t)> &load_chunk,
+        const std::function<void(size_t, std::vector<uint8_t> &)>
+                &encode_block) {
+    FILE *file = fopen(filename.c_str(), "wb");
+    if (file == NULL) {
+        utility::LogWarning("Write TSDF failed: unable to open file: {}\n",
+                            filename);
+        return false;
+    }
+    std::vector<uint8_t> header_data = EncodeTSDFHeader(header);
+    bool success = fwrite(header_data.data(), 1, header_data.size(), file) ==
+                   header_data.size();
+    std::vector<TSDFBlockEntry> entries;
+    uint64_t offset = header_data.size();
+    std::vector<std::vector<uint8_t>> raw_blocks(TSDF_BLOCKS_PER_CHUNK);
+    std::vector<std::vector<uint8_t>> packed_blocks(TSDF_BLOCKS_PER_CHUNK);
+    for (size_t begin = 0; success && begin < indices.size();
+         begin += TSDF_BLOCKS_PER_CHUNK) {
+        size_t end = std::min(begin + TSDF_BLOCKS_PER_CHUNK, indices.size());
+        if (!load_chunk(begin, end)) {
+            success = false;
+            break;
+        }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (int i = (int)begin; i < (int)end; i++) {
+            auto &raw = raw_blocks[i - begin];
+            auto &packed = packed_blocks[i - begin];
+            raw.clear();
+            packed.clear();
+            encode_block(i, raw);
+            if (compressed && raw.size() > 1) {
+                // Only keep the compressed block if it is smaller.
+                packed.resize(raw.size() - 1);
+                unsigned int size = lzf_compress(
+                        raw.data(), (unsigned int)raw.size(), packed.data(),
+                        (unsigned int)packed.size());
+                packed.resize(size);
+            }
+        }
+        for (size_t i = begin; success && i < end; i++) {
+            const auto &raw = raw_blocks[i - begin];
+            const auto &packed = packed_blocks[i - begin];
+            uint32_t count = 0;
+            if (raw.size() >= sizeof(count)) {
+                std::memcpy(&count, raw.data(), sizeof(count));
+            }
+            if (count == 0) {
+                continue;
+            }
+            const auto &block = packed.empty() ? raw : packed;
+            success = fwrite(block.data(), 1, block.size(), file) ==
+                      block.size();
+            entries.push_back(
+                    {indices[i], offset, block.size(), raw.size()});
+            offset += block.size();
+        }
+    }
+    std::vector<uint8_t> index_data;
+    for (const auto &entry : entries) {
+        for (int i = 0; i < 3; i++) {
+            AppendValue(index_data, (int32_t)entry.index_(i));
+        }
+        AppendValue(index_data, entry.offset_);
+        AppendValue(index_data, entry.size_);
+        AppendValue(index_data, entry.raw_size_);
+    }
+    if (success) {
+        success = fwrite(index_data.data(), 1, index_data.size(), file) ==
+                  index_data.size();
+    }
+    if (success) {
+        header.num_blocks_ = entries.size();
+        header.index_offset_ = offset;
+        header_data = EncodeTSDFHeader(header);
+        success = fseek(file, 0, SEEK_SET) == 0 &&
+                  fwrite(header_data.data(), 1, header_data.size(), file) ==
+                          header_data.size();
+    }
+    if (fclose(file) != 0) {
+        success = false;
+    }
+    if (!success) {
+        utility::LogWarning("Write TSDF failed: unexpected error.\n");
+    }
+    return success;
+}
+
+}  // unnamed namespace
+
+namespace io {
+
+bool ReadTSDFVolumeFromTSDF(const std::string &filename,
+                            integration::UniformTSDFVolume &volume) {
+    utility::filesystem::MappedFile mapped_file;
+    TSDFHeader header;
+    std::vector<TSDFBlockEntry> entries;
+    if (!ReadTSDFFile(filename, TSDF_UNIFORM_VOLUME, mapped_file, header,
+                      entries)) {
+        return false;
+    }
+    const int resolution = header.resolution_;
+    std::vector<bool> has_slice(resolution, false);
+    for (const auto &entry : entries) {
+        const auto &index = entry.index_;
+        if (index(0) < 0 || index(0) >= resolution || index(1) != 0 ||
+            index(2) != 0 || has_slice[index(0)]) {
+            utility::LogWarning("Read TSDF failed: invalid block index.\n");
+            return false;
+        }
+        has_slice[index(0)] = true;
+    }
+    volume.voxel_length_ = header.voxel_length_;
+    volume.sdf_trunc_ = header.sdf_trunc_;
+    volume.color_type_ = (integration::TSDFVolumeColorType)header.color_type_;
+    volume.origin_ = header.origin_;
+    volume.length_ = header.length_;
+    volume.resolution_ = resolution;
+    volume.voxel_num_ = resolution * resolution * resolution;
+    volume.voxels_.assign(volume.voxel_num_, geometry::TSDFVoxel());
+    const size_t slice_size = size_t(resolution) * size_t(resolution);
+    const bool has_color =
+            volume.color_type_ != integration::TSDFVolumeColorType::None;
+    if (!DecodeTSDFBlocks(
+                mapped_file, entries,
+                [&](size_t i, const uint8_t *data, size_t size) {
+                    return integration::VolumeUnitStore::DecodeVoxels(
+                            data, size,
+                            volume.voxels_.data() +
+                                    entries[i].index_(0) * slice_size,
+                            slice_size, has_color);
+                })) {
+        volume.Reset();
+        return false;
+    }
+    return true;
+}
+
+bool ReadTSDFVolumeFromTSDF(const std::string &filename,
+                            integration::ScalableTSDFVolume &volume) {
+    utility::filesystem::MappedFile mapped_file;
+    TSDFHeader header;
+    std::vector<TSDFBlockEntry> entries;
+    if (!ReadTSDFFile(filename, TSDF_SCALABLE_VOLUME, mapped_file, header,
+                      entries)) {
+        return false;
+    }
+    volume.Reset();
+    volume.voxel_length_ = header.voxel_length_;
+    volume.sdf_trunc_ = header.sdf_trunc_;
+    volume.color_type_ = (integration::TSDFVolumeColorType)header.color_type_;
+    volume.volume_unit_resolution_ = header.resolution_;
+    volume.volume_unit_length_ = header.length_;
+    volume.depth_sampling_stride_ = header.depth_sampling_stride_;
+    // Units are created serially, then decoded in parallel.
+    std::vector<integration::UniformTSDFVolume *> units(entries.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+        const auto &index = entries[i].index_;
+        auto &unit = volume.volume_units_[index];
+        if (unit.volume_) {
+            utility::LogWarning("Read TSDF failed: invalid block index.\n");
+            volume.Reset();
+            return false;
+        }
+        unit.volume_.reset(new integration::UniformTSDFVolume(
+                volume.volume_unit_length_, volume.volume_unit_resolution_,
+                volume.sdf_trunc_, volume.color_type_,
+                index.cast<double>() * volume.volume_unit_length_));
+        unit.index_ = index;
+        volume.dirty_volume_units_.insert(index);
+        units[i] = unit.volume_.get();
+    }
+    if (!DecodeTSDFBlocks(mapped_file, entries,
+                          [&](size_t i, const uint8_t *data, size_t size) {
+                              return integration::VolumeUnitStore::
+                                      DecodeVolumeUnit(data, size, *units[i]);
+                          })) {
+        volume.Reset();
+        return false;
+    }
+    return true;
+}
+
+bool WriteTSDFVolumeToTSDF(const std::string &filename,
+                           const integration::UniformTSDFVolume &volume,
+                           bool compressed /* = true*/) {
+    TSDFHeader header;
+    header.volume_type_ = TSDF_UNIFORM_VOLUME;
+    header.color_type_ = (uint32_t)volume.color_type_;
+    header.voxel_length_ = volume.voxel_length_;
+    header.length_ = volume.length_;
+    header.sdf_trunc_ = volume.sdf_trunc_;
+    header.origin_ = volume.origin_;
+    header.resolution_ = volume.resolution_;
+    // After Reset the volume has no voxels and no blocks are written.
+    std::vector<Eigen::Vector3i> indices;
+    if (volume.voxels_.size() == size_t(volume.voxel_num_)) {
+        for (int x = 0; x < volume.resolution_; x++) {
+            indices.push_back(Eigen::Vector3i(x, 0, 0));
+        }
+    }
+    const size_t slice_size =
+            size_t(volume.resolution_) * size_t(volume.resolution_);
+    const bool has_color =
+            volume.color_type_ != integration::TSDFVolumeColorType::None;
+    return WriteTSDFFile(
+            filename, header, indices, compressed,
+            [](size_t, size_t) { return true; },
+            [&](size_t i, std::vector<uint8_t> &buffer) {
+                integration::VolumeUnitStore::EncodeVoxels(
+                        volume.voxels_.data() + i * slice_size, slice_size,
+                        has_color, buffer);
+            });
+}
+
+bool WriteTSDFVolumeToTSDF(const std::string &filename,
+                           const integration::ScalableTSDFVolume &volume,
+                           bool compressed /* = true*/) {
+    TSDFHeader header;
+    header.volume_type_ = TSDF_SCALABLE_VOLUME;
+    header.color_type_ = (uint32_t)volume.color_type_;
+    header.voxel_length_ = volume.voxel_length_;
+    header.length_ = volume.volume_unit_length_;
+    header.sdf_trunc_ = volume.sdf_trunc_;
+    header.resolution_ = volume.volume_unit_resolution_;
+    header.depth_sampling_stride_ = volume.depth_sampling_stride_;
+    std::vector<Eigen::Vector3i> indices = volume.GetPagedVolumeUnitIndices();
+    for (const auto &unit : volume.volume_units_) {
+        if (unit.second.volume_) {
+            indices.push_back(unit.first);
+        }
+    }
+    // Sorted indices make the file independent of the hash map order.
+    std::sort(indices.begin(), indices.end(),
+              [](const Eigen::Vector3i &a, const Eigen::Vector3i &b) {
+                  return std::lexicographical_compare(
+                          a.data(), a.data() + 3, b.data(), b.data() + 3);
+              });
+    // Paged units are read into the chunk serially as the store is a single
+    // file.
+    std::vector<std::shared_ptr<integration::UniformTSDFVolume>> chunk(
+            TSDF_BLOCKS_PER_CHUNK);
+    size_t chunk_begin = 0;
+    return WriteTSDFFile(
+            filename, header, indices, compressed,
+            [&](size_t begin, size_t end) {
+                chunk_begin = begin;
+                for (size_t i = begin; i < end; i++) {
+                    auto &unit = chunk[i - begin];
+                    auto it = volume.volume_units_.find(indices[i]);
+                    if (it != volume.volume_units_.end() &&
+                        it->second.volume_) {
+                        unit = it->second.volume_;
+                        continue;
+                    }
+                    unit = std::make_shared<integration::UniformTSDFVolume>(
+                            volume.volume_unit_length_,
+                            volume.volume_unit_resolution_, volume.sdf_trunc_,
+                            volume.color_type_,
+                            indices[i].cast<double>() *
+                                    volume.volume_unit_length_);
+                    if (!volume.ReadPagedVolumeUnit(indices[i], *unit)) {
+                        return false;
+                    }
+                }
+                return true;
+            },
+            [&](size_t i, std::vector<uint8_t> &buffer) {
+                integration::VolumeUnitStore::EncodeVolumeUnit(
+                        *chunk[i - chunk_begin], buffer);
+            });
+}
+
+}  // namespace io
+}  // namespace open3d
@@ -28,6 +28,7 @@
 
 #include "Open3D/IO/ClassIO/PointCloudIO.h"
 #include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/TextParser.h"
 
 namespace open3d {
 namespace io {
@@ -35,24 +36,23 @@ namespace io {
 bool ReadPointCloudFromXYZ(const std::string &filename,
                            geometry::PointCloud &pointcloud,
                            bool print_progress) {
-    FILE *file = fopen(filename.c_str(), "r");
-    if (file == NULL) {
+    utility::filesystem::MappedFile mapped_file;
+    std::string buffer;
+    const char *begin, *end;
+    if (!utility::ReadTextFile(filename, mapped_file, buffer, begin, end)) {
         utility::LogWarning("Read XYZ failed: unable to open file: {}\n",
                             filename);
         return false;
     }
 
-    char line_buffer[DEFAULT_IO_BUFFER_SIZE];
-    double x, y, z;
     pointcloud.Clear();
-
-    while (fgets(line_buffer, DEFAULT_IO_BUFFER_SIZE, file)) {
-        if (sscanf(line_buffer, "%lf %lf %lf", &x, &y, &z) == 3) {
-            pointcloud.points_.push_back(Eigen::Vector3d(x, y, z));
-        }
-    }
-
-    fclose(file);
+    pointcloud.points_ = utility::ParseLines<Eigen::Vector3d>(
+            begin, end,
+            [](const char *ptr, const char *line_end, Eigen::Vector3d &point) {
+                return utility::ParseNumber(ptr, line_end, point(0)) &&
+                       utility::ParseNumber(ptr, line_end, point(1)) &&
+                       utility::ParseNumber(ptr, line_end, point(2));
+            });
     return true;
 }
 
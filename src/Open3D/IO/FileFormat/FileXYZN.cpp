@@ -28,6 +28,7 @@
 
 #include "Open3D/IO/ClassIO/PointCloudIO.h"
 #include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/TextParser.h"
 
 namespace open3d {
 namespace io {
@@ -35,26 +36,33 @@ namespace io {
 bool ReadPointCloudFromXYZN(const std::string &filename,
                             geometry::PointCloud &pointcloud,
                             bool print_progress) {
-    FILE *file = fopen(filename.c_str(), "r");
-    if (file == NULL) {
+    utility::filesystem::MappedFile mapped_file;
+    std::string buffer;
+    const char *begin, *end;
+    if (!utility::ReadTextFile(filename, mapped_file, buffer, begin, end)) {
         utility::LogWarning("Read XYZN failed: unable to open file: {}\n",
                             filename);
         return false;
     }
 
-    char line_buffer[DEFAULT_IO_BUFFER_SIZE];
-    double x, y, z, nx, ny, nz;
+    typedef std::pair<Eigen::Vector3d, Eigen::Vector3d> Record;
+    std::vector<Record> records = utility::ParseLines<Record>(
+            begin, end,
+            [](const char *ptr, const char *line_end, Record &record) {
+                return utility::ParseNumber(ptr, line_end, record.first(0)) &&
+                       utility::ParseNumber(ptr, line_end, record.first(1)) &&
+                       utility::ParseNumber(ptr, line_end, record.first(2)) &&
+                       utility::ParseNumber(ptr, line_end, record.second(0)) &&
+                       utility::ParseNumber(ptr, line_end, record.second(1)) &&
+                       utility::ParseNumber(ptr, line_end, record.second(2));
+            });
     pointcloud.Clear();
-
-    while (fgets(line_buffer, DEFAULT_IO_BUFFER_SIZE, file)) {
-        if (sscanf(line_buffer, "%lf %lf %lf %lf %lf %lf", &x, &y, &z, &nx, &ny,
-                   &nz) == 6) {
-            pointcloud.points_.push_back(Eigen::Vector3d(x, y, z));
-            pointcloud.normals_.push_back(Eigen::Vector3d(nx, ny, nz));
-        }
+    pointcloud.points_.resize(records.size());
+    pointcloud.normals_.resize(records.size());
+    for (size_t i = 0; i < records.size(); i++) {
+        pointcloud.points_[i] = records[i].first;
+        pointcloud.normals_[i] = records[i].second;
     }
-
-    fclose(file);
     return true;
 }
 
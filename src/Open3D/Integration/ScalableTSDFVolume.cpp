@@ -26,16 +26,378 @@
 
 #include "Open3D/Integration/ScalableTSDFVolume.h"
 
+#include <algorithm>
+#include <limits>
 #include <unordered_set>
 
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Integration/MarchingCubesConst.h"
 #include "Open3D/Integration/UniformTSDFVolume.h"
+#include "Open3D/Integration/VolumeUnitStore.h"
 #include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Profiler.h"
 
 namespace open3d {
 namespace integration {
 
+namespace {
+
+/// Finds the volume units of a ScalableTSDFVolume. Rays look up many units
+/// that are not allocated, so a dense table over the bounding box of the
+/// allocated units replaces the hash map unless the box is too large.
+class VolumeUnitTable {
+public:
+    explicit VolumeUnitTable(const ScalableTSDFVolume &volume)
+        : volume_(volume),
+          min_index_(0, 0, 0),
+          max_index_(-1, -1, -1),
+          size_(0, 0, 0) {
+        if (volume.volume_units_.empty()) {
+            return;
+        }
+        min_index_ = volume.volume_units_.begin()->first;
+        max_index_ = min_index_;
+        for (const auto &unit : volume.volume_units_) {
+            min_index_ = min_index_.cwiseMin(unit.first);
+            max_index_ = max_index_.cwiseMax(unit.first);
+        }
+        size_ = max_index_ - min_index_ + Eigen::Vector3i::Ones();
+        const int64_t max_num_cells = 1 << 20;
+        if (int64_t(size_(0)) * size_(1) * size_(2) <= max_num_cells) {
+            cells_.resize(size_(0) * size_(1) * size_(2), nullptr);
+            for (const auto &unit : volume.volume_units_) {
+                cells_[CellOf(unit.first - min_index_)] =
+                        unit.second.volume_.get();
+            }
+        }
+    }
+
+    const UniformTSDFVolume *Find(const Eigen::Vector3i &index) const {
+        Eigen::Vector3i offset = index - min_index_;
+        if ((offset.array() < 0).any() ||
+            (offset.array() >= size_.array()).any()) {
+            return nullptr;
+        }
+        if (!cells_.empty()) {
+            return cells_[CellOf(offset)];
+        }
+        auto unit_itr = volume_.volume_units_.find(index);
+        return unit_itr == volume_.volume_units_.end()
+                       ? nullptr
+                       : unit_itr->second.volume_.get();
+    }
+
+    /// Bounds of the allocated volume units, empty if there are none.
+    Eigen::Vector3d GetMinBound() const {
+        return min_index_.cast<double>() * volume_.volume_unit_length_;
+    }
+    Eigen::Vector3d GetMaxBound() const {
+        return (max_index_ + Eigen::Vector3i::Ones()).cast<double>() *
+               volume_.volume_unit_length_;
+    }
+
+private:
+    int CellOf(const Eigen::Vector3i &offset) const {
+        return (offset(0) * size_(1) + offset(1)) * size_(2) + offset(2);
+    }
+
+private:
+    const ScalableTSDFVolume &volume_;
+    Eigen::Vector3i min_index_;
+    Eigen::Vector3i max_index_;
+    Eigen::Vector3i size_;
+    std::vector<const UniformTSDFVolume *> cells_;
+};
+
+/// std::floor for values in the range of int, without the call into the math
+/// library that std::floor compiles to on plain SSE2.
+int FloorToInt(double x) {
+    int i = int(x);
+    return x < i ? i - 1 : i;
+}
+
+/// Reads the voxels of a ScalableTSDFVolume by their global index, in which
+/// voxel (x, y, z) of volume unit (i, j, k) has the index
+/// (i, j, k) * volume_unit_resolution_ + (x, y, z). The volume unit of the
+/// last voxel is cached with its range of global indices, because consecutive
+/// samples along a ray mostly fall into it and then need neither a table
+/// lookup nor an integer division.
+class VoxelSampler {
+public:
+    VoxelSampler(const VolumeUnitTable &table, int resolution)
+        : table_(table),
+          resolution_(resolution),
+          unit_(nullptr),
+          unit_min_(0, 0, 0),
+          has_unit_(false) {}
+
+    /// Makes the volume unit of global voxel \p voxel the cached one and
+    /// returns it, nullptr if it is not allocated.
+    const UniformTSDFVolume *Locate(const Eigen::Vector3i &voxel) {
+        if (!has_unit_ || !InUnit(voxel)) {
+            Eigen::Vector3i index(FloorDivide(voxel(0)),
+                                  FloorDivide(voxel(1)),
+                                  FloorDivide(voxel(2)));
+            unit_ = table_.Find(index);
+            unit_min_ = index * resolution_;
+            has_unit_ = true;
+        }
+        return unit_;
+    }
+
+    /// Global index of voxel (0, 0, 0) of the cached volume unit.
+    const Eigen::Vector3i &GetUnitMin() const { return unit_min_; }
+
+    const geometry::TSDFVoxel *GetVoxel(const Eigen::Vector3i &voxel) {
+        if (Locate(voxel) == nullptr) {
+            return nullptr;
+        }
+        return &unit_->voxels_[unit_->IndexOf(voxel - unit_min_)];
+    }
+
+    /// Trilinear interpolation at \p p_grid, given in voxels from the center
+    /// of global voxel (0, 0, 0). Returns false if any of the eight voxels
+    /// around \p p_grid has not been observed. The optional \p gradient is
+    /// the gradient of the interpolated TSDF per voxel.
+    bool Interpolate(const Eigen::Vector3d &p_grid,
+                     double &tsdf,
+                     Eigen::Vector3d *color = nullptr,
+                     Eigen::Vector3d *gradient = nullptr) {
+        Eigen::Vector3i voxel0(FloorToInt(p_grid(0)), FloorToInt(p_grid(1)),
+                               FloorToInt(p_grid(2)));
+        Eigen::Vector3d r = p_grid - voxel0.cast<double>();
+        const geometry::TSDFVoxel *voxels[8];
+        const UniformTSDFVolume *unit = Locate(voxel0);
+        Eigen::Vector3i idx0 = voxel0 - unit_min_;
+        if (idx0.maxCoeff() < resolution_ - 1) {
+            // All eight voxels are in the same volume unit.
+            if (unit == nullptr) {
+                return false;
+            }
+            for (int i = 0; i < 8; i++) {
+                voxels[i] = &unit->voxels_[unit->IndexOf(idx0 + shift[i])];
+            }
+        } else {
+            for (int i = 0; i < 8; i++) {
+                voxels[i] = GetVoxel(voxel0 + shift[i]);
+                if (voxels[i] == nullptr) {
+                    return false;
+                }
+            }
+        }
+        tsdf = 0.0;
+        if (color != nullptr) {
+            color->setZero();
+        }
+        if (gradient != nullptr) {
+            gradient->setZero();
+        }
+        for (int i = 0; i < 8; i++) {
+            if (voxels[i]->weight_ == 0.0f) {
+                return false;
+            }
+            Eigen::Vector3d w1d(shift[i](0) ? r(0) : 1.0 - r(0),
+                                shift[i](1) ? r(1) : 1.0 - r(1),
+                                shift[i](2) ? r(2) : 1.0 - r(2));
+            double w = w1d(0) * w1d(1) * w1d(2);
+            tsdf += w * voxels[i]->tsdf_;
+            if (color != nullptr) {
+                *color += w * voxels[i]->color_;
+            }
+            if (gradient != nullptr) {
+                Eigen::Vector3d dw(w1d(1) * w1d(2), w1d(0) * w1d(2),
+                                   w1d(0) * w1d(1));
+                for (int j = 0; j < 3; j++) {
+                    (*gradient)(j) += (shift[i](j) ? dw(j) : -dw(j)) *
+                                      voxels[i]->tsdf_;
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    bool InUnit(const Eigen::Vector3i &voxel) const {
+        for (int i = 0; i < 3; i++) {
+            int offset = voxel(i) - unit_min_(i);
+            if (offset < 0 || offset >= resolution_) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    int FloorDivide(int a) const {
+        return a >= 0 ? a / resolution_ : (a - resolution_ + 1) / resolution_;
+    }
+
+private:
+    const VolumeUnitTable &table_;
+    const int resolution_;
+    const UniformTSDFVolume *unit_;
+    Eigen::Vector3i unit_min_;
+    bool has_unit_;
+};
+
+/// Samples the ray grid_origin + t * grid_ray for t in [t_start, t_end) in
+/// steps of \p step and returns the first interpolated samples (ta, fa) and
+/// (tb, fb) with fa >= 0 > fb, passing over samples next to unobserved voxels.
+/// Fails if the first negative sample has no positive one before it.
+bool BracketCrossing(VoxelSampler &sampler,
+                     const Eigen::Vector3d &grid_origin,
+                     const Eigen::Vector3d &grid_ray,
+                     double t_start,
+                     double t_end,
+                     double step,
+                     double &ta,
+                     double &fa,
+                     double &tb,
+                     double &fb) {
+    bool has_a = false;
+    for (tb = t_start; tb < t_end; tb += step) {
+        if (!sampler.Interpolate(grid_origin + tb * grid_ray, fb)) {
+            continue;
+        }
+        if (fb < 0.0) {
+            return has_a;
+        }
+        ta = tb;
+        fa = fb;
+        has_a = true;
+    }
+    return false;
+}
+
+/// Marches the ray origin + t * ray for t in [t_min, t_max) and returns the
+/// first t at which the TSDF crosses from positive to negative. Rays that
+/// first meet a negative TSDF start inside or behind a surface and miss.
+/// The march reads the nearest voxel of every sample, which touches a single
+/// cache line, and only the samples around the crossing are interpolated.
+bool MarchRay(const ScalableTSDFVolume &volume,
+              const VolumeUnitTable &table,
+              VoxelSampler &sampler,
+              const Eigen::Vector3d &origin,
+              const Eigen::Vector3d &ray,
+              double t_min,
+              double t_max,
+              double &t_hit) {
+    const double voxel_length = volume.voxel_length_;
+    const int resolution = volume.volume_unit_resolution_;
+    const double ray_length = ray.norm();
+    // Clip the ray to the bounding box of the allocated volume units.
+    const Eigen::Vector3d min_bound = table.GetMinBound();
+    const Eigen::Vector3d max_bound = table.GetMaxBound();
+    for (int i = 0; i < 3; i++) {
+        if (ray(i) != 0.0) {
+            double t0 = (min_bound(i) - origin(i)) / ray(i);
+            double t1 = (max_bound(i) - origin(i)) / ray(i);
+            t_min = std::max(t_min, std::min(t0, t1));
+            t_max = std::min(t_max, std::max(t0, t1));
+        } else if (origin(i) < min_bound(i) || origin(i) >= max_bound(i)) {
+            return false;
+        }
+    }
+    // The ray in the coordinates of VoxelSampler::Interpolate(), in which the
+    // nearest voxel of a sample is its coordinates rounded down after adding
+    // one half.
+    const Eigen::Vector3d grid_origin =
+            origin / voxel_length - Eigen::Vector3d(0.5, 0.5, 0.5);
+    const Eigen::Vector3d grid_ray = ray / voxel_length;
+    auto to_grid = [&](double t) -> Eigen::Vector3d {
+        return grid_origin + t * grid_ray;
+    };
+    // Steps in t of one voxel and of the truncation distance. Observed free
+    // space is crossed in steps of the distance that its TSDF guarantees.
+    // Unobserved voxels carry no distance, but half the truncation distance
+    // still lands in the band of positive values in front of any surface.
+    const double voxel_step = voxel_length / ray_length;
+    const double trunc_step = volume.sdf_trunc_ / ray_length;
+    const double unobserved_step = std::max(voxel_step, 0.5 * trunc_step);
+    double t = t_min;
+    double t_prev = 0.0;
+    double f_prev = 0.0;
+    bool has_prev = false;
+    while (t < t_max) {
+        Eigen::Vector3d p = to_grid(t);
+        const geometry::TSDFVoxel *voxel = sampler.GetVoxel(
+                Eigen::Vector3i(FloorToInt(p(0) + 0.5), FloorToInt(p(1) + 0.5),
+                                FloorToInt(p(2) + 0.5)));
+        if (voxel == nullptr) {
+            // Skip to where the ray leaves the empty volume unit.
+            const Eigen::Vector3i &unit_min = sampler.GetUnitMin();
+            double t_exit = t_max;
+            for (int i = 0; i < 3; i++) {
+                if (grid_ray(i) != 0.0) {
+                    double plane = (grid_ray(i) > 0.0 ? unit_min(i) + resolution
+                                                      : unit_min(i)) -
+                                   0.5;
+                    t_exit = std::min(t_exit,
+                                      (plane - grid_origin(i)) / grid_ray(i));
+                }
+            }
+            t = std::max(t_exit, t) + 0.01 * voxel_step;
+            has_prev = false;
+            continue;
+        }
+        if (voxel->weight_ == 0.0f) {
+            t += unobserved_step;
+            has_prev = false;
+            continue;
+        }
+        double f = voxel->tsdf_;
+        if (f < 0.0) {
+            if (!has_prev) {
+                return false;
+            }
+            // The nearest voxels only locate the crossing to within a voxel.
+            // Bracket it again with interpolated values in half voxel steps,
+            // starting a voxel before the linear estimate from the nearest
+            // voxels or at t_prev if that start is already behind the
+            // crossing, and going slightly past t in case the interpolation
+            // is still positive there.
+            const double t_start = std::max(
+                    t_prev,
+                    t_prev + (t - t_prev) * f_prev / (f_prev - f) - voxel_step);
+            const double t_end = t + voxel_step;
+            double ta = 0.0, fa = 0.0, tb = 0.0, fb = 0.0;
+            if (BracketCrossing(sampler, grid_origin, grid_ray, t_start, t_end,
+                                0.5 * voxel_step, ta, fa, tb, fb) ||
+                (t_start > t_prev &&
+                 BracketCrossing(sampler, grid_origin, grid_ray, t_prev, t_end,
+                                 0.5 * voxel_step, ta, fa, tb, fb))) {
+                t_prev = ta;
+                f_prev = fa;
+                t = tb;
+                f = fb;
+            }
+            t_hit = t_prev + (t - t_prev) * f_prev / (f_prev - f);
+            // One more step of regula falsi on the bracketing interval.
+            double f_hit;
+            if (sampler.Interpolate(to_grid(t_hit), f_hit)) {
+                if (f_hit > 0.0) {
+                    t_hit += (t - t_hit) * f_hit / (f_hit - f);
+                } else if (f_hit < 0.0) {
+                    t_hit = t_prev +
+                            (t_hit - t_prev) * f_prev / (f_prev - f_hit);
+                }
+            }
+            return true;
+        }
+        t_prev = t;
+        f_prev = f;
+        has_prev = true;
+        t += std::max(voxel_step, 0.8 * f * trunc_step);
+    }
+    return false;
+}
+
+bool LexicographicLess(const Eigen::Vector3i &a, const Eigen::Vector3i &b) {
+    return std::lexicographical_compare(a.data(), a.data() + 3, b.data(),
+                                        b.data() + 3);
+}
+
+}  // unnamed namespace
+
 ScalableTSDFVolume::ScalableTSDFVolume(double voxel_length,
                                        double sdf_trunc,
                                        TSDFVolumeColorType color_type,
@@ -46,14 +408,74 @@ ScalableTSDFVolume::ScalableTSDFVolume(double voxel_length,
       volume_unit_length_(voxel_length * volume_unit_resolution),
       depth_sampling_stride_(depth_sampling_stride) {}
 
+ScalableTSDFVolume::ScalableTSDFVolume(const ScalableTSDFVolume &other)
+    : TSDFVolume(other),
+      volume_unit_resolution_(other.volume_unit_resolution_),
+      volume_unit_length_(other.volume_unit_length_),
+      depth_sampling_stride_(other.depth_sampling_stride_),
+      dirty_volume_units_(other.dirty_volume_units_),
+      access_stamp_(other.access_stamp_) {
+    CopyVolumeUnits(other);
+}
+
+ScalableTSDFVolume &ScalableTSDFVolume::operator=(
+        const ScalableTSDFVolume &other) {
+    if (this != &other) {
+        TSDFVolume::operator=(other);
+        volume_unit_resolution_ = other.volume_unit_resolution_;
+        volume_unit_length_ = other.volume_unit_length_;
+        depth_sampling_stride_ = other.depth_sampling_stride_;
+        dirty_volume_units_ = other.dirty_volume_units_;
+        store_.reset();
+        max_volume_units_ = 0;
+        eviction_policy_ = VolumeUnitEvictionPolicy::LeastRecentlyUsed;
+        access_stamp_ = other.access_stamp_;
+        CopyVolumeUnits(other);
+    }
+    return *this;
+}
+
 ScalableTSDFVolume::~ScalableTSDFVolume() {}
 
-void ScalableTSDFVolume::Reset() { volume_units_.clear(); }
+void ScalableTSDFVolume::CopyVolumeUnits(const ScalableTSDFVolume &other) {
+    volume_units_.clear();
+    for (const auto &other_unit : other.volume_units_) {
+        auto &unit = volume_units_[other_unit.first];
+        unit = other_unit.second;
+        if (other_unit.second.volume_) {
+            unit.volume_ = std::make_shared<UniformTSDFVolume>(
+                    *other_unit.second.volume_);
+        }
+    }
+    if (!other.store_) {
+        return;
+    }
+    for (const auto &index : other.store_->GetIndices()) {
+        auto &unit = volume_units_[index];
+        unit.volume_.reset(new UniformTSDFVolume(
+                volume_unit_length_, volume_unit_resolution_, sdf_trunc_,
+                color_type_, index.cast<double>() * volume_unit_length_));
+        unit.index_ = index;
+        unit.last_used_ = access_stamp_;
+        if (!other.store_->Read(index, *unit.volume_)) {
+            volume_units_.erase(index);
+        }
+    }
+}
+
+void ScalableTSDFVolume::Reset() {
+    volume_units_.clear();
+    dirty_volume_units_.clear();
+    if (store_) {
+        store_->Clear();
+    }
+}
 
 void ScalableTSDFVolume::Integrate(
         const geometry::RGBDImage &image,
         const camera::PinholeCameraIntrinsic &intrinsic,
         const Eigen::Matrix4d &extrinsic) {
+    OPEN3D_PROFILE_ZONE("ScalableTSDFVolume::Integrate");
     if ((image.depth_.num_of_channels_ != 1) ||
         (image.depth_.bytes_per_channel_ != 4) ||
         (image.depth_.width_ != intrinsic.width_) ||
@@ -74,36 +496,126 @@ void ScalableTSDFVolume::Integrate(
                 "[ScalableTSDFVolume::Integrate] Unsupported image format.\n");
         return;
     }
+    access_stamp_++;
     auto depth2cameradistance =
             geometry::Image::CreateDepthToCameraDistanceMultiplierFloatImage(
                     intrinsic);
-    auto pointcloud = geometry::PointCloud::CreateFromDepthImage(
-            image.depth_, intrinsic, extrinsic, 1000.0, 1000.0,
-            depth_sampling_stride_);
+    // The depth image is split into blocks of depth_sampling_stride_ pixels
+    // squared. Every block covers the units around the frustum section
+    // between its nearest and farthest depth, so larger strides allocate
+    // fewer candidates without missing any pixel. The depths of a block are
+    // split where they jump by more than a unit, so that the empty space
+    // between a foreground and a background surface is not allocated.
+    const int stride = std::max(depth_sampling_stride_, 1);
+    const int width = image.depth_.width_;
+    const int height = image.depth_.height_;
+    const int block_rows = (height + stride - 1) / stride;
+    const Eigen::Matrix4d camera_pose = extrinsic.inverse();
+    const Eigen::Matrix3d rotation = camera_pose.block<3, 3>(0, 0);
+    const Eigen::Vector3d translation = camera_pose.block<3, 1>(0, 3);
+    const auto focal_length = intrinsic.GetFocalLength();
+    const auto principal_point = intrinsic.GetPrincipalPoint();
+    const double margin = sdf_trunc_;
+    const double unit_length = volume_unit_length_;
+    std::vector<std::vector<Eigen::Vector3i>> block_row_units(block_rows);
+    std::vector<double> block_row_depth_max(block_rows, 0.0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int block_row = 0; block_row < block_rows; block_row++) {
+        const int v0 = block_row * stride;
+        const int v1 = std::min(v0 + stride, height) - 1;
+        const double y0 = (v0 - principal_point.second) / focal_length.second;
+        const double y1 = (v1 - principal_point.second) / focal_length.second;
+        std::vector<float> depths;
+        auto &units = block_row_units[block_row];
+        for (int u0 = 0; u0 < width; u0 += stride) {
+            const int u1 = std::min(u0 + stride, width) - 1;
+            depths.clear();
+            for (int v = v0; v <= v1; v++) {
+                const float *row = image.depth_.PointerAt<float>(0, v);
+                for (int u = u0; u <= u1; u++) {
+                    // Also skips NaN depth.
+                    if (row[u] > 0.0f) depths.push_back(row[u]);
+                }
+            }
+            if (depths.empty()) continue;
+            std::sort(depths.begin(), depths.end());
+            block_row_depth_max[block_row] = std::max(
+                    block_row_depth_max[block_row], double(depths.back()));
+            const double x0 = (u0 - principal_point.first) / focal_length.first;
+            const double x1 = (u1 - principal_point.first) / focal_length.first;
+            size_t begin = 0;
+            while (begin < depths.size()) {
+                size_t end = begin + 1;
+                while (end < depths.size() &&
+                       depths[end] - depths[end - 1] <= unit_length) {
+                    end++;
+                }
+                // The frustum section is the hull of its eight corners.
+                Eigen::Vector3d min_bound = Eigen::Vector3d::Constant(
+                        std::numeric_limits<double>::max());
+                Eigen::Vector3d max_bound = -min_bound;
+                for (double d : {double(depths[begin]),
+                                 double(depths[end - 1])}) {
+                    for (double x : {x0, x1}) {
+                        for (double y : {y0, y1}) {
+                            Eigen::Vector3d point =
+                                    rotation * Eigen::Vector3d(x * d, y * d,
+                                                               d) +
+                                    translation;
+                            min_bound = min_bound.cwiseMin(point);
+                            max_bound = max_bound.cwiseMax(point);
+                        }
+                    }
+                }
+                auto min_index = LocateVolumeUnit(
+                        min_bound - Eigen::Vector3d::Constant(margin));
+                auto max_index = LocateVolumeUnit(
+                        max_bound + Eigen::Vector3d::Constant(margin));
+                for (auto x = min_index(0); x <= max_index(0); x++) {
+                    for (auto y = min_index(1); y <= max_index(1); y++) {
+                        for (auto z = min_index(2); z <= max_index(2); z++) {
+                            units.emplace_back(x, y, z);
+                        }
+                    }
+                }
+                begin = end;
+            }
+        }
+        // Neighbouring blocks mostly touch the same units.
+        std::sort(units.begin(), units.end(), LexicographicLess);
+        units.erase(std::unique(units.begin(), units.end()), units.end());
+    }
+    // The largest depth bounds the part of each volume unit that is visited.
+    double depth_max = 0.0;
+    for (double d : block_row_depth_max) {
+        depth_max = std::max(depth_max, d);
+    }
     std::unordered_set<Eigen::Vector3i,
                        utility::hash_eigen::hash<Eigen::Vector3i>>
             touched_volume_units_;
-    for (const auto &point : pointcloud->points_) {
-        auto min_bound = LocateVolumeUnit(
-                point - Eigen::Vector3d(sdf_trunc_, sdf_trunc_, sdf_trunc_));
-        auto max_bound = LocateVolumeUnit(
-                point + Eigen::Vector3d(sdf_trunc_, sdf_trunc_, sdf_trunc_));
-        for (auto x = min_bound(0); x <= max_bound(0); x++) {
-            for (auto y = min_bound(1); y <= max_bound(1); y++) {
-                for (auto z = min_bound(2); z <= max_bound(2); z++) {
-                    auto loc = Eigen::Vector3i(x, y, z);
-                    if (touched_volume_units_.find(loc) ==
-                        touched_volume_units_.end()) {
-                        touched_volume_units_.insert(loc);
-                        auto volume = OpenVolumeUnit(Eigen::Vector3i(x, y, z));
-                        volume->IntegrateWithDepthToCameraDistanceMultiplier(
-                                image, intrinsic, extrinsic,
-                                *depth2cameradistance);
-                    }
+    for (const auto &units : block_row_units) {
+        for (const auto &loc : units) {
+            if (touched_volume_units_.find(loc) ==
+                touched_volume_units_.end()) {
+                touched_volume_units_.insert(loc);
+                auto volume = OpenVolumeUnit(loc);
+                if (!volume) {
+                    continue;
                 }
+                dirty_volume_units_.insert(loc);
+                volume->IntegrateWithDepthToCameraDistanceMultiplier(
+                        image, intrinsic, extrinsic, *depth2cameradistance,
+                        depth_max);
             }
         }
     }
+    if (store_) {
+        Eigen::Vector3d camera_center =
+                extrinsic.inverse().block<3, 1>(0, 3);
+        EvictVolumeUnits(camera_center, false);
+    }
 }
 
 std::shared_ptr<geometry::PointCloud> ScalableTSDFVolume::ExtractPointCloud() {
@@ -111,7 +623,16 @@ std::shared_ptr<geometry::PointCloud> ScalableTSDFVolume::ExtractPointCloud() {
     double half_voxel_length = voxel_length_ * 0.5;
     float w0, w1, f0, f1;
     Eigen::Vector3f c0, c1;
-    for (const auto &unit : volume_units_) {
+    for (const auto &index : GetVolumeUnitIndices()) {
+        // Normals are interpolated from the units on both sides.
+        PageInVolumeUnits(index - Eigen::Vector3i::Ones(),
+                          index + Eigen::Vector3i::Ones());
+        auto unit_itr = volume_units_.find(index);
+        if (unit_itr == volume_units_.end()) {
+            // The unit could not be paged in.
+            continue;
+        }
+        const auto &unit = *unit_itr;
         if (unit.second.volume_) {
             const auto &volume0 = *unit.second.volume_;
             const auto &index0 = unit.second.index_;
@@ -210,6 +731,52 @@ std::shared_ptr<geometry::PointCloud> ScalableTSDFVolume::ExtractPointCloud() {
 
 std::shared_ptr<geometry::TriangleMesh>
 ScalableTSDFVolume::ExtractTriangleMesh() {
+    return ExtractTriangleMeshOfVolumeUnits(GetVolumeUnitIndices());
+}
+
+std::vector<std::pair<Eigen::Vector3i, std::shared_ptr<geometry::TriangleMesh>>>
+ScalableTSDFVolume::ExtractDirtyTriangleMeshes() {
+    // The cubes of a unit reach into the units after it along every axis.
+    std::unordered_set<Eigen::Vector3i,
+                       utility::hash_eigen::hash<Eigen::Vector3i>>
+            chunk_set;
+    for (const auto &index : dirty_volume_units_) {
+        for (int i = 0; i < 8; i++) {
+            Eigen::Vector3i chunk = index - shift[i];
+            if (volume_units_.find(chunk) != volume_units_.end() ||
+                (store_ && store_->Contains(chunk))) {
+                chunk_set.insert(chunk);
+            }
+        }
+    }
+    std::vector<Eigen::Vector3i> chunks(chunk_set.begin(), chunk_set.end());
+    std::sort(chunks.begin(), chunks.end(), LexicographicLess);
+    std::vector<
+            std::pair<Eigen::Vector3i, std::shared_ptr<geometry::TriangleMesh>>>
+            meshes;
+    meshes.reserve(chunks.size());
+    for (const auto &chunk : chunks) {
+        meshes.push_back(
+                std::make_pair(chunk, ExtractVolumeUnitTriangleMesh(chunk)));
+    }
+    dirty_volume_units_.clear();
+    return meshes;
+}
+
+std::shared_ptr<geometry::TriangleMesh>
+ScalableTSDFVolume::ExtractVolumeUnitTriangleMesh(
+        const Eigen::Vector3i &index) {
+    if (volume_units_.find(index) == volume_units_.end() &&
+        !(store_ && store_->Contains(index))) {
+        return std::make_shared<geometry::TriangleMesh>();
+    }
+    return ExtractTriangleMeshOfVolumeUnits(
+            std::vector<Eigen::Vector3i>(1, index));
+}
+
+std::shared_ptr<geometry::TriangleMesh>
+ScalableTSDFVolume::ExtractTriangleMeshOfVolumeUnits(
+        const std::vector<Eigen::Vector3i> &indices) {
     // implementation of marching cubes, based on
     // http://paulbourke.net/geometry/polygonise/
     auto mesh = std::make_shared<geometry::TriangleMesh>();
@@ -220,7 +787,14 @@ ScalableTSDFVolume::ExtractTriangleMesh() {
             Eigen::aligned_allocator<std::pair<const Eigen::Vector4i, int>>>
             edgeindex_to_vertexindex;
     int edge_to_index[12];
-    for (const auto &unit : volume_units_) {
+    for (const auto &index : indices) {
+        PageInVolumeUnits(index, index + Eigen::Vector3i::Ones());
+        auto unit_itr = volume_units_.find(index);
+        if (unit_itr == volume_units_.end()) {
+            // The unit could not be paged in.
+            continue;
+        }
+        const auto &unit = *unit_itr;
         if (unit.second.volume_) {
             const auto &volume0 = *unit.second.volume_;
             const auto &index0 = unit.second.index_;
@@ -361,7 +935,14 @@ ScalableTSDFVolume::ExtractTriangleMesh() {
 std::shared_ptr<geometry::PointCloud>
 ScalableTSDFVolume::ExtractVoxelPointCloud() {
     auto voxel = std::make_shared<geometry::PointCloud>();
-    for (auto &unit : volume_units_) {
+    for (const auto &index : GetVolumeUnitIndices()) {
+        PageInVolumeUnits(index, index);
+        auto unit_itr = volume_units_.find(index);
+        if (unit_itr == volume_units_.end()) {
+            // The unit could not be paged in.
+            continue;
+        }
+        const auto &unit = *unit_itr;
         if (unit.second.volume_) {
             auto v = unit.second.volume_->ExtractVoxelPointCloud();
             *voxel += *v;
@@ -370,6 +951,91 @@ ScalableTSDFVolume::ExtractVoxelPointCloud() {
     return voxel;
 }
 
+void ScalableTSDFVolume::Raycast(
+        const camera::PinholeCameraIntrinsic &intrinsic,
+        const Eigen::Matrix4d &extrinsic,
+        geometry::Image &depth,
+        geometry::Image &normal,
+        geometry::Image &color,
+        double depth_min /* = 0.1*/,
+        double depth_max /* = 3.0*/) const {
+    OPEN3D_PROFILE_ZONE("ScalableTSDFVolume::Raycast");
+    const int width = intrinsic.width_;
+    const int height = intrinsic.height_;
+    depth.Prepare(width, height, 1, 4);
+    normal.Prepare(width, height, 3, 4);
+    if (color_type_ == TSDFVolumeColorType::RGB8) {
+        color.Prepare(width, height, 3, 1);
+    } else if (color_type_ == TSDFVolumeColorType::Gray32) {
+        color.Prepare(width, height, 1, 4);
+    } else {
+        color.Clear();
+    }
+
+    const double fx = intrinsic.GetFocalLength().first;
+    const double fy = intrinsic.GetFocalLength().second;
+    const double cx = intrinsic.GetPrincipalPoint().first;
+    const double cy = intrinsic.GetPrincipalPoint().second;
+    const Eigen::Matrix3d rotation = extrinsic.block<3, 3>(0, 0);
+    const Eigen::Vector3d camera_center =
+            -rotation.transpose() * extrinsic.block<3, 1>(0, 3);
+    const Eigen::Vector3d half_voxel(0.5, 0.5, 0.5);
+
+    const VolumeUnitTable table(*this);
+    // Neighboring rays visit the same volume units, so every thread marches
+    // the rays of one tile at a time.
+    const int tile_size = 16;
+    const int tiles_x = (width + tile_size - 1) / tile_size;
+    const int tiles_y = (height + tile_size - 1) / tile_size;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int tile = 0; tile < tiles_x * tiles_y; tile++) {
+        VoxelSampler sampler(table, volume_unit_resolution_);
+        const int u0 = (tile % tiles_x) * tile_size;
+        const int v0 = (tile / tiles_x) * tile_size;
+        const int u1 = std::min(u0 + tile_size, width);
+        const int v1 = std::min(v0 + tile_size, height);
+        for (int v = v0; v < v1; v++) {
+            for (int u = u0; u < u1; u++) {
+                Eigen::Vector3d ray =
+                        rotation.transpose() *
+                        Eigen::Vector3d((u - cx) / fx, (v - cy) / fy, 1.0);
+                double t_hit = 0.0;
+                Eigen::Vector3d n(0.0, 0.0, 0.0);
+                Eigen::Vector3d c(0.0, 0.0, 0.0);
+                if (MarchRay(*this, table, sampler, camera_center, ray,
+                             depth_min, depth_max, t_hit)) {
+                    Eigen::Vector3d p_grid =
+                            (camera_center + t_hit * ray) / voxel_length_ -
+                            half_voxel;
+                    double f;
+                    if (sampler.Interpolate(p_grid, f, &c, &n)) {
+                        n = (rotation * n).normalized();
+                    } else {
+                        n.setZero();
+                        c.setZero();
+                    }
+                } else {
+                    t_hit = 0.0;
+                }
+                *depth.PointerAt<float>(u, v) = float(t_hit);
+                for (int i = 0; i < 3; i++) {
+                    *normal.PointerAt<float>(u, v, i) = float(n(i));
+                }
+                if (color_type_ == TSDFVolumeColorType::RGB8) {
+                    for (int i = 0; i < 3; i++) {
+                        *color.PointerAt<uint8_t>(u, v, i) = uint8_t(
+                                std::min(std::max(c(i) + 0.5, 0.0), 255.0));
+                    }
+                } else if (color_type_ == TSDFVolumeColorType::Gray32) {
+                    *color.PointerAt<float>(u, v) = float(c(0));
+                }
+            }
+        }
+    }
+}
+
 std::shared_ptr<UniformTSDFVolume> ScalableTSDFVolume::OpenVolumeUnit(
         const Eigen::Vector3i &index) {
     auto &unit = volume_units_[index];
@@ -378,10 +1044,161 @@ std::shared_ptr<UniformTSDFVolume> ScalableTSDFVolume::OpenVolumeUnit(
                 volume_unit_length_, volume_unit_resolution_, sdf_trunc_,
                 color_type_, index.cast<double>() * volume_unit_length_));
         unit.index_ = index;
+        if (store_ && store_->Contains(index)) {
+            if (!store_->Read(index, *unit.volume_)) {
+                // The block stays in the store, so its data is not lost.
+                utility::LogWarning(
+                        "[ScalableTSDFVolume] Volume unit ({}, {}, {}) stays "
+                        "paged out.\n",
+                        index(0), index(1), index(2));
+                volume_units_.erase(index);
+                return nullptr;
+            }
+            store_->Erase(index);
+        }
     }
+    unit.last_used_ = access_stamp_;
     return unit.volume_;
 }
 
+bool ScalableTSDFVolume::EnablePaging(
+        const std::string &filename,
+        size_t max_volume_units,
+        VolumeUnitEvictionPolicy policy /* = LeastRecentlyUsed*/) {
+    if (store_) {
+        utility::LogWarning(
+                "[ScalableTSDFVolume::EnablePaging] Paging is already "
+                "enabled.\n");
+        return false;
+    }
+    auto store = std::make_shared<VolumeUnitStore>();
+    if (!store->Open(filename)) {
+        return false;
+    }
+    store_ = store;
+    max_volume_units_ = max_volume_units;
+    eviction_policy_ = policy;
+    return true;
+}
+
+bool ScalableTSDFVolume::DisablePaging() {
+    if (!store_) {
+        return false;
+    }
+    bool success = true;
+    for (const auto &index : store_->GetIndices()) {
+        if (!OpenVolumeUnit(index)) {
+            success = false;
+        }
+    }
+    if (!success) {
+        utility::LogWarning(
+                "[ScalableTSDFVolume::DisablePaging] Not all volume units "
+                "could be read, paging stays enabled.\n");
+        return false;
+    }
+    store_.reset();
+    return true;
+}
+
+size_t ScalableTSDFVolume::GetVolumeUnitCount() const {
+    return volume_units_.size() + GetPagedVolumeUnitCount();
+}
+
+size_t ScalableTSDFVolume::GetPagedVolumeUnitCount() const {
+    return store_ ? store_->Size() : 0;
+}
+
+std::vector<Eigen::Vector3i> ScalableTSDFVolume::GetPagedVolumeUnitIndices()
+        const {
+    return store_ ? store_->GetIndices() : std::vector<Eigen::Vector3i>();
+}
+
+bool ScalableTSDFVolume::ReadPagedVolumeUnit(const Eigen::Vector3i &index,
+                                             UniformTSDFVolume &volume) const {
+    return store_ && store_->Read(index, volume);
+}
+
+std::vector<Eigen::Vector3i> ScalableTSDFVolume::GetVolumeUnitIndices()
+        const {
+    std::vector<Eigen::Vector3i> indices;
+    indices.reserve(GetVolumeUnitCount());
+    for (const auto &unit : volume_units_) {
+        indices.push_back(unit.first);
+    }
+    if (store_) {
+        // Visiting the units in index order pages each of them in about once.
+        auto paged = store_->GetIndices();
+        indices.insert(indices.end(), paged.begin(), paged.end());
+        std::sort(indices.begin(), indices.end(), LexicographicLess);
+    }
+    return indices;
+}
+
+void ScalableTSDFVolume::PageInVolumeUnits(const Eigen::Vector3i &min_index,
+                                           const Eigen::Vector3i &max_index) {
+    if (!store_) {
+        return;
+    }
+    access_stamp_++;
+    for (int x = min_index(0); x <= max_index(0); x++) {
+        for (int y = min_index(1); y <= max_index(1); y++) {
+            for (int z = min_index(2); z <= max_index(2); z++) {
+                Eigen::Vector3i index(x, y, z);
+                auto unit_itr = volume_units_.find(index);
+                if (unit_itr != volume_units_.end()) {
+                    unit_itr->second.last_used_ = access_stamp_;
+                } else if (store_->Contains(index)) {
+                    OpenVolumeUnit(index);
+                }
+            }
+        }
+    }
+    Eigen::Vector3d center = (min_index + max_index + Eigen::Vector3i::Ones())
+                                     .cast<double>() *
+                             (0.5 * volume_unit_length_);
+    EvictVolumeUnits(center, true);
+}
+
+void ScalableTSDFVolume::EvictVolumeUnits(const Eigen::Vector3d &camera_center,
+                                          bool keep_current) {
+    if (volume_units_.size() <= max_volume_units_) {
+        return;
+    }
+    // Larger scores are evicted first.
+    std::vector<std::pair<double, Eigen::Vector3i>> candidates;
+    candidates.reserve(volume_units_.size());
+    for (const auto &unit : volume_units_) {
+        if (keep_current && unit.second.last_used_ == access_stamp_) {
+            continue;
+        }
+        double score;
+        if (eviction_policy_ == VolumeUnitEvictionPolicy::CameraDistance) {
+            Eigen::Vector3d center = (unit.first.cast<double>() +
+                                      Eigen::Vector3d(0.5, 0.5, 0.5)) *
+                                     volume_unit_length_;
+            score = (center - camera_center).squaredNorm();
+        } else {
+            score = -double(unit.second.last_used_);
+        }
+        candidates.push_back(std::make_pair(score, unit.first));
+    }
+    size_t num_evicted = std::min(candidates.size(),
+                                  volume_units_.size() - max_volume_units_);
+    std::nth_element(candidates.begin(), candidates.begin() + num_evicted,
+                     candidates.end(),
+                     [](const std::pair<double, Eigen::Vector3i> &a,
+                        const std::pair<double, Eigen::Vector3i> &b) {
+                         return a.first > b.first;
+                     });
+    for (size_t i = 0; i < num_evicted; i++) {
+        auto unit_itr = volume_units_.find(candidates[i].second);
+        if (store_->Write(unit_itr->first, *unit_itr->second.volume_)) {
+            volume_units_.erase(unit_itr);
+        }
+    }
+}
+
 Eigen::Vector3d ScalableTSDFVolume::GetNormalAt(const Eigen::Vector3d &p) {
     Eigen::Vector3d n;
     const double half_gap = 0.99 * voxel_length_;
@@ -27,7 +27,11 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "Open3D/Integration/TSDFVolume.h"
 #include "Open3D/Utility/Helper.h"
@@ -36,6 +40,16 @@ namespace open3d {
 namespace integration {
 
 class UniformTSDFVolume;
+class VolumeUnitStore;
+
+/// Chooses the volume units that a ScalableTSDFVolume pages out when it holds
+/// more units in memory than its budget.
+enum class VolumeUnitEvictionPolicy {
+    /// Units that have been integrated or read least recently.
+    LeastRecentlyUsed = 0,
+    /// Units farthest from the camera of the last integrated frame.
+    CameraDistance = 1,
+};
 
 /// Class that implements a more memory efficient data structure for volumetric
 /// integration
@@ -59,11 +73,13 @@ class ScalableTSDFVolume : public TSDFVolume {
 public:
     struct VolumeUnit {
     public:
-        VolumeUnit() : volume_(NULL) {}
+        VolumeUnit() : volume_(NULL), last_used_(0) {}
 
     public:
         std::shared_ptr<UniformTSDFVolume> volume_;
         Eigen::Vector3i index_;
+        /// Access stamp for paging, see EnablePaging.
+        size_t last_used_;
     };
 
 public:
@@ -72,6 +88,11 @@ public:
                        TSDFVolumeColorType color_type,
                        int volume_unit_resolution = 16,
                        int depth_sampling_stride = 4);
+    /// Copies own their volume units, all in memory: the paged units of
+    /// \p other are read into the copy, which does not page, and \p other
+    /// keeps its file.
+    ScalableTSDFVolume(const ScalableTSDFVolume &other);
+    ScalableTSDFVolume &operator=(const ScalableTSDFVolume &other);
     ~ScalableTSDFVolume() override;
 
 public:
@@ -83,9 +104,71 @@ public:
     std::shared_ptr<geometry::TriangleMesh> ExtractTriangleMesh() override;
     std::shared_ptr<geometry::PointCloud> ExtractVoxelPointCloud();
 
+    /// Meshes the volume units in dirty_volume_units_ and the units whose
+    /// cubes reach into them, for a live preview, and clears
+    /// dirty_volume_units_. Every unit gets its own mesh chunk that replaces
+    /// the chunk returned for it before. Vertices on the border of two units
+    /// are repeated in both chunks, and a chunk without surface is empty.
+    std::vector<std::pair<Eigen::Vector3i,
+                          std::shared_ptr<geometry::TriangleMesh>>>
+    ExtractDirtyTriangleMeshes();
+    /// Mesh chunk of the volume unit \p index as in
+    /// ExtractDirtyTriangleMeshes.
+    std::shared_ptr<geometry::TriangleMesh> ExtractVolumeUnitTriangleMesh(
+            const Eigen::Vector3i &index);
+
+    /// Renders the surface seen by a pinhole camera, e.g. as the model frame
+    /// of KinectFusion-style tracking. A ray is marched through every pixel:
+    /// volume units that are not allocated are skipped as a whole, the TSDF is
+    /// interpolated trilinearly, and the first crossing from positive to
+    /// negative TSDF is refined by linear interpolation.
+    /// Pixels without a surface between \p depth_min and \p depth_max are 0 in
+    /// all outputs.
+    /// \param depth Float image of the depth in meters.
+    /// \param normal Three channel float image of unit normals in camera
+    /// coordinates.
+    /// \param color Three channel uint8 image for RGB8 volumes, float image
+    /// for Gray32 volumes and empty image otherwise.
+    void Raycast(const camera::PinholeCameraIntrinsic &intrinsic,
+                 const Eigen::Matrix4d &extrinsic,
+                 geometry::Image &depth,
+                 geometry::Image &normal,
+                 geometry::Image &color,
+                 double depth_min = 0.1,
+                 double depth_max = 3.0) const;
+
+    /// Bounds the memory of the volume by keeping at most
+    /// \p max_volume_units volume units in volume_units_. After every
+    /// integrated frame, units chosen by \p policy are written to the file
+    /// \p filename and removed from memory until a later frame touches them
+    /// again. Extraction streams over all units in index order and keeps only
+    /// the neighbourhood of the current unit in memory besides the budget.
+    /// Raycast only sees the units in memory. Copies of the volume do not
+    /// page. Units already in memory stay there, and the file is replaced if
+    /// it exists. A unit that cannot be read back stays in the file and is
+    /// skipped with a warning.
+    bool EnablePaging(const std::string &filename,
+                      size_t max_volume_units,
+                      VolumeUnitEvictionPolicy policy =
+                              VolumeUnitEvictionPolicy::LeastRecentlyUsed);
+    /// Reads all paged volume units back into memory and removes the file.
+    /// Returns false, and keeps paging, if a unit cannot be read back.
+    bool DisablePaging();
+    bool IsPagingEnabled() const { return bool(store_); }
+    /// Number of volume units in memory and paged out.
+    size_t GetVolumeUnitCount() const;
+    size_t GetPagedVolumeUnitCount() const;
+    std::vector<Eigen::Vector3i> GetPagedVolumeUnitIndices() const;
+    /// Reads the paged volume unit \p index into \p volume, which must have
+    /// the resolution and color type of the units, and keeps it paged out.
+    bool ReadPagedVolumeUnit(const Eigen::Vector3i &index,
+                             UniformTSDFVolume &volume) const;
+
 public:
     int volume_unit_resolution_;
     double volume_unit_length_;
+    /// Size in pixels of the depth image blocks that select the volume units
+    /// of Integrate. Every pixel is covered for any stride.
     int depth_sampling_stride_;
 
     /// Assume the index of the volume unit is (x, y, z), then the unit spans
@@ -96,6 +179,12 @@ public:
                        utility::hash_eigen::hash<Eigen::Vector3i>>
             volume_units_;
 
+    /// Indices of the volume units that Integrate modified since the last
+    /// call of ExtractDirtyTriangleMeshes.
+    std::unordered_set<Eigen::Vector3i,
+                       utility::hash_eigen::hash<Eigen::Vector3i>>
+            dirty_volume_units_;
+
 private:
     Eigen::Vector3i LocateVolumeUnit(const Eigen::Vector3d &point) {
         return Eigen::Vector3i((int)std::floor(point(0) / volume_unit_length_),
@@ -103,12 +192,42 @@ private:
                                (int)std::floor(point(2) / volume_unit_length_));
     }
 
+    /// Returns the unit \p index, created or read back from the store if it is
+    /// not in memory. Returns nullptr if the unit cannot be read back.
     std::shared_ptr<UniformTSDFVolume> OpenVolumeUnit(
             const Eigen::Vector3i &index);
 
+    /// Replaces volume_units_ with copies of the units of \p other, in memory
+    /// and paged out.
+    void CopyVolumeUnits(const ScalableTSDFVolume &other);
+
+    /// Marching cubes over the cubes of the volume units \p indices.
+    std::shared_ptr<geometry::TriangleMesh> ExtractTriangleMeshOfVolumeUnits(
+            const std::vector<Eigen::Vector3i> &indices);
+
+    /// Indices of all volume units in the order extraction visits them.
+    std::vector<Eigen::Vector3i> GetVolumeUnitIndices() const;
+
+    /// Reads the paged units between \p min_index and \p max_index back into
+    /// memory and evicts other units if the budget is exceeded.
+    void PageInVolumeUnits(const Eigen::Vector3i &min_index,
+                           const Eigen::Vector3i &max_index);
+
+    /// Pages out units until at most max_volume_units_ remain in memory. Units
+    /// with the current access stamp are kept if \p keep_current is true.
+    void EvictVolumeUnits(const Eigen::Vector3d &camera_center,
+                          bool keep_current);
+
     Eigen::Vector3d GetNormalAt(const Eigen::Vector3d &p);
 
     double GetTSDFAt(const Eigen::Vector3d &p);
+
+private:
+    std::shared_ptr<VolumeUnitStore> store_;
+    size_t max_volume_units_ = 0;
+    VolumeUnitEvictionPolicy eviction_policy_ =
+            VolumeUnitEvictionPolicy::LeastRecentlyUsed;
+    size_t access_stamp_ = 0;
 };
 
 }  // namespace integration
@@ -26,17 +26,58 @@
 
 #include "Open3D/Integration/UniformTSDFVolume.h"
 
+#include <algorithm>
 #include <iostream>
 #include <thread>
-#include <unordered_map>
 
 #include "Open3D/Geometry/VoxelGrid.h"
 #include "Open3D/Integration/MarchingCubesConst.h"
 #include "Open3D/Utility/Helper.h"
+#include "Open3D/Utility/Profiler.h"
 
 namespace open3d {
 namespace integration {
 
+namespace {
+
+/// Marching cubes output of the cubes between the x slices x and x + 1, with
+/// vertex indices local to the slab.
+struct MeshSlab {
+    std::vector<Eigen::Vector3d> vertices_;
+    std::vector<Eigen::Vector3d> vertex_colors_;
+    std::vector<Eigen::Vector3i> triangles_;
+    /// Edge of each vertex, (x_edge - x) * resolution^2 * 3 +
+    /// (y_edge * resolution + z_edge) * 3 + direction.
+    std::vector<int> edges_;
+    /// Sorted (edge in the slice, vertex) pairs of the vertices on y and z
+    /// edges of slice x and on slice x + 1.
+    std::vector<std::pair<int, int>> near_;
+    std::vector<std::pair<int, int>> far_;
+    /// Vertex of the previous slab each vertex repeats, or -1.
+    std::vector<int> vertex_to_previous_;
+    std::vector<int> vertex_to_mesh_;
+};
+
+/// Concatenates the outputs of the slices in order.
+template <typename T>
+void ConcatenateSlices(const std::vector<std::vector<T>> &slices,
+                       std::vector<T> &output) {
+    std::vector<size_t> offsets(slices.size() + 1, 0);
+    for (size_t i = 0; i < slices.size(); i++) {
+        offsets[i + 1] = offsets[i] + slices[i].size();
+    }
+    output.resize(offsets.back());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < (int)slices.size(); i++) {
+        std::copy(slices[i].begin(), slices[i].end(),
+                  output.begin() + offsets[i]);
+    }
+}
+
+}  // unnamed namespace
+
 UniformTSDFVolume::UniformTSDFVolume(
         double length,
         int resolution,
@@ -59,6 +100,7 @@ void UniformTSDFVolume::Integrate(
         const geometry::RGBDImage &image,
         const camera::PinholeCameraIntrinsic &intrinsic,
         const Eigen::Matrix4d &extrinsic) {
+    OPEN3D_PROFILE_ZONE("UniformTSDFVolume::Integrate");
     // This function goes through the voxels, and scan convert the relative
     // depth/color value into the voxel.
     // The following implementation is a highly optimized version.
@@ -92,7 +134,19 @@ void UniformTSDFVolume::Integrate(
 std::shared_ptr<geometry::PointCloud> UniformTSDFVolume::ExtractPointCloud() {
     auto pointcloud = std::make_shared<geometry::PointCloud>();
     double half_voxel_length = voxel_length_ * 0.5;
+    // Every x slice gets its own output, the outputs are concatenated in
+    // order.
+    const int num_slices = std::max(resolution_ - 2, 0);
+    std::vector<std::vector<Eigen::Vector3d>> slice_points(num_slices);
+    std::vector<std::vector<Eigen::Vector3d>> slice_colors(num_slices);
+    std::vector<std::vector<Eigen::Vector3d>> slice_normals(num_slices);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
     for (int x = 1; x < resolution_ - 1; x++) {
+        auto &points = slice_points[x - 1];
+        auto &colors = slice_colors[x - 1];
+        auto &normals = slice_normals[x - 1];
         for (int y = 1; y < resolution_ - 1; y++) {
             for (int z = 1; z < resolution_ - 1; z++) {
                 Eigen::Vector3i idx0(x, y, z);
@@ -122,26 +176,29 @@ std::shared_ptr<geometry::PointCloud> UniformTSDFVolume::ExtractPointCloud() {
                             float r1 = std::fabs(f1);
                             Eigen::Vector3d p = p0;
                             p(i) = (p0(i) * r1 + p1(i) * r0) / (r0 + r1);
-                            pointcloud->points_.push_back(p + origin_);
+                            points.push_back(p + origin_);
                             if (color_type_ == TSDFVolumeColorType::RGB8) {
-                                pointcloud->colors_.push_back(
+                                colors.push_back(
                                         ((c0 * r1 + c1 * r0) / (r0 + r1) /
                                          255.0f)
                                                 .cast<double>());
                             } else if (color_type_ ==
                                        TSDFVolumeColorType::Gray32) {
-                                pointcloud->colors_.push_back(
+                                colors.push_back(
                                         ((c0 * r1 + c1 * r0) / (r0 + r1))
                                                 .cast<double>());
                             }
                             // has_normal
-                            pointcloud->normals_.push_back(GetNormalAt(p));
+                            normals.push_back(GetNormalAt(p));
                         }
                     }
                 }
             }
         }
     }
+    ConcatenateSlices(slice_points, pointcloud->points_);
+    ConcatenateSlices(slice_colors, pointcloud->colors_);
+    ConcatenateSlices(slice_normals, pointcloud->normals_);
     return pointcloud;
 }
 
@@ -149,83 +206,197 @@ std::shared_ptr<geometry::TriangleMesh>
 UniformTSDFVolume::ExtractTriangleMesh() {
     // implementation of marching cubes, based on
     // http://paulbourke.net/geometry/polygonise/
+    // The slabs of cubes between two x slices are meshed in parallel, then
+    // the vertices that a slab shares with the previous one are merged. The
+    // mesh is the same as if the cubes were visited in order.
     auto mesh = std::make_shared<geometry::TriangleMesh>();
     double half_voxel_length = voxel_length_ * 0.5;
-    // Map of "edge_index = (x, y, z, 0) + edge_shift" to "global vertex index"
-    std::unordered_map<
-            Eigen::Vector4i, int, utility::hash_eigen::hash<Eigen::Vector4i>,
-            std::equal_to<Eigen::Vector4i>,
-            Eigen::aligned_allocator<std::pair<const Eigen::Vector4i, int>>>
-            edgeindex_to_vertexindex;
-    int edge_to_index[12];
-    for (int x = 0; x < resolution_ - 1; x++) {
-        for (int y = 0; y < resolution_ - 1; y++) {
-            for (int z = 0; z < resolution_ - 1; z++) {
-                int cube_index = 0;
-                float f[8];
-                Eigen::Vector3d c[8];
-                for (int i = 0; i < 8; i++) {
-                    Eigen::Vector3i idx = Eigen::Vector3i(x, y, z) + shift[i];
+    const int num_slabs = std::max(resolution_ - 1, 0);
+    const int slice_edge_num = resolution_ * resolution_ * 3;
+    std::vector<MeshSlab> slabs(num_slabs);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        // Local vertex index of the edges of the two slices of a slab.
+        std::vector<int> edge_to_vertex(2 * size_t(slice_edge_num), -1);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+        for (int x = 0; x < num_slabs; x++) {
+            auto &slab = slabs[x];
+            int edge_to_index[12];
+            for (int y = 0; y < resolution_ - 1; y++) {
+                for (int z = 0; z < resolution_ - 1; z++) {
+                    int cube_index = 0;
+                    float f[8];
+                    Eigen::Vector3d c[8];
+                    for (int i = 0; i < 8; i++) {
+                        Eigen::Vector3i idx =
+                                Eigen::Vector3i(x, y, z) + shift[i];
 
-                    if (voxels_[IndexOf(idx)].weight_ == 0.0f) {
-                        cube_index = 0;
-                        break;
-                    } else {
-                        f[i] = voxels_[IndexOf(idx)].tsdf_;
-                        if (f[i] < 0.0f) {
-                            cube_index |= (1 << i);
-                        }
-                        if (color_type_ == TSDFVolumeColorType::RGB8) {
-                            c[i] = voxels_[IndexOf(idx)].color_.cast<double>() /
-                                   255.0;
-                        } else if (color_type_ == TSDFVolumeColorType::Gray32) {
-                            c[i] = voxels_[IndexOf(idx)].color_.cast<double>();
+                        if (voxels_[IndexOf(idx)].weight_ == 0.0f) {
+                            cube_index = 0;
+                            break;
+                        } else {
+                            f[i] = voxels_[IndexOf(idx)].tsdf_;
+                            if (f[i] < 0.0f) {
+                                cube_index |= (1 << i);
+                            }
+                            if (color_type_ == TSDFVolumeColorType::RGB8) {
+                                c[i] = voxels_[IndexOf(idx)]
+                                               .color_.cast<double>() /
+                                       255.0;
+                            } else if (color_type_ ==
+                                       TSDFVolumeColorType::Gray32) {
+                                c[i] = voxels_[IndexOf(idx)]
+                                               .color_.cast<double>();
+                            }
                         }
                     }
-                }
-                if (cube_index == 0 || cube_index == 255) {
-                    continue;
-                }
-                for (int i = 0; i < 12; i++) {
-                    if (edge_table[cube_index] & (1 << i)) {
-                        Eigen::Vector4i edge_index =
-                                Eigen::Vector4i(x, y, z, 0) + edge_shift[i];
-                        if (edgeindex_to_vertexindex.find(edge_index) ==
-                            edgeindex_to_vertexindex.end()) {
-                            edge_to_index[i] = (int)mesh->vertices_.size();
-                            edgeindex_to_vertexindex[edge_index] =
-                                    (int)mesh->vertices_.size();
-                            Eigen::Vector3d pt(
-                                    half_voxel_length +
-                                            voxel_length_ * edge_index(0),
-                                    half_voxel_length +
-                                            voxel_length_ * edge_index(1),
-                                    half_voxel_length +
-                                            voxel_length_ * edge_index(2));
-                            double f0 = std::abs((double)f[edge_to_vert[i][0]]);
-                            double f1 = std::abs((double)f[edge_to_vert[i][1]]);
-                            pt(edge_index(3)) += f0 * voxel_length_ / (f0 + f1);
-                            mesh->vertices_.push_back(pt + origin_);
-                            if (color_type_ != TSDFVolumeColorType::None) {
-                                const auto &c0 = c[edge_to_vert[i][0]];
-                                const auto &c1 = c[edge_to_vert[i][1]];
-                                mesh->vertex_colors_.push_back(
-                                        (f1 * c0 + f0 * c1) / (f0 + f1));
+                    if (cube_index == 0 || cube_index == 255) {
+                        continue;
+                    }
+                    for (int i = 0; i < 12; i++) {
+                        if (edge_table[cube_index] & (1 << i)) {
+                            Eigen::Vector4i edge_index =
+                                    Eigen::Vector4i(x, y, z, 0) +
+                                    edge_shift[i];
+                            int edge = (edge_index(0) - x) * slice_edge_num +
+                                       (edge_index(1) * resolution_ +
+                                        edge_index(2)) *
+                                               3 +
+                                       edge_index(3);
+                            if (edge_to_vertex[edge] < 0) {
+                                edge_to_index[i] = (int)slab.vertices_.size();
+                                edge_to_vertex[edge] =
+                                        (int)slab.vertices_.size();
+                                slab.edges_.push_back(edge);
+                                Eigen::Vector3d pt(
+                                        half_voxel_length +
+                                                voxel_length_ * edge_index(0),
+                                        half_voxel_length +
+                                                voxel_length_ * edge_index(1),
+                                        half_voxel_length +
+                                                voxel_length_ * edge_index(2));
+                                double f0 = std::abs(
+                                        (double)f[edge_to_vert[i][0]]);
+                                double f1 = std::abs(
+                                        (double)f[edge_to_vert[i][1]]);
+                                pt(edge_index(3)) +=
+                                        f0 * voxel_length_ / (f0 + f1);
+                                slab.vertices_.push_back(pt + origin_);
+                                if (color_type_ != TSDFVolumeColorType::None) {
+                                    const auto &c0 = c[edge_to_vert[i][0]];
+                                    const auto &c1 = c[edge_to_vert[i][1]];
+                                    slab.vertex_colors_.push_back(
+                                            (f1 * c0 + f0 * c1) / (f0 + f1));
+                                }
+                            } else {
+                                edge_to_index[i] = edge_to_vertex[edge];
                             }
-                        } else {
-                            edge_to_index[i] =
-                                    edgeindex_to_vertexindex.find(edge_index)
-                                            ->second;
                         }
                     }
+                    for (int i = 0; tri_table[cube_index][i] != -1; i += 3) {
+                        slab.triangles_.push_back(Eigen::Vector3i(
+                                edge_to_index[tri_table[cube_index][i]],
+                                edge_to_index[tri_table[cube_index][i + 2]],
+                                edge_to_index[tri_table[cube_index][i + 1]]));
+                    }
                 }
-                for (int i = 0; tri_table[cube_index][i] != -1; i += 3) {
-                    mesh->triangles_.push_back(Eigen::Vector3i(
-                            edge_to_index[tri_table[cube_index][i]],
-                            edge_to_index[tri_table[cube_index][i + 2]],
-                            edge_to_index[tri_table[cube_index][i + 1]]));
+            }
+            for (size_t i = 0; i < slab.edges_.size(); i++) {
+                int edge = slab.edges_[i];
+                edge_to_vertex[edge] = -1;
+                if (edge >= slice_edge_num) {
+                    slab.far_.push_back(
+                            std::make_pair(edge - slice_edge_num, int(i)));
+                } else if (edge % 3 != 0) {
+                    slab.near_.push_back(std::make_pair(edge, int(i)));
                 }
             }
+            std::sort(slab.far_.begin(), slab.far_.end());
+            std::sort(slab.near_.begin(), slab.near_.end());
+        }
+    }
+
+    // A vertex on the near slice of a slab was added before by the previous
+    // slab if it is on the far slice of that slab.
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int x = 0; x < num_slabs; x++) {
+        auto &slab = slabs[x];
+        slab.vertex_to_previous_.assign(slab.vertices_.size(), -1);
+        if (x > 0) {
+            const auto &far = slabs[x - 1].far_;
+            auto far_itr = far.begin();
+            for (const auto &near : slab.near_) {
+                far_itr = std::lower_bound(
+                        far_itr, far.end(), near,
+                        [](const std::pair<int, int> &a,
+                           const std::pair<int, int> &b) {
+                            return a.first < b.first;
+                        });
+                if (far_itr != far.end() && far_itr->first == near.first) {
+                    slab.vertex_to_previous_[near.second] = far_itr->second;
+                }
+            }
+        }
+    }
+    std::vector<size_t> vertex_offsets(num_slabs + 1, 0);
+    std::vector<size_t> triangle_offsets(num_slabs + 1, 0);
+    for (int x = 0; x < num_slabs; x++) {
+        const auto &slab = slabs[x];
+        vertex_offsets[x + 1] =
+                vertex_offsets[x] +
+                std::count(slab.vertex_to_previous_.begin(),
+                           slab.vertex_to_previous_.end(), -1);
+        triangle_offsets[x + 1] =
+                triangle_offsets[x] + slab.triangles_.size();
+    }
+    mesh->vertices_.resize(vertex_offsets.back());
+    if (color_type_ != TSDFVolumeColorType::None) {
+        mesh->vertex_colors_.resize(vertex_offsets.back());
+    }
+    mesh->triangles_.resize(triangle_offsets.back());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int x = 0; x < num_slabs; x++) {
+        auto &slab = slabs[x];
+        slab.vertex_to_mesh_.resize(slab.vertices_.size());
+        size_t vertex_index = vertex_offsets[x];
+        for (size_t i = 0; i < slab.vertices_.size(); i++) {
+            if (slab.vertex_to_previous_[i] >= 0) {
+                continue;
+            }
+            slab.vertex_to_mesh_[i] = int(vertex_index);
+            mesh->vertices_[vertex_index] = slab.vertices_[i];
+            if (color_type_ != TSDFVolumeColorType::None) {
+                mesh->vertex_colors_[vertex_index] = slab.vertex_colors_[i];
+            }
+            vertex_index++;
+        }
+    }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int x = 0; x < num_slabs; x++) {
+        auto &slab = slabs[x];
+        for (size_t i = 0; i < slab.vertices_.size(); i++) {
+            if (slab.vertex_to_previous_[i] >= 0) {
+                slab.vertex_to_mesh_[i] =
+                        slabs[x - 1].vertex_to_mesh_
+                                [slab.vertex_to_previous_[i]];
+            }
+        }
+        for (size_t i = 0; i < slab.triangles_.size(); i++) {
+            const auto &triangle = slab.triangles_[i];
+            mesh->triangles_[triangle_offsets[x] + i] = Eigen::Vector3i(
+                    slab.vertex_to_mesh_[triangle(0)],
+                    slab.vertex_to_mesh_[triangle(1)],
+                    slab.vertex_to_mesh_[triangle(2)]);
         }
     }
     return mesh;
@@ -235,9 +406,11 @@ std::shared_ptr<geometry::PointCloud>
 UniformTSDFVolume::ExtractVoxelPointCloud() const {
     auto voxel = std::make_shared<geometry::PointCloud>();
     double half_voxel_length = voxel_length_ * 0.5;
-    // const float *p_tsdf = (const float *)tsdf_.data();
-    // const float *p_weight = (const float *)weight_.data();
-    // const float *p_color = (const float *)color_.data();
+    std::vector<std::vector<Eigen::Vector3d>> slice_points(resolution_);
+    std::vector<std::vector<Eigen::Vector3d>> slice_colors(resolution_);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
     for (int x = 0; x < resolution_; x++) {
         for (int y = 0; y < resolution_; y++) {
             for (int z = 0; z < resolution_; z++) {
@@ -248,13 +421,15 @@ UniformTSDFVolume::ExtractVoxelPointCloud() const {
                 if (voxels_[ind].weight_ != 0.0f &&
                     voxels_[ind].tsdf_ < 0.98f &&
                     voxels_[ind].tsdf_ >= -0.98f) {
-                    voxel->points_.push_back(pt + origin_);
+                    slice_points[x].push_back(pt + origin_);
                     double c = (voxels_[ind].tsdf_ + 1.0) * 0.5;
-                    voxel->colors_.push_back(Eigen::Vector3d(c, c, c));
+                    slice_colors[x].push_back(Eigen::Vector3d(c, c, c));
                 }
             }
         }
     }
+    ConcatenateSlices(slice_points, voxel->points_);
+    ConcatenateSlices(slice_colors, voxel->colors_);
     return voxel;
 }
 
@@ -264,6 +439,10 @@ std::shared_ptr<geometry::VoxelGrid> UniformTSDFVolume::ExtractVoxelGrid()
     voxel_grid->voxel_size_ = voxel_length_;
     voxel_grid->origin_ = origin_;
 
+    std::vector<std::vector<geometry::Voxel>> slice_voxels(resolution_);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
     for (int x = 0; x < resolution_; x++) {
         for (int y = 0; y < resolution_; y++) {
             for (int z = 0; z < resolution_; z++) {
@@ -273,12 +452,13 @@ std::shared_ptr<geometry::VoxelGrid> UniformTSDFVolume::ExtractVoxelGrid()
                 if (w != 0.0f && f < 0.98f && f >= -0.98f) {
                     double c = (f + 1.0) * 0.5;
                     Eigen::Vector3d color = Eigen::Vector3d(c, c, c);
-                    voxel_grid->voxels_.emplace_back(Eigen::Vector3i(x, y, z),
-                                                     color);
+                    slice_voxels[x].emplace_back(Eigen::Vector3i(x, y, z),
+                                                 color);
                 }
             }
         }
     }
+    ConcatenateSlices(slice_voxels, voxel_grid->voxels_);
     return voxel_grid;
 }
 
@@ -286,7 +466,8 @@ void UniformTSDFVolume::IntegrateWithDepthToCameraDistanceMultiplier(
         const geometry::RGBDImage &image,
         const camera::PinholeCameraIntrinsic &intrinsic,
         const Eigen::Matrix4d &extrinsic,
-        const geometry::Image &depth_to_camera_distance_multiplier) {
+        const geometry::Image &depth_to_camera_distance_multiplier,
+        double depth_max /* = -1.0*/) {
     const float fx = static_cast<float>(intrinsic.GetFocalLength().first);
     const float fy = static_cast<float>(intrinsic.GetFocalLength().second);
     const float cx = static_cast<float>(intrinsic.GetPrincipalPoint().first);
@@ -300,11 +481,71 @@ void UniformTSDFVolume::IntegrateWithDepthToCameraDistanceMultiplier(
     const float safe_width_f = intrinsic.width_ - 0.0001f;
     const float safe_height_f = intrinsic.height_ - 0.0001f;
 
+    if (depth_max < 0.0) {
+        depth_max = 0.0;
+        for (int v = 0; v < image.depth_.height_; v++) {
+            for (int u = 0; u < image.depth_.width_; u++) {
+                float d = *image.depth_.PointerAt<float>(u, v);
+                depth_max = std::max(depth_max, double(d));
+            }
+        }
+    }
+    if (depth_max <= 0.0) {
+        return;
+    }
+
+    // Only voxels inside the view frustum and in front of depth_max plus the
+    // truncation are updated. In camera coordinates the voxel centers of a
+    // column (x, y) lie on the line p0 + x * dx + y * dy + z * dz, so every
+    // frustum plane n.p + c >= 0 bounds z from one side. The planes are moved
+    // out by a voxel to keep the bounds conservative for the float tests
+    // below, which still decide for every visited voxel.
+    const Eigen::Matrix3d rotation = extrinsic.block<3, 3>(0, 0);
+    const Eigen::Matrix3d d = rotation * voxel_length_;
+    const Eigen::Vector3d p0 = rotation * origin_ +
+                               extrinsic.block<3, 1>(0, 3) +
+                               d * Eigen::Vector3d::Constant(0.5);
+    Eigen::Matrix<double, 6, 3> planes;
+    Eigen::Matrix<double, 6, 1> plane_offsets;
+    // Near and far planes.
+    planes.row(0) << 0.0, 0.0, 1.0;
+    planes.row(1) << 0.0, 0.0, -1.0;
+    // Image borders, e.g. u_f >= 0.0001 for the left one.
+    planes.row(2) << fx, 0.0, cx + 0.5 - 0.0001;
+    planes.row(3) << -fx, 0.0, safe_width_f - cx - 0.5;
+    planes.row(4) << 0.0, fy, cy + 0.5 - 0.0001;
+    planes.row(5) << 0.0, -fy, safe_height_f - cy - 0.5;
+    planes.rowwise().normalize();
+    plane_offsets << 0.0, depth_max + sdf_trunc_, 0.0, 0.0, 0.0, 0.0;
+    const Eigen::Matrix<double, 6, 1> a0 =
+            planes * p0 + plane_offsets +
+            Eigen::Matrix<double, 6, 1>::Constant(voxel_length_);
+    const Eigen::Matrix<double, 6, 1> ax = planes * d.col(0);
+    const Eigen::Matrix<double, 6, 1> ay = planes * d.col(1);
+    const Eigen::Matrix<double, 6, 1> az = planes * d.col(2);
+
 #ifdef _OPENMP
-#pragma omp parallel for schedule(static)
+#pragma omp parallel for schedule(dynamic)
 #endif
     for (int x = 0; x < resolution_; x++) {
         for (int y = 0; y < resolution_; y++) {
+            double z_min = 0.0;
+            double z_max = resolution_ - 1.0;
+            for (int i = 0; i < 6 && z_min <= z_max; i++) {
+                double a = a0(i) + x * ax(i) + y * ay(i);
+                if (az(i) > 0.0) {
+                    z_min = std::max(z_min, -a / az(i));
+                } else if (az(i) < 0.0) {
+                    z_max = std::min(z_max, -a / az(i));
+                } else if (a < 0.0) {
+                    z_max = -1.0;
+                }
+            }
+            if (z_min > z_max) {
+                continue;
+            }
+            const int z_begin = int(std::floor(z_min));
+            const int z_end = int(std::ceil(z_max));
             Eigen::Vector4f pt_3d_homo(float(half_voxel_length_f +
                                              voxel_length_f * x + origin_(0)),
                                        float(half_voxel_length_f +
@@ -312,7 +553,15 @@ void UniformTSDFVolume::IntegrateWithDepthToCameraDistanceMultiplier(
                                        float(half_voxel_length_f + origin_(2)),
                                        1.f);
             Eigen::Vector4f pt_camera = extrinsic_f * pt_3d_homo;
-            for (int z = 0; z < resolution_; z++,
+            // The voxels before z_begin are stepped over by the same repeated
+            // addition as the visited ones, so that the voxel positions are
+            // bitwise identical to those of integrating every voxel.
+            for (int z = 0; z < z_begin; z++) {
+                pt_camera(0) += extrinsic_scaled_f(0, 2);
+                pt_camera(1) += extrinsic_scaled_f(1, 2);
+                pt_camera(2) += extrinsic_scaled_f(2, 2);
+            }
+            for (int z = z_begin; z <= z_end; z++,
                      pt_camera(0) += extrinsic_scaled_f(0, 2),
                      pt_camera(1) += extrinsic_scaled_f(1, 2),
                      pt_camera(2) += extrinsic_scaled_f(2, 2)) {
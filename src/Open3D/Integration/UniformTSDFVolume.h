@@ -72,12 +72,15 @@ public:
     std::shared_ptr<geometry::VoxelGrid> ExtractVoxelGrid() const;
 
     /// Faster Integrate function that uses depth_to_camera_distance_multiplier
-    /// precomputed from camera intrinsic
+    /// precomputed from camera intrinsic. Only the voxels in the view frustum
+    /// up to \p depth_max plus sdf_trunc_ are visited. A negative \p depth_max
+    /// is replaced by the largest depth in \p image.
     void IntegrateWithDepthToCameraDistanceMultiplier(
             const geometry::RGBDImage &image,
             const camera::PinholeCameraIntrinsic &intrinsic,
             const Eigen::Matrix4d &extrinsic,
-            const geometry::Image &depth_to_camera_distance_multiplier);
+            const geometry::Image &depth_to_camera_distance_multiplier,
+            double depth_max = -1.0);
 
     inline int IndexOf(int x, int y, int z) const {
         return x * resolution_ * resolution_ + y * resolution_ + z;
@@ -0,0 +1,242 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Integration/VolumeUnitStore.h"
+
+#include <cstring>
+
+#include "Open3D/Integration/UniformTSDFVolume.h"
+#include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/FileSystem.h"
+
+namespace open3d {
+namespace integration {
+
+namespace {
+
+size_t GetVoxelRecordSize(bool has_color) {
+    return 2 * sizeof(float) + (has_color ? 3 * sizeof(double) : 0);
+}
+
+}  // unnamed namespace
+
+VolumeUnitStore::~VolumeUnitStore() { Close(); }
+
+bool VolumeUnitStore::Open(const std::string &filename) {
+    Close();
+    file_.open(filename, std::ios::in | std::ios::out | std::ios::binary |
+                                 std::ios::trunc);
+    if (!file_.is_open()) {
+        utility::LogWarning("[VolumeUnitStore] Failed to create file {}.\n",
+                            filename);
+        return false;
+    }
+    filename_ = filename;
+    return true;
+}
+
+void VolumeUnitStore::Close() {
+    if (file_.is_open()) {
+        file_.close();
+        utility::filesystem::RemoveFile(filename_);
+    }
+    filename_.clear();
+    blocks_.clear();
+    free_blocks_.clear();
+    end_ = 0;
+}
+
+void VolumeUnitStore::Clear() {
+    if (file_.is_open()) {
+        std::string filename = filename_;
+        Open(filename);
+    }
+}
+
+bool VolumeUnitStore::Write(const Eigen::Vector3i &index,
+                            const UniformTSDFVolume &volume) {
+    if (!file_.is_open()) {
+        return false;
+    }
+    buffer_.clear();
+    EncodeVolumeUnit(volume, buffer_);
+    Erase(index);
+    Block block;
+    block.size_ = buffer_.size();
+    auto free_block = free_blocks_.lower_bound(block.size_);
+    if (free_block != free_blocks_.end()) {
+        block.offset_ = free_block->second;
+        block.capacity_ = free_block->first;
+        free_blocks_.erase(free_block);
+    } else {
+        block.offset_ = end_;
+        block.capacity_ = block.size_;
+        end_ += std::streamoff(block.size_);
+    }
+    file_.seekp(block.offset_);
+    file_.write(reinterpret_cast<const char *>(buffer_.data()),
+                std::streamsize(block.size_));
+    if (!file_) {
+        utility::LogWarning(
+                "[VolumeUnitStore] Failed to write volume unit ({}, {}, {}).\n",
+                index(0), index(1), index(2));
+        file_.clear();
+        free_blocks_.emplace(block.capacity_, block.offset_);
+        return false;
+    }
+    blocks_[index] = block;
+    return true;
+}
+
+bool VolumeUnitStore::Read(const Eigen::Vector3i &index,
+                           UniformTSDFVolume &volume) {
+    auto block = blocks_.find(index);
+    if (!file_.is_open() || block == blocks_.end()) {
+        return false;
+    }
+    buffer_.resize(block->second.size_);
+    file_.seekg(block->second.offset_);
+    file_.read(reinterpret_cast<char *>(buffer_.data()),
+               std::streamsize(buffer_.size()));
+    if (!file_ || !DecodeVolumeUnit(buffer_.data(), buffer_.size(), volume)) {
+        utility::LogWarning(
+                "[VolumeUnitStore] Failed to read volume unit ({}, {}, {}).\n",
+                index(0), index(1), index(2));
+        file_.clear();
+        return false;
+    }
+    return true;
+}
+
+void VolumeUnitStore::Erase(const Eigen::Vector3i &index) {
+    auto block = blocks_.find(index);
+    if (block != blocks_.end()) {
+        free_blocks_.emplace(block->second.capacity_, block->second.offset_);
+        blocks_.erase(block);
+    }
+}
+
+std::vector<Eigen::Vector3i> VolumeUnitStore::GetIndices() const {
+    std::vector<Eigen::Vector3i> indices;
+    indices.reserve(blocks_.size());
+    for (const auto &block : blocks_) {
+        indices.push_back(block.first);
+    }
+    return indices;
+}
+
+void VolumeUnitStore::EncodeVoxels(const geometry::TSDFVoxel *voxels,
+                                   size_t num_voxels,
+                                   bool has_color,
+                                   std::vector<uint8_t> &buffer) {
+    const size_t mask_size = (num_voxels + 7) / 8;
+    uint32_t count = 0;
+    for (size_t i = 0; i < num_voxels; i++) {
+        if (voxels[i].weight_ != 0.0f) {
+            count++;
+        }
+    }
+    const size_t begin = buffer.size();
+    buffer.resize(begin + sizeof(uint32_t) + mask_size +
+                  count * GetVoxelRecordSize(has_color));
+    uint8_t *mask = buffer.data() + begin + sizeof(uint32_t);
+    uint8_t *record = mask + mask_size;
+    std::memcpy(buffer.data() + begin, &count, sizeof(uint32_t));
+    std::memset(mask, 0, mask_size);
+    for (size_t i = 0; i < num_voxels; i++) {
+        const auto &voxel = voxels[i];
+        if (voxel.weight_ == 0.0f) {
+            continue;
+        }
+        mask[i / 8] |= uint8_t(1 << (i % 8));
+        std::memcpy(record, &voxel.tsdf_, sizeof(float));
+        std::memcpy(record + sizeof(float), &voxel.weight_, sizeof(float));
+        record += 2 * sizeof(float);
+        if (has_color) {
+            std::memcpy(record, voxel.color_.data(), 3 * sizeof(double));
+            record += 3 * sizeof(double);
+        }
+    }
+}
+
+bool VolumeUnitStore::DecodeVoxels(const uint8_t *data,
+                                   size_t size,
+                                   geometry::TSDFVoxel *voxels,
+                                   size_t num_voxels,
+                                   bool has_color) {
+    const size_t mask_size = (num_voxels + 7) / 8;
+    uint32_t count;
+    if (size < sizeof(uint32_t) + mask_size) {
+        return false;
+    }
+    std::memcpy(&count, data, sizeof(uint32_t));
+    if (size != sizeof(uint32_t) + mask_size +
+                        count * GetVoxelRecordSize(has_color)) {
+        return false;
+    }
+    const uint8_t *mask = data + sizeof(uint32_t);
+    const uint8_t *record = mask + mask_size;
+    const uint8_t *end = data + size;
+    for (size_t i = 0; i < num_voxels; i++) {
+        auto &voxel = voxels[i];
+        if ((mask[i / 8] & (1 << (i % 8))) == 0) {
+            voxel.tsdf_ = 0.0f;
+            voxel.weight_ = 0.0f;
+            voxel.color_.setZero();
+            continue;
+        }
+        if (record == end) {
+            return false;
+        }
+        std::memcpy(&voxel.tsdf_, record, sizeof(float));
+        std::memcpy(&voxel.weight_, record + sizeof(float), sizeof(float));
+        record += 2 * sizeof(float);
+        if (has_color) {
+            std::memcpy(voxel.color_.data(), record, 3 * sizeof(double));
+            record += 3 * sizeof(double);
+        } else {
+            voxel.color_.setZero();
+        }
+    }
+    return record == end;
+}
+
+void VolumeUnitStore::EncodeVolumeUnit(const UniformTSDFVolume &volume,
+                                       std::vector<uint8_t> &buffer) {
+    EncodeVoxels(volume.voxels_.data(), volume.voxels_.size(),
+                 volume.color_type_ != TSDFVolumeColorType::None, buffer);
+}
+
+bool VolumeUnitStore::DecodeVolumeUnit(const uint8_t *data,
+                                       size_t size,
+                                       UniformTSDFVolume &volume) {
+    return DecodeVoxels(data, size, volume.voxels_.data(),
+                        volume.voxels_.size(),
+                        volume.color_type_ != TSDFVolumeColorType::None);
+}
+
+}  // namespace integration
+}  // namespace open3d
@@ -0,0 +1,125 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Open3D/Utility/Helper.h"
+
+namespace open3d {
+
+namespace geometry {
+class TSDFVoxel;
+}
+
+namespace integration {
+
+class UniformTSDFVolume;
+
+/// Keeps the volume units that a ScalableTSDFVolume has paged out in a single
+/// scratch file. A unit is written as one block that holds only its observed
+/// voxels, losslessly, so a unit that is read back continues integration
+/// exactly as if it had stayed in memory. The space of blocks that have been
+/// read back is reused by later writes.
+class VolumeUnitStore {
+public:
+    VolumeUnitStore() {}
+    ~VolumeUnitStore();
+    VolumeUnitStore(const VolumeUnitStore &) = delete;
+    VolumeUnitStore &operator=(const VolumeUnitStore &) = delete;
+
+public:
+    /// Creates the file \p filename, replacing an existing one.
+    bool Open(const std::string &filename);
+    /// Closes and removes the file.
+    void Close();
+    bool IsOpen() const { return file_.is_open(); }
+    /// Drops all stored volume units.
+    void Clear();
+    bool Write(const Eigen::Vector3i &index, const UniformTSDFVolume &volume);
+    /// Reads the stored unit \p index into \p volume, which must have the
+    /// resolution and color type that the unit was written with. The unit
+    /// stays in the store until it is erased.
+    bool Read(const Eigen::Vector3i &index, UniformTSDFVolume &volume);
+    void Erase(const Eigen::Vector3i &index);
+    bool Contains(const Eigen::Vector3i &index) const {
+        return blocks_.find(index) != blocks_.end();
+    }
+    size_t Size() const { return blocks_.size(); }
+    std::vector<Eigen::Vector3i> GetIndices() const;
+    /// Size of the file in bytes, including free space.
+    size_t GetFileSize() const { return size_t(end_); }
+
+    /// Appends the observed voxels among \p num_voxels voxels to \p buffer:
+    /// the number of observed voxels, a bit mask of them, their TSDF values
+    /// and weights and, if \p has_color, their colors.
+    static void EncodeVoxels(const geometry::TSDFVoxel *voxels,
+                             size_t num_voxels,
+                             bool has_color,
+                             std::vector<uint8_t> &buffer);
+    /// Fills \p num_voxels voxels from \p size bytes at \p data written by
+    /// EncodeVoxels. Voxels that were not observed are reset.
+    static bool DecodeVoxels(const uint8_t *data,
+                             size_t size,
+                             geometry::TSDFVoxel *voxels,
+                             size_t num_voxels,
+                             bool has_color);
+    /// EncodeVoxels for all voxels of \p volume.
+    static void EncodeVolumeUnit(const UniformTSDFVolume &volume,
+                                 std::vector<uint8_t> &buffer);
+    /// DecodeVoxels for all voxels of \p volume.
+    static bool DecodeVolumeUnit(const uint8_t *data,
+                                 size_t size,
+                                 UniformTSDFVolume &volume);
+
+private:
+    struct Block {
+        std::streamoff offset_;
+        size_t size_;
+        size_t capacity_;
+    };
+
+    std::fstream file_;
+    std::string filename_;
+    std::unordered_map<Eigen::Vector3i,
+                       Block,
+                       utility::hash_eigen::hash<Eigen::Vector3i>>
+            blocks_;
+    /// Blocks of erased units by capacity.
+    std::multimap<size_t, std::streamoff> free_blocks_;
+    std::streamoff end_ = 0;
+    std::vector<uint8_t> buffer_;
+};
+
+}  // namespace integration
+}  // namespace open3d
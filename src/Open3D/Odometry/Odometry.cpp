@@ -32,6 +32,7 @@
 #include "Open3D/Geometry/RGBDImage.h"
 #include "Open3D/Odometry/RGBDOdometryJacobian.h"
 #include "Open3D/Utility/Eigen.h"
+#include "Open3D/Utility/Profiler.h"
 #include "Open3D/Utility/Timer.h"
 
 namespace open3d {
@@ -377,16 +378,19 @@ InitializeRGBDOdometry(
         const camera::PinholeCameraIntrinsic &pinhole_camera_intrinsic,
         const Eigen::Matrix4d &odo_init,
         const OdometryOption &option) {
+    OPEN3D_PROFILE_ZONE("InitializeRGBDOdometry");
     auto source_gray =
             source.color_.Filter(geometry::Image::FilterType::Gaussian3);
     auto target_gray =
             target.color_.Filter(geometry::Image::FilterType::Gaussian3);
-    auto source_depth_preprocessed = PreprocessDepth(source.depth_, option);
-    auto target_depth_preprocessed = PreprocessDepth(target.depth_, option);
-    auto source_depth = source_depth_preprocessed->Filter(
-            geometry::Image::FilterType::Gaussian3);
-    auto target_depth = target_depth_preprocessed->Filter(
-            geometry::Image::FilterType::Gaussian3);
+    auto source_depth = PreprocessDepth(source.depth_, option);
+    auto target_depth = PreprocessDepth(target.depth_, option);
+    if (!option.depth_preprocessed_) {
+        source_depth = source_depth->Filter(
+                geometry::Image::FilterType::Gaussian3);
+        target_depth = target_depth->Filter(
+                geometry::Image::FilterType::Gaussian3);
+    }
 
     auto correspondence = ComputeCorrespondence(
             pinhole_camera_intrinsic.intrinsic_matrix_, odo_init, *source_depth,
@@ -450,6 +454,7 @@ std::tuple<bool, Eigen::Matrix4d> ComputeMultiscale(
         const Eigen::Matrix4d &extrinsic_initial,
         const RGBDOdometryJacobian &jacobian_method,
         const OdometryOption &option) {
+    OPEN3D_PROFILE_ZONE("ComputeMultiscale");
     std::vector<int> iter_counts = option.iteration_number_per_pyramid_level_;
     int num_levels = (int)iter_counts.size();
 
@@ -514,6 +519,7 @@ std::tuple<bool, Eigen::Matrix4d, Eigen::Matrix6d> ComputeRGBDOdometry(
         const RGBDOdometryJacobian &jacobian_method
         /*=RGBDOdometryJacobianFromHybridTerm*/,
         const OdometryOption &option /*= OdometryOption()*/) {
+    OPEN3D_PROFILE_ZONE("ComputeRGBDOdometry");
     if (!CheckRGBDImagePair(source, target)) {
         utility::LogWarning(
                 "[RGBDOdometry] Two RGBD pairs should be same in size.\n");
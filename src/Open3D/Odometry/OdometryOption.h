@@ -39,12 +39,14 @@ public:
                      5} /* {smaller image size to original image size} */,
             double max_depth_diff = 0.03,
             double min_depth = 0.0,
-            double max_depth = 4.0)
+            double max_depth = 4.0,
+            bool depth_preprocessed = false)
         : iteration_number_per_pyramid_level_(
                   iteration_number_per_pyramid_level),
           max_depth_diff_(max_depth_diff),
           min_depth_(min_depth),
-          max_depth_(max_depth) {}
+          max_depth_(max_depth),
+          depth_preprocessed_(depth_preprocessed) {}
     ~OdometryOption() {}
 
 public:
@@ -52,6 +54,10 @@ public:
     double max_depth_diff_;
     double min_depth_;
     double max_depth_;
+    /// Set if the depth of both RGBD images comes from
+    /// geometry::DepthPreprocessor. The depth is then used as it is instead
+    /// of being smoothed again.
+    bool depth_preprocessed_;
 };
 
 }  // namespace odometry
@@ -40,19 +40,16 @@ namespace open3d {
 namespace {
 using namespace registration;
 
-class PointCloudForColoredICP : public geometry::PointCloud {
-public:
-    std::vector<Eigen::Vector3d> color_gradient_;
-};
-
 class TransformationEstimationForColoredICP : public TransformationEstimation {
 public:
     TransformationEstimationType GetTransformationEstimationType()
             const override {
         return type_;
     };
-    TransformationEstimationForColoredICP(double lambda_geometric = 0.968)
-        : lambda_geometric_(lambda_geometric) {
+    TransformationEstimationForColoredICP(
+            const std::vector<Eigen::Vector3d> &color_gradient,
+            double lambda_geometric = 0.968)
+        : color_gradient_(color_gradient), lambda_geometric_(lambda_geometric) {
         if (lambda_geometric_ < 0 || lambda_geometric_ > 1.0)
             lambda_geometric_ = 0.968;
     }
@@ -68,6 +65,8 @@ public:
             const CorrespondenceSet &corres) const override;
 
 public:
+    // Color gradients of the target points.
+    const std::vector<Eigen::Vector3d> &color_gradient_;
     double lambda_geometric_;
 
 private:
@@ -75,71 +74,6 @@ private:
             TransformationEstimationType::ColoredICP;
 };
 
-std::shared_ptr<PointCloudForColoredICP> InitializePointCloudForColoredICP(
-        const geometry::PointCloud &target,
-        const geometry::KDTreeSearchParamHybrid &search_param) {
-    utility::LogDebug("InitializePointCloudForColoredICP\n");
-
-    geometry::KDTreeFlann tree;
-    tree.SetGeometry(target);
-
-    auto output = std::make_shared<PointCloudForColoredICP>();
-    output->colors_ = target.colors_;
-    output->normals_ = target.normals_;
-    output->points_ = target.points_;
-
-    size_t n_points = output->points_.size();
-    output->color_gradient_.resize(n_points, Eigen::Vector3d::Zero());
-
-    for (size_t k = 0; k < n_points; k++) {
-        const Eigen::Vector3d &vt = output->points_[k];
-        const Eigen::Vector3d &nt = output->normals_[k];
-        double it = (output->colors_[k](0) + output->colors_[k](1) +
-                     output->colors_[k](2)) /
-                    3.0;
-
-        std::vector<int> point_idx;
-        std::vector<double> point_squared_distance;
-
-        if (tree.SearchHybrid(vt, search_param.radius_, search_param.max_nn_,
-                              point_idx, point_squared_distance) >= 3) {
-            // approximate image gradient of vt's tangential plane
-            size_t nn = point_idx.size();
-            Eigen::MatrixXd A(nn, 3);
-            Eigen::MatrixXd b(nn, 1);
-            A.setZero();
-            b.setZero();
-            for (size_t i = 1; i < nn; i++) {
-                int P_adj_idx = point_idx[i];
-                Eigen::Vector3d vt_adj = output->points_[P_adj_idx];
-                Eigen::Vector3d vt_proj = vt_adj - (vt_adj - vt).dot(nt) * nt;
-                double it_adj = (output->colors_[P_adj_idx](0) +
-                                 output->colors_[P_adj_idx](1) +
-                                 output->colors_[P_adj_idx](2)) /
-                                3.0;
-                A(i - 1, 0) = (vt_proj(0) - vt(0));
-                A(i - 1, 1) = (vt_proj(1) - vt(1));
-                A(i - 1, 2) = (vt_proj(2) - vt(2));
-                b(i - 1, 0) = (it_adj - it);
-            }
-            // adds orthogonal constraint
-            A(nn - 1, 0) = (nn - 1) * nt(0);
-            A(nn - 1, 1) = (nn - 1) * nt(1);
-            A(nn - 1, 2) = (nn - 1) * nt(2);
-            b(nn - 1, 0) = 0;
-            // solving linear equation
-            bool is_success;
-            Eigen::MatrixXd x;
-            std::tie(is_success, x) = utility::SolveLinearSystemPSD(
-                    A.transpose() * A, A.transpose() * b);
-            if (is_success) {
-                output->color_gradient_[k] = x;
-            }
-        }
-    }
-    return output;
-}
-
 Eigen::Matrix4d TransformationEstimationForColoredICP::ComputeTransformation(
         const geometry::PointCloud &source,
         const geometry::PointCloud &target,
@@ -152,8 +86,6 @@ Eigen::Matrix4d TransformationEstimationForColoredICP::ComputeTransformation(
     double lambda_photometric = 1.0 - lambda_geometric_;
     double sqrt_lambda_photometric = sqrt(lambda_photometric);
 
-    const auto &target_c = (const PointCloudForColoredICP &)target;
-
     auto compute_jacobian_and_residual =
             [&](int i,
                 std::vector<Eigen::Vector6d, utility::Vector6d_allocator> &J_r,
@@ -179,7 +111,7 @@ Eigen::Matrix4d TransformationEstimationForColoredICP::ComputeTransformation(
                 double it = (target.colors_[ct](0) + target.colors_[ct](1) +
                              target.colors_[ct](2)) /
                             3.0;
-                const Eigen::Vector3d &dit = target_c.color_gradient_[ct];
+                const Eigen::Vector3d &dit = color_gradient_[ct];
                 double is0_proj = (dit.dot(vs_proj - vt)) + it;
 
                 const Eigen::Matrix3d M =
@@ -218,7 +150,6 @@ double TransformationEstimationForColoredICP::ComputeRMSE(
     double sqrt_lambda_geometric = sqrt(lambda_geometric_);
     double lambda_photometric = 1.0 - lambda_geometric_;
     double sqrt_lambda_photometric = sqrt(lambda_photometric);
-    const auto &target_c = (const PointCloudForColoredICP &)target;
 
     double residual = 0.0;
     for (size_t i = 0; i < corres.size(); i++) {
@@ -234,7 +165,7 @@ double TransformationEstimationForColoredICP::ComputeRMSE(
         double it = (target.colors_[ct](0) + target.colors_[ct](1) +
                      target.colors_[ct](2)) /
                     3.0;
-        const Eigen::Vector3d &dit = target_c.color_gradient_[ct];
+        const Eigen::Vector3d &dit = color_gradient_[ct];
         double is0_proj = (dit.dot(vs_proj - vt)) + it;
         double residual_geometric = sqrt_lambda_geometric * (vs - vt).dot(nt);
         double residual_photometric = sqrt_lambda_photometric * (is - is0_proj);
@@ -248,6 +179,85 @@ double TransformationEstimationForColoredICP::ComputeRMSE(
 
 namespace registration {
 
+ColoredICPTarget::ColoredICPTarget(
+        const geometry::PointCloud &target,
+        const geometry::KDTreeSearchParamHybrid &search_param) {
+    SetPointCloud(target, search_param);
+}
+
+bool ColoredICPTarget::SetPointCloud(
+        const geometry::PointCloud &target,
+        const geometry::KDTreeSearchParamHybrid &search_param) {
+    utility::LogDebug("ColoredICPTarget::SetPointCloud\n");
+    point_cloud_ = target;
+    kdtree_.SetGeometry(point_cloud_);
+    int n_points = int(point_cloud_.points_.size());
+    color_gradient_.assign(n_points, Eigen::Vector3d::Zero());
+    if (!point_cloud_.HasNormals() || !point_cloud_.HasColors()) {
+        utility::LogWarning(
+                "[ColoredICPTarget] Point cloud needs normals and colors.\n");
+        return false;
+    }
+
+    const auto &points = point_cloud_.points_;
+    const auto &normals = point_cloud_.normals_;
+    const auto &colors = point_cloud_.colors_;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        std::vector<int> point_idx;
+        std::vector<double> point_squared_distance;
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (int k = 0; k < n_points; k++) {
+            const Eigen::Vector3d &vt = points[k];
+            const Eigen::Vector3d &nt = normals[k];
+            double it = (colors[k](0) + colors[k](1) + colors[k](2)) / 3.0;
+            if (kdtree_.SearchHybrid(vt, search_param.radius_,
+                                     search_param.max_nn_, point_idx,
+                                     point_squared_distance) < 3) {
+                continue;
+            }
+            // approximate image gradient of vt's tangential plane. The normal
+            // equations A^T A x = A^T b are accumulated row by row.
+            size_t nn = point_idx.size();
+            Eigen::Matrix3d ATA = Eigen::Matrix3d::Zero();
+            Eigen::Vector3d ATb = Eigen::Vector3d::Zero();
+            for (size_t i = 1; i < nn; i++) {
+                int P_adj_idx = point_idx[i];
+                const Eigen::Vector3d &vt_adj = points[P_adj_idx];
+                Eigen::Vector3d vt_proj = vt_adj - (vt_adj - vt).dot(nt) * nt;
+                double it_adj = (colors[P_adj_idx](0) + colors[P_adj_idx](1) +
+                                 colors[P_adj_idx](2)) /
+                                3.0;
+                Eigen::Vector3d a = vt_proj - vt;
+                ATA.noalias() += a * a.transpose();
+                ATb.noalias() += a * (it_adj - it);
+            }
+            // adds orthogonal constraint
+            Eigen::Vector3d a = (nn - 1) * nt;
+            ATA.noalias() += a * a.transpose();
+            // solving linear equation
+            bool is_success;
+            Eigen::VectorXd x;
+            std::tie(is_success, x) = utility::SolveLinearSystemPSD(
+                    Eigen::MatrixXd(ATA), Eigen::VectorXd(ATb));
+            if (is_success) {
+                color_gradient_[k] = x;
+            }
+        }
+    }
+    return true;
+}
+
+std::shared_ptr<ColoredICPTarget> PrepareColoredICPTarget(
+        const geometry::PointCloud &target, double max_distance) {
+    return std::make_shared<ColoredICPTarget>(
+            target, geometry::KDTreeSearchParamHybrid(max_distance * 2.0, 30));
+}
+
 RegistrationResult RegistrationColoredICP(
         const geometry::PointCloud &source,
         const geometry::PointCloud &target,
@@ -255,11 +265,23 @@ RegistrationResult RegistrationColoredICP(
         const Eigen::Matrix4d &init /* = Eigen::Matrix4d::Identity()*/,
         const ICPConvergenceCriteria &criteria /* = ICPConvergenceCriteria()*/,
         double lambda_geometric /* = 0.968*/) {
-    auto target_c = InitializePointCloudForColoredICP(
-            target, geometry::KDTreeSearchParamHybrid(max_distance * 2.0, 30));
+    auto target_c = PrepareColoredICPTarget(target, max_distance);
+    return RegistrationColoredICP(source, *target_c, max_distance, init,
+                                  criteria, lambda_geometric);
+}
+
+RegistrationResult RegistrationColoredICP(
+        const geometry::PointCloud &source,
+        const ColoredICPTarget &target,
+        double max_distance,
+        const Eigen::Matrix4d &init /* = Eigen::Matrix4d::Identity()*/,
+        const ICPConvergenceCriteria &criteria /* = ICPConvergenceCriteria()*/,
+        double lambda_geometric /* = 0.968*/) {
     return RegistrationICP(
-            source, *target_c, max_distance, init,
-            TransformationEstimationForColoredICP(lambda_geometric), criteria);
+            source, target.point_cloud_, target.kdtree_, max_distance, init,
+            TransformationEstimationForColoredICP(target.color_gradient_,
+                                                  lambda_geometric),
+            criteria);
 }
 
 }  // namespace registration
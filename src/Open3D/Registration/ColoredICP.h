@@ -27,18 +27,52 @@
 #pragma once
 
 #include <Eigen/Core>
+#include <memory>
+#include <vector>
 
+#include "Open3D/Geometry/KDTreeFlann.h"
+#include "Open3D/Geometry/KDTreeSearchParam.h"
+#include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Registration/Registration.h"
 
 namespace open3d {
 
-namespace geometry {
-class PointCloud;
-}
-
 namespace registration {
 class RegistrationResult;
 
+/// \class ColoredICPTarget
+///
+/// Target of colored ICP together with its KDTree and the color gradient of
+/// every point in its tangent plane. Preparing a target once allows it to be
+/// registered against many sources without recomputing the gradients.
+class ColoredICPTarget {
+public:
+    ColoredICPTarget() {}
+    ColoredICPTarget(const geometry::PointCloud &target,
+                     const geometry::KDTreeSearchParamHybrid &search_param);
+    ~ColoredICPTarget() {}
+    ColoredICPTarget(const ColoredICPTarget &) = delete;
+    ColoredICPTarget &operator=(const ColoredICPTarget &) = delete;
+
+public:
+    /// Copies \p target, builds its KDTree and estimates the color gradients
+    /// from the neighbors found with \p search_param. The target needs normals
+    /// and colors; otherwise all gradients are zero and false is returned.
+    bool SetPointCloud(const geometry::PointCloud &target,
+                       const geometry::KDTreeSearchParamHybrid &search_param);
+
+public:
+    geometry::PointCloud point_cloud_;
+    geometry::KDTreeFlann kdtree_;
+    std::vector<Eigen::Vector3d> color_gradient_;
+};
+
+/// Prepares \p target the same way RegistrationColoredICP does for
+/// \p max_distance, i.e. with a hybrid search of radius 2 * max_distance and
+/// at most 30 neighbors.
+std::shared_ptr<ColoredICPTarget> PrepareColoredICPTarget(
+        const geometry::PointCloud &target, double max_distance);
+
 /// Function to align colored point clouds
 /// This is implementation of following paper
 /// J. Park, Q.-Y. Zhou, V. Koltun,
@@ -51,5 +85,14 @@ RegistrationResult RegistrationColoredICP(
         const ICPConvergenceCriteria &criteria = ICPConvergenceCriteria(),
         double lambda_geometric = 0.968);
 
+/// Function to align a colored point cloud to a prepared target
+RegistrationResult RegistrationColoredICP(
+        const geometry::PointCloud &source,
+        const ColoredICPTarget &target,
+        double max_distance,
+        const Eigen::Matrix4d &init = Eigen::Matrix4d::Identity(),
+        const ICPConvergenceCriteria &criteria = ICPConvergenceCriteria(),
+        double lambda_geometric = 0.968);
+
 }  // namespace registration
 }  // namespace open3d
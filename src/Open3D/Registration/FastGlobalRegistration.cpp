@@ -26,7 +26,14 @@
 
 #include "Open3D/Registration/FastGlobalRegistration.h"
 
+#include <algorithm>
+#include <array>
 #include <ctime>
+#include <random>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Geometry/PointCloud.h"
@@ -40,6 +47,50 @@ namespace open3d {
 namespace {
 using namespace registration;
 
+// Number of tuple trials drawn from one random stream. The trials are split
+// into fixed blocks so that the accepted tuples only depend on the seed and not
+// on the number of threads.
+constexpr int kTupleTrialsPerBlock = 1024;
+
+// Number of correspondences whose contributions to JTJ and JTr are summed
+// together before the partial sums are reduced in a fixed order.
+constexpr int kCorrespondencesPerBlock = 256;
+
+unsigned int GetTupleSeed(const FastGlobalRegistrationOption& option) {
+    if (option.seed_ < 0) {
+        return (unsigned int)std::time(0);
+    }
+    return (unsigned int)option.seed_;
+}
+
+// Finds the nearest neighbor in feature space of every column of
+// query_feature. Only the columns with mask[k] != 0 are searched when a mask
+// is given; the others are set to -1.
+std::vector<int> SearchNearestFeatures(const geometry::KDTreeFlann& tree,
+                                       const Feature& query_feature,
+                                       const std::vector<char>* mask) {
+    int n = int(query_feature.Num());
+    std::vector<int> nearest(n, -1);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        std::vector<int> indices;
+        std::vector<double> dists;
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (int k = 0; k < n; k++) {
+            if (mask != nullptr && (*mask)[k] == 0) continue;
+            if (tree.SearchKNN(Eigen::VectorXd(query_feature.data_.col(k)), 1,
+                               indices, dists) > 0) {
+                nearest[k] = indices[0];
+            }
+        }
+    }
+    return nearest;
+}
+
 std::vector<std::pair<int, int>> AdvancedMatching(
         const std::vector<geometry::PointCloud>& point_cloud_vec,
         const std::vector<Feature>& features_vec,
@@ -57,125 +108,138 @@ std::vector<std::pair<int, int>> AdvancedMatching(
     }
 
     // STEP 1) Initial matching
+    // Every point of fragment j is matched to its nearest feature in fragment
+    // i, and every point of fragment i that was hit is matched back to its
+    // nearest feature in fragment j.
     int nPti = int(point_cloud_vec[fi].points_.size());
-    int nPtj = int(point_cloud_vec[fj].points_.size());
     geometry::KDTreeFlann feature_tree_i(features_vec[fi]);
     geometry::KDTreeFlann feature_tree_j(features_vec[fj]);
-    std::vector<int> corresK;
-    std::vector<double> dis;
-    std::vector<std::pair<int, int>> corres;
-    std::vector<std::pair<int, int>> corres_ij;
-    std::vector<std::pair<int, int>> corres_ji;
-    std::vector<int> i_to_j(nPti, -1);
-    for (int j = 0; j < nPtj; j++) {
-        feature_tree_i.SearchKNN(Eigen::VectorXd(features_vec[fj].data_.col(j)),
-                                 1, corresK, dis);
-        int i = corresK[0];
-        if (i_to_j[i] == -1) {
-            feature_tree_j.SearchKNN(
-                    Eigen::VectorXd(features_vec[fi].data_.col(i)), 1, corresK,
-                    dis);
-            int ij = corresK[0];
-            i_to_j[i] = ij;
-        }
-        corres_ji.push_back(std::pair<int, int>(i, j));
-    }
-    for (int i = 0; i < nPti; i++) {
-        if (i_to_j[i] != -1)
-            corres_ij.push_back(std::pair<int, int>(i, i_to_j[i]));
+    std::vector<int> j_to_i =
+            SearchNearestFeatures(feature_tree_i, features_vec[fj], nullptr);
+    std::vector<char> is_matched(nPti, 0);
+    for (int i : j_to_i) {
+        if (i >= 0) is_matched[i] = 1;
     }
-    int ncorres_ij = int(corres_ij.size());
-    int ncorres_ji = int(corres_ji.size());
-    for (int i = 0; i < ncorres_ij; ++i)
-        corres.push_back(
-                std::pair<int, int>(corres_ij[i].first, corres_ij[i].second));
-    for (int j = 0; j < ncorres_ji; ++j)
-        corres.push_back(
-                std::pair<int, int>(corres_ji[j].first, corres_ji[j].second));
-    utility::LogDebug("points are remained : {:d}\n", (int)corres.size());
+    std::vector<int> i_to_j =
+            SearchNearestFeatures(feature_tree_j, features_vec[fi], &is_matched);
+    utility::LogDebug(
+            "points are remained : {:d}\n",
+            int(std::count(is_matched.begin(), is_matched.end(), 1) +
+                j_to_i.size()));
 
     // STEP 2) CROSS CHECK
+    // Each point of fragment j has exactly one match in fragment i, so the
+    // pair (i, j) survives iff both points picked each other.
     utility::LogDebug("\t[cross check] ");
     std::vector<std::pair<int, int>> corres_cross;
-    std::vector<std::vector<int>> Mi(nPti), Mj(nPtj);
-    int ci, cj;
-    for (int i = 0; i < ncorres_ij; ++i) {
-        ci = corres_ij[i].first;
-        cj = corres_ij[i].second;
-        Mi[ci].push_back(cj);
-    }
-    for (int j = 0; j < ncorres_ji; ++j) {
-        ci = corres_ji[j].first;
-        cj = corres_ji[j].second;
-        Mj[cj].push_back(ci);
-    }
     for (int i = 0; i < nPti; ++i) {
-        for (size_t ii = 0; ii < Mi[i].size(); ++ii) {
-            int j = Mi[i][ii];
-            for (size_t jj = 0; jj < Mj[j].size(); ++jj) {
-                if (Mj[j][jj] == i)
-                    corres_cross.push_back(std::pair<int, int>(i, j));
-            }
+        int j = i_to_j[i];
+        if (j >= 0 && j_to_i[j] == i) {
+            corres_cross.push_back(std::pair<int, int>(i, j));
         }
     }
-    utility::LogDebug("points are remained : %d\n", (int)corres_cross.size());
+    utility::LogDebug("points are remained : {:d}\n", (int)corres_cross.size());
 
     // STEP 3) TUPLE CONSTRAINT
+    // The trials are drawn in fixed-size blocks, each with its own random
+    // stream derived from the seed. Blocks are evaluated in parallel in waves
+    // and the accepted tuples are kept in block order until
+    // maximum_tuple_count_ is reached.
     utility::LogDebug("\t[tuple constraint] ");
-    std::srand((unsigned int)std::time(0));
-    int rand0, rand1, rand2, i, cnt = 0;
-    int idi0, idi1, idi2, idj0, idj1, idj2;
+    unsigned int seed = GetTupleSeed(option);
     double scale = option.tuple_scale_;
     int ncorr = static_cast<int>(corres_cross.size());
     int number_of_trial = ncorr * 100;
-    std::vector<std::pair<int, int>> corres_tuple;
-    for (i = 0; i < number_of_trial; i++) {
-        rand0 = rand() % ncorr;
-        rand1 = rand() % ncorr;
-        rand2 = rand() % ncorr;
-        idi0 = corres_cross[rand0].first;
-        idj0 = corres_cross[rand0].second;
-        idi1 = corres_cross[rand1].first;
-        idj1 = corres_cross[rand1].second;
-        idi2 = corres_cross[rand2].first;
-        idj2 = corres_cross[rand2].second;
+    int num_blocks = (number_of_trial + kTupleTrialsPerBlock - 1) /
+                     kTupleTrialsPerBlock;
+    int max_tuple_count = std::max(option.maximum_tuple_count_, 0);
+    const auto& points_i = point_cloud_vec[fi].points_;
+    const auto& points_j = point_cloud_vec[fj].points_;
+    auto check_tuple = [&](int rand0, int rand1, int rand2) {
+        int idi0 = corres_cross[rand0].first;
+        int idj0 = corres_cross[rand0].second;
+        int idi1 = corres_cross[rand1].first;
+        int idj1 = corres_cross[rand1].second;
+        int idi2 = corres_cross[rand2].first;
+        int idj2 = corres_cross[rand2].second;
 
         // collect 3 points from i-th fragment
-        Eigen::Vector3d pti0 = point_cloud_vec[fi].points_[idi0];
-        Eigen::Vector3d pti1 = point_cloud_vec[fi].points_[idi1];
-        Eigen::Vector3d pti2 = point_cloud_vec[fi].points_[idi2];
-        double li0 = (pti0 - pti1).norm();
-        double li1 = (pti1 - pti2).norm();
-        double li2 = (pti2 - pti0).norm();
+        double li0 = (points_i[idi0] - points_i[idi1]).norm();
+        double li1 = (points_i[idi1] - points_i[idi2]).norm();
+        double li2 = (points_i[idi2] - points_i[idi0]).norm();
 
         // collect 3 points from j-th fragment
-        Eigen::Vector3d ptj0 = point_cloud_vec[fj].points_[idj0];
-        Eigen::Vector3d ptj1 = point_cloud_vec[fj].points_[idj1];
-        Eigen::Vector3d ptj2 = point_cloud_vec[fj].points_[idj2];
-        double lj0 = (ptj0 - ptj1).norm();
-        double lj1 = (ptj1 - ptj2).norm();
-        double lj2 = (ptj2 - ptj0).norm();
+        double lj0 = (points_j[idj0] - points_j[idj1]).norm();
+        double lj1 = (points_j[idj1] - points_j[idj2]).norm();
+        double lj2 = (points_j[idj2] - points_j[idj0]).norm();
 
         // check tuple constraint
-        if ((li0 * scale < lj0) && (lj0 < li0 / scale) && (li1 * scale < lj1) &&
-            (lj1 < li1 / scale) && (li2 * scale < lj2) && (lj2 < li2 / scale)) {
-            corres_tuple.push_back(std::pair<int, int>(idi0, idj0));
-            corres_tuple.push_back(std::pair<int, int>(idi1, idj1));
-            corres_tuple.push_back(std::pair<int, int>(idi2, idj2));
-            cnt++;
+        return (li0 * scale < lj0) && (lj0 < li0 / scale) &&
+               (li1 * scale < lj1) && (lj1 < li1 / scale) &&
+               (li2 * scale < lj2) && (lj2 < li2 / scale);
+    };
+
+    // Accepted tuples as (rand0, rand1, rand2, trial).
+    typedef std::array<int, 4> Tuple;
+    std::vector<Tuple> tuples;
+    int wave_size = 1;
+#ifdef _OPENMP
+    wave_size = omp_get_max_threads();
+#endif
+    int number_of_actual_trial = 0;
+    for (int wave_begin = 0;
+         wave_begin < num_blocks && int(tuples.size()) < max_tuple_count;
+         wave_begin += wave_size) {
+        int wave_end = std::min(wave_begin + wave_size, num_blocks);
+        std::vector<std::vector<Tuple>> block_tuples(wave_end - wave_begin);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (int b = wave_begin; b < wave_end; b++) {
+            std::seed_seq seq{seed, (unsigned int)b};
+            std::mt19937 generator(seq);
+            std::uniform_int_distribution<int> distribution(0, ncorr - 1);
+            int trial_begin = b * kTupleTrialsPerBlock;
+            int trial_end = std::min(trial_begin + kTupleTrialsPerBlock,
+                                     number_of_trial);
+            auto& accepted = block_tuples[b - wave_begin];
+            for (int t = trial_begin; t < trial_end; t++) {
+                int rand0 = distribution(generator);
+                int rand1 = distribution(generator);
+                int rand2 = distribution(generator);
+                if (check_tuple(rand0, rand1, rand2)) {
+                    accepted.push_back(Tuple{{rand0, rand1, rand2, t}});
+                    if (int(accepted.size()) >= max_tuple_count) break;
+                }
+            }
+        }
+        for (const auto& accepted : block_tuples) {
+            for (const auto& tuple : accepted) {
+                if (int(tuples.size()) >= max_tuple_count) break;
+                tuples.push_back(tuple);
+            }
         }
-        if (cnt >= option.maximum_tuple_count_) break;
+        number_of_actual_trial = std::min(wave_end * kTupleTrialsPerBlock,
+                                          number_of_trial);
     }
-    utility::LogDebug("{:d} tuples ({:d} trial, {:d} actual).\n", cnt,
-                      number_of_trial, i);
-
-    if (swapped) {
-        std::vector<std::pair<int, int>> temp;
-        for (size_t i = 0; i < corres_tuple.size(); i++)
-            temp.push_back(std::pair<int, int>(corres_tuple[i].second,
-                                               corres_tuple[i].first));
-        corres_tuple.clear();
-        corres_tuple = temp;
+    if (max_tuple_count > 0 && int(tuples.size()) >= max_tuple_count) {
+        number_of_actual_trial = tuples.back()[3] + 1;
+    }
+    utility::LogDebug("{:d} tuples ({:d} trial, {:d} actual).\n",
+                      (int)tuples.size(), number_of_trial,
+                      number_of_actual_trial);
+
+    std::vector<std::pair<int, int>> corres_tuple;
+    corres_tuple.reserve(tuples.size() * 3);
+    for (const auto& tuple : tuples) {
+        for (int k = 0; k < 3; k++) {
+            const auto& c = corres_cross[tuple[k]];
+            if (swapped) {
+                corres_tuple.push_back(std::pair<int, int>(c.second, c.first));
+            } else {
+                corres_tuple.push_back(c);
+            }
+        }
     }
     utility::LogDebug("\t[final] matches {:d}.\n", (int)corres_tuple.size());
     return corres_tuple;
@@ -195,21 +259,33 @@ std::tuple<std::vector<Eigen::Vector3d>, double, double> NormalizePointCloud(
         Eigen::Vector3d mean;
         mean.setZero();
 
-        int npti = static_cast<int>(point_cloud_vec[i].points_.size());
-        for (int ii = 0; ii < npti; ++ii)
-            mean = mean + point_cloud_vec[i].points_[ii];
+        // The mean is summed serially so that it does not depend on the
+        // number of threads.
+        auto& points = point_cloud_vec[i].points_;
+        int npti = static_cast<int>(points.size());
+        for (int ii = 0; ii < npti; ++ii) mean = mean + points[ii];
         mean = mean / npti;
         pcd_mean_vec.push_back(mean);
 
         utility::LogDebug("normalize points :: mean = [{:f} {:f} {:f}]\n",
                           mean(0), mean(1), mean(2));
-        for (int ii = 0; ii < npti; ++ii)
-            point_cloud_vec[i].points_[ii] -= mean;
-
-        for (int ii = 0; ii < npti; ++ii) {
-            Eigen::Vector3d p(point_cloud_vec[i].points_[ii]);
-            double temp = p.norm();
-            if (temp > max_scale) max_scale = temp;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            double local_max_scale = 0.0;
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+            for (int ii = 0; ii < npti; ++ii) {
+                points[ii] -= mean;
+                double temp = points[ii].norm();
+                if (temp > local_max_scale) local_max_scale = temp;
+            }
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            { max_scale = std::max(max_scale, local_max_scale); }
         }
         if (max_scale > scale) scale = max_scale;
     }
@@ -225,9 +301,13 @@ std::tuple<std::vector<Eigen::Vector3d>, double, double> NormalizePointCloud(
                       scale_global);
 
     for (int i = 0; i < num; ++i) {
-        int npti = static_cast<int>(point_cloud_vec[i].points_.size());
+        auto& points = point_cloud_vec[i].points_;
+        int npti = static_cast<int>(points.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
         for (int ii = 0; ii < npti; ++ii) {
-            point_cloud_vec[i].points_[ii] /= scale_global;
+            points[ii] /= scale_global;
         }
     }
     return std::make_tuple(pcd_mean_vec, scale_global, scale_start);
@@ -243,69 +323,79 @@ Eigen::Matrix4d OptimizePairwiseRegistration(
     int numIter = option.iteration_number_;
 
     int i = 0, j = 1;
-    geometry::PointCloud point_cloud_copy_j = point_cloud_vec[j];
 
     if (corres.size() < 10) return Eigen::Matrix4d::Identity();
 
-    std::vector<double> s(corres.size(), 1.0);
+    // Only the corresponding points of fragment j are moved by the
+    // optimization, so they are gathered once instead of transforming the
+    // whole fragment every iteration.
+    int ncorres = int(corres.size());
+    std::vector<Eigen::Vector3d> p_points(ncorres), q_points(ncorres);
+    for (int c = 0; c < ncorres; c++) {
+        p_points[c] = point_cloud_vec[i].points_[corres[c].first];
+        q_points[c] = point_cloud_vec[j].points_[corres[c].second];
+    }
+
+    int num_blocks =
+            (ncorres + kCorrespondencesPerBlock - 1) / kCorrespondencesPerBlock;
+    std::vector<Eigen::Matrix6d, utility::Matrix6d_allocator> block_JTJ(
+            num_blocks);
+    std::vector<Eigen::Vector6d, utility::Vector6d_allocator> block_JTr(
+            num_blocks);
     Eigen::Matrix4d trans;
     trans.setIdentity();
 
     for (int itr = 0; itr < numIter; itr++) {
-        const int nvariable = 6;
-        Eigen::MatrixXd JTJ(nvariable, nvariable);
-        Eigen::MatrixXd JTr(nvariable, 1);
-        Eigen::MatrixXd J(nvariable, 1);
-        JTJ.setZero();
-        JTr.setZero();
-        double r = 0.0, r2 = 0.0;
-
-        for (size_t c = 0; c < corres.size(); c++) {
-            int ii = corres[c].first;
-            int jj = corres[c].second;
-            Eigen::Vector3d p, q;
-            p = point_cloud_vec[i].points_[ii];
-            q = point_cloud_copy_j.points_[jj];
-            Eigen::Vector3d rpq = p - q;
-
-            size_t c2 = c;
-            double temp = par / (rpq.dot(rpq) + par);
-            s[c2] = temp * temp;
-
-            J.setZero();
-            J(1) = -q(2);
-            J(2) = q(1);
-            J(3) = -1;
-            r = rpq(0);
-            JTJ += J * J.transpose() * s[c2];
-            JTr += J * r * s[c2];
-            r2 += r * r * s[c2];
-
-            J.setZero();
-            J(2) = -q(0);
-            J(0) = q(2);
-            J(4) = -1;
-            r = rpq(1);
-            JTJ += J * J.transpose() * s[c2];
-            JTr += J * r * s[c2];
-            r2 += r * r * s[c2];
-
-            J.setZero();
-            J(0) = -q(1);
-            J(1) = q(0);
-            J(5) = -1;
-            r = rpq(2);
-            JTJ += J * J.transpose() * s[c2];
-            JTr += J * r * s[c2];
-            r2 += r * r * s[c2];
-            r2 += (par * (1.0 - sqrt(s[c2])) * (1.0 - sqrt(s[c2])));
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int b = 0; b < num_blocks; b++) {
+            Eigen::Matrix6d JTJ = Eigen::Matrix6d::Zero();
+            Eigen::Vector6d JTr = Eigen::Vector6d::Zero();
+            int c_end = std::min((b + 1) * kCorrespondencesPerBlock, ncorres);
+            for (int c = b * kCorrespondencesPerBlock; c < c_end; c++) {
+                const Eigen::Vector3d& q = q_points[c];
+                Eigen::Vector3d rpq = p_points[c] - q;
+                double temp = par / (rpq.dot(rpq) + par);
+                double s = temp * temp;
+
+                Eigen::Vector6d J;
+                J << 0.0, -q(2), q(1), -1.0, 0.0, 0.0;
+                JTJ.noalias() += J * J.transpose() * s;
+                JTr.noalias() += J * rpq(0) * s;
+
+                J << q(2), 0.0, -q(0), 0.0, -1.0, 0.0;
+                JTJ.noalias() += J * J.transpose() * s;
+                JTr.noalias() += J * rpq(1) * s;
+
+                J << -q(1), q(0), 0.0, 0.0, 0.0, -1.0;
+                JTJ.noalias() += J * J.transpose() * s;
+                JTr.noalias() += J * rpq(2) * s;
+            }
+            block_JTJ[b] = JTJ;
+            block_JTr[b] = JTr;
+        }
+        Eigen::MatrixXd JTJ = Eigen::MatrixXd::Zero(6, 6);
+        Eigen::VectorXd JTr = Eigen::VectorXd::Zero(6);
+        for (int b = 0; b < num_blocks; b++) {
+            JTJ += block_JTJ[b];
+            JTr += block_JTr[b];
         }
+
         bool success;
         Eigen::VectorXd result;
         std::tie(success, result) = utility::SolveLinearSystemPSD(-JTJ, JTr);
         Eigen::Matrix4d delta = utility::TransformVector6dToMatrix4d(result);
         trans = delta * trans;
-        point_cloud_copy_j.Transform(delta);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int c = 0; c < ncorres; c++) {
+            Eigen::Vector3d& q = q_points[c];
+            Eigen::Vector4d new_q =
+                    delta * Eigen::Vector4d(q(0), q(1), q(2), 1.0);
+            q = new_q.head<3>() / new_q(3);
+        }
 
         // graduated non-convexity.
         if (option.decrease_mu_) {
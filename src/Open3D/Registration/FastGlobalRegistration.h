@@ -50,14 +50,16 @@ public:
                                  double maximum_correspondence_distance = 0.025,
                                  int iteration_number = 64,
                                  double tuple_scale = 0.95,
-                                 int maximum_tuple_count = 1000)
+                                 int maximum_tuple_count = 1000,
+                                 int seed = -1)
         : division_factor_(division_factor),
           use_absolute_scale_(use_absolute_scale),
           decrease_mu_(decrease_mu),
           maximum_correspondence_distance_(maximum_correspondence_distance),
           iteration_number_(iteration_number),
           tuple_scale_(tuple_scale),
-          maximum_tuple_count_(maximum_tuple_count) {}
+          maximum_tuple_count_(maximum_tuple_count),
+          seed_(seed) {}
     ~FastGlobalRegistrationOption() {}
 
 public:
@@ -75,6 +77,10 @@ public:
     double tuple_scale_;
     // Maximum tuple numbers.
     int maximum_tuple_count_;
+    // Seed of the random tuple test. The result is reproducible for a fixed
+    // non-negative seed regardless of the number of threads. A negative seed
+    // uses the current time.
+    int seed_;
 };
 
 RegistrationResult FastGlobalRegistration(
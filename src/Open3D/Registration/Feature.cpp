@@ -30,6 +30,7 @@
 
 #include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/PointCloudNeighborhoods.h"
 #include "Open3D/Utility/Console.h"
 
 namespace open3d {
@@ -71,40 +72,150 @@ Eigen::Vector4d ComputePairFeatures(const Eigen::Vector3d &p1,
     return result;
 }
 
+/// Neighborhoods searched per point in a KD-tree. Only the buffers of the
+/// current point are held, so the memory does not grow with the cloud.
+class KDTreeNeighborhoods {
+public:
+    KDTreeNeighborhoods(const geometry::PointCloud &input,
+                        const geometry::KDTreeSearchParam &search_param)
+        : input_(input), kdtree_(input), search_param_(search_param) {}
+
+    /// Points \p indices and \p distance2 at the neighbors of point \p i,
+    /// which are searched into \p index_buffer and \p distance2_buffer.
+    int Get(int i,
+            std::vector<int> &index_buffer,
+            std::vector<double> &distance2_buffer,
+            const int *&indices,
+            const double *&distance2) const {
+        int count = kdtree_.Search(input_.points_[i], search_param_,
+                                   index_buffer, distance2_buffer);
+        indices = index_buffer.data();
+        distance2 = distance2_buffer.data();
+        return count;
+    }
+
+private:
+    const geometry::PointCloud &input_;
+    geometry::KDTreeFlann kdtree_;
+    const geometry::KDTreeSearchParam &search_param_;
+};
+
+/// Precomputed neighborhoods, read in place.
+class SharedNeighborhoods {
+public:
+    explicit SharedNeighborhoods(
+            const geometry::PointCloudNeighborhoods &neighborhoods)
+        : neighborhoods_(neighborhoods) {}
+
+    int Get(int i,
+            std::vector<int> & /*index_buffer*/,
+            std::vector<double> & /*distance2_buffer*/,
+            const int *&indices,
+            const double *&distance2) const {
+        indices = neighborhoods_.Indices(i);
+        distance2 = neighborhoods_.Distance2(i);
+        return neighborhoods_.NumNeighbors(i);
+    }
+
+private:
+    const geometry::PointCloudNeighborhoods &neighborhoods_;
+};
+
+template <typename Neighborhoods>
 std::shared_ptr<Feature> ComputeSPFHFeature(
         const geometry::PointCloud &input,
-        const geometry::KDTreeFlann &kdtree,
-        const geometry::KDTreeSearchParam &search_param) {
+        const Neighborhoods &neighborhoods) {
     auto feature = std::make_shared<Feature>();
     feature->Resize(33, (int)input.points_.size());
 #ifdef _OPENMP
-#pragma omp parallel for schedule(static)
+#pragma omp parallel
+#endif
+    {
+        std::vector<int> index_buffer;
+        std::vector<double> distance2_buffer;
+#ifdef _OPENMP
+#pragma omp for schedule(static)
 #endif
-    for (int i = 0; i < (int)input.points_.size(); i++) {
-        const auto &point = input.points_[i];
-        const auto &normal = input.normals_[i];
-        std::vector<int> indices;
-        std::vector<double> distance2;
-        if (kdtree.Search(point, search_param, indices, distance2) > 1) {
-            // only compute SPFH feature when a point has neighbors
-            double hist_incr = 100.0 / (double)(indices.size() - 1);
-            for (size_t k = 1; k < indices.size(); k++) {
-                // skip the point itself, compute histogram
-                auto pf = ComputePairFeatures(point, normal,
-                                              input.points_[indices[k]],
-                                              input.normals_[indices[k]]);
-                int h_index = (int)(floor(11 * (pf(0) + M_PI) / (2.0 * M_PI)));
-                if (h_index < 0) h_index = 0;
-                if (h_index >= 11) h_index = 10;
-                feature->data_(h_index, i) += hist_incr;
-                h_index = (int)(floor(11 * (pf(1) + 1.0) * 0.5));
-                if (h_index < 0) h_index = 0;
-                if (h_index >= 11) h_index = 10;
-                feature->data_(h_index + 11, i) += hist_incr;
-                h_index = (int)(floor(11 * (pf(2) + 1.0) * 0.5));
-                if (h_index < 0) h_index = 0;
-                if (h_index >= 11) h_index = 10;
-                feature->data_(h_index + 22, i) += hist_incr;
+        for (int i = 0; i < (int)input.points_.size(); i++) {
+            const auto &point = input.points_[i];
+            const auto &normal = input.normals_[i];
+            const int *indices;
+            const double *distance2;
+            int count = neighborhoods.Get(i, index_buffer, distance2_buffer,
+                                          indices, distance2);
+            if (count > 1) {
+                // only compute SPFH feature when a point has neighbors
+                double hist_incr = 100.0 / (double)(count - 1);
+                for (int k = 1; k < count; k++) {
+                    // skip the point itself, compute histogram
+                    auto pf = ComputePairFeatures(point, normal,
+                                                  input.points_[indices[k]],
+                                                  input.normals_[indices[k]]);
+                    int h_index =
+                            (int)(floor(11 * (pf(0) + M_PI) / (2.0 * M_PI)));
+                    if (h_index < 0) h_index = 0;
+                    if (h_index >= 11) h_index = 10;
+                    feature->data_(h_index, i) += hist_incr;
+                    h_index = (int)(floor(11 * (pf(1) + 1.0) * 0.5));
+                    if (h_index < 0) h_index = 0;
+                    if (h_index >= 11) h_index = 10;
+                    feature->data_(h_index + 11, i) += hist_incr;
+                    h_index = (int)(floor(11 * (pf(2) + 1.0) * 0.5));
+                    if (h_index < 0) h_index = 0;
+                    if (h_index >= 11) h_index = 10;
+                    feature->data_(h_index + 22, i) += hist_incr;
+                }
+            }
+        }
+    }
+    return feature;
+}
+
+/// Both the SPFH and the FPFH pass go over the same \p neighborhoods.
+template <typename Neighborhoods>
+std::shared_ptr<Feature> ComputeFPFHFeatureFromNeighborhoods(
+        const geometry::PointCloud &input,
+        const Neighborhoods &neighborhoods) {
+    auto feature = std::make_shared<Feature>();
+    feature->Resize(33, (int)input.points_.size());
+    auto spfh = ComputeSPFHFeature(input, neighborhoods);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        std::vector<int> index_buffer;
+        std::vector<double> distance2_buffer;
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (int i = 0; i < (int)input.points_.size(); i++) {
+            const int *indices;
+            const double *distance2;
+            int count = neighborhoods.Get(i, index_buffer, distance2_buffer,
+                                          indices, distance2);
+            if (count > 1) {
+                double sum[3] = {0.0, 0.0, 0.0};
+                for (int k = 1; k < count; k++) {
+                    // skip the point itself
+                    double dist = distance2[k];
+                    if (dist == 0.0) continue;
+                    for (int j = 0; j < 33; j++) {
+                        double val = spfh->data_(j, indices[k]) / dist;
+                        sum[j / 11] += val;
+                        feature->data_(j, i) += val;
+                    }
+                }
+                for (int j = 0; j < 3; j++)
+                    if (sum[j] != 0.0) sum[j] = 100.0 / sum[j];
+                for (int j = 0; j < 33; j++) {
+                    feature->data_(j, i) *= sum[j / 11];
+                    // The commented line is the fpfh function in the paper.
+                    // But according to PCL implementation, it is skipped.
+                    // Our initial test shows that the full fpfh function in
+                    // the paper seems to be better than PCL implementation.
+                    // Further test required.
+                    feature->data_(j, i) += spfh->data_(j, i);
+                }
             }
         }
     }
@@ -118,49 +229,40 @@ std::shared_ptr<Feature> ComputeFPFHFeature(
         const geometry::PointCloud &input,
         const geometry::KDTreeSearchParam
                 &search_param /* = geometry::KDTreeSearchParamKNN()*/) {
-    auto feature = std::make_shared<Feature>();
-    feature->Resize(33, (int)input.points_.size());
     if (input.HasNormals() == false) {
         utility::LogWarning(
                 "[ComputeFPFHFeature] Failed because input point cloud has no "
                 "normal.\n");
+        auto feature = std::make_shared<Feature>();
+        feature->Resize(33, (int)input.points_.size());
         return feature;
     }
-    geometry::KDTreeFlann kdtree(input);
-    auto spfh = ComputeSPFHFeature(input, kdtree, search_param);
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int i = 0; i < (int)input.points_.size(); i++) {
-        const auto &point = input.points_[i];
-        std::vector<int> indices;
-        std::vector<double> distance2;
-        if (kdtree.Search(point, search_param, indices, distance2) > 1) {
-            double sum[3] = {0.0, 0.0, 0.0};
-            for (size_t k = 1; k < indices.size(); k++) {
-                // skip the point itself
-                double dist = distance2[k];
-                if (dist == 0.0) continue;
-                for (int j = 0; j < 33; j++) {
-                    double val = spfh->data_(j, indices[k]) / dist;
-                    sum[j / 11] += val;
-                    feature->data_(j, i) += val;
-                }
-            }
-            for (int j = 0; j < 3; j++)
-                if (sum[j] != 0.0) sum[j] = 100.0 / sum[j];
-            for (int j = 0; j < 33; j++) {
-                feature->data_(j, i) *= sum[j / 11];
-                // The commented line is the fpfh function in the paper.
-                // But according to PCL implementation, it is skipped.
-                // Our initial test shows that the full fpfh function in the
-                // paper seems to be better than PCL implementation. Further
-                // test required.
-                feature->data_(j, i) += spfh->data_(j, i);
-            }
-        }
+    return ComputeFPFHFeatureFromNeighborhoods(
+            input, KDTreeNeighborhoods(input, search_param));
+}
+
+std::shared_ptr<Feature> ComputeFPFHFeature(
+        const geometry::PointCloud &input,
+        const geometry::PointCloudNeighborhoods &neighborhoods) {
+    if (input.HasNormals() == false) {
+        utility::LogWarning(
+                "[ComputeFPFHFeature] Failed because input point cloud has no "
+                "normal.\n");
+        auto feature = std::make_shared<Feature>();
+        feature->Resize(33, (int)input.points_.size());
+        return feature;
     }
-    return feature;
+    if (neighborhoods.Size() != input.points_.size()) {
+        utility::LogWarning(
+                "[ComputeFPFHFeature] Neighborhoods were computed for {:d} "
+                "points, but the point cloud has {:d} points.\n",
+                neighborhoods.Size(), input.points_.size());
+        auto feature = std::make_shared<Feature>();
+        feature->Resize(33, (int)input.points_.size());
+        return feature;
+    }
+    return ComputeFPFHFeatureFromNeighborhoods(
+            input, SharedNeighborhoods(neighborhoods));
 }
 
 }  // namespace registration
@@ -36,6 +36,7 @@ namespace open3d {
 
 namespace geometry {
 class PointCloud;
+class PointCloudNeighborhoods;
 }
 
 namespace registration {
@@ -59,5 +60,12 @@ std::shared_ptr<Feature> ComputeFPFHFeature(
         const geometry::KDTreeSearchParam &search_param =
                 geometry::KDTreeSearchParamKNN());
 
+/// Function to compute FPFH feature for a point cloud from the precomputed
+/// \param neighborhoods of its points, for instance the ones used to
+/// estimate its normals.
+std::shared_ptr<Feature> ComputeFPFHFeature(
+        const geometry::PointCloud &input,
+        const geometry::PointCloudNeighborhoods &neighborhoods);
+
 }  // namespace registration
 }  // namespace open3d
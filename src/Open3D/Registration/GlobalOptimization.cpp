@@ -36,6 +36,7 @@
 #include "Open3D/Registration/PoseGraph.h"
 #include "Open3D/Utility/Console.h"
 #include "Open3D/Utility/Eigen.h"
+#include "Open3D/Utility/Profiler.h"
 #include "Open3D/Utility/Timer.h"
 
 namespace open3d {
@@ -566,6 +567,7 @@ void GlobalOptimizationGaussNewton::OptimizePoseGraph(
         PoseGraph &pose_graph,
         const GlobalOptimizationConvergenceCriteria &criteria,
         const GlobalOptimizationOption &option) const {
+    OPEN3D_PROFILE_ZONE("GlobalOptimizationGaussNewton::OptimizePoseGraph");
     int n_nodes = (int)pose_graph.nodes_.size();
     int n_edges = (int)pose_graph.edges_.size();
     double line_process_weight = ComputeLineProcessWeight(pose_graph, option);
@@ -658,6 +660,8 @@ void GlobalOptimizationLevenbergMarquardt::OptimizePoseGraph(
         PoseGraph &pose_graph,
         const GlobalOptimizationConvergenceCriteria &criteria,
         const GlobalOptimizationOption &option) const {
+    OPEN3D_PROFILE_ZONE(
+            "GlobalOptimizationLevenbergMarquardt::OptimizePoseGraph");
     int n_nodes = (int)pose_graph.nodes_.size();
     int n_edges = (int)pose_graph.edges_.size();
     double line_process_weight = ComputeLineProcessWeight(pose_graph, option);
@@ -778,6 +782,7 @@ void GlobalOptimization(PoseGraph &pose_graph,
                         /* = GlobalOptimizationConvergenceCriteria() */,
                         const GlobalOptimizationOption &option
                         /* = GlobalOptimizationOption() */) {
+    OPEN3D_PROFILE_ZONE("GlobalOptimization");
     if (!ValidatePoseGraph(pose_graph)) return;
     std::shared_ptr<PoseGraph> pose_graph_pre = std::make_shared<PoseGraph>();
     *pose_graph_pre = pose_graph;
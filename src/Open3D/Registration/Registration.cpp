@@ -33,6 +33,7 @@
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Registration/Feature.h"
 #include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Profiler.h"
 
 namespace open3d {
 
@@ -153,6 +154,23 @@ RegistrationResult RegistrationICP(
         /* = TransformationEstimationPointToPoint(false)*/,
         const ICPConvergenceCriteria
                 &criteria /* = ICPConvergenceCriteria()*/) {
+    geometry::KDTreeFlann kdtree;
+    kdtree.SetGeometry(target);
+    return RegistrationICP(source, target, kdtree, max_correspondence_distance,
+                           init, estimation, criteria);
+}
+
+RegistrationResult RegistrationICP(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const geometry::KDTreeFlann &target_kdtree,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d &init /* = Eigen::Matrix4d::Identity()*/,
+        const TransformationEstimation &estimation
+        /* = TransformationEstimationPointToPoint(false)*/,
+        const ICPConvergenceCriteria
+                &criteria /* = ICPConvergenceCriteria()*/) {
+    OPEN3D_PROFILE_ZONE("RegistrationICP");
     if (max_correspondence_distance <= 0.0) {
         utility::LogWarning("Invalid max_correspondence_distance.\n");
         return RegistrationResult(init);
@@ -167,15 +185,14 @@ RegistrationResult RegistrationICP(
     }
 
     Eigen::Matrix4d transformation = init;
-    geometry::KDTreeFlann kdtree;
-    kdtree.SetGeometry(target);
     geometry::PointCloud pcd = source;
     if (init.isIdentity() == false) {
         pcd.Transform(init);
     }
     RegistrationResult result;
     result = GetRegistrationResultAndCorrespondences(
-            pcd, target, kdtree, max_correspondence_distance, transformation);
+            pcd, target, target_kdtree, max_correspondence_distance,
+            transformation);
     for (int i = 0; i < criteria.max_iteration_; i++) {
         utility::LogDebug("ICP Iteration #{:d}: Fitness {:.4f}, RMSE {:.4f}\n",
                           i, result.fitness_, result.inlier_rmse_);
@@ -185,7 +202,7 @@ RegistrationResult RegistrationICP(
         pcd.Transform(update);
         RegistrationResult backup = result;
         result = GetRegistrationResultAndCorrespondences(
-                pcd, target, kdtree, max_correspondence_distance,
+                pcd, target, target_kdtree, max_correspondence_distance,
                 transformation);
         if (std::abs(backup.fitness_ - result.fitness_) <
                     criteria.relative_fitness_ &&
@@ -38,6 +38,7 @@ namespace open3d {
 
 namespace geometry {
 class PointCloud;
+class KDTreeFlann;
 }
 
 namespace registration {
@@ -113,6 +114,18 @@ RegistrationResult RegistrationICP(
                 TransformationEstimationPointToPoint(false),
         const ICPConvergenceCriteria &criteria = ICPConvergenceCriteria());
 
+/// Function for ICP registration against a target whose KDTree has already
+/// been built. \p target_kdtree must have been built from \p target.
+RegistrationResult RegistrationICP(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const geometry::KDTreeFlann &target_kdtree,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d &init = Eigen::Matrix4d::Identity(),
+        const TransformationEstimation &estimation =
+                TransformationEstimationPointToPoint(false),
+        const ICPConvergenceCriteria &criteria = ICPConvergenceCriteria());
+
 /// Function for global RANSAC registration based on a given set of
 /// correspondences
 RegistrationResult RegistrationRANSACBasedOnCorrespondence(
@@ -28,9 +28,17 @@
 
 #include <Eigen/Core>
 #include <Eigen/StdVector>
+#include <algorithm>
 #include <tuple>
+#include <utility>
 #include <vector>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "Open3D/Utility/Console.h"
+
 namespace Eigen {
 
 /// Extending Eigen namespace by adding frequently used matrix type
@@ -88,30 +96,180 @@ std::tuple<bool, std::vector<Eigen::Matrix4d, Matrix4d_allocator>>
 SolveJacobianSystemAndObtainExtrinsicMatrixArray(const Eigen::MatrixXd &JTJ,
                                                  const Eigen::VectorXd &JTr);
 
+/// Partial sums of JTJ, JTr and r^2 over a subset of the rows of a Jacobian
+/// matrix with rows of type VecType. Only the upper triangle of JTJ is
+/// accumulated, packed row by row into a fixed-size array, so that the
+/// compiler unrolls and vectorizes the update.
+template <typename VecType>
+class JTJandJTrPartialSum {
+public:
+    static_assert(VecType::SizeAtCompileTime != Eigen::Dynamic,
+                  "Rows of the Jacobian matrix must have a fixed size.");
+    static const int kSize = VecType::SizeAtCompileTime;
+    static const int kUpperSize = kSize * (kSize + 1) / 2;
+
+public:
+    JTJandJTrPartialSum() { SetZero(); }
+
+    void SetZero() {
+        std::fill(JTJ_upper_, JTJ_upper_ + kUpperSize, 0.0);
+        std::fill(JTr_, JTr_ + kSize, 0.0);
+        r2_sum_ = 0.0;
+    }
+
+    void AddRow(const VecType &J_r, double r) {
+        int k = 0;
+        for (int row = 0; row < kSize; row++) {
+            const double J_row = J_r(row);
+            for (int col = row; col < kSize; col++, k++) {
+                JTJ_upper_[k] += J_row * J_r(col);
+            }
+            JTr_[row] += J_row * r;
+        }
+        r2_sum_ += r * r;
+    }
+
+    void Add(const JTJandJTrPartialSum &other) {
+        for (int k = 0; k < kUpperSize; k++) {
+            JTJ_upper_[k] += other.JTJ_upper_[k];
+        }
+        for (int k = 0; k < kSize; k++) {
+            JTr_[k] += other.JTr_[k];
+        }
+        r2_sum_ += other.r2_sum_;
+    }
+
+    template <typename MatType>
+    std::tuple<MatType, VecType, double> GetJTJandJTr() const {
+        MatType JTJ;
+        VecType JTr;
+        int k = 0;
+        for (int row = 0; row < kSize; row++) {
+            for (int col = row; col < kSize; col++, k++) {
+                JTJ(row, col) = JTJ_upper_[k];
+                JTJ(col, row) = JTJ_upper_[k];
+            }
+            JTr(row) = JTr_[row];
+        }
+        return std::make_tuple(std::move(JTJ), std::move(JTr), r2_sum_);
+    }
+
+private:
+    double JTJ_upper_[kUpperSize];
+    double JTr_[kSize];
+    double r2_sum_;
+};
+
+/// Sums \p partials pairwise in a binary tree into partials[0]. The result
+/// only depends on the number of partial sums, not on the order in which the
+/// threads computed them.
+template <typename PartialSum>
+void TreeReduce(std::vector<PartialSum> &partials) {
+    for (size_t stride = 1; stride < partials.size(); stride *= 2) {
+        for (size_t i = 0; i + stride < partials.size(); i += 2 * stride) {
+            partials[i].Add(partials[i + stride]);
+        }
+    }
+}
+
 /// Function to compute JTJ and Jtr
-/// Input: function pointer f and total number of rows of Jacobian matrix
+/// Input: functor f and total number of rows of Jacobian matrix
 /// Output: JTJ, JTr, sum of r^2
 /// Note: f takes index of row, and outputs corresponding residual and row
-/// vector.
-template <typename MatType, typename VecType>
-std::tuple<MatType, VecType, double> ComputeJTJandJTr(
-        std::function<void(int, VecType &, double &)> f,
-        int iteration_num,
-        bool verbose = true);
+/// vector, i.e. f(int i, VecType &J_r, double &r). f is called directly, so
+/// lambdas are inlined into the loop over the rows.
+template <typename MatType, typename VecType, typename FuncType>
+auto ComputeJTJandJTr(FuncType f, int iteration_num, bool verbose = true)
+        -> decltype(f(0, std::declval<VecType &>(), std::declval<double &>()),
+                    std::tuple<MatType, VecType, double>()) {
+#ifdef _OPENMP
+    const int num_threads = omp_get_max_threads();
+#else
+    const int num_threads = 1;
+#endif
+    std::vector<JTJandJTrPartialSum<VecType>> partials(num_threads);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        JTJandJTrPartialSum<VecType> partial;
+        VecType J_r;
+        double r;
+#ifdef _OPENMP
+#pragma omp for nowait
+#endif
+        for (int i = 0; i < iteration_num; i++) {
+            f(i, J_r, r);
+            partial.AddRow(J_r, r);
+        }
+#ifdef _OPENMP
+        partials[omp_get_thread_num()] = partial;
+#else
+        partials[0] = partial;
+#endif
+    }
+    TreeReduce(partials);
+    std::tuple<MatType, VecType, double> result =
+            partials[0].template GetJTJandJTr<MatType>();
+    if (verbose) {
+        LogDebug("Residual : {:.2e} (# of elements : {:d})\n",
+                 std::get<2>(result) / (double)iteration_num, iteration_num);
+    }
+    return result;
+}
 
 /// Function to compute JTJ and Jtr
-/// Input: function pointer f and total number of rows of Jacobian matrix
+/// Input: functor f and total number of rows of Jacobian matrix
 /// Output: JTJ, JTr, sum of r^2
-/// Note: f takes index of row, and outputs corresponding residual and row
-/// vector.
-template <typename MatType, typename VecType>
-std::tuple<MatType, VecType, double> ComputeJTJandJTr(
-        std::function<
-                void(int,
-                     std::vector<VecType, Eigen::aligned_allocator<VecType>> &,
-                     std::vector<double> &)> f,
-        int iteration_num,
-        bool verbose = true);
+/// Note: f takes index of row, and outputs corresponding residuals and row
+/// vectors, i.e. f(int i, std::vector<VecType, Eigen::aligned_allocator<
+/// VecType>> &J_r, std::vector<double> &r). Every thread passes the same
+/// vectors to all its calls of f, so they are only allocated once.
+template <typename MatType, typename VecType, typename FuncType>
+auto ComputeJTJandJTr(FuncType f, int iteration_num, bool verbose = true)
+        -> decltype(f(0,
+                      std::declval<std::vector<
+                              VecType,
+                              Eigen::aligned_allocator<VecType>> &>(),
+                      std::declval<std::vector<double> &>()),
+                    std::tuple<MatType, VecType, double>()) {
+#ifdef _OPENMP
+    const int num_threads = omp_get_max_threads();
+#else
+    const int num_threads = 1;
+#endif
+    std::vector<JTJandJTrPartialSum<VecType>> partials(num_threads);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        JTJandJTrPartialSum<VecType> partial;
+        std::vector<VecType, Eigen::aligned_allocator<VecType>> J_r;
+        std::vector<double> r;
+#ifdef _OPENMP
+#pragma omp for nowait
+#endif
+        for (int i = 0; i < iteration_num; i++) {
+            f(i, J_r, r);
+            for (size_t j = 0; j < r.size(); j++) {
+                partial.AddRow(J_r[j], r[j]);
+            }
+        }
+#ifdef _OPENMP
+        partials[omp_get_thread_num()] = partial;
+#else
+        partials[0] = partial;
+#endif
+    }
+    TreeReduce(partials);
+    std::tuple<MatType, VecType, double> result =
+            partials[0].template GetJTJandJTr<MatType>();
+    if (verbose) {
+        LogDebug("Residual : {:.2e} (# of elements : {:d})\n",
+                 std::get<2>(result) / (double)iteration_num, iteration_num);
+    }
+    return result;
+}
 
 Eigen::Matrix3d RotationMatrixX(double radians);
 Eigen::Matrix3d RotationMatrixY(double radians);
@@ -31,13 +31,17 @@
 #include <cstdlib>
 #ifdef WINDOWS
 #include <direct.h>
+#include <windows.h>
+
 #include <dirent/dirent.h>
 #ifndef PATH_MAX
 #define PATH_MAX MAX_PATH
 #endif
 #else
 #include <dirent.h>
+#include <fcntl.h>
 #include <limits.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #endif
@@ -199,6 +203,71 @@ bool ListFilesInDirectoryWithExtension(const std::string &directory,
     return true;
 }
 
+bool MappedFile::Open(const std::string &filename) {
+    Close();
+#ifdef WINDOWS
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                              NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    // The mapping keeps its own reference to the file.
+    CloseHandle(file);
+    if (mapping == NULL) {
+        return false;
+    }
+    void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == NULL) {
+        CloseHandle(mapping);
+        return false;
+    }
+    mapping_ = mapping;
+    size_ = size_t(file_size.QuadPart);
+#else
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) == -1 || !S_ISREG(info.st_mode) ||
+        info.st_size == 0) {
+        close(fd);
+        return false;
+    }
+    void *data = mmap(NULL, size_t(info.st_size), PROT_READ, MAP_PRIVATE, fd,
+                      0);
+    // The mapping stays valid after the descriptor is closed.
+    close(fd);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+    size_ = size_t(info.st_size);
+#endif
+    data_ = static_cast<const char *>(data);
+    return true;
+}
+
+void MappedFile::Close() {
+    if (data_ == nullptr) {
+        return;
+    }
+#ifdef WINDOWS
+    UnmapViewOfFile(data_);
+    CloseHandle(static_cast<HANDLE>(mapping_));
+    mapping_ = nullptr;
+#else
+    munmap(const_cast<char *>(data_), size_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
+
 }  // namespace filesystem
 }  // namespace utility
 }  // namespace open3d
@@ -66,6 +66,36 @@ bool ListFilesInDirectoryWithExtension(const std::string &directory,
                                        const std::string &extname,
                                        std::vector<std::string> &filenames);
 
+/// \class MappedFile
+///
+/// \brief Read-only memory mapping of a whole file.
+///
+/// The file contents are paged in by the operating system on first access,
+/// which lets readers of large binary files decode directly from the mapping
+/// instead of copying through stdio buffers.
+class MappedFile {
+public:
+    MappedFile() {}
+    ~MappedFile() { Close(); }
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+public:
+    /// Maps \p filename. Returns false if the file cannot be opened, is
+    /// empty or cannot be mapped.
+    bool Open(const std::string &filename);
+    void Close();
+    bool IsOpen() const { return data_ != nullptr; }
+    const char *GetData() const { return data_; }
+    size_t GetSize() const { return size_; }
+
+private:
+    const char *data_ = nullptr;
+    size_t size_ = 0;
+    /// Handle of the file mapping object, only used on Windows.
+    void *mapping_ = nullptr;
+};
+
 }  // namespace filesystem
 }  // namespace utility
 }  // namespace open3d
@@ -26,7 +26,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <functional>
+#include <numeric>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -101,6 +103,59 @@ struct hash {
 
 }  // namespace hash_eigen
 
+/// Sorts \param values like std::sort with the comparison \param comp.
+/// Chunks of the vector are sorted in parallel and merged pairwise.
+template <typename T, typename Compare>
+void ParallelSort(std::vector<T>& values, Compare comp) {
+    const int num_chunks =
+            int(std::min<size_t>(64, values.size() / 16384 + 1));
+    std::vector<size_t> bounds(num_chunks + 1);
+    for (int i = 0; i <= num_chunks; ++i) {
+        bounds[i] = values.size() * i / num_chunks;
+    }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < num_chunks; ++i) {
+        std::sort(values.begin() + bounds[i], values.begin() + bounds[i + 1],
+                  comp);
+    }
+    for (int width = 1; width < num_chunks; width *= 2) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int i = 0; i < num_chunks - width; i += 2 * width) {
+            std::inplace_merge(
+                    values.begin() + bounds[i],
+                    values.begin() + bounds[i + width],
+                    values.begin() + bounds[std::min(i + 2 * width,
+                                                     num_chunks)],
+                    comp);
+        }
+    }
+}
+
+/// Returns for every element of \param keys the index of the first element
+/// with an equal key. Keys are compared with operator<, equal keys are found
+/// by sorting instead of hashing.
+template <typename Key>
+std::vector<int> FindFirstOccurrences(const std::vector<Key>& keys) {
+    std::vector<int> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    ParallelSort(order, [&](int a, int b) {
+        return keys[a] < keys[b] || (!(keys[b] < keys[a]) && a < b);
+    });
+    std::vector<int> first(keys.size());
+    int current = -1;
+    for (size_t k = 0; k < order.size(); ++k) {
+        if (k == 0 || keys[order[k - 1]] < keys[order[k]]) {
+            current = order[k];
+        }
+        first[order[k]] = current;
+    }
+    return first;
+}
+
 /// Function to split a string, mimics boost::split
 /// http://stackoverflow.com/questions/236129/split-a-string-in-c
 void SplitString(std::vector<std::string>& tokens,
@@ -0,0 +1,311 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Utility/Profiler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <tuple>
+
+#include "Open3D/Utility/Console.h"
+
+namespace open3d {
+namespace utility {
+
+namespace {
+
+struct ProfileEvent {
+    const char *name_;
+    double begin_us_;
+    double end_us_;
+    int depth_;
+};
+
+std::string EscapeJSONString(const char *str) {
+    std::string escaped;
+    for (const char *c = str; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            escaped += '\\';
+            escaped += *c;
+        } else if ((unsigned char)*c < 0x20) {
+            escaped += fmt::format("\\u{:04x}", (int)*c);
+        } else {
+            escaped += *c;
+        }
+    }
+    return escaped;
+}
+
+ProfileNode &GetOrAddChild(ProfileNode &parent, const char *name) {
+    for (auto &child : parent.children_) {
+        if (child.name_ == name) {
+            return child;
+        }
+    }
+    parent.children_.emplace_back();
+    parent.children_.back().name_ = name;
+    return parent.children_.back();
+}
+
+void SortByTotalTime(ProfileNode &node) {
+    std::sort(node.children_.begin(), node.children_.end(),
+              [](const ProfileNode &a, const ProfileNode &b) {
+                  return a.total_ms_ > b.total_ms_;
+              });
+    for (auto &child : node.children_) {
+        SortByTotalTime(child);
+    }
+}
+
+void FormatReport(const ProfileNode &node, int depth, std::string &report) {
+    for (const auto &child : node.children_) {
+        report += fmt::format(
+                "{:<40s} {:>8d} {:>12.3f} {:>12.3f} {:>12.3f} {:>12.3f} "
+                "{:>12.3f}\n",
+                std::string(2 * depth, ' ') + child.name_, child.count_,
+                child.total_ms_, child.total_ms_ / child.count_, child.min_ms_,
+                child.max_ms_, child.self_ms_);
+        FormatReport(child, depth + 1, report);
+    }
+}
+
+}  // unnamed namespace
+
+/// Events closed by one thread. Only the owning thread appends, and an event
+/// becomes visible to readers when the size of its chunk is published, so
+/// the append never waits for a reader. Chunks are never moved while the
+/// buffer is alive.
+class Profiler::ThreadBuffer {
+public:
+    static const size_t kChunkSize = 1024;
+
+    struct Chunk {
+        ProfileEvent events_[kChunkSize];
+        std::atomic<size_t> size_{0};
+        std::atomic<Chunk *> next_{nullptr};
+    };
+
+    ThreadBuffer(int index, uint32_t generation)
+        : index_(index),
+          depth_(0),
+          generation_(generation),
+          head_(new Chunk),
+          tail_(head_) {}
+
+    ~ThreadBuffer() {
+        ReleaseChunks(head_->next_.load());
+        delete head_;
+    }
+
+    void Append(const ProfileEvent &event) {
+        size_t size = tail_->size_.load(std::memory_order_relaxed);
+        if (size == kChunkSize) {
+            Chunk *chunk = new Chunk;
+            tail_->next_.store(chunk, std::memory_order_release);
+            tail_ = chunk;
+            size = 0;
+        }
+        tail_->events_[size] = event;
+        tail_->size_.store(size + 1, std::memory_order_release);
+    }
+
+    /// Must only be called by the owning thread while holding the mutex of
+    /// the profiler.
+    void Reset(uint32_t generation) {
+        ReleaseChunks(head_->next_.load());
+        head_->next_.store(nullptr);
+        head_->size_.store(0);
+        tail_ = head_;
+        generation_ = generation;
+    }
+
+    void CopyEvents(std::vector<ProfileEvent> &events) const {
+        for (const Chunk *chunk = head_; chunk != nullptr;
+             chunk = chunk->next_.load(std::memory_order_acquire)) {
+            size_t size = chunk->size_.load(std::memory_order_acquire);
+            events.insert(events.end(), chunk->events_,
+                          chunk->events_ + size);
+        }
+    }
+
+private:
+    static void ReleaseChunks(Chunk *chunk) {
+        while (chunk != nullptr) {
+            Chunk *next = chunk->next_.load();
+            delete chunk;
+            chunk = next;
+        }
+    }
+
+public:
+    int index_;
+    int depth_;
+    /// Written only under the mutex of the profiler.
+    uint32_t generation_;
+
+private:
+    Chunk *head_;
+    Chunk *tail_;
+};
+
+Profiler::Profiler()
+    : enabled_(false),
+      generation_(0),
+      epoch_(std::chrono::steady_clock::now()) {}
+
+Profiler::~Profiler() {}
+
+Profiler::ThreadBuffer &Profiler::GetThreadBuffer() {
+    static thread_local ThreadBuffer *buffer = nullptr;
+    if (buffer == nullptr) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffers_.emplace_back(
+                new ThreadBuffer((int)buffers_.size(), generation_.load()));
+        buffer = buffers_.back().get();
+    }
+    return *buffer;
+}
+
+void Profiler::BeginZone() { GetThreadBuffer().depth_++; }
+
+void Profiler::EndZone(const char *name, double begin_us) {
+    double end_us = GetTimeInMicroseconds();
+    ThreadBuffer &buffer = GetThreadBuffer();
+    buffer.depth_--;
+    if (buffer.generation_ != generation_.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffer.Reset(generation_.load());
+    }
+    buffer.Append({name, begin_us, end_us, buffer.depth_});
+}
+
+void Profiler::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    generation_++;
+}
+
+ProfileNode Profiler::GetStatistics() const {
+    ProfileNode root;
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<ProfileEvent> events;
+    for (const auto &buffer : buffers_) {
+        if (buffer->generation_ != generation_.load()) {
+            continue;
+        }
+        events.clear();
+        buffer->CopyEvents(events);
+        // Parents begin before their children, and a child that begins at the
+        // same time as its parent is ordered by depth.
+        std::sort(events.begin(), events.end(),
+                  [](const ProfileEvent &a, const ProfileEvent &b) {
+                      return std::tie(a.begin_us_, a.depth_) <
+                             std::tie(b.begin_us_, b.depth_);
+                  });
+        // Enclosing zones of the current event with their end times. A zone
+        // that is still open has no event, so its children must not be
+        // attached to a preceding zone of the same depth.
+        std::vector<std::pair<ProfileNode *, const ProfileEvent *>> stack;
+        for (const auto &event : events) {
+            while (!stack.empty() &&
+                   (stack.back().second->depth_ >= event.depth_ ||
+                    stack.back().second->end_us_ < event.end_us_)) {
+                stack.pop_back();
+            }
+            ProfileNode &parent = stack.empty() ? root : *stack.back().first;
+            ProfileNode &node = GetOrAddChild(parent, event.name_);
+            double duration_ms = (event.end_us_ - event.begin_us_) / 1000.0;
+            if (node.count_ == 0) {
+                node.min_ms_ = node.max_ms_ = duration_ms;
+            } else {
+                node.min_ms_ = std::min(node.min_ms_, duration_ms);
+                node.max_ms_ = std::max(node.max_ms_, duration_ms);
+            }
+            node.count_++;
+            node.total_ms_ += duration_ms;
+            node.self_ms_ += duration_ms;
+            if (!stack.empty()) {
+                parent.self_ms_ -= duration_ms;
+            }
+            stack.emplace_back(&node, &event);
+        }
+    }
+    SortByTotalTime(root);
+    return root;
+}
+
+std::string Profiler::GetReport() const {
+    std::string report = fmt::format(
+            "{:<40s} {:>8s} {:>12s} {:>12s} {:>12s} {:>12s} {:>12s}\n",
+            "Zone", "Count", "Total [ms]", "Mean [ms]", "Min [ms]", "Max [ms]",
+            "Self [ms]");
+    FormatReport(GetStatistics(), 0, report);
+    return report;
+}
+
+void Profiler::PrintReport() const { LogInfo("Profile:\n{}", GetReport()); }
+
+bool Profiler::WriteChromeTrace(const std::string &filename) const {
+    FILE *file = fopen(filename.c_str(), "w");
+    if (file == NULL) {
+        LogWarning("Write Chrome trace failed: unable to open file: {}\n",
+                   filename);
+        return false;
+    }
+    fprintf(file, "{\"traceEvents\":[");
+    const char *separator = "\n";
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<ProfileEvent> events;
+    for (const auto &buffer : buffers_) {
+        if (buffer->generation_ != generation_.load()) {
+            continue;
+        }
+        fprintf(file,
+                "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,"
+                "\"tid\":%d,\"args\":{\"name\":\"Thread %d\"}}",
+                separator, buffer->index_, buffer->index_);
+        separator = ",\n";
+        events.clear();
+        buffer->CopyEvents(events);
+        for (const auto &event : events) {
+            fprintf(file,
+                    ",\n{\"name\":\"%s\",\"cat\":\"Open3D\",\"ph\":\"X\","
+                    "\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%d}",
+                    EscapeJSONString(event.name_).c_str(), event.begin_us_,
+                    event.end_us_ - event.begin_us_, buffer->index_);
+        }
+    }
+    fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    bool success = ferror(file) == 0;
+    fclose(file);
+    if (!success) {
+        LogWarning("Write Chrome trace failed: unable to write file: {}\n",
+                   filename);
+    }
+    return success;
+}
+
+}  // namespace utility
+}  // namespace open3d
@@ -0,0 +1,163 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace open3d {
+namespace utility {
+
+/// Aggregated statistics of all calls of one profiling zone at one position
+/// in the zone hierarchy. The root node returned by
+/// Profiler::GetStatistics() has an empty name and only holds children.
+class ProfileNode {
+public:
+    std::string name_;
+    int count_ = 0;
+    double total_ms_ = 0.0;
+    double min_ms_ = 0.0;
+    double max_ms_ = 0.0;
+    /// Time spent in the zone itself and not in any of its child zones.
+    double self_ms_ = 0.0;
+    std::vector<ProfileNode> children_;
+};
+
+/// Low overhead profiler for named scoped zones.
+///
+/// Every thread appends the zones it closes to its own event buffer without
+/// taking a lock. The buffers can be aggregated into hierarchical statistics
+/// or exported in the Chrome trace event format (chrome://tracing, Perfetto)
+/// at any time. Recording is off until SetEnabled(true) is called, and the
+/// OPEN3D_PROFILE_ZONE macro compiles to nothing unless Open3D is configured
+/// with ENABLE_PROFILING.
+class Profiler {
+public:
+    Profiler(Profiler const &) = delete;
+    void operator=(Profiler const &) = delete;
+
+    static Profiler &i() {
+        static Profiler instance;
+        return instance;
+    }
+
+public:
+    void SetEnabled(bool enabled) {
+        enabled_.store(enabled, std::memory_order_relaxed);
+    }
+    bool IsEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /// Discards all recorded zones. Buffers of other threads are released the
+    /// next time those threads close a zone.
+    void Clear();
+
+    /// Merges the recorded zones of all threads into a tree of statistics.
+    /// Zones are nested by the thread that ran them, so zones opened by
+    /// OpenMP worker threads appear at the top level.
+    ProfileNode GetStatistics() const;
+
+    /// Statistics formatted as an indented table, one line per node.
+    std::string GetReport() const;
+    void PrintReport() const;
+
+    /// Writes every recorded zone as a complete ("X") event of the Chrome
+    /// trace event format.
+    bool WriteChromeTrace(const std::string &filename) const;
+
+public:
+    /// Microseconds since the profiler was created.
+    double GetTimeInMicroseconds() const {
+        return std::chrono::duration<double, std::micro>(
+                       std::chrono::steady_clock::now() - epoch_)
+                .count();
+    }
+
+    /// Internal functions used by ProfileZone. \param name must outlive the
+    /// profiler, e.g. a string literal.
+    void BeginZone();
+    void EndZone(const char *name, double begin_us);
+
+private:
+    Profiler();
+    ~Profiler();
+
+    class ThreadBuffer;
+    ThreadBuffer &GetThreadBuffer();
+
+    std::atomic<bool> enabled_;
+    /// Incremented by Clear() to invalidate the contents of all buffers.
+    std::atomic<uint32_t> generation_;
+    std::chrono::steady_clock::time_point epoch_;
+    /// Guards buffers_ and the reset of a buffer, never the append of a zone.
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+};
+
+/// Records the lifetime of the object as a zone of the profiler, if the
+/// profiler is enabled when the object is constructed.
+class ProfileZone {
+public:
+    explicit ProfileZone(const char *name) : name_(name), begin_us_(-1.0) {
+        Profiler &profiler = Profiler::i();
+        if (profiler.IsEnabled()) {
+            profiler.BeginZone();
+            begin_us_ = profiler.GetTimeInMicroseconds();
+        }
+    }
+    ~ProfileZone() {
+        if (begin_us_ >= 0.0) {
+            Profiler::i().EndZone(name_, begin_us_);
+        }
+    }
+    ProfileZone(ProfileZone const &) = delete;
+    void operator=(ProfileZone const &) = delete;
+
+private:
+    const char *name_;
+    double begin_us_;
+};
+
+}  // namespace utility
+}  // namespace open3d
+
+#define OPEN3D_PROFILE_CONCAT_IMPL(a, b) a##b
+#define OPEN3D_PROFILE_CONCAT(a, b) OPEN3D_PROFILE_CONCAT_IMPL(a, b)
+
+/// Profiles the rest of the enclosing scope as a zone named \p name, which
+/// must be a string literal.
+#ifdef OPEN3D_ENABLE_PROFILING
+#define OPEN3D_PROFILE_ZONE(name)                         \
+    ::open3d::utility::ProfileZone OPEN3D_PROFILE_CONCAT( \
+            open3d_profile_zone_, __LINE__)(name)
+#else
+#define OPEN3D_PROFILE_ZONE(name)
+#endif
@@ -0,0 +1,336 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Utility/TextParser.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace open3d {
+namespace utility {
+
+namespace {
+
+inline bool IsSpace(char c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+
+inline bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+/// A decimal number as its significant digits and a power of ten.
+struct DecimalNumber {
+    bool negative;
+    std::uint64_t mantissa;
+    int exponent;
+    /// First character after the number.
+    const char *end;
+};
+
+/// Scans [sign] digits [. digits] [e [sign] digits] at \p ptr. Returns false
+/// if there is no such number or it has to be parsed by the C library, i.e.
+/// for more than 19 significant digits, hexadecimal numbers, infinity and
+/// NaN.
+bool ScanDecimal(const char *ptr, const char *end, DecimalNumber &number) {
+    number.negative = false;
+    if (ptr < end && (*ptr == '+' || *ptr == '-')) {
+        number.negative = *ptr == '-';
+        ptr++;
+    }
+    if (ptr + 1 < end && ptr[0] == '0' && (ptr[1] == 'x' || ptr[1] == 'X')) {
+        return false;
+    }
+    std::uint64_t mantissa = 0;
+    int num_digits = 0;
+    int exponent = 0;
+    bool has_digits = false;
+    for (; ptr < end && IsDigit(*ptr); ptr++) {
+        has_digits = true;
+        if (mantissa == 0 && *ptr == '0') {
+            continue;
+        }
+        if (num_digits == 19) {
+            return false;
+        }
+        mantissa = mantissa * 10 + std::uint64_t(*ptr - '0');
+        num_digits++;
+    }
+    if (ptr < end && *ptr == '.') {
+        for (ptr++; ptr < end && IsDigit(*ptr); ptr++) {
+            has_digits = true;
+            exponent--;
+            if (mantissa == 0 && *ptr == '0') {
+                continue;
+            }
+            if (num_digits == 19) {
+                return false;
+            }
+            mantissa = mantissa * 10 + std::uint64_t(*ptr - '0');
+            num_digits++;
+        }
+    }
+    if (!has_digits) {
+        return false;
+    }
+    // An exponent without digits is not part of the number.
+    if (ptr < end && (*ptr == 'e' || *ptr == 'E')) {
+        const char *exponent_ptr = ptr + 1;
+        bool exponent_negative = false;
+        if (exponent_ptr < end &&
+            (*exponent_ptr == '+' || *exponent_ptr == '-')) {
+            exponent_negative = *exponent_ptr == '-';
+            exponent_ptr++;
+        }
+        if (exponent_ptr < end && IsDigit(*exponent_ptr)) {
+            int exponent_value = 0;
+            for (; exponent_ptr < end && IsDigit(*exponent_ptr);
+                 exponent_ptr++) {
+                if (exponent_value < 100000) {
+                    exponent_value =
+                            exponent_value * 10 + (*exponent_ptr - '0');
+                }
+            }
+            exponent += exponent_negative ? -exponent_value : exponent_value;
+            ptr = exponent_ptr;
+        }
+    }
+    number.mantissa = mantissa;
+    number.exponent = exponent;
+    number.end = ptr;
+    return true;
+}
+
+/// Converts \p number exactly if its mantissa and the power of ten are both
+/// representable in T, in which case a single rounding gives the correctly
+/// rounded result, the same as the C library.
+template <typename T>
+bool ConvertDecimal(const DecimalNumber &number, T &value);
+
+template <>
+bool ConvertDecimal(const DecimalNumber &number, double &value) {
+    static const double kPowers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                     1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                     1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                     1e18, 1e19, 1e20, 1e21, 1e22};
+    double result;
+    if (number.mantissa == 0) {
+        result = 0.0;
+    } else if (number.mantissa <= (std::uint64_t(1) << 53) &&
+               number.exponent >= -22 && number.exponent <= 22) {
+        result = double(number.mantissa);
+        if (number.exponent < 0) {
+            result /= kPowers[-number.exponent];
+        } else {
+            result *= kPowers[number.exponent];
+        }
+    } else {
+        return false;
+    }
+    value = number.negative ? -result : result;
+    return true;
+}
+
+template <>
+bool ConvertDecimal(const DecimalNumber &number, float &value) {
+    static const float kPowers[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f,
+                                    1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+    float result;
+    double exact;
+    if (number.mantissa == 0) {
+        result = 0.0f;
+    } else if (number.mantissa <= (std::uint64_t(1) << 24) &&
+               number.exponent >= -10 && number.exponent <= 10) {
+        result = float(number.mantissa);
+        if (number.exponent < 0) {
+            result /= kPowers[-number.exponent];
+        } else {
+            result *= kPowers[number.exponent];
+        }
+    } else if (ConvertDecimal(number, exact)) {
+        // Rounding the correctly rounded double to float gives the correctly
+        // rounded float unless the double is a midpoint between two floats.
+        // Every normal float midpoint is a double with 25 significant bits.
+        const double magnitude = std::fabs(exact);
+        std::uint64_t bits;
+        std::memcpy(&bits, &exact, sizeof(bits));
+        const std::uint64_t midpoint_mask = (std::uint64_t(1) << 29) - 1;
+        if (magnitude < FLT_MIN || magnitude > FLT_MAX ||
+            (bits & midpoint_mask) == (std::uint64_t(1) << 28)) {
+            return false;
+        }
+        value = float(exact);
+        return true;
+    } else {
+        return false;
+    }
+    value = number.negative ? -result : result;
+    return true;
+}
+
+/// Parses the number at \p ptr with \p convert, one of the C library
+/// functions, on a null terminated copy of the characters up to the next
+/// whitespace.
+template <typename T, typename Convert>
+bool ParseWithCLibrary(const char *&ptr,
+                       const char *end,
+                       T &value,
+                       Convert convert) {
+    const char *token_end = ptr;
+    while (token_end < end && !IsSpace(*token_end)) {
+        token_end++;
+    }
+    // Numbers longer than the stack buffer are rare enough to be copied to
+    // the heap.
+    char stack_token[64];
+    std::string heap_token;
+    const char *token = stack_token;
+    const size_t length = size_t(token_end - ptr);
+    if (length < sizeof(stack_token)) {
+        std::memcpy(stack_token, ptr, length);
+        stack_token[length] = '\0';
+    } else {
+        heap_token.assign(ptr, token_end);
+        token = heap_token.c_str();
+    }
+    char *parse_end;
+    value = convert(token, &parse_end);
+    if (parse_end == token) {
+        return false;
+    }
+    ptr += parse_end - token;
+    return true;
+}
+
+template <typename T, typename Convert>
+bool ParseFloatingPoint(const char *&ptr,
+                        const char *end,
+                        T &value,
+                        Convert convert) {
+    while (ptr < end && IsSpace(*ptr)) {
+        ptr++;
+    }
+    DecimalNumber number;
+    if (ScanDecimal(ptr, end, number) && ConvertDecimal(number, value)) {
+        ptr = number.end;
+        return true;
+    }
+    return ParseWithCLibrary(ptr, end, value, convert);
+}
+
+}  // unnamed namespace
+
+bool ParseNumber(const char *&ptr, const char *end, double &value) {
+    return ParseFloatingPoint(ptr, end, value,
+                              [](const char *str, char **str_end) {
+                                  return std::strtod(str, str_end);
+                              });
+}
+
+bool ParseNumber(const char *&ptr, const char *end, float &value) {
+    return ParseFloatingPoint(ptr, end, value,
+                              [](const char *str, char **str_end) {
+                                  return std::strtof(str, str_end);
+                              });
+}
+
+bool ParseNumber(const char *&ptr, const char *end, int &value) {
+    while (ptr < end && IsSpace(*ptr)) {
+        ptr++;
+    }
+    const char *digits = ptr;
+    bool negative = false;
+    if (digits < end && (*digits == '+' || *digits == '-')) {
+        negative = *digits == '-';
+        digits++;
+    }
+    std::int64_t result = 0;
+    const char *digits_end = digits;
+    while (digits_end < end && IsDigit(*digits_end) &&
+           digits_end - digits < 10) {
+        result = result * 10 + (*digits_end - '0');
+        digits_end++;
+    }
+    if (digits_end == digits ||
+        (digits_end < end && IsDigit(*digits_end))) {
+        // No digits or too many of them for the fast path.
+        return ParseWithCLibrary(ptr, end, value,
+                                 [](const char *str, char **str_end) {
+                                     return int(std::strtol(str, str_end, 10));
+                                 });
+    }
+    value = int(negative ? -result : result);
+    ptr = digits_end;
+    return true;
+}
+
+bool ReadTextFile(const std::string &filename,
+                  filesystem::MappedFile &mapped_file,
+                  std::string &buffer,
+                  const char *&begin,
+                  const char *&end) {
+    if (mapped_file.Open(filename)) {
+        begin = mapped_file.GetData();
+        end = begin + mapped_file.GetSize();
+        return true;
+    }
+    FILE *file = fopen(filename.c_str(), "rb");
+    if (file == NULL) {
+        return false;
+    }
+    std::vector<char> chunk(1 << 20);
+    size_t num_read;
+    buffer.clear();
+    while ((num_read = fread(chunk.data(), 1, chunk.size(), file)) > 0) {
+        buffer.append(chunk.data(), num_read);
+    }
+    fclose(file);
+    begin = buffer.data();
+    end = begin + buffer.size();
+    return true;
+}
+
+std::vector<const char *> SplitIntoLineChunks(const char *begin,
+                                              const char *end) {
+    const size_t chunk_size = 1 << 20;
+    std::vector<const char *> chunks(1, begin);
+    while (chunks.back() < end) {
+        const char *chunk_begin = chunks.back();
+        if (size_t(end - chunk_begin) <= chunk_size) {
+            chunks.push_back(end);
+            break;
+        }
+        const char *newline = static_cast<const char *>(
+                std::memchr(chunk_begin + chunk_size, '\n',
+                            size_t(end - chunk_begin) - chunk_size));
+        chunks.push_back(newline != nullptr ? newline + 1 : end);
+    }
+    return chunks;
+}
+
+}  // namespace utility
+}  // namespace open3d
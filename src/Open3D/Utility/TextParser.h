@@ -0,0 +1,117 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/FileSystem.h"
+
+namespace open3d {
+namespace utility {
+
+/// Parses a number at \p ptr after skipping whitespace, with the same result
+/// as strtod, strtof and strtol with base 10. \p ptr is advanced past the
+/// number and no character at or after \p end is read. Returns false if no
+/// number starts at \p ptr.
+///
+/// Decimal numbers whose digits and exponent are small enough to be
+/// converted exactly are parsed directly, all others with the C library.
+bool ParseNumber(const char *&ptr, const char *end, double &value);
+bool ParseNumber(const char *&ptr, const char *end, float &value);
+bool ParseNumber(const char *&ptr, const char *end, int &value);
+
+/// Returns the characters of \p filename in [\p begin, \p end). The file is
+/// memory mapped into \p mapped_file if possible and read into \p buffer
+/// otherwise, e.g. if it is empty. Returns false if the file cannot be read.
+bool ReadTextFile(const std::string &filename,
+                  filesystem::MappedFile &mapped_file,
+                  std::string &buffer,
+                  const char *&begin,
+                  const char *&end);
+
+/// Splits [\p begin, \p end) into chunks of whole lines. Chunk i is
+/// [chunks[i], chunks[i + 1]).
+std::vector<const char *> SplitIntoLineChunks(const char *begin,
+                                              const char *end);
+
+/// Parses the lines of [\p begin, \p end) in parallel. \p parse_line is
+/// called as parse_line(line_begin, line_end, record) for every line, without
+/// its newline character, and returns whether \p record is kept. The kept
+/// records are returned in the order of their lines. If \p print_progress
+/// is set, a progress bar labelled \p progress_info advances once per parsed
+/// chunk.
+template <typename Record, typename ParseLine>
+std::vector<Record> ParseLines(const char *begin,
+                               const char *end,
+                               ParseLine parse_line,
+                               const std::string &progress_info = "",
+                               bool print_progress = false) {
+    const std::vector<const char *> chunks = SplitIntoLineChunks(begin, end);
+    const int num_chunks = int(chunks.size()) - 1;
+    std::vector<std::vector<Record>> chunk_records(num_chunks);
+    ConsoleProgressBar progress_bar(size_t(num_chunks), progress_info,
+                                    print_progress);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int i = 0; i < num_chunks; i++) {
+        Record record;
+        const char *line = chunks[i];
+        while (line < chunks[i + 1]) {
+            const char *line_end = line;
+            while (line_end < chunks[i + 1] && *line_end != '\n') {
+                line_end++;
+            }
+            if (parse_line(line, line_end, record)) {
+                chunk_records[i].push_back(record);
+            }
+            line = line_end + 1;
+        }
+        if (print_progress) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            { ++progress_bar; }
+        }
+    }
+    size_t num_records = 0;
+    for (const auto &records : chunk_records) {
+        num_records += records.size();
+    }
+    std::vector<Record> records;
+    records.reserve(num_records);
+    for (auto &chunk : chunk_records) {
+        records.insert(records.end(), chunk.begin(), chunk.end());
+        std::vector<Record>().swap(chunk);
+    }
+    return records;
+}
+
+}  // namespace utility
+}  // namespace open3d
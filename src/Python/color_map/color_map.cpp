@@ -142,6 +142,14 @@ void pybind_color_map_classes(py::module &m) {
                     "visible vertices to fill the invisible vertex. Set to "
                     "``0`` to disable this feature and all invisible vertices "
                     "will be black.")
+            .def_readwrite(
+                    "maximum_cached_keyframes",
+                    &color_map::ColorMapOptimizationOption::
+                            maximum_cached_keyframes_,
+                    "int: (Default ``32``) Number of keyframes whose gradient "
+                    "images are kept in memory when the keyframes are "
+                    "streamed from files or from a callback. Other keyframes "
+                    "are reloaded when they are needed again.")
             .def("__repr__", [](const color_map::ColorMapOptimizationOption
                                         &to) {
                 // clang-format off
@@ -156,7 +164,8 @@ void pybind_color_map_classes(py::module &m) {
                     "- depth_threshold_for_discontinuity_check: {}\n"
                     "- half_dilation_kernel_size_for_discontinuity_map: {}\n"
                     "- image_boundary_margin: {}\n"
-                    "- invisible_vertex_color_knn: {}\n",
+                    "- invisible_vertex_color_knn: {}\n"
+                    "- maximum_cached_keyframes: {}\n",
                     to.non_rigid_camera_coordinate_,
                     to.number_of_vertical_anchors_,
                     to.non_rigid_anchor_point_weight_,
@@ -166,23 +175,67 @@ void pybind_color_map_classes(py::module &m) {
                     to.depth_threshold_for_discontinuity_check_,
                     to.half_dilation_kernel_size_for_discontinuity_map_,
                     to.image_boundary_margin_,
-                    to.invisible_vertex_color_knn_
+                    to.invisible_vertex_color_knn_,
+                    to.maximum_cached_keyframes_
                 );
                 // clang-format on
             });
 }
 
 void pybind_color_map_methods(py::module &m) {
-    m.def("color_map_optimization", &color_map::ColorMapOptimization,
+    m.def("color_map_optimization",
+          (void (*)(geometry::TriangleMesh &,
+                    const std::vector<std::shared_ptr<geometry::RGBDImage>> &,
+                    camera::PinholeCameraTrajectory &,
+                    const color_map::ColorMapOptimizationOption &)) &
+                  color_map::ColorMapOptimization,
           "Function for color mapping of reconstructed scenes via optimization",
           "mesh"_a, "imgs_rgbd"_a, "camera"_a,
           "option"_a = color_map::ColorMapOptimizationOption());
+    m.def("color_map_optimization",
+          (void (*)(geometry::TriangleMesh &, const std::vector<std::string> &,
+                    const std::vector<std::string> &,
+                    camera::PinholeCameraTrajectory &,
+                    const color_map::ColorMapOptimizationOption &, double,
+                    double)) &
+                  color_map::ColorMapOptimization,
+          "Function for color mapping of reconstructed scenes via "
+          "optimization. The RGBD images are read from files when they are "
+          "needed instead of being held in memory.",
+          "mesh"_a, "color_filenames"_a, "depth_filenames"_a, "camera"_a,
+          "option"_a = color_map::ColorMapOptimizationOption(),
+          "depth_scale"_a = 1000.0, "depth_trunc"_a = 3.0);
+    m.def("color_map_optimization",
+          (void (*)(geometry::TriangleMesh &,
+                    const color_map::RGBDImageProvider &,
+                    camera::PinholeCameraTrajectory &,
+                    const color_map::ColorMapOptimizationOption &)) &
+                  color_map::ColorMapOptimization,
+          "Function for color mapping of reconstructed scenes via "
+          "optimization. The RGBD image of each camera is requested from "
+          "``image_provider`` when it is needed instead of being held in "
+          "memory.",
+          "mesh"_a, "image_provider"_a, "camera"_a,
+          "option"_a = color_map::ColorMapOptimizationOption());
     docstring::FunctionDocInject(
             m, "color_map_optimization",
             {{"mesh", "The input geometry mesh."},
              {"imgs_rgbd", "A list of RGBD images seen by cameras."},
+             {"color_filenames",
+              "Paths of the color images, one per camera."},
+             {"depth_filenames",
+              "Paths of the depth images, one per camera."},
+             {"image_provider",
+              "Function that takes a camera index and returns the RGBD image "
+              "seen by that camera."},
              {"camera", "Cameras' parameters."},
-             {"option", "The ColorMap optimization option."}});
+             {"option", "The ColorMap optimization option."},
+             {"depth_scale",
+              "The ratio to scale depth values. The depth values will first "
+              "be scaled and then truncated."},
+             {"depth_trunc",
+              "Depth values larger than ``depth_trunc`` gets truncated to 0. "
+              "The depth values will first be scaled and then truncated."}});
 }
 
 void pybind_color_map(py::module &m) {
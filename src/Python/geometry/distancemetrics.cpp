@@ -0,0 +1,116 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include "Open3D/Geometry/DistanceMetrics.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/TriangleMesh.h"
+#include "Python/docstring.h"
+#include "Python/geometry/geometry.h"
+
+using namespace open3d;
+
+void pybind_distancemetrics(py::module &m) {
+    py::class_<geometry::DistanceMetricsResult> result(
+            m, "DistanceMetricsResult",
+            "Symmetric distances between a point cloud and a reference "
+            "geometry.");
+    py::detail::bind_default_constructor<geometry::DistanceMetricsResult>(
+            result);
+    py::detail::bind_copy_functions<geometry::DistanceMetricsResult>(result);
+    result.def_readwrite("chamfer_distance",
+                         &geometry::DistanceMetricsResult::chamfer_distance_,
+                         "float: Mean distance from the query to the "
+                         "reference plus mean distance from the reference to "
+                         "the query.")
+            .def_readwrite(
+                    "hausdorff_distance",
+                    &geometry::DistanceMetricsResult::hausdorff_distance_,
+                    "float: Largest distance in either direction.")
+            .def_readwrite("thresholds",
+                           &geometry::DistanceMetricsResult::thresholds_,
+                           "List[float]: Distance thresholds.")
+            .def_readwrite("precision",
+                           &geometry::DistanceMetricsResult::precision_,
+                           "List[float]: Fraction of query points closer to "
+                           "the reference than each threshold.")
+            .def_readwrite("recall", &geometry::DistanceMetricsResult::recall_,
+                           "List[float]: Fraction of reference points closer "
+                           "to the query than each threshold.")
+            .def_readwrite("fscore", &geometry::DistanceMetricsResult::fscore_,
+                           "List[float]: Harmonic mean of precision and "
+                           "recall.")
+            .def("__repr__", [](const geometry::DistanceMetricsResult &r) {
+                return std::string(
+                               "geometry::DistanceMetricsResult with "
+                               "chamfer_distance = ") +
+                       std::to_string(r.chamfer_distance_) +
+                       std::string(", hausdorff_distance = ") +
+                       std::to_string(r.hausdorff_distance_) +
+                       std::string(", and ") +
+                       std::to_string(r.thresholds_.size()) +
+                       std::string(" thresholds.");
+            });
+
+    py::class_<geometry::DistanceMetrics,
+               std::shared_ptr<geometry::DistanceMetrics>>
+            metrics(m, "DistanceMetrics",
+                    "Compares point clouds with a fixed reference point cloud "
+                    "or triangle mesh whose search structure is built once.");
+    metrics.def(py::init<>())
+            .def("set_reference",
+                 (bool (geometry::DistanceMetrics::*)(
+                         const geometry::PointCloud &)) &
+                         geometry::DistanceMetrics::SetReference,
+                 "Sets a point cloud as reference.", "reference"_a)
+            .def("set_reference",
+                 (bool (geometry::DistanceMetrics::*)(
+                         const geometry::TriangleMesh &, size_t)) &
+                         geometry::DistanceMetrics::SetReference,
+                 "Sets a triangle mesh as reference.", "reference"_a,
+                 "number_of_points"_a)
+            .def("compute_distance",
+                 &geometry::DistanceMetrics::ComputeDistance,
+                 "Distance from each point to the reference.", "points"_a)
+            .def("compute", &geometry::DistanceMetrics::Compute,
+                 "Compares the query with the reference in both directions.",
+                 "query"_a, "thresholds"_a)
+            .def("__repr__", [](const geometry::DistanceMetrics &) {
+                return std::string("geometry::DistanceMetrics");
+            });
+    docstring::ClassMethodDocInject(
+            m, "DistanceMetrics", "set_reference",
+            {{"reference", "The reference point cloud or triangle mesh."},
+             {"number_of_points",
+              "Number of points sampled on the mesh to measure the distances "
+              "from it."}});
+    docstring::ClassMethodDocInject(
+            m, "DistanceMetrics", "compute_distance",
+            {{"points", "The query points."}});
+    docstring::ClassMethodDocInject(
+            m, "DistanceMetrics", "compute",
+            {{"query", "The query point cloud."},
+             {"thresholds",
+              "Distance thresholds of precision, recall and F-score."}});
+}
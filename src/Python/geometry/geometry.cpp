@@ -183,4 +183,5 @@ void pybind_geometry(py::module &m) {
     pybind_octree_methods(m_submodule);
     pybind_octree(m_submodule);
     pybind_boundingvolume(m_submodule);
+    pybind_distancemetrics(m_submodule);
 }
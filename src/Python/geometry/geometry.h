@@ -46,3 +46,4 @@ void pybind_image_methods(py::module &m);
 void pybind_octree_methods(py::module &m);
 void pybind_octree(py::module &m);
 void pybind_boundingvolume(py::module &m);
+void pybind_distancemetrics(py::module &m);
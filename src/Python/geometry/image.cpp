@@ -24,6 +24,7 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include "Open3D/Geometry/DepthPreprocessor.h"
 #include "Open3D/Geometry/Image.h"
 #include "Open3D/Geometry/RGBDImage.h"
 #include "Python/docstring.h"
@@ -177,6 +178,12 @@ void pybind_image(py::module &m) {
                      }
                  },
                  "Function to filter Image", "filter_type"_a)
+            .def("filter_bilateral", &geometry::Image::FilterBilateral,
+                 "Function to filter a float Image with an edge preserving "
+                 "bilateral filter. Pixels that are not positive are skipped "
+                 "and stay 0.",
+                 "half_kernel_size"_a = 2, "sigma_space"_a = 1.5,
+                 "sigma_value"_a = 0.03)
             .def("create_pyramid",
                  [](const geometry::Image &input, size_t num_of_levels,
                     bool with_gaussian_filter) {
@@ -206,6 +213,14 @@ void pybind_image(py::module &m) {
 
     docstring::ClassMethodDocInject(m, "Image", "filter",
                                     map_shared_argument_docstrings);
+    docstring::ClassMethodDocInject(
+            m, "Image", "filter_bilateral",
+            {{"half_kernel_size", "Radius of the filter in pixels."},
+             {"sigma_space",
+              "Standard deviation of the weights over the pixel distance."},
+             {"sigma_value",
+              "Standard deviation of the weights over the value "
+              "difference."}});
     docstring::ClassMethodDocInject(m, "Image", "create_pyramid",
                                     map_shared_argument_docstrings);
     docstring::ClassMethodDocInject(m, "Image", "filter_pyramid",
@@ -283,6 +298,75 @@ void pybind_image(py::module &m) {
                                     map_shared_argument_docstrings);
     docstring::ClassMethodDocInject(m, "RGBDImage", "create_from_nyu_format",
                                     map_shared_argument_docstrings);
+
+    // open3d.geometry.DepthPreprocessor
+    py::class_<geometry::DepthPreprocessor,
+               std::shared_ptr<geometry::DepthPreprocessor>>
+            preprocessor(m, "DepthPreprocessor",
+                         "Cleans up float depth images in meters once per "
+                         "frame: removes depth out of range and next to "
+                         "discontinuities and smooths the rest with a "
+                         "bilateral filter. Removed depth is 0.");
+    preprocessor
+            .def(py::init<double, double, double, int, int, double,
+                          double>(),
+                 "depth_min"_a = 0.0, "depth_max"_a = 4.0,
+                 "discontinuity_threshold"_a = 0.05,
+                 "discontinuity_dilation"_a = 1,
+                 "bilateral_half_kernel_size"_a = 2,
+                 "bilateral_sigma_space"_a = 1.5,
+                 "bilateral_sigma_depth"_a = 0.03)
+            .def("create_valid_mask",
+                 &geometry::DepthPreprocessor::CreateValidMask,
+                 "Returns an 8 bit image that is 255 where the depth is "
+                 "valid.",
+                 "depth"_a)
+            .def("process",
+                 (std::shared_ptr<geometry::Image>(
+                         geometry::DepthPreprocessor::*)(
+                         const geometry::Image &) const) &
+                         geometry::DepthPreprocessor::Process,
+                 "Returns the processed float depth image.", "depth"_a)
+            .def("process",
+                 (std::shared_ptr<geometry::RGBDImage>(
+                         geometry::DepthPreprocessor::*)(
+                         const geometry::RGBDImage &) const) &
+                         geometry::DepthPreprocessor::Process,
+                 "Returns the RGBD image with its depth processed.",
+                 "image"_a)
+            .def_readwrite("depth_min",
+                           &geometry::DepthPreprocessor::depth_min_,
+                           "Smaller depth in meters is removed.")
+            .def_readwrite("depth_max",
+                           &geometry::DepthPreprocessor::depth_max_,
+                           "Larger depth in meters is removed.")
+            .def_readwrite(
+                    "discontinuity_threshold",
+                    &geometry::DepthPreprocessor::discontinuity_threshold_,
+                    "A pixel is at a discontinuity if one of its four "
+                    "neighbours differs by more than this fraction of its "
+                    "depth.")
+            .def_readwrite(
+                    "discontinuity_dilation",
+                    &geometry::DepthPreprocessor::discontinuity_dilation_,
+                    "Radius in pixels of the region removed around "
+                    "discontinuities.")
+            .def_readwrite(
+                    "bilateral_half_kernel_size",
+                    &geometry::DepthPreprocessor::bilateral_half_kernel_size_,
+                    "Radius in pixels of the bilateral filter, 0 disables "
+                    "the filter.")
+            .def_readwrite("bilateral_sigma_space",
+                           &geometry::DepthPreprocessor::bilateral_sigma_space_,
+                           "Standard deviation of the filter weights over the "
+                           "pixel distance.")
+            .def_readwrite("bilateral_sigma_depth",
+                           &geometry::DepthPreprocessor::bilateral_sigma_depth_,
+                           "Standard deviation of the filter weights over the "
+                           "depth difference in meters.")
+            .def("__repr__", [](const geometry::DepthPreprocessor &) {
+                return std::string("geometry::DepthPreprocessor");
+            });
 }
 
 void pybind_image_methods(py::module &m) {}
@@ -25,6 +25,8 @@
 // ----------------------------------------------------------------------------
 
 #include "Open3D/Geometry/KDTreeFlann.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/PointCloudNeighborhoods.h"
 #include "Python/docstring.h"
 #include "Python/geometry/geometry.h"
 #include "Python/geometry/geometry_trampoline.h"
@@ -270,4 +272,45 @@ void pybind_kdtreeflann(py::module &m) {
                                     map_kd_tree_flann_method_docs);
     docstring::ClassMethodDocInject(m, "KDTreeFlann", "set_matrix_data",
                                     map_kd_tree_flann_method_docs);
+
+    // open3d.geometry.PointCloudNeighborhoods
+    py::class_<geometry::PointCloudNeighborhoods,
+               std::shared_ptr<geometry::PointCloudNeighborhoods>>
+            neighborhoods(m, "PointCloudNeighborhoods",
+                          "Neighbors of all points of a point cloud, computed "
+                          "once and shared by normal and feature estimation.");
+    neighborhoods.def(py::init<>())
+            .def(py::init<const geometry::PointCloud &,
+                          const geometry::KDTreeSearchParam &>(),
+                 "cloud"_a, "search_param"_a)
+            .def("compute", &geometry::PointCloudNeighborhoods::Compute,
+                 "Searches the neighbors of every point of the point cloud.",
+                 "cloud"_a, "search_param"_a)
+            .def("size", &geometry::PointCloudNeighborhoods::Size,
+                 "Number of points the neighborhoods were computed for.")
+            .def("__repr__",
+                 [](const geometry::PointCloudNeighborhoods &neighborhoods) {
+                     return std::string(
+                                    "geometry::PointCloudNeighborhoods of ") +
+                            std::to_string(neighborhoods.Size()) +
+                            " points with " +
+                            std::to_string(neighborhoods.indices_.size()) +
+                            " neighbors in total";
+                 })
+            .def_readonly("offsets",
+                          &geometry::PointCloudNeighborhoods::offsets_,
+                          "The neighbors of point ``i`` are "
+                          "``indices[offsets[i]:offsets[i + 1]]``.")
+            .def_readonly("indices",
+                          &geometry::PointCloudNeighborhoods::indices_,
+                          "Indices of the neighbors of all points.")
+            .def_readonly("distance2",
+                          &geometry::PointCloudNeighborhoods::distance2_,
+                          "Squared distances of the neighbors of all points.");
+    docstring::ClassMethodDocInject(
+            m, "PointCloudNeighborhoods", "compute",
+            {{"cloud", "The input point cloud."},
+             {"search_param",
+              "The KDTree search parameters for neighborhood search."}});
+    docstring::ClassMethodDocInject(m, "PointCloudNeighborhoods", "size");
 }
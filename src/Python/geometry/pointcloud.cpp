@@ -26,7 +26,9 @@
 
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Camera/PinholeCameraIntrinsic.h"
+#include "Open3D/Geometry/DepthBackProjector.h"
 #include "Open3D/Geometry/Image.h"
+#include "Open3D/Geometry/PointCloudNeighborhoods.h"
 #include "Open3D/Geometry/RGBDImage.h"
 #include "Python/docstring.h"
 #include "Python/geometry/geometry.h"
@@ -69,6 +71,11 @@ void pybind_pointcloud(py::module &m) {
                  "``True`` to "
                  "invert the selection of indices.",
                  "indices"_a, "invert"_a = false)
+            .def("select_down_sample_by_mask",
+                 &geometry::PointCloud::SelectDownSampleByMask,
+                 "Function to select points from input pointcloud into output "
+                 "pointcloud with a boolean mask.",
+                 "mask"_a, "invert"_a = false)
             .def("voxel_down_sample", &geometry::PointCloud::VoxelDownSample,
                  "Function to downsample input pointcloud into output "
                  "pointcloud with "
@@ -106,12 +113,46 @@ void pybind_pointcloud(py::module &m) {
                  "Function to remove points that are further away from their "
                  "neighbors in average",
                  "nb_neighbors"_a, "std_ratio"_a)
-            .def("estimate_normals", &geometry::PointCloud::EstimateNormals,
+            .def("compute_radius_inlier_mask",
+                 &geometry::PointCloud::ComputeRadiusInlierMask,
+                 "Function to compute a mask of the points kept by "
+                 "remove_radius_outlier",
+                 "nb_points"_a, "radius"_a)
+            .def("compute_statistical_inlier_mask",
+                 &geometry::PointCloud::ComputeStatisticalInlierMask,
+                 "Function to compute a mask of the points kept by "
+                 "remove_statistical_outlier",
+                 "nb_neighbors"_a, "std_ratio"_a)
+            .def("estimate_normals",
+                 (bool (geometry::PointCloud::*)(
+                         const geometry::KDTreeSearchParam &, bool)) &
+                         geometry::PointCloud::EstimateNormals,
                  "Function to compute the normals of a point cloud. Normals "
                  "are oriented with respect to the input point cloud if "
                  "normals exist",
                  "search_param"_a = geometry::KDTreeSearchParamKNN(),
                  "fast_normal_computation"_a = true)
+            .def("estimate_normals",
+                 (bool (geometry::PointCloud::*)(
+                         const geometry::PointCloudNeighborhoods &, bool)) &
+                         geometry::PointCloud::EstimateNormals,
+                 "Function to compute the normals of a point cloud from "
+                 "precomputed neighborhoods. Normals are oriented with "
+                 "respect to the input point cloud if normals exist",
+                 "neighborhoods"_a, "fast_normal_computation"_a = true)
+            .def("estimate_normals_and_curvatures",
+                 [](geometry::PointCloud &pcd,
+                    const geometry::PointCloudNeighborhoods &neighborhoods,
+                    bool fast_normal_computation) {
+                     std::vector<double> curvatures;
+                     pcd.EstimateNormals(neighborhoods, curvatures,
+                                         fast_normal_computation);
+                     return curvatures;
+                 },
+                 "Function to compute the normals of a point cloud from "
+                 "precomputed neighborhoods. Returns the surface variation "
+                 "of the neighborhood of each point.",
+                 "neighborhoods"_a, "fast_normal_computation"_a = true)
             .def("orient_normals_to_align_with_direction",
                  &geometry::PointCloud::OrientNormalsToAlignWithDirection,
                  "Function to orient the normals of a point cloud",
@@ -120,6 +161,12 @@ void pybind_pointcloud(py::module &m) {
                  &geometry::PointCloud::OrientNormalsTowardsCameraLocation,
                  "Function to orient the normals of a point cloud",
                  "camera_location"_a = Eigen::Vector3d(0.0, 0.0, 0.0))
+            .def("orient_normals_consistent_tangent_plane",
+                 &geometry::PointCloud::OrientNormalsConsistentTangentPlane,
+                 "Function to consistently orient the normals of a point "
+                 "cloud by propagating the orientation along a minimum "
+                 "spanning tree of its k nearest neighbor graph",
+                 "k"_a)
             .def("compute_point_cloud_distance",
                  &geometry::PointCloud::ComputePointCloudDistance,
                  "For each point in the source point cloud, compute the "
@@ -203,6 +250,10 @@ void pybind_pointcloud(py::module &m) {
             {{"indices", "Indices of points to be selected."},
              {"invert",
               "Set to ``True`` to invert the selection of indices."}});
+    docstring::ClassMethodDocInject(
+            m, "PointCloud", "select_down_sample_by_mask",
+            {{"mask", "Boolean mask with one entry per point."},
+             {"invert", "Set to ``True`` to invert the mask."}});
     docstring::ClassMethodDocInject(
             m, "PointCloud", "voxel_down_sample",
             {{"voxel_size", "Voxel size to downsample into."},
@@ -233,10 +284,28 @@ void pybind_pointcloud(py::module &m) {
             m, "PointCloud", "remove_statistical_outlier",
             {{"nb_neighbors", "Number of neighbors around the target point."},
              {"std_ratio", "Standard deviation ratio."}});
+    docstring::ClassMethodDocInject(
+            m, "PointCloud", "compute_radius_inlier_mask",
+            {{"nb_points", "Number of points within the radius."},
+             {"radius", "Radius of the sphere."}});
+    docstring::ClassMethodDocInject(
+            m, "PointCloud", "compute_statistical_inlier_mask",
+            {{"nb_neighbors", "Number of neighbors around the target point."},
+             {"std_ratio", "Standard deviation ratio."}});
     docstring::ClassMethodDocInject(
             m, "PointCloud", "estimate_normals",
             {{"search_param",
               "The KDTree search parameters for neighborhood search."},
+             {"neighborhoods",
+              "Neighborhoods of the points, see PointCloudNeighborhoods."},
+             {"fast_normal_computation",
+              "If true, the normal estiamtion uses a non-iterative method to "
+              "extract the eigenvector from the covariance matrix. This is "
+              "faster, but is not as numerical stable."}});
+    docstring::ClassMethodDocInject(
+            m, "PointCloud", "estimate_normals_and_curvatures",
+            {{"neighborhoods",
+              "Neighborhoods of the points, see PointCloudNeighborhoods."},
              {"fast_normal_computation",
               "If true, the normal estiamtion uses a non-iterative method to "
               "extract the eigenvector from the covariance matrix. This is "
@@ -249,6 +318,11 @@ void pybind_pointcloud(py::module &m) {
             m, "PointCloud", "orient_normals_towards_camera_location",
             {{"camera_location",
               "Normals are oriented with towards the camera_location."}});
+    docstring::ClassMethodDocInject(
+            m, "PointCloud", "orient_normals_consistent_tangent_plane",
+            {{"k",
+              "Number of nearest neighbors used in constructing the "
+              "Riemannian graph used to propagate normal orientation."}});
     docstring::ClassMethodDocInject(m, "PointCloud",
                                     "compute_point_cloud_distance",
                                     {{"target", "The target point cloud."}});
@@ -269,6 +343,54 @@ void pybind_pointcloud(py::module &m) {
               "If true the progress is visualized in the console."}});
     docstring::ClassMethodDocInject(m, "PointCloud", "create_from_depth_image");
     docstring::ClassMethodDocInject(m, "PointCloud", "create_from_rgbd_image");
+
+    // open3d.geometry.DepthBackProjector
+    py::class_<geometry::DepthBackProjector,
+               std::shared_ptr<geometry::DepthBackProjector>>
+            projector(m, "DepthBackProjector",
+                      "Back-projects depth images of one camera into point "
+                      "clouds. Caches the pixel rays of the last intrinsic and "
+                      "reuses the storage of the output point cloud.");
+    projector.def(py::init<>())
+            .def("create_from_depth_image",
+                 [](geometry::DepthBackProjector &projector,
+                    const geometry::Image &depth,
+                    const camera::PinholeCameraIntrinsic &intrinsic,
+                    geometry::PointCloud &output,
+                    const Eigen::Matrix4d &extrinsic, double depth_scale,
+                    double depth_trunc, int stride) {
+                     return projector.CreateFromDepthImage(
+                             depth, intrinsic, extrinsic, depth_scale,
+                             depth_trunc, stride, output);
+                 },
+                 "Same as PointCloud.create_from_depth_image, but writes "
+                 "into ``output``.",
+                 "depth"_a, "intrinsic"_a, "output"_a,
+                 "extrinsic"_a = Eigen::Matrix4d::Identity(),
+                 "depth_scale"_a = 1000.0, "depth_trunc"_a = 1000.0,
+                 "stride"_a = 1)
+            .def("create_from_rgbd_image",
+                 [](geometry::DepthBackProjector &projector,
+                    const geometry::RGBDImage &image,
+                    const camera::PinholeCameraIntrinsic &intrinsic,
+                    geometry::PointCloud &output,
+                    const Eigen::Matrix4d &extrinsic) {
+                     return projector.CreateFromRGBDImage(image, intrinsic,
+                                                          extrinsic, output);
+                 },
+                 "Same as PointCloud.create_from_rgbd_image, but writes "
+                 "into ``output``.",
+                 "image"_a, "intrinsic"_a, "output"_a,
+                 "extrinsic"_a = Eigen::Matrix4d::Identity())
+            .def("__repr__", [](const geometry::DepthBackProjector &) {
+                return std::string("geometry::DepthBackProjector");
+            });
+    docstring::ClassMethodDocInject(
+            m, "DepthBackProjector", "create_from_depth_image",
+            {{"output", "Point cloud that receives the points."}});
+    docstring::ClassMethodDocInject(
+            m, "DepthBackProjector", "create_from_rgbd_image",
+            {{"output", "Point cloud that receives the points and colors."}});
 }
 
 void pybind_pointcloud_methods(py::module &m) {}
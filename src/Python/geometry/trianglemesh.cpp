@@ -252,7 +252,7 @@ void pybind_trianglemesh(py::module &m) {
                  "Function to simplify mesh using Quadric Error Metric "
                  "Decimation by "
                  "Garland and Heckbert",
-                 "target_number_of_triangles"_a)
+                 "target_number_of_triangles"_a, "parallel"_a = false)
             .def("compute_convex_hull",
                  &geometry::TriangleMesh::ComputeConvexHull,
                  "Computes the convex hull of the triangle mesh.")
@@ -272,6 +272,15 @@ void pybind_trianglemesh(py::module &m) {
                     "radius over the point cloud, whenever the ball touches "
                     "three points a triangle is created.",
                     "pcd"_a, "radii"_a)
+            .def_static(
+                    "create_from_point_cloud_ball_pivoting_parallel",
+                    &geometry::TriangleMesh::
+                            CreateFromPointCloudBallPivotingParallel,
+                    "Parallel variant of "
+                    "create_from_point_cloud_ball_pivoting. Space is divided "
+                    "into cubic cells that are reconstructed independently "
+                    "and the seams between the cells are closed afterwards.",
+                    "pcd"_a, "radii"_a, "cell_size"_a = 0.0)
             .def_static("create_box", &geometry::TriangleMesh::CreateBox,
                         "Factory function to create a box. The left bottom "
                         "corner on the "
@@ -491,7 +500,11 @@ void pybind_trianglemesh(py::module &m) {
             m, "TriangleMesh", "simplify_quadric_decimation",
             {{"target_number_of_triangles",
               "The number of triangles that the simplified mesh should have. "
-              "It is not guranteed that this number will be reached."}});
+              "It is not guranteed that this number will be reached."},
+             {"parallel",
+              "If true, the mesh is first decimated in spatial cells in "
+              "parallel with the cell boundaries fixed and only the remaining "
+              "triangles are decimated serially."}});
     docstring::ClassMethodDocInject(m, "TriangleMesh", "compute_convex_hull");
     docstring::ClassMethodDocInject(
             m, "TriangleMesh", "create_from_point_cloud_ball_pivoting",
@@ -501,6 +514,17 @@ void pybind_trianglemesh(py::module &m) {
              {"radii",
               "The radii of the ball that are used for the surface "
               "reconstruction."}});
+    docstring::ClassMethodDocInject(
+            m, "TriangleMesh", "create_from_point_cloud_ball_pivoting_parallel",
+            {{"pcd",
+              "PointCloud from whicht the TriangleMesh surface is "
+              "reconstructed. Has to contain normals."},
+             {"radii",
+              "The radii of the ball that are used for the surface "
+              "reconstruction."},
+             {"cell_size",
+              "Edge length of the cells that are reconstructed in parallel. "
+              "It is chosen from the number of points if not positive."}});
     docstring::ClassMethodDocInject(m, "TriangleMesh", "create_box",
                                     {{"width", "x-directional length."},
                                      {"height", "y-directional length."},
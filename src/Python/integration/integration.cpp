@@ -70,6 +70,21 @@ void pybind_integration_classes(py::module &m) {
             }),
             py::none(), py::none(), "");
 
+    // open3d.integration.VolumeUnitEvictionPolicy
+    py::enum_<integration::VolumeUnitEvictionPolicy> eviction_policy(
+            m, "VolumeUnitEvictionPolicy", py::arithmetic());
+    eviction_policy
+            .value("LeastRecentlyUsed",
+                   integration::VolumeUnitEvictionPolicy::LeastRecentlyUsed)
+            .value("CameraDistance",
+                   integration::VolumeUnitEvictionPolicy::CameraDistance)
+            .export_values();
+    eviction_policy.attr("__doc__") = docstring::static_property(
+            py::cpp_function([](py::handle arg) -> std::string {
+                return "Enum class for VolumeUnitEvictionPolicy.";
+            }),
+            py::none(), py::none(), "");
+
     // open3d.integration.TSDFVolume
     py::class_<integration::TSDFVolume, PyTSDFVolume<integration::TSDFVolume>>
             tsdfvolume(m, "TSDFVolume", R"(Base class of the Truncated
@@ -201,9 +216,76 @@ In SIGGRAPH, 2013)");
             .def("extract_voxel_point_cloud",
                  &integration::ScalableTSDFVolume::ExtractVoxelPointCloud,
                  "Debug function to extract the voxel data into a point "
-                 "cloud.");
+                 "cloud.")
+            .def("extract_dirty_triangle_meshes",
+                 &integration::ScalableTSDFVolume::ExtractDirtyTriangleMeshes,
+                 "Function to mesh the volume units modified since the last "
+                 "call and their neighbours. Returns a list of (volume unit "
+                 "index, mesh) tuples, where each mesh replaces the one "
+                 "returned before for the same volume unit.")
+            .def("extract_volume_unit_triangle_mesh",
+                 &integration::ScalableTSDFVolume::
+                         ExtractVolumeUnitTriangleMesh,
+                 "Function to extract the mesh of a single volume unit",
+                 "index"_a)
+            .def("raycast",
+                 [](const integration::ScalableTSDFVolume &volume,
+                    const camera::PinholeCameraIntrinsic &intrinsic,
+                    const Eigen::Matrix4d &extrinsic, double depth_min,
+                    double depth_max) {
+                     geometry::Image depth, normal, color;
+                     volume.Raycast(intrinsic, extrinsic, depth, normal, color,
+                                    depth_min, depth_max);
+                     return std::make_tuple(depth, normal, color);
+                 },
+                 "Function to render the depth, normal and color images of "
+                 "the surface seen by a pinhole camera",
+                 "intrinsic"_a, "extrinsic"_a, "depth_min"_a = 0.1,
+                 "depth_max"_a = 3.0)
+            .def("enable_paging",
+                 &integration::ScalableTSDFVolume::EnablePaging,
+                 "Function to keep at most max_volume_units volume units in "
+                 "memory and page the others out to a file",
+                 "filename"_a, "max_volume_units"_a,
+                 "policy"_a = integration::VolumeUnitEvictionPolicy::
+                         LeastRecentlyUsed)
+            .def("disable_paging",
+                 &integration::ScalableTSDFVolume::DisablePaging,
+                 "Function to read all paged volume units back into memory")
+            .def("is_paging_enabled",
+                 &integration::ScalableTSDFVolume::IsPagingEnabled,
+                 "Returns ``True`` if volume units are paged out to a file.")
+            .def("get_volume_unit_count",
+                 &integration::ScalableTSDFVolume::GetVolumeUnitCount,
+                 "Returns the number of volume units in memory and paged out.")
+            .def("get_paged_volume_unit_count",
+                 &integration::ScalableTSDFVolume::GetPagedVolumeUnitCount,
+                 "Returns the number of paged out volume units.");
     docstring::ClassMethodDocInject(m, "ScalableTSDFVolume",
                                     "extract_voxel_point_cloud");
+    docstring::ClassMethodDocInject(m, "ScalableTSDFVolume",
+                                    "extract_dirty_triangle_meshes");
+    docstring::ClassMethodDocInject(
+            m, "ScalableTSDFVolume", "extract_volume_unit_triangle_mesh",
+            {{"index", "Index of the volume unit."}});
+    docstring::ClassMethodDocInject(
+            m, "ScalableTSDFVolume", "raycast",
+            {{"intrinsic", "Pinhole camera intrinsic parameters."},
+             {"extrinsic", "Extrinsic parameters of the camera."},
+             {"depth_min", "Depth of the closest surface in meters."},
+             {"depth_max", "Depth of the farthest surface in meters."}});
+    docstring::ClassMethodDocInject(
+            m, "ScalableTSDFVolume", "enable_paging",
+            {{"filename", "Path of the file that holds paged volume units."},
+             {"max_volume_units", "Number of volume units kept in memory."},
+             {"policy", "Policy that chooses the volume units to page out."}});
+    docstring::ClassMethodDocInject(m, "ScalableTSDFVolume", "disable_paging");
+    docstring::ClassMethodDocInject(m, "ScalableTSDFVolume",
+                                    "is_paging_enabled");
+    docstring::ClassMethodDocInject(m, "ScalableTSDFVolume",
+                                    "get_volume_unit_count");
+    docstring::ClassMethodDocInject(m, "ScalableTSDFVolume",
+                                    "get_paged_volume_unit_count");
 }
 
 void pybind_integration_methods(py::module &m) {
@@ -38,6 +38,7 @@
 #include "Open3D/IO/ClassIO/PinholeCameraTrajectoryIO.h"
 #include "Open3D/IO/ClassIO/PointCloudIO.h"
 #include "Open3D/IO/ClassIO/PoseGraphIO.h"
+#include "Open3D/IO/ClassIO/TSDFVolumeIO.h"
 #include "Open3D/IO/ClassIO/TriangleMeshIO.h"
 #include "Open3D/IO/ClassIO/VoxelGridIO.h"
 #include "Open3D/IO/Sensor/AzureKinect/AzureKinectSensorConfig.h"
@@ -86,6 +87,9 @@ static const std::unordered_map<std::string, std::string>
                  "The ``PinholeCameraParameters`` object for I/O"},
                 {"pose_graph", "The ``PoseGraph`` object for I/O"},
                 {"feature", "The ``Feature`` object for I/O"},
+                {"volume",
+                 "The ``UniformTSDFVolume`` or ``ScalableTSDFVolume`` object "
+                 "for I/O"},
                 {"print_progress",
                  "If set to true a progress bar is visualized in the console"},
 };
@@ -323,6 +327,55 @@ void pybind_class_io(py::module &m_io) {
     docstring::FunctionDocInject(m_io, "write_pose_graph",
                                  map_shared_argument_docstrings);
 
+    // open3d::integration
+    m_io.def("read_uniform_tsdf_volume",
+             [](const std::string &filename) {
+                 integration::UniformTSDFVolume volume(
+                         1.0, 1, 1.0, integration::TSDFVolumeColorType::None);
+                 io::ReadTSDFVolume(filename, volume);
+                 return volume;
+             },
+             "Function to read UniformTSDFVolume from a TSDF file",
+             "filename"_a);
+    docstring::FunctionDocInject(m_io, "read_uniform_tsdf_volume",
+                                 map_shared_argument_docstrings);
+
+    m_io.def("write_uniform_tsdf_volume",
+             [](const std::string &filename,
+                const integration::UniformTSDFVolume &volume,
+                bool compressed) {
+                 return io::WriteTSDFVolume(filename, volume, compressed);
+             },
+             "Function to write UniformTSDFVolume to a TSDF file",
+             "filename"_a, "volume"_a, "compressed"_a = true);
+    docstring::FunctionDocInject(m_io, "write_uniform_tsdf_volume",
+                                 map_shared_argument_docstrings);
+
+    m_io.def("read_scalable_tsdf_volume",
+             [](const std::string &filename) {
+                 integration::ScalableTSDFVolume volume(
+                         1.0, 1.0, integration::TSDFVolumeColorType::None);
+                 io::ReadTSDFVolume(filename, volume);
+                 return volume;
+             },
+             "Function to read ScalableTSDFVolume from a TSDF file. All "
+             "volume units are in memory and marked dirty",
+             "filename"_a);
+    docstring::FunctionDocInject(m_io, "read_scalable_tsdf_volume",
+                                 map_shared_argument_docstrings);
+
+    m_io.def("write_scalable_tsdf_volume",
+             [](const std::string &filename,
+                const integration::ScalableTSDFVolume &volume,
+                bool compressed) {
+                 return io::WriteTSDFVolume(filename, volume, compressed);
+             },
+             "Function to write ScalableTSDFVolume, including paged volume "
+             "units, to a TSDF file",
+             "filename"_a, "volume"_a, "compressed"_a = true);
+    docstring::FunctionDocInject(m_io, "write_scalable_tsdf_volume",
+                                 map_shared_argument_docstrings);
+
 #ifdef BUILD_AZURE_KINECT
     m_io.def("read_azure_kinect_sensor_config",
              [](const std::string &filename) {
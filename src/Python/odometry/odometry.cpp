@@ -66,15 +66,16 @@ void pybind_odometry_classes(py::module &m) {
             .def(py::init(
                          [](std::vector<int> iteration_number_per_pyramid_level,
                             double max_depth_diff, double min_depth,
-                            double max_depth) {
+                            double max_depth, bool depth_preprocessed) {
                              return new odometry::OdometryOption(
                                      iteration_number_per_pyramid_level,
-                                     max_depth_diff, min_depth, max_depth);
+                                     max_depth_diff, min_depth, max_depth,
+                                     depth_preprocessed);
                          }),
                  "iteration_number_per_pyramid_level"_a =
                          std::vector<int>{20, 10, 5},
                  "max_depth_diff"_a = 0.03, "min_depth"_a = 0.0,
-                 "max_depth"_a = 4.0)
+                 "max_depth"_a = 4.0, "depth_preprocessed"_a = false)
             .def_readwrite("iteration_number_per_pyramid_level",
                            &odometry::OdometryOption::
                                    iteration_number_per_pyramid_level_,
@@ -97,6 +98,11 @@ void pybind_odometry_classes(py::module &m) {
             .def_readwrite("max_depth", &odometry::OdometryOption::max_depth_,
                            "Pixels that has larger than specified depth values "
                            "are ignored.")
+            .def_readwrite("depth_preprocessed",
+                           &odometry::OdometryOption::depth_preprocessed_,
+                           "Set if the depth of both RGBD images comes from "
+                           "DepthPreprocessor. The depth is then used as it is "
+                           "instead of being smoothed again.")
             .def("__repr__", [](const odometry::OdometryOption &c) {
                 int num_pyramid_level =
                         (int)c.iteration_number_per_pyramid_level_.size();
@@ -117,7 +123,9 @@ void pybind_odometry_classes(py::module &m) {
                        std::string("\nmin_depth = ") +
                        std::to_string(c.min_depth_) +
                        std::string("\nmax_depth = ") +
-                       std::to_string(c.max_depth_);
+                       std::to_string(c.max_depth_) +
+                       std::string("\ndepth_preprocessed = ") +
+                       std::to_string(c.depth_preprocessed_);
             });
 
     // open3d.odometry.RGBDOdometryJacobian
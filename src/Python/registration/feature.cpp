@@ -26,6 +26,7 @@
 
 #include "Open3D/Registration/Feature.h"
 #include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/PointCloudNeighborhoods.h"
 #include "Python/docstring.h"
 #include "Python/registration/registration.h"
 
@@ -62,11 +63,26 @@ void pybind_feature(py::module &m) {
 }
 
 void pybind_feature_methods(py::module &m) {
-    m.def("compute_fpfh_feature", &registration::ComputeFPFHFeature,
+    m.def("compute_fpfh_feature",
+          (std::shared_ptr<registration::Feature>(*)(
+                  const geometry::PointCloud &,
+                  const geometry::KDTreeSearchParam &)) &
+                  registration::ComputeFPFHFeature,
           "Function to compute FPFH feature for a point cloud", "input"_a,
           "search_param"_a);
+    m.def("compute_fpfh_feature",
+          (std::shared_ptr<registration::Feature>(*)(
+                  const geometry::PointCloud &,
+                  const geometry::PointCloudNeighborhoods &)) &
+                  registration::ComputeFPFHFeature,
+          "Function to compute FPFH feature for a point cloud from "
+          "precomputed neighborhoods",
+          "input"_a, "neighborhoods"_a);
     docstring::FunctionDocInject(
             m, "compute_fpfh_feature",
             {{"input", "The Input point cloud."},
-             {"search_param", "KDTree KNN search parameter."}});
+             {"search_param", "KDTree KNN search parameter."},
+             {"neighborhoods",
+              "Neighborhoods of the points, see "
+              "geometry.PointCloudNeighborhoods."}});
 }
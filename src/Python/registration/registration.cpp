@@ -383,17 +383,17 @@ must hold true for all edges.)");
                              bool decrease_mu,
                              double maximum_correspondence_distance,
                              int iteration_number, double tuple_scale,
-                             int maximum_tuple_count) {
+                             int maximum_tuple_count, int seed) {
                      return new registration::FastGlobalRegistrationOption(
                              division_factor, use_absolute_scale, decrease_mu,
                              maximum_correspondence_distance, iteration_number,
-                             tuple_scale, maximum_tuple_count);
+                             tuple_scale, maximum_tuple_count, seed);
                  }),
                  "division_factor"_a = 1.4, "use_absolute_scale"_a = false,
                  "decrease_mu"_a = false,
                  "maximum_correspondence_distance"_a = 0.025,
                  "iteration_number"_a = 64, "tuple_scale"_a = 0.95,
-                 "maximum_tuple_count"_a = 1000)
+                 "maximum_tuple_count"_a = 1000, "seed"_a = -1)
             .def_readwrite(
                     "division_factor",
                     &registration::FastGlobalRegistrationOption::
@@ -427,6 +427,11 @@ must hold true for all edges.)");
                            &registration::FastGlobalRegistrationOption::
                                    maximum_tuple_count_,
                            "float: Maximum tuple numbers.")
+            .def_readwrite(
+                    "seed", &registration::FastGlobalRegistrationOption::seed_,
+                    "int: Seed of the random tuple test. The result is "
+                    "reproducible for a fixed non-negative seed. A negative "
+                    "seed uses the current time.")
             .def("__repr__",
                  [](const registration::FastGlobalRegistrationOption &c) {
                      return std::string(
@@ -447,9 +452,48 @@ must hold true for all edges.)");
                             std::string("\ntuple_scale = ") +
                             std::to_string(c.tuple_scale_) +
                             std::string("\nmaximum_tuple_count = ") +
-                            std::to_string(c.maximum_tuple_count_);
+                            std::to_string(c.maximum_tuple_count_) +
+                            std::string("\nseed = ") +
+                            std::to_string(c.seed_);
                  });
 
+    // open3d.registration.ColoredICPTarget
+    py::class_<registration::ColoredICPTarget,
+               std::shared_ptr<registration::ColoredICPTarget>>
+            colored_icp_target(m, "ColoredICPTarget",
+                               "Target of colored ICP with its KDTree and "
+                               "precomputed color gradients. A prepared "
+                               "target can be registered against many "
+                               "sources.");
+    colored_icp_target.def(py::init<>())
+            .def(py::init<const geometry::PointCloud &,
+                          const geometry::KDTreeSearchParamHybrid &>(),
+                 "target"_a, "search_param"_a)
+            .def("set_point_cloud",
+                 &registration::ColoredICPTarget::SetPointCloud,
+                 "Copies the target, builds its KDTree and estimates the "
+                 "color gradients.",
+                 "target"_a, "search_param"_a)
+            .def("__repr__",
+                 [](const registration::ColoredICPTarget &target) {
+                     return std::string(
+                                    "registration::ColoredICPTarget with ") +
+                            std::to_string(target.point_cloud_.points_.size()) +
+                            " points.";
+                 })
+            .def_readonly("point_cloud",
+                          &registration::ColoredICPTarget::point_cloud_,
+                          "``geometry.PointCloud``: The target point cloud.")
+            .def_readonly("color_gradient",
+                          &registration::ColoredICPTarget::color_gradient_,
+                          "``n x 3`` float64 numpy array: Color gradient of "
+                          "every target point.");
+    docstring::ClassMethodDocInject(
+            m, "ColoredICPTarget", "set_point_cloud",
+            {{"target", "The target point cloud with normals and colors."},
+             {"search_param",
+              "The KDTree search parameters for the gradient estimation."}});
+
     // ope3dn.registration.RegistrationResult
     py::class_<registration::RegistrationResult> registration_result(
             m, "RegistrationResult",
@@ -527,7 +571,13 @@ void pybind_registration_methods(py::module &m) {
     docstring::FunctionDocInject(m, "evaluate_registration",
                                  map_shared_argument_docstrings);
 
-    m.def("registration_icp", &registration::RegistrationICP,
+    m.def("registration_icp",
+          (registration::RegistrationResult(*)(
+                  const geometry::PointCloud &, const geometry::PointCloud &,
+                  double, const Eigen::Matrix4d &,
+                  const registration::TransformationEstimation &,
+                  const registration::ICPConvergenceCriteria &)) &
+                  registration::RegistrationICP,
           "Function for ICP registration", "source"_a, "target"_a,
           "max_correspondence_distance"_a,
           "init"_a = Eigen::Matrix4d::Identity(),
@@ -537,15 +587,40 @@ void pybind_registration_methods(py::module &m) {
     docstring::FunctionDocInject(m, "registration_icp",
                                  map_shared_argument_docstrings);
 
-    m.def("registration_colored_icp", &registration::RegistrationColoredICP,
+    m.def("registration_colored_icp",
+          (registration::RegistrationResult(*)(
+                  const geometry::PointCloud &, const geometry::PointCloud &,
+                  double, const Eigen::Matrix4d &,
+                  const registration::ICPConvergenceCriteria &, double)) &
+                  registration::RegistrationColoredICP,
           "Function for Colored ICP registration", "source"_a, "target"_a,
           "max_correspondence_distance"_a,
           "init"_a = Eigen::Matrix4d::Identity(),
           "criteria"_a = registration::ICPConvergenceCriteria(),
           "lambda_geometric"_a = 0.968);
+    m.def("registration_colored_icp",
+          (registration::RegistrationResult(*)(
+                  const geometry::PointCloud &,
+                  const registration::ColoredICPTarget &, double,
+                  const Eigen::Matrix4d &,
+                  const registration::ICPConvergenceCriteria &, double)) &
+                  registration::RegistrationColoredICP,
+          "Function for Colored ICP registration against a prepared target",
+          "source"_a, "target"_a, "max_correspondence_distance"_a,
+          "init"_a = Eigen::Matrix4d::Identity(),
+          "criteria"_a = registration::ICPConvergenceCriteria(),
+          "lambda_geometric"_a = 0.968);
     docstring::FunctionDocInject(m, "registration_colored_icp",
                                  map_shared_argument_docstrings);
 
+    m.def("prepare_colored_icp_target",
+          &registration::PrepareColoredICPTarget,
+          "Function to prepare a target for Colored ICP the same way "
+          "registration_colored_icp does for the given distance",
+          "target"_a, "max_correspondence_distance"_a);
+    docstring::FunctionDocInject(m, "prepare_colored_icp_target",
+                                 map_shared_argument_docstrings);
+
     m.def("registration_ransac_based_on_correspondence",
           &registration::RegistrationRANSACBasedOnCorrespondence,
           "Function for global RANSAC registration based on a set of "
@@ -0,0 +1,73 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+
+#include "Open3D/Utility/Profiler.h"
+#include "Python/docstring.h"
+#include "Python/open3d_pybind.h"
+
+using namespace open3d;
+
+void pybind_profiler(py::module &m) {
+    m.def("set_profiling_enabled",
+          [](bool enabled) { utility::Profiler::i().SetEnabled(enabled); },
+          "Start or stop recording the profiling zones of Open3D. Zones are "
+          "only available if Open3D is built with ENABLE_PROFILING",
+          py::arg("enabled"));
+    docstring::FunctionDocInject(
+            m, "set_profiling_enabled",
+            {{"enabled", "Whether profiling zones are recorded."}});
+
+    m.def("is_profiling_enabled",
+          []() { return utility::Profiler::i().IsEnabled(); },
+          "Whether profiling zones are recorded");
+    docstring::FunctionDocInject(m, "is_profiling_enabled");
+
+    m.def("clear_profile", []() { utility::Profiler::i().Clear(); },
+          "Discard all recorded profiling zones");
+    docstring::FunctionDocInject(m, "clear_profile");
+
+    m.def("get_profile_report",
+          []() { return utility::Profiler::i().GetReport(); },
+          "Statistics of the recorded profiling zones as an indented table");
+    docstring::FunctionDocInject(m, "get_profile_report");
+
+    m.def("print_profile_report",
+          []() { utility::Profiler::i().PrintReport(); },
+          "Print statistics of the recorded profiling zones");
+    docstring::FunctionDocInject(m, "print_profile_report");
+
+    m.def("write_chrome_trace",
+          [](const std::string &filename) {
+              return utility::Profiler::i().WriteChromeTrace(filename);
+          },
+          "Write the recorded profiling zones in the Chrome trace event "
+          "format",
+          py::arg("filename"));
+    docstring::FunctionDocInject(
+            m, "write_chrome_trace",
+            {{"filename", "Path of the JSON file to write."}});
+}
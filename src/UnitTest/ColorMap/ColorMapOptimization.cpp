@@ -24,6 +24,7 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include "Open3D/ColorMap/ColorMapOptimization.h"
 #include "Open3D/Camera/PinholeCameraTrajectory.h"
 #include "Open3D/Geometry/Image.h"
 #include "Open3D/Geometry/RGBDImage.h"
@@ -1167,3 +1168,103 @@ TEST(ColorMapOptimization, DISABLED_ColorMapOptimization) {
     for (size_t i = 0; i < ref_triangle_normals.size(); i++)
         ExpectEQ(ref_triangle_normals[i], mesh->triangle_normals_[i]);
 }
+
+// ----------------------------------------------------------------------------
+// Generate a planar grid mesh at depth 1 and keyframes of cameras that are
+// shifted sideways, so that every keyframe sees a part of the plane.
+// ----------------------------------------------------------------------------
+void GenerateStreamingScene(
+        geometry::TriangleMesh& mesh,
+        vector<shared_ptr<geometry::RGBDImage>>& rgbd_images,
+        camera::PinholeCameraTrajectory& camera) {
+    const int width = 64;
+    const int height = 48;
+    const int n_grid = 24;
+    const size_t n_camera = 5;
+
+    mesh.Clear();
+    for (int v = 0; v < n_grid; v++) {
+        for (int u = 0; u < n_grid; u++) {
+            mesh.vertices_.push_back(Eigen::Vector3d(
+                    -0.6 + 1.2 * u / (n_grid - 1),
+                    -0.45 + 0.9 * v / (n_grid - 1), 1.0));
+        }
+    }
+    for (int v = 0; v + 1 < n_grid; v++) {
+        for (int u = 0; u + 1 < n_grid; u++) {
+            int i = v * n_grid + u;
+            mesh.triangles_.push_back(Eigen::Vector3i(i, i + 1, i + n_grid));
+            mesh.triangles_.push_back(
+                    Eigen::Vector3i(i + 1, i + n_grid + 1, i + n_grid));
+        }
+    }
+
+    camera.parameters_.resize(n_camera);
+    rgbd_images.clear();
+    for (size_t c = 0; c < n_camera; c++) {
+        camera.parameters_[c].intrinsic_.SetIntrinsics(
+                width, height, 50.0, 50.0, width / 2 - 0.5, height / 2 - 0.5);
+        camera.parameters_[c].extrinsic_ = Eigen::Matrix4d::Identity();
+        camera.parameters_[c].extrinsic_(0, 3) = 0.05 * c - 0.1;
+
+        auto rgbd = make_shared<geometry::RGBDImage>();
+        rgbd->color_.Prepare(width, height, 3, 1);
+        rgbd->depth_.Prepare(width, height, 1, 4);
+        for (int v = 0; v < height; v++) {
+            for (int u = 0; u < width; u++) {
+                double x = (u + 2.5 * c) * 0.2;
+                double y = v * 0.15;
+                *rgbd->color_.PointerAt<uint8_t>(u, v, 0) =
+                        uint8_t(128 + 100 * sin(x) * cos(y));
+                *rgbd->color_.PointerAt<uint8_t>(u, v, 1) =
+                        uint8_t(128 + 100 * cos(x + y));
+                *rgbd->color_.PointerAt<uint8_t>(u, v, 2) =
+                        uint8_t(128 + 100 * sin(0.5 * x - y));
+                *rgbd->depth_.PointerAt<float>(u, v) = 1.0f;
+            }
+        }
+        rgbd_images.push_back(rgbd);
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(ColorMapOptimization, StreamingMatchesInMemory) {
+    for (bool non_rigid : {false, true}) {
+        geometry::TriangleMesh mesh_ref;
+        vector<shared_ptr<geometry::RGBDImage>> rgbd_images;
+        camera::PinholeCameraTrajectory camera_ref;
+        GenerateStreamingScene(mesh_ref, rgbd_images, camera_ref);
+        geometry::TriangleMesh mesh = mesh_ref;
+        camera::PinholeCameraTrajectory camera = camera_ref;
+
+        color_map::ColorMapOptimizationOption option;
+        option.non_rigid_camera_coordinate_ = non_rigid;
+        option.number_of_vertical_anchors_ = 4;
+        option.maximum_iteration_ = 5;
+        option.image_boundary_margin_ = 2;
+        option.half_dilation_kernel_size_for_discontinuity_map_ = 1;
+        // Fewer cached keyframes than cameras, forcing evictions.
+        option.maximum_cached_keyframes_ = 2;
+
+        color_map::ColorMapOptimization(mesh_ref, rgbd_images, camera_ref,
+                                        option);
+
+        int n_loaded = 0;
+        color_map::RGBDImageProvider provider =
+                [&](int index) -> shared_ptr<geometry::RGBDImage> {
+            n_loaded++;
+            return make_shared<geometry::RGBDImage>(*rgbd_images[index]);
+        };
+        color_map::ColorMapOptimization(mesh, provider, camera, option);
+
+        EXPECT_GT(n_loaded, int(rgbd_images.size()));
+        EXPECT_EQ(camera_ref.parameters_.size(), camera.parameters_.size());
+        for (size_t c = 0; c < camera.parameters_.size(); c++) {
+            ExpectEQ(camera_ref.parameters_[c].extrinsic_,
+                     camera.parameters_[c].extrinsic_);
+        }
+        ExpectEQ(mesh_ref.vertex_colors_, mesh.vertex_colors_);
+    }
+}
@@ -0,0 +1,132 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/ColorMap/EigenHelperForNonRigidOptimization.h"
+#include "TestUtility/UnitTest.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+namespace {
+
+const int kNonRigidVal = 10;
+const int kNumRows = 500;
+
+/// Row i has random entries at random columns, some of them repeated.
+void TestFunction(int i, Vector14d &J_r, double &r, Vector14i &pattern) {
+    vector<double> v(14);
+    Rand(v, -1.0, 1.0, i);
+    vector<int> cols(14);
+    Rand(cols, 0, 6 + kNonRigidVal - 1, i);
+    for (int k = 0; k < 14; k++) {
+        J_r(k) = v[k];
+        pattern(k) = cols[k];
+    }
+    r = v[0] - v[13];
+}
+
+/// Accumulates the dense rows of TestFunction.
+void ReferenceJTJandJTr(MatrixXd &JTJ, VectorXd &JTr, double &r2) {
+    const int size = 6 + kNonRigidVal;
+    JTJ.setZero(size, size);
+    JTr.setZero(size);
+    r2 = 0.0;
+    for (int i = 0; i < kNumRows; i++) {
+        Vector14d J_r;
+        Vector14i pattern;
+        double r;
+        TestFunction(i, J_r, r, pattern);
+        VectorXd row = VectorXd::Zero(size);
+        for (int k = 0; k < 14; k++) {
+            row(pattern(k)) += J_r(k);
+        }
+        JTJ += row * row.transpose();
+        JTr += r * row;
+        r2 += r * r;
+    }
+}
+
+}  // unnamed namespace
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(EigenHelperForNonRigidOptimization, ComputeJTJandJTrNonRigid) {
+    MatrixXd ref_JTJ;
+    VectorXd ref_JTr;
+    double ref_r2;
+    ReferenceJTJandJTr(ref_JTJ, ref_JTr, ref_r2);
+
+    MatrixXd JTJ;
+    VectorXd JTr;
+    double r2;
+    tie(JTJ, JTr, r2) = color_map::ComputeJTJandJTrNonRigid<
+            Vector14d, Vector14i, MatrixXd, VectorXd>(TestFunction, kNumRows,
+                                                      kNonRigidVal, false);
+    ExpectEQ(ref_JTJ, JTJ);
+    ExpectEQ(ref_JTr, JTr);
+    EXPECT_NEAR(ref_r2, r2, THRESHOLD_1E_6);
+}
+
+// ----------------------------------------------------------------------------
+// ColorMapOptimization calls it from a parallel loop over the cameras, where
+// the nested region runs on fewer threads than omp_get_max_threads().
+// ----------------------------------------------------------------------------
+TEST(EigenHelperForNonRigidOptimization, ComputeJTJandJTrNonRigidNested) {
+    MatrixXd ref_JTJ;
+    VectorXd ref_JTr;
+    double ref_r2;
+    ReferenceJTJandJTr(ref_JTJ, ref_JTr, ref_r2);
+
+    const int num_calls = 8;
+    vector<MatrixXd> JTJ(num_calls);
+    vector<VectorXd> JTr(num_calls);
+    vector<double> r2(num_calls);
+#ifdef _OPENMP
+    int num_threads = omp_get_max_threads();
+    omp_set_num_threads(4);
+#pragma omp parallel for schedule(static)
+#endif
+    for (int c = 0; c < num_calls; c++) {
+        tie(JTJ[c], JTr[c], r2[c]) = color_map::ComputeJTJandJTrNonRigid<
+                Vector14d, Vector14i, MatrixXd, VectorXd>(
+                TestFunction, kNumRows, kNonRigidVal, false);
+    }
+#ifdef _OPENMP
+    omp_set_num_threads(num_threads);
+#endif
+    for (int c = 0; c < num_calls; c++) {
+        ExpectEQ(ref_JTJ, JTJ[c]);
+        ExpectEQ(ref_JTr, JTr[c]);
+        EXPECT_NEAR(ref_r2, r2[c], THRESHOLD_1E_6);
+    }
+}
@@ -0,0 +1,158 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include "Open3D/Geometry/DepthBackProjector.h"
+#include "Open3D/Camera/PinholeCameraIntrinsic.h"
+#include "Open3D/Geometry/Image.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/RGBDImage.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+namespace {
+
+// Back-projects the pixels of a float depth image one by one.
+vector<Vector3d> ReferenceBackProjection(
+        const geometry::Image &depth,
+        const camera::PinholeCameraIntrinsic &intrinsic,
+        const Matrix4d &extrinsic,
+        int stride) {
+    Matrix4d camera_pose = extrinsic.inverse();
+    auto focal_length = intrinsic.GetFocalLength();
+    auto principal_point = intrinsic.GetPrincipalPoint();
+    vector<Vector3d> points;
+    for (int v = 0; v < depth.height_; v += stride) {
+        for (int u = 0; u < depth.width_; u += stride) {
+            double z = *depth.PointerAt<float>(u, v);
+            if (z <= 0) continue;
+            double x = (u - principal_point.first) * z / focal_length.first;
+            double y = (v - principal_point.second) * z / focal_length.second;
+            Vector4d point = camera_pose * Vector4d(x, y, z, 1.0);
+            points.push_back(point.block<3, 1>(0, 0));
+        }
+    }
+    return points;
+}
+
+}  // unnamed namespace
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(DepthBackProjector, CreateFromDepthImage) {
+    int width = 64;
+    int height = 48;
+    geometry::Image depth;
+    depth.Prepare(width, height, 1, 2);
+    Rand(depth.data_, 0, 255, 0);
+    // Invalidate some pixels by truncation.
+    double depth_scale = 1000.0;
+    double depth_trunc = 50.0;
+
+    camera::PinholeCameraIntrinsic intrinsic(width, height, 50.0, 55.0, 31.5,
+                                             23.0);
+    Matrix4d extrinsic = Matrix4d::Identity();
+    extrinsic.block<3, 3>(0, 0) =
+            AngleAxisd(0.4, Vector3d(0.0, 1.0, 1.0).normalized())
+                    .toRotationMatrix();
+    extrinsic.block<3, 1>(0, 3) = Vector3d(0.1, -0.2, 0.3);
+
+    auto float_depth = depth.ConvertDepthToFloatImage(depth_scale, depth_trunc);
+
+    geometry::DepthBackProjector projector;
+    geometry::PointCloud output;
+    for (int stride : {1, 3}) {
+        auto ref = ReferenceBackProjection(*float_depth, intrinsic, extrinsic,
+                                           stride);
+        EXPECT_TRUE(projector.CreateFromDepthImage(depth, intrinsic, extrinsic,
+                                                   depth_scale, depth_trunc,
+                                                   stride, output));
+        ExpectEQ(ref, output.points_);
+        EXPECT_TRUE(projector.CreateFromDepthImage(*float_depth, intrinsic,
+                                                   extrinsic, depth_scale,
+                                                   depth_trunc, stride,
+                                                   output));
+        ExpectEQ(ref, output.points_);
+    }
+
+    // The storage of the output is reused for frames that are not larger.
+    EXPECT_TRUE(projector.CreateFromDepthImage(depth, intrinsic, extrinsic,
+                                               depth_scale, depth_trunc, 1,
+                                               output));
+    const Vector3d *data = output.points_.data();
+    EXPECT_TRUE(projector.CreateFromDepthImage(depth, intrinsic, extrinsic,
+                                               depth_scale, depth_trunc, 2,
+                                               output));
+    EXPECT_EQ(data, output.points_.data());
+
+    geometry::Image color;
+    color.Prepare(width, height, 3, 1);
+    EXPECT_FALSE(projector.CreateFromDepthImage(color, intrinsic, extrinsic,
+                                                depth_scale, depth_trunc, 1,
+                                                output));
+    EXPECT_TRUE(output.IsEmpty());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(DepthBackProjector, CreateFromRGBDImage) {
+    int width = 40;
+    int height = 30;
+    geometry::Image depth;
+    depth.Prepare(width, height, 1, 2);
+    Rand(depth.data_, 0, 255, 0);
+    geometry::Image color;
+    color.Prepare(width, height, 3, 1);
+    Rand(color.data_, 0, 255, 1);
+    geometry::RGBDImage rgbd(color, *depth.ConvertDepthToFloatImage());
+
+    camera::PinholeCameraIntrinsic intrinsic(width, height, 40.0, 40.0, 19.5,
+                                             14.5);
+    Matrix4d extrinsic = Matrix4d::Identity();
+    extrinsic.block<3, 1>(0, 3) = Vector3d(1.0, 2.0, 3.0);
+
+    auto ref = ReferenceBackProjection(rgbd.depth_, intrinsic, extrinsic, 1);
+    geometry::DepthBackProjector projector;
+    geometry::PointCloud output;
+    EXPECT_TRUE(projector.CreateFromRGBDImage(rgbd, intrinsic, extrinsic,
+                                              output));
+    ExpectEQ(ref, output.points_);
+    EXPECT_EQ(ref.size(), output.colors_.size());
+    size_t k = 0;
+    for (int v = 0; v < height; v++) {
+        for (int u = 0; u < width; u++) {
+            if (*rgbd.depth_.PointerAt<float>(u, v) <= 0) continue;
+            Vector3d c(*color.PointerAt<uint8_t>(u, v, 0),
+                       *color.PointerAt<uint8_t>(u, v, 1),
+                       *color.PointerAt<uint8_t>(u, v, 2));
+            ExpectEQ(Vector3d(c / 255.0), output.colors_[k++]);
+        }
+    }
+}
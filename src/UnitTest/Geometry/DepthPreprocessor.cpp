@@ -0,0 +1,149 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Geometry/DepthPreprocessor.h"
+#include "Open3D/Geometry/Image.h"
+#include "Open3D/Geometry/RGBDImage.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace open3d;
+using namespace unit_test;
+
+namespace {
+
+// A wall at 2 m with a box at 1 m in front of the columns [8, 16).
+geometry::Image CreateStepDepth(int width, int height) {
+    geometry::Image depth;
+    depth.Prepare(width, height, 1, 4);
+    for (int v = 0; v < height; v++) {
+        for (int u = 0; u < width; u++) {
+            *depth.PointerAt<float>(u, v) = (u >= 8 && u < 16) ? 1.0f : 2.0f;
+        }
+    }
+    return depth;
+}
+
+}  // unnamed namespace
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(DepthPreprocessor, CreateValidMask) {
+    int width = 24;
+    int height = 8;
+    geometry::Image depth = CreateStepDepth(width, height);
+    *depth.PointerAt<float>(20, 2) = 0.0f;
+    *depth.PointerAt<float>(21, 5) = 5.0f;
+
+    geometry::DepthPreprocessor preprocessor(0.0, 4.0, 0.05, 1);
+    auto mask = preprocessor.CreateValidMask(depth);
+    EXPECT_EQ(width, mask->width_);
+    EXPECT_EQ(height, mask->height_);
+    EXPECT_EQ(1, mask->num_of_channels_);
+    EXPECT_EQ(1, mask->bytes_per_channel_);
+    for (int u = 0; u < width; u++) {
+        // The columns 7, 8, 15 and 16 are at the discontinuities, the
+        // dilation adds one column on both sides.
+        bool near_step = (u >= 6 && u <= 9) || (u >= 14 && u <= 17);
+        EXPECT_EQ(near_step ? 0 : 255, *mask->PointerAt<uint8_t>(u, 4));
+    }
+    // Missing and out of range depth is invalid, but not a discontinuity.
+    EXPECT_EQ(0, *mask->PointerAt<uint8_t>(20, 2));
+    EXPECT_EQ(255, *mask->PointerAt<uint8_t>(21, 2));
+    EXPECT_EQ(0, *mask->PointerAt<uint8_t>(21, 5));
+    EXPECT_EQ(255, *mask->PointerAt<uint8_t>(22, 5));
+
+    preprocessor.discontinuity_dilation_ = 0;
+    mask = preprocessor.CreateValidMask(depth);
+    for (int u = 0; u < width; u++) {
+        bool at_step = u == 7 || u == 8 || u == 15 || u == 16;
+        EXPECT_EQ(at_step ? 0 : 255, *mask->PointerAt<uint8_t>(u, 4));
+    }
+
+    preprocessor.depth_max_ = 1.5;
+    mask = preprocessor.CreateValidMask(depth);
+    for (int u = 0; u < width; u++) {
+        // The wall is out of range, so the box has no discontinuities.
+        bool on_box = u >= 8 && u < 16;
+        EXPECT_EQ(on_box ? 255 : 0, *mask->PointerAt<uint8_t>(u, 4));
+    }
+
+    geometry::Image color;
+    color.Prepare(width, height, 3, 1);
+    EXPECT_TRUE(preprocessor.CreateValidMask(color)->IsEmpty());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(DepthPreprocessor, Process) {
+    int width = 24;
+    int height = 8;
+    geometry::Image depth = CreateStepDepth(width, height);
+    for (int v = 0; v < height; v++) {
+        for (int u = 0; u < width; u++) {
+            *depth.PointerAt<float>(u, v) +=
+                    ((u + v) % 2 == 0) ? 0.004f : -0.004f;
+        }
+    }
+
+    geometry::DepthPreprocessor preprocessor;
+    auto mask = preprocessor.CreateValidMask(depth);
+    auto output = preprocessor.Process(depth);
+    EXPECT_EQ(width, output->width_);
+    EXPECT_EQ(height, output->height_);
+    EXPECT_EQ(1, output->num_of_channels_);
+    EXPECT_EQ(4, output->bytes_per_channel_);
+    for (int v = 0; v < height; v++) {
+        for (int u = 0; u < width; u++) {
+            float value = *output->PointerAt<float>(u, v);
+            if (*mask->PointerAt<uint8_t>(u, v) == 0) {
+                EXPECT_EQ(0.0f, value);
+            } else {
+                float expected = (u >= 8 && u < 16) ? 1.0f : 2.0f;
+                EXPECT_LT(std::abs(value - expected), 0.004f);
+            }
+        }
+    }
+
+    // Without the filter the valid depth is kept as it is.
+    preprocessor.bilateral_half_kernel_size_ = 0;
+    output = preprocessor.Process(depth);
+    for (int u = 0; u < width; u++) {
+        float expected = *mask->PointerAt<uint8_t>(u, 4) != 0
+                                 ? *depth.PointerAt<float>(u, 4)
+                                 : 0.0f;
+        EXPECT_EQ(expected, *output->PointerAt<float>(u, 4));
+    }
+
+    geometry::RGBDImage rgbd;
+    rgbd.depth_ = depth;
+    rgbd.color_.Prepare(width, height, 3, 1);
+    rgbd.color_.data_[0] = 7;
+    auto rgbd_output = preprocessor.Process(rgbd);
+    ExpectEQ(rgbd.color_.data_, rgbd_output->color_.data_);
+    ExpectEQ(output->data_, rgbd_output->depth_.data_);
+}
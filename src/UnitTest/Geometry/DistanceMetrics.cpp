@@ -0,0 +1,157 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include "Open3D/Geometry/DistanceMetrics.h"
+#include "Open3D/Geometry/IntersectionTest.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/TriangleMesh.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(DistanceMetrics, PointCloud) {
+    geometry::PointCloud reference;
+    reference.points_.resize(1000);
+    Rand(reference.points_, Vector3d(0, 0, 0), Vector3d(1, 1, 1), 0);
+    geometry::PointCloud query;
+    query.points_.resize(700);
+    Rand(query.points_, Vector3d(0.1, 0, 0), Vector3d(1.2, 1, 1), 1);
+
+    vector<double> thresholds = {0.02, 0.05, 0.1};
+    geometry::DistanceMetrics metrics;
+    EXPECT_TRUE(metrics.SetReference(reference));
+    auto result = metrics.Compute(query, thresholds);
+
+    vector<double> forward = query.ComputePointCloudDistance(reference);
+    vector<double> backward = reference.ComputePointCloudDistance(query);
+    ExpectEQ(forward, metrics.ComputeDistance(query.points_));
+
+    double chamfer = 0.0, hausdorff = 0.0;
+    for (double d : forward) {
+        chamfer += d / forward.size();
+        hausdorff = max(hausdorff, d);
+    }
+    for (double d : backward) {
+        chamfer += d / backward.size();
+        hausdorff = max(hausdorff, d);
+    }
+    EXPECT_NEAR(chamfer, result.chamfer_distance_, 1e-9);
+    EXPECT_EQ(hausdorff, result.hausdorff_distance_);
+
+    ExpectEQ(thresholds, result.thresholds_);
+    EXPECT_EQ(thresholds.size(), result.fscore_.size());
+    for (size_t t = 0; t < thresholds.size(); t++) {
+        double precision =
+                double(count_if(forward.begin(), forward.end(),
+                                [&](double d) { return d < thresholds[t]; })) /
+                forward.size();
+        double recall =
+                double(count_if(backward.begin(), backward.end(),
+                                [&](double d) { return d < thresholds[t]; })) /
+                backward.size();
+        EXPECT_EQ(precision, result.precision_[t]);
+        EXPECT_EQ(recall, result.recall_[t]);
+        EXPECT_NEAR(2 * precision * recall / (precision + recall),
+                    result.fscore_[t], 1e-12);
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(DistanceMetrics, PointCloudWithNaN) {
+    geometry::PointCloud reference;
+    reference.points_.resize(200);
+    Rand(reference.points_, Vector3d(0, 0, 0), Vector3d(1, 1, 1), 0);
+    geometry::PointCloud query;
+    query.points_.resize(100);
+    Rand(query.points_, Vector3d(0, 0, 0), Vector3d(1, 1, 1), 1);
+    query.points_[10] = Vector3d::Constant(numeric_limits<double>::quiet_NaN());
+
+    geometry::DistanceMetrics metrics;
+    EXPECT_TRUE(metrics.SetReference(reference));
+    auto result = metrics.Compute(query, {0.05});
+
+    // The NaN point counts as ComputeDistance reports it.
+    vector<double> forward = metrics.ComputeDistance(query.points_);
+    double forward_sum = 0.0;
+    for (double d : forward) {
+        EXPECT_FALSE(std::isnan(d));
+        forward_sum += d;
+    }
+    EXPECT_FALSE(std::isnan(result.chamfer_distance_));
+    EXPECT_FALSE(std::isnan(result.hausdorff_distance_));
+    double precision =
+            double(count_if(forward.begin(), forward.end(),
+                            [](double d) { return d < 0.05; })) /
+            forward.size();
+    EXPECT_EQ(precision, result.precision_[0]);
+    EXPECT_LE(forward_sum / forward.size(), result.chamfer_distance_);
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(DistanceMetrics, TriangleMesh) {
+    auto mesh = geometry::TriangleMesh::CreateSphere(1.0, 10);
+    geometry::PointCloud query;
+    query.points_.resize(500);
+    Rand(query.points_, Vector3d(-1.5, -1.5, -1.5), Vector3d(1.5, 1.5, 1.5),
+         0);
+
+    geometry::DistanceMetrics metrics;
+    EXPECT_TRUE(metrics.SetReference(*mesh, 5000));
+    vector<double> distances = metrics.ComputeDistance(query.points_);
+    for (size_t i = 0; i < query.points_.size(); i++) {
+        double expected = numeric_limits<double>::infinity();
+        for (const auto &triangle : mesh->triangles_) {
+            expected = min(expected,
+                           geometry::IntersectionTest::
+                                   PointTriangleMinimumDistance(
+                                           query.points_[i],
+                                           mesh->vertices_[triangle(0)],
+                                           mesh->vertices_[triangle(1)],
+                                           mesh->vertices_[triangle(2)]));
+        }
+        EXPECT_NEAR(expected, distances[i], 1e-12);
+    }
+
+    // Points sampled on the mesh are on its surface.
+    auto samples = mesh->SamplePointsUniformly(1000);
+    auto result = metrics.Compute(*samples, {0.01});
+    EXPECT_NEAR(0.0, result.chamfer_distance_, 0.1);
+    EXPECT_EQ(1.0, result.precision_[0]);
+    EXPECT_GT(result.recall_[0], 0.0);
+    EXPECT_LE(result.recall_[0], 1.0);
+
+    geometry::TriangleMesh empty;
+    EXPECT_FALSE(metrics.SetReference(empty, 100));
+}
@@ -0,0 +1,94 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <algorithm>
+
+#include "Open3D/Geometry/FixedRadiusGrid.h"
+#include "Open3D/Geometry/KDTreeFlann.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FixedRadiusGrid, ForEachNeighbor) {
+    int size = 2000;
+
+    geometry::PointCloud pc;
+
+    Vector3d vmin(0.0, 0.0, 0.0);
+    Vector3d vmax(10.0, 10.0, 10.0);
+
+    pc.points_.resize(size);
+    Rand(pc.points_, vmin, vmax, 0);
+
+    geometry::KDTreeFlann kdtree(pc);
+
+    for (double radius : {0.5, 1.3, 20.0}) {
+        geometry::FixedRadiusGrid grid;
+        EXPECT_TRUE(grid.SetPoints(pc.points_, radius));
+
+        vector<vector<int>> neighbors(size);
+        grid.ForEachNeighbor([](int) { return true; },
+                             [&](int i, int j, double) {
+                                 neighbors[i].push_back(j);
+                             });
+
+        for (int i = 0; i < size; i++) {
+            vector<int> indices;
+            vector<double> distance2;
+            kdtree.SearchRadius(pc.points_[i], radius, indices, distance2);
+            sort(indices.begin(), indices.end());
+            sort(neighbors[i].begin(), neighbors[i].end());
+            ExpectEQ(indices, neighbors[i]);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FixedRadiusGrid, SetPoints) {
+    vector<Vector3d> points = {{0.0, 0.0, 0.0}, {0.5, 0.0, 0.0}};
+    geometry::FixedRadiusGrid grid;
+
+    EXPECT_FALSE(grid.SetPoints(points, 0.0));
+    EXPECT_EQ(0, grid.NumCells());
+
+    EXPECT_TRUE(grid.SetPoints(vector<Vector3d>(), 1.0));
+    EXPECT_EQ(0, grid.NumCells());
+
+    EXPECT_TRUE(grid.SetPoints(points, 1.0));
+    EXPECT_EQ(1, grid.NumCells());
+
+    EXPECT_TRUE(grid.SetPoints(points, 0.1));
+    EXPECT_EQ(2, grid.NumCells());
+}
@@ -1016,3 +1016,46 @@ TEST(Image, CreatePyramid) {
         expected_height /= 2;
     }
 }
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Image, FilterBilateral) {
+    int width = 16;
+    int height = 8;
+    geometry::Image image;
+    image.Prepare(width, height, 1, 4);
+    // A step from 1 to 2 with small noise and a pixel without depth.
+    for (int v = 0; v < height; v++) {
+        for (int u = 0; u < width; u++) {
+            float step = u < width / 2 ? 1.0f : 2.0f;
+            float noise = ((u + v) % 2 == 0) ? 0.005f : -0.005f;
+            *image.PointerAt<float>(u, v) = step + noise;
+        }
+    }
+    *image.PointerAt<float>(3, 3) = 0.0f;
+
+    auto output = image.FilterBilateral(2, 1.5, 0.03);
+    EXPECT_FALSE(output->IsEmpty());
+    EXPECT_EQ(width, output->width_);
+    EXPECT_EQ(height, output->height_);
+    EXPECT_EQ(1, output->num_of_channels_);
+    EXPECT_EQ(4, output->bytes_per_channel_);
+
+    EXPECT_EQ(0.0f, *output->PointerAt<float>(3, 3));
+    for (int v = 0; v < height; v++) {
+        for (int u = 0; u < width; u++) {
+            if (u == 3 && v == 3) continue;
+            float expected = u < width / 2 ? 1.0f : 2.0f;
+            float value = *output->PointerAt<float>(u, v);
+            // The noise is smoothed and the step is kept.
+            EXPECT_LT(std::abs(value - expected), 0.005f);
+        }
+    }
+    EXPECT_NEAR(1.0f, *output->PointerAt<float>(width / 2 - 1, 4), 0.002f);
+    EXPECT_NEAR(2.0f, *output->PointerAt<float>(width / 2, 4), 0.002f);
+
+    geometry::Image color;
+    color.Prepare(width, height, 3, 1);
+    EXPECT_TRUE(color.FilterBilateral()->IsEmpty());
+}
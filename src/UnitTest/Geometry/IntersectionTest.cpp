@@ -96,3 +96,42 @@ TEST(IntersectionTest, LineSegmentsMinimumDistance) {
                                                                       q0, q1),
               1.);
 }
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(IntersectionTest, PointTriangleMinimumDistance) {
+    Eigen::Vector3d p0(0, 0, 0);
+    Eigen::Vector3d p1(2, 0, 0);
+    Eigen::Vector3d p2(0, 2, 0);
+
+    // face, vertex and edge regions
+    ExpectEQ(geometry::IntersectionTest::PointTriangleClosestPoint(
+                     Eigen::Vector3d(0.5, 0.5, 3), p0, p1, p2),
+             Eigen::Vector3d(0.5, 0.5, 0));
+    ExpectEQ(geometry::IntersectionTest::PointTriangleClosestPoint(
+                     Eigen::Vector3d(-1, -1, 0), p0, p1, p2),
+             p0);
+    ExpectEQ(geometry::IntersectionTest::PointTriangleClosestPoint(
+                     Eigen::Vector3d(3, -1, 1), p0, p1, p2),
+             p1);
+    ExpectEQ(geometry::IntersectionTest::PointTriangleClosestPoint(
+                     Eigen::Vector3d(-1, 3, 0), p0, p1, p2),
+             p2);
+    ExpectEQ(geometry::IntersectionTest::PointTriangleClosestPoint(
+                     Eigen::Vector3d(1, -1, 0), p0, p1, p2),
+             Eigen::Vector3d(1, 0, 0));
+    ExpectEQ(geometry::IntersectionTest::PointTriangleClosestPoint(
+                     Eigen::Vector3d(-1, 1, 0), p0, p1, p2),
+             Eigen::Vector3d(0, 1, 0));
+    ExpectEQ(geometry::IntersectionTest::PointTriangleClosestPoint(
+                     Eigen::Vector3d(2, 2, 0), p0, p1, p2),
+             Eigen::Vector3d(1, 1, 0));
+
+    EXPECT_NEAR(geometry::IntersectionTest::PointTriangleMinimumDistance(
+                        Eigen::Vector3d(0.5, 0.5, -3), p0, p1, p2),
+                3.0, 1e-12);
+    EXPECT_NEAR(geometry::IntersectionTest::PointTriangleMinimumDistance(
+                        Eigen::Vector3d(2, 2, 0), p0, p1, p2),
+                std::sqrt(2.0), 1e-12);
+}
@@ -25,10 +25,13 @@
 // ----------------------------------------------------------------------------
 
 #include <algorithm>
+#include <tuple>
 
 #include "Open3D/Camera/PinholeCameraIntrinsic.h"
 #include "Open3D/Geometry/Image.h"
+#include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/PointCloudNeighborhoods.h"
 #include "Open3D/Geometry/RGBDImage.h"
 #include "TestUtility/UnitTest.h"
 
@@ -697,6 +700,65 @@ TEST(PointCloud, EstimateNormals) {
     ExpectEQ(ref, pc.normals_);
 }
 
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(PointCloud, EstimateNormalsFromNeighborhoods) {
+    size_t size = 500;
+    geometry::PointCloud pc;
+
+    pc.points_.resize(size);
+    Rand(pc.points_, Vector3d(0.0, 0.0, 0.0), Vector3d(10.0, 10.0, 10.0), 0);
+
+    geometry::KDTreeSearchParamHybrid param(2.0, 20);
+    geometry::PointCloudNeighborhoods neighborhoods(pc, param);
+    for (bool fast_normal_computation : {true, false}) {
+        geometry::PointCloud ref = pc;
+        ref.EstimateNormals(param, fast_normal_computation);
+
+        geometry::PointCloud output = pc;
+        vector<double> curvatures;
+        EXPECT_TRUE(output.EstimateNormals(neighborhoods, curvatures,
+                                           fast_normal_computation));
+        ExpectEQ(ref.normals_, output.normals_);
+        EXPECT_EQ(size, curvatures.size());
+        for (double curvature : curvatures) {
+            EXPECT_GE(curvature, 0.0);
+            EXPECT_LE(curvature, 1.0 / 3.0 + 1e-12);
+        }
+
+        // orientation of existing normals is kept
+        output.normals_ = ref.normals_;
+        for (auto &normal : output.normals_) {
+            normal *= -1.0;
+        }
+        EXPECT_TRUE(output.EstimateNormals(neighborhoods,
+                                           fast_normal_computation));
+        for (size_t i = 0; i < size; i++) {
+            ExpectEQ(Vector3d(-ref.normals_[i]), output.normals_[i]);
+        }
+    }
+
+    // points on a plane have zero surface variation
+    geometry::PointCloud plane;
+    for (int x = 0; x < 10; x++) {
+        for (int y = 0; y < 10; y++) {
+            plane.points_.push_back(Vector3d(x, y, 2.0));
+        }
+    }
+    vector<double> curvatures;
+    EXPECT_TRUE(plane.EstimateNormals(
+            geometry::PointCloudNeighborhoods(
+                    plane, geometry::KDTreeSearchParamKNN(8)),
+            curvatures));
+    for (size_t i = 0; i < plane.points_.size(); i++) {
+        EXPECT_NEAR(0.0, curvatures[i], 1e-12);
+        EXPECT_NEAR(1.0, std::abs(plane.normals_[i](2)), 1e-12);
+    }
+
+    EXPECT_FALSE(pc.EstimateNormals(geometry::PointCloudNeighborhoods()));
+}
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -798,6 +860,36 @@ TEST(PointCloud, OrientNormalsTowardsCameraLocation) {
     ExpectEQ(ref, pc.normals_);
 }
 
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(PointCloud, OrientNormalsConsistentTangentPlane) {
+    // two evenly sampled spheres with normals pointing randomly in or out
+    geometry::PointCloud pc;
+    vector<Vector3d> centers = {{0.0, 0.0, 0.0}, {5.0, 0.0, 0.0}};
+    int size = 1000;
+    for (const auto &center : centers) {
+        for (int i = 0; i < size; i++) {
+            double z = 1.0 - (2.0 * i + 1.0) / size;
+            double r = sqrt(1.0 - z * z);
+            double phi = i * M_PI * (3.0 - sqrt(5.0));
+            Vector3d normal(r * cos(phi), r * sin(phi), z);
+            pc.points_.push_back(center + normal);
+            pc.normals_.push_back(i % 3 == 0 ? -normal : normal);
+        }
+    }
+
+    EXPECT_TRUE(pc.OrientNormalsConsistentTangentPlane(10));
+    for (size_t i = 0; i < pc.points_.size(); i++) {
+        const Vector3d &center = centers[i / size];
+        EXPECT_GT(pc.normals_[i].dot(pc.points_[i] - center), 0.0);
+    }
+
+    EXPECT_FALSE(pc.OrientNormalsConsistentTangentPlane(0));
+    pc.normals_.clear();
+    EXPECT_FALSE(pc.OrientNormalsConsistentTangentPlane(10));
+}
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -1135,3 +1227,217 @@ TEST(PointCloud, CreatePointCloudFromRGBDImage_1_4) {
                                        color_bytes_per_channel, ref_points,
                                        ref_colors);
 }
+
+// ----------------------------------------------------------------------------
+// Sequential DBSCAN that grows one cluster at a time from precomputed
+// neighbourhoods, used as reference for PointCloud::ClusterDBSCAN.
+// ----------------------------------------------------------------------------
+vector<int> ReferenceDBSCAN(const geometry::PointCloud &pc,
+                            double eps,
+                            size_t min_points) {
+    geometry::KDTreeFlann kdtree(pc);
+    vector<vector<int>> nbs(pc.points_.size());
+    for (size_t idx = 0; idx < pc.points_.size(); ++idx) {
+        vector<double> dists2;
+        kdtree.SearchRadius(pc.points_[idx], eps, nbs[idx], dists2);
+    }
+
+    vector<int> labels(pc.points_.size(), -2);
+    int cluster_label = 0;
+    for (size_t idx = 0; idx < pc.points_.size(); ++idx) {
+        if (labels[idx] != -2) {
+            continue;
+        }
+        if (nbs[idx].size() < min_points) {
+            labels[idx] = -1;
+            continue;
+        }
+        labels[idx] = cluster_label;
+        vector<int> queue(nbs[idx].begin(), nbs[idx].end());
+        while (!queue.empty()) {
+            int nb = queue.back();
+            queue.pop_back();
+            if (labels[nb] == -1) {
+                labels[nb] = cluster_label;
+            }
+            if (labels[nb] != -2) {
+                continue;
+            }
+            labels[nb] = cluster_label;
+            if (nbs[nb].size() >= min_points) {
+                queue.insert(queue.end(), nbs[nb].begin(), nbs[nb].end());
+            }
+        }
+        cluster_label++;
+    }
+    return labels;
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(PointCloud, ClusterDBSCAN) {
+    geometry::PointCloud pc;
+
+    // dense blobs with sparse points in between
+    vector<Vector3d> centers(6);
+    Rand(centers, Vector3d(0.0, 0.0, 0.0), Vector3d(10.0, 10.0, 10.0), 0);
+    for (size_t c = 0; c < centers.size(); c++) {
+        vector<Vector3d> blob(300);
+        Rand(blob, Vector3d(-1.0, -1.0, -1.0), Vector3d(1.0, 1.0, 1.0),
+             int(c) + 1);
+        for (auto &point : blob) {
+            pc.points_.push_back(centers[c] + point);
+        }
+    }
+    vector<Vector3d> sparse(500);
+    Rand(sparse, Vector3d(0.0, 0.0, 0.0), Vector3d(10.0, 10.0, 10.0), 7);
+    pc.points_.insert(pc.points_.end(), sparse.begin(), sparse.end());
+
+    for (double eps : {0.2, 0.35, 0.8}) {
+        for (size_t min_points : {1, 4, 10}) {
+            vector<int> ref_labels = ReferenceDBSCAN(pc, eps, min_points);
+            vector<int> labels = pc.ClusterDBSCAN(eps, min_points);
+            ExpectEQ(ref_labels, labels);
+        }
+    }
+
+    EXPECT_TRUE(geometry::PointCloud().ClusterDBSCAN(0.1, 1).empty());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(PointCloud, ClusterDBSCANTinyEps) {
+    geometry::PointCloud pc;
+    pc.points_.resize(400);
+    Rand(pc.points_, Vector3d(0.0, 0.0, 0.0), Vector3d(1.0, 1.0, 1.0), 0);
+    // Far away points make eps too small for a grid over the extent, so the
+    // neighbours are searched with a KD-tree instead.
+    pc.points_.push_back(Vector3d(1e7, 1e7, 1e7));
+    pc.points_.push_back(Vector3d(1e7, 1e7, 1e7 + 0.05));
+    pc.points_.push_back(Vector3d(-1e7, 0.0, 1e7));
+
+    for (size_t min_points : {1, 2, 4}) {
+        vector<int> ref_labels = ReferenceDBSCAN(pc, 0.15, min_points);
+        vector<int> labels = pc.ClusterDBSCAN(0.15, min_points);
+        ExpectEQ(ref_labels, labels);
+    }
+    vector<int> labels = pc.ClusterDBSCAN(0.15, 2);
+    EXPECT_NE(-1, labels[400]);
+    EXPECT_EQ(labels[400], labels[401]);
+    EXPECT_EQ(-1, labels[402]);
+
+    ExpectEQ(vector<int>(pc.points_.size(), -1), pc.ClusterDBSCAN(0.0, 1));
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(PointCloud, SelectDownSampleByMask) {
+    size_t size = 100;
+    geometry::PointCloud pc;
+
+    pc.points_.resize(size);
+    pc.normals_.resize(size);
+    pc.colors_.resize(size);
+    Rand(pc.points_, Vector3d(0.0, 0.0, 0.0), Vector3d(10.0, 10.0, 10.0), 0);
+    Rand(pc.normals_, Vector3d(-1.0, -1.0, -1.0), Vector3d(1.0, 1.0, 1.0), 1);
+    Rand(pc.colors_, Vector3d(0.0, 0.0, 0.0), Vector3d(1.0, 1.0, 1.0), 2);
+
+    vector<bool> mask(size);
+    vector<size_t> indices;
+    for (size_t i = 0; i < size; i++) {
+        mask[i] = pc.points_[i](0) < 4.0;
+        if (mask[i]) {
+            indices.push_back(i);
+        }
+    }
+
+    for (bool invert : {false, true}) {
+        auto ref = pc.SelectDownSample(indices, invert);
+        auto output = pc.SelectDownSampleByMask(mask, invert);
+        ExpectEQ(ref->points_, output->points_);
+        ExpectEQ(ref->normals_, output->normals_);
+        ExpectEQ(ref->colors_, output->colors_);
+    }
+
+    EXPECT_FALSE(pc.SelectDownSampleByMask(vector<bool>(size - 1))
+                         ->HasPoints());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(PointCloud, RemoveRadiusOutliers) {
+    size_t size = 1000;
+    geometry::PointCloud pc;
+
+    pc.points_.resize(size);
+    pc.colors_.resize(size);
+    Rand(pc.points_, Vector3d(0.0, 0.0, 0.0), Vector3d(10.0, 10.0, 10.0), 0);
+    Rand(pc.colors_, Vector3d(0.0, 0.0, 0.0), Vector3d(1.0, 1.0, 1.0), 1);
+
+    geometry::KDTreeFlann kdtree(pc);
+    for (double radius : {0.8, 1.5}) {
+        for (size_t nb_points : {2, 8}) {
+            vector<size_t> ref_indices;
+            for (size_t i = 0; i < size; i++) {
+                vector<int> indices;
+                vector<double> distance2;
+                if (size_t(kdtree.SearchRadius(pc.points_[i], radius, indices,
+                                               distance2)) > nb_points) {
+                    ref_indices.push_back(i);
+                }
+            }
+
+            shared_ptr<geometry::PointCloud> output;
+            vector<size_t> indices;
+            tie(output, indices) = pc.RemoveRadiusOutliers(nb_points, radius);
+            EXPECT_EQ(ref_indices, indices);
+
+            auto ref = pc.SelectDownSample(ref_indices);
+            ExpectEQ(ref->points_, output->points_);
+            ExpectEQ(ref->colors_, output->colors_);
+
+            vector<bool> mask = pc.ComputeRadiusInlierMask(nb_points, radius);
+            EXPECT_EQ(size, mask.size());
+            for (size_t i = 0; i < size; i++) {
+                EXPECT_EQ(mask[i], binary_search(ref_indices.begin(),
+                                                 ref_indices.end(), i));
+            }
+        }
+    }
+
+    EXPECT_TRUE(pc.ComputeRadiusInlierMask(0, 1.0).empty());
+    EXPECT_TRUE(pc.ComputeRadiusInlierMask(2, 0.0).empty());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(PointCloud, RemoveStatisticalOutliers) {
+    size_t size = 1000;
+    geometry::PointCloud pc;
+
+    pc.points_.resize(size);
+    Rand(pc.points_, Vector3d(0.0, 0.0, 0.0), Vector3d(1.0, 1.0, 1.0), 0);
+    pc.points_.push_back(Vector3d(5.0, 5.0, 5.0));
+
+    shared_ptr<geometry::PointCloud> output;
+    vector<size_t> indices;
+    tie(output, indices) = pc.RemoveStatisticalOutliers(10, 2.0);
+
+    EXPECT_FALSE(indices.empty());
+    EXPECT_EQ(indices.size(), output->points_.size());
+    EXPECT_TRUE(is_sorted(indices.begin(), indices.end()));
+    EXPECT_NE(size, indices.back());
+
+    vector<bool> mask = pc.ComputeStatisticalInlierMask(10, 2.0);
+    EXPECT_EQ(pc.points_.size(), mask.size());
+    ExpectEQ(pc.SelectDownSample(indices)->points_,
+             pc.SelectDownSampleByMask(mask)->points_);
+    EXPECT_EQ(indices.size(), size_t(count(mask.begin(), mask.end(), true)));
+
+    EXPECT_TRUE(pc.ComputeStatisticalInlierMask(0, 1.0).empty());
+}
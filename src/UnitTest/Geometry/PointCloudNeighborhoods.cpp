@@ -0,0 +1,105 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <algorithm>
+
+#include "Open3D/Geometry/KDTreeFlann.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/PointCloudNeighborhoods.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(PointCloudNeighborhoods, ComputeMortonOrder) {
+    int size = 1000;
+
+    vector<Vector3d> points(size);
+    Rand(points, Vector3d(0.0, 0.0, 0.0), Vector3d(10.0, 10.0, 10.0), 0);
+
+    vector<int> order = geometry::ComputeMortonOrder(points);
+    EXPECT_EQ(size, int(order.size()));
+    sort(order.begin(), order.end());
+    for (int i = 0; i < size; i++) {
+        EXPECT_EQ(i, order[i]);
+    }
+
+    // z is the most significant axis of the interleaved code, then y and x
+    vector<Vector3d> corners = {{1.0, 1.0, 1.0}, {0.0, 0.0, 0.0},
+                                {1.0, 0.0, 0.0}, {0.0, 1.0, 1.0},
+                                {0.1, 0.0, 0.0}, {0.0, 0.0, 1.0}};
+    vector<int> ref_order = {1, 4, 2, 5, 3, 0};
+    EXPECT_EQ(ref_order, geometry::ComputeMortonOrder(corners));
+
+    EXPECT_TRUE(geometry::ComputeMortonOrder(vector<Vector3d>()).empty());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(PointCloudNeighborhoods, Compute) {
+    int size = 1000;
+
+    geometry::PointCloud pc;
+    pc.points_.resize(size);
+    Rand(pc.points_, Vector3d(0.0, 0.0, 0.0), Vector3d(10.0, 10.0, 10.0), 0);
+
+    geometry::KDTreeFlann kdtree(pc);
+
+    vector<shared_ptr<geometry::KDTreeSearchParam>> params = {
+            make_shared<geometry::KDTreeSearchParamKNN>(12),
+            make_shared<geometry::KDTreeSearchParamRadius>(1.0),
+            make_shared<geometry::KDTreeSearchParamHybrid>(1.0, 5)};
+    for (const auto &param : params) {
+        geometry::PointCloudNeighborhoods neighborhoods(pc, *param);
+        EXPECT_EQ(size_t(size), neighborhoods.Size());
+        EXPECT_EQ(neighborhoods.indices_.size(),
+                  neighborhoods.distance2_.size());
+        for (int i = 0; i < size; i++) {
+            vector<int> indices;
+            vector<double> distance2;
+            int count = kdtree.Search(pc.points_[i], *param, indices,
+                                      distance2);
+            EXPECT_EQ(count, neighborhoods.NumNeighbors(i));
+            ExpectEQ(indices,
+                     vector<int>(neighborhoods.Indices(i),
+                                 neighborhoods.Indices(i) + count));
+            ExpectEQ(distance2,
+                     vector<double>(neighborhoods.Distance2(i),
+                                    neighborhoods.Distance2(i) + count));
+        }
+    }
+
+    geometry::PointCloudNeighborhoods neighborhoods;
+    EXPECT_TRUE(neighborhoods.Compute(geometry::PointCloud(),
+                                      geometry::KDTreeSearchParamKNN()));
+    EXPECT_EQ(0u, neighborhoods.Size());
+}
@@ -25,9 +25,24 @@
 // ----------------------------------------------------------------------------
 
 #include "Open3D/Geometry/TriangleMesh.h"
+#include "Open3D/Geometry/DistanceMetrics.h"
 #include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/IO/ClassIO/TriangleMeshIO.h"
+#include "Open3D/Utility/Helper.h"
 #include "TestUtility/UnitTest.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace Eigen;
 using namespace open3d;
 using namespace std;
@@ -668,6 +683,301 @@ TEST(TriangleMesh, Purge) {
     ExpectEQ(ref_triangle_normals, tm.triangle_normals_);
 }
 
+namespace {
+
+// The hash map based cleanup of TriangleMesh before it was parallelized.
+void RemoveDuplicatedVerticesBaseline(geometry::TriangleMesh& mesh) {
+    typedef std::tuple<double, double, double> Coordinate3;
+    std::unordered_map<Coordinate3, size_t,
+                       utility::hash_tuple::hash<Coordinate3>>
+            point_to_old_index;
+    std::vector<int> index_old_to_new(mesh.vertices_.size());
+    size_t k = 0;
+    for (size_t i = 0; i < mesh.vertices_.size(); i++) {
+        const Vector3d& vertex = mesh.vertices_[i];
+        Coordinate3 coord = std::make_tuple(vertex(0), vertex(1), vertex(2));
+        if (point_to_old_index.find(coord) == point_to_old_index.end()) {
+            point_to_old_index[coord] = i;
+            mesh.vertices_[k] = mesh.vertices_[i];
+            mesh.vertex_colors_[k] = mesh.vertex_colors_[i];
+            index_old_to_new[i] = (int)k;
+            k++;
+        } else {
+            index_old_to_new[i] = index_old_to_new[point_to_old_index[coord]];
+        }
+    }
+    mesh.vertices_.resize(k);
+    mesh.vertex_colors_.resize(k);
+    for (auto& triangle : mesh.triangles_) {
+        for (int i = 0; i < 3; i++) {
+            triangle(i) = index_old_to_new[triangle(i)];
+        }
+    }
+}
+
+void RemoveDuplicatedTrianglesBaseline(geometry::TriangleMesh& mesh) {
+    typedef std::tuple<int, int, int> Index3;
+    std::unordered_map<Index3, size_t, utility::hash_tuple::hash<Index3>>
+            triangle_to_old_index;
+    size_t k = 0;
+    for (size_t i = 0; i < mesh.triangles_.size(); i++) {
+        const Vector3i& t = mesh.triangles_[i];
+        Index3 index;
+        if (t(0) <= t(1)) {
+            if (t(0) <= t(2)) {
+                index = std::make_tuple(t(0), t(1), t(2));
+            } else {
+                index = std::make_tuple(t(2), t(0), t(1));
+            }
+        } else {
+            if (t(1) <= t(2)) {
+                index = std::make_tuple(t(1), t(2), t(0));
+            } else {
+                index = std::make_tuple(t(2), t(0), t(1));
+            }
+        }
+        if (triangle_to_old_index.find(index) == triangle_to_old_index.end()) {
+            triangle_to_old_index[index] = i;
+            mesh.triangles_[k] = mesh.triangles_[i];
+            k++;
+        }
+    }
+    mesh.triangles_.resize(k);
+}
+
+void RemoveUnreferencedVerticesBaseline(geometry::TriangleMesh& mesh) {
+    std::vector<bool> vertex_has_reference(mesh.vertices_.size(), false);
+    for (const auto& triangle : mesh.triangles_) {
+        vertex_has_reference[triangle(0)] = true;
+        vertex_has_reference[triangle(1)] = true;
+        vertex_has_reference[triangle(2)] = true;
+    }
+    std::vector<int> index_old_to_new(mesh.vertices_.size());
+    size_t k = 0;
+    for (size_t i = 0; i < mesh.vertices_.size(); i++) {
+        if (vertex_has_reference[i]) {
+            mesh.vertices_[k] = mesh.vertices_[i];
+            mesh.vertex_colors_[k] = mesh.vertex_colors_[i];
+            index_old_to_new[i] = (int)k;
+            k++;
+        } else {
+            index_old_to_new[i] = -1;
+        }
+    }
+    mesh.vertices_.resize(k);
+    mesh.vertex_colors_.resize(k);
+    for (auto& triangle : mesh.triangles_) {
+        for (int i = 0; i < 3; i++) {
+            triangle(i) = index_old_to_new[triangle(i)];
+        }
+    }
+}
+
+// The hash map based SimplifyVertexClustering with average contraction before
+// it was parallelized. Its triangles come out in hash order.
+std::shared_ptr<geometry::TriangleMesh> SimplifyVertexClusteringBaseline(
+        const geometry::TriangleMesh& input, double voxel_size) {
+    auto mesh = std::make_shared<geometry::TriangleMesh>();
+    Vector3d voxel_size3(voxel_size, voxel_size, voxel_size);
+    Vector3d voxel_min_bound = input.GetMinBound() - voxel_size3 * 0.5;
+    auto GetVoxelIdx = [&](const Vector3d& vert) {
+        Vector3d ref_coord = (vert - voxel_min_bound) / voxel_size;
+        return Vector3i(int(floor(ref_coord(0))), int(floor(ref_coord(1))),
+                        int(floor(ref_coord(2))));
+    };
+    std::unordered_map<Vector3i, std::unordered_set<int>,
+                       utility::hash_eigen::hash<Vector3i>>
+            voxel_vertices;
+    std::unordered_map<Vector3i, int, utility::hash_eigen::hash<Vector3i>>
+            voxel_vert_ind;
+    int new_vidx = 0;
+    for (size_t vidx = 0; vidx < input.vertices_.size(); ++vidx) {
+        const Vector3i vox_idx = GetVoxelIdx(input.vertices_[vidx]);
+        voxel_vertices[vox_idx].insert(int(vidx));
+        if (voxel_vert_ind.count(vox_idx) == 0) {
+            voxel_vert_ind[vox_idx] = new_vidx;
+            new_vidx++;
+        }
+    }
+    mesh->vertices_.resize(voxel_vertices.size());
+    mesh->vertex_colors_.resize(voxel_vertices.size());
+    for (const auto& voxel : voxel_vertices) {
+        int vox_vidx = voxel_vert_ind[voxel.first];
+        Vector3d vertex(0, 0, 0);
+        Vector3d color(0, 0, 0);
+        for (int vidx : voxel.second) {
+            vertex += input.vertices_[vidx];
+            color += input.vertex_colors_[vidx];
+        }
+        mesh->vertices_[vox_vidx] = vertex / double(voxel.second.size());
+        mesh->vertex_colors_[vox_vidx] = color / double(voxel.second.size());
+    }
+    std::unordered_set<Vector3i, utility::hash_eigen::hash<Vector3i>>
+            triangles;
+    for (const auto& triangle : input.triangles_) {
+        int vidx0 = voxel_vert_ind[GetVoxelIdx(input.vertices_[triangle(0)])];
+        int vidx1 = voxel_vert_ind[GetVoxelIdx(input.vertices_[triangle(1)])];
+        int vidx2 = voxel_vert_ind[GetVoxelIdx(input.vertices_[triangle(2)])];
+        if (vidx0 == vidx1 || vidx0 == vidx2 || vidx1 == vidx2) {
+            continue;
+        }
+        if (vidx1 < vidx0 && vidx1 < vidx2) {
+            int tmp = vidx0;
+            vidx0 = vidx1;
+            vidx1 = vidx2;
+            vidx2 = tmp;
+        } else if (vidx2 < vidx0 && vidx2 < vidx1) {
+            int tmp = vidx1;
+            vidx1 = vidx0;
+            vidx0 = vidx2;
+            vidx2 = tmp;
+        }
+        triangles.emplace(Vector3i(vidx0, vidx1, vidx2));
+    }
+    mesh->triangles_.assign(triangles.begin(), triangles.end());
+    return mesh;
+}
+
+// A sphere with colors as a triangle soup: every triangle has its own copy of
+// its vertices, every fifth triangle is repeated with rotated indices and
+// every seventh vertex is followed by one that no triangle references.
+geometry::TriangleMesh CreateSphereSoup() {
+    auto sphere = geometry::TriangleMesh::CreateSphere(1.0, 12);
+    geometry::TriangleMesh soup;
+    for (size_t tidx = 0; tidx < sphere->triangles_.size(); ++tidx) {
+        Vector3i triangle;
+        for (int i = 0; i < 3; i++) {
+            const Vector3d& vertex =
+                    sphere->vertices_[sphere->triangles_[tidx](i)];
+            triangle(i) = int(soup.vertices_.size());
+            soup.vertices_.push_back(vertex);
+            soup.vertex_colors_.push_back((vertex + Vector3d::Ones()) * 0.5);
+            if (soup.vertices_.size() % 7 == 0) {
+                soup.vertices_.push_back(Vector3d(2.0 + tidx, 0.0, i));
+                soup.vertex_colors_.push_back(Vector3d::Zero());
+            }
+        }
+        soup.triangles_.push_back(triangle);
+        if (tidx % 5 == 0) {
+            soup.triangles_.push_back(
+                    Vector3i(triangle(1), triangle(2), triangle(0)));
+        }
+    }
+    return soup;
+}
+
+vector<Vector3i> SortedTriangles(vector<Vector3i> triangles) {
+    std::sort(triangles.begin(), triangles.end(),
+              [](const Vector3i& a, const Vector3i& b) {
+                  return std::lexicographical_compare(a.data(), a.data() + 3,
+                                                      b.data(), b.data() + 3);
+              });
+    return triangles;
+}
+
+}  // unnamed namespace
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(TriangleMesh, RemoveDuplicatedVertices) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    geometry::TriangleMesh tm;
+    tm.vertices_ = {{0, 0, 0}, {1, 0, 0}, {nan, 0, 0}, {0, 1, 0},
+                    {1, 0, 0}, {nan, 0, 0}, {0, 0, 0}};
+    tm.vertex_colors_ = {{0, 0, 0}, {1, 1, 1}, {2, 2, 2}, {3, 3, 3},
+                         {4, 4, 4}, {5, 5, 5}, {6, 6, 6}};
+    tm.triangles_ = {{0, 1, 3}, {6, 4, 3}, {2, 5, 3}};
+
+    tm.RemoveDuplicatedVertices();
+
+    // Duplicates map to their first occurrence, NaN vertices are never merged
+    // and the remaining vertices keep their order.
+    EXPECT_EQ(5u, tm.vertices_.size());
+    EXPECT_TRUE(std::isnan(tm.vertices_[2](0)));
+    EXPECT_TRUE(std::isnan(tm.vertices_[4](0)));
+    ExpectEQ(Vector3d(0, 1, 0), tm.vertices_[3]);
+    vector<Vector3d> ref_vertex_colors = {
+            {0, 0, 0}, {1, 1, 1}, {2, 2, 2}, {3, 3, 3}, {5, 5, 5}};
+    ExpectEQ(ref_vertex_colors, tm.vertex_colors_);
+    vector<Vector3i> ref_triangles = {{0, 1, 3}, {0, 1, 3}, {2, 4, 3}};
+    ExpectEQ(ref_triangles, tm.triangles_);
+
+    tm.RemoveDuplicatedTriangles();
+    ref_triangles = {{0, 1, 3}, {2, 4, 3}};
+    ExpectEQ(ref_triangles, tm.triangles_);
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(TriangleMesh, MeshCleanupMatchesBaseline) {
+    const geometry::TriangleMesh soup = CreateSphereSoup();
+    geometry::TriangleMesh ref = soup;
+    RemoveDuplicatedVerticesBaseline(ref);
+    RemoveDuplicatedTrianglesBaseline(ref);
+    RemoveUnreferencedVerticesBaseline(ref);
+    auto sphere = geometry::TriangleMesh::CreateSphere(1.0, 12);
+    EXPECT_EQ(sphere->vertices_.size(), ref.vertices_.size());
+    EXPECT_EQ(sphere->triangles_.size(), ref.triangles_.size());
+
+#ifdef _OPENMP
+    int num_threads = omp_get_max_threads();
+    for (int threads : {1, 2, 4}) {
+        omp_set_num_threads(threads);
+#endif
+        geometry::TriangleMesh mesh = soup;
+        mesh.RemoveDuplicatedVertices();
+        mesh.RemoveDuplicatedTriangles();
+        mesh.RemoveUnreferencedVertices();
+        ExpectEQ(ref.vertices_, mesh.vertices_);
+        ExpectEQ(ref.vertex_colors_, mesh.vertex_colors_);
+        ExpectEQ(ref.triangles_, mesh.triangles_);
+#ifdef _OPENMP
+    }
+    omp_set_num_threads(num_threads);
+#endif
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(TriangleMesh, SimplifyVertexClusteringMatchesBaseline) {
+    geometry::TriangleMesh mesh = CreateSphereSoup();
+    mesh.RemoveUnreferencedVertices();
+    const double voxel_size = 0.3;
+    auto ref = SimplifyVertexClusteringBaseline(mesh, voxel_size);
+    EXPECT_GT(ref->triangles_.size(), 0u);
+
+    // The vertices keep the order of their first input vertex. The baseline
+    // emitted the triangles in hash order, which is why only their sets are
+    // compared.
+    auto simplified = mesh.SimplifyVertexClustering(voxel_size);
+    ExpectEQ(ref->vertices_, simplified->vertices_);
+    ExpectEQ(ref->vertex_colors_, simplified->vertex_colors_);
+    EXPECT_EQ(ref->triangles_.size(), simplified->triangles_.size());
+    ExpectEQ(SortedTriangles(ref->triangles_),
+             SortedTriangles(simplified->triangles_));
+
+#ifdef _OPENMP
+    int num_threads = omp_get_max_threads();
+    for (auto contraction :
+         {geometry::TriangleMesh::SimplificationContraction::Average,
+          geometry::TriangleMesh::SimplificationContraction::Quadric}) {
+        omp_set_num_threads(1);
+        auto single = mesh.SimplifyVertexClustering(voxel_size, contraction);
+        for (int threads : {2, 4}) {
+            omp_set_num_threads(threads);
+            auto parallel =
+                    mesh.SimplifyVertexClustering(voxel_size, contraction);
+            ExpectEQ(single->vertices_, parallel->vertices_);
+            ExpectEQ(single->triangles_, parallel->triangles_);
+        }
+    }
+    omp_set_num_threads(num_threads);
+#endif
+}
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -1555,3 +1865,85 @@ TEST(TriangleMesh, CreateMeshCoordinateFrame) {
     ExpectEQ(ref_triangles, output->triangles_);
     ExpectEQ(ref_triangle_normals, output->triangle_normals_);
 }
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(TriangleMesh, CreateFromPointCloudBallPivotingParallel) {
+    geometry::TriangleMesh knot;
+    io::ReadTriangleMesh(std::string(TEST_DATA_DIR) + "/knot.ply", knot);
+    auto dense = knot.SubdivideLoop(2);
+    dense->ComputeVertexNormals();
+    geometry::PointCloud pcd;
+    pcd.points_ = dense->vertices_;
+    pcd.normals_ = dense->vertex_normals_;
+    vector<double> radii = {1.5, 3.0};
+
+    auto serial = geometry::TriangleMesh::CreateFromPointCloudBallPivoting(
+            pcd, radii);
+    auto parallel =
+            geometry::TriangleMesh::CreateFromPointCloudBallPivotingParallel(
+                    pcd, radii, 40.0);
+
+    EXPECT_EQ(pcd.points_.size(), parallel->vertices_.size());
+    EXPECT_EQ(serial->triangles_.size(), parallel->triangles_.size());
+    EXPECT_EQ(parallel->triangles_.size(), parallel->triangle_normals_.size());
+    // The knot is closed, so there must not be any boundary edges either.
+    EXPECT_TRUE(parallel->IsEdgeManifold(false));
+
+    // A cell size far below the ball radius is raised to the margin that the
+    // cells need, instead of allocating a dense grid of tiny cells.
+    auto tiny =
+            geometry::TriangleMesh::CreateFromPointCloudBallPivotingParallel(
+                    pcd, radii, 1e-12);
+    EXPECT_EQ(serial->triangles_.size(), tiny->triangles_.size());
+    EXPECT_TRUE(tiny->IsEdgeManifold(false));
+
+#ifdef _OPENMP
+    int num_threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    auto single =
+            geometry::TriangleMesh::CreateFromPointCloudBallPivotingParallel(
+                    pcd, radii, 40.0);
+    omp_set_num_threads(num_threads);
+    ExpectEQ(parallel->triangles_, single->triangles_);
+#endif
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(TriangleMesh, SimplifyQuadricDecimation) {
+    geometry::TriangleMesh knot;
+    io::ReadTriangleMesh(std::string(TEST_DATA_DIR) + "/knot.ply", knot);
+    auto dense = knot.SubdivideLoop(1);
+
+    auto serial = dense->SimplifyQuadricDecimation(2000);
+    auto parallel = dense->SimplifyQuadricDecimation(2000, true);
+
+    for (const auto& mesh : {serial, parallel}) {
+        EXPECT_LE(mesh->triangles_.size(), 2000u);
+        EXPECT_GE(mesh->triangles_.size(), 1990u);
+        // The knot is closed and has to stay closed
+        EXPECT_TRUE(mesh->IsEdgeManifold(false));
+    }
+
+    // The partitioned decimation has to be about as accurate
+    geometry::DistanceMetrics metrics;
+    metrics.SetReference(*dense, 1000);
+    auto MeanDistance = [&](const geometry::TriangleMesh& mesh) {
+        vector<double> distances = metrics.ComputeDistance(mesh.vertices_);
+        return accumulate(distances.begin(), distances.end(), 0.0) /
+               distances.size();
+    };
+    EXPECT_LT(MeanDistance(*parallel), 1.5 * MeanDistance(*serial));
+
+#ifdef _OPENMP
+    int num_threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    auto single = dense->SimplifyQuadricDecimation(2000, true);
+    omp_set_num_threads(num_threads);
+    ExpectEQ(parallel->vertices_, single->vertices_);
+    ExpectEQ(parallel->triangles_, single->triangles_);
+#endif
+}
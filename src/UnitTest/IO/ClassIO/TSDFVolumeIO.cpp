@@ -0,0 +1,239 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "Open3D/Camera/PinholeCameraIntrinsic.h"
+#include "Open3D/Geometry/RGBDImage.h"
+#include "Open3D/IO/ClassIO/TSDFVolumeIO.h"
+#include "Open3D/Utility/FileSystem.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace open3d;
+using namespace unit_test;
+
+namespace {
+
+// A tilted plane about one meter in front of the camera, with a color ramp.
+geometry::RGBDImage CreateRampImage(
+        const camera::PinholeCameraIntrinsic &intrinsic) {
+    geometry::RGBDImage rgbd;
+    rgbd.depth_.Prepare(intrinsic.width_, intrinsic.height_, 1, 4);
+    rgbd.color_.Prepare(intrinsic.width_, intrinsic.height_, 3, 1);
+    for (int v = 0; v < intrinsic.height_; v++) {
+        for (int u = 0; u < intrinsic.width_; u++) {
+            *rgbd.depth_.PointerAt<float>(u, v) = 0.8f + 0.004f * u;
+            *rgbd.color_.PointerAt<uint8_t>(u, v, 0) = uint8_t(4 * u);
+            *rgbd.color_.PointerAt<uint8_t>(u, v, 1) = uint8_t(4 * v);
+            *rgbd.color_.PointerAt<uint8_t>(u, v, 2) = 50;
+        }
+    }
+    return rgbd;
+}
+
+void ExpectVoxelsEQ(const std::vector<geometry::TSDFVoxel> &voxels0,
+                    const std::vector<geometry::TSDFVoxel> &voxels1) {
+    ASSERT_EQ(voxels0.size(), voxels1.size());
+    for (size_t i = 0; i < voxels0.size(); i++) {
+        EXPECT_EQ(voxels0[i].tsdf_, voxels1[i].tsdf_);
+        EXPECT_EQ(voxels0[i].weight_, voxels1[i].weight_);
+        EXPECT_EQ(voxels0[i].color_, voxels1[i].color_);
+    }
+}
+
+void TruncateFile(const std::string &filename, size_t size) {
+    std::string data;
+    {
+        std::ifstream file(filename, std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(file),
+                    std::istreambuf_iterator<char>());
+    }
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file.write(data.data(), std::min(size, data.size()));
+}
+
+}  // unnamed namespace
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(TSDFVolumeIO, UniformTSDFVolumeRoundTrip) {
+    const camera::PinholeCameraIntrinsic intrinsic(64, 48, 60.0, 60.0, 31.5,
+                                                   23.5);
+    geometry::RGBDImage rgbd = CreateRampImage(intrinsic);
+    const integration::TSDFVolumeColorType color_types[] = {
+            integration::TSDFVolumeColorType::None,
+            integration::TSDFVolumeColorType::RGB8};
+    const std::string filename = "tmp_uniform_volume.tsdf";
+    for (auto color_type : color_types) {
+        integration::UniformTSDFVolume volume(
+                2.0, 48, 0.08, color_type, Eigen::Vector3d(-1.0, -1.0, 0.0));
+        volume.Integrate(rgbd, intrinsic, Eigen::Matrix4d::Identity());
+        for (bool compressed : {false, true}) {
+            ASSERT_TRUE(io::WriteTSDFVolume(filename, volume, compressed));
+            integration::UniformTSDFVolume loaded(
+                    1.0, 4, 0.01, integration::TSDFVolumeColorType::Gray32);
+            ASSERT_TRUE(io::ReadTSDFVolume(filename, loaded));
+            EXPECT_EQ(volume.voxel_length_, loaded.voxel_length_);
+            EXPECT_EQ(volume.sdf_trunc_, loaded.sdf_trunc_);
+            EXPECT_EQ(volume.color_type_, loaded.color_type_);
+            EXPECT_EQ(volume.length_, loaded.length_);
+            EXPECT_EQ(volume.resolution_, loaded.resolution_);
+            EXPECT_EQ(volume.voxel_num_, loaded.voxel_num_);
+            ExpectEQ(volume.origin_, loaded.origin_);
+            ExpectVoxelsEQ(volume.voxels_, loaded.voxels_);
+        }
+    }
+
+    // A reset volume has no blocks.
+    integration::UniformTSDFVolume volume(
+            2.0, 48, 0.08, integration::TSDFVolumeColorType::None);
+    volume.Reset();
+    ASSERT_TRUE(io::WriteTSDFVolume(filename, volume));
+    integration::UniformTSDFVolume loaded(
+            1.0, 4, 0.01, integration::TSDFVolumeColorType::None);
+    ASSERT_TRUE(io::ReadTSDFVolume(filename, loaded));
+    EXPECT_EQ(48 * 48 * 48, (int)loaded.voxels_.size());
+    std::remove(filename.c_str());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(TSDFVolumeIO, ScalableTSDFVolumeRoundTrip) {
+    const camera::PinholeCameraIntrinsic intrinsic(64, 48, 60.0, 60.0, 31.5,
+                                                   23.5);
+    geometry::RGBDImage rgbd = CreateRampImage(intrinsic);
+    const integration::TSDFVolumeColorType color_types[] = {
+            integration::TSDFVolumeColorType::None,
+            integration::TSDFVolumeColorType::RGB8};
+    const std::string filename = "tmp_scalable_volume.tsdf";
+    for (auto color_type : color_types) {
+        for (bool paging : {false, true}) {
+            integration::ScalableTSDFVolume volume(0.02, 0.08, color_type, 8,
+                                                   2);
+            if (paging) {
+                ASSERT_TRUE(volume.EnablePaging("tmp_volume_units.bin", 4));
+            }
+            volume.Integrate(rgbd, intrinsic, Eigen::Matrix4d::Identity());
+            if (paging) {
+                EXPECT_GT(volume.GetPagedVolumeUnitCount(), 0u);
+            }
+            for (bool compressed : {false, true}) {
+                ASSERT_TRUE(io::WriteTSDFVolume(filename, volume, compressed));
+                integration::ScalableTSDFVolume loaded(
+                        0.01, 0.01, integration::TSDFVolumeColorType::Gray32);
+                ASSERT_TRUE(io::ReadTSDFVolume(filename, loaded));
+                EXPECT_EQ(volume.voxel_length_, loaded.voxel_length_);
+                EXPECT_EQ(volume.sdf_trunc_, loaded.sdf_trunc_);
+                EXPECT_EQ(volume.color_type_, loaded.color_type_);
+                EXPECT_EQ(volume.volume_unit_resolution_,
+                          loaded.volume_unit_resolution_);
+                EXPECT_EQ(volume.volume_unit_length_,
+                          loaded.volume_unit_length_);
+                EXPECT_EQ(volume.depth_sampling_stride_,
+                          loaded.depth_sampling_stride_);
+                EXPECT_EQ(loaded.volume_units_.size(),
+                          loaded.dirty_volume_units_.size());
+
+                // Every unit with observed voxels is loaded exactly.
+                integration::UniformTSDFVolume unit(
+                        volume.volume_unit_length_,
+                        volume.volume_unit_resolution_, volume.sdf_trunc_,
+                        volume.color_type_);
+                size_t num_observed = 0;
+                auto indices = volume.GetPagedVolumeUnitIndices();
+                for (const auto &it : volume.volume_units_) {
+                    indices.push_back(it.first);
+                }
+                for (const auto &index : indices) {
+                    auto it = volume.volume_units_.find(index);
+                    if (it != volume.volume_units_.end()) {
+                        unit.voxels_ = it->second.volume_->voxels_;
+                    } else {
+                        ASSERT_TRUE(volume.ReadPagedVolumeUnit(index, unit));
+                    }
+                    bool observed = false;
+                    for (const auto &voxel : unit.voxels_) {
+                        observed = observed || voxel.weight_ != 0.0f;
+                    }
+                    auto loaded_it = loaded.volume_units_.find(index);
+                    if (!observed) {
+                        EXPECT_TRUE(loaded_it == loaded.volume_units_.end());
+                        continue;
+                    }
+                    num_observed++;
+                    ASSERT_TRUE(loaded_it != loaded.volume_units_.end());
+                    Eigen::Vector3d origin =
+                            index.cast<double>() * volume.volume_unit_length_;
+                    ExpectEQ(origin, loaded_it->second.volume_->origin_);
+                    ExpectVoxelsEQ(unit.voxels_,
+                                   loaded_it->second.volume_->voxels_);
+                }
+                EXPECT_GT(num_observed, 0u);
+                EXPECT_EQ(num_observed, loaded.volume_units_.size());
+            }
+        }
+    }
+    std::remove(filename.c_str());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(TSDFVolumeIO, ReadInvalidFile) {
+    const camera::PinholeCameraIntrinsic intrinsic(64, 48, 60.0, 60.0, 31.5,
+                                                   23.5);
+    geometry::RGBDImage rgbd = CreateRampImage(intrinsic);
+    integration::ScalableTSDFVolume volume(
+            0.02, 0.08, integration::TSDFVolumeColorType::RGB8, 8);
+    volume.Integrate(rgbd, intrinsic, Eigen::Matrix4d::Identity());
+    integration::ScalableTSDFVolume loaded(
+            0.02, 0.08, integration::TSDFVolumeColorType::RGB8, 8);
+    integration::UniformTSDFVolume uniform(
+            2.0, 16, 0.08, integration::TSDFVolumeColorType::RGB8);
+
+    const std::string filename = "tmp_invalid_volume.tsdf";
+    std::remove(filename.c_str());
+    EXPECT_FALSE(io::ReadTSDFVolume(filename, loaded));
+
+    ASSERT_TRUE(io::WriteTSDFVolume(filename, volume));
+    EXPECT_FALSE(io::ReadTSDFVolume(filename, uniform));
+    TruncateFile(filename, 200);
+    EXPECT_FALSE(io::ReadTSDFVolume(filename, loaded));
+    TruncateFile(filename, 40);
+    EXPECT_FALSE(io::ReadTSDFVolume(filename, loaded));
+    std::remove(filename.c_str());
+
+    const std::string unknown_filename = "tmp_invalid_volume.xyz";
+    EXPECT_FALSE(io::WriteTSDFVolume(unknown_filename, volume));
+    EXPECT_FALSE(io::WriteTSDFVolume(unknown_filename, uniform));
+    EXPECT_FALSE(io::ReadTSDFVolume(unknown_filename, loaded));
+    EXPECT_FALSE(io::ReadTSDFVolume(unknown_filename, uniform));
+    EXPECT_FALSE(utility::filesystem::FileExists(unknown_filename));
+}
@@ -24,8 +24,30 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/IO/ClassIO/PointCloudIO.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+namespace {
+
+template <typename T>
+void Append(std::string &data, T value) {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    data.append(bytes, sizeof(T));
+}
+
+}  // unnamed namespace
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -64,7 +86,82 @@ TEST(FilePCD, DISABLED_UnpackASCIIPCDColor) { unit_test::NotImplemented(); }
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
-TEST(FilePCD, DISABLED_ReadPCDData) { unit_test::NotImplemented(); }
+TEST(FilePCD, ReadPCDData) {
+    geometry::PointCloud pcd_gt;
+    pcd_gt.points_.resize(1000);
+    pcd_gt.normals_.resize(1000);
+    pcd_gt.colors_.resize(1000);
+    Rand(pcd_gt.points_, Vector3d(-10, -10, -10), Vector3d(10, 10, 10), 0);
+    Rand(pcd_gt.normals_, Vector3d(-1, -1, -1), Vector3d(1, 1, 1), 1);
+    for (size_t i = 0; i < pcd_gt.colors_.size(); i++) {
+        pcd_gt.colors_[i] = Vector3d(i % 256, (3 * i) % 256, (7 * i) % 256) /
+                            255.0;
+    }
+
+    for (bool write_ascii : {true, false}) {
+        for (bool compressed : {false, true}) {
+            EXPECT_TRUE(io::WritePointCloudToPCD("tmp.pcd", pcd_gt,
+                                                 write_ascii, compressed));
+            geometry::PointCloud pcd_test;
+            EXPECT_TRUE(io::ReadPointCloudFromPCD("tmp.pcd", pcd_test, false));
+            EXPECT_EQ(std::remove("tmp.pcd"), 0);
+
+            // Points and normals are stored as floats.
+            ExpectEQ(pcd_gt.points_, pcd_test.points_, 1e-5);
+            ExpectEQ(pcd_gt.normals_, pcd_test.normals_, 1e-6);
+            ExpectEQ(pcd_gt.colors_, pcd_test.colors_);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FilePCD, ReadPCDDataMixedTypes) {
+    std::string data =
+            "# .PCD v0.7 - Point Cloud Data file format\n"
+            "VERSION 0.7\n"
+            "FIELDS x _ y z rgba\n"
+            "SIZE 8 1 2 1 4\n"
+            "TYPE F U U I U\n"
+            "COUNT 1 3 1 1 1\n"
+            "WIDTH 2\n"
+            "HEIGHT 1\n"
+            "VIEWPOINT 0 0 0 1 0 0 0\n"
+            "POINTS 2\n"
+            "DATA binary\n";
+    for (int i = 0; i < 2; i++) {
+        Append(data, 0.5 + i);
+        Append(data, std::uint8_t(1));
+        Append(data, std::uint8_t(2));
+        Append(data, std::uint8_t(3));
+        Append(data, std::uint16_t(1000 + i));
+        Append(data, std::int8_t(-1 - i));
+        // Colors are packed in BGR order.
+        const std::uint8_t bgra[4] = {std::uint8_t(51 * i), 102, 255, 0};
+        data.append(reinterpret_cast<const char *>(bgra), 4);
+    }
+    {
+        std::ofstream file("tmp.pcd", std::ios::binary);
+        file.write(data.data(), data.size());
+    }
+
+    geometry::PointCloud pcd;
+    EXPECT_TRUE(io::ReadPointCloudFromPCD("tmp.pcd", pcd, false));
+    vector<Vector3d> ref_points = {{0.5, 1000, -1}, {1.5, 1001, -2}};
+    vector<Vector3d> ref_colors = {{1.0, 0.4, 0.0}, {1.0, 0.4, 0.2}};
+    ExpectEQ(ref_points, pcd.points_);
+    ExpectEQ(ref_colors, pcd.colors_);
+    EXPECT_FALSE(pcd.HasNormals());
+
+    // A data block shorter than the header promises is rejected.
+    {
+        std::ofstream file("tmp.pcd", std::ios::binary);
+        file.write(data.data(), data.size() - 1);
+    }
+    EXPECT_FALSE(io::ReadPointCloudFromPCD("tmp.pcd", pcd, false));
+    EXPECT_EQ(std::remove("tmp.pcd"), 0);
+}
 
 // ----------------------------------------------------------------------------
 //
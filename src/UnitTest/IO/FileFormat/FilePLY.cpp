@@ -24,8 +24,79 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/TriangleMesh.h"
+#include "Open3D/IO/ClassIO/PointCloudIO.h"
+#include "Open3D/IO/ClassIO/TriangleMeshIO.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+namespace {
+
+// Appends \p value to \p data with the most significant byte first.
+template <typename T>
+void AppendBigEndian(std::string &data, T value) {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    const uint16_t one = 1;
+    if (*reinterpret_cast<const uint8_t *>(&one) == 1) {
+        std::reverse(bytes, bytes + sizeof(T));
+    }
+    data.append(bytes, sizeof(T));
+}
+
+// Writes a big endian PLY file with float vertices, uchar colors and the
+// faces \p faces. The face element comes first if \p faces_first is set.
+void WriteBigEndianPLY(const std::string &filename,
+                       const std::vector<std::vector<uint32_t>> &faces,
+                       bool faces_first = false) {
+    const std::string vertex_header =
+            "element vertex 4\n"
+            "property float x\nproperty float y\nproperty float z\n"
+            "property uchar red\nproperty uchar green\nproperty uchar blue\n";
+    const std::string face_header =
+            "element face " + std::to_string(faces.size()) +
+            "\nproperty list uchar int vertex_indices\n";
+    std::string vertex_data;
+    const float vertices[4][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}};
+    for (int i = 0; i < 4; i++) {
+        for (int c = 0; c < 3; c++) {
+            AppendBigEndian(vertex_data, vertices[i][c]);
+        }
+        for (int c = 0; c < 3; c++) {
+            AppendBigEndian(vertex_data, uint8_t(51 * (i + c)));
+        }
+    }
+    std::string face_data;
+    for (const auto &face : faces) {
+        AppendBigEndian(face_data, uint8_t(face.size()));
+        for (uint32_t index : face) {
+            AppendBigEndian(face_data, int32_t(index));
+        }
+    }
+    std::string data = "ply\nformat binary_big_endian 1.0\n";
+    if (faces_first) {
+        data += face_header + vertex_header + "end_header\n" + face_data +
+                vertex_data;
+    } else {
+        data += vertex_header + face_header + "end_header\n" + vertex_data +
+                face_data;
+    }
+    std::ofstream file(filename, std::ios::binary);
+    file.write(data.data(), data.size());
+}
+
+}  // unnamed namespace
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -54,22 +125,175 @@ TEST(FilePLY, DISABLED_ReadFaceCallBack) { unit_test::NotImplemented(); }
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
-TEST(FilePLY, DISABLED_ReadPointCloudFromPLY) { unit_test::NotImplemented(); }
+TEST(FilePLY, ReadPointCloudFromPLY) {
+    geometry::PointCloud pcd_gt;
+    pcd_gt.points_.resize(1000);
+    pcd_gt.normals_.resize(1000);
+    pcd_gt.colors_.resize(1000);
+    Rand(pcd_gt.points_, Vector3d(-10, -10, -10), Vector3d(10, 10, 10), 0);
+    Rand(pcd_gt.normals_, Vector3d(-1, -1, -1), Vector3d(1, 1, 1), 1);
+    for (size_t i = 0; i < pcd_gt.colors_.size(); i++) {
+        pcd_gt.colors_[i] = Vector3d(i % 256, (3 * i) % 256, (7 * i) % 256) /
+                            255.0;
+    }
+
+    // The binary file is read with the memory mapped path and the ASCII
+    // file with rply, both have to give the same point cloud.
+    EXPECT_TRUE(io::WritePointCloudToPLY("tmp.ply", pcd_gt, false));
+    geometry::PointCloud pcd_binary;
+    EXPECT_TRUE(io::ReadPointCloudFromPLY("tmp.ply", pcd_binary, false));
+    EXPECT_TRUE(io::WritePointCloudToPLY("tmp.ply", pcd_gt, true));
+    geometry::PointCloud pcd_ascii;
+    EXPECT_TRUE(io::ReadPointCloudFromPLY("tmp.ply", pcd_ascii, false));
+    EXPECT_EQ(std::remove("tmp.ply"), 0);
+
+    ExpectEQ(pcd_gt.points_, pcd_binary.points_);
+    ExpectEQ(pcd_gt.normals_, pcd_binary.normals_);
+    ExpectEQ(pcd_gt.colors_, pcd_binary.colors_);
+    // rply writes ASCII doubles with six significant digits.
+    ExpectEQ(pcd_ascii.points_, pcd_binary.points_, 1e-4);
+    ExpectEQ(pcd_ascii.normals_, pcd_binary.normals_, 1e-4);
+    ExpectEQ(pcd_ascii.colors_, pcd_binary.colors_);
+}
 
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
-TEST(FilePLY, DISABLED_WritePointCloudToPLY) { unit_test::NotImplemented(); }
+TEST(FilePLY, WritePointCloudToPLY) {
+    geometry::PointCloud pcd_gt;
+    pcd_gt.points_ = {{0, 0, 0}, {1, 2, 3}, {-4, 5, -6}};
+    pcd_gt.colors_ = {{0, 0.5, 1}, {1.5, -0.5, 0}, {0.25, 0.75, 1}};
+
+    EXPECT_TRUE(io::WritePointCloudToPLY("tmp.ply", pcd_gt, false));
+    std::ifstream file("tmp.ply", std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(file)),
+                     std::istreambuf_iterator<char>());
+    file.close();
+    geometry::PointCloud pcd_test;
+    EXPECT_TRUE(io::ReadPointCloudFromPLY("tmp.ply", pcd_test, false));
+    EXPECT_EQ(std::remove("tmp.ply"), 0);
+
+    const std::string header =
+            "ply\nformat binary_little_endian 1.0\n"
+            "comment Created by Open3D\nelement vertex 3\n"
+            "property double x\nproperty double y\nproperty double z\n"
+            "property uchar red\nproperty uchar green\nproperty uchar blue\n"
+            "end_header\n";
+    EXPECT_EQ(header, data.substr(0, header.size()));
+    EXPECT_EQ(header.size() + 3 * (3 * sizeof(double) + 3), data.size());
+
+    // Colors are clamped to [0, 1] and truncated to 8 bits.
+    vector<Vector3d> ref_colors = {
+            {0, 127 / 255.0, 1}, {1, 0, 0}, {63 / 255.0, 191 / 255.0, 1}};
+    ExpectEQ(pcd_gt.points_, pcd_test.points_);
+    ExpectEQ(ref_colors, pcd_test.colors_);
+    EXPECT_FALSE(pcd_test.HasNormals());
+}
 
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
-TEST(FilePLY, DISABLED_ReadTriangleMeshFromPLY) { unit_test::NotImplemented(); }
+TEST(FilePLY, ReadTriangleMeshFromPLY) {
+    geometry::TriangleMesh mesh_gt;
+    EXPECT_TRUE(io::ReadTriangleMesh(std::string(TEST_DATA_DIR) + "/knot.ply",
+                                     mesh_gt));
+    mesh_gt.ComputeVertexNormals();
+    mesh_gt.vertex_colors_.resize(mesh_gt.vertices_.size());
+    for (size_t i = 0; i < mesh_gt.vertex_colors_.size(); i++) {
+        mesh_gt.vertex_colors_[i] =
+                Vector3d(i % 256, (5 * i) % 256, (11 * i) % 256) / 255.0;
+    }
+
+    EXPECT_TRUE(io::WriteTriangleMeshToPLY("tmp.ply", mesh_gt, false));
+    geometry::TriangleMesh mesh_binary;
+    EXPECT_TRUE(io::ReadTriangleMeshFromPLY("tmp.ply", mesh_binary, false));
+    EXPECT_TRUE(io::WriteTriangleMeshToPLY("tmp.ply", mesh_gt, true));
+    geometry::TriangleMesh mesh_ascii;
+    EXPECT_TRUE(io::ReadTriangleMeshFromPLY("tmp.ply", mesh_ascii, false));
+    EXPECT_EQ(std::remove("tmp.ply"), 0);
+
+    ExpectEQ(mesh_gt.vertices_, mesh_binary.vertices_);
+    ExpectEQ(mesh_gt.vertex_normals_, mesh_binary.vertex_normals_);
+    ExpectEQ(mesh_gt.vertex_colors_, mesh_binary.vertex_colors_);
+    ExpectEQ(mesh_gt.triangles_, mesh_binary.triangles_);
+    ExpectEQ(mesh_ascii.vertices_, mesh_binary.vertices_, 1e-3);
+    ExpectEQ(mesh_ascii.vertex_colors_, mesh_binary.vertex_colors_);
+    ExpectEQ(mesh_ascii.triangles_, mesh_binary.triangles_);
+}
 
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
-TEST(FilePLY, DISABLED_WriteTriangleMeshToPLY) { unit_test::NotImplemented(); }
+TEST(FilePLY, ReadTriangleMeshFromBigEndianPLY) {
+    vector<Vector3d> ref_vertices = {
+            {0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}};
+    vector<Vector3d> ref_colors = {{0.0, 0.2, 0.4},
+                                   {0.2, 0.4, 0.6},
+                                   {0.4, 0.6, 0.8},
+                                   {0.6, 0.8, 1.0}};
+
+    // Triangles are decoded from the mapped file.
+    WriteBigEndianPLY("tmp.ply", {{0, 1, 2}, {0, 2, 3}});
+    geometry::TriangleMesh mesh;
+    EXPECT_TRUE(io::ReadTriangleMeshFromPLY("tmp.ply", mesh, false));
+    ExpectEQ(ref_vertices, mesh.vertices_);
+    ExpectEQ(ref_colors, mesh.vertex_colors_);
+    vector<Vector3i> ref_triangles = {{0, 1, 2}, {0, 2, 3}};
+    ExpectEQ(ref_triangles, mesh.triangles_);
+
+    // Polygons are read with rply, which splits them into triangles.
+    WriteBigEndianPLY("tmp.ply", {{0, 1, 2, 3}});
+    EXPECT_TRUE(io::ReadTriangleMeshFromPLY("tmp.ply", mesh, false));
+    EXPECT_EQ(std::remove("tmp.ply"), 0);
+    ExpectEQ(ref_vertices, mesh.vertices_);
+    ExpectEQ(ref_colors, mesh.vertex_colors_);
+    EXPECT_EQ(2u, mesh.triangles_.size());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FilePLY, ReadPLYWithFacesBeforeVertices) {
+    vector<Vector3d> ref_vertices = {
+            {0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}};
+
+    // The size of the quads is not known from the header, so the vertices
+    // after them are read with rply.
+    WriteBigEndianPLY("tmp.ply", {{0, 1, 2, 3}, {3, 2, 1, 0}}, true);
+    geometry::PointCloud pointcloud;
+    EXPECT_TRUE(io::ReadPointCloudFromPLY("tmp.ply", pointcloud, false));
+    ExpectEQ(ref_vertices, pointcloud.points_);
+
+    WriteBigEndianPLY("tmp.ply", {{0, 1, 2}, {0, 2, 3}}, true);
+    EXPECT_TRUE(io::ReadPointCloudFromPLY("tmp.ply", pointcloud, false));
+    ExpectEQ(ref_vertices, pointcloud.points_);
+    geometry::TriangleMesh mesh;
+    EXPECT_TRUE(io::ReadTriangleMeshFromPLY("tmp.ply", mesh, false));
+    EXPECT_EQ(std::remove("tmp.ply"), 0);
+    ExpectEQ(ref_vertices, mesh.vertices_);
+    vector<Vector3i> ref_triangles = {{0, 1, 2}, {0, 2, 3}};
+    ExpectEQ(ref_triangles, mesh.triangles_);
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FilePLY, WriteTriangleMeshToPLY) {
+    geometry::TriangleMesh mesh_gt;
+    mesh_gt.vertices_ = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    mesh_gt.vertex_normals_ = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}, {1, 1, 1}};
+    mesh_gt.triangles_ = {{0, 1, 2}, {0, 3, 1}};
+
+    EXPECT_TRUE(io::WriteTriangleMeshToPLY("tmp.ply", mesh_gt, false, false,
+                                           false));
+    geometry::TriangleMesh mesh_test;
+    EXPECT_TRUE(io::ReadTriangleMeshFromPLY("tmp.ply", mesh_test, false));
+    EXPECT_EQ(std::remove("tmp.ply"), 0);
+
+    ExpectEQ(mesh_gt.vertices_, mesh_test.vertices_);
+    ExpectEQ(mesh_gt.triangles_, mesh_test.triangles_);
+    EXPECT_FALSE(mesh_test.HasVertexNormals());
+}
 
 // ----------------------------------------------------------------------------
 //
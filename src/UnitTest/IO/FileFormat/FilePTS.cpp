@@ -24,12 +24,53 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/IO/ClassIO/PointCloudIO.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
-TEST(FilePTS, DISABLED_ReadPointCloudFromPTS) { unit_test::NotImplemented(); }
+TEST(FilePTS, ReadPointCloudFromPTS) {
+    // A line that cannot be parsed still counts as a point, the lines after
+    // the number of points in the header are ignored.
+    const string contents =
+            "4\r\n"
+            "1 2 3 0 255 0 51\r\n"
+            "0.5 -1e-3 2 0 0 255 0\r\n"
+            "bad line\r\n"
+            "7 8 9 0 102 204 255\r\n"
+            "10 11 12 0 0 0 0\r\n";
+    ofstream("tmp.pts", ios::binary) << contents;
+
+    geometry::PointCloud pcd;
+    EXPECT_TRUE(io::ReadPointCloudFromPTS("tmp.pts", pcd, false));
+
+    vector<Vector3d> ref_points = {{1, 2, 3}, {0.5, -1e-3, 2}, {7, 8, 9}};
+    vector<Vector3d> ref_colors = {{1, 0, 0.2}, {0, 1, 0}, {0.4, 0.8, 1}};
+    EXPECT_EQ(4u, pcd.points_.size());
+    EXPECT_EQ(4u, pcd.colors_.size());
+    const size_t valid_lines[] = {0, 1, 3};
+    for (size_t i = 0; i < ref_points.size(); i++) {
+        ExpectEQ(ref_points[i], pcd.points_[valid_lines[i]]);
+        ExpectEQ(ref_colors[i], pcd.colors_[valid_lines[i]]);
+    }
+
+    ofstream("tmp.pts", ios::binary) << "3\n1 2\n";
+    EXPECT_FALSE(io::ReadPointCloudFromPTS("tmp.pts", pcd, false));
+    ofstream("tmp.pts", ios::binary) << "0\n1 2 3\n";
+    EXPECT_FALSE(io::ReadPointCloudFromPTS("tmp.pts", pcd, false));
+    std::remove("tmp.pts");
+}
 
 // ----------------------------------------------------------------------------
 //
@@ -24,12 +24,50 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/IO/ClassIO/PointCloudIO.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
-TEST(FileXYZ, DISABLED_ReadPointCloudFromXYZ) { unit_test::NotImplemented(); }
+TEST(FileXYZ, ReadPointCloudFromXYZ) {
+    const string contents =
+            "# comment\n"
+            "1 2 3\n"
+            "\n"
+            "-0.5\t1e-3  0.30000000000000004\r\n"
+            "4 5\n"
+            "  7.25 8 9 extra\n"
+            "123456789012345678901234567890 1e300 -2.5e-300\n"
+            "10 11 12";
+    ofstream("tmp.xyz", ios::binary) << contents;
+
+    geometry::PointCloud pcd;
+    pcd.points_.push_back(Vector3d(-1, -1, -1));
+    EXPECT_TRUE(io::ReadPointCloudFromXYZ("tmp.xyz", pcd, false));
+
+    vector<Vector3d> ref_points = {
+            {1, 2, 3},
+            {-0.5, 1e-3, 0.30000000000000004},
+            {7.25, 8, 9},
+            {123456789012345678901234567890.0, 1e300, -2.5e-300},
+            {10, 11, 12}};
+    ExpectEQ(ref_points, pcd.points_);
+    EXPECT_FALSE(pcd.HasNormals());
+
+    EXPECT_FALSE(io::ReadPointCloudFromXYZ("does_not_exist.xyz", pcd, false));
+    std::remove("tmp.xyz");
+}
 
 // ----------------------------------------------------------------------------
 //
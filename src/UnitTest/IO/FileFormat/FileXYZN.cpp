@@ -24,12 +24,40 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/IO/ClassIO/PointCloudIO.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
-TEST(FileXYZN, DISABLED_ReadPointCloudFromXYZN) { unit_test::NotImplemented(); }
+TEST(FileXYZN, ReadPointCloudFromXYZN) {
+    const string contents =
+            "1 2 3 0.1 0.2 0.3\n"
+            "1 2 3 4 5\n"
+            "\n"
+            "-1e-3\t4 5.5 1 0 0\r\n"
+            "7 8 9 0 0.5 1";
+    ofstream("tmp.xyzn", ios::binary) << contents;
+
+    geometry::PointCloud pcd;
+    EXPECT_TRUE(io::ReadPointCloudFromXYZN("tmp.xyzn", pcd, false));
+
+    vector<Vector3d> ref_points = {{1, 2, 3}, {-1e-3, 4, 5.5}, {7, 8, 9}};
+    vector<Vector3d> ref_normals = {{0.1, 0.2, 0.3}, {1, 0, 0}, {0, 0.5, 1}};
+    ExpectEQ(ref_points, pcd.points_);
+    ExpectEQ(ref_normals, pcd.normals_);
+    std::remove("tmp.xyzn");
+}
 
 // ----------------------------------------------------------------------------
 //
@@ -24,8 +24,51 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <fstream>
+
+#include "Open3D/Integration/ScalableTSDFVolume.h"
+#include "Open3D/Camera/PinholeCameraIntrinsic.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/RGBDImage.h"
+#include "Open3D/Geometry/TriangleMesh.h"
+#include "Open3D/Integration/UniformTSDFVolume.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace open3d;
+using namespace unit_test;
+
+namespace {
+
+// The plane 0.3 x - z = -1 in camera coordinates, seen with a uniform color.
+const double kPlaneSlope = 0.3;
+
+double PlaneDepth(const camera::PinholeCameraIntrinsic &intrinsic,
+                  int u,
+                  int v) {
+    double x = (u - intrinsic.GetPrincipalPoint().first) /
+               intrinsic.GetFocalLength().first;
+    return 1.0 / (1.0 - kPlaneSlope * x);
+}
+
+geometry::RGBDImage CreatePlaneImage(
+        const camera::PinholeCameraIntrinsic &intrinsic) {
+    geometry::RGBDImage rgbd;
+    rgbd.depth_.Prepare(intrinsic.width_, intrinsic.height_, 1, 4);
+    rgbd.color_.Prepare(intrinsic.width_, intrinsic.height_, 3, 1);
+    for (int v = 0; v < intrinsic.height_; v++) {
+        for (int u = 0; u < intrinsic.width_; u++) {
+            *rgbd.depth_.PointerAt<float>(u, v) =
+                    float(PlaneDepth(intrinsic, u, v));
+            *rgbd.color_.PointerAt<uint8_t>(u, v, 0) = 200;
+            *rgbd.color_.PointerAt<uint8_t>(u, v, 1) = 100;
+            *rgbd.color_.PointerAt<uint8_t>(u, v, 2) = 50;
+        }
+    }
+    return rgbd;
+}
+
+}  // unnamed namespace
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -70,6 +113,304 @@ TEST(ScalableTSDFVolume, DISABLED_ExtractTriangleMesh) {
     unit_test::NotImplemented();
 }
 
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(ScalableTSDFVolume, Raycast) {
+    const camera::PinholeCameraIntrinsic intrinsic(64, 48, 250.0, 250.0, 31.5,
+                                                   23.5);
+    integration::ScalableTSDFVolume volume(
+            0.01, 0.04, integration::TSDFVolumeColorType::RGB8);
+    geometry::Image depth, normal, color;
+
+    // An empty volume has no surface.
+    volume.Raycast(intrinsic, Eigen::Matrix4d::Identity(), depth, normal,
+                   color);
+    EXPECT_EQ(64, depth.width_);
+    EXPECT_EQ(48, depth.height_);
+    EXPECT_EQ(3, normal.num_of_channels_);
+    EXPECT_EQ(3, color.num_of_channels_);
+    for (int v = 0; v < 48; v++) {
+        for (int u = 0; u < 64; u++) {
+            EXPECT_EQ(0.0f, *depth.PointerAt<float>(u, v));
+        }
+    }
+
+    geometry::RGBDImage rgbd = CreatePlaneImage(intrinsic);
+    for (int i = 0; i < 3; i++) {
+        volume.Integrate(rgbd, intrinsic, Eigen::Matrix4d::Identity());
+    }
+
+    // Rendering from the integrated view gives back the plane, except at the
+    // border of the image where the ray leaves the observed volume.
+    volume.Raycast(intrinsic, Eigen::Matrix4d::Identity(), depth, normal,
+                   color);
+    const Eigen::Vector3d plane_normal =
+            Eigen::Vector3d(kPlaneSlope, 0.0, -1.0).normalized();
+    int num_hits = 0;
+    for (int v = 4; v < 44; v++) {
+        for (int u = 4; u < 60; u++) {
+            double d = *depth.PointerAt<float>(u, v);
+            if (d == 0.0) {
+                continue;
+            }
+            num_hits++;
+            EXPECT_NEAR(PlaneDepth(intrinsic, u, v), d, 0.003);
+            Eigen::Vector3d n(*normal.PointerAt<float>(u, v, 0),
+                              *normal.PointerAt<float>(u, v, 1),
+                              *normal.PointerAt<float>(u, v, 2));
+            EXPECT_GT(n.dot(plane_normal), 0.99);
+            EXPECT_NEAR(200, *color.PointerAt<uint8_t>(u, v, 0), 1);
+            EXPECT_NEAR(100, *color.PointerAt<uint8_t>(u, v, 1), 1);
+            EXPECT_NEAR(50, *color.PointerAt<uint8_t>(u, v, 2), 1);
+        }
+    }
+    EXPECT_GT(num_hits, 40 * 56 * 9 / 10);
+
+    // A camera moved back by 0.2 sees the plane 0.2 farther away along its
+    // optical axis.
+    Eigen::Matrix4d extrinsic = Eigen::Matrix4d::Identity();
+    extrinsic(2, 3) = 0.2;
+    volume.Raycast(intrinsic, extrinsic, depth, normal, color);
+    EXPECT_NEAR(1.2 * PlaneDepth(intrinsic, 32, 24),
+                *depth.PointerAt<float>(32, 24), 0.003);
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(ScalableTSDFVolume, ExtractDirtyTriangleMeshes) {
+    const camera::PinholeCameraIntrinsic intrinsic(64, 48, 250.0, 250.0, 31.5,
+                                                   23.5);
+    geometry::RGBDImage rgbd = CreatePlaneImage(intrinsic);
+    integration::ScalableTSDFVolume volume(
+            0.01, 0.04, integration::TSDFVolumeColorType::RGB8);
+    EXPECT_TRUE(volume.ExtractDirtyTriangleMeshes().empty());
+
+    // The preview that a caller keeps up to date with the chunks.
+    std::unordered_map<Eigen::Vector3i,
+                       std::shared_ptr<geometry::TriangleMesh>,
+                       utility::hash_eigen::hash<Eigen::Vector3i>>
+            preview;
+    auto update_preview = [&]() {
+        auto chunks = volume.ExtractDirtyTriangleMeshes();
+        for (const auto &chunk : chunks) {
+            preview[chunk.first] = chunk.second;
+        }
+        return chunks.size();
+    };
+    auto expect_preview_eq_mesh = [&]() {
+        size_t num_triangles = 0;
+        for (const auto &chunk : preview) {
+            num_triangles += chunk.second->triangles_.size();
+        }
+        EXPECT_EQ(volume.ExtractTriangleMesh()->triangles_.size(),
+                  num_triangles);
+    };
+
+    // The camera sweeps sideways.
+    Eigen::Matrix4d extrinsic = Eigen::Matrix4d::Identity();
+    for (int i = 0; i < 6; i++) {
+        extrinsic(0, 3) = -0.08 * i;
+        volume.Integrate(rgbd, intrinsic, extrinsic);
+    }
+    EXPECT_EQ(volume.volume_units_.size(), volume.dirty_volume_units_.size());
+    EXPECT_EQ(volume.volume_units_.size(), update_preview());
+    EXPECT_TRUE(volume.dirty_volume_units_.empty());
+    EXPECT_TRUE(volume.ExtractDirtyTriangleMeshes().empty());
+    expect_preview_eq_mesh();
+
+    // Looking at the start of the sweep again only re-meshes that part.
+    extrinsic(0, 3) = 0.0;
+    volume.Integrate(rgbd, intrinsic, extrinsic);
+    size_t num_dirty = volume.dirty_volume_units_.size();
+    EXPECT_GT(num_dirty, 0u);
+    size_t num_chunks = update_preview();
+    EXPECT_GE(num_chunks, num_dirty);
+    EXPECT_LT(num_chunks, volume.volume_units_.size());
+    expect_preview_eq_mesh();
+
+    for (const auto &chunk : preview) {
+        EXPECT_EQ(chunk.second->triangles_.size(),
+                  volume.ExtractVolumeUnitTriangleMesh(chunk.first)
+                          ->triangles_.size());
+    }
+    auto missing_chunk =
+            volume.ExtractVolumeUnitTriangleMesh(Eigen::Vector3i(9, 9, 9));
+    EXPECT_TRUE(missing_chunk->IsEmpty());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(ScalableTSDFVolume, Paging) {
+    const camera::PinholeCameraIntrinsic intrinsic(64, 48, 250.0, 250.0, 31.5,
+                                                   23.5);
+    geometry::RGBDImage rgbd = CreatePlaneImage(intrinsic);
+    const size_t max_volume_units = 8;
+
+    // The camera sweeps sideways, so earlier units leave the view.
+    std::vector<Eigen::Matrix4d> extrinsics;
+    for (int i = 0; i < 12; i++) {
+        Eigen::Matrix4d extrinsic = Eigen::Matrix4d::Identity();
+        extrinsic(0, 3) = -0.04 * i;
+        extrinsics.push_back(extrinsic);
+        extrinsics.push_back(extrinsic);
+    }
+    integration::ScalableTSDFVolume reference(
+            0.01, 0.04, integration::TSDFVolumeColorType::RGB8);
+    for (const auto &extrinsic : extrinsics) {
+        reference.Integrate(rgbd, intrinsic, extrinsic);
+    }
+    auto reference_mesh = reference.ExtractTriangleMesh();
+    auto reference_pcd = reference.ExtractPointCloud();
+    ASSERT_GT(reference.volume_units_.size(), 2 * max_volume_units);
+
+    const integration::VolumeUnitEvictionPolicy policies[] = {
+            integration::VolumeUnitEvictionPolicy::LeastRecentlyUsed,
+            integration::VolumeUnitEvictionPolicy::CameraDistance};
+    for (auto policy : policies) {
+        integration::ScalableTSDFVolume volume(
+                0.01, 0.04, integration::TSDFVolumeColorType::RGB8);
+        EXPECT_FALSE(volume.IsPagingEnabled());
+        ASSERT_TRUE(volume.EnablePaging("tmp_volume_units.bin",
+                                        max_volume_units, policy));
+        EXPECT_TRUE(volume.IsPagingEnabled());
+        for (const auto &extrinsic : extrinsics) {
+            volume.Integrate(rgbd, intrinsic, extrinsic);
+            EXPECT_LE(volume.volume_units_.size(), max_volume_units);
+        }
+        EXPECT_EQ(reference.volume_units_.size(), volume.GetVolumeUnitCount());
+        EXPECT_GT(volume.GetPagedVolumeUnitCount(), 0u);
+
+        // Extraction keeps at most the neighbourhood of one unit in memory
+        // besides the budget and gives the same surface.
+        auto mesh = volume.ExtractTriangleMesh();
+        EXPECT_LE(volume.volume_units_.size(), max_volume_units + 8);
+        EXPECT_EQ(reference_mesh->vertices_.size(), mesh->vertices_.size());
+        EXPECT_EQ(reference_mesh->triangles_.size(), mesh->triangles_.size());
+        auto pcd = volume.ExtractPointCloud();
+        EXPECT_LE(volume.volume_units_.size(), max_volume_units + 27);
+        EXPECT_EQ(reference_pcd->points_.size(), pcd->points_.size());
+        auto voxel_pcd = volume.ExtractVoxelPointCloud();
+        EXPECT_EQ(reference.ExtractVoxelPointCloud()->points_.size(),
+                  voxel_pcd->points_.size());
+
+        // Paged units are stored losslessly.
+        EXPECT_TRUE(volume.DisablePaging());
+        EXPECT_FALSE(volume.IsPagingEnabled());
+        ASSERT_EQ(reference.volume_units_.size(), volume.volume_units_.size());
+        for (const auto &unit : reference.volume_units_) {
+            auto unit_itr = volume.volume_units_.find(unit.first);
+            ASSERT_TRUE(unit_itr != volume.volume_units_.end());
+            const auto &voxels0 = unit.second.volume_->voxels_;
+            const auto &voxels1 = unit_itr->second.volume_->voxels_;
+            for (size_t i = 0; i < voxels0.size(); i++) {
+                EXPECT_EQ(voxels0[i].tsdf_, voxels1[i].tsdf_);
+                EXPECT_EQ(voxels0[i].weight_, voxels1[i].weight_);
+                ExpectEQ(voxels0[i].color_, voxels1[i].color_);
+            }
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(ScalableTSDFVolume, PagingReadFailure) {
+    const camera::PinholeCameraIntrinsic intrinsic(64, 48, 250.0, 250.0, 31.5,
+                                                   23.5);
+    geometry::RGBDImage rgbd = CreatePlaneImage(intrinsic);
+    integration::ScalableTSDFVolume volume(
+            0.01, 0.04, integration::TSDFVolumeColorType::RGB8);
+    ASSERT_TRUE(volume.EnablePaging("tmp_volume_units.bin", 4));
+    Eigen::Matrix4d extrinsic = Eigen::Matrix4d::Identity();
+    for (int i = 0; i < 6; i++) {
+        extrinsic(0, 3) = -0.08 * i;
+        volume.Integrate(rgbd, intrinsic, extrinsic);
+    }
+    size_t num_paged = volume.GetPagedVolumeUnitCount();
+    ASSERT_GT(num_paged, 0u);
+
+    // Units that cannot be read back stay paged out and are skipped.
+    std::ofstream("tmp_volume_units.bin", std::ios::trunc);
+    volume.ExtractTriangleMesh();
+    EXPECT_EQ(num_paged, volume.GetPagedVolumeUnitCount());
+    extrinsic(0, 3) = 0.0;
+    volume.Integrate(rgbd, intrinsic, extrinsic);
+    EXPECT_FALSE(volume.DisablePaging());
+    EXPECT_TRUE(volume.IsPagingEnabled());
+    EXPECT_GT(volume.GetPagedVolumeUnitCount(), 0u);
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(ScalableTSDFVolume, CopyWithPaging) {
+    const camera::PinholeCameraIntrinsic intrinsic(64, 48, 250.0, 250.0, 31.5,
+                                                   23.5);
+    geometry::RGBDImage rgbd = CreatePlaneImage(intrinsic);
+    integration::ScalableTSDFVolume volume(
+            0.01, 0.04, integration::TSDFVolumeColorType::RGB8);
+    ASSERT_TRUE(volume.EnablePaging("tmp_volume_units.bin", 4));
+    Eigen::Matrix4d extrinsic = Eigen::Matrix4d::Identity();
+    for (int i = 0; i < 6; i++) {
+        extrinsic(0, 3) = -0.08 * i;
+        volume.Integrate(rgbd, intrinsic, extrinsic);
+    }
+    ASSERT_GT(volume.GetPagedVolumeUnitCount(), 0u);
+    size_t num_triangles = volume.ExtractTriangleMesh()->triangles_.size();
+
+    // Copies hold all units in memory and are independent of the original.
+    integration::ScalableTSDFVolume copy(volume);
+    integration::ScalableTSDFVolume assigned(
+            0.02, 0.08, integration::TSDFVolumeColorType::None);
+    ASSERT_TRUE(assigned.EnablePaging("tmp_volume_units_assigned.bin", 4));
+    assigned = volume;
+    for (const auto *other : {&copy, &assigned}) {
+        EXPECT_FALSE(other->IsPagingEnabled());
+        EXPECT_EQ(volume.GetVolumeUnitCount(), other->volume_units_.size());
+    }
+    for (int i = 0; i < 6; i++) {
+        extrinsic(0, 3) = -0.08 * i - 0.02;
+        volume.Integrate(rgbd, intrinsic, extrinsic);
+    }
+    EXPECT_EQ(num_triangles, copy.ExtractTriangleMesh()->triangles_.size());
+    EXPECT_EQ(num_triangles,
+              assigned.ExtractTriangleMesh()->triangles_.size());
+    EXPECT_TRUE(volume.DisablePaging());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(ScalableTSDFVolume, DepthSamplingStride) {
+    const camera::PinholeCameraIntrinsic intrinsic(64, 48, 250.0, 250.0, 31.5,
+                                                   23.5);
+    geometry::RGBDImage rgbd = CreatePlaneImage(intrinsic);
+    // A pole in front of the plane that is one pixel wide, so that it falls
+    // between the sampled pixels of a stride.
+    for (int v = 0; v < intrinsic.height_; v++) {
+        *rgbd.depth_.PointerAt<float>(33, v) = 0.5f;
+    }
+    integration::ScalableTSDFVolume reference(
+            0.01, 0.04, integration::TSDFVolumeColorType::RGB8, 16, 1);
+    reference.Integrate(rgbd, intrinsic, Eigen::Matrix4d::Identity());
+    auto reference_mesh = reference.ExtractTriangleMesh();
+    for (int stride : {4, 8}) {
+        integration::ScalableTSDFVolume volume(
+                0.01, 0.04, integration::TSDFVolumeColorType::RGB8, 16,
+                stride);
+        volume.Integrate(rgbd, intrinsic, Eigen::Matrix4d::Identity());
+        for (const auto &unit : reference.volume_units_) {
+            EXPECT_EQ(1u, volume.volume_units_.count(unit.first));
+        }
+        auto mesh = volume.ExtractTriangleMesh();
+        EXPECT_EQ(reference_mesh->vertices_.size(), mesh->vertices_.size());
+        EXPECT_EQ(reference_mesh->triangles_.size(), mesh->triangles_.size());
+    }
+}
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -28,10 +28,16 @@
 #include "Open3D/Camera/PinholeCameraIntrinsic.h"
 #include "Open3D/Geometry/RGBDImage.h"
 #include "Open3D/IO/ClassIO/ImageIO.h"
+#include "Open3D/Integration/MarchingCubesConst.h"
 #include "Open3D/Visualization/Utility/DrawGeometry.h"
 #include "TestUtility/UnitTest.h"
 
 #include <sstream>
+#include <unordered_map>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace open3d;
 using namespace unit_test;
@@ -194,6 +200,267 @@ TEST(UniformTSDFVolume, RealData) {
              /*threshold*/ 0.1);
 }
 
+namespace {
+
+// Integrates every voxel of an RGB8 volume with the loop that
+// IntegrateWithDepthToCameraDistanceMultiplier had before it was limited to
+// the view frustum.
+void IntegrateAllVoxels(integration::UniformTSDFVolume& volume,
+                        const geometry::RGBDImage& image,
+                        const camera::PinholeCameraIntrinsic& intrinsic,
+                        const Eigen::Matrix4d& extrinsic) {
+    auto multiplier =
+            geometry::Image::CreateDepthToCameraDistanceMultiplierFloatImage(
+                    intrinsic);
+    const float fx = static_cast<float>(intrinsic.GetFocalLength().first);
+    const float fy = static_cast<float>(intrinsic.GetFocalLength().second);
+    const float cx = static_cast<float>(intrinsic.GetPrincipalPoint().first);
+    const float cy = static_cast<float>(intrinsic.GetPrincipalPoint().second);
+    const Eigen::Matrix4f extrinsic_f = extrinsic.cast<float>();
+    const float voxel_length_f = static_cast<float>(volume.voxel_length_);
+    const float half_voxel_length_f = voxel_length_f * 0.5f;
+    const float sdf_trunc_f = static_cast<float>(volume.sdf_trunc_);
+    const Eigen::Matrix4f extrinsic_scaled_f = extrinsic_f * voxel_length_f;
+    for (int x = 0; x < volume.resolution_; x++) {
+        for (int y = 0; y < volume.resolution_; y++) {
+            Eigen::Vector4f pt_3d_homo(
+                    float(half_voxel_length_f + voxel_length_f * x +
+                          volume.origin_(0)),
+                    float(half_voxel_length_f + voxel_length_f * y +
+                          volume.origin_(1)),
+                    float(half_voxel_length_f + volume.origin_(2)), 1.f);
+            Eigen::Vector4f pt_camera = extrinsic_f * pt_3d_homo;
+            for (int z = 0; z < volume.resolution_; z++,
+                     pt_camera(0) += extrinsic_scaled_f(0, 2),
+                     pt_camera(1) += extrinsic_scaled_f(1, 2),
+                     pt_camera(2) += extrinsic_scaled_f(2, 2)) {
+                if (pt_camera(2) <= 0) {
+                    continue;
+                }
+                float u_f = pt_camera(0) * fx / pt_camera(2) + cx + 0.5f;
+                float v_f = pt_camera(1) * fy / pt_camera(2) + cy + 0.5f;
+                if (!(u_f >= 0.0001f && u_f < intrinsic.width_ - 0.0001f &&
+                      v_f >= 0.0001f && v_f < intrinsic.height_ - 0.0001f)) {
+                    continue;
+                }
+                int u = (int)u_f;
+                int v = (int)v_f;
+                float d = *image.depth_.PointerAt<float>(u, v);
+                if (d <= 0.0f) {
+                    continue;
+                }
+                float sdf = (d - pt_camera(2)) *
+                            (*multiplier->PointerAt<float>(u, v));
+                if (sdf > -sdf_trunc_f) {
+                    auto& voxel = volume.voxels_[volume.IndexOf(x, y, z)];
+                    float tsdf = std::min(1.0f, sdf * (1.0f / sdf_trunc_f));
+                    voxel.tsdf_ = (voxel.tsdf_ * voxel.weight_ + tsdf) /
+                                  (voxel.weight_ + 1.0f);
+                    const uint8_t* rgb =
+                            image.color_.PointerAt<uint8_t>(u, v, 0);
+                    Eigen::Vector3d rgb_f(rgb[0], rgb[1], rgb[2]);
+                    voxel.color_ = (voxel.color_ * voxel.weight_ + rgb_f) /
+                                   (voxel.weight_ + 1.0f);
+                    voxel.weight_ += 1.0f;
+                }
+            }
+        }
+    }
+}
+
+}  // unnamed namespace
+
+TEST(UniformTSDFVolume, FrustumCulling) {
+    std::vector<Eigen::Matrix4d> poses;
+    ASSERT_TRUE(ReadPoses(std::string(TEST_DATA_DIR) + "/RGBD/odometry.log",
+                          poses));
+    camera::PinholeCameraIntrinsic intrinsic(
+            camera::PinholeCameraIntrinsicParameters::PrimeSenseDefault);
+
+    // The camera is inside the volume and sees a part of it.
+    integration::UniformTSDFVolume volume(
+            4.0, 100, 0.04, integration::TSDFVolumeColorType::RGB8,
+            Eigen::Vector3d(-2.0, -1.5, -1.0));
+    integration::UniformTSDFVolume reference = volume;
+    for (size_t i = 0; i < 3; ++i) {
+        geometry::Image im_color;
+        std::ostringstream im_color_path;
+        im_color_path << TEST_DATA_DIR << "/RGBD/color/" << std::setfill('0')
+                      << std::setw(5) << i << ".jpg";
+        io::ReadImage(im_color_path.str(), im_color);
+        geometry::Image im_depth;
+        std::ostringstream im_depth_path;
+        im_depth_path << TEST_DATA_DIR << "/RGBD/depth/" << std::setfill('0')
+                      << std::setw(5) << i << ".png";
+        io::ReadImage(im_depth_path.str(), im_depth);
+        std::shared_ptr<geometry::RGBDImage> im_rgbd =
+                geometry::RGBDImage::CreateFromColorAndDepth(
+                        im_color, im_depth, 1000.0, 4.0, false);
+        volume.Integrate(*im_rgbd, intrinsic, poses[i].inverse());
+        IntegrateAllVoxels(reference, *im_rgbd, intrinsic, poses[i].inverse());
+    }
+
+    int num_observed = 0;
+    for (size_t i = 0; i < volume.voxels_.size(); i++) {
+        EXPECT_EQ(reference.voxels_[i].weight_, volume.voxels_[i].weight_);
+        EXPECT_EQ(reference.voxels_[i].tsdf_, volume.voxels_[i].tsdf_);
+        ExpectEQ(reference.voxels_[i].color_, volume.voxels_[i].color_);
+        if (volume.voxels_[i].weight_ != 0.0f) {
+            num_observed++;
+        }
+    }
+    EXPECT_GT(num_observed, 0);
+    EXPECT_LT(num_observed, int(volume.voxels_.size()) / 2);
+}
+
+// Marching cubes that visits the cubes in order and looks up the vertices of
+// edges in a hash map, as UniformTSDFVolume::ExtractTriangleMesh did before it
+// was parallelized.
+std::shared_ptr<geometry::TriangleMesh> ExtractTriangleMeshSerial(
+        const integration::UniformTSDFVolume& volume) {
+    auto mesh = std::make_shared<geometry::TriangleMesh>();
+    const double half_voxel_length = volume.voxel_length_ * 0.5;
+    std::unordered_map<
+            Eigen::Vector4i, int, utility::hash_eigen::hash<Eigen::Vector4i>,
+            std::equal_to<Eigen::Vector4i>,
+            Eigen::aligned_allocator<std::pair<const Eigen::Vector4i, int>>>
+            edgeindex_to_vertexindex;
+    int edge_to_index[12];
+    const int resolution = volume.resolution_;
+    for (int x = 0; x < resolution - 1; x++) {
+        for (int y = 0; y < resolution - 1; y++) {
+            for (int z = 0; z < resolution - 1; z++) {
+                int cube_index = 0;
+                float f[8];
+                Eigen::Vector3d c[8];
+                for (int i = 0; i < 8; i++) {
+                    const auto& voxel = volume.voxels_[volume.IndexOf(
+                            Eigen::Vector3i(x, y, z) + shift[i])];
+                    if (voxel.weight_ == 0.0f) {
+                        cube_index = 0;
+                        break;
+                    }
+                    f[i] = voxel.tsdf_;
+                    if (f[i] < 0.0f) {
+                        cube_index |= (1 << i);
+                    }
+                    c[i] = voxel.color_ / 255.0;
+                }
+                if (cube_index == 0 || cube_index == 255) {
+                    continue;
+                }
+                for (int i = 0; i < 12; i++) {
+                    if (!(edge_table[cube_index] & (1 << i))) {
+                        continue;
+                    }
+                    Eigen::Vector4i edge_index =
+                            Eigen::Vector4i(x, y, z, 0) + edge_shift[i];
+                    auto itr = edgeindex_to_vertexindex.find(edge_index);
+                    if (itr != edgeindex_to_vertexindex.end()) {
+                        edge_to_index[i] = itr->second;
+                        continue;
+                    }
+                    edge_to_index[i] = (int)mesh->vertices_.size();
+                    edgeindex_to_vertexindex[edge_index] = edge_to_index[i];
+                    Eigen::Vector3d pt(
+                            half_voxel_length +
+                                    volume.voxel_length_ * edge_index(0),
+                            half_voxel_length +
+                                    volume.voxel_length_ * edge_index(1),
+                            half_voxel_length +
+                                    volume.voxel_length_ * edge_index(2));
+                    const int* vertices = edge_to_vert[i];
+                    double f0 = std::abs((double)f[vertices[0]]);
+                    double f1 = std::abs((double)f[vertices[1]]);
+                    pt(edge_index(3)) += f0 * volume.voxel_length_ / (f0 + f1);
+                    mesh->vertices_.push_back(pt + volume.origin_);
+                    mesh->vertex_colors_.push_back(
+                            (f1 * c[vertices[0]] + f0 * c[vertices[1]]) /
+                            (f0 + f1));
+                }
+                const int* triangles = tri_table[cube_index];
+                for (int i = 0; triangles[i] != -1; i += 3) {
+                    mesh->triangles_.push_back(
+                            Eigen::Vector3i(edge_to_index[triangles[i]],
+                                            edge_to_index[triangles[i + 2]],
+                                            edge_to_index[triangles[i + 1]]));
+                }
+            }
+        }
+    }
+    return mesh;
+}
+
+TEST(UniformTSDFVolume, ParallelExtraction) {
+    std::vector<Eigen::Matrix4d> poses;
+    ASSERT_TRUE(ReadPoses(std::string(TEST_DATA_DIR) + "/RGBD/odometry.log",
+                          poses));
+    camera::PinholeCameraIntrinsic intrinsic(
+            camera::PinholeCameraIntrinsicParameters::PrimeSenseDefault);
+    integration::UniformTSDFVolume volume(
+            4.0, 100, 0.04, integration::TSDFVolumeColorType::RGB8,
+            Eigen::Vector3d(-2.0, -1.5, -1.0));
+    for (size_t i = 0; i < 2; ++i) {
+        geometry::Image im_color;
+        std::ostringstream im_color_path;
+        im_color_path << TEST_DATA_DIR << "/RGBD/color/" << std::setfill('0')
+                      << std::setw(5) << i << ".jpg";
+        io::ReadImage(im_color_path.str(), im_color);
+        geometry::Image im_depth;
+        std::ostringstream im_depth_path;
+        im_depth_path << TEST_DATA_DIR << "/RGBD/depth/" << std::setfill('0')
+                      << std::setw(5) << i << ".png";
+        io::ReadImage(im_depth_path.str(), im_depth);
+        std::shared_ptr<geometry::RGBDImage> im_rgbd =
+                geometry::RGBDImage::CreateFromColorAndDepth(
+                        im_color, im_depth, 1000.0, 4.0, false);
+        volume.Integrate(*im_rgbd, intrinsic, poses[i].inverse());
+    }
+
+    // The merged slabs give the mesh of the serial marching cubes.
+    auto mesh = volume.ExtractTriangleMesh();
+    auto reference = ExtractTriangleMeshSerial(volume);
+    EXPECT_GT(mesh->triangles_.size(), 0u);
+    ASSERT_EQ(reference->vertices_.size(), mesh->vertices_.size());
+    ASSERT_EQ(reference->triangles_.size(), mesh->triangles_.size());
+    ExpectEQ(reference->vertices_, mesh->vertices_, 0.0);
+    ExpectEQ(reference->vertex_colors_, mesh->vertex_colors_, 0.0);
+    ExpectEQ(reference->triangles_, mesh->triangles_);
+
+    // The outputs do not depend on the number of threads.
+    auto pcd = volume.ExtractPointCloud();
+    auto voxel_pcd = volume.ExtractVoxelPointCloud();
+    auto voxel_grid = volume.ExtractVoxelGrid();
+#ifdef _OPENMP
+    int num_threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    auto single_mesh = volume.ExtractTriangleMesh();
+    auto single_pcd = volume.ExtractPointCloud();
+    auto single_voxel_pcd = volume.ExtractVoxelPointCloud();
+    auto single_voxel_grid = volume.ExtractVoxelGrid();
+    omp_set_num_threads(4);
+    auto multi_mesh = volume.ExtractTriangleMesh();
+    auto multi_pcd = volume.ExtractPointCloud();
+    omp_set_num_threads(num_threads);
+    ExpectEQ(single_mesh->vertices_, mesh->vertices_, 0.0);
+    ExpectEQ(single_mesh->triangles_, mesh->triangles_);
+    ExpectEQ(multi_mesh->vertices_, mesh->vertices_, 0.0);
+    ExpectEQ(multi_mesh->triangles_, mesh->triangles_);
+    ExpectEQ(single_pcd->points_, pcd->points_, 0.0);
+    ExpectEQ(single_pcd->colors_, pcd->colors_, 0.0);
+    ExpectEQ(single_pcd->normals_, pcd->normals_, 0.0);
+    ExpectEQ(multi_pcd->points_, pcd->points_, 0.0);
+    ExpectEQ(single_voxel_pcd->points_, voxel_pcd->points_, 0.0);
+    ASSERT_EQ(single_voxel_grid->voxels_.size(), voxel_grid->voxels_.size());
+    for (size_t i = 0; i < voxel_grid->voxels_.size(); i++) {
+        ExpectEQ(single_voxel_grid->voxels_[i].grid_index_,
+                 voxel_grid->voxels_[i].grid_index_);
+    }
+#endif
+    EXPECT_GT(pcd->points_.size(), 0u);
+    EXPECT_EQ(voxel_pcd->points_.size(), voxel_grid->voxels_.size());
+}
+
 TEST(UniformTSDFVolume, DISABLED_Destructor) {}
 
 TEST(UniformTSDFVolume, DISABLED_MemberData) {}
@@ -0,0 +1,140 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Integration/VolumeUnitStore.h"
+#include "Open3D/Integration/UniformTSDFVolume.h"
+#include "Open3D/Utility/FileSystem.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace open3d;
+using namespace unit_test;
+
+namespace {
+
+// Fills every third voxel of a unit with distinct values.
+void FillVolumeUnit(integration::UniformTSDFVolume &volume, int seed) {
+    for (size_t i = 0; i < volume.voxels_.size(); i += 3) {
+        auto &voxel = volume.voxels_[i];
+        voxel.tsdf_ = float(i % 200) / 100.0f - 1.0f;
+        voxel.weight_ = float(seed + 1);
+        voxel.color_ = Eigen::Vector3d(0.1 * i, 0.2 * seed, 0.3);
+    }
+}
+
+void ExpectVoxelsEQ(const integration::UniformTSDFVolume &volume0,
+                    const integration::UniformTSDFVolume &volume1) {
+    ASSERT_EQ(volume0.voxels_.size(), volume1.voxels_.size());
+    for (size_t i = 0; i < volume0.voxels_.size(); i++) {
+        EXPECT_EQ(volume0.voxels_[i].tsdf_, volume1.voxels_[i].tsdf_);
+        EXPECT_EQ(volume0.voxels_[i].weight_, volume1.voxels_[i].weight_);
+        ExpectEQ(volume0.voxels_[i].color_, volume1.voxels_[i].color_);
+    }
+}
+
+}  // unnamed namespace
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(VolumeUnitStore, EncodeDecode) {
+    for (auto color_type : {integration::TSDFVolumeColorType::None,
+                            integration::TSDFVolumeColorType::RGB8}) {
+        integration::UniformTSDFVolume volume(0.16, 8, 0.04, color_type);
+        FillVolumeUnit(volume, 2);
+        if (color_type == integration::TSDFVolumeColorType::None) {
+            for (auto &voxel : volume.voxels_) {
+                voxel.color_.setZero();
+            }
+        }
+        std::vector<uint8_t> buffer;
+        integration::VolumeUnitStore::EncodeVolumeUnit(volume, buffer);
+        // Only the observed voxels are stored.
+        size_t record_size =
+                color_type == integration::TSDFVolumeColorType::None ? 8 : 32;
+        EXPECT_EQ(4 + 512 / 8 + 171 * record_size, buffer.size());
+
+        integration::UniformTSDFVolume decoded(0.16, 8, 0.04, color_type);
+        decoded.voxels_[1].weight_ = 1.0f;
+        EXPECT_TRUE(integration::VolumeUnitStore::DecodeVolumeUnit(
+                buffer.data(), buffer.size(), decoded));
+        ExpectVoxelsEQ(volume, decoded);
+        EXPECT_FALSE(integration::VolumeUnitStore::DecodeVolumeUnit(
+                buffer.data(), buffer.size() - 1, decoded));
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(VolumeUnitStore, WriteRead) {
+    const std::string filename = "tmp_volume_unit_store.bin";
+    const auto color_type = integration::TSDFVolumeColorType::RGB8;
+    integration::VolumeUnitStore store;
+    EXPECT_FALSE(store.IsOpen());
+    ASSERT_TRUE(store.Open(filename));
+    EXPECT_TRUE(store.IsOpen());
+    EXPECT_TRUE(utility::filesystem::FileExists(filename));
+
+    std::vector<integration::UniformTSDFVolume> volumes;
+    for (int i = 0; i < 4; i++) {
+        volumes.emplace_back(0.16, 8, 0.04, color_type);
+        FillVolumeUnit(volumes.back(), i);
+        EXPECT_TRUE(store.Write(Eigen::Vector3i(i, -i, 0), volumes.back()));
+    }
+    EXPECT_EQ(4u, store.Size());
+    EXPECT_TRUE(store.Contains(Eigen::Vector3i(2, -2, 0)));
+    EXPECT_FALSE(store.Contains(Eigen::Vector3i(2, 2, 0)));
+    const size_t file_size = store.GetFileSize();
+
+    for (int i = 3; i >= 0; i--) {
+        integration::UniformTSDFVolume volume(0.16, 8, 0.04, color_type);
+        EXPECT_TRUE(store.Read(Eigen::Vector3i(i, -i, 0), volume));
+        ExpectVoxelsEQ(volumes[i], volume);
+    }
+    integration::UniformTSDFVolume volume(0.16, 8, 0.04, color_type);
+    EXPECT_FALSE(store.Read(Eigen::Vector3i(2, 2, 0), volume));
+
+    // Space of erased units is reused, and rewriting a unit replaces it.
+    store.Erase(Eigen::Vector3i(1, -1, 0));
+    EXPECT_FALSE(store.Contains(Eigen::Vector3i(1, -1, 0)));
+    EXPECT_TRUE(store.Write(Eigen::Vector3i(5, 5, 5), volumes[3]));
+    EXPECT_TRUE(store.Write(Eigen::Vector3i(0, 0, 0), volumes[2]));
+    EXPECT_EQ(file_size, store.GetFileSize());
+    EXPECT_EQ(4u, store.Size());
+    EXPECT_TRUE(store.Read(Eigen::Vector3i(0, 0, 0), volume));
+    ExpectVoxelsEQ(volumes[2], volume);
+    EXPECT_TRUE(store.Read(Eigen::Vector3i(5, 5, 5), volume));
+    ExpectVoxelsEQ(volumes[3], volume);
+
+    store.Clear();
+    EXPECT_EQ(0u, store.Size());
+    EXPECT_EQ(0u, store.GetFileSize());
+    EXPECT_TRUE(store.IsOpen());
+    store.Close();
+    EXPECT_FALSE(store.IsOpen());
+    EXPECT_FALSE(utility::filesystem::FileExists(filename));
+    EXPECT_FALSE(store.Open("/not_a_directory/volume_units.bin"));
+}
@@ -24,8 +24,40 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <cmath>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Registration/ColoredICP.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+namespace {
+
+// Wavy surface with a smoothly varying gray color.
+geometry::PointCloud CreateColoredSurface(int size, double step) {
+    geometry::PointCloud pcd;
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < size; j++) {
+            double x = i * step;
+            double y = j * step;
+            double z = 0.05 * sin(5.0 * x) * cos(5.0 * y);
+            double dzdx = 0.25 * cos(5.0 * x) * cos(5.0 * y);
+            double dzdy = -0.25 * sin(5.0 * x) * sin(5.0 * y);
+            double c = 0.5 + 0.4 * sin(10.0 * x + 7.0 * y);
+            pcd.points_.push_back(Vector3d(x, y, z));
+            pcd.normals_.push_back(Vector3d(-dzdx, -dzdy, 1.0).normalized());
+            pcd.colors_.push_back(Vector3d(c, c, c));
+        }
+    }
+    return pcd;
+}
+
+}  // unnamed namespace
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -39,3 +71,63 @@ TEST(ColoredICP, DISABLED_RegistrationColoredICP) {
 TEST(ColoredICP, DISABLED_ICPConvergenceCriteria) {
     unit_test::NotImplemented();
 }
+
+// ----------------------------------------------------------------------------
+// A linear color ramp on a plane has a constant gradient.
+// ----------------------------------------------------------------------------
+TEST(ColoredICP, ColoredICPTarget) {
+    int size = 20;
+    double step = 0.01;
+    geometry::PointCloud pcd;
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < size; j++) {
+            double x = i * step;
+            double y = j * step;
+            double c = 0.1 + 2.0 * x + 1.0 * y;
+            pcd.points_.push_back(Vector3d(x, y, 0.0));
+            pcd.normals_.push_back(Vector3d(0.0, 0.0, 1.0));
+            pcd.colors_.push_back(Vector3d(c, c, c));
+        }
+    }
+
+    registration::ColoredICPTarget target;
+    EXPECT_TRUE(target.SetPointCloud(
+            pcd, geometry::KDTreeSearchParamHybrid(2.5 * step, 30)));
+    EXPECT_EQ(pcd.points_.size(), target.color_gradient_.size());
+    for (const auto &gradient : target.color_gradient_) {
+        ExpectEQ(Vector3d(2.0, 1.0, 0.0), gradient, 1e-6);
+    }
+
+    geometry::PointCloud no_colors = pcd;
+    no_colors.colors_.clear();
+    EXPECT_FALSE(target.SetPointCloud(
+            no_colors, geometry::KDTreeSearchParamHybrid(2.5 * step, 30)));
+}
+
+// ----------------------------------------------------------------------------
+// Registering against a prepared target gives the same result as preparing
+// the target on every call, and the prepared target can be reused.
+// ----------------------------------------------------------------------------
+TEST(ColoredICP, RegistrationColoredICPPreparedTarget) {
+    geometry::PointCloud target = CreateColoredSurface(40, 0.01);
+    double max_distance = 0.02;
+    auto prepared = registration::PrepareColoredICPTarget(target, max_distance);
+    EXPECT_EQ(target.points_.size(), prepared->point_cloud_.points_.size());
+
+    for (double offset : {0.004, -0.003}) {
+        geometry::PointCloud source = target;
+        Matrix4d ground_truth = Matrix4d::Identity();
+        ground_truth.block<3, 1>(0, 3) = Vector3d(offset, -offset, 0.002);
+        source.Transform(ground_truth.inverse());
+
+        auto expected = registration::RegistrationColoredICP(source, target,
+                                                             max_distance);
+        auto result = registration::RegistrationColoredICP(source, *prepared,
+                                                           max_distance);
+        ExpectEQ(Matrix4d(expected.transformation_),
+                 Matrix4d(result.transformation_), 0.0);
+        EXPECT_EQ(expected.fitness_, result.fitness_);
+        EXPECT_EQ(expected.inlier_rmse_, result.inlier_rmse_);
+        ExpectEQ(ground_truth, Matrix4d(result.transformation_), 1e-3);
+    }
+}
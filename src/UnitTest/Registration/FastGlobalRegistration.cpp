@@ -24,8 +24,21 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Registration/FastGlobalRegistration.h"
+#include "Open3D/Registration/Feature.h"
+#include "Open3D/Registration/Registration.h"
 #include "TestUtility/UnitTest.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -53,3 +66,49 @@ TEST(FastGlobalRegistration, DISABLED_Constructor) {
 TEST(FastGlobalRegistration, DISABLED_MemberData) {
     unit_test::NotImplemented();
 }
+
+// ----------------------------------------------------------------------------
+// Fragment j is fragment i moved by a known transformation and every point
+// carries the same random feature in both fragments.
+// ----------------------------------------------------------------------------
+TEST(FastGlobalRegistration, FastGlobalRegistration) {
+    int size = 500;
+    int dimension = 8;
+
+    geometry::PointCloud source;
+    source.points_.resize(size);
+    Rand(source.points_, Vector3d(0.0, 0.0, 0.0), Vector3d(1.0, 1.0, 1.0), 0);
+
+    Matrix4d ground_truth = Matrix4d::Identity();
+    ground_truth.block<3, 3>(0, 0) =
+            AngleAxisd(0.3, Vector3d(1.0, 2.0, 3.0).normalized())
+                    .toRotationMatrix();
+    ground_truth.block<3, 1>(0, 3) = Vector3d(0.2, -0.1, 0.4);
+    geometry::PointCloud target = source;
+    target.Transform(ground_truth);
+
+    registration::Feature source_feature;
+    source_feature.Resize(dimension, size);
+    Rand(source_feature.data_.data(), dimension * size, 0.0, 1.0, 1);
+    registration::Feature target_feature = source_feature;
+
+    registration::FastGlobalRegistrationOption option;
+    option.seed_ = 42;
+    auto result = registration::FastGlobalRegistration(
+            source, target, source_feature, target_feature, option);
+    Matrix4d transformation = result.transformation_;
+    ExpectEQ(ground_truth, transformation, 1e-4);
+
+    // The same seed must give the same result for any number of threads.
+    auto repeated = registration::FastGlobalRegistration(
+            source, target, source_feature, target_feature, option);
+    ExpectEQ(transformation, Matrix4d(repeated.transformation_), 0.0);
+#ifdef _OPENMP
+    int num_threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    auto serial = registration::FastGlobalRegistration(
+            source, target, source_feature, target_feature, option);
+    omp_set_num_threads(num_threads);
+    ExpectEQ(transformation, Matrix4d(serial.transformation_), 0.0);
+#endif
+}
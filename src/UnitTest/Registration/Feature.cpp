@@ -24,8 +24,16 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/PointCloudNeighborhoods.h"
+#include "Open3D/Registration/Feature.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -46,6 +54,34 @@ TEST(Feature, DISABLED_Num) { unit_test::NotImplemented(); }
 // ----------------------------------------------------------------------------
 TEST(Feature, DISABLED_ComputeFPFHFeature) { unit_test::NotImplemented(); }
 
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Feature, ComputeFPFHFeatureFromNeighborhoods) {
+    size_t size = 200;
+    geometry::PointCloud pc;
+
+    pc.points_.resize(size);
+    Rand(pc.points_, Vector3d(0.0, 0.0, 0.0), Vector3d(10.0, 10.0, 10.0), 0);
+
+    geometry::KDTreeSearchParamHybrid param(3.0, 30);
+    geometry::PointCloudNeighborhoods neighborhoods(pc, param);
+    EXPECT_TRUE(pc.EstimateNormals(neighborhoods));
+
+    auto ref = registration::ComputeFPFHFeature(pc, param);
+    auto feature = registration::ComputeFPFHFeature(pc, neighborhoods);
+    EXPECT_EQ(33u, feature->Dimension());
+    EXPECT_EQ(size, feature->Num());
+    ExpectEQ(ref->data_, feature->data_);
+    EXPECT_GT(feature->data_.sum(), 0.0);
+
+    // without normals the feature is zero
+    pc.normals_.clear();
+    feature = registration::ComputeFPFHFeature(pc, neighborhoods);
+    EXPECT_EQ(size, feature->Num());
+    EXPECT_EQ(0.0, feature->data_.cwiseAbs().sum());
+}
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -274,3 +274,50 @@ TEST(Eigen, ComputeJTJandJTr_vector) {
     ExpectEQ(ref_JTr, JTr);
     ExpectEQ(ref_JTJ, JTJ);
 }
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Eigen, ComputeJTJandJTr_symmetric) {
+    int iteration_num = 1000;
+    vector<Vector6d, utility::Vector6d_allocator> rows(iteration_num);
+    vector<double> residuals(iteration_num);
+    Matrix6d ref_JTJ = Matrix6d::Zero();
+    Vector6d ref_JTr = Vector6d::Zero();
+    double ref_r2 = 0.0;
+    vector<double> v(6);
+    for (int i = 0; i < iteration_num; i++) {
+        Rand(v, -1.0, 1.0, i);
+        for (int k = 0; k < 6; k++) rows[i](k) = v[k];
+        residuals[i] = v[0] - v[5];
+        ref_JTJ += rows[i] * rows[i].transpose();
+        ref_JTr += rows[i] * residuals[i];
+        ref_r2 += residuals[i] * residuals[i];
+    }
+
+    auto testFunction = [&](int i, Vector6d &J_r, double &r) {
+        J_r = rows[i];
+        r = residuals[i];
+    };
+
+    Matrix6d JTJ;
+    Vector6d JTr;
+    double r2;
+    tie(JTJ, JTr, r2) = utility::ComputeJTJandJTr<Matrix6d, Vector6d>(
+            testFunction, iteration_num, false);
+
+    ExpectEQ(ref_JTJ, JTJ);
+    ExpectEQ(ref_JTr, JTr);
+    EXPECT_NEAR(ref_r2, r2, THRESHOLD_1E_6);
+    for (int i = 0; i < 6; i++) {
+        for (int j = 0; j < 6; j++) {
+            EXPECT_EQ(JTJ(i, j), JTJ(j, i));
+        }
+    }
+
+    tie(JTJ, JTr, r2) =
+            utility::ComputeJTJandJTr<Matrix6d, Vector6d>(testFunction, 0);
+    ExpectEQ(Matrix6d(Matrix6d::Zero()), JTJ);
+    ExpectEQ(Zero6d, JTr);
+    EXPECT_EQ(0.0, r2);
+}
@@ -505,3 +505,35 @@ TEST(FileSystem, ListFilesInDirectoryWithExtension) {
     status = utility::filesystem::DeleteDirectory("test");
     EXPECT_TRUE(status);
 }
+
+// ----------------------------------------------------------------------------
+// Map a file into memory.
+// ----------------------------------------------------------------------------
+TEST(FileSystem, MappedFile) {
+    string fileName = "mapped_file.bin";
+    string contents("mapped\nfile\0contents", 20);
+
+    FILE* file = fopen(fileName.c_str(), "wb");
+    fwrite(contents.data(), 1, contents.size(), file);
+    fclose(file);
+
+    utility::filesystem::MappedFile mapped_file;
+    EXPECT_TRUE(mapped_file.Open(fileName));
+    EXPECT_TRUE(mapped_file.IsOpen());
+    EXPECT_EQ(contents.size(), mapped_file.GetSize());
+    EXPECT_EQ(contents,
+              string(mapped_file.GetData(), mapped_file.GetSize()));
+
+    mapped_file.Close();
+    EXPECT_FALSE(mapped_file.IsOpen());
+    EXPECT_EQ(0u, mapped_file.GetSize());
+
+    EXPECT_TRUE(utility::filesystem::RemoveFile(fileName));
+    EXPECT_FALSE(mapped_file.Open(fileName));
+
+    // Empty files cannot be mapped.
+    file = fopen(fileName.c_str(), "wb");
+    fclose(file);
+    EXPECT_FALSE(mapped_file.Open(fileName));
+    EXPECT_TRUE(utility::filesystem::RemoveFile(fileName));
+}
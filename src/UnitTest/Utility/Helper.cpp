@@ -24,9 +24,39 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include "Open3D/Utility/Helper.h"
 #include "TestUtility/UnitTest.h"
 
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
 TEST(Helper, DISABLED_SplitString) { unit_test::NotImplemented(); }
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Helper, ParallelSort) {
+    std::vector<int> values(100000);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = int((i * 7919) % 1009);
+    }
+    std::vector<int> ref = values;
+    std::sort(ref.begin(), ref.end());
+
+    open3d::utility::ParallelSort(values, std::less<int>());
+    EXPECT_EQ(ref, values);
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Helper, FindFirstOccurrences) {
+    std::vector<std::tuple<int, int>> keys = {{3, 1}, {0, 2}, {3, 1},
+                                              {1, 1}, {0, 2}, {3, 1}};
+    std::vector<int> ref = {0, 1, 0, 3, 1, 0};
+
+    EXPECT_EQ(ref, open3d::utility::FindFirstOccurrences(keys));
+    EXPECT_TRUE(open3d::utility::FindFirstOccurrences(
+                        std::vector<std::tuple<int, int>>())
+                        .empty());
+}
@@ -0,0 +1,231 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <json/json.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Open3D/Utility/Profiler.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+namespace {
+
+const utility::ProfileNode *FindChild(const utility::ProfileNode &node,
+                                      const string &name) {
+    for (const auto &child : node.children_) {
+        if (child.name_ == name) {
+            return &child;
+        }
+    }
+    return nullptr;
+}
+
+// Two zones nested in an outer zone, the inner one in a loop.
+void RunNestedZones(int inner_count) {
+    utility::ProfileZone outer("Outer");
+    for (int i = 0; i < inner_count; i++) {
+        utility::ProfileZone inner("Inner");
+    }
+    utility::ProfileZone other("Other");
+}
+
+}  // unnamed namespace
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Profiler, Disabled) {
+    utility::Profiler &profiler = utility::Profiler::i();
+    profiler.SetEnabled(false);
+    profiler.Clear();
+    RunNestedZones(3);
+
+    EXPECT_FALSE(profiler.IsEnabled());
+    EXPECT_TRUE(profiler.GetStatistics().children_.empty());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Profiler, GetStatistics) {
+    utility::Profiler &profiler = utility::Profiler::i();
+    profiler.Clear();
+    profiler.SetEnabled(true);
+    RunNestedZones(5);
+    RunNestedZones(5);
+    profiler.SetEnabled(false);
+
+    utility::ProfileNode root = profiler.GetStatistics();
+    ASSERT_EQ(1u, root.children_.size());
+    const utility::ProfileNode &outer = root.children_[0];
+    EXPECT_EQ("Outer", outer.name_);
+    EXPECT_EQ(2, outer.count_);
+    ASSERT_EQ(2u, outer.children_.size());
+
+    const utility::ProfileNode *inner = FindChild(outer, "Inner");
+    const utility::ProfileNode *other = FindChild(outer, "Other");
+    ASSERT_NE(nullptr, inner);
+    ASSERT_NE(nullptr, other);
+    EXPECT_EQ(10, inner->count_);
+    EXPECT_EQ(2, other->count_);
+    EXPECT_TRUE(inner->children_.empty());
+    EXPECT_TRUE(other->children_.empty());
+
+    EXPECT_LE(inner->min_ms_, inner->max_ms_);
+    EXPECT_LE(inner->max_ms_, inner->total_ms_);
+    EXPECT_NEAR(inner->total_ms_, inner->self_ms_, THRESHOLD_1E_6);
+    EXPECT_NEAR(outer.total_ms_,
+                outer.self_ms_ + inner->total_ms_ + other->total_ms_,
+                THRESHOLD_1E_6);
+    EXPECT_GE(outer.self_ms_, -THRESHOLD_1E_6);
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Profiler, MultipleThreads) {
+    const int num_threads = 4;
+    const int inner_count = 1000;
+
+    utility::Profiler &profiler = utility::Profiler::i();
+    profiler.Clear();
+    profiler.SetEnabled(true);
+    vector<thread> threads;
+    for (int i = 0; i < num_threads; i++) {
+        threads.emplace_back(RunNestedZones, inner_count);
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    profiler.SetEnabled(false);
+
+    utility::ProfileNode root = profiler.GetStatistics();
+    ASSERT_EQ(1u, root.children_.size());
+    const utility::ProfileNode &outer = root.children_[0];
+    EXPECT_EQ(num_threads, outer.count_);
+    const utility::ProfileNode *inner = FindChild(outer, "Inner");
+    ASSERT_NE(nullptr, inner);
+    EXPECT_EQ(num_threads * inner_count, inner->count_);
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Profiler, Clear) {
+    utility::Profiler &profiler = utility::Profiler::i();
+    profiler.Clear();
+    profiler.SetEnabled(true);
+    RunNestedZones(2);
+    profiler.Clear();
+    EXPECT_TRUE(profiler.GetStatistics().children_.empty());
+
+    // A zone that is open while clearing is kept, its children are not.
+    {
+        utility::ProfileZone outer("Outer");
+        { utility::ProfileZone inner("Inner"); }
+        profiler.Clear();
+    }
+    profiler.SetEnabled(false);
+
+    utility::ProfileNode root = profiler.GetStatistics();
+    ASSERT_EQ(1u, root.children_.size());
+    EXPECT_EQ("Outer", root.children_[0].name_);
+    EXPECT_EQ(1, root.children_[0].count_);
+    EXPECT_TRUE(root.children_[0].children_.empty());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Profiler, GetReport) {
+    utility::Profiler &profiler = utility::Profiler::i();
+    profiler.Clear();
+    profiler.SetEnabled(true);
+    RunNestedZones(3);
+    profiler.SetEnabled(false);
+
+    string report = profiler.GetReport();
+    EXPECT_NE(string::npos, report.find("\nOuter "));
+    EXPECT_NE(string::npos, report.find("\n  Inner "));
+    EXPECT_NE(string::npos, report.find("\n  Other "));
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Profiler, WriteChromeTrace) {
+    const string filename = "profile_trace.json";
+
+    utility::Profiler &profiler = utility::Profiler::i();
+    profiler.Clear();
+    profiler.SetEnabled(true);
+    RunNestedZones(3);
+    thread(RunNestedZones, 2).join();
+    profiler.SetEnabled(false);
+    EXPECT_TRUE(profiler.WriteChromeTrace(filename));
+
+    ifstream file(filename);
+    Json::Value value;
+    Json::Reader reader;
+    ASSERT_TRUE(reader.parse(file, value));
+    const Json::Value &events = value["traceEvents"];
+    ASSERT_TRUE(events.isArray());
+
+    // Every thread has a name and every zone is a complete event.
+    int num_names = 0;
+    vector<int> num_zones(2, 0);
+    for (const auto &event : events) {
+        if (event["ph"].asString() == "M") {
+            num_names++;
+            continue;
+        }
+        EXPECT_EQ("X", event["ph"].asString());
+        EXPECT_GE(event["dur"].asDouble(), 0.0);
+        if (event["name"].asString() == "Inner") {
+            int tid = event["tid"].asInt();
+            ASSERT_TRUE(tid >= 0);
+            if (tid >= (int)num_zones.size()) {
+                num_zones.resize(tid + 1, 0);
+            }
+            num_zones[tid]++;
+        }
+    }
+    EXPECT_LE(2, num_names);
+    std::sort(num_zones.begin(), num_zones.end());
+    EXPECT_EQ(3, num_zones.back());
+    EXPECT_EQ(2, num_zones[num_zones.size() - 2]);
+    remove(filename.c_str());
+
+    EXPECT_FALSE(profiler.WriteChromeTrace("/not_a_directory/trace.json"));
+}
@@ -0,0 +1,228 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Open3D/Utility/TextParser.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+namespace {
+
+// Numbers in the formats point cloud files are written with and the corner
+// cases the C library handles differently from the fast path.
+vector<string> GenerateNumbers() {
+    vector<string> numbers = {"0",
+                              "-0",
+                              "+1",
+                              "1.",
+                              ".5",
+                              "-.5e-3",
+                              "1e",
+                              "1e+",
+                              "2E-5x",
+                              "007.25",
+                              "0.1",
+                              "0.30000000000000004",
+                              "9007199254740993",
+                              "123456789012345678901234567890",
+                              "0.000000000000000000000000000001",
+                              "1e22",
+                              "1e23",
+                              "1e-22",
+                              "1e-23",
+                              "4.9e-324",
+                              "1e-400",
+                              "1.7976931348623157e308",
+                              "1e400",
+                              "0x1A",
+                              "0x1p-3",
+                              "inf",
+                              "-Infinity",
+                              "nan",
+                              "16777217",
+                              "1.00000005960464477",
+                              "1.00000005960464478",
+                              "3.4028235e38",
+                              "1.17549435e-38",
+                              "2147483647",
+                              "-2147483648",
+                              "99999999999",
+                              "12abc",
+                              "-",
+                              ".",
+                              "e5",
+                              "abc"};
+    mt19937 engine(0);
+    uniform_real_distribution<double> uniform(-1000.0, 1000.0);
+    uniform_int_distribution<int> exponent(-40, 40);
+    char buffer[64];
+    for (int i = 0; i < 2000; i++) {
+        const double value = uniform(engine) * pow(10.0, exponent(engine));
+        const char *formats[] = {"%.17g", "%.10f", "%.6e", "%g", "%.3f"};
+        for (const char *format : formats) {
+            snprintf(buffer, sizeof(buffer), format, value);
+            numbers.push_back(buffer);
+        }
+    }
+    return numbers;
+}
+
+}  // unnamed namespace
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(TextParser, ParseNumberDouble) {
+    for (const string &number : GenerateNumbers()) {
+        const string text = " \t" + number + " 7";
+        char *ref_end;
+        const double ref = strtod(text.c_str(), &ref_end);
+
+        const char *ptr = text.c_str();
+        double value = -1.0;
+        const bool parsed = utility::ParseNumber(ptr, ptr + text.size(), value);
+
+        EXPECT_EQ(ref_end != text.c_str(), parsed) << number;
+        if (parsed) {
+            EXPECT_EQ(ref_end, ptr) << number;
+            if (ref == ref) {
+                EXPECT_EQ(0, memcmp(&ref, &value, sizeof(double))) << number;
+            } else {
+                EXPECT_NE(value, value) << number;
+            }
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(TextParser, ParseNumberFloat) {
+    for (const string &number : GenerateNumbers()) {
+        const string text = number + "\n";
+        char *ref_end;
+        const float ref = strtof(text.c_str(), &ref_end);
+
+        const char *ptr = text.c_str();
+        float value = -1.0f;
+        const bool parsed = utility::ParseNumber(ptr, ptr + text.size(), value);
+
+        EXPECT_EQ(ref_end != text.c_str(), parsed) << number;
+        if (parsed) {
+            EXPECT_EQ(ref_end, ptr) << number;
+            if (ref == ref) {
+                EXPECT_EQ(0, memcmp(&ref, &value, sizeof(float))) << number;
+            } else {
+                EXPECT_NE(value, value) << number;
+            }
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(TextParser, ParseNumberInt) {
+    vector<string> numbers = {"0",    "-0",         "+12",         "-345",
+                              "0010", "2147483647", "-2147483648", "1.5",
+                              "99 1", "-",          "x1"};
+    for (const string &number : numbers) {
+        const string text = "  " + number;
+        char *ref_end;
+        const int ref = int(strtol(text.c_str(), &ref_end, 10));
+
+        const char *ptr = text.c_str();
+        int value = -1;
+        const bool parsed = utility::ParseNumber(ptr, ptr + text.size(), value);
+
+        EXPECT_EQ(ref_end != text.c_str(), parsed) << number;
+        if (parsed) {
+            EXPECT_EQ(ref_end, ptr) << number;
+            EXPECT_EQ(ref, value) << number;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(TextParser, ParseNumberStopsAtEnd) {
+    const string text = "12345";
+    const char *ptr = text.c_str();
+    double value;
+    EXPECT_TRUE(utility::ParseNumber(ptr, text.c_str() + 3, value));
+    EXPECT_EQ(123.0, value);
+    EXPECT_EQ(text.c_str() + 3, ptr);
+
+    EXPECT_FALSE(utility::ParseNumber(ptr, text.c_str() + 3, value));
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(TextParser, ParseLines) {
+    // Several chunks, the last line without a newline.
+    const int num_lines = 300000;
+    string text;
+    for (int i = 0; i < num_lines; i++) {
+        text += to_string(i) + (i % 3 == 0 ? " skip" : "") + "\n";
+    }
+    text += to_string(num_lines);
+
+    const char *begin = text.c_str();
+    const char *end = begin + text.size();
+    const vector<const char *> chunks =
+            utility::SplitIntoLineChunks(begin, end);
+    EXPECT_LT(2u, chunks.size());
+    EXPECT_EQ(begin, chunks.front());
+    EXPECT_EQ(end, chunks.back());
+    for (size_t i = 1; i + 1 < chunks.size(); i++) {
+        EXPECT_EQ('\n', chunks[i][-1]);
+    }
+
+    vector<int> values = utility::ParseLines<int>(
+            begin, end, [](const char *ptr, const char *line_end, int &value) {
+                return utility::ParseNumber(ptr, line_end, value) &&
+                       ptr == line_end;
+            });
+    vector<int> ref;
+    for (int i = 0; i <= num_lines; i++) {
+        if (i % 3 != 0 || i == num_lines) {
+            ref.push_back(i);
+        }
+    }
+    ExpectEQ(ref, values);
+}
@@ -0,0 +1,80 @@
+# Open3D: www.open3d.org
+# The MIT License (MIT)
+# See license file or visit www.open3d.org for details
+
+# util/scripts/compare_benchmarks.py
+
+# Compares two JSON result files of bin/benchmarks, e.g. of the main branch
+# and of a change. Benchmarks are matched by name and compared by real time.
+# The script exits with code 1 if any benchmark of the contender is slower
+# than the baseline by more than the threshold.
+#
+# Usage:
+#   ./bin/benchmarks --benchmark_out=old.json --benchmark_out_format=json
+#   python compare_benchmarks.py old.json new.json --threshold 0.1
+#
+# If the benchmarks were run with --benchmark_repetitions, the median of the
+# repetitions is compared.
+
+import argparse
+import json
+import sys
+
+time_unit_to_seconds = {"ns": 1e-9, "us": 1e-6, "ms": 1e-3, "s": 1.0}
+
+
+def read_results(filename):
+    with open(filename) as f:
+        benchmarks = json.load(f)["benchmarks"]
+    has_medians = any(
+        benchmark.get("aggregate_name") == "median" for benchmark in benchmarks)
+    results = {}
+    for benchmark in benchmarks:
+        if has_medians:
+            if benchmark.get("aggregate_name") != "median":
+                continue
+            name = benchmark["run_name"]
+        elif benchmark.get("run_type") == "aggregate":
+            continue
+        else:
+            name = benchmark["name"]
+        unit = time_unit_to_seconds[benchmark.get("time_unit", "ns")]
+        results[name] = benchmark["real_time"] * unit
+    return results
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(
+        description="Flag benchmarks that became slower between two builds.")
+    parser.add_argument("baseline", help="JSON results of the baseline build")
+    parser.add_argument("contender",
+                        help="JSON results of the build to check")
+    parser.add_argument("--threshold",
+                        type=float,
+                        default=0.1,
+                        help="relative slowdown that counts as a regression")
+    args = parser.parse_args()
+
+    baseline = read_results(args.baseline)
+    contender = read_results(args.contender)
+    names = [name for name in baseline if name in contender]
+    width = max([len(name) for name in names] + [len("benchmark")])
+    print("%-*s %14s %14s %9s" %
+          (width, "benchmark", "baseline [s]", "contender [s]", "change"))
+    regressions = []
+    for name in names:
+        change = contender[name] / baseline[name] - 1.0
+        flag = ""
+        if change > args.threshold:
+            regressions.append(name)
+            flag = "  REGRESSION"
+        print("%-*s %14.6f %14.6f %+8.1f%%%s" %
+              (width, name, baseline[name], contender[name], 100.0 * change,
+               flag))
+    for name in sorted(set(baseline) ^ set(contender)):
+        print("%s is only in %s" %
+              (name, args.baseline if name in baseline else args.contender))
+    if regressions:
+        print("%d of %d benchmarks regressed by more than %.0f%%" %
+              (len(regressions), len(names), 100.0 * args.threshold))
+        sys.exit(1)